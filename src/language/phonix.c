@@ -601,7 +601,7 @@ static int iLngPhonixStandardKey_un
     /* Make a copy of the term because we side effect it, also allocate extra space because 
     ** the phonix key for short terms can be longer than the term itself
     */
-    if ( (pwcNewTerm = (wchar_t *)s_malloc((size_t)(s_wcslen(pwcTerm) + 100))) == NULL ) {
+    if ( (pwcNewTerm = (wchar_t *)s_malloc((size_t)(sizeof(wchar_t) * (s_wcslen(pwcTerm) + 100)))) == NULL ) {
         return (LNG_MemError);
     }
     s_wcscpy(pwcNewTerm, pwcTerm);
@@ -710,8 +710,12 @@ static int iLngPhonixStandardKey_un
     iLngPhonixReplace2(LNG_PHONIX_ALL,          pwcNewTerm,     L"MPT",     L"MT");
 
 
-    /* Calculate the phonix for the term */
-    iLngPhonixCode(pwcNewTerm, pwcPhonixKey);
+    /* Calculate the phonix for the term, the letter group replacements can leave 
+    ** nothing of the term (a lone 'E' for example), in which case there is no key
+    */
+    if ( bUtlStringsIsWideStringNULL(pwcNewTerm) == false ) {
+        iLngPhonixCode(pwcNewTerm, pwcPhonixKey);
+    }
 
 
     /* Free the new term */
@@ -759,7 +763,7 @@ static int iLngPhonixCode
 
 
     ASSERT(bUtlStringsIsWideStringNULL(pwcTerm) == false);
-    ASSERT(bUtlStringsIsWideStringNULL(pwcPhonixKey) == false);
+    ASSERT(pwcPhonixKey != NULL);
 
 
     /* Set default phonix key */
@@ -787,8 +791,8 @@ static int iLngPhonixCode
             if ( wcLastLetter != *pwcTermPtr ) {
                 wcLastLetter = *pwcTermPtr;
 
-                /* Ignore letters with code 0 except as separators */
-                if ( piCodeList[towupper(*pwcTermPtr) - L'A'] != 0 ) {
+                /* Ignore letters with code 0 except as separators, and letters outside A-Z which have no code */
+                if ( (towupper(*pwcTermPtr) >= L'A') && (towupper(*pwcTermPtr) <= L'Z') && (piCodeList[towupper(*pwcTermPtr) - L'A'] != 0) ) {
                       pwcPhonixKey[uiIndex] = L'0' + (wint_t)piCodeList[towupper(*pwcTermPtr) - L'A'];
                     uiIndex++;
                 }
@@ -823,9 +827,9 @@ static int iLngPhonixCode
                 LNG_PHONIX_START).
 
     Parameters: uiWhere         replace pwcOldString only if it occurs at this position
-                pwcTerm         string to work
+                pwcTerm         string to work, can become empty as letter groups are deleted
                 pwcOldString    old letter group to delete
-                pwcNewString    new letter group to insert
+                pwcNewString    new letter group to insert, empty to delete pwcOldString
                 uiCondPre       condition referring to letter before pwcOldString
                 uiCondPost      condition referring to letter after pwcOldString
 
@@ -856,9 +860,9 @@ static int iLngPhonixReplace1
     boolean     bOkayPost = false;      /* Post-condition okay? */
 
 
-    ASSERT(bUtlStringsIsWideStringNULL(pwcTerm) == false);
+    ASSERT(pwcTerm != NULL);
     ASSERT(bUtlStringsIsWideStringNULL(pwcOldString) == false);
-    ASSERT(bUtlStringsIsWideStringNULL(pwcNewString) == false);
+    ASSERT(pwcNewString != NULL);
 
 
     do  { 
@@ -959,9 +963,9 @@ static int iLngPhonixReplace1
                 with a V because of the condition LNG_PHONIX_START.
 
     Parameters: uiWhere         replace pwcOldString only if it occurs at this position
-                pwcTerm         string to work
+                pwcTerm         string to work, can become empty as letter groups are deleted
                 pwcOldString    old letter group to delete
-                pwcNewString    new letter group to insert
+                pwcNewString    new letter group to insert, empty to delete pwcOldString
 
     Globals:    none
 
@@ -982,9 +986,9 @@ static int iLngPhonixReplace2
     wchar_t     *pwcTermPtr = pwcTerm;
 
 
-    ASSERT(bUtlStringsIsWideStringNULL(pwcTerm) == false);
+    ASSERT(pwcTerm != NULL);
     ASSERT(bUtlStringsIsWideStringNULL(pwcOldString) == false);
-    ASSERT(bUtlStringsIsWideStringNULL(pwcNewString) == false);
+    ASSERT(pwcNewString != NULL);
 
 
     do { 
@@ -119,6 +119,49 @@
 #define VRF_LOCALE_NAME_DEFAULT                             LNG_LOCALE_EN_US_UTF_8_NAME
 
 
+/* Number of keys and key length for the dictionary test, the keys are the numbers 
+** from 1 up, which gives plenty of shared prefixes and keys which are prefixes of others
+*/
+#define VRF_TEST_DICTIONARY_KEY_COUNT                       (100000)
+#define VRF_TEST_DICTIONARY_KEY_LENGTH                      (15)
+
+
+/* Number of values covered by the roaring test, this covers eight containers */
+#define VRF_TEST_ROARING_BITMAP_LENGTH                      (8 * 65536)
+
+
+/* Maximum number of postings in each postings array in the loser tree test */
+#define VRF_TEST_LOSER_TREE_POSTINGS_LENGTH_MAX             (2000)
+
+/* Maximum number of terms looked up in the phonetic keys test, each lookup without
+** the phonetic key dictionaries scans the whole term dictionary
+*/
+#define VRF_TEST_PHONETIC_KEYS_TERM_COUNT_MAX               (1000)
+
+/* Next pseudo random number, the test needs to be repeatable */
+#define VRF_TEST_NEXT_RANDOM(uiMacroRandom)                 ((uiMacroRandom) = ((uiMacroRandom) * 1103515245) + 12345)
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Globals
+*/
+
+/* Number of values in the containers of the two roaring structures in the roaring test, 
+** these give empty containers, array containers up to the maximum array length,
+** bitmap containers just beyond it, and full containers
+*/
+static unsigned int puiTestRoaringValuesCounts1Global[] = {0, 100, 4096, 4097, 30000, 65536, 2000, 50000};
+static unsigned int puiTestRoaringValuesCounts2Global[] = {5000, 0, 4096, 100, 65536, 30000, 4097, 1};
+
+/* Number of postings arrays merged in each round of the loser tree test, 
+** these cover trees with one leaf, with a power of two leaves and without
+*/
+static unsigned int puiTestLoserTreeSrchPostingsListLengthsGlobal[] = {1, 2, 3, 4, 5, 8, 13, 16, 33, 100};
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -166,6 +209,24 @@ static void vListTemporaryIndexFile (unsigned char *pucTemporaryIndexFilePath, b
 
 static void    vTest (void);
 
+static void vTestDictionary (unsigned char *pucDictionaryFilePath);
+static int iTestDictionaryCompareKeys (unsigned char *pucKey1, unsigned char *pucKey2);
+static int iTestDictionaryCallBack (unsigned char *pucKey, void *pvEntryData, unsigned int uiEntryLength, va_list ap);
+
+static void vTestRoaring (void);
+static void vTestRoaringCreate (unsigned int *puiValuesCounts, unsigned int uiStep, 
+        void **ppvUtlRoaring, unsigned char *pucBitmap);
+static void vTestRoaringCheck (void *pvUtlRoaring, unsigned char *pucBitmap, unsigned char *pucName);
+
+static void vTestLoserTree (void);
+static int iTestLoserTreeCompareSrchPostings (struct srchPosting *pspSrchPosting1, struct srchPosting *pspSrchPosting2);
+
+static void vTestPhoneticKeys (unsigned char *pucIndexDirectoryPath, unsigned char *pucConfigurationDirectoryPath,
+        unsigned char *pucIndexName);
+static int iTestPhoneticKeysCallBack (unsigned char *pucKey, void *pvEntryData, unsigned int uiEntryLength, va_list ap);
+static int iTestPhoneticKeysCompareSrchTermDictInfos (struct srchTermDictInfo *pstdiSrchTermDictInfo1, 
+        struct srchTermDictInfo *pstdiSrchTermDictInfo2);
+
 
 /*---------------------------------------------------------------------------*/
 
@@ -212,6 +273,10 @@ int main
     boolean         bListDocumentKeys = false;
     boolean         bListStats = false;
     boolean         bTest = false;
+    unsigned char   *pucTestDictionaryFilePath = NULL;
+    boolean         bTestRoaring = false;
+    boolean         bTestLoserTree = false;
+    boolean         bTestPhoneticKeys = false;
 
     unsigned char   pucTemporaryIndexFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
     boolean         bListIndexBlockHeader = false;
@@ -511,6 +576,37 @@ int main
             bTest = true;
         }
 
+        /* Check for test dictionary */
+        else if ( s_strncmp("--test-dictionary=", pucNextArgument, s_strlen("--test-dictionary=")) == 0 ) {
+
+            /* Get the test dictionary file path */
+            pucNextArgument += s_strlen("--test-dictionary=");
+
+            /* Set the test dictionary file path */
+            pucTestDictionaryFilePath = pucNextArgument;
+        }
+
+        /* Check for test roaring */
+        else if ( s_strcmp("--test-roaring", pucNextArgument) == 0 ) {
+
+            /* Set the test roaring flag */
+            bTestRoaring = true;
+        }
+
+        /* Check for test loser tree */
+        else if ( s_strcmp("--test-loser-tree", pucNextArgument) == 0 ) {
+
+            /* Set the test loser tree flag */
+            bTestLoserTree = true;
+        }
+
+        /* Check for test phonetic keys */
+        else if ( s_strcmp("--test-phonetic-keys", pucNextArgument) == 0 ) {
+
+            /* Set the test phonetic keys flag */
+            bTestPhoneticKeys = true;
+        }
+
         /* Check for locale */
         else if ( s_strncmp("--locale=", pucNextArgument, s_strlen("--locale=")) == 0 ) {
 
@@ -621,8 +717,11 @@ int main
     }
 
     
-    /* Check for index name, index directory and configuration directory paths if the temporary index file path is not provided */
-    if ( bUtlStringsIsStringNULL(pucTemporaryIndexFilePath) == true ) { 
+    /* Check for index name, index directory and configuration directory paths if the temporary index file path 
+    ** is not provided and if we are not running a test which does not need an index
+    */
+    if ( (bUtlStringsIsStringNULL(pucTemporaryIndexFilePath) == true) && (bUtlStringsIsStringNULL(pucTestDictionaryFilePath) == true) && 
+            (bTestRoaring == false) && (bTestLoserTree == false) ) { 
 
         /* Check for index name */
         if ( bUtlStringsIsStringNULL(pucIndexName) == true ) {
@@ -708,6 +807,22 @@ int main
         vTest();
     }
 
+    else if ( bUtlStringsIsStringNULL(pucTestDictionaryFilePath) == false ) {
+        vTestDictionary(pucTestDictionaryFilePath);
+    }
+
+    else if ( bTestRoaring == true ) {
+        vTestRoaring();
+    }
+
+    else if ( bTestLoserTree == true ) {
+        vTestLoserTree();
+    }
+
+    else if ( bTestPhoneticKeys == true ) {
+        vTestPhoneticKeys(pucIndexDirectoryPath, pucConfigurationDirectoryPath, pucIndexName);
+    }
+
 
     printf("\n\nFinished...\n");
 
@@ -858,6 +973,17 @@ static void vUsage
 
     printf("Test: \n");
     printf("  --test           Run the test function. \n");
+    printf("  --test-dictionary=name \n");
+    printf("                  Create a dictionary in the named file, check that every key \n");
+    printf("                  and entry round trips through it, and remove the file. \n");
+    printf("  --test-roaring   Check that roaring structures round trip through serialization \n");
+    printf("                  and bitmaps, and that they merge like bitmaps. \n");
+    printf("  --test-loser-tree \n");
+    printf("                  Check that merging postings arrays over the loser tree \n");
+    printf("                  matches sorting them. \n");
+    printf("  --test-phonetic-keys \n");
+    printf("                  Check that soundex, metaphone and phonix lookups of the index terms \n");
+    printf("                  match the same terms with and without the phonetic key dictionaries. \n");
     printf("\n");
 
     printf(" Locale parameter: \n");
@@ -1085,6 +1211,11 @@ static int iListTermsCallBack
     UTL_NUM_READ_COMPRESSED_UINT(uiDocumentCount, pucEntryDataPtr);
     UTL_NUM_READ_COMPRESSED_ULONG(ulIndexBlockID, pucEntryDataPtr);
 
+    /* Skip the term ID, the field IDs follow it */
+    if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS ) {
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucEntryDataPtr);
+    }
+
 
     /* Filter out regular terms if we are not listing them */
     if ( (bListTerms == false) && (uiTermType == SPI_TERM_TYPE_REGULAR) ) {
@@ -1130,13 +1261,17 @@ static int iListTermsCallBack
         int             iError = UTL_NoError;
         unsigned char   *pucIndexBlock = NULL;
         unsigned char   *pucIndexBlockPtr = NULL;
+        unsigned char   *pucIndexBlockEndPtr = NULL;
         unsigned int    uiIndexBlockLength = 0;
         unsigned int    uiIndexBlockHeaderLength = 0;
         unsigned int    uiIndexBlockDataLength = 0;
 
+        unsigned int    puiIndexEntries[SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH];
+        unsigned int    uiIndexEntriesLength = 0;
+        unsigned int    *puiIndexEntriesPtr = NULL;
+        unsigned int    *puiIndexEntriesEnd = NULL;
+
         unsigned int    uiIndexEntryDeltaDocumentID = 0;
-        unsigned int    uiIndexEntryTermPosition = 0;
-        unsigned int    uiIndexEntryFieldID = 0;
         unsigned int    uiIndexEntryDocumentID = 0;
 
         boolean         bListTerm = false;
@@ -1148,25 +1283,38 @@ static int iListTermsCallBack
         }
 
         /* Get the size of the index block */
-        pucIndexBlockPtr = pucIndexBlock;
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexBlockDataLength, pucIndexBlockPtr);
-        ASSERT(uiIndexBlockDataLength < uiIndexBlockLength);
-        uiIndexBlockHeaderLength = pucIndexBlockPtr - pucIndexBlock;
+        if ( (iError = iSrchTermSearchGetIndexBlockHeader(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, &uiIndexBlockHeaderLength, 
+                &uiIndexBlockDataLength, NULL, NULL, NULL, NULL)) != SRCH_NoError ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to get the index block header, index object ID: %lu, index: '%s', srch error: %d.", 
+                    ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+        }
 
+        /* Get the index entries, we dont need the term positions */
+        if ( (iError = iSrchTermSearchGetIndexBlockStreams(psiSrchIndex, pucIndexBlock + uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+                &pucIndexBlockPtr, &pucIndexBlockEndPtr, NULL)) != SRCH_NoError ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to get the index block streams, index object ID: %lu, index: '%s', srch error: %d.", 
+                    ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+        }
 
-        /* Loop over the index block */
-        while ( pucIndexBlockPtr < (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength) ) {
 
-            /* Read the index entry */
+        /* Loop over the index block */
+        while ( (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr) ) {
+
+            /* Decode the next index entries if we have used them all up, this handles bit packed and split index blocks */
+            if ( puiIndexEntriesPtr >= puiIndexEntriesEnd ) {
+                if ( (iError = iSrchTermSearchDecodeIndexEntries(psiSrchIndex, &pucIndexBlockPtr, pucIndexBlockEndPtr, NULL, 
+                        puiIndexEntries, &uiIndexEntriesLength)) != SRCH_NoError ) {
+                    iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to decode the index block, index object ID: %lu, index: '%s', srch error: %d.", 
+                            ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+                }
+                ASSERT(pucIndexBlockPtr <= pucIndexBlockEndPtr);
+                puiIndexEntriesPtr = puiIndexEntries;
+                puiIndexEntriesEnd = puiIndexEntries + uiIndexEntriesLength;
+            }
 
-            UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-            ASSERT(pucIndexBlockPtr <= (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength));
-            
-            UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermPosition, pucIndexBlockPtr);
-            ASSERT(pucIndexBlockPtr <= (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength));
-            
-            UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
-            ASSERT(pucIndexBlockPtr <= (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength));
+            /* Read the index entry, we only need the document ID */
+            uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+            puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 
             /* Document IDs get stored as deltas (note that 0 is a valid delta) */
             uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
@@ -1291,6 +1439,7 @@ static void vListTerm
     unsigned int        uiTermCount = 0;
     unsigned int        uiDocumentCount = 0;
     unsigned long       ulIndexBlockID = 0;
+    unsigned int        uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
     
     unsigned char       *pucFieldIDBitmap = NULL;
     unsigned long       uiFieldIDBitmapLength = 0;
@@ -1351,7 +1500,7 @@ static void vListTerm
 
     /* Look up the term in the term dictionary */
     if ( (iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, pucFieldIDBitmap, uiFieldIDBitmapLength, 
-            &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID)) != SRCH_NoError ) {
+            &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID)) != SRCH_NoError ) {
         iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to lookup the term, srch error: %d", iError);
     }
 
@@ -1431,10 +1580,17 @@ static void vListIndexBlock
 
     unsigned char   *pucIndexBlock = NULL;
     unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned char   *pucIndexBlockEndPtr = NULL;
+    unsigned char   *pucTermPositionsPtr = NULL;
     unsigned int    uiIndexBlockLength = 0;
     unsigned int    uiIndexBlockHeaderLength = 0;
     unsigned int    uiIndexBlockDataLength = 0;
 
+    unsigned int    puiIndexEntries[SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH];
+    unsigned int    uiIndexEntriesLength = 0;
+    unsigned int    *puiIndexEntriesPtr = NULL;
+    unsigned int    *puiIndexEntriesEnd = NULL;
+
     unsigned int    uiIndexEntryDeltaDocumentID = 0;
     unsigned int    uiIndexEntryTermPosition = 0;
     unsigned int    uiIndexEntryFieldID = 0;
@@ -1457,27 +1613,42 @@ static void vListIndexBlock
 
 
     /* Get the size of the index block */
-    pucIndexBlockPtr = pucIndexBlock;
-    UTL_NUM_READ_COMPRESSED_UINT(uiIndexBlockDataLength, pucIndexBlockPtr);
-    ASSERT(uiIndexBlockDataLength < uiIndexBlockLength);
-    uiIndexBlockHeaderLength = pucIndexBlockPtr - pucIndexBlock;
+    if ( (iError = iSrchTermSearchGetIndexBlockHeader(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, &uiIndexBlockHeaderLength, 
+            &uiIndexBlockDataLength, NULL, NULL, NULL, NULL)) != SRCH_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to get the index block header, index object ID: %lu, index: '%s', srch error: %d.", 
+                ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+    }
+
+    /* Get the index entries and the term positions */
+    if ( (iError = iSrchTermSearchGetIndexBlockStreams(psiSrchIndex, pucIndexBlock + uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+            &pucIndexBlockPtr, &pucIndexBlockEndPtr, &pucTermPositionsPtr)) != SRCH_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to get the index block streams, index object ID: %lu, index: '%s', srch error: %d.", 
+                ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+    }
 
 
     printf("  Index block ID: %lu, Size: %u\n", ulIndexBlockID, uiIndexBlockDataLength);
 
     /* Loop over the index block */
-    while ( pucIndexBlockPtr < (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength) ) {
+    while ( (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr) ) {
+
+        /* Decode the next index entries if we have used them all up, this handles bit packed and split index blocks */
+        if ( puiIndexEntriesPtr >= puiIndexEntriesEnd ) {
+            if ( (iError = iSrchTermSearchDecodeIndexEntries(psiSrchIndex, &pucIndexBlockPtr, pucIndexBlockEndPtr, &pucTermPositionsPtr, 
+                    puiIndexEntries, &uiIndexEntriesLength)) != SRCH_NoError ) {
+                iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to decode the index block, index object ID: %lu, index: '%s', srch error: %d.", 
+                        ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+            }
+            ASSERT(pucIndexBlockPtr <= pucIndexBlockEndPtr);
+            puiIndexEntriesPtr = puiIndexEntries;
+            puiIndexEntriesEnd = puiIndexEntries + uiIndexEntriesLength;
+        }
 
         /* Read the index entry */
-
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-        ASSERT(pucIndexBlockPtr <= (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength));
-        
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermPosition, pucIndexBlockPtr);
-        ASSERT(pucIndexBlockPtr <= (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength));
-        
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
-        ASSERT(pucIndexBlockPtr <= (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength));
+        uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+        uiIndexEntryTermPosition = puiIndexEntriesPtr[1];
+        uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+        puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 
         /* Document IDs get stored as deltas (note that 0 is a valid delta) */
         uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
@@ -2606,3 +2777,1058 @@ static void vTest
 
 /*---------------------------------------------------------------------------*/
 
+
+/*
+
+    Function:   vTestDictionary()
+
+    Purpose:    This function creates a dictionary, adds the numbers from 1 up 
+                to it in key order with the number as the entry, and reopens it
+                to check that each key is found with its entry, that keys which 
+                were not added are not found, and that listing the entries from 
+                the first key and from a key half way through returns the keys 
+                that follow in order. The dictionary file is removed afterwards.
+
+                Any failure is fatal.
+
+    Parameters: pucDictionaryFilePath   dictionary file path
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vTestDictionary
+(
+    unsigned char *pucDictionaryFilePath
+)
+{
+
+    int             iError = UTL_NoError;
+    void            *pvUtlDict = NULL;
+    unsigned char   (*ppucKeys)[VRF_TEST_DICTIONARY_KEY_LENGTH + 1] = NULL;
+    unsigned char   pucKey[VRF_TEST_DICTIONARY_KEY_LENGTH + 1] = {'\0'};
+    unsigned char   pucEntryData[UTL_NUM_UINT_MAX_SIZE + 1] = {'\0'};
+    unsigned char   *pucEntryDataPtr = NULL;
+    unsigned int    uiEntryLength = 0;
+    unsigned int    uiEntry = 0;
+    unsigned int    uiKeyIndex = 0;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucDictionaryFilePath) == false);
+
+
+    printf("Testing dictionary: '%s', keys: %u.\n", pucDictionaryFilePath, VRF_TEST_DICTIONARY_KEY_COUNT); 
+
+
+    /* Allocate the keys */
+    if ( (ppucKeys = s_malloc((size_t)(sizeof(*ppucKeys) * VRF_TEST_DICTIONARY_KEY_COUNT))) == NULL ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Memory allocation error");
+    }
+
+    /* Create the keys and sort them in key order */
+    for ( uiI = 0; uiI < VRF_TEST_DICTIONARY_KEY_COUNT; uiI++ ) {
+        snprintf(ppucKeys[uiI], VRF_TEST_DICTIONARY_KEY_LENGTH + 1, "%u", uiI + 1);
+    }
+
+    s_qsort(ppucKeys, VRF_TEST_DICTIONARY_KEY_COUNT, sizeof(*ppucKeys), (int (*)())iTestDictionaryCompareKeys);
+
+
+    /* Create the dictionary */
+    if ( (iError = iUtlDictCreate(pucDictionaryFilePath, VRF_TEST_DICTIONARY_KEY_LENGTH, &pvUtlDict)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to create the dictionary: '%s', utl error: %d", pucDictionaryFilePath, iError);
+    }
+
+    /* Add the keys, the entry is the number in the key */
+    for ( uiI = 0; uiI < VRF_TEST_DICTIONARY_KEY_COUNT; uiI++ ) {
+
+        pucEntryDataPtr = pucEntryData;
+        UTL_NUM_WRITE_COMPRESSED_UINT(s_strtol(ppucKeys[uiI], NULL, 10), pucEntryDataPtr);
+
+        if ( (iError = iUtlDictAddEntry(pvUtlDict, ppucKeys[uiI], pucEntryData, pucEntryDataPtr - pucEntryData)) != UTL_NoError ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to add a key to the dictionary, key: '%s', utl error: %d", ppucKeys[uiI], iError);
+        }
+    }
+
+    /* Close the dictionary, this writes it out */
+    if ( (iError = iUtlDictClose(pvUtlDict)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to close the dictionary: '%s', utl error: %d", pucDictionaryFilePath, iError);
+    }
+    pvUtlDict = NULL;
+
+
+    /* Open the dictionary */
+    if ( (iError = iUtlDictOpen(pucDictionaryFilePath, &pvUtlDict)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to open the dictionary: '%s', utl error: %d", pucDictionaryFilePath, iError);
+    }
+
+
+    /* Check that each key is found with its entry, and that the key with a letter after it is not found */
+    for ( uiI = 0; uiI < VRF_TEST_DICTIONARY_KEY_COUNT; uiI++ ) {
+
+        if ( (iError = iUtlDictGetEntry(pvUtlDict, ppucKeys[uiI], (void **)&pucEntryDataPtr, &uiEntryLength)) != UTL_NoError ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to get a key from the dictionary, key: '%s', utl error: %d", ppucKeys[uiI], iError);
+        }
+
+        UTL_NUM_READ_COMPRESSED_UINT(uiEntry, pucEntryDataPtr);
+        if ( uiEntry != s_strtol(ppucKeys[uiI], NULL, 10) ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Got the wrong entry from the dictionary, key: '%s', entry: %u", ppucKeys[uiI], uiEntry);
+        }
+
+        snprintf(pucKey, VRF_TEST_DICTIONARY_KEY_LENGTH + 1, "%sx", ppucKeys[uiI]);
+        if ( (iError = iUtlDictGetEntry(pvUtlDict, pucKey, (void **)&pucEntryDataPtr, &uiEntryLength)) != UTL_DictKeyNotFound ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Found a key which was not added to the dictionary, key: '%s', utl error: %d", pucKey, iError);
+        }
+    }
+
+    /* Check that keys before the first key and after the last key are not found */
+    if ( (iError = iUtlDictGetEntry(pvUtlDict, "0", (void **)&pucEntryDataPtr, &uiEntryLength)) != UTL_DictKeyNotFound ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Found a key which was not added to the dictionary, key: '0', utl error: %d", iError);
+    }
+    if ( (iError = iUtlDictGetEntry(pvUtlDict, "a", (void **)&pucEntryDataPtr, &uiEntryLength)) != UTL_DictKeyNotFound ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Found a key which was not added to the dictionary, key: 'a', utl error: %d", iError);
+    }
+
+
+    /* Check that listing the entries from the first key and from a key half way through returns the keys in order */
+    for ( uiI = 0; uiI < VRF_TEST_DICTIONARY_KEY_COUNT; uiI += (VRF_TEST_DICTIONARY_KEY_COUNT / 2) ) {
+
+        uiKeyIndex = uiI;
+
+        if ( (iError = iUtlDictProcessEntryList(pvUtlDict, ppucKeys[uiI], iTestDictionaryCallBack, ppucKeys, &uiKeyIndex)) != UTL_NoError ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to list the dictionary from key: '%s', utl error: %d", ppucKeys[uiI], iError);
+        }
+
+        if ( uiKeyIndex != VRF_TEST_DICTIONARY_KEY_COUNT ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Listing the dictionary from key: '%s', stopped at key: '%s'", ppucKeys[uiI], ppucKeys[uiKeyIndex]);
+        }
+    }
+
+
+    /* Close the dictionary */
+    if ( (iError = iUtlDictClose(pvUtlDict)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to close the dictionary: '%s', utl error: %d", pucDictionaryFilePath, iError);
+    }
+    pvUtlDict = NULL;
+
+
+    /* Remove the dictionary and free the keys */
+    s_remove(pucDictionaryFilePath);
+    s_free(ppucKeys);
+
+
+    printf("Dictionary test passed.\n"); 
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iTestDictionaryCompareKeys()
+
+    Purpose:    This function is passed to s_qsort() to sort the dictionary 
+                test keys in key order.
+
+    Parameters: pucKey1     key 1
+                pucKey2     key 2
+
+    Globals:    none
+
+    Returns:    1 if pucKey1 > pucKey2, -1 if pucKey1 < pucKey2, 0 if equal
+
+*/
+static int iTestDictionaryCompareKeys
+(
+    unsigned char *pucKey1,
+    unsigned char *pucKey2
+)
+{
+
+    ASSERT(pucKey1 != NULL);
+    ASSERT(pucKey2 != NULL);
+
+
+    return (s_strcmp(pucKey1, pucKey2));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iTestDictionaryCallBack()
+
+    Purpose:    This function is passed to the dictionary list function to
+                check that the keys come back in order, listing may start
+                a few keys before the key asked for, those are skipped.
+
+    Parameters: pucKey          key
+                pvEntryData     entry data
+                uiEntryLength   entry length
+                ap              args (optional)
+
+    Globals:    none
+
+    Returns:    0 to continue processing, non-0 otherwise
+
+*/
+static int iTestDictionaryCallBack
+(
+    unsigned char *pucKey,
+    void *pvEntryData,
+    unsigned int uiEntryLength,
+    va_list ap
+)
+{
+
+    va_list         ap_;
+    unsigned char   (*ppucKeys)[VRF_TEST_DICTIONARY_KEY_LENGTH + 1] = NULL;
+    unsigned int    *puiKeyIndex = NULL;
+    unsigned char   *pucEntryDataPtr = (unsigned char *)pvEntryData;
+    unsigned int    uiEntry = 0;
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(pvEntryData != NULL);
+    ASSERT(uiEntryLength > 0);
+
+
+    /* Get all our parameters, note that we make a copy of 'ap' */
+    va_copy(ap_, ap);
+    ppucKeys = (unsigned char (*)[VRF_TEST_DICTIONARY_KEY_LENGTH + 1])va_arg(ap_, unsigned char *);
+    puiKeyIndex = (unsigned int *)va_arg(ap_, unsigned int *);
+    va_end(ap_);
+
+    ASSERT(ppucKeys != NULL);
+    ASSERT(puiKeyIndex != NULL);
+
+
+    /* Skip the keys before the key we asked for */
+    if ( (*puiKeyIndex < VRF_TEST_DICTIONARY_KEY_COUNT) && (s_strcmp(pucKey, ppucKeys[*puiKeyIndex]) < 0) ) {
+        return (0);
+    }
+
+    /* Check the key and its entry */
+    if ( *puiKeyIndex >= VRF_TEST_DICTIONARY_KEY_COUNT ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Listed a key which was not added to the dictionary, key: '%s'", pucKey);
+    }
+
+    if ( s_strcmp(pucKey, ppucKeys[*puiKeyIndex]) != 0 ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Listed the wrong key from the dictionary, key: '%s', expected key: '%s'", pucKey, ppucKeys[*puiKeyIndex]);
+    }
+
+    UTL_NUM_READ_COMPRESSED_UINT(uiEntry, pucEntryDataPtr);
+    if ( uiEntry != s_strtol(pucKey, NULL, 10) ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Listed the wrong entry from the dictionary, key: '%s', entry: %u", pucKey, uiEntry);
+    }
+
+    (*puiKeyIndex)++;
+
+
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vTestRoaring()
+
+    Purpose:    This function creates two roaring structures with a mix of 
+                empty, array and bitmap containers, alongside the bitmaps 
+                holding the same values, and checks that they match their 
+                bitmaps, that they still do after being serialized and 
+                deserialized and after being recreated from their bitmaps, 
+                and that merging them matches merging their bitmaps.
+
+                Any failure is fatal.
+
+    Parameters: none
+
+    Globals:    puiTestRoaringValuesCounts1Global, puiTestRoaringValuesCounts2Global
+
+    Returns:    void
+
+*/
+static void vTestRoaring
+(
+
+)
+{
+
+    int             iError = UTL_NoError;
+    void            *pvUtlRoaring1 = NULL;
+    void            *pvUtlRoaring2 = NULL;
+    void            *pvUtlRoaring = NULL;
+    unsigned char   *pucBitmap1 = NULL;
+    unsigned char   *pucBitmap2 = NULL;
+    unsigned char   *pucBitmap = NULL;
+    unsigned char   *pucBuffer = NULL;
+    unsigned int    uiSerializedLength = 0;
+    unsigned int    uiBufferLength = 0;
+    unsigned int    uiBitmapByteLength = UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(VRF_TEST_ROARING_BITMAP_LENGTH);
+    unsigned int    uiMergeType = UTL_ROARING_MERGE_TYPE_INVALID;
+    unsigned int    uiI = 0;
+
+
+    printf("Testing roaring, values: %u.\n", VRF_TEST_ROARING_BITMAP_LENGTH); 
+
+
+    /* Allocate the bitmaps */
+    if ( ((pucBitmap1 = (unsigned char *)s_malloc((size_t)uiBitmapByteLength)) == NULL) ||
+            ((pucBitmap2 = (unsigned char *)s_malloc((size_t)uiBitmapByteLength)) == NULL) ||
+            ((pucBitmap = (unsigned char *)s_malloc((size_t)uiBitmapByteLength)) == NULL) ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Memory allocation error");
+    }
+
+
+    /* Create the roaring structures and check them */
+    vTestRoaringCreate(puiTestRoaringValuesCounts1Global, 40503, &pvUtlRoaring1, pucBitmap1);
+    vTestRoaringCheck(pvUtlRoaring1, pucBitmap1, "created 1");
+
+    vTestRoaringCreate(puiTestRoaringValuesCounts2Global, 7, &pvUtlRoaring2, pucBitmap2);
+    vTestRoaringCheck(pvUtlRoaring2, pucBitmap2, "created 2");
+
+
+    /* Serialize and deserialize the first roaring structure and check it */
+    if ( (iError = iUtlRoaringGetSerializedLength(pvUtlRoaring1, &uiSerializedLength)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to get the roaring serialized length, utl error: %d", iError);
+    }
+
+    if ( (pucBuffer = (unsigned char *)s_malloc((size_t)uiSerializedLength)) == NULL ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Memory allocation error");
+    }
+
+    if ( (iError = iUtlRoaringSerialize(pvUtlRoaring1, pucBuffer, &uiBufferLength)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to serialize the roaring, utl error: %d", iError);
+    }
+
+    if ( uiBufferLength != uiSerializedLength ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Serialized the roaring to: %u bytes, expected: %u bytes", uiBufferLength, uiSerializedLength);
+    }
+
+    if ( (iError = iUtlRoaringDeserialize(pucBuffer, uiBufferLength, &pvUtlRoaring)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to deserialize the roaring, utl error: %d", iError);
+    }
+
+    vTestRoaringCheck(pvUtlRoaring, pucBitmap1, "deserialized");
+
+    iUtlRoaringFree(pvUtlRoaring);
+    pvUtlRoaring = NULL;
+    s_free(pucBuffer);
+
+
+    /* Recreate the second roaring structure from its bitmap and check it */
+    if ( (iError = iUtlRoaringCreateFromBitmap(pucBitmap2, VRF_TEST_ROARING_BITMAP_LENGTH, &pvUtlRoaring)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to create the roaring from a bitmap, utl error: %d", iError);
+    }
+
+    vTestRoaringCheck(pvUtlRoaring, pucBitmap2, "from bitmap");
+
+    iUtlRoaringFree(pvUtlRoaring);
+    pvUtlRoaring = NULL;
+
+
+    /* Merge the roaring structures each way and check them against the merged bitmaps */
+    for ( uiMergeType = UTL_ROARING_MERGE_TYPE_XOR; UTL_ROARING_MERGE_TYPE_VALID(uiMergeType) == true; uiMergeType++ ) {
+
+        for ( uiI = 0; uiI < uiBitmapByteLength; uiI++ ) {
+            switch ( uiMergeType ) {
+                case UTL_ROARING_MERGE_TYPE_XOR:
+                    pucBitmap[uiI] = pucBitmap1[uiI] ^ pucBitmap2[uiI];
+                    break;
+                case UTL_ROARING_MERGE_TYPE_OR:
+                    pucBitmap[uiI] = pucBitmap1[uiI] | pucBitmap2[uiI];
+                    break;
+                case UTL_ROARING_MERGE_TYPE_AND:
+                    pucBitmap[uiI] = pucBitmap1[uiI] & pucBitmap2[uiI];
+                    break;
+                case UTL_ROARING_MERGE_TYPE_NOT:
+                    pucBitmap[uiI] = pucBitmap1[uiI] & ~pucBitmap2[uiI];
+                    break;
+            }
+        }
+
+        if ( (iError = iUtlRoaringMerge(pvUtlRoaring1, pvUtlRoaring2, uiMergeType, &pvUtlRoaring)) != UTL_NoError ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to merge the roarings, merge type: %u, utl error: %d", uiMergeType, iError);
+        }
+
+        vTestRoaringCheck(pvUtlRoaring, pucBitmap, 
+                (uiMergeType == UTL_ROARING_MERGE_TYPE_XOR) ? "xor" : (uiMergeType == UTL_ROARING_MERGE_TYPE_OR) ? "or" : 
+                (uiMergeType == UTL_ROARING_MERGE_TYPE_AND) ? "and" : "not");
+
+        iUtlRoaringFree(pvUtlRoaring);
+        pvUtlRoaring = NULL;
+    }
+
+
+    /* Free everything */
+    iUtlRoaringFree(pvUtlRoaring1);
+    iUtlRoaringFree(pvUtlRoaring2);
+    s_free(pucBitmap1);
+    s_free(pucBitmap2);
+    s_free(pucBitmap);
+
+
+    printf("Roaring test passed.\n"); 
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vTestRoaringCreate()
+
+    Purpose:    This function creates a roaring structure and the bitmap holding
+                the same values. The values in each container are spread out by
+                stepping through it with an odd step, so the values counts give
+                exactly that many distinct values and they are not added in order.
+
+    Parameters: puiValuesCounts     number of values in each container
+                uiStep              step, must be odd
+                ppvUtlRoaring       return pointer for the roaring structure
+                pucBitmap           bitmap
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vTestRoaringCreate
+(
+    unsigned int *puiValuesCounts,
+    unsigned int uiStep,
+    void **ppvUtlRoaring,
+    unsigned char *pucBitmap
+)
+{
+
+    int             iError = UTL_NoError;
+    unsigned int    uiKey = 0;
+    unsigned int    uiI = 0;
+    unsigned int    uiValue = 0;
+
+
+    ASSERT(puiValuesCounts != NULL);
+    ASSERT((uiStep % 2) == 1);
+    ASSERT(ppvUtlRoaring != NULL);
+    ASSERT(pucBitmap != NULL);
+
+
+    /* Create the roaring structure and clear the bitmap */
+    if ( (iError = iUtlRoaringCreate(ppvUtlRoaring)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to create the roaring, utl error: %d", iError);
+    }
+
+    UTL_BITMAP_CLEAR_POINTER(pucBitmap, VRF_TEST_ROARING_BITMAP_LENGTH);
+
+
+    /* Add the values to each container */
+    for ( uiKey = 0; uiKey < (VRF_TEST_ROARING_BITMAP_LENGTH / 65536); uiKey++ ) {
+
+        for ( uiI = 0; uiI < puiValuesCounts[uiKey]; uiI++ ) {
+
+            uiValue = (uiKey * 65536) + (((uiI * uiStep) + uiKey) % 65536);
+
+            if ( (iError = iUtlRoaringAddValue(*ppvUtlRoaring, uiValue)) != UTL_NoError ) {
+                iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to add a value to the roaring, value: %u, utl error: %d", uiValue, iError);
+            }
+
+            UTL_BITMAP_SET_BIT_IN_POINTER(pucBitmap, uiValue);
+        }
+    }
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vTestRoaringCheck()
+
+    Purpose:    This function checks that a roaring structure holds the values 
+                set in a bitmap, checking the values count, whether each value
+                is contained, the next value from every value, and the bitmap
+                the roaring structure gives back.
+
+    Parameters: pvUtlRoaring    roaring structure
+                pucBitmap       bitmap
+                pucName         name for the check
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vTestRoaringCheck
+(
+    void *pvUtlRoaring,
+    unsigned char *pucBitmap,
+    unsigned char *pucName
+)
+{
+
+    int             iError = UTL_NoError;
+    unsigned char   *pucRoaringBitmap = NULL;
+    unsigned int    uiBitmapByteLength = UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(VRF_TEST_ROARING_BITMAP_LENGTH);
+    unsigned int    uiValuesCount = 0;
+    unsigned int    uiBitmapValuesCount = 0;
+    unsigned int    uiNextValue = 0;
+    unsigned int    uiBitmapNextValue = VRF_TEST_ROARING_BITMAP_LENGTH;
+    unsigned int    uiValue = 0;
+    boolean         bValue = false;
+
+
+    ASSERT(pvUtlRoaring != NULL);
+    ASSERT(pucBitmap != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucName) == false);
+
+
+    /* Check each value, working down so we know the next value in the bitmap */
+    for ( uiValue = VRF_TEST_ROARING_BITMAP_LENGTH; uiValue > 0; uiValue-- ) {
+
+        bValue = (UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucBitmap, uiValue - 1) != 0) ? true : false;
+
+        if ( bValue == true ) {
+            uiBitmapValuesCount++;
+            uiBitmapNextValue = uiValue - 1;
+        }
+
+        if ( bUtlRoaringContainsValue(pvUtlRoaring, uiValue - 1) != bValue ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Roaring check: '%s', value: %u, is %s in the roaring", pucName, uiValue - 1, (bValue == true) ? "missing" : "wrongly");
+        }
+
+        iError = iUtlRoaringGetNextValue(pvUtlRoaring, uiValue - 1, &uiNextValue);
+        
+        if ( (uiBitmapNextValue == VRF_TEST_ROARING_BITMAP_LENGTH) ? (iError != UTL_RoaringValueNotFound) : 
+                ((iError != UTL_NoError) || (uiNextValue != uiBitmapNextValue)) ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Roaring check: '%s', got the wrong next value from value: %u, utl error: %d", pucName, uiValue - 1, iError);
+        }
+    }
+
+
+    /* Check the values count */
+    if ( (iError = iUtlRoaringGetValuesCount(pvUtlRoaring, &uiValuesCount)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Roaring check: '%s', failed to get the values count, utl error: %d", pucName, iError);
+    }
+
+    if ( uiValuesCount != uiBitmapValuesCount ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Roaring check: '%s', values count: %u, expected: %u", pucName, uiValuesCount, uiBitmapValuesCount);
+    }
+
+
+    /* Check the bitmap */
+    if ( (pucRoaringBitmap = (unsigned char *)s_malloc((size_t)uiBitmapByteLength)) == NULL ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Memory allocation error");
+    }
+
+    if ( (iError = iUtlRoaringGetBitmap(pvUtlRoaring, pucRoaringBitmap, VRF_TEST_ROARING_BITMAP_LENGTH)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Roaring check: '%s', failed to get the bitmap, utl error: %d", pucName, iError);
+    }
+
+    if ( s_memcmp(pucRoaringBitmap, pucBitmap, uiBitmapByteLength) != 0 ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Roaring check: '%s', the bitmap does not match", pucName);
+    }
+
+    s_free(pucRoaringBitmap);
+
+
+    printf("Roaring check: '%s', values: %u, passed.\n", pucName, uiValuesCount); 
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vTestLoserTree()
+
+    Purpose:    This function creates rounds of postings arrays, each sorted in 
+                document ID and term position order, merges them over the loser
+                tree with iSrchPostingMergeSrchPostings(), and checks the result
+                against the postings arrays concatenated and sorted. 
+
+                The postings arrays share document IDs and term positions so 
+                there are plenty of ties, the weight of each posting is the index 
+                of its postings array so the check also covers the ties going to 
+                the lower index, and some postings arrays are empty.
+
+                Any failure is fatal.
+
+    Parameters: none
+
+    Globals:    puiTestLoserTreeSrchPostingsListLengthsGlobal
+
+    Returns:    void
+
+*/
+static void vTestLoserTree
+(
+
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchPosting      **ppspSrchPostingsList = NULL;
+    unsigned int            *puiSrchPostingsLengthList = NULL;
+    unsigned int            uiSrchPostingsListLength = 0;
+    struct srchPosting      *pspSrchPostings = NULL;
+    unsigned int            uiSrchPostingsLength = 0;
+    struct srchPosting      *pspSrchPostingsSorted = NULL;
+    unsigned int            uiSrchPostingsSortedLength = 0;
+    unsigned int            uiRandom = 1;
+    unsigned int            uiDocumentID = 0;
+    unsigned int            uiTermPosition = 0;
+    unsigned int            uiI = 0;
+    unsigned int            uiJ = 0;
+    unsigned int            uiK = 0;
+
+
+    for ( uiI = 0; uiI < (sizeof(puiTestLoserTreeSrchPostingsListLengthsGlobal) / sizeof(unsigned int)); uiI++ ) {
+
+        uiSrchPostingsListLength = puiTestLoserTreeSrchPostingsListLengthsGlobal[uiI];
+
+        /* Allocate the postings arrays list, the postings arrays lengths list and the sorted postings array */
+        if ( ((ppspSrchPostingsList = (struct srchPosting **)s_malloc((size_t)(sizeof(struct srchPosting *) * uiSrchPostingsListLength))) == NULL) ||
+                ((puiSrchPostingsLengthList = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiSrchPostingsListLength))) == NULL) ||
+                ((pspSrchPostingsSorted = (struct srchPosting *)s_malloc((size_t)(sizeof(struct srchPosting) * 
+                        uiSrchPostingsListLength * VRF_TEST_LOSER_TREE_POSTINGS_LENGTH_MAX))) == NULL) ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Memory allocation error");
+        }
+
+        uiSrchPostingsSortedLength = 0;
+
+
+        /* Create the postings arrays, every fourth one after the first is left empty */
+        for ( uiJ = 0; uiJ < uiSrchPostingsListLength; uiJ++ ) {
+
+            puiSrchPostingsLengthList[uiJ] = ((uiJ > 0) && ((uiJ % 4) == 0)) ? 0 : 
+                    ((VRF_TEST_NEXT_RANDOM(uiRandom) >> 16) % VRF_TEST_LOSER_TREE_POSTINGS_LENGTH_MAX) + 1;
+
+            if ( (ppspSrchPostingsList[uiJ] = (struct srchPosting *)s_malloc((size_t)(sizeof(struct srchPosting) * 
+                    VRF_TEST_LOSER_TREE_POSTINGS_LENGTH_MAX))) == NULL ) {
+                iUtlLogPanic(UTL_LOG_CONTEXT, "Memory allocation error");
+            }
+
+            /* Step the document IDs and term positions up by small amounts so the postings arrays overlap */
+            for ( uiK = 0, uiDocumentID = 1, uiTermPosition = 0; uiK < puiSrchPostingsLengthList[uiJ]; uiK++ ) {
+
+                if ( ((VRF_TEST_NEXT_RANDOM(uiRandom) >> 16) % 2) == 0 ) {
+                    uiDocumentID += ((uiRandom >> 20) % 3) + 1;
+                    uiTermPosition = (uiRandom >> 24) % 3;
+                }
+                else {
+                    uiTermPosition += ((uiRandom >> 20) % 2) + 1;
+                }
+
+                ppspSrchPostingsList[uiJ][uiK].uiDocumentID = uiDocumentID;
+                ppspSrchPostingsList[uiJ][uiK].uiTermPosition = uiTermPosition;
+                ppspSrchPostingsList[uiJ][uiK].fWeight = (float)uiJ;
+
+                pspSrchPostingsSorted[uiSrchPostingsSortedLength++] = ppspSrchPostingsList[uiJ][uiK];
+            }
+        }
+
+
+        /* Merge the postings arrays */
+        if ( (iError = iSrchPostingMergeSrchPostings(ppspSrchPostingsList, puiSrchPostingsLengthList, uiSrchPostingsListLength, 
+                &pspSrchPostings, &uiSrchPostingsLength)) != SRCH_NoError ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to merge the postings arrays, srch error: %d", iError);
+        }
+
+        /* Sort the concatenated postings arrays */
+        s_qsort(pspSrchPostingsSorted, uiSrchPostingsSortedLength, sizeof(struct srchPosting), (int (*)())iTestLoserTreeCompareSrchPostings);
+
+
+        /* Check the merged postings array against the sorted postings array */
+        if ( uiSrchPostingsLength != uiSrchPostingsSortedLength ) {
+            iUtlLogPanic(UTL_LOG_CONTEXT, "Loser tree check, postings arrays: %u, merged postings: %u, expected: %u", 
+                    uiSrchPostingsListLength, uiSrchPostingsLength, uiSrchPostingsSortedLength);
+        }
+
+        for ( uiK = 0; uiK < uiSrchPostingsLength; uiK++ ) {
+            if ( iTestLoserTreeCompareSrchPostings(pspSrchPostings + uiK, pspSrchPostingsSorted + uiK) != 0 ) {
+                iUtlLogPanic(UTL_LOG_CONTEXT, "Loser tree check, postings arrays: %u, merged posting: %u, is document ID: %u, term position: %u, postings array: %.0f, " 
+                        "expected document ID: %u, term position: %u, postings array: %.0f", uiSrchPostingsListLength, uiK, 
+                        pspSrchPostings[uiK].uiDocumentID, pspSrchPostings[uiK].uiTermPosition, pspSrchPostings[uiK].fWeight, 
+                        pspSrchPostingsSorted[uiK].uiDocumentID, pspSrchPostingsSorted[uiK].uiTermPosition, pspSrchPostingsSorted[uiK].fWeight);
+            }
+        }
+
+        printf("Loser tree check, postings arrays: %u, postings: %u, passed.\n", uiSrchPostingsListLength, uiSrchPostingsLength); 
+
+
+        /* Free everything */
+        for ( uiJ = 0; uiJ < uiSrchPostingsListLength; uiJ++ ) {
+            s_free(ppspSrchPostingsList[uiJ]);
+        }
+        s_free(ppspSrchPostingsList);
+        s_free(puiSrchPostingsLengthList);
+        s_free(pspSrchPostings);
+        s_free(pspSrchPostingsSorted);
+    }
+
+
+    printf("Loser tree test passed.\n"); 
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iTestLoserTreeCompareSrchPostings()
+
+    Purpose:    This function is passed to s_qsort() to sort postings in 
+                document ID and term position order, ties going to the 
+                posting with the lower weight, which is the index of its
+                postings array in the loser tree test.
+
+    Parameters: pspSrchPosting1     posting 1
+                pspSrchPosting2     posting 2
+
+    Globals:    none
+
+    Returns:    1 if pspSrchPosting1 > pspSrchPosting2, -1 if pspSrchPosting1 < pspSrchPosting2, 0 if equal
+
+*/
+static int iTestLoserTreeCompareSrchPostings
+(
+    struct srchPosting *pspSrchPosting1,
+    struct srchPosting *pspSrchPosting2
+)
+{
+
+    ASSERT(pspSrchPosting1 != NULL);
+    ASSERT(pspSrchPosting2 != NULL);
+
+
+    if ( pspSrchPosting1->uiDocumentID != pspSrchPosting2->uiDocumentID ) {
+        return ((pspSrchPosting1->uiDocumentID < pspSrchPosting2->uiDocumentID) ? -1 : 1);
+    }
+
+    if ( pspSrchPosting1->uiTermPosition != pspSrchPosting2->uiTermPosition ) {
+        return ((pspSrchPosting1->uiTermPosition < pspSrchPosting2->uiTermPosition) ? -1 : 1);
+    }
+
+    if ( pspSrchPosting1->fWeight != pspSrchPosting2->fWeight ) {
+        return ((pspSrchPosting1->fWeight < pspSrchPosting2->fWeight) ? -1 : 1);
+    }
+
+
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vTestPhoneticKeys()
+
+    Purpose:    This function looks up the terms of an index created with 
+                phonetic keys as soundex, metaphone and phonix terms, the way 
+                a search does, once with the phonetic key dictionaries and 
+                once without them, which scans the term dictionary, and checks
+                that both lookups match the same terms.
+
+                Any failure is fatal.
+
+    Parameters: pucIndexDirectoryPath           index directory path
+                pucConfigurationDirectoryPath   configuration directory path
+                pucIndexName                    index name
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vTestPhoneticKeys
+(
+    unsigned char *pucIndexDirectoryPath,
+    unsigned char *pucConfigurationDirectoryPath,
+    unsigned char *pucIndexName
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchIndex            *psiSrchIndex = NULL;
+    unsigned char               **ppucTerms = NULL;
+    unsigned int                uiTermsLength = 0;
+    unsigned int                uiTermMatch = SRCH_TERMDICT_TERM_MATCH_UNKNOWN;
+    unsigned int                uiPhoneticKeysCount = 0;
+    unsigned int                uiI = 0;
+    unsigned int                uiJ = 0;
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucIndexDirectoryPath) == false);
+    ASSERT(bUtlStringsIsStringNULL(pucConfigurationDirectoryPath) == false);
+    ASSERT(bUtlStringsIsStringNULL(pucIndexName) == false);
+
+
+    /* Open index */
+    if ( (iError = iSrchIndexOpen(pucIndexDirectoryPath, pucConfigurationDirectoryPath, pucIndexName, SRCH_INDEX_INTENT_SEARCH, &psiSrchIndex)) != SRCH_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to open the index: '%s', srch error: %d.", pucIndexName, iError);
+    }
+
+
+    /* Allocate the terms */
+    if ( (ppucTerms = (unsigned char **)s_malloc((size_t)(sizeof(unsigned char *) * VRF_TEST_PHONETIC_KEYS_TERM_COUNT_MAX))) == NULL ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Memory allocation error");
+    }
+
+    /* Collect the terms from the term dictionary, start from the first key */
+    if ( (iError = iUtlDictProcessEntryList(psiSrchIndex->pvUtlTermDictionary, UTL_DICT_FIRST_KEY_FLAG, (int (*)())iTestPhoneticKeysCallBack, 
+            ppucTerms, &uiTermsLength)) != UTL_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to process the term dictionary, index: '%s', utl error: %d.", pucIndexName, iError);
+    }
+
+
+    /* Loop over the phonetic keys */
+    for ( uiTermMatch = SRCH_TERMDICT_TERM_MATCH_SOUNDEX; SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == true; uiTermMatch++ ) {
+
+        void            **ppvUtlDictionary = NULL;
+        void            *pvUtlDictionary = NULL;
+        unsigned char   *pucName = NULL;
+        unsigned int    uiMatchedTermsCount = 0;
+
+        /* Get the phonetic key dictionary */
+        if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_SOUNDEX ) {
+            ppvUtlDictionary = &psiSrchIndex->pvUtlSoundexKeysDictionary;
+            pucName = "soundex";
+        }
+        else if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_METAPHONE ) {
+            ppvUtlDictionary = &psiSrchIndex->pvUtlMetaphoneKeysDictionary;
+            pucName = "metaphone";
+        }
+        else if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_PHONIX ) {
+            ppvUtlDictionary = &psiSrchIndex->pvUtlPhonixKeysDictionary;
+            pucName = "phonix";
+        }
+
+        /* Skip the phonetic key if the index was not created with it */
+        if ( *ppvUtlDictionary == NULL ) {
+            continue;
+        }
+
+        uiPhoneticKeysCount++;
+        pvUtlDictionary = *ppvUtlDictionary;
+
+
+        /* Look up each term with and without the phonetic key dictionary */
+        for ( uiI = 0; uiI < uiTermsLength; uiI++ ) {
+
+            struct srchTermDictInfo     *pstdiSrchTermDictInfos1 = NULL;
+            unsigned int                uiSrchTermDictInfos1Length = 0;
+            struct srchTermDictInfo     *pstdiSrchTermDictInfos2 = NULL;
+            unsigned int                uiSrchTermDictInfos2Length = 0;
+
+            *ppvUtlDictionary = pvUtlDictionary;
+            if ( ((iError = iSrchTermDictLookupList(psiSrchIndex, psiSrchIndex->uiLanguageID, ppucTerms[uiI], NULL, 0, uiTermMatch, SRCH_PARSER_INVALID_ID, 
+                    &pstdiSrchTermDictInfos1, &uiSrchTermDictInfos1Length)) != SRCH_NoError) && (iError != SRCH_TermDictTermDoesNotOccur) ) {
+                iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to look up the %s term: '%s' with the phonetic key dictionary, srch error: %d.", pucName, ppucTerms[uiI], iError);
+            }
+
+            *ppvUtlDictionary = NULL;
+            if ( ((iError = iSrchTermDictLookupList(psiSrchIndex, psiSrchIndex->uiLanguageID, ppucTerms[uiI], NULL, 0, uiTermMatch, SRCH_PARSER_INVALID_ID, 
+                    &pstdiSrchTermDictInfos2, &uiSrchTermDictInfos2Length)) != SRCH_NoError) && (iError != SRCH_TermDictTermDoesNotOccur) ) {
+                iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to look up the %s term: '%s' without the phonetic key dictionary, srch error: %d.", pucName, ppucTerms[uiI], iError);
+            }
+
+            /* Check that the same terms were matched, the order can differ */
+            if ( uiSrchTermDictInfos1Length != uiSrchTermDictInfos2Length ) {
+                iUtlLogPanic(UTL_LOG_CONTEXT, "Phonetic keys check, %s term: '%s', matched terms: %u, expected: %u", 
+                        pucName, ppucTerms[uiI], uiSrchTermDictInfos1Length, uiSrchTermDictInfos2Length);
+            }
+
+            if ( uiSrchTermDictInfos1Length > 0 ) {
+
+                s_qsort(pstdiSrchTermDictInfos1, uiSrchTermDictInfos1Length, sizeof(struct srchTermDictInfo), (int (*)())iTestPhoneticKeysCompareSrchTermDictInfos);
+                s_qsort(pstdiSrchTermDictInfos2, uiSrchTermDictInfos2Length, sizeof(struct srchTermDictInfo), (int (*)())iTestPhoneticKeysCompareSrchTermDictInfos);
+
+                for ( uiJ = 0; uiJ < uiSrchTermDictInfos1Length; uiJ++ ) {
+                    if ( (iTestPhoneticKeysCompareSrchTermDictInfos(pstdiSrchTermDictInfos1 + uiJ, pstdiSrchTermDictInfos2 + uiJ) != 0) ||
+                            (pstdiSrchTermDictInfos1[uiJ].uiTermCount != pstdiSrchTermDictInfos2[uiJ].uiTermCount) ||
+                            (pstdiSrchTermDictInfos1[uiJ].uiDocumentCount != pstdiSrchTermDictInfos2[uiJ].uiDocumentCount) ) {
+                        iUtlLogPanic(UTL_LOG_CONTEXT, "Phonetic keys check, %s term: '%s', matched term: '%s', expected: '%s'", 
+                                pucName, ppucTerms[uiI], pstdiSrchTermDictInfos1[uiJ].pucTerm, pstdiSrchTermDictInfos2[uiJ].pucTerm);
+                    }
+                }
+
+                uiMatchedTermsCount++;
+            }
+
+            iSrchTermDictFreeSearchTermDictInfo(pstdiSrchTermDictInfos1, uiSrchTermDictInfos1Length);
+            iSrchTermDictFreeSearchTermDictInfo(pstdiSrchTermDictInfos2, uiSrchTermDictInfos2Length);
+        }
+
+        /* Restore the phonetic key dictionary so it gets closed with the index */
+        *ppvUtlDictionary = pvUtlDictionary;
+
+        printf("Phonetic keys check: '%s', terms: %u, terms with matches: %u, passed.\n", pucName, uiTermsLength, uiMatchedTermsCount); 
+    }
+
+
+    /* Free the terms */
+    for ( uiI = 0; uiI < uiTermsLength; uiI++ ) {
+        s_free(ppucTerms[uiI]);
+    }
+    s_free(ppucTerms);
+
+
+    /* Close the index */
+    if ( (iError = iSrchIndexClose(psiSrchIndex)) != SRCH_NoError ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Failed to close the index: '%s', srch error: %d.", pucIndexName, iError);
+    }
+
+
+    /* The index needs to have been created with phonetic keys */
+    if ( uiPhoneticKeysCount == 0 ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "The index: '%s', has no phonetic key dictionaries, it needs to be created with '--phonetic-keys'", pucIndexName);
+    }
+
+
+    printf("Phonetic keys test passed.\n"); 
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iTestPhoneticKeysCallBack()
+
+    Purpose:    This function is passed to the dictionary list function to
+                collect the terms for the phonetic keys test.
+
+    Parameters: pucKey          key
+                pvEntryData     entry data
+                uiEntryLength   entry length
+                ap              args (optional)
+
+    Globals:    none
+
+    Returns:    0 to continue processing, non-0 otherwise
+
+*/
+static int iTestPhoneticKeysCallBack
+(
+    unsigned char *pucKey,
+    void *pvEntryData,
+    unsigned int uiEntryLength,
+    va_list ap
+)
+{
+
+    va_list         ap_;
+    unsigned char   **ppucTerms = NULL;
+    unsigned int    *puiTermsLength = NULL;
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+
+
+    /* Get all our parameters, note that we make a copy of 'ap' */
+    va_copy(ap_, ap);
+    ppucTerms = (unsigned char **)va_arg(ap_, unsigned char **);
+    puiTermsLength = (unsigned int *)va_arg(ap_, unsigned int *);
+    va_end(ap_);
+
+    ASSERT(ppucTerms != NULL);
+    ASSERT(puiTermsLength != NULL);
+
+
+    /* Stop once we have all the terms we need */
+    if ( *puiTermsLength >= VRF_TEST_PHONETIC_KEYS_TERM_COUNT_MAX ) {
+        return (1);
+    }
+
+    /* Add the term */
+    if ( (ppucTerms[*puiTermsLength] = s_strdup(pucKey)) == NULL ) {
+        iUtlLogPanic(UTL_LOG_CONTEXT, "Memory allocation error");
+    }
+
+    (*puiTermsLength)++;
+
+
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iTestPhoneticKeysCompareSrchTermDictInfos()
+
+    Purpose:    This function is passed to s_qsort() to sort term dict infos
+                in term order.
+
+    Parameters: pstdiSrchTermDictInfo1      term dict info 1
+                pstdiSrchTermDictInfo2      term dict info 2
+
+    Globals:    none
+
+    Returns:    1 if pstdiSrchTermDictInfo1 > pstdiSrchTermDictInfo2, 
+                -1 if pstdiSrchTermDictInfo1 < pstdiSrchTermDictInfo2, 0 if equal
+
+*/
+static int iTestPhoneticKeysCompareSrchTermDictInfos
+(
+    struct srchTermDictInfo *pstdiSrchTermDictInfo1,
+    struct srchTermDictInfo *pstdiSrchTermDictInfo2
+)
+{
+
+    ASSERT(pstdiSrchTermDictInfo1 != NULL);
+    ASSERT(pstdiSrchTermDictInfo2 != NULL);
+
+
+    return (s_strcmp(pstdiSrchTermDictInfo1->pucTerm, pstdiSrchTermDictInfo2->pucTerm));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
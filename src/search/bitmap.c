@@ -49,6 +49,18 @@
 /*---------------------------------------------------------------------------*/
 
 
+/*
+** Private function prototypes
+*/
+
+static int iSrchBitmapMergeRoaring (struct srchBitmap *psbSrchBitmap1, 
+        struct srchBitmap *psbSrchBitmap2, unsigned int uiMergeType, 
+        struct srchBitmap **ppsbSrchBitmap);
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchBitmapCreate()
@@ -122,6 +134,72 @@ int iSrchBitmapCreate
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchBitmapCreateRoaring()
+
+    Purpose:    This function creates a search bitmap structure whose bits
+                are stored in a roaring structure rather than in a bitmap, 
+                which is much smaller when few bits are set.
+
+    Parameters: pvUtlRoaring            roaring structure (optional, handed over)
+                uiBitmapLength          bitmap length
+                ppsbSrchBitmap          search bitmap structure return pointer
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchBitmapCreateRoaring
+(
+    void *pvUtlRoaring,
+    unsigned int uiBitmapLength,
+    struct srchBitmap **ppsbSrchBitmap
+)
+{
+
+    int                 iError = UTL_NoError;
+    struct srchBitmap   *psbSrchBitmap = NULL;
+
+
+    /* Check the parameters */
+    if ( ppsbSrchBitmap == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppsbSrchBitmap' parameter passed to 'iSrchBitmapCreateRoaring'."); 
+        return (SPI_ReturnParameterError);
+    }
+
+
+    /* Allocate the search bitmap structure */
+    if ( (psbSrchBitmap = (struct srchBitmap *)s_malloc(sizeof(struct srchBitmap))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+    psbSrchBitmap->uiBitmapLength = uiBitmapLength;
+    psbSrchBitmap->bMappedAllocationFlag = false;
+
+    /* Hand over the roaring structure if one was passed, otherwise we create a new one */
+    if ( pvUtlRoaring != NULL ) {
+        psbSrchBitmap->pvUtlRoaring = pvUtlRoaring;
+    }
+    else if ( (iError = iUtlRoaringCreate(&psbSrchBitmap->pvUtlRoaring)) != UTL_NoError ) {
+        s_free(psbSrchBitmap);
+        return (SRCH_MemError);
+    }
+
+
+    /* Set the return pointer */
+    *ppsbSrchBitmap = psbSrchBitmap;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchBitmapFree()
@@ -155,6 +233,9 @@ int iSrchBitmapFree
             }
         }
 
+        iUtlRoaringFree(psbSrchBitmap->pvUtlRoaring);
+        psbSrchBitmap->pvUtlRoaring = NULL;
+
         s_free(psbSrchBitmap);
     }
 
@@ -167,6 +248,68 @@ int iSrchBitmapFree
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchBitmapExpandRoaring()
+
+    Purpose:    This function expands the roaring structure of the search
+                bitmap structure into a bitmap, it does nothing if the 
+                search bitmap structure does not have a roaring structure.
+
+    Parameters: psbSrchBitmap       search bitmap structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchBitmapExpandRoaring
+(
+    struct srchBitmap *psbSrchBitmap
+)
+{
+
+    int     iError = UTL_NoError;
+
+
+    /* Check the parameters */
+    if ( psbSrchBitmap == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psbSrchBitmap' parameter passed to 'iSrchBitmapExpandRoaring'."); 
+        return (SRCH_BitmapInvalidBitmap);
+    }
+
+
+    /* Nothing to expand */
+    if ( psbSrchBitmap->pvUtlRoaring == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Allocate the bitmap */
+    if ( (psbSrchBitmap->pucBitmap = (unsigned char *)s_malloc((size_t)UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(psbSrchBitmap->uiBitmapLength))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+    /* Get the bitmap from the roaring structure */
+    if ( (iError = iUtlRoaringGetBitmap(psbSrchBitmap->pvUtlRoaring, psbSrchBitmap->pucBitmap, psbSrchBitmap->uiBitmapLength)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get a bitmap from a roaring structure, utl error: %d.", iError);
+        s_free(psbSrchBitmap->pucBitmap);
+        return (SRCH_BitmapInvalidBitmap);
+    }
+
+    /* Free the roaring structure */
+    iUtlRoaringFree(psbSrchBitmap->pvUtlRoaring);
+    psbSrchBitmap->pvUtlRoaring = NULL;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchBitmapMergeXOR()
@@ -208,7 +351,7 @@ int iSrchBitmapMergeXOR
         return (SRCH_BitmapInvalidBitmap);
     }
 
-    if ( psbSrchBitmap1->pucBitmap == NULL ) {
+    if ( (psbSrchBitmap1->pucBitmap == NULL) && (psbSrchBitmap1->pvUtlRoaring == NULL) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'psbSrchBitmap1' parameter passed to 'iSrchBitmapMergeXOR'."); 
         return (SRCH_BitmapInvalidBitmap);
     }
@@ -218,7 +361,7 @@ int iSrchBitmapMergeXOR
         return (SRCH_BitmapInvalidBitmap);
     }
 
-    if ( psbSrchBitmap2->pucBitmap == NULL ) {
+    if ( (psbSrchBitmap2->pucBitmap == NULL) && (psbSrchBitmap2->pvUtlRoaring == NULL) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'psbSrchBitmap2' parameter passed to 'iSrchBitmapMergeXOR'."); 
         return (SRCH_BitmapInvalidBitmap);
     }
@@ -229,6 +372,22 @@ int iSrchBitmapMergeXOR
     }
     
     
+    /* Merge the roaring structures if both search bitmap structures have one, 
+    ** otherwise we expand whichever has one and merge the bitmaps
+    */
+    if ( (psbSrchBitmap1->pvUtlRoaring != NULL) && (psbSrchBitmap2->pvUtlRoaring != NULL) ) {
+        return (iSrchBitmapMergeRoaring(psbSrchBitmap1, psbSrchBitmap2, UTL_ROARING_MERGE_TYPE_XOR, ppsbSrchBitmap));
+    }
+
+    if ( (iError = iSrchBitmapExpandRoaring(psbSrchBitmap1)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    if ( (iError = iSrchBitmapExpandRoaring(psbSrchBitmap2)) != SRCH_NoError ) {
+        return (iError);
+    }
+    
+    
     /* Reuse one or the other search bitmap structure if we can, otherwise we allocate a new one */
     if ( psbSrchBitmap1->bMappedAllocationFlag == false ) {
         psbSrchBitmap = psbSrchBitmap1;
@@ -319,7 +478,7 @@ int iSrchBitmapMergeOR
         return (SRCH_BitmapInvalidBitmap);
     }
 
-    if ( psbSrchBitmap1->pucBitmap == NULL ) {
+    if ( (psbSrchBitmap1->pucBitmap == NULL) && (psbSrchBitmap1->pvUtlRoaring == NULL) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'psbSrchBitmap1' parameter passed to 'iSrchBitmapMergeOR'."); 
         return (SRCH_BitmapInvalidBitmap);
     }
@@ -329,7 +488,7 @@ int iSrchBitmapMergeOR
         return (SRCH_BitmapInvalidBitmap);
     }
 
-    if ( psbSrchBitmap2->pucBitmap == NULL ) {
+    if ( (psbSrchBitmap2->pucBitmap == NULL) && (psbSrchBitmap2->pvUtlRoaring == NULL) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'psbSrchBitmap2' parameter passed to 'iSrchBitmapMergeOR'."); 
         return (SRCH_BitmapInvalidBitmap);
     }
@@ -340,6 +499,22 @@ int iSrchBitmapMergeOR
     }
     
     
+    /* Merge the roaring structures if both search bitmap structures have one, 
+    ** otherwise we expand whichever has one and merge the bitmaps
+    */
+    if ( (psbSrchBitmap1->pvUtlRoaring != NULL) && (psbSrchBitmap2->pvUtlRoaring != NULL) ) {
+        return (iSrchBitmapMergeRoaring(psbSrchBitmap1, psbSrchBitmap2, UTL_ROARING_MERGE_TYPE_OR, ppsbSrchBitmap));
+    }
+
+    if ( (iError = iSrchBitmapExpandRoaring(psbSrchBitmap1)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    if ( (iError = iSrchBitmapExpandRoaring(psbSrchBitmap2)) != SRCH_NoError ) {
+        return (iError);
+    }
+    
+    
     /* Reuse one or the other search bitmap structure if we can, otherwise we allocate a new one */
     if ( psbSrchBitmap1->bMappedAllocationFlag == false ) {
         psbSrchBitmap = psbSrchBitmap1;
@@ -430,7 +605,7 @@ int iSrchBitmapMergeAND
         return (SRCH_BitmapInvalidBitmap);
     }
 
-    if ( psbSrchBitmap1->pucBitmap == NULL ) {
+    if ( (psbSrchBitmap1->pucBitmap == NULL) && (psbSrchBitmap1->pvUtlRoaring == NULL) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'psbSrchBitmap1' parameter passed to 'iSrchBitmapMergeAND'."); 
         return (SRCH_BitmapInvalidBitmap);
     }
@@ -440,7 +615,7 @@ int iSrchBitmapMergeAND
         return (SRCH_BitmapInvalidBitmap);
     }
 
-    if ( psbSrchBitmap2->pucBitmap == NULL ) {
+    if ( (psbSrchBitmap2->pucBitmap == NULL) && (psbSrchBitmap2->pvUtlRoaring == NULL) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'psbSrchBitmap2' parameter passed to 'iSrchBitmapMergeAND'."); 
         return (SRCH_BitmapInvalidBitmap);
     }
@@ -451,6 +626,22 @@ int iSrchBitmapMergeAND
     }
     
     
+    /* Merge the roaring structures if both search bitmap structures have one, 
+    ** otherwise we expand whichever has one and merge the bitmaps
+    */
+    if ( (psbSrchBitmap1->pvUtlRoaring != NULL) && (psbSrchBitmap2->pvUtlRoaring != NULL) ) {
+        return (iSrchBitmapMergeRoaring(psbSrchBitmap1, psbSrchBitmap2, UTL_ROARING_MERGE_TYPE_AND, ppsbSrchBitmap));
+    }
+
+    if ( (iError = iSrchBitmapExpandRoaring(psbSrchBitmap1)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    if ( (iError = iSrchBitmapExpandRoaring(psbSrchBitmap2)) != SRCH_NoError ) {
+        return (iError);
+    }
+    
+    
     /* Reuse one or the other search bitmap structure if we can, otherwise we allocate a new one */
     if ( psbSrchBitmap1->bMappedAllocationFlag == false ) {
         psbSrchBitmap = psbSrchBitmap1;
@@ -508,10 +699,10 @@ int iSrchBitmapMergeAND
                 and return a pointer to the new search bitmap structure.
                 It disposes of the two passed search bitmap structures 
                 except if an error occurs.
-                ppsbSrchBitmap        return pointer for the search bitmap structure
 
     Parameters: psbSrchBitmap1      search bitmap structure
                 psbSrchBitmap2      search bitmap structure
+                ppsbSrchBitmap      return pointer for the search bitmap structure
 
     Globals:    none
 
@@ -541,7 +732,7 @@ int iSrchBitmapMergeNOT
         return (SRCH_BitmapInvalidBitmap);
     }
 
-    if ( psbSrchBitmap1->pucBitmap == NULL ) {
+    if ( (psbSrchBitmap1->pucBitmap == NULL) && (psbSrchBitmap1->pvUtlRoaring == NULL) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'psbSrchBitmap1' parameter passed to 'iSrchBitmapMergeNOT'."); 
         return (SRCH_BitmapInvalidBitmap);
     }
@@ -551,7 +742,7 @@ int iSrchBitmapMergeNOT
         return (SRCH_BitmapInvalidBitmap);
     }
 
-    if ( psbSrchBitmap2->pucBitmap == NULL ) {
+    if ( (psbSrchBitmap2->pucBitmap == NULL) && (psbSrchBitmap2->pvUtlRoaring == NULL) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'psbSrchBitmap2' parameter passed to 'iSrchBitmapMergeNOT'."); 
         return (SRCH_BitmapInvalidBitmap);
     }
@@ -562,6 +753,22 @@ int iSrchBitmapMergeNOT
     }
     
     
+    /* Merge the roaring structures if both search bitmap structures have one, 
+    ** otherwise we expand whichever has one and merge the bitmaps
+    */
+    if ( (psbSrchBitmap1->pvUtlRoaring != NULL) && (psbSrchBitmap2->pvUtlRoaring != NULL) ) {
+        return (iSrchBitmapMergeRoaring(psbSrchBitmap1, psbSrchBitmap2, UTL_ROARING_MERGE_TYPE_NOT, ppsbSrchBitmap));
+    }
+
+    if ( (iError = iSrchBitmapExpandRoaring(psbSrchBitmap1)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    if ( (iError = iSrchBitmapExpandRoaring(psbSrchBitmap2)) != SRCH_NoError ) {
+        return (iError);
+    }
+    
+    
     /* Reuse one or the other search bitmap structure if we can, otherwise we allocate a new one */
     if ( psbSrchBitmap1->bMappedAllocationFlag == false ) {
         psbSrchBitmap = psbSrchBitmap1;
@@ -583,7 +790,7 @@ int iSrchBitmapMergeNOT
             pucBitmapEnd = psbSrchBitmap->pucBitmap + UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(UTL_MACROS_MIN(psbSrchBitmap1->uiBitmapLength, psbSrchBitmap2->uiBitmapLength)); 
             pucBitmapPtr < pucBitmapEnd; pucBitmapPtr++, pucBitmap1Ptr++, pucBitmap2Ptr++ ) {
 
-        *pucBitmapPtr = *pucBitmap1Ptr | *pucBitmap2Ptr;
+        *pucBitmapPtr = *pucBitmap1Ptr & ~*pucBitmap2Ptr;
     }
 
     
@@ -636,8 +843,8 @@ int iSrchBitmapPrint
         iUtlLogInfo(UTL_LOG_CONTEXT, "iSrchBitmapPrint - psbSrchBitmap pointer is NULL");
     }
 
-    if ( psbSrchBitmap->pucBitmap == NULL ) {
-        iUtlLogInfo(UTL_LOG_CONTEXT, "iSrchBitmapPrint - psbSrchBitmap->pucBitmap pointer is NULL");
+    if ( (psbSrchBitmap->pucBitmap == NULL) && (psbSrchBitmap->pvUtlRoaring == NULL) ) {
+        iUtlLogInfo(UTL_LOG_CONTEXT, "iSrchBitmapPrint - psbSrchBitmap->pucBitmap and psbSrchBitmap->pvUtlRoaring pointers are NULL");
     }
 
     if ( psbSrchBitmap->uiBitmapLength == 0 ) {
@@ -646,13 +853,13 @@ int iSrchBitmapPrint
 
 
     /* Print out the search bitmap structure */
-    if ( (psbSrchBitmap != NULL) && (psbSrchBitmap->pucBitmap != NULL) ) {
+    if ( (psbSrchBitmap != NULL) && ((psbSrchBitmap->pucBitmap != NULL) || (psbSrchBitmap->pvUtlRoaring != NULL)) ) {
         
         unsigned int    uiI = 0;
 
         for ( uiI = 0; uiI < psbSrchBitmap->uiBitmapLength; uiI++ ) {
 
-            printf("%8u - %s\n", uiI, (UTL_BITMAP_IS_BIT_SET_IN_POINTER(psbSrchBitmap->pucBitmap, uiI)) ? "true" : "false");
+            printf("%8u - %s\n", uiI, (SRCH_BITMAP_IS_BIT_SET(psbSrchBitmap, uiI) == true) ? "true" : "false");
 
         }
     }
@@ -663,4 +870,74 @@ int iSrchBitmapPrint
 }
 
 
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchBitmapMergeRoaring()
+
+    Purpose:    This function merges the roaring structures of psbSrchBitmap1
+                and psbSrchBitmap2 according to the merge type and return a 
+                pointer to the new search bitmap structure. It disposes of 
+                the two passed search bitmap structures except if an error 
+                occurs.
+
+    Parameters: psbSrchBitmap1      search bitmap structure
+                psbSrchBitmap2      search bitmap structure
+                uiMergeType         roaring merge type
+                ppsbSrchBitmap      return pointer for the search bitmap structure
+
+    Globals:    none
+
+    Returns:    SRCH Error code
+
+*/
+static int iSrchBitmapMergeRoaring
+(
+    struct srchBitmap *psbSrchBitmap1,
+    struct srchBitmap *psbSrchBitmap2,
+    unsigned int uiMergeType,
+    struct srchBitmap **ppsbSrchBitmap
+)
+{
+    
+    int     iError = UTL_NoError;
+    void    *pvUtlRoaring = NULL;
+
+
+    ASSERT(psbSrchBitmap1 != NULL);
+    ASSERT(psbSrchBitmap1->pvUtlRoaring != NULL);
+    ASSERT(psbSrchBitmap2 != NULL);
+    ASSERT(psbSrchBitmap2->pvUtlRoaring != NULL);
+    ASSERT(UTL_ROARING_MERGE_TYPE_VALID(uiMergeType) == true);
+    ASSERT(ppsbSrchBitmap != NULL);
+
+
+    /* Merge the two roaring structures */
+    if ( (iError = iUtlRoaringMerge(psbSrchBitmap1->pvUtlRoaring, psbSrchBitmap2->pvUtlRoaring, uiMergeType, &pvUtlRoaring)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to merge two roaring structures, utl error: %d.", iError);
+        return (SRCH_BitmapMergeFailed);
+    }
+
+
+    /* Reuse the first search bitmap structure */
+    iUtlRoaringFree(psbSrchBitmap1->pvUtlRoaring);
+    psbSrchBitmap1->pvUtlRoaring = pvUtlRoaring;
+    psbSrchBitmap1->uiBitmapLength = UTL_MACROS_MIN(psbSrchBitmap1->uiBitmapLength, psbSrchBitmap2->uiBitmapLength);
+
+    /* Free the second search bitmap structure */
+    iSrchBitmapFree(psbSrchBitmap2);
+    psbSrchBitmap2 = NULL;
+
+
+    /* Set the return pointer */
+    *ppsbSrchBitmap = psbSrchBitmap1;
+    
+
+    return (SRCH_NoError);
+
+}
+
+
 /*---------------------------------------------------------------------------*/
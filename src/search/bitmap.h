@@ -57,17 +57,45 @@ extern "C" {
 ** Structures
 */
 
-/* Bitmap structure */
+/* Bitmap structure, the bits are either in the bitmap or in the roaring structure */
 struct srchBitmap {
     unsigned char   *pucBitmap;                     /* Bitmap */
     unsigned int    uiBitmapLength;                 /* Bitmap length (in bits) */
     boolean         bMappedAllocationFlag;          /* Memory mapped allocation flag */
+    void            *pvUtlRoaring;                  /* Roaring structure (pucBitmap is NULL if set) */
 };
 
 
 /*---------------------------------------------------------------------------*/
 
 
+/*
+** Macros
+*/
+
+/* Check if a bit is set in a search bitmap */
+#define SRCH_BITMAP_IS_BIT_SET(psbMacroSrchBitmap, uiMacroBit) \
+    (((psbMacroSrchBitmap)->pvUtlRoaring != NULL) ? \
+            bUtlRoaringContainsValue((psbMacroSrchBitmap)->pvUtlRoaring, (uiMacroBit)) : \
+            (UTL_BITMAP_IS_BIT_SET_IN_POINTER((psbMacroSrchBitmap)->pucBitmap, (uiMacroBit)) ? true : false))
+
+
+/* Set a bit in a search bitmap, iMacroError is set to a SRCH error code */
+#define SRCH_BITMAP_SET_BIT(psbMacroSrchBitmap, uiMacroBit, iMacroError) \
+    {   \
+        if ( (psbMacroSrchBitmap)->pvUtlRoaring != NULL ) {    \
+            iMacroError = (iUtlRoaringAddValue((psbMacroSrchBitmap)->pvUtlRoaring, (uiMacroBit)) == UTL_NoError) ? SRCH_NoError : SRCH_BitmapSetBitFailed; \
+        }   \
+        else {  \
+            UTL_BITMAP_SET_BIT_IN_POINTER((psbMacroSrchBitmap)->pucBitmap, (uiMacroBit)); \
+            iMacroError = SRCH_NoError; \
+        }   \
+    }
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 ** Public function prototypes
 */
@@ -75,9 +103,15 @@ struct srchBitmap {
 int iSrchBitmapCreate (unsigned char *pucBitmap, unsigned int uiBitmapLength,
     boolean bMappedAllocationFlag, struct srchBitmap **ppsbSrchBitmap);
 
+int iSrchBitmapCreateRoaring (void *pvUtlRoaring, unsigned int uiBitmapLength,
+    struct srchBitmap **ppsbSrchBitmap);
+
 int iSrchBitmapFree (struct srchBitmap *psbSrchBitmap);
 
 
+int iSrchBitmapExpandRoaring (struct srchBitmap *psbSrchBitmap);
+
+
 int iSrchBitmapMergeXOR (struct srchBitmap *psbSrchBitmap1, 
         struct srchBitmap *psbSrchBitmap2, struct srchBitmap **ppsbSrchBitmap);
 
@@ -493,6 +493,44 @@ int iSrchCacheClose
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   bSrchCacheSaveEnabled()
+
+    Purpose:    Return true if search results can be saved in the cache,
+                false otherwise
+
+    Parameters: pvSrchCache     search cache structure (optional)
+
+    Globals:    none
+
+    Returns:    true if search results can be saved in the cache, false
+                otherwise
+
+*/
+boolean bSrchCacheSaveEnabled
+(
+    void *pvSrchCache
+)
+{
+
+    struct srchCache    *pscSrchCache = (struct srchCache *)pvSrchCache;
+
+
+    /* No cache, so nothing can be saved */
+    if ( pvSrchCache == NULL ) {
+        return (false);
+    }
+
+
+    return ((pscSrchCache->uiSearchCacheMode == SRCH_CACHE_MODE_READ_WRITE) ? true : false);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchCacheSaveSearchShortResults()
@@ -2288,6 +2326,7 @@ int iSrchCacheSaveSearchWeight
     unsigned char       pucBuffer[BUFSIZ + 1] = {'\0'};
     unsigned char       *pucBufferPtr = NULL;
     unsigned int        uiBufferLength = 0;
+    float               *pfWeights = NULL;
 
 
 #if !defined(SRCH_CACHE_ENABLE_SEARCH_WEIGHTS_CACHING)
@@ -2410,8 +2449,23 @@ int iSrchCacheSaveSearchWeight
         goto bailFromiSrchCacheSaveSearchWeight;
     }
 
+    /* Get the search weight as a weights array if it is sparse, search weights are cached as weights arrays so they can be mapped */
+    if ( pswSrchWeight->bSparseFlag == true ) {
+
+        unsigned int    uiI = 0;
+
+        if ( (pfWeights = (float *)s_malloc((size_t)(pswSrchWeight->uiWeightsLength * sizeof(float)))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchCacheSaveSearchWeight;
+        }
+
+        for ( uiI = 0; uiI < pswSrchWeight->uiDocumentIDsLength; uiI++ ) {
+            pfWeights[pswSrchWeight->puiDocumentIDs[uiI]] = pswSrchWeight->pfWeights[uiI];
+        }
+    }
+
     /* Write out the weight array to the file */
-    if ( s_fwrite((unsigned char *)pswSrchWeight->pfWeights, (pswSrchWeight->uiWeightsLength * sizeof(float)), 1, pfSearchCacheFile) != 1 ) {
+    if ( s_fwrite((unsigned char *)((pfWeights != NULL) ? pfWeights : pswSrchWeight->pfWeights), (pswSrchWeight->uiWeightsLength * sizeof(float)), 1, pfSearchCacheFile) != 1 ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the search weight cache file: '%s'.", pucSearchCacheFilePath);
         iError = SRCH_CacheSaveFailed;
         goto bailFromiSrchCacheSaveSearchWeight;
@@ -2430,6 +2484,10 @@ int iSrchCacheSaveSearchWeight
     bailFromiSrchCacheSaveSearchWeight:
 
 
+    /* Free the weights array */
+    s_free(pfWeights);
+
+
     /* Handle the error */
     if ( iError == SRCH_NoError ) {
 
@@ -2825,6 +2883,7 @@ int iSrchCacheSaveSearchBitmap
     unsigned char       pucSearchCacheFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
     unsigned char       pucSHA1HexDigest[UTL_SHA1_HEX_DIGEST_LENGTH + 1] = {'\0'};
     FILE                *pfSearchCacheFile = NULL;
+    unsigned char       *pucBitmap = NULL;
 
 
 #if !defined(SRCH_CACHE_ENABLE_SEARCH_BITMAPS_CACHING)
@@ -2898,8 +2957,24 @@ int iSrchCacheSaveSearchBitmap
     }
 
 
+    /* Get the search bitmap as a bitmap if it is a roaring structure, search bitmaps are cached as bitmaps so they can be mapped */
+    if ( psbSrchBitmap->pvUtlRoaring != NULL ) {
+
+        if ( (pucBitmap = (unsigned char *)s_malloc((size_t)UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(psbSrchBitmap->uiBitmapLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchCacheSaveSearchBitmap;
+        }
+
+        if ( (iError = iUtlRoaringGetBitmap(psbSrchBitmap->pvUtlRoaring, pucBitmap, psbSrchBitmap->uiBitmapLength)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to get a bitmap from a roaring structure, utl error: %d.", iError);
+            iError = SRCH_CacheSaveFailed;
+            goto bailFromiSrchCacheSaveSearchBitmap;
+        }
+    }
+
+
     /* Write out the search bitmap */
-    if ( s_fwrite(psbSrchBitmap->pucBitmap, UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(psbSrchBitmap->uiBitmapLength), 1, pfSearchCacheFile) != 1 ) {
+    if ( s_fwrite((pucBitmap != NULL) ? pucBitmap : psbSrchBitmap->pucBitmap, UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(psbSrchBitmap->uiBitmapLength), 1, pfSearchCacheFile) != 1 ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the search bitmap cache file: '%s'.", pucSearchCacheFilePath);
         iError = SRCH_CacheSaveFailed;
         goto bailFromiSrchCacheSaveSearchBitmap;
@@ -2919,6 +2994,10 @@ int iSrchCacheSaveSearchBitmap
     bailFromiSrchCacheSaveSearchBitmap:
 
 
+    /* Free the bitmap */
+    s_free(pucBitmap);
+
+
     /* Handle the error */
     if ( iError == SRCH_NoError ) {
 
@@ -63,6 +63,8 @@ int iSrchCacheCreate (struct srchSearch *pssSrchSearch, void **ppvSrchCache);
 
 int iSrchCacheClose (void *pvSrchCache);
 
+boolean bSrchCacheSaveEnabled (void *pvSrchCache);
+
 
 int iSrchCacheSaveSearchShortResults (void *pvSrchCache, struct srchIndex *psiSrchIndex, 
         wchar_t *pwcSearchText, wchar_t *pwcPositiveFeedbackText, wchar_t *pwcNegativeFeedbackText, 
@@ -0,0 +1,3384 @@
+/*****************************************************************************
+*       Copyright (C) 1993-2011, FS Consulting LLC. All rights reserved      *
+*                                                                            *
+*  This notice is intended as a precaution against inadvertent publication   *
+*  and does not constitute an admission or acknowledgement that publication  *
+*  has occurred or constitute a waiver of confidentiality.                   *
+*                                                                            *
+*  This software is the proprietary and confidential property                *
+*  of FS Consulting LLC.                                                     *
+*****************************************************************************/
+
+
+/*
+
+    Module:     cursor.c
+
+    Author:     Francois Schiettecatte (FS Consulting LLC.)
+
+    Created:    17 October 2026
+
+    Purpose:    This module provides posting cursors for search.c, these
+                allow a search tree to be evaluated a document at a time
+                rather than materializing a postings list at every level.
+
+                A postings cursor walks a search postings list, and an
+                operator cursor combines two cursors lazily, only keeping
+                the postings for the current document. The per document
+                merges mirror the merges in posting.c so the two produce
+                the same documents with the same weights.
+
+                A WAND cursor ORs a number of postings cursors but only 
+                stops on documents which can make it into the top documents,
+                using the search posting blocks to skip the ones which can't.
+
+                A multi OR cursor ORs a number of cursors in a single pass,
+                a loser tree over the cursors picks the next document, and
+                the search postings of the cursors on that document are 
+                merged in term order the same way a chain of OR cursors 
+                would merge them.
+
+*/
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#include "srch.h"
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Feature defines
+*/
+
+/* Context for logging */
+#undef UTL_LOG_CONTEXT
+#define UTL_LOG_CONTEXT                     (unsigned char *)"com.fsconsult.mps.src.search.cursor"
+
+
+/* Enable proximity reweighting, this needs to match posting.c, the term positions 
+** are only loaded for the documents where there is more than one search posting 
+** to merge since a single search posting is never reweighted
+*/
+#define SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Defines
+*/
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+#define SRCH_CURSOR_PROXIMITY_REWEIGHTING                   (3)
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+
+/* Initial length of the search postings array when draining a cursor */
+#define SRCH_CURSOR_SRCH_POSTINGS_LENGTH_INITIAL            (1024)
+
+
+/* Document ID a cursor is keyed on in the loser tree, cursors which have run out of documents go last */
+#define SRCH_CURSOR_LOSER_TREE_DOCUMENT_ID(psc) \
+    (((psc)->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE) ? UINT_MAX : (psc)->uiDocumentID)
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Macros
+*/
+
+/* Macro for moving search posting structure content around */
+#define SRCH_CURSOR_COPY_SRCH_POSTING(psp1, psp2) \
+{   \
+    (psp1)->uiDocumentID = (psp2)->uiDocumentID; \
+    (psp1)->uiTermPosition = (psp2)->uiTermPosition; \
+    (psp1)->fWeight = (psp2)->fWeight; \
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Private function prototypes
+*/
+
+static int iSrchCursorSetDocument (struct srchCursor *pscSrchCursor,
+        struct srchPosting *pspSrchPostingsPtr);
+
+static int iSrchCursorDecodeNextSrchPostings (struct srchCursor *pscSrchCursor,
+        unsigned int uiDocumentID);
+
+static int iSrchCursorSetDocumentContainersDocument (struct srchCursor *pscSrchCursor,
+        unsigned int uiDocumentID);
+
+static int iSrchCursorFindDocument (struct srchCursor *pscSrchCursor);
+
+static int iSrchCursorFindDocumentWAND (struct srchCursor *pscSrchCursor);
+
+static int iSrchCursorFindDocumentMultiOR (struct srchCursor *pscSrchCursor);
+
+static int iSrchCursorGetLoserTreeSrchCursorsDocument (struct srchCursor *pscSrchCursor, 
+        unsigned int uiNode, unsigned int uiIndex, unsigned int uiDocumentID);
+
+static int iSrchCursorAdjustLoserTree (struct srchCursor *pscSrchCursor, 
+        unsigned int uiIndex);
+
+static int iSrchCursorLoadTermPositions (struct srchCursor *pscSrchCursor);
+
+static int iSrchCursorCheckSrchPostingsBuffer (struct srchCursor *pscSrchCursor,
+        unsigned int uiSrchPostingsLength);
+
+static int iSrchCursorMergeORCursors (struct srchCursor *pscSrchCursor, 
+        unsigned int uiDocumentID, boolean bTermPositions);
+
+static int iSrchCursorMergeWANDCursors (struct srchCursor *pscSrchCursor, 
+        unsigned int uiDocumentID, boolean bTermPositions);
+
+static int iSrchCursorMergeMultiORCursors (struct srchCursor *pscSrchCursor, 
+        unsigned int uiDocumentID, boolean bTermPositions);
+
+static int iSrchCursorMergeOR (struct srchCursor *pscSrchCursor,
+        struct srchPosting *pspSrchPostings1, unsigned int uiSrchPostingsLength1,
+        struct srchPosting *pspSrchPostings2, unsigned int uiSrchPostingsLength2);
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+static void vSrchCursorReweightSrchPostings (struct srchPosting *pspSrchPostings, 
+        unsigned int uiSrchPostingsLength, unsigned int uiReweightingsCount);
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+static int iSrchCursorMergeAND (struct srchCursor *pscSrchCursor,
+        struct srchPosting *pspSrchPostings1, unsigned int uiSrchPostingsLength1,
+        struct srchPosting *pspSrchPostings2, unsigned int uiSrchPostingsLength2);
+
+static int iSrchCursorMergeADJ (struct srchCursor *pscSrchCursor,
+        struct srchPosting *pspSrchPostings1, unsigned int uiSrchPostingsLength1,
+        struct srchPosting *pspSrchPostings2, unsigned int uiSrchPostingsLength2);
+
+static int iSrchCursorMergeNEAR (struct srchCursor *pscSrchCursor,
+        struct srchPosting *pspSrchPostings1, unsigned int uiSrchPostingsLength1,
+        struct srchPosting *pspSrchPostings2, unsigned int uiSrchPostingsLength2);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorCreateFromSrchPostingsList()
+
+    Purpose:    This function creates a postings cursor from a search postings
+                list, the cursor takes over the search postings list and will
+                free it when the cursor is freed. The cursor is positioned
+                on the first document in the search postings list.
+
+                A NULL search postings list yields a NULL cursor, this is
+                the same as a missing search postings list in posting.c.
+
+                If the search postings list has document containers, the
+                cursor steps through them and sets up one search posting 
+                for each document, with no term position.
+
+                If the search postings list decodes its search postings on 
+                demand, the cursor decodes them as it moves along.
+
+    Parameters: psplSrchPostingsList    search postings list structure (optional)
+                ppscSrchCursor          return pointer for the search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorCreateFromSrchPostingsList
+(
+    struct srchPostingsList *psplSrchPostingsList,
+    struct srchCursor **ppscSrchCursor
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchCursor       *pscSrchCursor = NULL;
+
+
+    /* Check the parameters */
+    if ( ppscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppscSrchCursor' parameter passed to 'iSrchCursorCreateFromSrchPostingsList'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* No search postings list, no cursor */
+    if ( psplSrchPostingsList == NULL ) {
+        *ppscSrchCursor = NULL;
+        return (SRCH_NoError);
+    }
+
+
+    /* Allocate the search cursor structure */
+    if ( (pscSrchCursor = (struct srchCursor *)s_malloc(sizeof(struct srchCursor))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+    /* Set the fields */
+    pscSrchCursor->uiCursorTypeID = SRCH_CURSOR_TYPE_POSTINGS_ID;
+    pscSrchCursor->uiTermType = psplSrchPostingsList->uiTermType;
+    pscSrchCursor->bRequired = psplSrchPostingsList->bRequired;
+    pscSrchCursor->psplSrchPostingsList = psplSrchPostingsList;
+    pscSrchCursor->pspSrchPostingsEnd = (psplSrchPostingsList->uiSrchPostingsLength > 0) ?
+            psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength : psplSrchPostingsList->pspSrchPostings;
+
+
+    /* Position the cursor on the first document, document IDs start at 1 */
+    if ( psplSrchPostingsList->pvUtlRoaring != NULL ) {
+        if ( (iError = iSrchCursorCheckSrchPostingsBuffer(pscSrchCursor, 1)) == SRCH_NoError ) {
+            iError = iSrchCursorSetDocumentContainersDocument(pscSrchCursor, 1);
+        }
+    }
+    else {
+        iError = iSrchCursorSetDocument(pscSrchCursor, psplSrchPostingsList->pspSrchPostings);
+    }
+
+    if ( iError != SRCH_NoError ) {
+        pscSrchCursor->psplSrchPostingsList = NULL;
+        iSrchCursorFree(pscSrchCursor);
+        return (iError);
+    }
+
+
+    /* Set the return pointer */
+    *ppscSrchCursor = pscSrchCursor;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorCreateFromSrchCursors()
+
+    Purpose:    This function creates an operator cursor from two cursors, the
+                operator cursor takes over the two cursors and will free them
+                when it is freed. The cursor is positioned on the first
+                document it matches.
+
+                If either cursor is NULL or empty, this applies the same rules
+                as posting.c to decide which of the two cursors to return, or
+                whether to return an empty cursor. Likewise an OR cursor
+                involving required terms is remapped to an AND or an IOR cursor.
+
+                The two cursors are freed if an error occurs.
+
+    Parameters: uiCursorTypeID                      cursor type ID
+                pscSrchCursor1                      search cursor structure (optional)
+                pscSrchCursor2                      search cursor structure (optional)
+                iTermDistance                       term distance (ADJ and NEAR)
+                bTermOrderMatters                   term order matters (NEAR)
+                uiSrchPostingBooleanOperationID     posting boolean operation ID
+                ppscSrchCursor                      return pointer for the search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorCreateFromSrchCursors
+(
+    unsigned int uiCursorTypeID,
+    struct srchCursor *pscSrchCursor1,
+    struct srchCursor *pscSrchCursor2,
+    int iTermDistance,
+    boolean bTermOrderMatters,
+    unsigned int uiSrchPostingBooleanOperationID,
+    struct srchCursor **ppscSrchCursor
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchCursor       *pscSrchCursor = NULL;
+    boolean                 bEmpty1 = false;
+    boolean                 bEmpty2 = false;
+
+
+    /* Check the parameters */
+    if ( (uiCursorTypeID != SRCH_CURSOR_TYPE_OR_ID) && (uiCursorTypeID != SRCH_CURSOR_TYPE_IOR_ID) &&
+            (uiCursorTypeID != SRCH_CURSOR_TYPE_XOR_ID) && (uiCursorTypeID != SRCH_CURSOR_TYPE_AND_ID) &&
+            (uiCursorTypeID != SRCH_CURSOR_TYPE_NOT_ID) && (uiCursorTypeID != SRCH_CURSOR_TYPE_ADJ_ID) &&
+            (uiCursorTypeID != SRCH_CURSOR_TYPE_NEAR_ID) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiCursorTypeID' parameter passed to 'iSrchCursorCreateFromSrchCursors'.");
+        iSrchCursorFree(pscSrchCursor1);
+        iSrchCursorFree(pscSrchCursor2);
+        return (SRCH_CursorInvalidCursorType);
+    }
+
+    if ( (uiCursorTypeID == SRCH_CURSOR_TYPE_ADJ_ID) && (iTermDistance <= 0) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'iTermDistance' parameter passed to 'iSrchCursorCreateFromSrchCursors'.");
+        iSrchCursorFree(pscSrchCursor1);
+        iSrchCursorFree(pscSrchCursor2);
+        return (SRCH_PostingInvalidTermDistance);
+    }
+
+    if ( !((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID) || (uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID)) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiSrchPostingBooleanOperationID' parameter passed to 'iSrchCursorCreateFromSrchCursors'.");
+        iSrchCursorFree(pscSrchCursor1);
+        iSrchCursorFree(pscSrchCursor2);
+        return (SRCH_PostingInvalidSearchBooleanModifier);
+    }
+
+    if ( ppscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppscSrchCursor' parameter passed to 'iSrchCursorCreateFromSrchCursors'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Cursors are positioned on their first document when they are created, so a cursor not positioned on a document is empty */
+    bEmpty1 = ((pscSrchCursor1 == NULL) || (pscSrchCursor1->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE)) ? true : false;
+    bEmpty2 = ((pscSrchCursor2 == NULL) || (pscSrchCursor2->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE)) ? true : false;
+
+
+    /* If either of the cursors are NULL or empty we try to return the other one,
+    ** if we cant then we just return an empty cursor, see posting.c for the rules
+    */
+    if ( (bEmpty1 == true) || (bEmpty2 == true) ) {
+
+        /* OR - return the non-empty cursor if the other one is NULL or contains a non-required term */
+        if ( uiCursorTypeID == SRCH_CURSOR_TYPE_OR_ID ) {
+
+            if ( (bEmpty1 == false) && ((pscSrchCursor2 == NULL) || (pscSrchCursor2->bRequired == false)) ) {
+                iSrchCursorFree(pscSrchCursor2);
+                *ppscSrchCursor = pscSrchCursor1;
+                return (SRCH_NoError);
+            }
+            else if ( (bEmpty2 == false) && ((pscSrchCursor1 == NULL) || (pscSrchCursor1->bRequired == false)) ) {
+                iSrchCursorFree(pscSrchCursor1);
+                *ppscSrchCursor = pscSrchCursor2;
+                return (SRCH_NoError);
+            }
+        }
+
+        /* NOT - return the outer cursor if the inner cursor is empty */
+        else if ( uiCursorTypeID == SRCH_CURSOR_TYPE_NOT_ID ) {
+
+            if ( (bEmpty1 == false) && (pscSrchCursor2 != NULL) ) {
+                iSrchCursorFree(pscSrchCursor2);
+                *ppscSrchCursor = pscSrchCursor1;
+                return (SRCH_NoError);
+            }
+        }
+
+        /* Everything else - return the non-empty cursor if we are using strict booleans and the other one contains
+        ** a stop term, or if we are using relaxed booleans and the other one contains a non-required term
+        */
+        else if ( (pscSrchCursor1 != NULL) && (pscSrchCursor2 != NULL) ) {
+
+            if ( (bEmpty1 == false) &&
+                    ( ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID) && (pscSrchCursor2->uiTermType == SPI_TERM_TYPE_STOP)) ||
+                    ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID) && (pscSrchCursor2->bRequired == false)) ) ) {
+                iSrchCursorFree(pscSrchCursor2);
+                *ppscSrchCursor = pscSrchCursor1;
+                return (SRCH_NoError);
+            }
+            else if ( (bEmpty2 == false) &&
+                    ( ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID) && (pscSrchCursor1->uiTermType == SPI_TERM_TYPE_STOP)) ||
+                    ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID) && (pscSrchCursor1->bRequired == false)) ) ) {
+                iSrchCursorFree(pscSrchCursor1);
+                *ppscSrchCursor = pscSrchCursor2;
+                return (SRCH_NoError);
+            }
+        }
+
+        /* Everything else - return the non-NULL cursor if we are using relaxed booleans */
+        else if ( uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID ) {
+
+            if ( (pscSrchCursor1 == NULL) && (pscSrchCursor2 != NULL) ) {
+                *ppscSrchCursor = pscSrchCursor2;
+                return (SRCH_NoError);
+            }
+            else if ( (pscSrchCursor2 == NULL) && (pscSrchCursor1 != NULL) ) {
+                *ppscSrchCursor = pscSrchCursor1;
+                return (SRCH_NoError);
+            }
+        }
+
+
+        /* Return an empty cursor */
+        {
+            struct srchPostingsList     *psplSrchPostingsList = NULL;
+            unsigned int                uiTermType = SPI_TERM_TYPE_UNKNOWN;
+
+            /* Set the term type to stop word is both passed term types were stop words */
+            if ( (pscSrchCursor1 != NULL) && (pscSrchCursor1->uiTermType == SPI_TERM_TYPE_STOP) &&
+                    (pscSrchCursor2 != NULL) && (pscSrchCursor2->uiTermType == SPI_TERM_TYPE_STOP) ) {
+                uiTermType = SPI_TERM_TYPE_STOP;
+            }
+
+            /* Free the cursors */
+            iSrchCursorFree(pscSrchCursor1);
+            pscSrchCursor1 = NULL;
+
+            iSrchCursorFree(pscSrchCursor2);
+            pscSrchCursor2 = NULL;
+
+            /* Create an empty postings list */
+            if ( (iError = iSrchPostingCreateSrchPostingsList(uiTermType, SPI_TERM_COUNT_UNKNOWN, SPI_TERM_DOCUMENT_COUNT_UNKNOWN,
+                    false, NULL, 0, &psplSrchPostingsList)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            /* And wrap it in a cursor */
+            if ( (iError = iSrchCursorCreateFromSrchPostingsList(psplSrchPostingsList, ppscSrchCursor)) != SRCH_NoError ) {
+                iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
+                psplSrchPostingsList = NULL;
+                return (iError);
+            }
+
+            return (SRCH_NoError);
+        }
+    }
+
+
+    ASSERT(pscSrchCursor1 != NULL);
+    ASSERT(pscSrchCursor2 != NULL);
+
+
+    /* Various permutations of handling required terms in an OR, we send all those to AND or IOR */
+    if ( uiCursorTypeID == SRCH_CURSOR_TYPE_OR_ID ) {
+
+        if ( (pscSrchCursor1->bRequired == true) && (pscSrchCursor2->bRequired == true) ) {
+            uiCursorTypeID = SRCH_CURSOR_TYPE_AND_ID;
+        }
+        else if ( (pscSrchCursor1->bRequired == true) && (pscSrchCursor2->bRequired == false) ) {
+            uiCursorTypeID = SRCH_CURSOR_TYPE_IOR_ID;
+        }
+        else if ( (pscSrchCursor1->bRequired == false) && (pscSrchCursor2->bRequired == true) ) {
+
+            struct srchCursor   *pscSrchCursorTmp = pscSrchCursor1;
+
+            uiCursorTypeID = SRCH_CURSOR_TYPE_IOR_ID;
+            pscSrchCursor1 = pscSrchCursor2;
+            pscSrchCursor2 = pscSrchCursorTmp;
+        }
+    }
+
+
+    /* Allocate the search cursor structure */
+    if ( (pscSrchCursor = (struct srchCursor *)s_malloc(sizeof(struct srchCursor))) == NULL ) {
+        iSrchCursorFree(pscSrchCursor1);
+        iSrchCursorFree(pscSrchCursor2);
+        return (SRCH_MemError);
+    }
+
+    /* Set the fields */
+    pscSrchCursor->uiCursorTypeID = uiCursorTypeID;
+    pscSrchCursor->uiTermType = SPI_TERM_TYPE_REGULAR;
+    pscSrchCursor->bRequired = ((pscSrchCursor1->bRequired == true) || (pscSrchCursor2->bRequired == true)) ? true : false;
+    pscSrchCursor->iTermDistance = iTermDistance;
+    pscSrchCursor->bTermOrderMatters = bTermOrderMatters;
+    pscSrchCursor->pscSrchCursor1 = pscSrchCursor1;
+    pscSrchCursor->pscSrchCursor2 = pscSrchCursor2;
+
+
+    /* Position the cursor on the first document */
+    if ( (iError = iSrchCursorFindDocument(pscSrchCursor)) != SRCH_NoError ) {
+        iSrchCursorFree(pscSrchCursor);
+        return (iError);
+    }
+
+
+    /* Set the return pointer */
+    *ppscSrchCursor = pscSrchCursor;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorCreateWANDFromSrchCursors()
+
+    Purpose:    This function creates a WAND cursor from an array of postings 
+                cursors, the WAND cursor takes over the cursors and will free 
+                them when it is freed, the array itself is not taken over.
+
+                The WAND cursor matches the same documents with the same 
+                weights as ORing the cursors together in array order, but 
+                it only stops on documents whose weight exceeds the minimum 
+                weight, using the search posting blocks of each cursor to 
+                skip over documents which cannot get there. The minimum 
+                weight starts below 0 so that every document is matched 
+                and is raised as the caller finds better documents.
+
+                Required terms are not supported since they turn the OR 
+                into an AND or an IOR.
+
+                The cursors are freed if an error occurs.
+
+    Parameters: ppscSrchCursors         search cursor structures
+                uiSrchCursorsLength     search cursor structures length
+                ppscSrchCursor          return pointer for the search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorCreateWANDFromSrchCursors
+(
+    struct srchCursor **ppscSrchCursors,
+    unsigned int uiSrchCursorsLength,
+    struct srchCursor **ppscSrchCursor
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchCursor       *pscSrchCursor = NULL;
+    struct srchCursorBound  *pscbSrchCursorBoundsPtr = NULL;
+    unsigned int            uiI = 0;
+
+
+    /* Check the parameters */
+    if ( (ppscSrchCursors == NULL) || (uiSrchCursorsLength == 0) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null or empty 'ppscSrchCursors' parameter passed to 'iSrchCursorCreateWANDFromSrchCursors'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+    if ( ppscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppscSrchCursor' parameter passed to 'iSrchCursorCreateWANDFromSrchCursors'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Allocate the search cursor structure */
+    if ( (pscSrchCursor = (struct srchCursor *)s_malloc(sizeof(struct srchCursor))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+    }
+
+    /* Set the fields */
+    pscSrchCursor->uiCursorTypeID = SRCH_CURSOR_TYPE_WAND_ID;
+    pscSrchCursor->uiTermType = SPI_TERM_TYPE_REGULAR;
+    pscSrchCursor->bRequired = false;
+    pscSrchCursor->fMinimumWeight = -1;
+    pscSrchCursor->bSkippedDocuments = false;
+
+
+    /* Allocate the search cursor bounds */
+    if ( (pscSrchCursor->pscbSrchCursorBounds = (struct srchCursorBound *)s_malloc((size_t)(uiSrchCursorsLength * sizeof(struct srchCursorBound)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+    }
+
+    if ( (pscSrchCursor->ppscbSrchCursorBoundsSorted = (struct srchCursorBound **)s_malloc((size_t)(uiSrchCursorsLength * sizeof(struct srchCursorBound *)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+    }
+
+    /* Allocate the search cursors and the indices of the search cursors on the current document */
+    if ( (pscSrchCursor->ppscSrchCursors = (struct srchCursor **)s_malloc((size_t)(uiSrchCursorsLength * sizeof(struct srchCursor *)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+    }
+
+    if ( (pscSrchCursor->puiSrchCursorsDocument = (unsigned int *)s_malloc((size_t)(uiSrchCursorsLength * sizeof(unsigned int)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+    }
+
+
+    /* Take over the cursors, empty cursors are dropped just as they would be when ORing */
+    for ( uiI = 0; uiI < uiSrchCursorsLength; uiI++ ) {
+
+        struct srchCursor   *pscSrchCursorPtr = ppscSrchCursors[uiI];
+
+        ppscSrchCursors[uiI] = NULL;
+
+        if ( pscSrchCursorPtr == NULL ) {
+            continue;
+        }
+
+        if ( (pscSrchCursorPtr->uiCursorTypeID != SRCH_CURSOR_TYPE_POSTINGS_ID) || (pscSrchCursorPtr->bRequired == true) ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Invalid search cursor passed to 'iSrchCursorCreateWANDFromSrchCursors', only non-required postings cursors are supported.");
+            iSrchCursorFree(pscSrchCursorPtr);
+            iError = SRCH_CursorInvalidCursorType;
+            goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+        }
+
+        if ( pscSrchCursorPtr->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE ) {
+            iSrchCursorFree(pscSrchCursorPtr);
+            continue;
+        }
+
+        /* Add the cursor */
+        pscSrchCursor->ppscSrchCursors[pscSrchCursor->uiSrchCursorsLength++] = pscSrchCursorPtr;
+        pscbSrchCursorBoundsPtr = pscSrchCursor->pscbSrchCursorBounds + pscSrchCursor->uiSrchCursorBoundsLength;
+        pscbSrchCursorBoundsPtr->pscSrchCursor = pscSrchCursorPtr;
+        pscSrchCursor->uiSrchCursorBoundsLength++;
+
+        /* Make sure the search postings list has search posting blocks, creating them decodes any search 
+        ** postings which have not been decoded yet, which moves them, so the cursor is put back on its document
+        */
+        if ( (pscSrchCursorPtr->psplSrchPostingsList->pspbSrchPostingBlocks == NULL) && (pscSrchCursorPtr->psplSrchPostingsList->pvSrchTermSearchDecoder != NULL) ) {
+
+            struct srchPostingsList     *psplSrchPostingsList = pscSrchCursorPtr->psplSrchPostingsList;
+
+            ASSERT(pscSrchCursorPtr->bSrchPostingsListMoved == false);
+
+            if ( (iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList)) != SRCH_NoError ) {
+                goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+            }
+
+            pscSrchCursorPtr->pspSrchPostingsEnd = psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength;
+
+            if ( (iError = iSrchCursorSetDocument(pscSrchCursorPtr, pspSrchPostingSeekDocumentID(psplSrchPostingsList->pspSrchPostings, 
+                    pscSrchCursorPtr->pspSrchPostingsEnd, pscSrchCursorPtr->uiDocumentID))) != SRCH_NoError ) {
+                goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+            }
+        }
+
+        if ( (iError = iSrchPostingCreateSrchPostingBlocks(pscSrchCursorPtr->psplSrchPostingsList)) != SRCH_NoError ) {
+            goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+        }
+    }
+
+
+    /* Set the bounds, the first cursor goes through every OR after the first one
+    ** and each of the other cursors goes through every OR from its own one on, and
+    ** each OR can reweight a search posting for proximity
+    */
+    for ( uiI = 0, pscbSrchCursorBoundsPtr = pscSrchCursor->pscbSrchCursorBounds; uiI < pscSrchCursor->uiSrchCursorBoundsLength; uiI++, pscbSrchCursorBoundsPtr++ ) {
+
+        struct srchPostingsList     *psplSrchPostingsList = pscbSrchCursorBoundsPtr->pscSrchCursor->psplSrchPostingsList;
+        struct srchPostingBlock     *pspbSrchPostingBlocksPtr = NULL;
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+        unsigned int                uiOperationCount = (uiI == 0) ? (pscSrchCursor->uiSrchCursorBoundsLength - 1) : (pscSrchCursor->uiSrchCursorBoundsLength - uiI);
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+        float                       fMaxWeight = 0;
+
+        pscbSrchCursorBoundsPtr->fFactor = 1;
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+        for ( ; uiOperationCount > 0; uiOperationCount-- ) {
+            pscbSrchCursorBoundsPtr->fFactor *= SRCH_CURSOR_PROXIMITY_REWEIGHTING;
+        }
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+        pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr = psplSrchPostingsList->pspbSrchPostingBlocks;
+        pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksEnd = psplSrchPostingsList->pspbSrchPostingBlocks + psplSrchPostingsList->uiSrchPostingBlocksLength;
+
+        for ( pspbSrchPostingBlocksPtr = pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr; pspbSrchPostingBlocksPtr < pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksEnd; pspbSrchPostingBlocksPtr++ ) {
+            fMaxWeight = UTL_MACROS_MAX(fMaxWeight, pspbSrchPostingBlocksPtr->fMaxWeight);
+        }
+        pscbSrchCursorBoundsPtr->fMaxWeight = fMaxWeight * pscbSrchCursorBoundsPtr->fFactor;
+
+        pscSrchCursor->ppscbSrchCursorBoundsSorted[uiI] = pscbSrchCursorBoundsPtr;
+    }
+
+
+    /* Position the cursor on the first document */
+    if ( (iError = iSrchCursorFindDocumentWAND(pscSrchCursor)) != SRCH_NoError ) {
+        goto bailFromiSrchCursorCreateWANDFromSrchCursors;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchCursorCreateWANDFromSrchCursors:
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointer */
+        *ppscSrchCursor = pscSrchCursor;
+    }
+    else {
+
+        /* Free the search cursor structure, along with the cursors it took over */
+        iSrchCursorFree(pscSrchCursor);
+        pscSrchCursor = NULL;
+
+        /* Free the cursors which were not taken over */
+        for ( uiI = 0; uiI < uiSrchCursorsLength; uiI++ ) {
+            iSrchCursorFree(ppscSrchCursors[uiI]);
+            ppscSrchCursors[uiI] = NULL;
+        }
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorCreateMultiORFromSrchCursors()
+
+    Purpose:    This function creates a multi OR cursor from an array of cursors, 
+                the multi OR cursor takes over the cursors and will free them 
+                when it is freed, the array itself is not taken over. 
+
+                The multi OR cursor matches the same documents with the same 
+                weights as ORing the cursors together in array order, but it
+                keeps the cursors in a loser tree rather than in a chain of OR
+                cursors, so it takes a single step to get to the next document 
+                however many cursors there are.
+
+                NULL and empty cursors are dropped just as they would be when 
+                ORing, and the remaining cursor is returned if there is only 
+                one. Required terms turn the OR into an AND or an IOR, so the 
+                cursors are chained with iSrchCursorCreateFromSrchCursors() 
+                if any of them are required.
+
+                The cursors are freed if an error occurs.
+
+    Parameters: ppscSrchCursors                     search cursor structures
+                uiSrchCursorsLength                 search cursor structures length
+                uiSrchPostingBooleanOperationID     posting boolean operation ID
+                ppscSrchCursor                      return pointer for the search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorCreateMultiORFromSrchCursors
+(
+    struct srchCursor **ppscSrchCursors,
+    unsigned int uiSrchCursorsLength,
+    unsigned int uiSrchPostingBooleanOperationID,
+    struct srchCursor **ppscSrchCursor
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchCursor       *pscSrchCursor = NULL;
+    boolean                 bRequired = false;
+    boolean                 bStopTerms = true;
+    unsigned int            uiI = 0;
+
+
+    /* Check the parameters */
+    if ( (ppscSrchCursors == NULL) || (uiSrchCursorsLength == 0) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null or empty 'ppscSrchCursors' parameter passed to 'iSrchCursorCreateMultiORFromSrchCursors'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+    if ( !((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID) || (uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID)) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiSrchPostingBooleanOperationID' parameter passed to 'iSrchCursorCreateMultiORFromSrchCursors'.");
+        iError = SRCH_PostingInvalidSearchBooleanModifier;
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+    if ( ppscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppscSrchCursor' parameter passed to 'iSrchCursorCreateMultiORFromSrchCursors'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Check for required terms and for cursors which are not stop terms */
+    for ( uiI = 0; uiI < uiSrchCursorsLength; uiI++ ) {
+        if ( (ppscSrchCursors[uiI] != NULL) && (ppscSrchCursors[uiI]->bRequired == true) ) {
+            bRequired = true;
+        }
+        if ( (ppscSrchCursors[uiI] == NULL) || (ppscSrchCursors[uiI]->uiTermType != SPI_TERM_TYPE_STOP) ) {
+            bStopTerms = false;
+        }
+    }
+
+
+    /* Chain the cursors if there are required terms, this takes over all of them */
+    if ( bRequired == true ) {
+
+        pscSrchCursor = ppscSrchCursors[0];
+        ppscSrchCursors[0] = NULL;
+
+        for ( uiI = 1; uiI < uiSrchCursorsLength; uiI++ ) {
+
+            struct srchCursor   *pscSrchCursorPtr = ppscSrchCursors[uiI];
+
+            ppscSrchCursors[uiI] = NULL;
+
+            if ( (iError = iSrchCursorCreateFromSrchCursors(SRCH_CURSOR_TYPE_OR_ID, pscSrchCursor, pscSrchCursorPtr, 0, false,
+                    uiSrchPostingBooleanOperationID, &pscSrchCursor)) != SRCH_NoError ) {
+                pscSrchCursor = NULL;
+                goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+            }
+        }
+
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+
+    /* Allocate the search cursor structure */
+    if ( (pscSrchCursor = (struct srchCursor *)s_malloc(sizeof(struct srchCursor))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+    /* Set the fields */
+    pscSrchCursor->uiCursorTypeID = SRCH_CURSOR_TYPE_MULTI_OR_ID;
+    pscSrchCursor->uiTermType = SPI_TERM_TYPE_REGULAR;
+    pscSrchCursor->bRequired = false;
+
+
+    /* Allocate the search cursors, the indices of the search cursors on the current document and the loser tree */
+    if ( (pscSrchCursor->ppscSrchCursors = (struct srchCursor **)s_malloc((size_t)(uiSrchCursorsLength * sizeof(struct srchCursor *)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+    if ( (pscSrchCursor->puiSrchCursorsDocument = (unsigned int *)s_malloc((size_t)(uiSrchCursorsLength * sizeof(unsigned int)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+    if ( (pscSrchCursor->puiLoserTree = (unsigned int *)s_malloc((size_t)(uiSrchCursorsLength * sizeof(unsigned int)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+    if ( (pscSrchCursor->puiLoserTreeDocumentIDs = (unsigned int *)s_malloc((size_t)(uiSrchCursorsLength * sizeof(unsigned int)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+
+    /* Take over the cursors, empty cursors are dropped just as they would be when ORing */
+    for ( uiI = 0; uiI < uiSrchCursorsLength; uiI++ ) {
+
+        struct srchCursor   *pscSrchCursorPtr = ppscSrchCursors[uiI];
+
+        ppscSrchCursors[uiI] = NULL;
+
+        if ( (pscSrchCursorPtr != NULL) && (pscSrchCursorPtr->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE) ) {
+            iSrchCursorFree(pscSrchCursorPtr);
+            pscSrchCursorPtr = NULL;
+        }
+
+        if ( pscSrchCursorPtr != NULL ) {
+            pscSrchCursor->ppscSrchCursors[pscSrchCursor->uiSrchCursorsLength++] = pscSrchCursorPtr;
+        }
+    }
+
+
+    /* No cursors left, return an empty cursor, it contains a stop term if all the cursors did */
+    if ( pscSrchCursor->uiSrchCursorsLength == 0 ) {
+
+        struct srchPostingsList     *psplSrchPostingsList = NULL;
+
+        iSrchCursorFree(pscSrchCursor);
+        pscSrchCursor = NULL;
+
+        if ( (iError = iSrchPostingCreateSrchPostingsList((bStopTerms == true) ? SPI_TERM_TYPE_STOP : SPI_TERM_TYPE_UNKNOWN, SPI_TERM_COUNT_UNKNOWN, 
+                SPI_TERM_DOCUMENT_COUNT_UNKNOWN, false, NULL, 0, &psplSrchPostingsList)) != SRCH_NoError ) {
+            goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+        }
+
+        if ( (iError = iSrchCursorCreateFromSrchPostingsList(psplSrchPostingsList, &pscSrchCursor)) != SRCH_NoError ) {
+            iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
+            psplSrchPostingsList = NULL;
+            goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+        }
+
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+
+    /* One cursor left, return it */
+    if ( pscSrchCursor->uiSrchCursorsLength == 1 ) {
+
+        struct srchCursor   *pscSrchCursorPtr = pscSrchCursor->ppscSrchCursors[0];
+
+        pscSrchCursor->uiSrchCursorsLength = 0;
+        iSrchCursorFree(pscSrchCursor);
+        pscSrchCursor = pscSrchCursorPtr;
+
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+
+    /* Build the loser tree, the nodes are seeded with the search cursors length which stands 
+    ** for a search cursor which wins against all others, these get pushed out of the loser 
+    ** tree as the search cursors are added to it
+    */
+    for ( uiI = 0; uiI < pscSrchCursor->uiSrchCursorsLength; uiI++ ) {
+        pscSrchCursor->puiLoserTree[uiI] = pscSrchCursor->uiSrchCursorsLength;
+        pscSrchCursor->puiLoserTreeDocumentIDs[uiI] = SRCH_CURSOR_LOSER_TREE_DOCUMENT_ID(pscSrchCursor->ppscSrchCursors[uiI]);
+    }
+    for ( uiI = pscSrchCursor->uiSrchCursorsLength; uiI > 0; uiI-- ) {
+        iSrchCursorAdjustLoserTree(pscSrchCursor, uiI - 1);
+    }
+
+
+    /* Position the cursor on the first document */
+    if ( (iError = iSrchCursorFindDocumentMultiOR(pscSrchCursor)) != SRCH_NoError ) {
+        goto bailFromiSrchCursorCreateMultiORFromSrchCursors;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchCursorCreateMultiORFromSrchCursors:
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointer */
+        *ppscSrchCursor = pscSrchCursor;
+    }
+    else {
+
+        /* Free the search cursor structure, along with the cursors it took over */
+        iSrchCursorFree(pscSrchCursor);
+        pscSrchCursor = NULL;
+
+        /* Free the cursors which were not taken over */
+        for ( uiI = 0; uiI < uiSrchCursorsLength; uiI++ ) {
+            iSrchCursorFree(ppscSrchCursors[uiI]);
+            ppscSrchCursors[uiI] = NULL;
+        }
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorFree()
+
+    Purpose:    This function frees the search cursor structure, along with
+                the cursors and the search postings list it took over
+
+    Parameters: pscSrchCursor       search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorFree
+(
+    struct srchCursor *pscSrchCursor
+)
+{
+
+    /* Free the search cursor structure */
+    if ( pscSrchCursor != NULL ) {
+
+        iSrchPostingFreeSrchPostingsList(pscSrchCursor->psplSrchPostingsList);
+        pscSrchCursor->psplSrchPostingsList = NULL;
+
+        iSrchCursorFree(pscSrchCursor->pscSrchCursor1);
+        pscSrchCursor->pscSrchCursor1 = NULL;
+
+        iSrchCursorFree(pscSrchCursor->pscSrchCursor2);
+        pscSrchCursor->pscSrchCursor2 = NULL;
+
+        if ( pscSrchCursor->ppscSrchCursors != NULL ) {
+
+            unsigned int    uiI = 0;
+
+            for ( uiI = 0; uiI < pscSrchCursor->uiSrchCursorsLength; uiI++ ) {
+                iSrchCursorFree(pscSrchCursor->ppscSrchCursors[uiI]);
+            }
+
+            s_free(pscSrchCursor->ppscSrchCursors);
+        }
+
+        s_free(pscSrchCursor->puiSrchCursorsDocument);
+        s_free(pscSrchCursor->puiLoserTree);
+        s_free(pscSrchCursor->puiLoserTreeDocumentIDs);
+        s_free(pscSrchCursor->pscbSrchCursorBounds);
+        s_free(pscSrchCursor->ppscbSrchCursorBoundsSorted);
+        s_free(pscSrchCursor->pspSrchPostingsScratch);
+        s_free(pscSrchCursor->pspSrchPostingsBuffer);
+        s_free(pscSrchCursor);
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorNextDocument()
+
+    Purpose:    This function moves the cursor to the next document, the
+                document ID will be set to SRCH_CURSOR_DOCUMENT_ID_NONE
+                if the cursor runs out of documents.
+
+    Parameters: pscSrchCursor       search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorNextDocument
+(
+    struct srchCursor *pscSrchCursor
+)
+{
+
+    int     iError = SRCH_NoError;
+
+
+    /* Check the parameters */
+    if ( pscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pscSrchCursor' parameter passed to 'iSrchCursorNextDocument'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+
+    /* Nothing to do if we have run out of documents */
+    if ( pscSrchCursor->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Postings cursor, the next document starts right after the postings for the current document */
+    if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_POSTINGS_ID ) {
+        if ( pscSrchCursor->psplSrchPostingsList->pvUtlRoaring != NULL ) {
+            return (iSrchCursorSetDocumentContainersDocument(pscSrchCursor, pscSrchCursor->uiDocumentID + 1));
+        }
+        return (iSrchCursorSetDocument(pscSrchCursor, pscSrchCursor->pspSrchPostings + pscSrchCursor->uiSrchPostingsLength));
+    }
+
+
+    /* WAND cursor, move the cursors which are on the current document along and find the next document */
+    if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_WAND_ID ) {
+
+        unsigned int    uiI = 0;
+
+        for ( uiI = 0; uiI < pscSrchCursor->uiSrchCursorBoundsLength; uiI++ ) {
+            if ( pscSrchCursor->pscbSrchCursorBounds[uiI].pscSrchCursor->uiDocumentID == pscSrchCursor->uiDocumentID ) {
+                if ( (iError = iSrchCursorNextDocument(pscSrchCursor->pscbSrchCursorBounds[uiI].pscSrchCursor)) != SRCH_NoError ) {
+                    return (iError);
+                }
+            }
+        }
+
+        return (iSrchCursorFindDocumentWAND(pscSrchCursor));
+    }
+
+
+    /* Multi OR cursor, move the winning cursor along and replay it up the loser tree until it is past the current document, and find the next document */
+    if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_MULTI_OR_ID ) {
+
+        while ( pscSrchCursor->puiLoserTreeDocumentIDs[pscSrchCursor->puiLoserTree[0]] == pscSrchCursor->uiDocumentID ) {
+
+            unsigned int    uiIndex = pscSrchCursor->puiLoserTree[0];
+
+            if ( (iError = iSrchCursorNextDocument(pscSrchCursor->ppscSrchCursors[uiIndex])) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            pscSrchCursor->puiLoserTreeDocumentIDs[uiIndex] = SRCH_CURSOR_LOSER_TREE_DOCUMENT_ID(pscSrchCursor->ppscSrchCursors[uiIndex]);
+            iSrchCursorAdjustLoserTree(pscSrchCursor, uiIndex);
+        }
+
+        return (iSrchCursorFindDocumentMultiOR(pscSrchCursor));
+    }
+
+
+    /* Operator cursor, move the cursors which are on the current document along and find the next document */
+    if ( pscSrchCursor->pscSrchCursor1->uiDocumentID == pscSrchCursor->uiDocumentID ) {
+        if ( (iError = iSrchCursorNextDocument(pscSrchCursor->pscSrchCursor1)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+    if ( pscSrchCursor->pscSrchCursor2->uiDocumentID == pscSrchCursor->uiDocumentID ) {
+        if ( (iError = iSrchCursorNextDocument(pscSrchCursor->pscSrchCursor2)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+
+    return (iSrchCursorFindDocument(pscSrchCursor));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorSeekDocument()
+
+    Purpose:    This function moves the cursor to the first document whose
+                document ID is greater than or equal to the passed document ID.
+                The cursor is not moved if it is already there, and the document
+                ID will be set to SRCH_CURSOR_DOCUMENT_ID_NONE if the cursor
+                runs out of documents.
+
+    Parameters: pscSrchCursor       search cursor structure
+                uiDocumentID        document ID to seek to
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorSeekDocument
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiDocumentID
+)
+{
+
+    int     iError = SRCH_NoError;
+
+
+    /* Check the parameters */
+    if ( pscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pscSrchCursor' parameter passed to 'iSrchCursorSeekDocument'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+
+    /* Nothing to do if we have run out of documents or if we are already there */
+    if ( (pscSrchCursor->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE) || (pscSrchCursor->uiDocumentID >= uiDocumentID) ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Postings cursor, gallop through the postings */
+    if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_POSTINGS_ID ) {
+
+        struct srchPosting      *pspSrchPostingsPtr = NULL;
+
+        if ( pscSrchCursor->psplSrchPostingsList->pvUtlRoaring != NULL ) {
+            return (iSrchCursorSetDocumentContainersDocument(pscSrchCursor, uiDocumentID));
+        }
+
+        pspSrchPostingsPtr = pspSrchPostingSeekDocumentID(pscSrchCursor->pspSrchPostings + pscSrchCursor->uiSrchPostingsLength,
+                pscSrchCursor->pspSrchPostingsEnd, uiDocumentID);
+
+        /* Decode the next search postings, skipping ahead to the document ID, until we get to it or run out of search postings */
+        while ( (pspSrchPostingsPtr >= pscSrchCursor->pspSrchPostingsEnd) && (pscSrchCursor->psplSrchPostingsList->pvSrchTermSearchDecoder != NULL) ) {
+            if ( (iError = iSrchCursorDecodeNextSrchPostings(pscSrchCursor, uiDocumentID)) != SRCH_NoError ) {
+                return (iError);
+            }
+            pspSrchPostingsPtr = pspSrchPostingSeekDocumentID(pscSrchCursor->psplSrchPostingsList->pspSrchPostings, pscSrchCursor->pspSrchPostingsEnd, uiDocumentID);
+        }
+
+        return (iSrchCursorSetDocument(pscSrchCursor, pspSrchPostingsPtr));
+    }
+
+
+    /* WAND cursor, seek all the cursors and find the next document */
+    if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_WAND_ID ) {
+
+        unsigned int    uiI = 0;
+
+        for ( uiI = 0; uiI < pscSrchCursor->uiSrchCursorBoundsLength; uiI++ ) {
+            if ( (iError = iSrchCursorSeekDocument(pscSrchCursor->pscbSrchCursorBounds[uiI].pscSrchCursor, uiDocumentID)) != SRCH_NoError ) {
+                return (iError);
+            }
+        }
+
+        return (iSrchCursorFindDocumentWAND(pscSrchCursor));
+    }
+
+
+    /* Multi OR cursor, seek the winning cursor and replay it up the loser tree until it is at or past the document ID, and find the next document */
+    if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_MULTI_OR_ID ) {
+
+        while ( pscSrchCursor->puiLoserTreeDocumentIDs[pscSrchCursor->puiLoserTree[0]] < uiDocumentID ) {
+
+            unsigned int    uiIndex = pscSrchCursor->puiLoserTree[0];
+
+            if ( (iError = iSrchCursorSeekDocument(pscSrchCursor->ppscSrchCursors[uiIndex], uiDocumentID)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            pscSrchCursor->puiLoserTreeDocumentIDs[uiIndex] = SRCH_CURSOR_LOSER_TREE_DOCUMENT_ID(pscSrchCursor->ppscSrchCursors[uiIndex]);
+            iSrchCursorAdjustLoserTree(pscSrchCursor, uiIndex);
+        }
+
+        return (iSrchCursorFindDocumentMultiOR(pscSrchCursor));
+    }
+
+
+    /* Operator cursor, seek both cursors and find the next document */
+    if ( (iError = iSrchCursorSeekDocument(pscSrchCursor->pscSrchCursor1, uiDocumentID)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    if ( (iError = iSrchCursorSeekDocument(pscSrchCursor->pscSrchCursor2, uiDocumentID)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
+    return (iSrchCursorFindDocument(pscSrchCursor));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorSetMinimumWeight()
+
+    Purpose:    This function sets the weight a document needs to exceed for 
+                a WAND cursor to stop on it, the minimum weight only ever 
+                goes up and takes effect when the cursor is next moved.
+
+    Parameters: pscSrchCursor       search cursor structure
+                fMinimumWeight      minimum weight
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorSetMinimumWeight
+(
+    struct srchCursor *pscSrchCursor,
+    float fMinimumWeight
+)
+{
+
+    /* Check the parameters */
+    if ( pscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pscSrchCursor' parameter passed to 'iSrchCursorSetMinimumWeight'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+    if ( pscSrchCursor->uiCursorTypeID != SRCH_CURSOR_TYPE_WAND_ID ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'pscSrchCursor' parameter passed to 'iSrchCursorSetMinimumWeight', not a WAND cursor.");
+        return (SRCH_CursorInvalidCursorType);
+    }
+
+
+    /* Raise the minimum weight */
+    pscSrchCursor->fMinimumWeight = UTL_MACROS_MAX(pscSrchCursor->fMinimumWeight, fMinimumWeight);
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorGetDocumentID()
+
+    Purpose:    This function gets the current document ID for the cursor,
+                this will be SRCH_CURSOR_DOCUMENT_ID_NONE if the cursor
+                has run out of documents.
+
+    Parameters: pscSrchCursor       search cursor structure
+                puiDocumentID       return pointer for the document ID
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorGetDocumentID
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int *puiDocumentID
+)
+{
+
+    /* Check the parameters */
+    if ( pscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pscSrchCursor' parameter passed to 'iSrchCursorGetDocumentID'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+    if ( puiDocumentID == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiDocumentID' parameter passed to 'iSrchCursorGetDocumentID'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Set the return pointer */
+    *puiDocumentID = pscSrchCursor->uiDocumentID;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorGetSrchPostings()
+
+    Purpose:    This function gets the search postings for the current document,
+                these carry the term positions and the weights, and are only
+                valid until the cursor is moved.
+
+    Parameters: pscSrchCursor               search cursor structure
+                ppspSrchPostings            return pointer for the search postings
+                puiSrchPostingsLength       return pointer for the search postings length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorGetSrchPostings
+(
+    struct srchCursor *pscSrchCursor,
+    struct srchPosting **ppspSrchPostings,
+    unsigned int *puiSrchPostingsLength
+)
+{
+
+    int         iError = SRCH_NoError;
+
+
+    /* Check the parameters */
+    if ( pscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pscSrchCursor' parameter passed to 'iSrchCursorGetSrchPostings'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+    if ( ppspSrchPostings == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppspSrchPostings' parameter passed to 'iSrchCursorGetSrchPostings'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiSrchPostingsLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiSrchPostingsLength' parameter passed to 'iSrchCursorGetSrchPostings'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Load the term positions of the search postings */
+    if ( (iError = iSrchCursorLoadTermPositions(pscSrchCursor)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
+    /* Set the return pointers */
+    *ppspSrchPostings = pscSrchCursor->pspSrchPostings;
+    *puiSrchPostingsLength = pscSrchCursor->uiSrchPostingsLength;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorGetWeight()
+
+    Purpose:    This function gets the weight of the current document,
+                which is the sum of the weights of its search postings
+
+    Parameters: pscSrchCursor       search cursor structure
+                pfWeight            return pointer for the weight
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorGetWeight
+(
+    struct srchCursor *pscSrchCursor,
+    float *pfWeight
+)
+{
+
+    struct srchPosting      *pspSrchPostingsPtr = NULL;
+    struct srchPosting      *pspSrchPostingsEnd = NULL;
+    float                   fWeight = 0;
+
+
+    /* Check the parameters */
+    if ( pscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pscSrchCursor' parameter passed to 'iSrchCursorGetWeight'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+    if ( pfWeight == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pfWeight' parameter passed to 'iSrchCursorGetWeight'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Add up the weights */
+    for ( pspSrchPostingsPtr = pscSrchCursor->pspSrchPostings, pspSrchPostingsEnd = pscSrchCursor->pspSrchPostings + pscSrchCursor->uiSrchPostingsLength;
+            pspSrchPostingsPtr < pspSrchPostingsEnd; pspSrchPostingsPtr++ ) {
+        fWeight += pspSrchPostingsPtr->fWeight;
+    }
+
+
+    /* Set the return pointer */
+    *pfWeight = fWeight;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorGetSrchPostingsList()
+
+    Purpose:    This function drains the cursor from its current document into
+                a search postings list with one search posting per document,
+                the weight of that search posting being the weight of the
+                document.
+
+                A postings cursor which has not been moved simply hands over
+                its search postings list rather than copying it, unless the
+                search postings list has document containers, any search 
+                postings which have not been decoded yet are decoded first.
+
+    Parameters: pscSrchCursor               search cursor structure
+                ppsplSrchPostingsList       return pointer for the search postings list structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchCursorGetSrchPostingsList
+(
+    struct srchCursor *pscSrchCursor,
+    struct srchPostingsList **ppsplSrchPostingsList
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchPostingsList     *psplSrchPostingsList = NULL;
+    struct srchPosting          *pspSrchPostings = NULL;
+    unsigned int                uiSrchPostingsLength = 0;
+    unsigned int                uiSrchPostingsCapacity = 0;
+
+
+    /* Check the parameters */
+    if ( pscSrchCursor == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pscSrchCursor' parameter passed to 'iSrchCursorGetSrchPostingsList'.");
+        return (SRCH_CursorInvalidCursor);
+    }
+
+    if ( ppsplSrchPostingsList == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppsplSrchPostingsList' parameter passed to 'iSrchCursorGetSrchPostingsList'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Hand over the search postings list if this is a postings cursor which has not been moved */
+    if ( (pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_POSTINGS_ID) && (pscSrchCursor->psplSrchPostingsList->pvUtlRoaring == NULL) && 
+            (pscSrchCursor->bSrchPostingsListMoved == false) &&
+            ((pscSrchCursor->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE) || (pscSrchCursor->pspSrchPostings == pscSrchCursor->psplSrchPostingsList->pspSrchPostings)) ) {
+
+        /* Decode the search postings which have not been decoded yet */
+        if ( (iError = iSrchPostingDecodeSrchPostings(pscSrchCursor->psplSrchPostingsList)) != SRCH_NoError ) {
+            return (iError);
+        }
+
+        *ppsplSrchPostingsList = pscSrchCursor->psplSrchPostingsList;
+
+        /* The cursor no longer has any postings */
+        pscSrchCursor->psplSrchPostingsList = NULL;
+        pscSrchCursor->pspSrchPostingsEnd = NULL;
+        pscSrchCursor->uiDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+        pscSrchCursor->pspSrchPostings = NULL;
+        pscSrchCursor->uiSrchPostingsLength = 0;
+
+        return (SRCH_NoError);
+    }
+
+
+    /* Drain the cursor */
+    while ( pscSrchCursor->uiDocumentID != SRCH_CURSOR_DOCUMENT_ID_NONE ) {
+
+        /* Make sure there is enough space for this search posting */
+        if ( uiSrchPostingsLength == uiSrchPostingsCapacity ) {
+
+            struct srchPosting      *pspSrchPostingsPtr = NULL;
+            unsigned int            uiNewSrchPostingsCapacity = (uiSrchPostingsCapacity == 0) ? SRCH_CURSOR_SRCH_POSTINGS_LENGTH_INITIAL : uiSrchPostingsCapacity * 2;
+
+            if ( (pspSrchPostingsPtr = (struct srchPosting *)s_realloc(pspSrchPostings, (size_t)(uiNewSrchPostingsCapacity * sizeof(struct srchPosting)))) == NULL ) {
+                iError = SRCH_MemError;
+                goto bailFromiSrchCursorGetSrchPostingsList;
+            }
+
+            pspSrchPostings = pspSrchPostingsPtr;
+            uiSrchPostingsCapacity = uiNewSrchPostingsCapacity;
+        }
+
+        /* Add the search posting for this document */
+        SRCH_CURSOR_COPY_SRCH_POSTING(pspSrchPostings + uiSrchPostingsLength, pscSrchCursor->pspSrchPostings);
+        if ( (iError = iSrchCursorGetWeight(pscSrchCursor, &(pspSrchPostings + uiSrchPostingsLength)->fWeight)) != SRCH_NoError ) {
+            goto bailFromiSrchCursorGetSrchPostingsList;
+        }
+        uiSrchPostingsLength++;
+
+        /* Move to the next document */
+        if ( (iError = iSrchCursorNextDocument(pscSrchCursor)) != SRCH_NoError ) {
+            goto bailFromiSrchCursorGetSrchPostingsList;
+        }
+    }
+
+
+    /* Adjust the size of the search postings */
+    if ( (uiSrchPostingsLength > 0) && (uiSrchPostingsLength < uiSrchPostingsCapacity) ) {
+
+        struct srchPosting      *pspSrchPostingsPtr = NULL;
+
+        if ( (pspSrchPostingsPtr = (struct srchPosting *)s_realloc(pspSrchPostings, (size_t)(uiSrchPostingsLength * sizeof(struct srchPosting)))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchCursorGetSrchPostingsList;
+        }
+
+        pspSrchPostings = pspSrchPostingsPtr;
+    }
+
+
+    /* Create the search postings list, handing over the search postings */
+    if ( (iError = iSrchPostingCreateSrchPostingsList(pscSrchCursor->uiTermType, uiSrchPostingsLength, uiSrchPostingsLength,
+            pscSrchCursor->bRequired, pspSrchPostings, uiSrchPostingsLength, &psplSrchPostingsList)) != SRCH_NoError ) {
+        goto bailFromiSrchCursorGetSrchPostingsList;
+    }
+
+    ASSERT(iSrchPostingCheckSrchPostingsList(psplSrchPostingsList) == SRCH_NoError);
+
+
+
+    /* Bail label */
+    bailFromiSrchCursorGetSrchPostingsList:
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointer */
+        *ppsplSrchPostingsList = psplSrchPostingsList;
+    }
+    else {
+
+        /* Free the search postings */
+        s_free(pspSrchPostings);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorSetDocument()
+
+    Purpose:    This function positions a postings cursor on the document
+                whose search postings start at the passed pointer, the next
+                search postings are decoded if the pointer is at the end of
+                the search postings decoded so far
+
+    Parameters: pscSrchCursor           search cursor structure
+                pspSrchPostingsPtr      search postings pointer
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorSetDocument
+(
+    struct srchCursor *pscSrchCursor,
+    struct srchPosting *pspSrchPostingsPtr
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchPosting      *pspSrchPostingsEnd = NULL;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_POSTINGS_ID);
+
+
+    /* Decode the next search postings if we are at the end of the search postings decoded so far */
+    while ( ((pspSrchPostingsPtr == NULL) || (pspSrchPostingsPtr >= pscSrchCursor->pspSrchPostingsEnd)) && 
+            (pscSrchCursor->psplSrchPostingsList->pvSrchTermSearchDecoder != NULL) ) {
+        if ( (iError = iSrchCursorDecodeNextSrchPostings(pscSrchCursor, 0)) != SRCH_NoError ) {
+            return (iError);
+        }
+        pspSrchPostingsPtr = pscSrchCursor->psplSrchPostingsList->pspSrchPostings;
+    }
+
+
+    /* Run out of documents */
+    if ( (pspSrchPostingsPtr == NULL) || (pspSrchPostingsPtr >= pscSrchCursor->pspSrchPostingsEnd) ) {
+        pscSrchCursor->uiDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+        pscSrchCursor->pspSrchPostings = NULL;
+        pscSrchCursor->uiSrchPostingsLength = 0;
+        return (SRCH_NoError);
+    }
+
+
+    /* Find the end of the search postings for this document */
+    for ( pspSrchPostingsEnd = pspSrchPostingsPtr + 1; (pspSrchPostingsEnd < pscSrchCursor->pspSrchPostingsEnd) &&
+            (pspSrchPostingsEnd->uiDocumentID == pspSrchPostingsPtr->uiDocumentID); pspSrchPostingsEnd++ ) {
+        ;
+    }
+
+    /* Set the current document */
+    pscSrchCursor->uiDocumentID = pspSrchPostingsPtr->uiDocumentID;
+    pscSrchCursor->pspSrchPostings = pspSrchPostingsPtr;
+    pscSrchCursor->uiSrchPostingsLength = pspSrchPostingsEnd - pspSrchPostingsPtr;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorDecodeNextSrchPostings()
+
+    Purpose:    This function replaces the search postings of the search postings 
+                list of a postings cursor with the next ones decoded on demand, 
+                skipping ahead to the document ID if it can. The cursor needs to be 
+                positioned on a document in the new search postings afterwards.
+
+    Parameters: pscSrchCursor       search cursor structure
+                uiDocumentID        document ID to skip ahead to (0 for no skipping)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorDecodeNextSrchPostings
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiDocumentID
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchPostingsList     *psplSrchPostingsList = NULL;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_POSTINGS_ID);
+    ASSERT(pscSrchCursor->psplSrchPostingsList->pvSrchTermSearchDecoder != NULL);
+
+
+    psplSrchPostingsList = pscSrchCursor->psplSrchPostingsList;
+
+    /* Decode the next search postings */
+    if ( (iError = iSrchTermSearchDecodeNextSrchPostings(psplSrchPostingsList, uiDocumentID)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    /* Reset the end, the search postings list no longer holds its first search postings */
+    pscSrchCursor->pspSrchPostingsEnd = (psplSrchPostingsList->uiSrchPostingsLength > 0) ?
+            psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength : psplSrchPostingsList->pspSrchPostings;
+    pscSrchCursor->bSrchPostingsListMoved = true;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorSetDocumentContainersDocument()
+
+    Purpose:    This function positions a postings cursor whose search postings 
+                list has document containers on the first document whose 
+                document ID is greater than or equal to the passed document ID,
+                the search posting for that document is set up in the search 
+                postings buffer
+
+    Parameters: pscSrchCursor       search cursor structure
+                uiDocumentID        document ID
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorSetDocumentContainersDocument
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiDocumentID
+)
+{
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_POSTINGS_ID);
+    ASSERT(pscSrchCursor->psplSrchPostingsList->pvUtlRoaring != NULL);
+    ASSERT(pscSrchCursor->uiSrchPostingsBufferLength >= 1);
+
+
+    /* Run out of documents */
+    if ( (uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE) || 
+            (iUtlRoaringGetNextValue(pscSrchCursor->psplSrchPostingsList->pvUtlRoaring, uiDocumentID, &uiDocumentID) != UTL_NoError) ) {
+        pscSrchCursor->uiDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+        pscSrchCursor->pspSrchPostings = NULL;
+        pscSrchCursor->uiSrchPostingsLength = 0;
+        return (SRCH_NoError);
+    }
+
+
+    /* Set up the search posting for this document */
+    pscSrchCursor->pspSrchPostingsBuffer->uiDocumentID = uiDocumentID;
+    pscSrchCursor->pspSrchPostingsBuffer->uiTermPosition = 0;
+    pscSrchCursor->pspSrchPostingsBuffer->fWeight = pscSrchCursor->psplSrchPostingsList->fDocumentContainersWeight;
+
+    /* Set the current document */
+    pscSrchCursor->uiDocumentID = uiDocumentID;
+    pscSrchCursor->pspSrchPostings = pscSrchCursor->pspSrchPostingsBuffer;
+    pscSrchCursor->uiSrchPostingsLength = 1;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorFindDocument()
+
+    Purpose:    This function positions an operator cursor on the first document
+                it matches, starting from where its two cursors are positioned.
+
+    Parameters: pscSrchCursor       search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorFindDocument
+(
+    struct srchCursor *pscSrchCursor
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchCursor       *pscSrchCursor1 = NULL;
+    struct srchCursor       *pscSrchCursor2 = NULL;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID != SRCH_CURSOR_TYPE_POSTINGS_ID);
+    ASSERT(pscSrchCursor->pscSrchCursor1 != NULL);
+    ASSERT(pscSrchCursor->pscSrchCursor2 != NULL);
+
+
+    pscSrchCursor1 = pscSrchCursor->pscSrchCursor1;
+    pscSrchCursor2 = pscSrchCursor->pscSrchCursor2;
+
+
+    /* Loop until we find a document or run out of documents */
+    while ( true ) {
+
+        unsigned int    uiDocumentID1 = pscSrchCursor1->uiDocumentID;
+        unsigned int    uiDocumentID2 = pscSrchCursor2->uiDocumentID;
+        unsigned int    uiDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+
+        /* Reset the search postings for the current document */
+        pscSrchCursor->pspSrchPostings = NULL;
+        pscSrchCursor->uiSrchPostingsLength = 0;
+        pscSrchCursor->bTermPositionsPending = false;
+
+
+        /* OR - any document in either cursor */
+        if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_OR_ID ) {
+
+            if ( (uiDocumentID1 == SRCH_CURSOR_DOCUMENT_ID_NONE) && (uiDocumentID2 == SRCH_CURSOR_DOCUMENT_ID_NONE) ) {
+                break;
+            }
+
+            uiDocumentID = (uiDocumentID1 == SRCH_CURSOR_DOCUMENT_ID_NONE) ? uiDocumentID2 :
+                    ((uiDocumentID2 == SRCH_CURSOR_DOCUMENT_ID_NONE) ? uiDocumentID1 : UTL_MACROS_MIN(uiDocumentID1, uiDocumentID2));
+
+            if ( (iError = iSrchCursorMergeORCursors(pscSrchCursor, uiDocumentID, false)) != SRCH_NoError ) {
+                return (iError);
+            }
+        }
+
+        /* IOR - any document in the first cursor, along with the second cursor if it is there too */
+        else if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_IOR_ID ) {
+
+            if ( uiDocumentID1 == SRCH_CURSOR_DOCUMENT_ID_NONE ) {
+                break;
+            }
+
+            if ( (iError = iSrchCursorSeekDocument(pscSrchCursor2, uiDocumentID1)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            uiDocumentID = uiDocumentID1;
+
+            if ( (iError = iSrchCursorMergeORCursors(pscSrchCursor, uiDocumentID, false)) != SRCH_NoError ) {
+                return (iError);
+            }
+        }
+
+        /* XOR - any document in only one of the cursors */
+        else if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_XOR_ID ) {
+
+            if ( (uiDocumentID1 == SRCH_CURSOR_DOCUMENT_ID_NONE) && (uiDocumentID2 == SRCH_CURSOR_DOCUMENT_ID_NONE) ) {
+                break;
+            }
+
+            /* Document in both cursors, skip it */
+            if ( uiDocumentID1 == uiDocumentID2 ) {
+
+                if ( (iError = iSrchCursorNextDocument(pscSrchCursor1)) != SRCH_NoError ) {
+                    return (iError);
+                }
+
+                if ( (iError = iSrchCursorNextDocument(pscSrchCursor2)) != SRCH_NoError ) {
+                    return (iError);
+                }
+
+                continue;
+            }
+
+            /* The search postings are passed through as they are, along with their term positions if they have not been loaded */
+            pscSrchCursor->bTermPositionsPending = true;
+
+            if ( (uiDocumentID2 == SRCH_CURSOR_DOCUMENT_ID_NONE) || ((uiDocumentID1 != SRCH_CURSOR_DOCUMENT_ID_NONE) && (uiDocumentID1 < uiDocumentID2)) ) {
+                uiDocumentID = uiDocumentID1;
+                pscSrchCursor->pspSrchPostings = pscSrchCursor1->pspSrchPostings;
+                pscSrchCursor->uiSrchPostingsLength = pscSrchCursor1->uiSrchPostingsLength;
+            }
+            else {
+                uiDocumentID = uiDocumentID2;
+                pscSrchCursor->pspSrchPostings = pscSrchCursor2->pspSrchPostings;
+                pscSrchCursor->uiSrchPostingsLength = pscSrchCursor2->uiSrchPostingsLength;
+            }
+        }
+
+        /* NOT - any document in the first cursor which is not in the second cursor */
+        else if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_NOT_ID ) {
+
+            if ( uiDocumentID1 == SRCH_CURSOR_DOCUMENT_ID_NONE ) {
+                break;
+            }
+
+            if ( (iError = iSrchCursorSeekDocument(pscSrchCursor2, uiDocumentID1)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            /* Document in both cursors, skip it */
+            if ( pscSrchCursor2->uiDocumentID == uiDocumentID1 ) {
+
+                if ( (iError = iSrchCursorNextDocument(pscSrchCursor1)) != SRCH_NoError ) {
+                    return (iError);
+                }
+
+                continue;
+            }
+
+            /* The search postings are passed through as they are, along with their term positions if they have not been loaded */
+            uiDocumentID = uiDocumentID1;
+            pscSrchCursor->bTermPositionsPending = true;
+            pscSrchCursor->pspSrchPostings = pscSrchCursor1->pspSrchPostings;
+            pscSrchCursor->uiSrchPostingsLength = pscSrchCursor1->uiSrchPostingsLength;
+        }
+
+        /* AND, ADJ, NEAR - any document in both cursors, leapfrogging one cursor over the other until they agree */
+        else {
+
+            if ( (uiDocumentID1 == SRCH_CURSOR_DOCUMENT_ID_NONE) || (uiDocumentID2 == SRCH_CURSOR_DOCUMENT_ID_NONE) ) {
+                break;
+            }
+
+            if ( uiDocumentID1 < uiDocumentID2 ) {
+                if ( (iError = iSrchCursorSeekDocument(pscSrchCursor1, uiDocumentID2)) != SRCH_NoError ) {
+                    return (iError);
+                }
+                continue;
+            }
+
+            if ( uiDocumentID2 < uiDocumentID1 ) {
+                if ( (iError = iSrchCursorSeekDocument(pscSrchCursor2, uiDocumentID1)) != SRCH_NoError ) {
+                    return (iError);
+                }
+                continue;
+            }
+
+            uiDocumentID = uiDocumentID1;
+
+            /* These merges go by term position */
+            if ( ((iError = iSrchCursorLoadTermPositions(pscSrchCursor1)) != SRCH_NoError) || 
+                    ((iError = iSrchCursorLoadTermPositions(pscSrchCursor2)) != SRCH_NoError) ) {
+                return (iError);
+            }
+
+            if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_AND_ID ) {
+                iError = iSrchCursorMergeAND(pscSrchCursor, pscSrchCursor1->pspSrchPostings, pscSrchCursor1->uiSrchPostingsLength,
+                        pscSrchCursor2->pspSrchPostings, pscSrchCursor2->uiSrchPostingsLength);
+            }
+            else if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_ADJ_ID ) {
+                iError = iSrchCursorMergeADJ(pscSrchCursor, pscSrchCursor1->pspSrchPostings, pscSrchCursor1->uiSrchPostingsLength,
+                        pscSrchCursor2->pspSrchPostings, pscSrchCursor2->uiSrchPostingsLength);
+            }
+            else if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_NEAR_ID ) {
+                iError = iSrchCursorMergeNEAR(pscSrchCursor, pscSrchCursor1->pspSrchPostings, pscSrchCursor1->uiSrchPostingsLength,
+                        pscSrchCursor2->pspSrchPostings, pscSrchCursor2->uiSrchPostingsLength);
+            }
+            else {
+                ASSERT(false);
+            }
+
+            if ( iError != SRCH_NoError ) {
+                return (iError);
+            }
+
+            /* The terms did not fall close enough to each other in this document, skip it */
+            if ( pscSrchCursor->uiSrchPostingsLength == 0 ) {
+
+                if ( (iError = iSrchCursorNextDocument(pscSrchCursor1)) != SRCH_NoError ) {
+                    return (iError);
+                }
+
+                if ( (iError = iSrchCursorNextDocument(pscSrchCursor2)) != SRCH_NoError ) {
+                    return (iError);
+                }
+
+                continue;
+            }
+        }
+
+
+        /* Set the current document */
+        pscSrchCursor->uiDocumentID = uiDocumentID;
+
+        return (SRCH_NoError);
+    }
+
+
+    /* Run out of documents */
+    pscSrchCursor->uiDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+    pscSrchCursor->pspSrchPostings = NULL;
+    pscSrchCursor->uiSrchPostingsLength = 0;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorFindDocumentWAND()
+
+    Purpose:    This function positions a WAND cursor on the first document whose
+                weight exceeds the minimum weight, starting from where its cursors 
+                are positioned.
+
+                The cursors are sorted by document ID and the upper bounds of 
+                their weights are added up in that order until they exceed the 
+                minimum weight, the document where this happens is the pivot and 
+                no document before it can make it. The search posting blocks 
+                the pivot falls in then give a tighter bound, and if even that 
+                does not exceed the minimum weight we can skip to the end of the 
+                nearest block. Otherwise the pivot is scored if all the cursors 
+                before it are on it, or they are moved up to it.
+
+    Parameters: pscSrchCursor       search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorFindDocumentWAND
+(
+    struct srchCursor *pscSrchCursor
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchCursorBound  **ppscbSrchCursorBoundsSorted = NULL;
+    unsigned int            uiSrchCursorBoundsLength = 0;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_WAND_ID);
+
+
+    ppscbSrchCursorBoundsSorted = pscSrchCursor->ppscbSrchCursorBoundsSorted;
+    uiSrchCursorBoundsLength = pscSrchCursor->uiSrchCursorBoundsLength;
+
+
+    /* Loop until we find a document or run out of documents */
+    while ( true ) {
+
+        unsigned int            uiI = 0;
+        unsigned int            uiJ = 0;
+        unsigned int            uiActiveLength = 0;
+        unsigned int            uiPivot = 0;
+        unsigned int            uiPivotDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+        unsigned int            uiNextDocumentID = UINT_MAX;
+        float                   fWeight = 0;
+        struct srchCursorBound  *pscbSrchCursorBoundsPtr = NULL;
+
+        /* Reset the search postings for the current document */
+        pscSrchCursor->pspSrchPostings = NULL;
+        pscSrchCursor->uiSrchPostingsLength = 0;
+        pscSrchCursor->bTermPositionsPending = false;
+
+
+        /* Sort the cursors by document ID, insertion sort because they are nearly sorted 
+        ** already, cursors which have run out of documents go to the end
+        */
+        for ( uiI = 1; uiI < uiSrchCursorBoundsLength; uiI++ ) {
+
+            unsigned int    uiDocumentID = 0;
+
+            pscbSrchCursorBoundsPtr = ppscbSrchCursorBoundsSorted[uiI];
+            uiDocumentID = (pscbSrchCursorBoundsPtr->pscSrchCursor->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE) ? UINT_MAX : pscbSrchCursorBoundsPtr->pscSrchCursor->uiDocumentID;
+
+            for ( uiJ = uiI; (uiJ > 0) && (((ppscbSrchCursorBoundsSorted[uiJ - 1]->pscSrchCursor->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE) ? 
+                    UINT_MAX : ppscbSrchCursorBoundsSorted[uiJ - 1]->pscSrchCursor->uiDocumentID) > uiDocumentID); uiJ-- ) {
+                ppscbSrchCursorBoundsSorted[uiJ] = ppscbSrchCursorBoundsSorted[uiJ - 1];
+            }
+
+            ppscbSrchCursorBoundsSorted[uiJ] = pscbSrchCursorBoundsPtr;
+        }
+
+        /* Count the cursors which still have documents */
+        for ( uiActiveLength = 0; (uiActiveLength < uiSrchCursorBoundsLength) && 
+                (ppscbSrchCursorBoundsSorted[uiActiveLength]->pscSrchCursor->uiDocumentID != SRCH_CURSOR_DOCUMENT_ID_NONE); uiActiveLength++ ) {
+            ;
+        }
+
+
+        /* Find the pivot, the first cursor where the upper bounds add up to more than the minimum weight */
+        for ( uiPivot = 0, fWeight = 0; uiPivot < uiActiveLength; uiPivot++ ) {
+            fWeight += ppscbSrchCursorBoundsSorted[uiPivot]->fMaxWeight;
+            if ( fWeight > pscSrchCursor->fMinimumWeight ) {
+                break;
+            }
+        }
+
+        /* No pivot, so no remaining document can exceed the minimum weight, any cursors still on a document get passed over */
+        if ( uiPivot == uiActiveLength ) {
+            if ( uiActiveLength > 0 ) {
+                pscSrchCursor->bSkippedDocuments = true;
+            }
+            break;
+        }
+
+        /* Include the cursors after the pivot which are on the same document */
+        uiPivotDocumentID = ppscbSrchCursorBoundsSorted[uiPivot]->pscSrchCursor->uiDocumentID;
+        for ( ; ((uiPivot + 1) < uiActiveLength) && (ppscbSrchCursorBoundsSorted[uiPivot + 1]->pscSrchCursor->uiDocumentID == uiPivotDocumentID); uiPivot++ ) {
+            ;
+        }
+
+        /* The next document a cursor past the pivot is on */
+        if ( (uiPivot + 1) < uiActiveLength ) {
+            uiNextDocumentID = ppscbSrchCursorBoundsSorted[uiPivot + 1]->pscSrchCursor->uiDocumentID;
+        }
+
+
+        /* Add up the block maximum weights for the pivot document, keeping track of where the nearest block ends */
+        for ( uiI = 0, fWeight = 0; uiI <= uiPivot; uiI++ ) {
+
+            pscbSrchCursorBoundsPtr = ppscbSrchCursorBoundsSorted[uiI];
+
+            /* Move the block up to the pivot document */
+            while ( (pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr < pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksEnd) && 
+                    (pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr->uiDocumentID < uiPivotDocumentID) ) {
+                pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr++;
+            }
+
+            /* Past the last block, this cursor has nothing for the pivot document or beyond */
+            if ( pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr == pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksEnd ) {
+                continue;
+            }
+
+            fWeight += pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr->fMaxWeight * pscbSrchCursorBoundsPtr->fFactor;
+
+            if ( pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr->uiDocumentID < UINT_MAX ) {
+                uiNextDocumentID = UTL_MACROS_MIN(uiNextDocumentID, pscbSrchCursorBoundsPtr->pspbSrchPostingBlocksPtr->uiDocumentID + 1);
+            }
+        }
+
+
+        /* The blocks can't get the pivot document over the minimum weight, skip the cursors 
+        ** up to the pivot past the nearest block end or to the next cursor past the pivot
+        */
+        if ( fWeight <= pscSrchCursor->fMinimumWeight ) {
+
+            /* The cursors up to the pivot are on documents which get passed over */
+            pscSrchCursor->bSkippedDocuments = true;
+
+            /* Nothing left to skip to */
+            if ( uiNextDocumentID == UINT_MAX ) {
+                break;
+            }
+
+            ASSERT(uiNextDocumentID > uiPivotDocumentID);
+
+            for ( uiI = 0; uiI <= uiPivot; uiI++ ) {
+                if ( (iError = iSrchCursorSeekDocument(ppscbSrchCursorBoundsSorted[uiI]->pscSrchCursor, uiNextDocumentID)) != SRCH_NoError ) {
+                    return (iError);
+                }
+            }
+
+            continue;
+        }
+
+
+        /* Not all the cursors up to the pivot are on the pivot document, move them up to it */
+        if ( ppscbSrchCursorBoundsSorted[0]->pscSrchCursor->uiDocumentID != uiPivotDocumentID ) {
+
+            /* The documents those cursors are on get passed over */
+            pscSrchCursor->bSkippedDocuments = true;
+
+            for ( uiI = 0; (uiI <= uiPivot) && (ppscbSrchCursorBoundsSorted[uiI]->pscSrchCursor->uiDocumentID != uiPivotDocumentID); uiI++ ) {
+                if ( (iError = iSrchCursorSeekDocument(ppscbSrchCursorBoundsSorted[uiI]->pscSrchCursor, uiPivotDocumentID)) != SRCH_NoError ) {
+                    return (iError);
+                }
+            }
+
+            continue;
+        }
+
+
+        /* Score the pivot document */
+        if ( (iError = iSrchCursorMergeWANDCursors(pscSrchCursor, uiPivotDocumentID, false)) != SRCH_NoError ) {
+            return (iError);
+        }
+
+        ASSERT(pscSrchCursor->uiSrchPostingsLength > 0);
+
+
+        /* Get the weight, and stop here if it exceeds the minimum weight */
+        if ( (iError = iSrchCursorGetWeight(pscSrchCursor, &fWeight)) != SRCH_NoError ) {
+            return (iError);
+        }
+
+        if ( fWeight > pscSrchCursor->fMinimumWeight ) {
+            pscSrchCursor->uiDocumentID = uiPivotDocumentID;
+            return (SRCH_NoError);
+        }
+
+
+        /* The pivot document gets passed over, move the cursors on it along */
+        pscSrchCursor->bSkippedDocuments = true;
+
+        for ( uiI = 0; uiI <= uiPivot; uiI++ ) {
+            if ( (iError = iSrchCursorNextDocument(ppscbSrchCursorBoundsSorted[uiI]->pscSrchCursor)) != SRCH_NoError ) {
+                return (iError);
+            }
+        }
+    }
+
+
+    /* Run out of documents */
+    pscSrchCursor->uiDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+    pscSrchCursor->pspSrchPostings = NULL;
+    pscSrchCursor->uiSrchPostingsLength = 0;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorFindDocumentMultiOR()
+
+    Purpose:    This function positions a multi OR cursor on the first document
+                its cursors are on, starting from where they are positioned,
+                this is the document the winner of the loser tree is on.
+
+                The cursors on that document are picked out of the loser tree 
+                and sorted into term order for the merge.
+
+    Parameters: pscSrchCursor       search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorFindDocumentMultiOR
+(
+    struct srchCursor *pscSrchCursor
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned int    uiDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+    unsigned int    uiI = 0;
+    unsigned int    uiJ = 0;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_MULTI_OR_ID);
+    ASSERT(pscSrchCursor->uiSrchCursorsLength > 1);
+
+
+    /* Reset the search postings for the current document */
+    pscSrchCursor->pspSrchPostings = NULL;
+    pscSrchCursor->uiSrchPostingsLength = 0;
+    pscSrchCursor->bTermPositionsPending = false;
+    pscSrchCursor->uiSrchCursorsDocumentLength = 0;
+
+
+    /* Run out of documents if the winner has run out of documents */
+    uiDocumentID = pscSrchCursor->puiLoserTreeDocumentIDs[pscSrchCursor->puiLoserTree[0]];
+
+    if ( uiDocumentID == UINT_MAX ) {
+        pscSrchCursor->uiDocumentID = SRCH_CURSOR_DOCUMENT_ID_NONE;
+        return (SRCH_NoError);
+    }
+
+
+    /* Pick out the cursors on the document, starting from the root of the loser tree */
+    iSrchCursorGetLoserTreeSrchCursorsDocument(pscSrchCursor, 1, pscSrchCursor->puiLoserTree[0], uiDocumentID);
+
+    /* Sort them into term order, insertion sort because there are few of them */
+    for ( uiI = 1; uiI < pscSrchCursor->uiSrchCursorsDocumentLength; uiI++ ) {
+
+        unsigned int    uiIndex = pscSrchCursor->puiSrchCursorsDocument[uiI];
+
+        for ( uiJ = uiI; (uiJ > 0) && (pscSrchCursor->puiSrchCursorsDocument[uiJ - 1] > uiIndex); uiJ-- ) {
+            pscSrchCursor->puiSrchCursorsDocument[uiJ] = pscSrchCursor->puiSrchCursorsDocument[uiJ - 1];
+        }
+
+        pscSrchCursor->puiSrchCursorsDocument[uiJ] = uiIndex;
+    }
+
+
+    /* Merge the search postings */
+    if ( (iError = iSrchCursorMergeMultiORCursors(pscSrchCursor, uiDocumentID, false)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    pscSrchCursor->uiDocumentID = uiDocumentID;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorGetLoserTreeSrchCursorsDocument()
+
+    Purpose:    This function adds the indices of the cursors in a subtree of the 
+                loser tree of a multi OR cursor which are on the passed document 
+                to the indices of the search cursors on the current document.
+
+                The winner of the subtree is passed, if it is not on the document 
+                then no cursor in the subtree is. Otherwise the loser kept at the 
+                root of the subtree is the winner of the other half of it, so the 
+                half with the winner and the other half are looked at in turn.
+
+    Parameters: pscSrchCursor       search cursor structure
+                uiNode              node at the root of the subtree
+                uiIndex             index of the winner of the subtree
+                uiDocumentID        document ID
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorGetLoserTreeSrchCursorsDocument
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiNode,
+    unsigned int uiIndex,
+    unsigned int uiDocumentID
+)
+{
+
+    unsigned int    uiChildNode = 0;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_MULTI_OR_ID);
+    ASSERT(uiIndex < pscSrchCursor->uiSrchCursorsLength);
+
+
+    /* No cursor in the subtree is on the document if the winner is not */
+    if ( pscSrchCursor->puiLoserTreeDocumentIDs[uiIndex] != uiDocumentID ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* The subtree is a leaf, the leaves sit below the nodes */
+    if ( uiNode >= pscSrchCursor->uiSrchCursorsLength ) {
+        ASSERT(uiNode == (uiIndex + pscSrchCursor->uiSrchCursorsLength));
+        pscSrchCursor->puiSrchCursorsDocument[pscSrchCursor->uiSrchCursorsDocumentLength++] = uiIndex;
+        return (SRCH_NoError);
+    }
+
+
+    /* Find the half of the subtree with the winner */
+    for ( uiChildNode = uiIndex + pscSrchCursor->uiSrchCursorsLength; (uiChildNode / 2) != uiNode; uiChildNode /= 2 ) {
+        ;
+    }
+
+    /* Look at the half with the winner, and at the other half whose winner is the loser kept at this node */
+    iSrchCursorGetLoserTreeSrchCursorsDocument(pscSrchCursor, uiChildNode, uiIndex, uiDocumentID);
+    iSrchCursorGetLoserTreeSrchCursorsDocument(pscSrchCursor, uiChildNode ^ 1, pscSrchCursor->puiLoserTree[uiNode], uiDocumentID);
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorAdjustLoserTree()
+
+    Purpose:    This function replays the matches for a cursor from its leaf to 
+                the root of the loser tree of a multi OR cursor, the loser of 
+                each match is kept at the node and the winner moves up. 
+
+                A cursor index equal to the cursors length wins against all 
+                cursors, and the other cursors are ordered on the document ID
+                they are keyed on, the lower index going first on ties.
+
+    Parameters: pscSrchCursor       search cursor structure
+                uiIndex             index of the cursor to replay
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorAdjustLoserTree
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiIndex
+)
+{
+
+    unsigned int    *puiLoserTree = NULL;
+    unsigned int    *puiLoserTreeDocumentIDs = NULL;
+    unsigned int    uiLoserTreeLength = 0;
+    unsigned int    uiNode = 0;
+    unsigned int    uiLoser = 0;
+    boolean         bLoserWins = false;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_MULTI_OR_ID);
+    ASSERT(uiIndex < pscSrchCursor->uiSrchCursorsLength);
+
+
+    puiLoserTree = pscSrchCursor->puiLoserTree;
+    puiLoserTreeDocumentIDs = pscSrchCursor->puiLoserTreeDocumentIDs;
+    uiLoserTreeLength = pscSrchCursor->uiSrchCursorsLength;
+
+
+    /* Replay the matches from the leaf to the root, the leaves sit below the nodes */
+    for ( uiNode = (uiIndex + uiLoserTreeLength) / 2; uiNode > 0; uiNode /= 2 ) {
+
+        uiLoser = puiLoserTree[uiNode];
+
+        /* Work out whether the loser at this node wins against the current winner */
+        if ( uiLoser == uiLoserTreeLength ) {
+            bLoserWins = true;
+        }
+        else if ( uiIndex == uiLoserTreeLength ) {
+            bLoserWins = false;
+        }
+        else {
+            bLoserWins = ((puiLoserTreeDocumentIDs[uiLoser] < puiLoserTreeDocumentIDs[uiIndex]) || 
+                    ((puiLoserTreeDocumentIDs[uiLoser] == puiLoserTreeDocumentIDs[uiIndex]) && (uiLoser < uiIndex))) ? true : false;
+        }
+
+        /* Swap the winner and the loser if the loser won */
+        if ( bLoserWins == true ) {
+            puiLoserTree[uiNode] = uiIndex;
+            uiIndex = uiLoser;
+        }
+    }
+
+    /* Set the winner */
+    puiLoserTree[0] = uiIndex;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorLoadTermPositions()
+
+    Purpose:    This function makes sure that the search postings of the cursor
+                for the current document have their term positions, they are only 
+                loaded when they are needed and only for the current document. 
+                An OR or IOR cursor merges its search postings again once the 
+                term positions of its cursors have been loaded.
+
+    Parameters: pscSrchCursor       search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorLoadTermPositions
+(
+    struct srchCursor *pscSrchCursor
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchCursor       *pscSrchCursor1 = NULL;
+    struct srchCursor       *pscSrchCursor2 = NULL;
+
+
+    ASSERT(pscSrchCursor != NULL);
+
+
+    /* Nothing to do if the cursor has run out of documents */
+    if ( pscSrchCursor->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Postings cursor, the term positions are loaded in place in the search postings list */
+    if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_POSTINGS_ID ) {
+        return (iSrchPostingLoadTermPositions(pscSrchCursor->psplSrchPostingsList, pscSrchCursor->pspSrchPostings, pscSrchCursor->uiSrchPostingsLength));
+    }
+
+
+    /* Nothing to do if the term positions have been loaded */
+    if ( pscSrchCursor->bTermPositionsPending == false ) {
+        return (SRCH_NoError);
+    }
+
+
+    pscSrchCursor1 = pscSrchCursor->pscSrchCursor1;
+    pscSrchCursor2 = pscSrchCursor->pscSrchCursor2;
+
+
+    /* OR, IOR - merge the search postings again with the term positions loaded */
+    if ( (pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_OR_ID) || (pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_IOR_ID) ) {
+        if ( (iError = iSrchCursorMergeORCursors(pscSrchCursor, pscSrchCursor->uiDocumentID, true)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+    /* XOR, NOT - load the term positions of the cursor whose search postings are passed through, and pass them through again */
+    else if ( (pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_XOR_ID) || (pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_NOT_ID) ) {
+
+        if ( pscSrchCursor1->uiDocumentID != pscSrchCursor->uiDocumentID ) {
+            ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_XOR_ID);
+            pscSrchCursor1 = pscSrchCursor2;
+        }
+
+        ASSERT(pscSrchCursor1->uiDocumentID == pscSrchCursor->uiDocumentID);
+
+        if ( (iError = iSrchCursorLoadTermPositions(pscSrchCursor1)) != SRCH_NoError ) {
+            return (iError);
+        }
+
+        pscSrchCursor->pspSrchPostings = pscSrchCursor1->pspSrchPostings;
+        pscSrchCursor->uiSrchPostingsLength = pscSrchCursor1->uiSrchPostingsLength;
+    }
+
+    /* WAND - score the document again with the term positions loaded */
+    else if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_WAND_ID ) {
+        if ( (iError = iSrchCursorMergeWANDCursors(pscSrchCursor, pscSrchCursor->uiDocumentID, true)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+    /* Multi OR - merge the search postings again with the term positions loaded */
+    else if ( pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_MULTI_OR_ID ) {
+        if ( (iError = iSrchCursorMergeMultiORCursors(pscSrchCursor, pscSrchCursor->uiDocumentID, true)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+    else {
+        ASSERT(false);
+    }
+
+
+    pscSrchCursor->bTermPositionsPending = false;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorCheckSrchPostingsBuffer()
+
+    Purpose:    This function makes sure that the search postings buffer
+                of the cursor is large enough for the passed length
+
+    Parameters: pscSrchCursor               search cursor structure
+                uiSrchPostingsLength        search postings length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorCheckSrchPostingsBuffer
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiSrchPostingsLength
+)
+{
+
+    struct srchPosting      *pspSrchPostingsPtr = NULL;
+
+
+    ASSERT(pscSrchCursor != NULL);
+
+
+    /* Grow the search postings buffer if needed */
+    if ( uiSrchPostingsLength > pscSrchCursor->uiSrchPostingsBufferLength ) {
+
+        if ( (pspSrchPostingsPtr = (struct srchPosting *)s_realloc(pscSrchCursor->pspSrchPostingsBuffer, (size_t)(uiSrchPostingsLength * sizeof(struct srchPosting)))) == NULL ) {
+            return (SRCH_MemError);
+        }
+
+        pscSrchCursor->pspSrchPostingsBuffer = pspSrchPostingsPtr;
+        pscSrchCursor->uiSrchPostingsBufferLength = uiSrchPostingsLength;
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorMergeORCursors()
+
+    Purpose:    This function ORs the search postings of the cursors of an OR or 
+                IOR cursor which are positioned on the passed document. The term 
+                positions are only loaded if there is more than one search posting 
+                to merge or if bTermPositions is true, a single search posting is 
+                not reweighted so its term position is not needed for the merge.
+
+    Parameters: pscSrchCursor       search cursor structure
+                uiDocumentID        document ID
+                bTermPositions      set to true if the term positions are needed
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorMergeORCursors
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiDocumentID,
+    boolean bTermPositions
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchCursor       *pscSrchCursor1 = NULL;
+    struct srchCursor       *pscSrchCursor2 = NULL;
+    unsigned int            uiSrchPostingsLength1 = 0;
+    unsigned int            uiSrchPostingsLength2 = 0;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT((pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_OR_ID) || (pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_IOR_ID));
+    ASSERT(uiDocumentID != SRCH_CURSOR_DOCUMENT_ID_NONE);
+
+
+    pscSrchCursor1 = pscSrchCursor->pscSrchCursor1;
+    pscSrchCursor2 = pscSrchCursor->pscSrchCursor2;
+
+    uiSrchPostingsLength1 = (pscSrchCursor1->uiDocumentID == uiDocumentID) ? pscSrchCursor1->uiSrchPostingsLength : 0;
+    uiSrchPostingsLength2 = (pscSrchCursor2->uiDocumentID == uiDocumentID) ? pscSrchCursor2->uiSrchPostingsLength : 0;
+
+
+    /* Load the term positions if they are needed */
+    if ( (bTermPositions == true) || ((uiSrchPostingsLength1 + uiSrchPostingsLength2) > 1) ) {
+
+        if ( (uiSrchPostingsLength1 > 0) && ((iError = iSrchCursorLoadTermPositions(pscSrchCursor1)) != SRCH_NoError) ) {
+            return (iError);
+        }
+
+        if ( (uiSrchPostingsLength2 > 0) && ((iError = iSrchCursorLoadTermPositions(pscSrchCursor2)) != SRCH_NoError) ) {
+            return (iError);
+        }
+
+        pscSrchCursor->bTermPositionsPending = false;
+    }
+    else {
+        pscSrchCursor->bTermPositionsPending = true;
+    }
+
+
+    /* Merge the search postings */
+    return (iSrchCursorMergeOR(pscSrchCursor, (uiSrchPostingsLength1 > 0) ? pscSrchCursor1->pspSrchPostings : NULL, uiSrchPostingsLength1,
+            (uiSrchPostingsLength2 > 0) ? pscSrchCursor2->pspSrchPostings : NULL, uiSrchPostingsLength2));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorMergeWANDCursors()
+
+    Purpose:    This function ORs the search postings of the cursors of a WAND cursor
+                which are positioned on the passed document, the cursors are picked 
+                out in term order and merged by iSrchCursorMergeMultiORCursors().
+
+    Parameters: pscSrchCursor       search cursor structure
+                uiDocumentID        document ID
+                bTermPositions      set to true if the term positions are needed
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorMergeWANDCursors
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiDocumentID,
+    boolean bTermPositions
+)
+{
+
+    unsigned int            uiI = 0;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_WAND_ID);
+    ASSERT(uiDocumentID != SRCH_CURSOR_DOCUMENT_ID_NONE);
+
+
+    /* Pick out the cursors on the document */
+    for ( uiI = 0, pscSrchCursor->uiSrchCursorsDocumentLength = 0; uiI < pscSrchCursor->uiSrchCursorsLength; uiI++ ) {
+        if ( pscSrchCursor->ppscSrchCursors[uiI]->uiDocumentID == uiDocumentID ) {
+            pscSrchCursor->puiSrchCursorsDocument[pscSrchCursor->uiSrchCursorsDocumentLength++] = uiI;
+        }
+    }
+
+
+    /* Merge the search postings */
+    return (iSrchCursorMergeMultiORCursors(pscSrchCursor, uiDocumentID, bTermPositions));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorMergeMultiORCursors()
+
+    Purpose:    This function ORs the search postings of the cursors of a multi OR
+                or a WAND cursor which are positioned on the passed document, in 
+                term order like a chain of OR cursors would. The indices of those
+                cursors are in the indices of the search cursors on the current 
+                document. 
+
+                In the chain, the search postings of the first cursor go through 
+                every OR merge, and the search postings of the other cursors 
+                through the OR merges from theirs on. The OR merges where no 
+                other cursor is on the document only reweight the search postings 
+                which are there already, so they are applied together rather 
+                than one by one. The term positions are only loaded if there is 
+                more than one search posting to merge or if bTermPositions is true.
+
+    Parameters: pscSrchCursor       search cursor structure
+                uiDocumentID        document ID
+                bTermPositions      set to true if the term positions are needed
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorMergeMultiORCursors
+(
+    struct srchCursor *pscSrchCursor,
+    unsigned int uiDocumentID,
+    boolean bTermPositions
+)
+{
+
+    int                     iError = SRCH_NoError;
+    unsigned int            uiI = 0;
+    unsigned int            uiIndex = 0;
+    unsigned int            uiLastIndex = 0;
+    struct srchCursor       *pscSrchCursorPtr = NULL;
+    struct srchPosting      *pspSrchPostings = NULL;
+    unsigned int            uiSrchPostingsLength = 0;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT((pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_MULTI_OR_ID) || (pscSrchCursor->uiCursorTypeID == SRCH_CURSOR_TYPE_WAND_ID));
+    ASSERT(uiDocumentID != SRCH_CURSOR_DOCUMENT_ID_NONE);
+    ASSERT(pscSrchCursor->uiSrchCursorsDocumentLength > 0);
+
+
+    /* Load the term positions if they are needed */
+    for ( uiI = 0; uiI < pscSrchCursor->uiSrchCursorsDocumentLength; uiI++ ) {
+        uiSrchPostingsLength += pscSrchCursor->ppscSrchCursors[pscSrchCursor->puiSrchCursorsDocument[uiI]]->uiSrchPostingsLength;
+    }
+
+    if ( (bTermPositions == true) || (uiSrchPostingsLength > 1) ) {
+
+        for ( uiI = 0; uiI < pscSrchCursor->uiSrchCursorsDocumentLength; uiI++ ) {
+            if ( (iError = iSrchCursorLoadTermPositions(pscSrchCursor->ppscSrchCursors[pscSrchCursor->puiSrchCursorsDocument[uiI]])) != SRCH_NoError ) {
+                return (iError);
+            }
+        }
+
+        pscSrchCursor->bTermPositionsPending = false;
+    }
+    else {
+        pscSrchCursor->bTermPositionsPending = true;
+    }
+
+
+    /* OR the search postings, the search postings of the first cursor are the first ones in, the merges 
+    ** start from there or from the first cursor on the document, ping-ponging between the two buffers
+    */
+    for ( uiI = 0, pspSrchPostings = NULL, uiSrchPostingsLength = 0; uiI <= pscSrchCursor->uiSrchCursorsDocumentLength; uiI++ ) {
+
+        struct srchPosting      *pspSrchPostingsTmp = NULL;
+        unsigned int            uiSrchPostingsLengthTmp = 0;
+        unsigned int            uiMergesCount = 0;
+
+        /* Index of the cursor to merge, the cursors length to finish off the merges */
+        uiIndex = (uiI < pscSrchCursor->uiSrchCursorsDocumentLength) ? pscSrchCursor->puiSrchCursorsDocument[uiI] : pscSrchCursor->uiSrchCursorsLength;
+        pscSrchCursorPtr = (uiI < pscSrchCursor->uiSrchCursorsDocumentLength) ? pscSrchCursor->ppscSrchCursors[uiIndex] : NULL;
+
+        ASSERT((pscSrchCursorPtr == NULL) || (pscSrchCursorPtr->uiDocumentID == uiDocumentID));
+
+        /* The first cursor is the first one in */
+        if ( uiIndex == 0 ) {
+            pspSrchPostings = pscSrchCursorPtr->pspSrchPostings;
+            uiSrchPostingsLength = pscSrchCursorPtr->uiSrchPostingsLength;
+            uiLastIndex = 0;
+            continue;
+        }
+
+        /* The merges since the last cursor on the document only reweight the search postings */
+        if ( uiSrchPostingsLength > 0 ) {
+            uiMergesCount = uiIndex - uiLastIndex - 1;
+        }
+
+        /* Merge the search postings */
+        if ( (uiMergesCount > 0) || (pscSrchCursorPtr != NULL) ) {
+
+            if ( (iError = iSrchCursorMergeOR(pscSrchCursor, pspSrchPostings, uiSrchPostingsLength, 
+                    (uiMergesCount == 0) ? pscSrchCursorPtr->pspSrchPostings : NULL, 
+                    (uiMergesCount == 0) ? pscSrchCursorPtr->uiSrchPostingsLength : 0)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+            if ( uiMergesCount > 1 ) {
+                vSrchCursorReweightSrchPostings(pscSrchCursor->pspSrchPostings, pscSrchCursor->uiSrchPostingsLength, uiMergesCount - 1);
+            }
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+            /* Merge in the cursor if the merges before it were for reweighting */
+            if ( (uiMergesCount > 0) && (pscSrchCursorPtr != NULL) ) {
+
+                pspSrchPostings = pscSrchCursor->pspSrchPostings;
+                uiSrchPostingsLength = pscSrchCursor->uiSrchPostingsLength;
+
+                pspSrchPostingsTmp = pscSrchCursor->pspSrchPostingsBuffer;
+                uiSrchPostingsLengthTmp = pscSrchCursor->uiSrchPostingsBufferLength;
+                pscSrchCursor->pspSrchPostingsBuffer = pscSrchCursor->pspSrchPostingsScratch;
+                pscSrchCursor->uiSrchPostingsBufferLength = pscSrchCursor->uiSrchPostingsScratchLength;
+                pscSrchCursor->pspSrchPostingsScratch = pspSrchPostingsTmp;
+                pscSrchCursor->uiSrchPostingsScratchLength = uiSrchPostingsLengthTmp;
+
+                if ( (iError = iSrchCursorMergeOR(pscSrchCursor, pspSrchPostings, uiSrchPostingsLength, 
+                        pscSrchCursorPtr->pspSrchPostings, pscSrchCursorPtr->uiSrchPostingsLength)) != SRCH_NoError ) {
+                    return (iError);
+                }
+            }
+
+            /* Swap the buffers so the merged search postings are not overwritten by the next merge */
+            pspSrchPostings = pscSrchCursor->pspSrchPostings;
+            uiSrchPostingsLength = pscSrchCursor->uiSrchPostingsLength;
+
+            pspSrchPostingsTmp = pscSrchCursor->pspSrchPostingsBuffer;
+            uiSrchPostingsLengthTmp = pscSrchCursor->uiSrchPostingsBufferLength;
+            pscSrchCursor->pspSrchPostingsBuffer = pscSrchCursor->pspSrchPostingsScratch;
+            pscSrchCursor->uiSrchPostingsBufferLength = pscSrchCursor->uiSrchPostingsScratchLength;
+            pscSrchCursor->pspSrchPostingsScratch = pspSrchPostingsTmp;
+            pscSrchCursor->uiSrchPostingsScratchLength = uiSrchPostingsLengthTmp;
+        }
+
+        uiLastIndex = uiIndex;
+    }
+
+
+    /* Set the search postings for the current document */
+    pscSrchCursor->pspSrchPostings = pspSrchPostings;
+    pscSrchCursor->uiSrchPostingsLength = uiSrchPostingsLength;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorMergeOR()
+
+    Purpose:    This function ORs the search postings of two cursors for one
+                document into the search postings buffer of the cursor, this
+                mirrors iSrchPostingMergeSrchPostingsListsOR() and
+                iSrchPostingMergeSrchPostingsListsIOR().
+
+    Parameters: pscSrchCursor               search cursor structure
+                pspSrchPostings1            search postings (optional)
+                uiSrchPostingsLength1       search postings length
+                pspSrchPostings2            search postings (optional)
+                uiSrchPostingsLength2       search postings length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorMergeOR
+(
+    struct srchCursor *pscSrchCursor,
+    struct srchPosting *pspSrchPostings1,
+    unsigned int uiSrchPostingsLength1,
+    struct srchPosting *pspSrchPostings2,
+    unsigned int uiSrchPostingsLength2
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchPosting      *pspSrchPostingsPtr1 = pspSrchPostings1;
+    struct srchPosting      *pspSrchPostingsEnd1 = pspSrchPostings1 + uiSrchPostingsLength1;
+    struct srchPosting      *pspSrchPostingsPtr2 = pspSrchPostings2;
+    struct srchPosting      *pspSrchPostingsEnd2 = pspSrchPostings2 + uiSrchPostingsLength2;
+    struct srchPosting      *pspSrchPostingsPtr = NULL;
+    struct srchPosting      *pspSrchPostingsFromPtr = NULL;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT((uiSrchPostingsLength1 + uiSrchPostingsLength2) > 0);
+
+
+    /* Make sure the buffer is large enough */
+    if ( (iError = iSrchCursorCheckSrchPostingsBuffer(pscSrchCursor, uiSrchPostingsLength1 + uiSrchPostingsLength2)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
+    /* Merge the search postings in term position order, inner search postings first */
+    for ( pspSrchPostingsPtr = pscSrchCursor->pspSrchPostingsBuffer; (pspSrchPostingsPtr1 < pspSrchPostingsEnd1) || (pspSrchPostingsPtr2 < pspSrchPostingsEnd2); pspSrchPostingsPtr++ ) {
+
+        /* Pick the search posting to add */
+        if ( (pspSrchPostingsPtr2 < pspSrchPostingsEnd2) &&
+                ((pspSrchPostingsPtr1 >= pspSrchPostingsEnd1) || (pspSrchPostingsPtr1->uiTermPosition >= pspSrchPostingsPtr2->uiTermPosition)) ) {
+            pspSrchPostingsFromPtr = pspSrchPostingsPtr2++;
+        }
+        else {
+            pspSrchPostingsFromPtr = pspSrchPostingsPtr1++;
+        }
+
+        SRCH_CURSOR_COPY_SRCH_POSTING(pspSrchPostingsPtr, pspSrchPostingsFromPtr);
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+        if ( (pspSrchPostingsPtr > pscSrchCursor->pspSrchPostingsBuffer) &&
+                (pspSrchPostingsFromPtr->uiTermPosition == ((pspSrchPostingsPtr - 1)->uiTermPosition + 1)) ) {
+            pspSrchPostingsPtr->fWeight *= SRCH_CURSOR_PROXIMITY_REWEIGHTING;
+        }
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+    }
+
+
+    /* Set the search postings for the current document */
+    pscSrchCursor->pspSrchPostings = pscSrchCursor->pspSrchPostingsBuffer;
+    pscSrchCursor->uiSrchPostingsLength = pspSrchPostingsPtr - pscSrchCursor->pspSrchPostingsBuffer;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+
+/*
+
+    Function:   vSrchCursorReweightSrchPostings()
+
+    Purpose:    This function reweights the search postings of one document for
+                proximity as many times as requested, this is the same as ORing 
+                them that many times with no other search postings since the 
+                search postings which get reweighted do not change.
+
+    Parameters: pspSrchPostings             search postings
+                uiSrchPostingsLength        search postings length
+                uiReweightingsCount         number of times to reweight
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vSrchCursorReweightSrchPostings
+(
+    struct srchPosting *pspSrchPostings,
+    unsigned int uiSrchPostingsLength,
+    unsigned int uiReweightingsCount
+)
+{
+
+    struct srchPosting      *pspSrchPostingsPtr = NULL;
+    struct srchPosting      *pspSrchPostingsEnd = NULL;
+    unsigned int            uiI = 0;
+
+
+    ASSERT(pspSrchPostings != NULL);
+    ASSERT(uiSrchPostingsLength > 0);
+
+
+    /* Reweight the search postings which follow on from the previous one, one reweighting at a time like the OR merges */
+    for ( pspSrchPostingsPtr = pspSrchPostings + 1, pspSrchPostingsEnd = pspSrchPostings + uiSrchPostingsLength; pspSrchPostingsPtr < pspSrchPostingsEnd; pspSrchPostingsPtr++ ) {
+        if ( pspSrchPostingsPtr->uiTermPosition == ((pspSrchPostingsPtr - 1)->uiTermPosition + 1) ) {
+            for ( uiI = 0; uiI < uiReweightingsCount; uiI++ ) {
+                pspSrchPostingsPtr->fWeight *= SRCH_CURSOR_PROXIMITY_REWEIGHTING;
+            }
+        }
+    }
+
+
+    return;
+
+}
+
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorMergeAND()
+
+    Purpose:    This function ANDs the search postings of two cursors for one
+                document into a single search posting in the search postings
+                buffer of the cursor, this mirrors iSrchPostingMergeSrchPostingsListsAND().
+
+    Parameters: pscSrchCursor               search cursor structure
+                pspSrchPostings1            search postings
+                uiSrchPostingsLength1       search postings length
+                pspSrchPostings2            search postings
+                uiSrchPostingsLength2       search postings length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorMergeAND
+(
+    struct srchCursor *pscSrchCursor,
+    struct srchPosting *pspSrchPostings1,
+    unsigned int uiSrchPostingsLength1,
+    struct srchPosting *pspSrchPostings2,
+    unsigned int uiSrchPostingsLength2
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchPosting      *pspSrchPostingsPtr1 = pspSrchPostings1;
+    struct srchPosting      *pspSrchPostingsEnd1 = pspSrchPostings1 + uiSrchPostingsLength1;
+    struct srchPosting      *pspSrchPostingsPtr2 = pspSrchPostings2;
+    struct srchPosting      *pspSrchPostingsEnd2 = pspSrchPostings2 + uiSrchPostingsLength2;
+    struct srchPosting      *pspSrchPostingsCurrentPtr = NULL;
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+    int                     iCurrentTermPosition = -1;
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+    float                   fCurrentWeight = 0;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(uiSrchPostingsLength1 > 0);
+    ASSERT(uiSrchPostingsLength2 > 0);
+
+
+    /* Make sure the buffer is large enough */
+    if ( (iError = iSrchCursorCheckSrchPostingsBuffer(pscSrchCursor, 1)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
+    /* Accumulate the weight in term position order, inner search postings first */
+    while ( (pspSrchPostingsPtr1 < pspSrchPostingsEnd1) || (pspSrchPostingsPtr2 < pspSrchPostingsEnd2) ) {
+
+        /* Inner search posting, this is where adjacent terms get reweighted */
+        if ( (pspSrchPostingsPtr2 < pspSrchPostingsEnd2) &&
+                ((pspSrchPostingsPtr1 >= pspSrchPostingsEnd1) || (pspSrchPostingsPtr1->uiTermPosition >= pspSrchPostingsPtr2->uiTermPosition)) ) {
+
+            fCurrentWeight += pspSrchPostingsPtr2->fWeight;
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+            if ( (int)pspSrchPostingsPtr2->uiTermPosition == (iCurrentTermPosition + 1) ) {
+                fCurrentWeight *= SRCH_CURSOR_PROXIMITY_REWEIGHTING;
+            }
+            iCurrentTermPosition = pspSrchPostingsPtr2->uiTermPosition;
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+            pspSrchPostingsCurrentPtr = pspSrchPostingsPtr2++;
+        }
+
+        /* Outer search posting */
+        else {
+
+            fCurrentWeight += pspSrchPostingsPtr1->fWeight;
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+            iCurrentTermPosition = pspSrchPostingsPtr1->uiTermPosition;
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+            pspSrchPostingsCurrentPtr = pspSrchPostingsPtr1++;
+        }
+    }
+
+
+    /* Add the last search posting with the accumulated weight */
+    SRCH_CURSOR_COPY_SRCH_POSTING(pscSrchCursor->pspSrchPostingsBuffer, pspSrchPostingsCurrentPtr);
+    pscSrchCursor->pspSrchPostingsBuffer->fWeight = fCurrentWeight;
+
+
+    /* Set the search postings for the current document */
+    pscSrchCursor->pspSrchPostings = pscSrchCursor->pspSrchPostingsBuffer;
+    pscSrchCursor->uiSrchPostingsLength = 1;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorMergeADJ()
+
+    Purpose:    This function ADJs the search postings of two cursors for one
+                document into the search postings buffer of the cursor, this
+                mirrors iSrchPostingMergeSrchPostingsListsADJ().
+
+    Parameters: pscSrchCursor               search cursor structure
+                pspSrchPostings1            search postings
+                uiSrchPostingsLength1       search postings length
+                pspSrchPostings2            search postings
+                uiSrchPostingsLength2       search postings length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorMergeADJ
+(
+    struct srchCursor *pscSrchCursor,
+    struct srchPosting *pspSrchPostings1,
+    unsigned int uiSrchPostingsLength1,
+    struct srchPosting *pspSrchPostings2,
+    unsigned int uiSrchPostingsLength2
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchPosting      *pspSrchPostingsPtr1 = pspSrchPostings1;
+    struct srchPosting      *pspSrchPostingsEnd1 = pspSrchPostings1 + uiSrchPostingsLength1;
+    struct srchPosting      *pspSrchPostingsPtr2 = pspSrchPostings2;
+    struct srchPosting      *pspSrchPostingsEnd2 = pspSrchPostings2 + uiSrchPostingsLength2;
+    struct srchPosting      *pspSrchPostingsPtr = NULL;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(uiSrchPostingsLength1 > 0);
+    ASSERT(uiSrchPostingsLength2 > 0);
+
+
+    /* Make sure the buffer is large enough, each outer search posting can only be matched once */
+    if ( (iError = iSrchCursorCheckSrchPostingsBuffer(pscSrchCursor, uiSrchPostingsLength1)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
+    /* Loop on the inner search postings */
+    for ( pspSrchPostingsPtr = pscSrchCursor->pspSrchPostingsBuffer; pspSrchPostingsPtr2 < pspSrchPostingsEnd2; pspSrchPostingsPtr2++ ) {
+
+        /* Loop through the outer search postings */
+        for ( ; pspSrchPostingsPtr1 < pspSrchPostingsEnd1; pspSrchPostingsPtr1++ ) {
+
+            /* Work out the term position delta */
+            int iTermPositionDelta = (pspSrchPostingsPtr2->uiTermPosition - pspSrchPostingsPtr1->uiTermPosition);
+
+            /* Look for A B adjacency - skip terms positions of zero since those are meta-terms with no location  */
+            if ( ((iTermPositionDelta == 0) || (iTermPositionDelta == pscSrchCursor->iTermDistance)) &&
+                    (pspSrchPostingsPtr1->uiTermPosition != 0) && (pspSrchPostingsPtr2->uiTermPosition != 0) ) {
+
+                SRCH_CURSOR_COPY_SRCH_POSTING(pspSrchPostingsPtr, pspSrchPostingsPtr2);
+                pspSrchPostingsPtr->fWeight += pspSrchPostingsPtr1->fWeight;
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+                pspSrchPostingsPtr->fWeight *= SRCH_CURSOR_PROXIMITY_REWEIGHTING;
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+                pspSrchPostingsPtr++;
+            }
+            else if ( iTermPositionDelta < 0 ) {
+                break;
+            }
+        }
+    }
+
+
+    /* Set the search postings for the current document */
+    pscSrchCursor->pspSrchPostings = pscSrchCursor->pspSrchPostingsBuffer;
+    pscSrchCursor->uiSrchPostingsLength = pspSrchPostingsPtr - pscSrchCursor->pspSrchPostingsBuffer;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchCursorMergeNEAR()
+
+    Purpose:    This function NEARs the search postings of two cursors for one
+                document into the search postings buffer of the cursor, this
+                mirrors iSrchPostingMergeSrchPostingsListsNEAR().
+
+    Parameters: pscSrchCursor               search cursor structure
+                pspSrchPostings1            search postings
+                uiSrchPostingsLength1       search postings length
+                pspSrchPostings2            search postings
+                uiSrchPostingsLength2       search postings length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchCursorMergeNEAR
+(
+    struct srchCursor *pscSrchCursor,
+    struct srchPosting *pspSrchPostings1,
+    unsigned int uiSrchPostingsLength1,
+    struct srchPosting *pspSrchPostings2,
+    unsigned int uiSrchPostingsLength2
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchPosting      *pspSrchPostingsPtr1 = pspSrchPostings1;
+    struct srchPosting      *pspSrchPostingsEnd1 = pspSrchPostings1 + uiSrchPostingsLength1;
+    struct srchPosting      *pspSrchPostingsPtr2 = pspSrchPostings2;
+    struct srchPosting      *pspSrchPostingsEnd2 = pspSrchPostings2 + uiSrchPostingsLength2;
+    struct srchPosting      *pspSrchPostingsPtr = NULL;
+    int                     iTermDistance = pscSrchCursor->iTermDistance;
+    int                     iPositiveTermDistance = abs(iTermDistance);
+    boolean                 bTermOrderMatters = pscSrchCursor->bTermOrderMatters;
+
+
+    ASSERT(pscSrchCursor != NULL);
+    ASSERT(uiSrchPostingsLength1 > 0);
+    ASSERT(uiSrchPostingsLength2 > 0);
+
+
+    /* Make sure the buffer is large enough, each outer search posting can only be matched once */
+    if ( (iError = iSrchCursorCheckSrchPostingsBuffer(pscSrchCursor, uiSrchPostingsLength1)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
+    /* Loop on the inner search postings */
+    for ( pspSrchPostingsPtr = pscSrchCursor->pspSrchPostingsBuffer; pspSrchPostingsPtr2 < pspSrchPostingsEnd2; pspSrchPostingsPtr2++ ) {
+
+        /* Loop through the outer search postings */
+        for ( ; pspSrchPostingsPtr1 < pspSrchPostingsEnd1; pspSrchPostingsPtr1++ ) {
+
+            /* Work out the term position delta */
+            int iTermPositionDelta = pspSrchPostingsPtr2->uiTermPosition - pspSrchPostingsPtr1->uiTermPosition;
+            int iPositiveTermPositionDelta = abs(iTermPositionDelta);
+
+            /* Look for A B adjacency - skip terms positions of zero since those are meta-terms with no location */
+            if ( (iTermPositionDelta >= 0) && (iTermPositionDelta <= iPositiveTermDistance) &&
+                    (((bTermOrderMatters == true) && (iTermDistance >= 0)) || (bTermOrderMatters == false)) &&
+                    (pspSrchPostingsPtr1->uiTermPosition != 0) && (pspSrchPostingsPtr2->uiTermPosition != 0) ) {
+
+                SRCH_CURSOR_COPY_SRCH_POSTING(pspSrchPostingsPtr, pspSrchPostingsPtr2);
+                pspSrchPostingsPtr->fWeight += pspSrchPostingsPtr1->fWeight;
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+                pspSrchPostingsPtr->fWeight *= SRCH_CURSOR_PROXIMITY_REWEIGHTING;
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+                pspSrchPostingsPtr++;
+            }
+            /* Look for B A adjacency */
+            else if ( (iTermPositionDelta < 0) && (iPositiveTermPositionDelta <= iPositiveTermDistance) &&
+                    (((bTermOrderMatters == true) && (iTermDistance <= 0)) || (bTermOrderMatters == false)) &&
+                    (pspSrchPostingsPtr1->uiTermPosition != 0) && (pspSrchPostingsPtr2->uiTermPosition != 0) ) {
+
+                SRCH_CURSOR_COPY_SRCH_POSTING(pspSrchPostingsPtr, pspSrchPostingsPtr1);
+                pspSrchPostingsPtr->fWeight += pspSrchPostingsPtr2->fWeight;
+
+#if defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING)
+                pspSrchPostingsPtr->fWeight *= SRCH_CURSOR_PROXIMITY_REWEIGHTING;
+#endif    /* defined(SRCH_CURSOR_ENABLE_PROXIMITY_REWEIGHTING) */
+
+                pspSrchPostingsPtr++;
+            }
+            else if ( iTermPositionDelta < 0 ) {
+                break;
+            }
+        }
+    }
+
+
+    /* Set the search postings for the current document */
+    pscSrchCursor->pspSrchPostings = pscSrchCursor->pspSrchPostingsBuffer;
+    pscSrchCursor->uiSrchPostingsLength = pspSrchPostingsPtr - pscSrchCursor->pspSrchPostingsBuffer;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,203 @@
+/*****************************************************************************
+*       Copyright (C) 1993-2011, FS Consulting LLC. All rights reserved      *
+*                                                                            *
+*  This notice is intended as a precaution against inadvertent publication   *
+*  and does not constitute an admission or acknowledgement that publication  *
+*  has occurred or constitute a waiver of confidentiality.                   *
+*                                                                            *
+*  This software is the proprietary and confidential property                *
+*  of FS Consulting LLC.                                                     *
+*****************************************************************************/
+
+
+/*
+
+    Module:     cursor.h
+
+    Author:     Francois Schiettecatte (FS Consulting LLC.)
+
+    Created:    17 October 2026
+
+    Purpose:    This module provides posting cursors for search.c, these
+                allow a search tree to be evaluated a document at a time
+                rather than materializing a postings list at every level
+
+*/
+
+
+#if !defined(SRCH_CURSOR_H)
+#define SRCH_CURSOR_H
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#include "srch.h"
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** C++ wrapper
+*/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif    /* defined(__cplusplus) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Defines
+*/
+
+/* Cursor type IDs */
+#define SRCH_CURSOR_TYPE_INVALID_ID             (0)
+#define SRCH_CURSOR_TYPE_POSTINGS_ID            (1)
+#define SRCH_CURSOR_TYPE_OR_ID                  (2)
+#define SRCH_CURSOR_TYPE_IOR_ID                 (3)
+#define SRCH_CURSOR_TYPE_XOR_ID                 (4)
+#define SRCH_CURSOR_TYPE_AND_ID                 (5)
+#define SRCH_CURSOR_TYPE_NOT_ID                 (6)
+#define SRCH_CURSOR_TYPE_ADJ_ID                 (7)
+#define SRCH_CURSOR_TYPE_NEAR_ID                (8)
+#define SRCH_CURSOR_TYPE_WAND_ID                (9)
+#define SRCH_CURSOR_TYPE_MULTI_OR_ID            (10)
+
+
+/* Document ID of a cursor which has run out of documents, document IDs start at 1 */
+#define SRCH_CURSOR_DOCUMENT_ID_NONE            (0)
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Structures
+*/
+
+/* Search cursor bound structure, the WAND cursor keeps one of these for each of 
+** its cursors to track the upper bound of the weight that cursor can contribute
+** to a document, the factor allows for the proximity reweighting that would
+** be applied if the cursors were ORed together
+*/
+struct srchCursorBound {
+    struct srchCursor       *pscSrchCursor;                 /* Search cursor */
+    float                   fFactor;                        /* Factor applied to the block maximum weights */
+    float                   fMaxWeight;                     /* Maximum weight across all the blocks, with the factor applied */
+    struct srchPostingBlock *pspbSrchPostingBlocksPtr;      /* Current search posting block */
+    struct srchPostingBlock *pspbSrchPostingBlocksEnd;      /* Search posting blocks end */
+};
+
+
+/* Search cursor structure, a cursor is always positioned on a document,
+** or on SRCH_CURSOR_DOCUMENT_ID_NONE if it has run out of documents,
+** so a newly created cursor which is not positioned on a document is empty
+*/
+struct srchCursor {
+    unsigned int            uiCursorTypeID;                 /* Cursor type ID */
+    unsigned int            uiTermType;                     /* Term type */
+    boolean                 bRequired;                      /* Required flag */
+    int                     iTermDistance;                  /* Term distance (ADJ and NEAR) */
+    boolean                 bTermOrderMatters;              /* Term order matters (NEAR) */
+
+    struct srchPostingsList *psplSrchPostingsList;          /* Search postings list (postings cursor) */
+    struct srchPosting      *pspSrchPostingsEnd;            /* Search postings list end (postings cursor) */
+    boolean                 bSrchPostingsListMoved;         /* Set once the search postings list has been moved on to search postings decoded on demand (postings cursor) */
+
+    struct srchCursor       *pscSrchCursor1;                /* First search cursor (operator cursor) */
+    struct srchCursor       *pscSrchCursor2;                /* Second search cursor (operator cursor) */
+    struct srchPosting      *pspSrchPostingsBuffer;         /* Search postings buffer for the current document (operator cursor, postings cursor with document containers) */
+    unsigned int            uiSrchPostingsBufferLength;     /* Search postings buffer length (operator cursor) */
+
+    struct srchCursorBound  *pscbSrchCursorBounds;          /* Search cursor bounds in term order (WAND cursor) */
+    struct srchCursorBound  **ppscbSrchCursorBoundsSorted;  /* Search cursor bounds in document ID order (WAND cursor) */
+    unsigned int            uiSrchCursorBoundsLength;       /* Search cursor bounds length (WAND cursor) */
+    float                   fMinimumWeight;                 /* Weight a document needs to exceed to be matched (WAND cursor) */
+    boolean                 bSkippedDocuments;              /* Set once a document has been passed over for not exceeding the minimum weight (WAND cursor) */
+    struct srchPosting      *pspSrchPostingsScratch;        /* Scratch search postings buffer (multi OR cursor, WAND cursor) */
+    unsigned int            uiSrchPostingsScratchLength;    /* Scratch search postings buffer length (multi OR cursor, WAND cursor) */
+
+    struct srchCursor       **ppscSrchCursors;              /* Search cursors in term order (multi OR cursor, WAND cursor) */
+    unsigned int            uiSrchCursorsLength;            /* Search cursors length (multi OR cursor, WAND cursor) */
+    unsigned int            *puiSrchCursorsDocument;        /* Indices of the search cursors on the current document in term order (multi OR cursor, WAND cursor) */
+    unsigned int            uiSrchCursorsDocumentLength;    /* Indices of the search cursors on the current document length (multi OR cursor, WAND cursor) */
+    unsigned int            *puiLoserTree;                  /* Loser tree over the search cursors (multi OR cursor) */
+    unsigned int            *puiLoserTreeDocumentIDs;       /* Document IDs the loser tree is keyed on, UINT_MAX for the search cursors which have run out of documents (multi OR cursor) */
+
+    unsigned int            uiDocumentID;                   /* Current document ID */
+    struct srchPosting      *pspSrchPostings;               /* Search postings for the current document */
+    unsigned int            uiSrchPostingsLength;           /* Search postings length for the current document */
+    boolean                 bTermPositionsPending;          /* Set if the term positions of the search postings for the current document may not have been loaded (operator cursor, WAND cursor) */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Public function prototypes
+*/
+
+int iSrchCursorCreateFromSrchPostingsList (struct srchPostingsList *psplSrchPostingsList,
+        struct srchCursor **ppscSrchCursor);
+
+int iSrchCursorCreateFromSrchCursors (unsigned int uiCursorTypeID, struct srchCursor *pscSrchCursor1,
+        struct srchCursor *pscSrchCursor2, int iTermDistance, boolean bTermOrderMatters,
+        unsigned int uiSrchPostingBooleanOperationID, struct srchCursor **ppscSrchCursor);
+
+int iSrchCursorCreateWANDFromSrchCursors (struct srchCursor **ppscSrchCursors,
+        unsigned int uiSrchCursorsLength, struct srchCursor **ppscSrchCursor);
+
+int iSrchCursorCreateMultiORFromSrchCursors (struct srchCursor **ppscSrchCursors,
+        unsigned int uiSrchCursorsLength, unsigned int uiSrchPostingBooleanOperationID, 
+        struct srchCursor **ppscSrchCursor);
+
+int iSrchCursorFree (struct srchCursor *pscSrchCursor);
+
+
+int iSrchCursorNextDocument (struct srchCursor *pscSrchCursor);
+
+int iSrchCursorSeekDocument (struct srchCursor *pscSrchCursor, unsigned int uiDocumentID);
+
+int iSrchCursorSetMinimumWeight (struct srchCursor *pscSrchCursor, float fMinimumWeight);
+
+
+int iSrchCursorGetDocumentID (struct srchCursor *pscSrchCursor, unsigned int *puiDocumentID);
+
+int iSrchCursorGetSrchPostings (struct srchCursor *pscSrchCursor,
+        struct srchPosting **ppspSrchPostings, unsigned int *puiSrchPostingsLength);
+
+int iSrchCursorGetWeight (struct srchCursor *pscSrchCursor, float *pfWeight);
+
+
+int iSrchCursorGetSrchPostingsList (struct srchCursor *pscSrchCursor,
+        struct srchPostingsList **ppsplSrchPostingsList);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** C++ wrapper
+*/
+
+#if defined(__cplusplus)
+}
+#endif    /* defined(__cplusplus) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#endif    /* !defined(SRCH_CURSOR_H) */
+
+
+/*---------------------------------------------------------------------------*/
@@ -59,6 +59,37 @@
 /*---------------------------------------------------------------------------*/
 
 
+/*
+** Structures
+*/
+
+/* Document date structure, used to sort the document IDs on their date when creating the date index */
+struct srchDocumentDate {
+    unsigned long   ulAnsiDate;                     /* Ansi date */
+    unsigned int    uiDocumentID;                   /* Document ID */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Globals
+*/
+
+/* Document column widths, indexed by column ID */
+static size_t pzSrchDocumentColumnWidthsGlobal[SRCH_DOCUMENT_COLUMN_COUNT] = 
+{
+    sizeof(unsigned int),       /* SRCH_DOCUMENT_COLUMN_RANK_ID */
+    sizeof(unsigned int),       /* SRCH_DOCUMENT_COLUMN_TERM_COUNT_ID */
+    sizeof(unsigned long),      /* SRCH_DOCUMENT_COLUMN_DATE_ID */
+    sizeof(unsigned int)        /* SRCH_DOCUMENT_COLUMN_LANGUAGE_ID_ID */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 ** Private function prototypes
 */ 
@@ -87,6 +118,13 @@ static int iSrchDocumentSaveDocumentDataEntry (struct srchIndex *psiSrchIndex, u
         unsigned long *pulDocumentDataID);
 
 
+/* Document columns management functions */
+static int iSrchDocumentCreateDateIndex (struct srchIndex *psiSrchIndex);
+
+static int iSrchDocumentCompareDocumentDateAsc (struct srchDocumentDate *psddSrchDocumentDate1, 
+        struct srchDocumentDate *psddSrchDocumentDate2);
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -171,6 +209,16 @@ int iSrchDocumentGetDocumentInfo
     }
 
 
+    /* Get the document information from the document columns if we only need the rank, term count, date and/or language,
+    ** this avoids reading the whole document table entry
+    */
+    if ( (psiSrchIndex->psdcSrchDocumentColumns != NULL) && (uiDocumentID <= psiSrchIndex->psdcSrchDocumentColumns->uiDocumentCount) &&
+            (ppucTitle == NULL) && (ppucDocumentKey == NULL) && ((ppsdiSrchDocumentItems == NULL) || (puiSrchDocumentItemsLength == NULL)) ) {
+        SRCH_DOCUMENT_COLUMNS_GET_DOCUMENT_INFO(psiSrchIndex->psdcSrchDocumentColumns, uiDocumentID, puiRank, puiTermCount, pulAnsiDate, puiLanguageID);
+        return (SRCH_NoError);
+    }
+
+
     /* Get the document table entry information */
     if ( (iError = iSrchDocumentGetDocumentTableEntry(psiSrchIndex, uiDocumentID, &ulDocumentDataID, puiRank, puiTermCount, 
             pulAnsiDate, puiLanguageID)) != SRCH_NoError ) {
@@ -427,6 +475,656 @@ int iSrchDocumentValidateDocumentID
 /*---------------------------------------------------------------------------*/
 
 
+/* 
+** ========================================
+** ===  Document Columns Management     ===
+** ========================================
+*/
+
+
+/*
+
+    Function:   iSrchDocumentCreateDocumentColumns()
+
+    Purpose:    This function creates the document columns for the index 
+                being created, the document columns are filled in as the 
+                document information is saved.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchDocumentCreateDocumentColumns
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int                             iError = SRCH_NoError;
+    struct srchDocumentColumns      *psdcSrchDocumentColumns = NULL;
+    unsigned char                   pucColumnFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    unsigned char                   pucBuffer[sizeof(unsigned long)] = {'\0'};
+    unsigned int                    uiI = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchDocumentCreateDocumentColumns'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Allocate the document columns structure */
+    if ( (psdcSrchDocumentColumns = (struct srchDocumentColumns *)s_malloc((size_t)sizeof(struct srchDocumentColumns))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+
+    /* Create the column files */
+    for ( uiI = 0; uiI < SRCH_DOCUMENT_COLUMN_COUNT; uiI++ ) {
+
+        /* Get the column file path */
+        if ( (iError = iSrchFilePathsGetDocumentColumnFilePathFromIndex(psiSrchIndex, uiI, pucColumnFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document column file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+            goto bailFromiSrchDocumentCreateDocumentColumns;
+        }
+
+        /* Create the column file */
+        if ( (psdcSrchDocumentColumns->ppfColumnFiles[uiI] = s_fopen(pucColumnFilePath, "w")) == NULL ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document column file: '%s'.", pucColumnFilePath);
+            iError = SRCH_DocumentCreateDocumentColumnsFailed;
+            goto bailFromiSrchDocumentCreateDocumentColumns;
+        }
+
+        /* Write the entry for document ID 0 which is not used, this is so the columns can be indexed by document ID */
+        if ( s_fwrite(pucBuffer, pzSrchDocumentColumnWidthsGlobal[uiI], 1, psdcSrchDocumentColumns->ppfColumnFiles[uiI]) != 1 ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the document column file: '%s'.", pucColumnFilePath);
+            iError = SRCH_DocumentCreateDocumentColumnsFailed;
+            goto bailFromiSrchDocumentCreateDocumentColumns;
+        }
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchDocumentCreateDocumentColumns:
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+        psiSrchIndex->psdcSrchDocumentColumns = psdcSrchDocumentColumns;
+    }
+    else {
+        for ( uiI = 0; uiI < SRCH_DOCUMENT_COLUMN_COUNT; uiI++ ) {
+            if ( psdcSrchDocumentColumns->ppfColumnFiles[uiI] != NULL ) {
+                s_fclose(psdcSrchDocumentColumns->ppfColumnFiles[uiI]);
+            }
+        }
+        s_free(psdcSrchDocumentColumns);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchDocumentOpenDocumentColumns()
+
+    Purpose:    This function maps in the document columns for the index
+                being searched.
+
+                Indices created before the document columns were added will
+                not have them, and the document columns are not used if any 
+                of the column files is missing or does not match the number 
+                of documents in the index, the document information is then 
+                read from the document table.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchDocumentOpenDocumentColumns
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int                             iError = SRCH_NoError;
+    struct srchDocumentColumns      *psdcSrchDocumentColumns = NULL;
+    unsigned char                   pucColumnFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    FILE                            *pfColumnFile = NULL;
+    off_t                           zColumnFileLength = 0;
+    unsigned int                    uiI = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchDocumentOpenDocumentColumns'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Allocate the document columns structure */
+    if ( (psdcSrchDocumentColumns = (struct srchDocumentColumns *)s_malloc((size_t)sizeof(struct srchDocumentColumns))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+    /* Set the document count */
+    psdcSrchDocumentColumns->uiDocumentCount = psiSrchIndex->uiDocumentCount;
+
+
+    /* Map in the column files */
+    for ( uiI = 0; uiI < SRCH_DOCUMENT_COLUMN_COUNT; uiI++ ) {
+
+        /* Get the column file path */
+        if ( (iError = iSrchFilePathsGetDocumentColumnFilePathFromIndex(psiSrchIndex, uiI, pucColumnFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document column file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+            goto bailFromiSrchDocumentOpenDocumentColumns;
+        }
+
+        /* Fall back to the document table if the column file is missing */
+        if ( bUtlFileIsFile(pucColumnFilePath) == false ) {
+            goto bailFromiSrchDocumentOpenDocumentColumns;
+        }
+
+        /* Open the column file */
+        if ( (pfColumnFile = s_fopen(pucColumnFilePath, "r")) == NULL ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the document column file: '%s'.", pucColumnFilePath);
+            iError = SRCH_DocumentOpenDocumentColumnsFailed;
+            goto bailFromiSrchDocumentOpenDocumentColumns;
+        }
+
+        /* Get the column file length */
+        if ( (iError = iUtlFileGetFileLength(pfColumnFile, &zColumnFileLength)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the length of the document column file: '%s', utl error: %d.", pucColumnFilePath, iError);
+            iError = SRCH_DocumentOpenDocumentColumnsFailed;
+            goto bailFromiSrchDocumentOpenDocumentColumns;
+        }
+
+        /* Fall back to the document table if the column file does not cover all the documents, 
+        ** this would happen if the indexer was interrupted
+        */
+        if ( zColumnFileLength != (off_t)(pzSrchDocumentColumnWidthsGlobal[uiI] * (psiSrchIndex->uiDocumentCount + 1)) ) {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Invalid document column file length: '%s', ignoring the document columns.", pucColumnFilePath);
+            goto bailFromiSrchDocumentOpenDocumentColumns;
+        }
+
+        /* Map in the column file */
+        if ( (iError = iUtlFileMemoryMap(fileno(pfColumnFile), 0, (size_t)zColumnFileLength, PROT_READ, (void **)&psdcSrchDocumentColumns->ppvColumns[uiI])) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to map in the document column file: '%s', utl error: %d.", pucColumnFilePath, iError);
+            iError = SRCH_DocumentOpenDocumentColumnsFailed;
+            goto bailFromiSrchDocumentOpenDocumentColumns;
+        }
+        psdcSrchDocumentColumns->pzColumnLengths[uiI] = (size_t)zColumnFileLength;
+
+        /* Close the column file, the mapping stays in place */
+        s_fclose(pfColumnFile);
+        pfColumnFile = NULL;
+    }
+
+
+    /* Get the date index file path */
+    if ( (iError = iSrchFilePathsGetDocumentDateIndexFilePathFromIndex(psiSrchIndex, pucColumnFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document date index file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchDocumentOpenDocumentColumns;
+    }
+
+    /* Map in the date index, it is optional so we just go without it if it is missing or does not cover all the documents */
+    if ( (psiSrchIndex->uiDocumentCount > 0) && (bUtlFileIsFile(pucColumnFilePath) == true) ) {
+
+        /* Open the date index file */
+        if ( (pfColumnFile = s_fopen(pucColumnFilePath, "r")) == NULL ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the document date index file: '%s'.", pucColumnFilePath);
+            iError = SRCH_DocumentOpenDocumentColumnsFailed;
+            goto bailFromiSrchDocumentOpenDocumentColumns;
+        }
+
+        /* Get the date index file length */
+        if ( (iError = iUtlFileGetFileLength(pfColumnFile, &zColumnFileLength)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the length of the document date index file: '%s', utl error: %d.", pucColumnFilePath, iError);
+            iError = SRCH_DocumentOpenDocumentColumnsFailed;
+            goto bailFromiSrchDocumentOpenDocumentColumns;
+        }
+
+        /* Map in the date index file if it covers all the documents */
+        if ( zColumnFileLength == (off_t)(sizeof(unsigned int) * psiSrchIndex->uiDocumentCount) ) {
+            if ( (iError = iUtlFileMemoryMap(fileno(pfColumnFile), 0, (size_t)zColumnFileLength, PROT_READ, (void **)&psdcSrchDocumentColumns->puiDateIndex)) != UTL_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to map in the document date index file: '%s', utl error: %d.", pucColumnFilePath, iError);
+                iError = SRCH_DocumentOpenDocumentColumnsFailed;
+                goto bailFromiSrchDocumentOpenDocumentColumns;
+            }
+            psdcSrchDocumentColumns->zDateIndexLength = (size_t)zColumnFileLength;
+        }
+        else {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Invalid document date index file length: '%s', ignoring the document date index.", pucColumnFilePath);
+        }
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchDocumentOpenDocumentColumns:
+
+
+    /* Close the column file */
+    if ( pfColumnFile != NULL ) {
+        s_fclose(pfColumnFile);
+    }
+
+    /* Handle the error, we only use the document columns if all of them were mapped in */
+    if ( (iError == SRCH_NoError) && (uiI == SRCH_DOCUMENT_COLUMN_COUNT) ) {
+        psiSrchIndex->psdcSrchDocumentColumns = psdcSrchDocumentColumns;
+    }
+    else {
+        for ( uiI = 0; uiI < SRCH_DOCUMENT_COLUMN_COUNT; uiI++ ) {
+            if ( psdcSrchDocumentColumns->ppvColumns[uiI] != NULL ) {
+                iUtlFileMemoryUnMap(psdcSrchDocumentColumns->ppvColumns[uiI], psdcSrchDocumentColumns->pzColumnLengths[uiI]);
+            }
+        }
+        if ( psdcSrchDocumentColumns->puiDateIndex != NULL ) {
+            iUtlFileMemoryUnMap(psdcSrchDocumentColumns->puiDateIndex, psdcSrchDocumentColumns->zDateIndexLength);
+        }
+        s_free(psdcSrchDocumentColumns);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchDocumentCloseDocumentColumns()
+
+    Purpose:    This function closes the document columns, closing the column
+                files and creating the date index if the index was being created, 
+                and unmapping the columns if the index was being searched.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchDocumentCloseDocumentColumns
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int                             iError = SRCH_NoError;
+    struct srchDocumentColumns      *psdcSrchDocumentColumns = NULL;
+    boolean                         bCreateDateIndex = false;
+    unsigned int                    uiI = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchDocumentCloseDocumentColumns'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Dereference the document columns for convenience */
+    if ( (psdcSrchDocumentColumns = psiSrchIndex->psdcSrchDocumentColumns) == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* The date index needs to be created if the date column file was being written */
+    bCreateDateIndex = (psdcSrchDocumentColumns->ppfColumnFiles[SRCH_DOCUMENT_COLUMN_DATE_ID] != NULL) ? true : false;
+
+
+    /* Close the column files and unmap the columns */
+    for ( uiI = 0; uiI < SRCH_DOCUMENT_COLUMN_COUNT; uiI++ ) {
+
+        if ( psdcSrchDocumentColumns->ppfColumnFiles[uiI] != NULL ) {
+            s_fclose(psdcSrchDocumentColumns->ppfColumnFiles[uiI]);
+        }
+
+        if ( psdcSrchDocumentColumns->ppvColumns[uiI] != NULL ) {
+            iUtlFileMemoryUnMap(psdcSrchDocumentColumns->ppvColumns[uiI], psdcSrchDocumentColumns->pzColumnLengths[uiI]);
+            psdcSrchDocumentColumns->ppvColumns[uiI] = NULL;
+        }
+    }
+
+    /* Unmap the date index */
+    if ( psdcSrchDocumentColumns->puiDateIndex != NULL ) {
+        iUtlFileMemoryUnMap(psdcSrchDocumentColumns->puiDateIndex, psdcSrchDocumentColumns->zDateIndexLength);
+        psdcSrchDocumentColumns->puiDateIndex = NULL;
+    }
+
+    /* Free the document columns structure */
+    s_free(psiSrchIndex->psdcSrchDocumentColumns);
+
+
+    /* Create the date index now that the date column file is complete */
+    if ( bCreateDateIndex == true ) {
+        if ( (iError = iSrchDocumentCreateDateIndex(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document date index, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+            return (iError);
+        }
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchDocumentGetDateIndexOffset()
+
+    Purpose:    This function returns the offset of the first entry in the date 
+                index whose date is greater than or equal to the passed date, 
+                the number of documents is returned if there is no such entry.
+
+                The entries before the returned offset are the document IDs 
+                of the documents dated before the passed date.
+
+    Parameters: psiSrchIndex            search index structure
+                ulAnsiDate              ansi date
+                puiDateIndexOffset      return pointer for the date index offset
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchDocumentGetDateIndexOffset
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned long ulAnsiDate,
+    unsigned int *puiDateIndexOffset
+)
+{
+
+    struct srchDocumentColumns      *psdcSrchDocumentColumns = NULL;
+    unsigned long                   *pulAnsiDates = NULL;
+    unsigned int                    uiLowOffset = 0;
+    unsigned int                    uiHighOffset = 0;
+    unsigned int                    uiMiddleOffset = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchDocumentGetDateIndexOffset'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( (psiSrchIndex->psdcSrchDocumentColumns == NULL) || (psiSrchIndex->psdcSrchDocumentColumns->puiDateIndex == NULL) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Missing date index in the 'psiSrchIndex' parameter passed to 'iSrchDocumentGetDateIndexOffset'."); 
+        return (SRCH_DocumentInvalidDateIndex);
+    }
+
+    if ( puiDateIndexOffset == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiDateIndexOffset' parameter passed to 'iSrchDocumentGetDateIndexOffset'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Dereference the document columns and the date column for convenience */
+    psdcSrchDocumentColumns = psiSrchIndex->psdcSrchDocumentColumns;
+    pulAnsiDates = (unsigned long *)psdcSrchDocumentColumns->ppvColumns[SRCH_DOCUMENT_COLUMN_DATE_ID];
+
+
+    /* Binary search the date index for the first entry dated on or after the passed date */
+    uiLowOffset = 0;
+    uiHighOffset = psdcSrchDocumentColumns->uiDocumentCount;
+    while ( uiLowOffset < uiHighOffset ) {
+        
+        uiMiddleOffset = uiLowOffset + ((uiHighOffset - uiLowOffset) / 2);
+        
+        if ( pulAnsiDates[psdcSrchDocumentColumns->puiDateIndex[uiMiddleOffset]] < ulAnsiDate ) {
+            uiLowOffset = uiMiddleOffset + 1;
+        }
+        else {
+            uiHighOffset = uiMiddleOffset;
+        }
+    }
+
+
+    /* Set the return pointer */
+    *puiDateIndexOffset = uiLowOffset;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchDocumentCreateDateIndex()
+
+    Purpose:    This function creates the date index from the date column 
+                of the index being created, it must be called after the 
+                date column file has been closed.
+
+                The date index is the list of the document IDs sorted on 
+                their date, and on their document ID for documents with 
+                the same date, so a date range maps to a contiguous run of 
+                entries which can be found with a binary search.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchDocumentCreateDateIndex
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int                         iError = SRCH_NoError;
+    unsigned char               pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    FILE                        *pfFile = NULL;
+    off_t                       zColumnFileLength = 0;
+    unsigned long               *pulAnsiDates = NULL;
+    unsigned int                uiDocumentCount = 0;
+    struct srchDocumentDate     *psddSrchDocumentDates = NULL;
+    unsigned int                uiI = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+
+
+    /* Get the date column file path */
+    if ( (iError = iSrchFilePathsGetDocumentColumnFilePathFromIndex(psiSrchIndex, SRCH_DOCUMENT_COLUMN_DATE_ID, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document column file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+    /* Open the date column file */
+    if ( (pfFile = s_fopen(pucFilePath, "r")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the document column file: '%s'.", pucFilePath);
+        iError = SRCH_DocumentCreateDocumentDateIndexFailed;
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+    /* Get the date column file length */
+    if ( (iError = iUtlFileGetFileLength(pfFile, &zColumnFileLength)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the length of the document column file: '%s', utl error: %d.", pucFilePath, iError);
+        iError = SRCH_DocumentCreateDocumentDateIndexFailed;
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+    /* Work out the number of documents, the first entry is for document ID 0 which is not used */
+    if ( (zColumnFileLength < (off_t)sizeof(unsigned long)) || ((zColumnFileLength % sizeof(unsigned long)) != 0) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid document column file length: '%s'.", pucFilePath);
+        iError = SRCH_DocumentCreateDocumentDateIndexFailed;
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+    uiDocumentCount = (unsigned int)(zColumnFileLength / sizeof(unsigned long)) - 1;
+
+    /* Nothing to index */
+    if ( uiDocumentCount == 0 ) {
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+
+    /* Allocate the dates and the document dates */
+    if ( (pulAnsiDates = (unsigned long *)s_malloc((size_t)zColumnFileLength)) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+    if ( (psddSrchDocumentDates = (struct srchDocumentDate *)s_malloc((size_t)(sizeof(struct srchDocumentDate) * uiDocumentCount))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+    /* Read the dates */
+    if ( s_fread(pulAnsiDates, sizeof(unsigned long), uiDocumentCount + 1, pfFile) != (uiDocumentCount + 1) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to read the document column file: '%s'.", pucFilePath);
+        iError = SRCH_DocumentCreateDocumentDateIndexFailed;
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+    s_fclose(pfFile);
+    pfFile = NULL;
+
+
+    /* Sort the document IDs on their date */
+    for ( uiI = 0; uiI < uiDocumentCount; uiI++ ) {
+        psddSrchDocumentDates[uiI].ulAnsiDate = pulAnsiDates[uiI + 1];
+        psddSrchDocumentDates[uiI].uiDocumentID = uiI + 1;
+    }
+
+    s_qsort(psddSrchDocumentDates, uiDocumentCount, sizeof(struct srchDocumentDate), 
+            (int (*)(const void *, const void *))iSrchDocumentCompareDocumentDateAsc);
+
+
+    /* Get the date index file path */
+    if ( (iError = iSrchFilePathsGetDocumentDateIndexFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document date index file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+    /* Create the date index file */
+    if ( (pfFile = s_fopen(pucFilePath, "w")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document date index file: '%s'.", pucFilePath);
+        iError = SRCH_DocumentCreateDocumentDateIndexFailed;
+        goto bailFromiSrchDocumentCreateDateIndex;
+    }
+
+    /* Write out the document IDs */
+    for ( uiI = 0; uiI < uiDocumentCount; uiI++ ) {
+        if ( s_fwrite(&psddSrchDocumentDates[uiI].uiDocumentID, sizeof(unsigned int), 1, pfFile) != 1 ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the document date index file: '%s'.", pucFilePath);
+            iError = SRCH_DocumentCreateDocumentDateIndexFailed;
+            goto bailFromiSrchDocumentCreateDateIndex;
+        }
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchDocumentCreateDateIndex:
+
+
+    /* Close the file */
+    if ( pfFile != NULL ) {
+        s_fclose(pfFile);
+    }
+
+    /* Free the dates and the document dates */
+    s_free(pulAnsiDates);
+    s_free(psddSrchDocumentDates);
+
+    /* Remove the date index file if we failed to create it, it will not be used */
+    if ( iError != SRCH_NoError ) {
+        if ( iSrchFilePathsGetDocumentDateIndexFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1) == SRCH_NoError ) {
+            s_remove(pucFilePath);
+        }
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchDocumentCompareDocumentDateAsc()
+
+    Purpose:    This functions takes a two document date structures and compares their dates,
+                and their document IDs if the dates are the same. This function is used by the 
+                qsort call in iSrchDocumentCreateDateIndex().
+
+    Parameters: psddSrchDocumentDate1       pointer to a document date structure
+                psddSrchDocumentDate2       pointer to a document date structure
+
+    Globals:    none
+
+    Returns:    1 if psddSrchDocumentDate1 > psddSrchDocumentDate2, 
+                -1 if psddSrchDocumentDate2 > psddSrchDocumentDate1, 
+                and 0 if psddSrchDocumentDate1 == psddSrchDocumentDate2
+
+*/
+static int iSrchDocumentCompareDocumentDateAsc
+(
+    struct srchDocumentDate *psddSrchDocumentDate1,
+    struct srchDocumentDate *psddSrchDocumentDate2
+)
+{
+
+    ASSERT(psddSrchDocumentDate1 != NULL);
+    ASSERT(psddSrchDocumentDate2 != NULL);
+
+
+    if ( psddSrchDocumentDate1->ulAnsiDate < psddSrchDocumentDate2->ulAnsiDate ) {
+        return (-1);
+    }
+    else if ( psddSrchDocumentDate1->ulAnsiDate > psddSrchDocumentDate2->ulAnsiDate ) {
+        return (1);
+    }
+    else if ( psddSrchDocumentDate1->uiDocumentID < psddSrchDocumentDate2->uiDocumentID ) {
+        return (-1);
+    }
+    else if ( psddSrchDocumentDate1->uiDocumentID > psddSrchDocumentDate2->uiDocumentID ) {
+        return (1);
+    }
+
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /* 
 ** ========================================
 ** ===  Document Table Entry Management ===
@@ -585,6 +1283,18 @@ static int iSrchDocumentSaveDocumentTableEntry
     ASSERT(ulDocumentTableID == psiSrchIndex->uiDocumentCount);
 
 
+    /* Add the document information to the document columns, they are indexed by document ID */
+    if ( (psiSrchIndex->psdcSrchDocumentColumns != NULL) && (psiSrchIndex->psdcSrchDocumentColumns->ppfColumnFiles[SRCH_DOCUMENT_COLUMN_RANK_ID] != NULL) ) {
+        if ( (s_fwrite(&uiRank, sizeof(unsigned int), 1, psiSrchIndex->psdcSrchDocumentColumns->ppfColumnFiles[SRCH_DOCUMENT_COLUMN_RANK_ID]) != 1) ||
+                (s_fwrite(&uiTermCount, sizeof(unsigned int), 1, psiSrchIndex->psdcSrchDocumentColumns->ppfColumnFiles[SRCH_DOCUMENT_COLUMN_TERM_COUNT_ID]) != 1) ||
+                (s_fwrite(&ulAnsiDate, sizeof(unsigned long), 1, psiSrchIndex->psdcSrchDocumentColumns->ppfColumnFiles[SRCH_DOCUMENT_COLUMN_DATE_ID]) != 1) ||
+                (s_fwrite(&uiLanguageID, sizeof(unsigned int), 1, psiSrchIndex->psdcSrchDocumentColumns->ppfColumnFiles[SRCH_DOCUMENT_COLUMN_LANGUAGE_ID_ID]) != 1) ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to add a document columns entry, document ID: %u, index: '%s'.", uiDocumentID, psiSrchIndex->pucIndexName);
+            return (SRCH_DocumentSaveDocumentColumnsEntryFailed);
+        }
+    }
+
+
     return (SRCH_NoError);
 
 }
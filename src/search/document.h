@@ -75,6 +75,21 @@ extern "C" {
                                                         SRCH_DOCUMENT_LANGUAGE_ID_SIZE)
 
 
+/* Document column IDs, the document rank, term count, date and language ID are
+** also stored as columns, each column is a file of fixed width entries indexed
+** by document ID (entry 0 is not used) which gets mapped in when searching
+*/
+#define SRCH_DOCUMENT_COLUMN_RANK_ID            (0)
+#define SRCH_DOCUMENT_COLUMN_TERM_COUNT_ID      (1)
+#define SRCH_DOCUMENT_COLUMN_DATE_ID            (2)
+#define SRCH_DOCUMENT_COLUMN_LANGUAGE_ID_ID     (3)
+
+#define SRCH_DOCUMENT_COLUMN_COUNT              (4)
+
+#define SRCH_DOCUMENT_COLUMN_VALID(n)           (((n) >= SRCH_DOCUMENT_COLUMN_RANK_ID) && \
+                                                        ((n) <= SRCH_DOCUMENT_COLUMN_LANGUAGE_ID_ID))
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -96,6 +111,50 @@ struct srchDocumentItem {
 };
 
 
+/* Document columns structure, the date index is the list of document IDs sorted
+** on the date column, it is written out when the document columns are closed after 
+** indexing and gets mapped in along with the columns when searching
+*/
+struct srchDocumentColumns {
+    void            *ppvColumns[SRCH_DOCUMENT_COLUMN_COUNT];        /* Mapped columns, indexed by column ID */
+    size_t          pzColumnLengths[SRCH_DOCUMENT_COLUMN_COUNT];    /* Mapped column lengths, indexed by column ID */
+    FILE            *ppfColumnFiles[SRCH_DOCUMENT_COLUMN_COUNT];    /* Column files, indexed by column ID, only set when creating */
+    unsigned int    uiDocumentCount;                                /* Number of documents in the columns */
+    unsigned int    *puiDateIndex;                                  /* Mapped date index, document IDs in date order (optional) */
+    size_t          zDateIndexLength;                               /* Mapped date index length */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Macros
+*/
+
+/* Read the document information from the document columns, the return pointers
+** are optional and the document ID is not checked, so this is only meant for 
+** tight loops over document IDs which are known to be valid
+*/
+#define SRCH_DOCUMENT_COLUMNS_GET_DOCUMENT_INFO(psdc, uiDocumentID, puiRank, puiTermCount, pulAnsiDate, puiLanguageID) \
+{ \
+    ASSERT((psdc) != NULL); \
+    ASSERT(((uiDocumentID) > 0) && ((uiDocumentID) <= (psdc)->uiDocumentCount)); \
+    if ( (puiRank) != NULL ) { \
+        *(puiRank) = ((unsigned int *)(psdc)->ppvColumns[SRCH_DOCUMENT_COLUMN_RANK_ID])[(uiDocumentID)]; \
+    } \
+    if ( (puiTermCount) != NULL ) { \
+        *(puiTermCount) = ((unsigned int *)(psdc)->ppvColumns[SRCH_DOCUMENT_COLUMN_TERM_COUNT_ID])[(uiDocumentID)]; \
+    } \
+    if ( (pulAnsiDate) != NULL ) { \
+        *(pulAnsiDate) = ((unsigned long *)(psdc)->ppvColumns[SRCH_DOCUMENT_COLUMN_DATE_ID])[(uiDocumentID)]; \
+    } \
+    if ( (puiLanguageID) != NULL ) { \
+        *(puiLanguageID) = ((unsigned int *)(psdc)->ppvColumns[SRCH_DOCUMENT_COLUMN_LANGUAGE_ID_ID])[(uiDocumentID)]; \
+    } \
+}
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -120,6 +179,16 @@ int iSrchDocumentGetNewDocumentID (struct srchIndex *psiSrchIndex, unsigned int
 int iSrchDocumentValidateDocumentID (struct srchIndex *psiSrchIndex, unsigned int uiDocumentID);
 
 
+int iSrchDocumentCreateDocumentColumns (struct srchIndex *psiSrchIndex);
+
+int iSrchDocumentOpenDocumentColumns (struct srchIndex *psiSrchIndex);
+
+int iSrchDocumentCloseDocumentColumns (struct srchIndex *psiSrchIndex);
+
+int iSrchDocumentGetDateIndexOffset (struct srchIndex *psiSrchIndex, 
+        unsigned long ulAnsiDate, unsigned int *puiDateIndexOffset);
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -55,6 +55,7 @@
 /* Search feedback sort structure */
 struct srchFeedbackSort {
     unsigned char   *pucTerm;                   /* Term */
+    unsigned int    uiTermID;                   /* Term ID, SRCH_TERMDICT_TERM_ID_INVALID if the term was not looked up by term ID */
     unsigned int    uiTermCountInFeedback;      /* Number of occurrences of this term in feedback text */
     unsigned int    uiTermCount;                /* Number of occurrences of this term */
     unsigned int    uiDocumentCount;            /* Number of documents in which this term occurs */
@@ -104,11 +105,19 @@ static int iSrchFeedbackGetSearchWeightFromFeedbackText (struct srchSearch *pssS
         unsigned int uiEndDocumentID, unsigned char *pucFieldIDBitmap, 
         unsigned int uiFieldIDBitmapLength, struct srchWeight **ppswSrchWeight);
 
+static int iSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys (struct srchSearch *pssSrchSearch, 
+        struct srchIndex *psiSrchIndex, wchar_t *pwcFeedbackDocumentKeys, unsigned int uiFeedbackType, 
+        unsigned int uiStartDocumentID, unsigned int uiEndDocumentID, unsigned char *pucFieldIDBitmap, 
+        unsigned int uiFieldIDBitmapLength, struct srchWeight **ppswSrchWeight);
+
 static int iSrchFeedbackAddTermToTermTrie (struct srchIndex *psiSrchIndex, void *pvUtlTermTrie, void *pvLngStemmer, 
         wchar_t *pwcTerm, unsigned int *puiTotalTermCount, unsigned int *puiUniqueTermCount);
 
 static int iSrchFeedbackCallBackFunction (unsigned char *pucKey, void *pvData, va_list ap);
 
+static int iSrchFeedbackGetTermWeight (struct srchIndex *psiSrchIndex, unsigned char *pucFieldIDBitmap, 
+        unsigned int uiFieldIDBitmapLength, struct srchFeedbackSort *psfsSrchFeedbackSort);
+
 static int iSrchFeedbackSearchWeightFromFeedbackSort (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex,
         struct srchFeedbackSort *psfsSrchFeedbackSort, unsigned int uiSrchFeedbackSortLength, 
         unsigned int uiTotalTermCount, unsigned int uiFeedbackType, unsigned int uiStartDocumentID,
@@ -117,6 +126,9 @@ static int iSrchFeedbackSearchWeightFromFeedbackSort (struct srchSearch *pssSrch
 static int iSrchFeedbackCompareByWeightDesc (struct srchFeedbackSort *pssfsSrchSearchFeedbackSort1, 
         struct srchFeedbackSort *pssfsSrchSearchFeedbackSort2);
 
+static int iSrchFeedbackCompareForwardTermByTermIDAsc (struct srchForwardTerm *psftSrchForwardTerm1, 
+        struct srchForwardTerm *psftSrchForwardTerm2);
+
 
 /*---------------------------------------------------------------------------*/
 
@@ -453,6 +465,16 @@ static int iSrchFeedbackGetSearchWeightFromFeedbackText
     }
 
 
+    /* Get the search weight from the term vectors of the feedback documents if the feedback text is a list of 
+    ** document keys, this saves us from having to tokenize and stem the text of the feedback documents
+    */
+    if ( s_wcsncmp(pwcFeedbackText, SRCH_FEEDBACK_DOCUMENT_KEYS_PREFIX, s_wcslen(SRCH_FEEDBACK_DOCUMENT_KEYS_PREFIX)) == 0 ) {
+        iError = iSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys(pssSrchSearch, psiSrchIndex, pwcFeedbackText + s_wcslen(SRCH_FEEDBACK_DOCUMENT_KEYS_PREFIX), 
+                uiFeedbackType, uiStartDocumentID, uiEndDocumentID, pucFieldIDBitmap, uiFieldIDBitmapLength, ppswSrchWeight);
+        goto bailFromiSrchFeedbackGetSearchWeightFromFeedbackText;
+    }
+
+
     /* Create the tokenizer  */
     if ( (iError = iLngTokenizerCreateByID(pssSrchSearch->pucConfigurationDirectoryPath, psiSrchIndex->uiTokenizerID, uiLanguageID, &pvLngTokenizer)) != LNG_NoError ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a tokenizer for relevance feedback, lng error: %d.", iError);
@@ -625,6 +647,219 @@ static int iSrchFeedbackGetSearchWeightFromFeedbackText
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys()
+
+    Purpose:    This function gets the search weight from the term vectors of 
+                the feedback documents in the forward index. The term vectors
+                are summed and used in place of the terms of the feedback text.
+
+                Document keys which are not in the index are skipped, and 
+                the feedback is ignored if the index has no forward index.
+
+    Parameters: pssSrchSearch               search structure
+                psiSrchIndex                index structure
+                pwcFeedbackDocumentKeys     feedback document keys
+                uiFeedbackType              feedback type
+                uiStartDocumentID           start document ID restriction (0 for no restriction)
+                uiEndDocumentID             end document ID restriction (0 for no restriction)
+                pucFieldIDBitmap            field ID bitmap (optional)
+                uiFieldIDBitmapLength       field ID bitmap length (optional)
+                ppswSrchWeight              return pointer for the search weight structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys
+(
+    struct srchSearch *pssSrchSearch,
+    struct srchIndex *psiSrchIndex,
+    wchar_t *pwcFeedbackDocumentKeys,
+    unsigned int uiFeedbackType,
+    unsigned int uiStartDocumentID,
+    unsigned int uiEndDocumentID,
+    unsigned char *pucFieldIDBitmap,
+    unsigned int uiFieldIDBitmapLength,
+    struct srchWeight **ppswSrchWeight
+)
+{
+
+    int                         iError = SRCH_NoError;
+    unsigned char               *pucFeedbackDocumentKeys = NULL;
+    unsigned char               *pucDocumentKeyPtr = NULL;
+    unsigned char               *pucDocumentKeysStrtokPtr = NULL;
+    struct srchForwardTerm      *psftSrchForwardTerms = NULL;
+    unsigned int                uiSrchForwardTermsLength = 0;
+    unsigned int                uiSrchForwardTermsCapacity = 0;
+    unsigned int                uiTotalTermCount = 0;
+    struct srchFeedbackSort     *psfsSrchFeedbackSort = NULL;
+    unsigned int                uiSrchFeedbackSortLength = 0;
+    unsigned int                uiI = 0;
+
+
+    ASSERT(pssSrchSearch != NULL);
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(pwcFeedbackDocumentKeys != NULL);
+    ASSERT(SRCH_SEARCH_FEEDBACK_TYPE_VALID(uiFeedbackType) == true);
+    ASSERT(uiStartDocumentID >= 0);
+    ASSERT(uiEndDocumentID >= 0);
+    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
+    ASSERT(ppswSrchWeight != NULL);
+
+
+    /* Ignore the feedback if there is no forward index, we have no way to get the feedback terms */
+    if ( psiSrchIndex->psfSrchForward == NULL ) {
+        iSrchReportAppend(pssSrchSearch->pvSrchReport, "%s Feedback by document key was submitted but was not used because the index has no forward index\n", REP_SEARCH_WARNING);
+        return (SRCH_NoError);
+    }
+
+
+    /* Convert the document keys from wide characters to utf-8, pucFeedbackDocumentKeys is allocated */
+    if ( (iError = iLngConvertWideStringToUtf8_d(pwcFeedbackDocumentKeys, 0, &pucFeedbackDocumentKeys)) != LNG_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert the feedback document keys from wide characters to utf-8, lng error: %d.", iError);
+        iError = SRCH_FeedbackCharacterSetConvertionFailed;
+        goto bailFromiSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys;
+    }
+
+
+    /* Loop over the document keys, collecting the term vectors of the documents */
+    for ( pucDocumentKeyPtr = (unsigned char *)s_strtok_r(pucFeedbackDocumentKeys, SRCH_FEEDBACK_DOCUMENT_KEYS_SEPARATORS, (char **)&pucDocumentKeysStrtokPtr); 
+            pucDocumentKeyPtr != NULL; 
+            pucDocumentKeyPtr = (unsigned char *)s_strtok_r(NULL, SRCH_FEEDBACK_DOCUMENT_KEYS_SEPARATORS, (char **)&pucDocumentKeysStrtokPtr) ) {
+
+        unsigned int                uiDocumentID = 0;
+        struct srchForwardTerm      *psftSrchForwardTermVector = NULL;
+        unsigned int                uiSrchForwardTermVectorLength = 0;
+
+        /* Look up the document key, skipping documents which are not in this index */
+        if ( iSrchKeyDictLookup(psiSrchIndex, pucDocumentKeyPtr, &uiDocumentID) != SRCH_NoError ) {
+            continue;
+        }
+
+        /* Get the term vector for the document */
+        if ( (iError = iSrchForwardGetDocumentTermVector(psiSrchIndex, uiDocumentID, &psftSrchForwardTermVector, &uiSrchForwardTermVectorLength)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the term vector for a feedback document, document key: '%s', srch error: %d.", pucDocumentKeyPtr, iError);
+            goto bailFromiSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys;
+        }
+
+        /* Add the term vector to the forward terms */
+        if ( uiSrchForwardTermVectorLength > 0 ) {
+
+            /* Extend the forward terms if needed */
+            if ( (uiSrchForwardTermsLength + uiSrchForwardTermVectorLength) > uiSrchForwardTermsCapacity ) {
+
+                struct srchForwardTerm      *psftSrchForwardTermsPtr = NULL;
+
+                if ( (psftSrchForwardTermsPtr = (struct srchForwardTerm *)s_realloc(psftSrchForwardTerms, 
+                        (size_t)(sizeof(struct srchForwardTerm) * (uiSrchForwardTermsLength + uiSrchForwardTermVectorLength)))) == NULL ) {
+                    s_free(psftSrchForwardTermVector);
+                    iError = SRCH_MemError;
+                    goto bailFromiSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys;
+                }
+
+                psftSrchForwardTerms = psftSrchForwardTermsPtr;
+                uiSrchForwardTermsCapacity = uiSrchForwardTermsLength + uiSrchForwardTermVectorLength;
+            }
+
+            s_memcpy(psftSrchForwardTerms + uiSrchForwardTermsLength, psftSrchForwardTermVector, sizeof(struct srchForwardTerm) * uiSrchForwardTermVectorLength);
+            uiSrchForwardTermsLength += uiSrchForwardTermVectorLength;
+        }
+
+        /* Free the term vector */
+        s_free(psftSrchForwardTermVector);
+    }
+
+
+    /* Nothing to do if none of the documents had any terms */
+    if ( uiSrchForwardTermsLength == 0 ) {
+        goto bailFromiSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys;
+    }
+
+
+    /* Sort the forward terms by term ID and sum the counts of the same terms */
+    s_qsort(psftSrchForwardTerms, uiSrchForwardTermsLength, sizeof(struct srchForwardTerm), 
+            (int (*)(const void *, const void *))iSrchFeedbackCompareForwardTermByTermIDAsc);
+
+    for ( uiI = 1, uiSrchFeedbackSortLength = 1, uiTotalTermCount = psftSrchForwardTerms[0].uiTermCount; uiI < uiSrchForwardTermsLength; uiI++ ) {
+
+        if ( psftSrchForwardTerms[uiI].uiTermID == psftSrchForwardTerms[uiSrchFeedbackSortLength - 1].uiTermID ) {
+            psftSrchForwardTerms[uiSrchFeedbackSortLength - 1].uiTermCount += psftSrchForwardTerms[uiI].uiTermCount;
+        }
+        else {
+            psftSrchForwardTerms[uiSrchFeedbackSortLength] = psftSrchForwardTerms[uiI];
+            uiSrchFeedbackSortLength++;
+        }
+
+        uiTotalTermCount += psftSrchForwardTerms[uiI].uiTermCount;
+    }
+
+
+    /* Allocate an feedback sort array */
+    if ( (psfsSrchFeedbackSort = (struct srchFeedbackSort *)s_malloc((size_t)(uiSrchFeedbackSortLength * sizeof(struct srchFeedbackSort)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys;
+    }
+
+    /* Fill the feedback sort array from the forward terms, the terms are looked up by term ID */
+    for ( uiI = 0; uiI < uiSrchFeedbackSortLength; uiI++ ) {
+
+        /* Set the term ID and the term count in the feedback documents */
+        (psfsSrchFeedbackSort + uiI)->uiTermID = psftSrchForwardTerms[uiI].uiTermID;
+        (psfsSrchFeedbackSort + uiI)->uiTermCountInFeedback = psftSrchForwardTerms[uiI].uiTermCount;
+
+        /* Get the term and the term weight */
+        if ( (iError = iSrchFeedbackGetTermWeight(psiSrchIndex, pucFieldIDBitmap, uiFieldIDBitmapLength, psfsSrchFeedbackSort + uiI)) != SRCH_NoError ) {
+            
+            /* The term exists but does not occur in the fields */
+            if ( iError == SRCH_TermDictTermDoesNotOccur ) {
+                iError = SRCH_NoError;
+            }
+            else {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get a feedback term from the term dictionary, term ID: %u, srch error: %d.", psftSrchForwardTerms[uiI].uiTermID, iError);
+                goto bailFromiSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys;
+            }
+        }
+    }
+
+
+    /* Loop through each entry in the term list calling the call back function for each entry */
+    if ( (iError = iSrchFeedbackSearchWeightFromFeedbackSort(pssSrchSearch, psiSrchIndex, psfsSrchFeedbackSort, uiSrchFeedbackSortLength, 
+            uiTotalTermCount, uiFeedbackType, uiStartDocumentID, uiEndDocumentID, ppswSrchWeight)) != SRCH_NoError ) {
+        goto bailFromiSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys:
+
+
+    /* Free the feedback sort array */
+    if ( psfsSrchFeedbackSort != NULL ) {
+        for ( uiI = 0; uiI < uiSrchFeedbackSortLength; uiI++ ) {
+            s_free((psfsSrchFeedbackSort + uiI)->pucTerm);
+        }
+        s_free(psfsSrchFeedbackSort);
+    }
+
+    /* Free the forward terms */
+    s_free(psftSrchForwardTerms);
+
+    /* Free the document keys */
+    s_free(pucFeedbackDocumentKeys);
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchFeedbackAddTermToTermTrie()
@@ -804,7 +1039,6 @@ static int iSrchFeedbackCallBackFunction
 {
 
     va_list                     ap_;
-    int                         iError = SRCH_NoError;
     struct srchSearch           *pssSrchSearch = NULL;
     struct srchIndex            *psiSrchIndex = NULL;
     unsigned char               *pucFieldIDBitmap = NULL;
@@ -813,10 +1047,6 @@ static int iSrchFeedbackCallBackFunction
     unsigned int                uiSrchFeedbackSortLength = 0;
     struct srchFeedbackSort     *psfsSrchFeedbackSortPtr = NULL;
     unsigned int                *puiSrchSearchFeedbackSortIndex = NULL;
-    unsigned int                uiTermType = 0;
-    unsigned int                uiTermCount = 0;
-    unsigned int                uiDocumentCount = 0;
-    unsigned long               ulIndexBlockID = 0;
 
 
 /*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchFeedbackCallBackFunction - [%s][%u]", pucKey, (unsigned int)pvData); */
@@ -860,36 +1090,109 @@ static int iSrchFeedbackCallBackFunction
     psfsSrchFeedbackSortPtr->uiTermCountInFeedback = (unsigned int)pvData;
 
 
-    /* Preset the term count, the document count, and the weight */
-    psfsSrchFeedbackSortPtr->uiTermCount = 0;
-    psfsSrchFeedbackSortPtr->uiDocumentCount = 0;
-    psfsSrchFeedbackSortPtr->fWeight = 0;
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm - [%s]", psfsSrchFeedbackSortPtr->pucTerm); */
 
+    /* Get the term weight */
+    iSrchFeedbackGetTermWeight(psiSrchIndex, pucFieldIDBitmap, uiFieldIDBitmapLength, psfsSrchFeedbackSortPtr);
+
+
+    /* Increment the indent */
+    (*puiSrchSearchFeedbackSortIndex)++;
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm - [%s]", psfsSrchFeedbackSortPtr->pucTerm); */
 
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchFeedbackGetTermWeight()
+
+    Purpose:    This function looks up the term in a search feedback sort 
+                structure and sets its term count, document count and weight.
+
+                The term is looked up by term ID if there is one, in which 
+                case the term is set from the term ID table if it is not set.
+
+    Parameters: psiSrchIndex                index structure
+                pucFieldIDBitmap            field ID bitmap (optional)
+                uiFieldIDBitmapLength       field ID bitmap length (optional)
+                psfsSrchFeedbackSort        search feedback sort structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchFeedbackGetTermWeight
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucFieldIDBitmap,
+    unsigned int uiFieldIDBitmapLength,
+    struct srchFeedbackSort *psfsSrchFeedbackSort
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned int    uiTermType = 0;
+    unsigned int    uiTermCount = 0;
+    unsigned int    uiDocumentCount = 0;
+    unsigned long   ulIndexBlockID = 0;
+    unsigned int    uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
+    unsigned char   *pucTerm = NULL;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
+    ASSERT(psfsSrchFeedbackSort != NULL);
+    ASSERT((bUtlStringsIsStringNULL(psfsSrchFeedbackSort->pucTerm) == false) || (psfsSrchFeedbackSort->uiTermID != SRCH_TERMDICT_TERM_ID_INVALID));
+
+
+    /* Preset the term count, the document count, and the weight */
+    psfsSrchFeedbackSort->uiTermCount = 0;
+    psfsSrchFeedbackSort->uiDocumentCount = 0;
+    psfsSrchFeedbackSort->fWeight = 0;
+
+
+    /* Look up the term by term ID, this saves a term dictionary lookup */
+    if ( psfsSrchFeedbackSort->uiTermID != SRCH_TERMDICT_TERM_ID_INVALID ) {
+        
+        iError = iSrchTermDictLookupTermID(psiSrchIndex, psfsSrchFeedbackSort->uiTermID, pucFieldIDBitmap, uiFieldIDBitmapLength, 
+                &pucTerm, &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID);
+        
+        /* Make a copy of the term if it is not set, it is needed even if the term does not occur */
+        if ( ((iError == SRCH_NoError) || (iError == SRCH_TermDictTermDoesNotOccur)) && (psfsSrchFeedbackSort->pucTerm == NULL) ) {
+            if ( (psfsSrchFeedbackSort->pucTerm = (unsigned char *)s_strdup(pucTerm)) == NULL ) {
+                return (SRCH_MemError);
+            }
+        }
+    }
     /* Look up the term */
-    if ( (iError = iSrchTermDictLookup(psiSrchIndex, psfsSrchFeedbackSortPtr->pucTerm, pucFieldIDBitmap, uiFieldIDBitmapLength, 
-            &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID)) == SRCH_NoError ) {
+    else {
+        iError = iSrchTermDictLookup(psiSrchIndex, psfsSrchFeedbackSort->pucTerm, pucFieldIDBitmap, uiFieldIDBitmapLength, 
+                &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID);
+    }
+
+    if ( iError == SRCH_NoError ) {
 
         /* If this term is a regular term, we work out its IDF weight */
         if ( uiTermType == SPI_TERM_TYPE_REGULAR ) {
 
             /* Set the term count and the document count */
-            psfsSrchFeedbackSortPtr->uiTermCount = uiTermCount;
-            psfsSrchFeedbackSortPtr->uiDocumentCount = uiDocumentCount;
+            psfsSrchFeedbackSort->uiTermCount = uiTermCount;
+            psfsSrchFeedbackSort->uiDocumentCount = uiDocumentCount;
 
             /* This works out the IDF of the term */
-            psfsSrchFeedbackSortPtr->fWeight += SRCH_SEARCH_IDF_FACTOR(uiTermCount, uiDocumentCount, psiSrchIndex->uiDocumentCount) * psfsSrchFeedbackSortPtr->uiTermCountInFeedback;
+            psfsSrchFeedbackSort->fWeight += SRCH_SEARCH_IDF_FACTOR(uiTermCount, uiDocumentCount, psiSrchIndex->uiDocumentCount) * psfsSrchFeedbackSort->uiTermCountInFeedback;
         }
     }
 
 
-    /* Increment the indent */
-    (*puiSrchSearchFeedbackSortIndex)++;
-
-
-    return (0);
+    return (iError);
 
 }
 
@@ -1347,4 +1650,48 @@ static int iSrchFeedbackCompareByWeightDesc
 }
 
 
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchFeedbackCompareForwardTermByTermIDAsc()
+
+    Purpose:    This functions takes a two forward term structures and compares their term ID.
+                This function is used by the qsort call in iSrchFeedbackGetSearchWeightFromFeedbackDocumentKeys().
+
+    Parameters: psftSrchForwardTerm1    pointer to a forward term structure
+                psftSrchForwardTerm2    pointer to a forward term structure
+
+    Globals:    none
+
+    Returns:    1 if psftSrchForwardTerm1 > psftSrchForwardTerm2, 
+                -1 if psftSrchForwardTerm2 > psftSrchForwardTerm1, 
+                and 0 if psftSrchForwardTerm1 == psftSrchForwardTerm2
+
+*/
+static int iSrchFeedbackCompareForwardTermByTermIDAsc
+(
+    struct srchForwardTerm *psftSrchForwardTerm1,
+    struct srchForwardTerm *psftSrchForwardTerm2
+)
+{
+
+    ASSERT(psftSrchForwardTerm1 != NULL);
+    ASSERT(psftSrchForwardTerm2 != NULL);
+
+
+    if ( psftSrchForwardTerm1->uiTermID < psftSrchForwardTerm2->uiTermID ) {
+        return (-1);
+    }
+    else if ( psftSrchForwardTerm1->uiTermID > psftSrchForwardTerm2->uiTermID ) {
+        return (1);
+    }
+    else { 
+        return (0);
+    }
+
+}
+
+
 /*---------------------------------------------------------------------------*/
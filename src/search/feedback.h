@@ -52,6 +52,21 @@ extern "C" {
 /*---------------------------------------------------------------------------*/
 
 
+/*
+** Defines
+*/
+
+/* Feedback text prefix for feedback by document keys, the document keys follow, separated 
+** by commas or spaces, and are closed by a brace, for example '{feedback_document_keys:1234,5678}',
+** the feedback terms are then taken from the term vectors of the documents in the forward index
+*/
+#define SRCH_FEEDBACK_DOCUMENT_KEYS_PREFIX              L"{feedback_document_keys:"
+#define SRCH_FEEDBACK_DOCUMENT_KEYS_SEPARATORS          (unsigned char *)", }"
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 ** Public function prototypes
 */
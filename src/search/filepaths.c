@@ -63,6 +63,20 @@
 #define SRCH_FILE_PATHS_KEY_DICTIONARY_FILENAME         (unsigned char *)"key.dct"
 #define SRCH_FILE_PATHS_DOCUMENT_TABLE_FILENAME         (unsigned char *)"document.tab"
 #define SRCH_FILE_PATHS_DOCUMENT_DATA_FILENAME          (unsigned char *)"document.dat"
+#define SRCH_FILE_PATHS_DOCUMENT_RANK_FILENAME          (unsigned char *)"rank.col"
+#define SRCH_FILE_PATHS_DOCUMENT_TERM_COUNT_FILENAME    (unsigned char *)"termcount.col"
+#define SRCH_FILE_PATHS_DOCUMENT_DATE_FILENAME          (unsigned char *)"date.col"
+#define SRCH_FILE_PATHS_DOCUMENT_LANGUAGE_ID_FILENAME   (unsigned char *)"language.col"
+#define SRCH_FILE_PATHS_DOCUMENT_DATE_INDEX_FILENAME    (unsigned char *)"date.idx"
+#define SRCH_FILE_PATHS_TERM_FILTER_FILENAME            (unsigned char *)"term.flt"
+#define SRCH_FILE_PATHS_TERM_IDS_INDEX_FILENAME         (unsigned char *)"termid.idx"
+#define SRCH_FILE_PATHS_TERM_IDS_DATA_FILENAME          (unsigned char *)"termid.dat"
+#define SRCH_FILE_PATHS_TERM_GRAMS_FILENAME             (unsigned char *)"termgram.dct"
+#define SRCH_FILE_PATHS_SOUNDEX_KEYS_FILENAME           (unsigned char *)"soundex.dct"
+#define SRCH_FILE_PATHS_METAPHONE_KEYS_FILENAME         (unsigned char *)"metaphon.dct"
+#define SRCH_FILE_PATHS_PHONIX_KEYS_FILENAME            (unsigned char *)"phonix.dct"
+#define SRCH_FILE_PATHS_FORWARD_INDEX_FILENAME          (unsigned char *)"forward.idx"
+#define SRCH_FILE_PATHS_FORWARD_DATA_FILENAME           (unsigned char *)"forward.dat"
 #define SRCH_FILE_PATHS_INDEX_DATA_FILENAME             (unsigned char *)"index.dat"
 #define SRCH_FILE_PATHS_INDEX_INFORMATION_FILENAME      (unsigned char *)"index.inf"
 #define SRCH_FILE_PATHS_INDEX_LOCK_FILENAME             (unsigned char *)"index.lck"
@@ -71,6 +85,7 @@
 /* Temporary file name addition */
 #define SRCH_FILE_PATHS_TMP_TERM_INDEX_FILE_ADDITION    (unsigned char *)"term"
 #define SRCH_FILE_PATHS_TMP_KEY_INDEX_FILE_ADDITION     (unsigned char *)"key"
+#define SRCH_FILE_PATHS_TMP_FORWARD_FILE_ADDITION       (unsigned char *)"forward"
 
 
 /*---------------------------------------------------------------------------*/
@@ -272,6 +287,85 @@ int iSrchFilePathsGetTempKeyDictionaryFilePathFromIndex
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchFilePathsGetTempForwardIndexFilePathFromIndex()
+
+    Purpose:    Return the temp forward index file path
+
+    Parameters: psiSrchIndex        search index structure
+                pucFilePath         return pointer for the file path
+                uiFilePathLength    length of the return pointer for the file path
+
+    Globals:    none
+
+    Returns:    SRCH error name
+
+*/
+int iSrchFilePathsGetTempForwardIndexFilePathFromIndex
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucFilePath,
+    unsigned int uiFilePathLength
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   pucFileName[UTL_FILE_PATH_MAX + 1] = {'\0'};
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchFilePathsGetTempForwardIndexFilePathFromIndex'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( pucFilePath == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucFilePath' parameter passed to 'iSrchFilePathsGetTempForwardIndexFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( uiFilePathLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiFilePathLength' parameter passed to 'iSrchFilePathsGetTempForwardIndexFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Use the temporary directory if it was provided */
+    if ( psiSrchIndex->psibSrchIndexBuild->pucTemporaryDirectoryPath != NULL ) {
+    
+        /* Create the file name, prepend the index base name to the name */
+        snprintf(pucFileName, UTL_FILE_PATH_MAX + 1, "%s-%s.tmp", psiSrchIndex->pucIndexName, SRCH_FILE_PATHS_TMP_FORWARD_FILE_ADDITION);
+
+        /* Create the final file path */
+        if ( (iError = iUtlFileMergePaths(psiSrchIndex->psibSrchIndexBuild->pucTemporaryDirectoryPath, pucFileName, pucFilePath, uiFilePathLength)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index file path, forward index file name: '%s', temporary directory path: '%s', utl error: %d.", 
+                    pucFileName, psiSrchIndex->psibSrchIndexBuild->pucTemporaryDirectoryPath, iError); 
+            return (SRCH_FilePathsFailed);
+        }
+    }
+    else {
+
+        /* Create the file name */
+        snprintf(pucFileName, UTL_FILE_PATH_MAX + 1, "%s.tmp", SRCH_FILE_PATHS_TMP_FORWARD_FILE_ADDITION);
+
+        /* Create the final file path */
+        if ( (iError = iUtlFileMergePaths(psiSrchIndex->pucIndexPath, pucFileName, pucFilePath, uiFilePathLength)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index file path, forward index file name: '%s', index: '%s', utl error: %d.", 
+                    pucFileName, psiSrchIndex->pucIndexName, iError); 
+            return (SRCH_FilePathsFailed);
+        }
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchFilePathsGetTermDictionaryFilePathFromIndex()
@@ -419,6 +513,454 @@ int iSrchFilePathsGetDocumentTableFilePathFromIndex
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchFilePathsGetDocumentColumnFilePathFromIndex()
+
+    Purpose:    Constructs and returns a document column file path from the index.
+
+    Parameters: psiSrchIndex        search index structure
+                uiColumnID          column ID (SRCH_DOCUMENT_COLUMN_*_ID)
+                pucFilePath         return pointer for the file path
+                uiFilePathLength    length of the return pointer for the file path
+
+    Globals:    none
+
+    Returns:    SRCH error name
+
+*/
+int iSrchFilePathsGetDocumentColumnFilePathFromIndex
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiColumnID,
+    unsigned char *pucFilePath,
+    unsigned int uiFilePathLength
+)
+{
+
+    unsigned char   *pucFileName = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchFilePathsGetDocumentColumnFilePathFromIndex'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( SRCH_DOCUMENT_COLUMN_VALID(uiColumnID) == false ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiColumnID' parameter passed to 'iSrchFilePathsGetDocumentColumnFilePathFromIndex'."); 
+        return (SRCH_DocumentInvalidColumnID);
+    }
+
+    if ( pucFilePath == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucFilePath' parameter passed to 'iSrchFilePathsGetDocumentColumnFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( uiFilePathLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'uiFilePathLength' parameter passed to 'iSrchFilePathsGetDocumentColumnFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Select the file name for the column */
+    switch ( uiColumnID ) {
+
+        case SRCH_DOCUMENT_COLUMN_RANK_ID:
+            pucFileName = SRCH_FILE_PATHS_DOCUMENT_RANK_FILENAME;
+            break;
+
+        case SRCH_DOCUMENT_COLUMN_TERM_COUNT_ID:
+            pucFileName = SRCH_FILE_PATHS_DOCUMENT_TERM_COUNT_FILENAME;
+            break;
+
+        case SRCH_DOCUMENT_COLUMN_DATE_ID:
+            pucFileName = SRCH_FILE_PATHS_DOCUMENT_DATE_FILENAME;
+            break;
+
+        case SRCH_DOCUMENT_COLUMN_LANGUAGE_ID_ID:
+            pucFileName = SRCH_FILE_PATHS_DOCUMENT_LANGUAGE_ID_FILENAME;
+            break;
+    }
+
+
+    /* Get and return the document column file path */
+    return (iSrchFilePathsGetFilePathFromIndexPath(psiSrchIndex->pucIndexPath, pucFileName, pucFilePath, uiFilePathLength));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchFilePathsGetDocumentDateIndexFilePathFromIndex()
+
+    Purpose:    Constructs and returns the document date index file path from the index.
+
+    Parameters: psiSrchIndex        search index structure
+                pucFilePath         return pointer for the file path
+                uiFilePathLength    length of the return pointer for the file path
+
+    Globals:    none
+
+    Returns:    SRCH error name
+
+*/
+int iSrchFilePathsGetDocumentDateIndexFilePathFromIndex
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucFilePath,
+    unsigned int uiFilePathLength
+)
+{
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchFilePathsGetDocumentDateIndexFilePathFromIndex'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( pucFilePath == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucFilePath' parameter passed to 'iSrchFilePathsGetDocumentDateIndexFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( uiFilePathLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'uiFilePathLength' parameter passed to 'iSrchFilePathsGetDocumentDateIndexFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Get and return the document date index file path */
+    return (iSrchFilePathsGetFilePathFromIndexPath(psiSrchIndex->pucIndexPath, SRCH_FILE_PATHS_DOCUMENT_DATE_INDEX_FILENAME, pucFilePath, uiFilePathLength));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchFilePathsGetTermFilterFilePathFromIndex()
+
+    Purpose:    Constructs and returns the term filter file path from the index.
+
+    Parameters: psiSrchIndex        search index structure
+                pucFilePath         return pointer for the file path
+                uiFilePathLength    length of the return pointer for the file path
+
+    Globals:    none
+
+    Returns:    SRCH error name
+
+*/
+int iSrchFilePathsGetTermFilterFilePathFromIndex
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucFilePath,
+    unsigned int uiFilePathLength
+)
+{
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchFilePathsGetTermFilterFilePathFromIndex'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( pucFilePath == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucFilePath' parameter passed to 'iSrchFilePathsGetTermFilterFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( uiFilePathLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'uiFilePathLength' parameter passed to 'iSrchFilePathsGetTermFilterFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Get and return the term filter file path */
+    return (iSrchFilePathsGetFilePathFromIndexPath(psiSrchIndex->pucIndexPath, SRCH_FILE_PATHS_TERM_FILTER_FILENAME, pucFilePath, uiFilePathLength));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchFilePathsGetTermIDsFilePathFromIndex()
+
+    Purpose:    Constructs and returns a term ID table file path from the index.
+
+    Parameters: psiSrchIndex        search index structure
+                uiFileID            term ID table file ID
+                pucFilePath         return pointer for the file path
+                uiFilePathLength    length of the return pointer for the file path
+
+    Globals:    none
+
+    Returns:    SRCH error name
+
+*/
+int iSrchFilePathsGetTermIDsFilePathFromIndex
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiFileID,
+    unsigned char *pucFilePath,
+    unsigned int uiFilePathLength
+)
+{
+
+    unsigned char   *pucFileName = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchFilePathsGetTermIDsFilePathFromIndex'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( SRCH_TERMDICT_TERM_IDS_FILE_VALID(uiFileID) == false ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiFileID' parameter passed to 'iSrchFilePathsGetTermIDsFilePathFromIndex'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( pucFilePath == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucFilePath' parameter passed to 'iSrchFilePathsGetTermIDsFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( uiFilePathLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'uiFilePathLength' parameter passed to 'iSrchFilePathsGetTermIDsFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Select the file name for the term ID table file */
+    switch ( uiFileID ) {
+
+        case SRCH_TERMDICT_TERM_IDS_FILE_INDEX_ID:
+            pucFileName = SRCH_FILE_PATHS_TERM_IDS_INDEX_FILENAME;
+            break;
+
+        case SRCH_TERMDICT_TERM_IDS_FILE_DATA_ID:
+            pucFileName = SRCH_FILE_PATHS_TERM_IDS_DATA_FILENAME;
+            break;
+    }
+
+
+    /* Get and return the term ID table file path */
+    return (iSrchFilePathsGetFilePathFromIndexPath(psiSrchIndex->pucIndexPath, pucFileName, pucFilePath, uiFilePathLength));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchFilePathsGetTermGramsFilePathFromIndex()
+
+    Purpose:    Constructs and returns the term gram dictionary file path from the index.
+
+    Parameters: psiSrchIndex        search index structure
+                pucFilePath         return pointer for the file path
+                uiFilePathLength    length of the return pointer for the file path
+
+    Globals:    none
+
+    Returns:    SRCH error name
+
+*/
+int iSrchFilePathsGetTermGramsFilePathFromIndex
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucFilePath,
+    unsigned int uiFilePathLength
+)
+{
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchFilePathsGetTermGramsFilePathFromIndex'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( pucFilePath == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucFilePath' parameter passed to 'iSrchFilePathsGetTermGramsFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( uiFilePathLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'uiFilePathLength' parameter passed to 'iSrchFilePathsGetTermGramsFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Get and return the term gram dictionary file path */
+    return (iSrchFilePathsGetFilePathFromIndexPath(psiSrchIndex->pucIndexPath, SRCH_FILE_PATHS_TERM_GRAMS_FILENAME, pucFilePath, uiFilePathLength));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchFilePathsGetPhoneticKeysFilePathFromIndex()
+
+    Purpose:    Constructs and returns the phonetic key dictionary file path 
+                for a term match from the index.
+
+    Parameters: psiSrchIndex        search index structure
+                uiTermMatch         term match
+                pucFilePath         return pointer for the file path
+                uiFilePathLength    length of the return pointer for the file path
+
+    Globals:    none
+
+    Returns:    SRCH error name
+
+*/
+int iSrchFilePathsGetPhoneticKeysFilePathFromIndex
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiTermMatch,
+    unsigned char *pucFilePath,
+    unsigned int uiFilePathLength
+)
+{
+
+    unsigned char   *pucFileName = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchFilePathsGetPhoneticKeysFilePathFromIndex'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == false ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiTermMatch' parameter passed to 'iSrchFilePathsGetPhoneticKeysFilePathFromIndex'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( pucFilePath == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucFilePath' parameter passed to 'iSrchFilePathsGetPhoneticKeysFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( uiFilePathLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'uiFilePathLength' parameter passed to 'iSrchFilePathsGetPhoneticKeysFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Select the file name for the phonetic key dictionary */
+    switch ( uiTermMatch ) {
+
+        case SRCH_TERMDICT_TERM_MATCH_SOUNDEX:
+            pucFileName = SRCH_FILE_PATHS_SOUNDEX_KEYS_FILENAME;
+            break;
+
+        case SRCH_TERMDICT_TERM_MATCH_METAPHONE:
+            pucFileName = SRCH_FILE_PATHS_METAPHONE_KEYS_FILENAME;
+            break;
+
+        case SRCH_TERMDICT_TERM_MATCH_PHONIX:
+            pucFileName = SRCH_FILE_PATHS_PHONIX_KEYS_FILENAME;
+            break;
+    }
+
+
+    /* Get and return the phonetic key dictionary file path */
+    return (iSrchFilePathsGetFilePathFromIndexPath(psiSrchIndex->pucIndexPath, pucFileName, pucFilePath, uiFilePathLength));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchFilePathsGetForwardIndexFilePathFromIndex()
+
+    Purpose:    Constructs and returns a forward index file path from the index.
+
+    Parameters: psiSrchIndex        search index structure
+                uiFileID            forward index file ID
+                pucFilePath         return pointer for the file path
+                uiFilePathLength    length of the return pointer for the file path
+
+    Globals:    none
+
+    Returns:    SRCH error name
+
+*/
+int iSrchFilePathsGetForwardIndexFilePathFromIndex
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiFileID,
+    unsigned char *pucFilePath,
+    unsigned int uiFilePathLength
+)
+{
+
+    unsigned char   *pucFileName = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchFilePathsGetForwardIndexFilePathFromIndex'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( SRCH_FORWARD_FILE_VALID(uiFileID) == false ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiFileID' parameter passed to 'iSrchFilePathsGetForwardIndexFilePathFromIndex'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( pucFilePath == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucFilePath' parameter passed to 'iSrchFilePathsGetForwardIndexFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( uiFilePathLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'uiFilePathLength' parameter passed to 'iSrchFilePathsGetForwardIndexFilePathFromIndex'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Select the file name for the forward index file */
+    switch ( uiFileID ) {
+
+        case SRCH_FORWARD_FILE_INDEX_ID:
+            pucFileName = SRCH_FILE_PATHS_FORWARD_INDEX_FILENAME;
+            break;
+
+        case SRCH_FORWARD_FILE_DATA_ID:
+            pucFileName = SRCH_FILE_PATHS_FORWARD_DATA_FILENAME;
+            break;
+    }
+
+
+    /* Get and return the forward index file path */
+    return (iSrchFilePathsGetFilePathFromIndexPath(psiSrchIndex->pucIndexPath, pucFileName, pucFilePath, uiFilePathLength));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchFilePathsGetDocumentDataFilePathFromIndex()
@@ -66,6 +66,9 @@ int iSrchFilePathsGetTempKeyDictionaryFilePathFromIndex (struct srchIndex *psiSr
         unsigned int uiVersion, boolean bShadowFile, unsigned char *pucFilePath,
         unsigned int uiFilePathLength);
 
+int iSrchFilePathsGetTempForwardIndexFilePathFromIndex (struct srchIndex *psiSrchIndex,
+        unsigned char *pucFilePath, unsigned int uiFilePathLength);
+
 
 
 int iSrchFilePathsGetTermDictionaryFilePathFromIndex (struct srchIndex *psiSrchIndex,
@@ -80,6 +83,27 @@ int iSrchFilePathsGetDocumentTableFilePathFromIndex (struct srchIndex *psiSrchIn
 int iSrchFilePathsGetDocumentDataFilePathFromIndex (struct srchIndex *psiSrchIndex,
         unsigned char *pucFilePath, unsigned int uiFilePathLength);
 
+int iSrchFilePathsGetDocumentColumnFilePathFromIndex (struct srchIndex *psiSrchIndex,
+        unsigned int uiColumnID, unsigned char *pucFilePath, unsigned int uiFilePathLength);
+
+int iSrchFilePathsGetDocumentDateIndexFilePathFromIndex (struct srchIndex *psiSrchIndex,
+        unsigned char *pucFilePath, unsigned int uiFilePathLength);
+
+int iSrchFilePathsGetTermFilterFilePathFromIndex (struct srchIndex *psiSrchIndex,
+        unsigned char *pucFilePath, unsigned int uiFilePathLength);
+
+int iSrchFilePathsGetTermIDsFilePathFromIndex (struct srchIndex *psiSrchIndex,
+        unsigned int uiFileID, unsigned char *pucFilePath, unsigned int uiFilePathLength);
+
+int iSrchFilePathsGetTermGramsFilePathFromIndex (struct srchIndex *psiSrchIndex,
+        unsigned char *pucFilePath, unsigned int uiFilePathLength);
+
+int iSrchFilePathsGetPhoneticKeysFilePathFromIndex (struct srchIndex *psiSrchIndex,
+        unsigned int uiTermMatch, unsigned char *pucFilePath, unsigned int uiFilePathLength);
+
+int iSrchFilePathsGetForwardIndexFilePathFromIndex (struct srchIndex *psiSrchIndex,
+        unsigned int uiFileID, unsigned char *pucFilePath, unsigned int uiFilePathLength);
+
 int iSrchFilePathsGetIndexDataFilePathFromIndex (struct srchIndex *psiSrchIndex,
         unsigned char *pucFilePath, unsigned int uiFilePathLength);
 
@@ -189,7 +189,7 @@ int iSrchFilterGetSearchBitmapFromFilters
 
         /* Not getting a bitmap means that none of the terms were found, so we allocate an empty bitmap */
         if ( psbSrchBitmap == NULL ) {
-            if ( (iError = iSrchBitmapCreate(NULL, psiSrchIndex->uiDocumentCount + 1, false, &psbSrchBitmap)) != SRCH_NoError ) {
+            if ( (iError = iSrchBitmapCreateRoaring(NULL, psiSrchIndex->uiDocumentCount + 1, &psbSrchBitmap)) != SRCH_NoError ) {
                 iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a new search bitmap, srch error: %d.", iError);
                 goto bailFromiSrchFilterGetSearchBitmapFromFilters;
             }
@@ -227,7 +227,7 @@ int iSrchFilterGetSearchBitmapFromFilters
 
     /* Not getting a bitmap means that none of the terms were found, so we allocate an empty bitmap */
     if ( (iError == SRCH_NoError) && (*ppsbSrchBitmap == NULL) ) {
-        if ( (iError = iSrchBitmapCreate(NULL, psiSrchIndex->uiDocumentCount + 1, false, ppsbSrchBitmap)) != SRCH_NoError ) {
+        if ( (iError = iSrchBitmapCreateRoaring(NULL, psiSrchIndex->uiDocumentCount + 1, ppsbSrchBitmap)) != SRCH_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a new search bitmap, srch error: %d.", iError);
             goto bailFromiSrchFilterGetSearchBitmapFromFilters;
         }
@@ -542,10 +542,10 @@ static int iSrchFilterGetSearchBitmapFromFilter
                         goto bailFromiSrchFilterGetSearchBitmapFromFilter;
                     }
 
-                    /* Search to postings list */
+                    /* Search to postings list, we need the term positions to match the phrase */
                     iError = iSrchTermSearchGetSearchPostingsListFromTerm(pssSrchSearch, psiSrchIndex, pucSubTerm, SRCH_SEARCH_TERM_WEIGHT_DEFAULT, 
                             (bFieldIDBitmapSet == true) ? pucFieldIDBitmap : NULL, (bFieldIDBitmapSet == true) ? psiSrchIndex->uiFieldIDMaximum : 0, 
-                            0, 0, 0, &psplSrchPostingsTempList);
+                            0, 0, 0, true, false, false, &psplSrchPostingsTempList);
 
                     /* Free the subterm */
                     s_free(pucSubTerm);
@@ -591,31 +591,31 @@ static int iSrchFilterGetSearchBitmapFromFilter
                 struct srchPosting      *pspSrchPostingsPtr = NULL;
                 struct srchPosting      *pspSrchPostingsEnd = NULL;
                 unsigned int            uiLastDocumentID = 0;
-                
-                unsigned char           *pucBitmapPtr = NULL;
 
                 /* We only process the search postings list structure if there is something in it */
                 if ( psplSrchPostingsList->uiSrchPostingsLength > 0 ) {
                 
                     /* Allocate the search bitmap structure if it has not yet been allocated */
                     if ( *ppsbSrchBitmap == NULL ) {
-                        if ( (iError = iSrchBitmapCreate(NULL, psiSrchIndex->uiDocumentCount + 1, false, ppsbSrchBitmap)) != SRCH_NoError ) {
+                        if ( (iError = iSrchBitmapCreateRoaring(NULL, psiSrchIndex->uiDocumentCount + 1, ppsbSrchBitmap)) != SRCH_NoError ) {
                             iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a new search bitmap, srch error: %d.", iError);
                             goto bailFromiSrchFilterGetSearchBitmapFromFilter;
                         }
                     }
     
     
-                    /* Dereference the bitmap array */
-                    pucBitmapPtr = (*ppsbSrchBitmap)->pucBitmap;
-                
                     /* Set the bitmap for these documents  */
                     for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pspSrchPostingsEnd = psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength; 
                             pspSrchPostingsPtr < pspSrchPostingsEnd; pspSrchPostingsPtr++ ) {
                         
                         /* Set the document in the bitmap if it has not already been set */
                         if ( pspSrchPostingsPtr->uiDocumentID != uiLastDocumentID ) {
-                            UTL_BITMAP_SET_BIT_IN_POINTER(pucBitmapPtr, pspSrchPostingsPtr->uiDocumentID);
+                            SRCH_BITMAP_SET_BIT(*ppsbSrchBitmap, pspSrchPostingsPtr->uiDocumentID, iError);
+                            if ( iError != SRCH_NoError ) {
+                                iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
+                                psplSrchPostingsList = NULL;
+                                goto bailFromiSrchFilterGetSearchBitmapFromFilter;
+                            }
                             uiLastDocumentID = pspSrchPostingsPtr->uiDocumentID;
                         }
                     }
@@ -0,0 +1,1143 @@
+/*****************************************************************************
+*       Copyright (C) 1993-2011, FS Consulting LLC. All rights reserved      *
+*                                                                            *
+*  This notice is intended as a precaution against inadvertent publication   *
+*  and does not constitute an admission or acknowledgement that publication  *
+*  has occurred or constitute a waiver of confidentiality.                   *
+*                                                                            *
+*  This software is the proprietary and confidential property                *
+*  of FS Consulting LLC.                                                     *
+*****************************************************************************/
+
+
+/*
+
+    Module:     forward.c
+
+    Author:     Francois Schiettecatte (FS Consulting LLC.)
+
+    Created:    17 October 2026
+
+    Purpose:    This module manages the forward index, which maps each
+                document to its term vector, the list of term IDs which
+                occur in the document along with their counts.
+
+                The forward index is built from the index blocks during the
+                final merge. Terms are identified by their term dictionary 
+                term ID, and an entry is written to a temporary file for 
+                every document the term occurs in. When the index is closed the entries are
+                grouped by document, in as many passes as the indexer memory
+                size requires, and the term vectors are written out.
+
+                Term vectors are stored as pairs of compressed numbers, the
+                delta term ID and the term count, term IDs being ascending
+                within a document.
+
+*/
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#include "srch.h"
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Feature defines
+*/
+
+/* Context for logging */
+#undef UTL_LOG_CONTEXT
+#define UTL_LOG_CONTEXT                     (unsigned char *)"com.fsconsult.mps.src.search.forward"
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Defines
+*/
+
+/* Number of entries read from the entries file at a time */
+#define SRCH_FORWARD_ENTRIES_READ_LENGTH                (4096)
+
+/* Minimum number of entries grouped in a pass when creating the forward index */
+#define SRCH_FORWARD_ENTRIES_MINIMUM                    (65536)
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Structures
+*/
+
+/* Forward index entry structure, these are written to the entries file */
+struct srchForwardEntry {
+    unsigned int    uiDocumentID;               /* Document ID */
+    unsigned int    uiTermID;                   /* Term ID */
+    unsigned int    uiTermCount;                /* Number of occurrences of the term in the document */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Private function prototypes
+*/
+
+static int iSrchForwardCreateBuild (struct srchIndex *psiSrchIndex);
+
+static int iSrchForwardFreeBuild (struct srchIndex *psiSrchIndex);
+
+static int iSrchForwardWriteEntry (struct srchForwardBuild *psfbSrchForwardBuild,
+        unsigned int uiDocumentID, unsigned int uiTermID, unsigned int uiTermCount);
+
+static int iSrchForwardWriteTermVectors (struct srchIndex *psiSrchIndex, FILE *pfIndexFile, FILE *pfDataFile);
+
+static int iSrchForwardMapFile (struct srchIndex *psiSrchIndex, unsigned int uiFileID,
+        void **ppvFile, size_t *pzFileLength);
+
+static void vSrchForwardRemoveFiles (struct srchIndex *psiSrchIndex);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardAddTerm()
+
+    Purpose:    This function adds a term to the forward index being created,
+                writing an entry for each document it occurs in.
+
+                Terms must be added in ascending term ID order.
+
+    Parameters: psiSrchIndex                search index structure
+                uiTermID                    term ID
+                pucIndexBlockData           compressed index block data
+                uiIndexBlockDataLength      compressed index block data length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchForwardAddTerm
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiTermID,
+    unsigned char *pucIndexBlockData,
+    unsigned int uiIndexBlockDataLength
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchForwardBuild     *psfbSrchForwardBuild = NULL;
+    unsigned char               *pucIndexBlockDataPtr = NULL;
+    unsigned char               *pucIndexBlockDataEndPtr = NULL;
+    unsigned int                uiIndexEntryDocumentID = 0;
+    unsigned int                uiIndexEntryDeltaDocumentID = 0;
+    unsigned int                uiTermCount = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchForwardAddTerm'.");
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( psiSrchIndex->psibSrchIndexBuild == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex->psibSrchIndexBuild' parameter passed to 'iSrchForwardAddTerm'.");
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( uiTermID == SRCH_TERMDICT_TERM_ID_INVALID ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiTermID' parameter passed to 'iSrchForwardAddTerm'.");
+        return (SRCH_ParameterError);
+    }
+
+    if ( pucIndexBlockData == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucIndexBlockData' parameter passed to 'iSrchForwardAddTerm'.");
+        return (SRCH_ParameterError);
+    }
+
+    if ( uiIndexBlockDataLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiIndexBlockDataLength' parameter passed to 'iSrchForwardAddTerm'.");
+        return (SRCH_ParameterError);
+    }
+
+
+    /* Create the forward index build structure if this is the first term */
+    if ( psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild == NULL ) {
+        if ( (iError = iSrchForwardCreateBuild(psiSrchIndex)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+    /* Dereference the forward index build structure for convenience */
+    psfbSrchForwardBuild = psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild;
+
+
+    /* Loop over the index entries, counting the entries in each document and writing
+    ** an entry when we get to a new document, there is one index entry per occurrence
+    */
+    for ( pucIndexBlockDataPtr = pucIndexBlockData, pucIndexBlockDataEndPtr = pucIndexBlockData + uiIndexBlockDataLength;
+            pucIndexBlockDataPtr < pucIndexBlockDataEndPtr; ) {
+
+        /* Read the index entry, we only need the document ID */
+        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockDataPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockDataPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockDataPtr);
+
+        /* Write the entry for the previous document if this is a new document */
+        if ( uiIndexEntryDeltaDocumentID != 0 ) {
+
+            if ( uiTermCount > 0 ) {
+                if ( (iError = iSrchForwardWriteEntry(psfbSrchForwardBuild, uiIndexEntryDocumentID, uiTermID, uiTermCount)) != SRCH_NoError ) {
+                    return (iError);
+                }
+            }
+
+            uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
+            uiTermCount = 0;
+        }
+
+        uiTermCount++;
+    }
+
+    /* Write the entry for the last document */
+    if ( uiTermCount > 0 ) {
+        if ( (iError = iSrchForwardWriteEntry(psfbSrchForwardBuild, uiIndexEntryDocumentID, uiTermID, uiTermCount)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardCreateIndex()
+
+    Purpose:    This function creates the forward index from the entries
+                written while the terms were added, it must be called after
+                the final merge. The forward index build structure is
+                released, and the forward index files are removed if the
+                forward index could not be created.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchForwardCreateIndex
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int                         iError = SRCH_NoError;
+    unsigned char               pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    FILE                        *pfIndexFile = NULL;
+    FILE                        *pfDataFile = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchForwardCreateIndex'.");
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Nothing to do if no terms were added to the forward index */
+    if ( (psiSrchIndex->psibSrchIndexBuild == NULL) || (psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild == NULL) ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Create the index file */
+    if ( (iError = iSrchFilePathsGetForwardIndexFilePathFromIndex(psiSrchIndex, SRCH_FORWARD_FILE_INDEX_ID, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index index file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchForwardCreateIndex;
+    }
+
+    if ( (pfIndexFile = s_fopen(pucFilePath, "w")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index index file: '%s'.", pucFilePath);
+        iError = SRCH_ForwardCreateIndexFailed;
+        goto bailFromiSrchForwardCreateIndex;
+    }
+
+    /* Create the data file */
+    if ( (iError = iSrchFilePathsGetForwardIndexFilePathFromIndex(psiSrchIndex, SRCH_FORWARD_FILE_DATA_ID, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index data file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchForwardCreateIndex;
+    }
+
+    if ( (pfDataFile = s_fopen(pucFilePath, "w")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index data file: '%s'.", pucFilePath);
+        iError = SRCH_ForwardCreateIndexFailed;
+        goto bailFromiSrchForwardCreateIndex;
+    }
+
+
+    /* Write the term vectors */
+    if ( (iError = iSrchForwardWriteTermVectors(psiSrchIndex, pfIndexFile, pfDataFile)) != SRCH_NoError ) {
+        goto bailFromiSrchForwardCreateIndex;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchForwardCreateIndex:
+
+
+    /* Close the index file and the data file */
+    if ( pfIndexFile != NULL ) {
+        s_fclose(pfIndexFile);
+    }
+
+    if ( pfDataFile != NULL ) {
+        s_fclose(pfDataFile);
+    }
+
+    /* Free the forward index build structure, this removes the entries file */
+    iSrchForwardFreeBuild(psiSrchIndex);
+
+    /* Remove the forward index files if we failed to create the forward index, it will not be used */
+    if ( iError != SRCH_NoError ) {
+        vSrchForwardRemoveFiles(psiSrchIndex);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardOpenIndex()
+
+    Purpose:    This function opens the forward index, mapping in its files.
+
+                The forward index is optional so we just go without it if
+                the index was not created with one, or if its files are
+                missing or do not cover all the documents. It also needs
+                the term ID table to map its term IDs back to terms, so it
+                must be opened after the term ID table.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchForwardOpenIndex
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchForward      *psfSrchForward = NULL;
+    boolean                 bValid = false;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchForwardOpenIndex'.");
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Nothing to open if the index was not created with a forward index */
+    if ( !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_FORWARD_INDEX) || (psiSrchIndex->uiDocumentCount == 0) ) {
+        return (SRCH_NoError);
+    }
+
+    /* The term IDs in the forward index are useless without the term ID table */
+    if ( psiSrchIndex->pstdtiSrchTermDictTermIDs == NULL ) {
+        iUtlLogWarn(UTL_LOG_CONTEXT, "Missing term ID table, ignoring the forward index, index: '%s'.", psiSrchIndex->pucIndexName);
+        return (SRCH_NoError);
+    }
+
+
+    /* Allocate the forward index structure */
+    if ( (psfSrchForward = (struct srchForward *)s_malloc((size_t)sizeof(struct srchForward))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+
+    /* Map in the files */
+    if ( (iError = iSrchForwardMapFile(psiSrchIndex, SRCH_FORWARD_FILE_INDEX_ID, (void **)&psfSrchForward->pulDocumentOffsets,
+            &psfSrchForward->zDocumentOffsetsLength)) != SRCH_NoError ) {
+        goto bailFromiSrchForwardOpenIndex;
+    }
+
+    if ( (iError = iSrchForwardMapFile(psiSrchIndex, SRCH_FORWARD_FILE_DATA_ID, (void **)&psfSrchForward->pucData,
+            &psfSrchForward->zDataLength)) != SRCH_NoError ) {
+        goto bailFromiSrchForwardOpenIndex;
+    }
+
+
+    /* Check that all the files are there and that they cover all the documents, the
+    ** document offsets have an entry for document ID 0 and an entry for the end of the data
+    */
+    if ( (psfSrchForward->pulDocumentOffsets != NULL) && (psfSrchForward->pucData != NULL) &&
+            (psfSrchForward->zDocumentOffsetsLength == (size_t)(sizeof(unsigned long) * (psiSrchIndex->uiDocumentCount + 2))) &&
+            (psfSrchForward->pulDocumentOffsets[psiSrchIndex->uiDocumentCount + 1] == (unsigned long)psfSrchForward->zDataLength) ) {
+        bValid = true;
+    }
+    else {
+        iUtlLogWarn(UTL_LOG_CONTEXT, "Missing or invalid forward index files, ignoring the forward index, index: '%s'.", psiSrchIndex->pucIndexName);
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchForwardOpenIndex:
+
+
+    /* Handle the error, we only use the forward index if all of it was mapped in */
+    if ( (iError == SRCH_NoError) && (bValid == true) ) {
+        psiSrchIndex->psfSrchForward = psfSrchForward;
+    }
+    else {
+        if ( psfSrchForward->pulDocumentOffsets != NULL ) {
+            iUtlFileMemoryUnMap(psfSrchForward->pulDocumentOffsets, psfSrchForward->zDocumentOffsetsLength);
+        }
+        if ( psfSrchForward->pucData != NULL ) {
+            iUtlFileMemoryUnMap(psfSrchForward->pucData, psfSrchForward->zDataLength);
+        }
+        s_free(psfSrchForward);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardCloseIndex()
+
+    Purpose:    This function closes the forward index, unmapping its files,
+                and releasing the forward index build structure if the
+                forward index was not created.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchForwardCloseIndex
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    struct srchForward      *psfSrchForward = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchForwardCloseIndex'.");
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Free the forward index build structure, it will only still be there if the forward index was not created */
+    if ( (psiSrchIndex->psibSrchIndexBuild != NULL) && (psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild != NULL) ) {
+        iSrchForwardFreeBuild(psiSrchIndex);
+        vSrchForwardRemoveFiles(psiSrchIndex);
+    }
+
+
+    /* Unmap the forward index */
+    if ( psiSrchIndex->psfSrchForward != NULL ) {
+
+        psfSrchForward = psiSrchIndex->psfSrchForward;
+
+        iUtlFileMemoryUnMap(psfSrchForward->pulDocumentOffsets, psfSrchForward->zDocumentOffsetsLength);
+        iUtlFileMemoryUnMap(psfSrchForward->pucData, psfSrchForward->zDataLength);
+
+        s_free(psiSrchIndex->psfSrchForward);
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardGetDocumentTermVector()
+
+    Purpose:    This function returns the term vector for a document, the
+                terms are in ascending term ID order, the terms themselves
+                can be looked up with iSrchTermDictLookupTermID().
+
+                The term vector is allocated and needs to be released by
+                the caller, it is NULL if the document has no terms.
+
+    Parameters: psiSrchIndex                search index structure
+                uiDocumentID                document ID
+                ppsftSrchForwardTerms       return pointer for the forward term structure array
+                puiSrchForwardTermsLength   return pointer for the forward term structure array length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchForwardGetDocumentTermVector
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiDocumentID,
+    struct srchForwardTerm **ppsftSrchForwardTerms,
+    unsigned int *puiSrchForwardTermsLength
+)
+{
+
+    struct srchForward          *psfSrchForward = NULL;
+    unsigned char               *pucDataPtr = NULL;
+    unsigned char               *pucDataEndPtr = NULL;
+    struct srchForwardTerm      *psftSrchForwardTerms = NULL;
+    unsigned int                uiSrchForwardTermsLength = 0;
+    unsigned int                uiDeltaTermID = 0;
+    unsigned int                uiTermID = 0;
+    unsigned int                uiTermCount = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchForwardGetDocumentTermVector'.");
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( psiSrchIndex->psfSrchForward == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Missing forward index in the 'psiSrchIndex' parameter passed to 'iSrchForwardGetDocumentTermVector'.");
+        return (SRCH_ForwardMissingIndex);
+    }
+
+    if ( (uiDocumentID <= 0) || (uiDocumentID > psiSrchIndex->uiDocumentCount) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiDocumentID' parameter passed to 'iSrchForwardGetDocumentTermVector'.");
+        return (SRCH_ForwardInvalidDocumentID);
+    }
+
+    if ( ppsftSrchForwardTerms == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppsftSrchForwardTerms' parameter passed to 'iSrchForwardGetDocumentTermVector'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiSrchForwardTermsLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiSrchForwardTermsLength' parameter passed to 'iSrchForwardGetDocumentTermVector'.");
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Dereference the forward index structure for convenience */
+    psfSrchForward = psiSrchIndex->psfSrchForward;
+
+    /* Get the term vector for the document */
+    pucDataPtr = psfSrchForward->pucData + psfSrchForward->pulDocumentOffsets[uiDocumentID];
+    pucDataEndPtr = psfSrchForward->pucData + psfSrchForward->pulDocumentOffsets[uiDocumentID + 1];
+
+
+    /* Allocate the forward term structure array, each entry takes at least two bytes */
+    if ( pucDataEndPtr > pucDataPtr ) {
+        if ( (psftSrchForwardTerms = (struct srchForwardTerm *)s_malloc((size_t)(sizeof(struct srchForwardTerm) * ((pucDataEndPtr - pucDataPtr) / 2)))) == NULL ) {
+            return (SRCH_MemError);
+        }
+    }
+
+    /* Decode the term vector */
+    while ( pucDataPtr < pucDataEndPtr ) {
+
+        UTL_NUM_READ_COMPRESSED_UINT(uiDeltaTermID, pucDataPtr);
+        UTL_NUM_READ_COMPRESSED_UINT(uiTermCount, pucDataPtr);
+
+        uiTermID += uiDeltaTermID;
+
+        psftSrchForwardTerms[uiSrchForwardTermsLength].uiTermID = uiTermID;
+        psftSrchForwardTerms[uiSrchForwardTermsLength].uiTermCount = uiTermCount;
+        uiSrchForwardTermsLength++;
+    }
+
+
+    /* Set the return pointers */
+    *ppsftSrchForwardTerms = psftSrchForwardTerms;
+    *puiSrchForwardTermsLength = uiSrchForwardTermsLength;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardCreateBuild()
+
+    Purpose:    This function creates the forward index build structure and
+                creates the entries file.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchForwardCreateBuild
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchForwardBuild     *psfbSrchForwardBuild = NULL;
+    unsigned char               pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild == NULL);
+
+
+    /* Allocate the forward index build structure */
+    if ( (psfbSrchForwardBuild = (struct srchForwardBuild *)s_malloc((size_t)sizeof(struct srchForwardBuild))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+    /* Hand it over to the index build structure now so it gets released along with its files if we fail */
+    psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild = psfbSrchForwardBuild;
+
+
+    /* Create the entries file, it gets read back when the forward index is created */
+    if ( (iError = iSrchFilePathsGetTempForwardIndexFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index entries file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchForwardCreateBuild;
+    }
+
+    if ( (psfbSrchForwardBuild->pfEntriesFile = s_fopen(pucFilePath, "w+")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index entries file: '%s'.", pucFilePath);
+        iError = SRCH_ForwardAddTermFailed;
+        goto bailFromiSrchForwardCreateBuild;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchForwardCreateBuild:
+
+
+    /* Handle the error */
+    if ( iError != SRCH_NoError ) {
+        iSrchForwardFreeBuild(psiSrchIndex);
+        vSrchForwardRemoveFiles(psiSrchIndex);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardFreeBuild()
+
+    Purpose:    This function frees the forward index build structure, closing
+                and removing the entries file.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchForwardFreeBuild
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    struct srchForwardBuild     *psfbSrchForwardBuild = NULL;
+    unsigned char               pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild != NULL);
+
+
+    /* Dereference the forward index build structure for convenience */
+    if ( (psfbSrchForwardBuild = psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild) == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Close the entries file */
+    if ( psfbSrchForwardBuild->pfEntriesFile != NULL ) {
+        s_fclose(psfbSrchForwardBuild->pfEntriesFile);
+    }
+
+    /* Remove the entries file */
+    if ( iSrchFilePathsGetTempForwardIndexFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1) == SRCH_NoError ) {
+        s_remove(pucFilePath);
+    }
+
+
+    /* Free the forward index build structure */
+    s_free(psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild);
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardWriteEntry()
+
+    Purpose:    This function writes an entry to the entries file.
+
+    Parameters: psfbSrchForwardBuild    forward index build structure
+                uiDocumentID            document ID
+                uiTermID                term ID
+                uiTermCount             term count
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchForwardWriteEntry
+(
+    struct srchForwardBuild *psfbSrchForwardBuild,
+    unsigned int uiDocumentID,
+    unsigned int uiTermID,
+    unsigned int uiTermCount
+)
+{
+
+    struct srchForwardEntry     sfeSrchForwardEntry;
+
+
+    ASSERT(psfbSrchForwardBuild != NULL);
+    ASSERT(psfbSrchForwardBuild->pfEntriesFile != NULL);
+    ASSERT(uiDocumentID > 0);
+    ASSERT(uiTermID > 0);
+    ASSERT(uiTermCount > 0);
+
+
+    /* Set the entry */
+    sfeSrchForwardEntry.uiDocumentID = uiDocumentID;
+    sfeSrchForwardEntry.uiTermID = uiTermID;
+    sfeSrchForwardEntry.uiTermCount = uiTermCount;
+
+    /* Write the entry */
+    if ( s_fwrite(&sfeSrchForwardEntry, sizeof(struct srchForwardEntry), 1, psfbSrchForwardBuild->pfEntriesFile) != 1 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the forward index entries file.");
+        return (SRCH_ForwardAddTermFailed);
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardWriteTermVectors()
+
+    Purpose:    This function groups the entries in the entries file by
+                document and writes out the document term vectors to the
+                data file and their offsets to the index file.
+
+                The documents are processed in runs whose entries fit in
+                the indexer memory size, reading the entries file once per
+                run, entries for a document are in ascending term ID order
+                since terms were added in that order.
+
+    Parameters: psiSrchIndex    search index structure
+                pfIndexFile     index file
+                pfDataFile      data file
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchForwardWriteTermVectors
+(
+    struct srchIndex *psiSrchIndex,
+    FILE *pfIndexFile,
+    FILE *pfDataFile
+)
+{
+
+    int                         iError = SRCH_NoError;
+    FILE                        *pfEntriesFile = NULL;
+    unsigned int                uiDocumentCount = 0;
+    unsigned int                *puiDocumentEntryCounts = NULL;
+    unsigned int                *puiDocumentEntryIndices = NULL;
+    struct srchForwardEntry     *psfeSrchForwardEntries = NULL;
+    size_t                      zSrchForwardEntriesLength = 0;
+    struct srchForwardTerm      *psftSrchForwardTerms = NULL;
+    unsigned int                uiSrchForwardTermsCapacity = 0;
+    unsigned char               *pucData = NULL;
+    unsigned char               *pucDataPtr = NULL;
+    unsigned long               ulDataLength = 0;
+    unsigned long               ulEntriesMaximum = 0;
+    unsigned int                uiStartDocumentID = 0;
+    unsigned int                uiEndDocumentID = 0;
+    unsigned int                uiDocumentID = 0;
+    unsigned long               ulEntriesLength = 0;
+    unsigned int                uiI = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild != NULL);
+    ASSERT(pfIndexFile != NULL);
+    ASSERT(pfDataFile != NULL);
+
+
+    /* Dereference the entries file and the document count for convenience */
+    pfEntriesFile = psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild->pfEntriesFile;
+    uiDocumentCount = psiSrchIndex->uiDocumentCount;
+
+
+    /* Allocate the document entry counts and indices, document IDs start at 1 */
+    if ( (puiDocumentEntryCounts = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * (uiDocumentCount + 1)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchForwardWriteTermVectors;
+    }
+
+    if ( (puiDocumentEntryIndices = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * (uiDocumentCount + 1)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchForwardWriteTermVectors;
+    }
+
+    /* Allocate the entries read buffer */
+    if ( (psfeSrchForwardEntries = (struct srchForwardEntry *)s_malloc((size_t)(sizeof(struct srchForwardEntry) * SRCH_FORWARD_ENTRIES_READ_LENGTH))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchForwardWriteTermVectors;
+    }
+
+
+    /* Count the entries for each document */
+    s_fseek(pfEntriesFile, 0, SEEK_SET);
+    while ( (zSrchForwardEntriesLength = s_fread(psfeSrchForwardEntries, sizeof(struct srchForwardEntry), SRCH_FORWARD_ENTRIES_READ_LENGTH, pfEntriesFile)) > 0 ) {
+        for ( uiI = 0; uiI < zSrchForwardEntriesLength; uiI++ ) {
+            if ( (psfeSrchForwardEntries[uiI].uiDocumentID <= 0) || (psfeSrchForwardEntries[uiI].uiDocumentID > uiDocumentCount) ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Invalid document ID: %u, in the forward index entries file.", psfeSrchForwardEntries[uiI].uiDocumentID);
+                iError = SRCH_ForwardCreateIndexFailed;
+                goto bailFromiSrchForwardWriteTermVectors;
+            }
+            puiDocumentEntryCounts[psfeSrchForwardEntries[uiI].uiDocumentID]++;
+        }
+    }
+
+
+    /* Work out the number of entries we can group in a run, each entry takes a term structure
+    ** and up to two compressed numbers
+    */
+    ulEntriesMaximum = ((unsigned long)psiSrchIndex->psibSrchIndexBuild->uiIndexerMemorySizeMaximum * 1024 * 1024) /
+            (sizeof(struct srchForwardTerm) + (UTL_NUM_COMPRESSED_UINT_MAX_SIZE * 2));
+    ulEntriesMaximum = UTL_MACROS_MAX(ulEntriesMaximum, SRCH_FORWARD_ENTRIES_MINIMUM);
+
+
+    /* Write the offsets for document ID 0, which is not used */
+    if ( (s_fwrite(&ulDataLength, sizeof(unsigned long), 1, pfIndexFile) != 1) || (s_fwrite(&ulDataLength, sizeof(unsigned long), 1, pfIndexFile) != 1) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the forward index index file.");
+        iError = SRCH_ForwardCreateIndexFailed;
+        goto bailFromiSrchForwardWriteTermVectors;
+    }
+
+
+    /* Loop over the runs of documents */
+    for ( uiStartDocumentID = 1; uiStartDocumentID <= uiDocumentCount; uiStartDocumentID = uiEndDocumentID ) {
+
+        /* Work out the end of the run, a run has at least one document */
+        for ( uiEndDocumentID = uiStartDocumentID, ulEntriesLength = 0; uiEndDocumentID <= uiDocumentCount; uiEndDocumentID++ ) {
+            if ( ((ulEntriesLength + puiDocumentEntryCounts[uiEndDocumentID]) > ulEntriesMaximum) && (uiEndDocumentID > uiStartDocumentID) ) {
+                break;
+            }
+            puiDocumentEntryIndices[uiEndDocumentID] = (unsigned int)ulEntriesLength;
+            ulEntriesLength += puiDocumentEntryCounts[uiEndDocumentID];
+        }
+
+        /* Extend the term structures and the data buffer if needed */
+        if ( ulEntriesLength > uiSrchForwardTermsCapacity ) {
+
+            struct srchForwardTerm      *psftSrchForwardTermsPtr = NULL;
+            unsigned char               *pucDataNew = NULL;
+
+            if ( (psftSrchForwardTermsPtr = (struct srchForwardTerm *)s_realloc(psftSrchForwardTerms, (size_t)(sizeof(struct srchForwardTerm) * ulEntriesLength))) == NULL ) {
+                iError = SRCH_MemError;
+                goto bailFromiSrchForwardWriteTermVectors;
+            }
+            psftSrchForwardTerms = psftSrchForwardTermsPtr;
+
+            if ( (pucDataNew = (unsigned char *)s_realloc(pucData, (size_t)(sizeof(unsigned char) * ulEntriesLength * UTL_NUM_COMPRESSED_UINT_MAX_SIZE * 2))) == NULL ) {
+                iError = SRCH_MemError;
+                goto bailFromiSrchForwardWriteTermVectors;
+            }
+            pucData = pucDataNew;
+
+            uiSrchForwardTermsCapacity = (unsigned int)ulEntriesLength;
+        }
+
+
+        /* Read the entries file, placing the entries for the documents in the run */
+        s_fseek(pfEntriesFile, 0, SEEK_SET);
+        while ( (zSrchForwardEntriesLength = s_fread(psfeSrchForwardEntries, sizeof(struct srchForwardEntry), SRCH_FORWARD_ENTRIES_READ_LENGTH, pfEntriesFile)) > 0 ) {
+            for ( uiI = 0; uiI < zSrchForwardEntriesLength; uiI++ ) {
+
+                uiDocumentID = psfeSrchForwardEntries[uiI].uiDocumentID;
+
+                if ( (uiDocumentID >= uiStartDocumentID) && (uiDocumentID < uiEndDocumentID) ) {
+                    psftSrchForwardTerms[puiDocumentEntryIndices[uiDocumentID]].uiTermID = psfeSrchForwardEntries[uiI].uiTermID;
+                    psftSrchForwardTerms[puiDocumentEntryIndices[uiDocumentID]].uiTermCount = psfeSrchForwardEntries[uiI].uiTermCount;
+                    puiDocumentEntryIndices[uiDocumentID]++;
+                }
+            }
+        }
+
+
+        /* Encode the term vectors for the documents in the run, the entry indices now point to the end of each document */
+        for ( uiDocumentID = uiStartDocumentID, pucDataPtr = pucData; uiDocumentID < uiEndDocumentID; uiDocumentID++ ) {
+
+            unsigned int    uiPreviousTermID = 0;
+            unsigned long   ulDocumentDataLength = 0;
+
+            for ( uiI = puiDocumentEntryIndices[uiDocumentID] - puiDocumentEntryCounts[uiDocumentID]; uiI < puiDocumentEntryIndices[uiDocumentID]; uiI++ ) {
+
+                ASSERT(psftSrchForwardTerms[uiI].uiTermID >= uiPreviousTermID);
+
+                UTL_NUM_WRITE_COMPRESSED_UINT(psftSrchForwardTerms[uiI].uiTermID - uiPreviousTermID, pucDataPtr);
+                UTL_NUM_WRITE_COMPRESSED_UINT(psftSrchForwardTerms[uiI].uiTermCount, pucDataPtr);
+                uiPreviousTermID = psftSrchForwardTerms[uiI].uiTermID;
+            }
+
+            /* Write the offset of the end of the term vector, which is also the offset of the start of the next one */
+            ulDocumentDataLength = ulDataLength + (unsigned long)(pucDataPtr - pucData);
+            if ( s_fwrite(&ulDocumentDataLength, sizeof(unsigned long), 1, pfIndexFile) != 1 ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the forward index index file.");
+                iError = SRCH_ForwardCreateIndexFailed;
+                goto bailFromiSrchForwardWriteTermVectors;
+            }
+        }
+
+        /* Write the term vectors */
+        if ( pucDataPtr > pucData ) {
+            if ( s_fwrite(pucData, pucDataPtr - pucData, 1, pfDataFile) != 1 ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the forward index data file.");
+                iError = SRCH_ForwardCreateIndexFailed;
+                goto bailFromiSrchForwardWriteTermVectors;
+            }
+            ulDataLength += (unsigned long)(pucDataPtr - pucData);
+        }
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchForwardWriteTermVectors:
+
+
+    /* Free the allocations */
+    s_free(puiDocumentEntryCounts);
+    s_free(puiDocumentEntryIndices);
+    s_free(psfeSrchForwardEntries);
+    s_free(psftSrchForwardTerms);
+    s_free(pucData);
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchForwardMapFile()
+
+    Purpose:    This function maps in a forward index file, the pointer is
+                left NULL if the file does not exist or is empty.
+
+    Parameters: psiSrchIndex    search index structure
+                uiFileID        forward index file ID
+                ppvFile         return pointer for the mapped file
+                pzFileLength    return pointer for the mapped file length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchForwardMapFile
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiFileID,
+    void **ppvFile,
+    size_t *pzFileLength
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    FILE            *pfFile = NULL;
+    off_t           zFileLength = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(SRCH_FORWARD_FILE_VALID(uiFileID) == true);
+    ASSERT(ppvFile != NULL);
+    ASSERT(pzFileLength != NULL);
+
+
+    /* Get the file path */
+    if ( (iError = iSrchFilePathsGetForwardIndexFilePathFromIndex(psiSrchIndex, uiFileID, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the forward index file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        return (iError);
+    }
+
+    /* Skip the file if it does not exist */
+    if ( bUtlFileIsFile(pucFilePath) == false ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Open the file */
+    if ( (pfFile = s_fopen(pucFilePath, "r")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the forward index file: '%s'.", pucFilePath);
+        return (SRCH_ForwardOpenIndexFailed);
+    }
+
+    /* Get the file length */
+    if ( (iError = iUtlFileGetFileLength(pfFile, &zFileLength)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the length of the forward index file: '%s', utl error: %d.", pucFilePath, iError);
+        iError = SRCH_ForwardOpenIndexFailed;
+        goto bailFromiSrchForwardMapFile;
+    }
+
+    /* Map in the file if it is not empty */
+    if ( zFileLength > 0 ) {
+        if ( (iError = iUtlFileMemoryMap(fileno(pfFile), 0, (size_t)zFileLength, PROT_READ, ppvFile)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to map in the forward index file: '%s', utl error: %d.", pucFilePath, iError);
+            iError = SRCH_ForwardOpenIndexFailed;
+            goto bailFromiSrchForwardMapFile;
+        }
+        *pzFileLength = (size_t)zFileLength;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchForwardMapFile:
+
+
+    /* Close the file, the mapping stays in place */
+    s_fclose(pfFile);
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vSrchForwardRemoveFiles()
+
+    Purpose:    This function removes the forward index files.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vSrchForwardRemoveFiles
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    unsigned int    uiFileID = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+
+
+    /* Remove the files */
+    for ( uiFileID = SRCH_FORWARD_FILE_INDEX_ID; SRCH_FORWARD_FILE_VALID(uiFileID) == true; uiFileID++ ) {
+        if ( iSrchFilePathsGetForwardIndexFilePathFromIndex(psiSrchIndex, uiFileID, pucFilePath, UTL_FILE_PATH_MAX + 1) == SRCH_NoError ) {
+            s_remove(pucFilePath);
+        }
+    }
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,137 @@
+/*****************************************************************************
+*       Copyright (C) 1993-2011, FS Consulting LLC. All rights reserved      *
+*                                                                            *
+*  This notice is intended as a precaution against inadvertent publication   *
+*  and does not constitute an admission or acknowledgement that publication  *
+*  has occurred or constitute a waiver of confidentiality.                   *
+*                                                                            *
+*  This software is the proprietary and confidential property                *
+*  of FS Consulting LLC.                                                     *
+*****************************************************************************/
+
+
+/*
+
+    Module:     forward.h
+
+    Author:     Francois Schiettecatte (FS Consulting LLC.)
+
+    Created:    17 October 2026
+
+    Purpose:    This is the header file for forward.c.
+
+*/
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if !defined(SRCH_FORWARD_H)
+#define SRCH_FORWARD_H
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#include "srch.h"
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** C++ wrapper
+*/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif    /* defined(__cplusplus) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Defines
+*/
+
+/* Forward index files */
+#define SRCH_FORWARD_FILE_INDEX_ID              (0)         /* Document offsets into the data file */
+#define SRCH_FORWARD_FILE_DATA_ID               (1)         /* Document term vectors */
+
+#define SRCH_FORWARD_FILE_VALID(n)              (((n) >= SRCH_FORWARD_FILE_INDEX_ID) && \
+                                                        ((n) <= SRCH_FORWARD_FILE_DATA_ID))
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Structures
+*/
+
+/* Forward index build structure, this is used while the index is being created */
+struct srchForwardBuild {
+    FILE                    *pfEntriesFile;             /* Temporary file for the (document ID, term ID, term count) entries */
+};
+
+
+/* Forward index structure, this is used while the index is being searched */
+struct srchForward {
+    unsigned long           *pulDocumentOffsets;        /* Document offsets into the data, indexed by document ID */
+    size_t                  zDocumentOffsetsLength;     /* Document offsets mapping length */
+    unsigned char           *pucData;                   /* Document term vectors */
+    size_t                  zDataLength;                /* Document term vectors mapping length */
+};
+
+
+/* Forward index term structure, an entry in a document term vector */
+struct srchForwardTerm {
+    unsigned int            uiTermID;                   /* Term ID, from the term dictionary */
+    unsigned int            uiTermCount;                /* Number of occurrences of the term in the document */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Public function prototypes
+*/
+
+int iSrchForwardAddTerm (struct srchIndex *psiSrchIndex, unsigned int uiTermID,
+        unsigned char *pucIndexBlockData, unsigned int uiIndexBlockDataLength);
+
+int iSrchForwardCreateIndex (struct srchIndex *psiSrchIndex);
+
+int iSrchForwardOpenIndex (struct srchIndex *psiSrchIndex);
+
+int iSrchForwardCloseIndex (struct srchIndex *psiSrchIndex);
+
+int iSrchForwardGetDocumentTermVector (struct srchIndex *psiSrchIndex, unsigned int uiDocumentID,
+        struct srchForwardTerm **ppsftSrchForwardTerms, unsigned int *puiSrchForwardTermsLength);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** C++ wrapper
+*/
+
+#if defined(__cplusplus)
+}
+#endif    /* defined(__cplusplus) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#endif    /* !defined(SRCH_FORWARD_H) */
+
+
+/*---------------------------------------------------------------------------*/
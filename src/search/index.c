@@ -184,6 +184,7 @@ int iSrchIndexOpen
     psiSrchIndex->uiMajorVersion = 0;
     psiSrchIndex->uiMinorVersion = 0;
     psiSrchIndex->uiPatchVersion = 0;
+    psiSrchIndex->uiIndexBlockFeatures = SRCH_INDEX_BLOCK_FEATURE_NONE;
     psiSrchIndex->pfLockFile = NULL;
     psiSrchIndex->uiIntent = 0;
     psiSrchIndex->uiLanguageID = 0;
@@ -195,6 +196,14 @@ int iSrchIndexOpen
     psiSrchIndex->pvUtlKeyDictionary = NULL;
     psiSrchIndex->pvUtlTermDictionary = NULL;
     psiSrchIndex->pvUtlIndexInformation = NULL;
+    psiSrchIndex->psdcSrchDocumentColumns = NULL;
+    psiSrchIndex->pstdfSrchTermDictFilter = NULL;
+    psiSrchIndex->pstdtiSrchTermDictTermIDs = NULL;
+    psiSrchIndex->pvUtlTermGramsDictionary = NULL;
+    psiSrchIndex->pvUtlSoundexKeysDictionary = NULL;
+    psiSrchIndex->pvUtlMetaphoneKeysDictionary = NULL;
+    psiSrchIndex->pvUtlPhonixKeysDictionary = NULL;
+    psiSrchIndex->psfSrchForward = NULL;
     psiSrchIndex->uiTermLengthMaximum = 0;
     psiSrchIndex->uiTermLengthMinimum = 0;
     psiSrchIndex->ulUniqueTermCount = 0;
@@ -205,6 +214,9 @@ int iSrchIndexOpen
     psiSrchIndex->uiDocumentTermCountMaximum = 0;
     psiSrchIndex->uiDocumentTermCountMinimum = 0;
     psiSrchIndex->uiFieldIDMaximum = 0;
+    psiSrchIndex->ulDocumentAnsiDateMaximum = ULONG_MAX;
+    psiSrchIndex->ulDocumentAnsiDateMinimum = 0;
+    psiSrchIndex->uiDocumentLanguageIDsLength = 0;
     psiSrchIndex->tLastUpdateTime = 0;
     psiSrchIndex->psibSrchIndexBuild = NULL;
 
@@ -321,6 +333,23 @@ int iSrchIndexOpen
         psiSrchIndex->psibSrchIndexBuild->pucFieldIDBitmap = NULL;
         psiSrchIndex->psibSrchIndexBuild->uiFieldIDBitmapLength = 0;
         psiSrchIndex->psibSrchIndexBuild->uiDuplicateDocumentKeysCount = 0;
+        psiSrchIndex->psibSrchIndexBuild->pulTermHashes = NULL;
+        psiSrchIndex->psibSrchIndexBuild->ulTermHashesLength = 0;
+        psiSrchIndex->psibSrchIndexBuild->ulTermHashesCapacity = 0;
+        psiSrchIndex->psibSrchIndexBuild->pfTermIDsDataFile = NULL;
+        psiSrchIndex->psibSrchIndexBuild->ulTermIDsDataLength = 0;
+        psiSrchIndex->psibSrchIndexBuild->pulTermIDOffsets = NULL;
+        psiSrchIndex->psibSrchIndexBuild->uiTermIDsLength = 0;
+        psiSrchIndex->psibSrchIndexBuild->uiTermIDsCapacity = 0;
+        psiSrchIndex->psibSrchIndexBuild->pvUtlTermGramsTrie = NULL;
+        psiSrchIndex->psibSrchIndexBuild->pvUtlSoundexKeysTrie = NULL;
+        psiSrchIndex->psibSrchIndexBuild->pvUtlMetaphoneKeysTrie = NULL;
+        psiSrchIndex->psibSrchIndexBuild->pvUtlPhonixKeysTrie = NULL;
+        psiSrchIndex->psibSrchIndexBuild->pvLngSoundex = NULL;
+        psiSrchIndex->psibSrchIndexBuild->pvLngMetaphone = NULL;
+        psiSrchIndex->psibSrchIndexBuild->pvLngPhonix = NULL;
+        psiSrchIndex->psibSrchIndexBuild->psfbSrchForwardBuild = NULL;
+        psiSrchIndex->psibSrchIndexBuild->puiDocumentTermCounts = NULL;
         psiSrchIndex->psibSrchIndexBuild->pvLngConverterUTF8ToWChar = NULL;
         psiSrchIndex->psibSrchIndexBuild->pvLngConverterWCharToUTF8 = NULL;
 
@@ -457,6 +486,9 @@ int iSrchIndexClose
         s_free(psiSrchIndex->psibSrchIndexBuild->pucIndexBlock);
         s_free(psiSrchIndex->psibSrchIndexBuild->pucFieldIDBitmap);
         s_free(psiSrchIndex->psibSrchIndexBuild->pucTemporaryDirectoryPath);
+        s_free(psiSrchIndex->psibSrchIndexBuild->pulTermHashes);
+        s_free(psiSrchIndex->psibSrchIndexBuild->pulTermIDOffsets);
+        s_free(psiSrchIndex->psibSrchIndexBuild->puiDocumentTermCounts);
 
         /* Close the character set converters */
         iLngConverterFree(psiSrchIndex->psibSrchIndexBuild->pvLngConverterUTF8ToWChar);
@@ -717,6 +749,13 @@ static int iSrchIndexFilesOpen
         }
     
     
+        /* Open the document columns, indices created before the document columns will not have them */
+        if ( (iError = iSrchDocumentOpenDocumentColumns(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the document columns, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+            return (SRCH_IndexOpenFailed);
+        }
+    
+    
         /* Open the document data */
         if ( (iError = iUtlDataOpen(pucDocumentDataFilePath, &psiSrchIndex->pvUtlDocumentData)) != UTL_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the document data, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
@@ -744,6 +783,41 @@ static int iSrchIndexFilesOpen
             return (SRCH_IndexOpenFailed);
         }
 
+
+        /* Open the term dictionary filter */
+        if ( (iError = iSrchTermDictOpenTermFilter(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the term dictionary filter, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError); 
+            return (SRCH_IndexOpenFailed);
+        }
+
+
+        /* Open the term ID table, indices created without term IDs will not have one */
+        if ( (iError = iSrchTermDictOpenTermIDs(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the term ID table, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError); 
+            return (SRCH_IndexOpenFailed);
+        }
+
+
+        /* Open the term gram dictionary, indices created without term grams will not have one */
+        if ( (iError = iSrchTermDictOpenTermGrams(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the term gram dictionary, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError); 
+            return (SRCH_IndexOpenFailed);
+        }
+
+
+        /* Open the phonetic key dictionaries, indices created without phonetic keys will not have them */
+        if ( (iError = iSrchTermDictOpenPhoneticKeys(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the phonetic key dictionaries, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError); 
+            return (SRCH_IndexOpenFailed);
+        }
+
+
+        /* Open the forward index, indices created without a forward index will not have one */
+        if ( (iError = iSrchForwardOpenIndex(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the forward index, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError); 
+            return (SRCH_IndexOpenFailed);
+        }
+
     }
     
     /* Create the index files */
@@ -757,7 +831,7 @@ static int iSrchIndexFilesOpen
     
     
         /* Initialize the version */
-        if ( (iError = iSrchVersionInit(psiSrchIndex, UTL_VERSION_MAJOR, UTL_VERSION_MINOR, UTL_VERSION_PATCH)) != SRCH_NoError ) {
+        if ( (iError = iSrchVersionInit(psiSrchIndex, UTL_VERSION_MAJOR, UTL_VERSION_MINOR, UTL_VERSION_PATCH, SRCH_INDEX_BLOCK_FEATURES_DEFAULT)) != SRCH_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Invalid index version in information file, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError); 
             return (iError);
         }
@@ -777,6 +851,13 @@ static int iSrchIndexFilesOpen
         }
     
     
+        /* Create the document columns */
+        if ( (iError = iSrchDocumentCreateDocumentColumns(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document columns, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError); 
+            return (SRCH_IndexCreateFailed);
+        }
+    
+    
         /* Create the document data */
         if ( (iError = iUtlDataCreate(pucDocumentDataFilePath, &psiSrchIndex->pvUtlDocumentData)) != UTL_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the document data, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError); 
@@ -891,6 +972,13 @@ static int iSrchIndexFilesClose
     }
     
 
+    /* Close the document columns */
+    if ( (iError = iSrchDocumentCloseDocumentColumns(psiSrchIndex)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to close the document columns, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        return (SRCH_IndexCloseFailed);
+    }
+
+
     /* Close the document table */
     if ( (iError = iUtlTableClose(psiSrchIndex->pvUtlDocumentTable)) != UTL_NoError ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to close the document table, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
@@ -923,6 +1011,70 @@ static int iSrchIndexFilesClose
     psiSrchIndex->pvUtlKeyDictionary = NULL;
 
 
+    /* Create the term dictionary filter if we are creating this index, the index can be searched without it so we just warn if this fails */
+    if ( psiSrchIndex->uiIntent == SRCH_INDEX_INTENT_CREATE ) {
+        if ( (iError = iSrchTermDictCreateTermFilter(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Failed to create the term dictionary filter, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        }
+    }
+
+
+    /* Close the term dictionary filter */
+    iSrchTermDictCloseTermFilter(psiSrchIndex);
+
+
+    /* Create the forward index if we are creating this index, the index can be searched without it so we just warn if this fails */
+    if ( psiSrchIndex->uiIntent == SRCH_INDEX_INTENT_CREATE ) {
+        if ( (iError = iSrchForwardCreateIndex(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Failed to create the forward index, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        }
+    }
+
+
+    /* Close the forward index */
+    iSrchForwardCloseIndex(psiSrchIndex);
+
+
+    /* Create the term ID table if we are creating this index, the index can be searched without it so we just warn if this fails */
+    if ( psiSrchIndex->uiIntent == SRCH_INDEX_INTENT_CREATE ) {
+        if ( (iError = iSrchTermDictCreateTermIDs(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Failed to create the term ID table, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        }
+    }
+
+
+    /* Close the term ID table */
+    iSrchTermDictCloseTermIDs(psiSrchIndex);
+
+
+    /* Create the term gram dictionary if we are creating this index, the index can be searched without it so we just warn if this fails */
+    if ( psiSrchIndex->uiIntent == SRCH_INDEX_INTENT_CREATE ) {
+        if ( (iError = iSrchTermDictCreateTermGrams(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Failed to create the term gram dictionary, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        }
+    }
+
+
+    /* Close the term gram dictionary */
+    iSrchTermDictCloseTermGrams(psiSrchIndex);
+
+
+    /* Create the phonetic key dictionaries if we are creating this index, phonetic keys were asked for 
+    ** when the index was created so the index is incomplete without them
+    */
+    if ( psiSrchIndex->uiIntent == SRCH_INDEX_INTENT_CREATE ) {
+        if ( (iError = iSrchTermDictCreatePhoneticKeys(psiSrchIndex)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the phonetic key dictionaries, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+            iSrchTermDictClosePhoneticKeys(psiSrchIndex);
+            return (SRCH_IndexCloseFailed);
+        }
+    }
+
+
+    /* Close the phonetic key dictionaries */
+    iSrchTermDictClosePhoneticKeys(psiSrchIndex);
+
+
     /* Close the term dictionary */
     if ( (iError = iUtlDictClose(psiSrchIndex->pvUtlTermDictionary)) != UTL_NoError ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to close the term dictionary, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
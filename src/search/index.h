@@ -68,6 +68,58 @@ extern "C" {
                                                         ((n) <= SRCH_INDEX_INTENT_SEARCH))
 
 
+/* Index block features, these are stored in the information file, an index 
+** without any features recorded was created before features were introduced
+*/
+#define SRCH_INDEX_BLOCK_FEATURE_NONE           (0)
+#define SRCH_INDEX_BLOCK_FEATURE_SKIP_LIST      (1 << 0)            /* Index blocks are followed by a skip list */
+#define SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX      (1 << 1)            /* Skip lists carry the maximum term count per document for each run */
+#define SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED     (1 << 2)            /* Index block data is bit packed into frames rather than compressed */
+#define SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM (1 << 3)           /* Index block data is split into a document stream and a term position stream */
+#define SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS (1 << 4)       /* Index blocks of dense terms end with their document IDs in roaring containers */
+#define SRCH_INDEX_BLOCK_FEATURE_FORWARD_INDEX  (1 << 5)            /* Index blocks are also inverted into a forward index of document term vectors */
+#define SRCH_INDEX_BLOCK_FEATURE_TERM_IDS       (1 << 6)            /* Terms are given dense term IDs, kept in the term dictionary and in a term ID table */
+#define SRCH_INDEX_BLOCK_FEATURE_IMPACTS        (1 << 7)            /* Index blocks carry a quantized impact per document, block maximums are maximum impacts */
+#define SRCH_INDEX_BLOCK_FEATURE_TERM_GRAMS     (1 << 8)            /* Terms are indexed by their trigrams in a term gram dictionary, needs term IDs */
+#define SRCH_INDEX_BLOCK_FEATURE_SOUNDEX_KEYS   (1 << 9)            /* Terms are indexed by their soundex keys in a phonetic key dictionary, needs term IDs */
+#define SRCH_INDEX_BLOCK_FEATURE_METAPHONE_KEYS (1 << 10)           /* Terms are indexed by their metaphone keys in a phonetic key dictionary, needs term IDs */
+#define SRCH_INDEX_BLOCK_FEATURE_PHONIX_KEYS    (1 << 11)           /* Terms are indexed by their phonix keys in a phonetic key dictionary, needs term IDs */
+
+#define SRCH_INDEX_BLOCK_FEATURES_PHONETIC_KEYS (SRCH_INDEX_BLOCK_FEATURE_SOUNDEX_KEYS | SRCH_INDEX_BLOCK_FEATURE_METAPHONE_KEYS | \
+                                                        SRCH_INDEX_BLOCK_FEATURE_PHONIX_KEYS)
+
+#define SRCH_INDEX_BLOCK_FEATURES_ALL           (SRCH_INDEX_BLOCK_FEATURE_SKIP_LIST | SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX | \
+                                                        SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED | SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM | \
+                                                        SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS | SRCH_INDEX_BLOCK_FEATURE_FORWARD_INDEX | \
+                                                        SRCH_INDEX_BLOCK_FEATURE_TERM_IDS | SRCH_INDEX_BLOCK_FEATURE_IMPACTS | \
+                                                        SRCH_INDEX_BLOCK_FEATURE_TERM_GRAMS | SRCH_INDEX_BLOCK_FEATURES_PHONETIC_KEYS)
+
+/* Bit packed index block data keeps its term positions in a separate array in each frame, so it does not get split into streams */
+#define SRCH_INDEX_BLOCK_FEATURES_VALID(n)      ((((n) & ~SRCH_INDEX_BLOCK_FEATURES_ALL) == 0) && \
+                                                        (((n) & (SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED | SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM)) != \
+                                                        (SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED | SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM)))
+
+/* Maximum number of index entries in a frame of bit packed index block data */
+#define SRCH_INDEX_BLOCK_FRAME_LENGTH           (128)
+
+/* Index block features used when creating an index */
+#define SRCH_INDEX_BLOCK_FEATURES_DEFAULT       (SRCH_INDEX_BLOCK_FEATURE_SKIP_LIST | SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX | \
+                                                        SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM | SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS | \
+                                                        SRCH_INDEX_BLOCK_FEATURE_TERM_IDS)
+
+/* Index block features used when creating an index with bit packed index block data, 
+** frame headers take the place of the skip list
+*/
+#define SRCH_INDEX_BLOCK_FEATURES_BIT_PACKED    (SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED | SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX | \
+                                                        SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS | SRCH_INDEX_BLOCK_FEATURE_TERM_IDS)
+
+
+/* Maximum number of document language IDs kept in the index summary, 
+** the language IDs are not kept if the index has more languages than this
+*/
+#define SRCH_INDEX_DOCUMENT_LANGUAGE_IDS_MAXIMUM    (16)
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -121,6 +173,29 @@ struct srchIndexBuild {
     unsigned int            uiFieldIDBitmapLength;          /* Field ID bitmap length */
 
     unsigned int            uiDuplicateDocumentKeysCount;   /* Number of duplicate document keys detected */
+
+    unsigned long           *pulTermHashes;                 /* Hashes of the terms added to the term dictionary, used to create the term filter */
+    unsigned long           ulTermHashesLength;             /* Number of term hashes */
+    unsigned long           ulTermHashesCapacity;           /* Capacity of the term hashes */
+    
+    FILE                    *pfTermIDsDataFile;             /* Term ID table data file, the terms are written to it as they are added to the term dictionary */
+    unsigned long           ulTermIDsDataLength;            /* Term ID table data file length */
+    unsigned long           *pulTermIDOffsets;              /* Term offsets into the term ID table data file, indexed by term ID */
+    unsigned int            uiTermIDsLength;                /* Number of term IDs given out */
+    unsigned int            uiTermIDsCapacity;              /* Capacity of the term offsets */
+    
+    void                    *pvUtlTermGramsTrie;            /* Term IDs for each term gram, collected as terms are added to the term dictionary (optional) */
+    
+    void                    *pvUtlSoundexKeysTrie;          /* Term IDs for each soundex key, collected as terms are added to the term dictionary (optional) */
+    void                    *pvUtlMetaphoneKeysTrie;        /* Term IDs for each metaphone key, collected as terms are added to the term dictionary (optional) */
+    void                    *pvUtlPhonixKeysTrie;           /* Term IDs for each phonix key, collected as terms are added to the term dictionary (optional) */
+    void                    *pvLngSoundex;                  /* Soundex used to get the soundex keys (optional) */
+    void                    *pvLngMetaphone;                /* Metaphone used to get the metaphone keys (optional) */
+    void                    *pvLngPhonix;                   /* Phonix used to get the phonix keys (optional) */
+    
+    struct srchForwardBuild *psfbSrchForwardBuild;          /* Forward index build structure (optional) */
+    
+    unsigned int            *puiDocumentTermCounts;         /* Document term counts, indexed by document ID, loaded to work out the impacts (optional) */
     
     void                    *pvLngConverterUTF8ToWChar;     /* Character set converter */
     void                    *pvLngConverterWCharToUTF8;     /* Character set converter */
@@ -136,6 +211,8 @@ struct srchIndex {
     unsigned int            uiMinorVersion;                 /* Minor version */
     unsigned int            uiPatchVersion;                 /* Patch version */
 
+    unsigned int            uiIndexBlockFeatures;           /* Index block features */
+
     FILE                    *pfLockFile;                    /* Lock file */
     unsigned int            uiIntent;                       /* Current intent */
     
@@ -150,6 +227,20 @@ struct srchIndex {
     void                    *pvUtlTermDictionary;           /* Term dictionary */
     void                    *pvUtlIndexInformation;         /* Index information */
 
+    struct srchDocumentColumns  *psdcSrchDocumentColumns;   /* Document columns (optional) */
+
+    struct srchTermDictFilter   *pstdfSrchTermDictFilter;   /* Term dictionary filter (optional) */
+
+    struct srchTermDictTermIDs  *pstdtiSrchTermDictTermIDs; /* Term ID table (optional) */
+
+    void                    *pvUtlTermGramsDictionary;      /* Term gram dictionary (optional) */
+
+    void                    *pvUtlSoundexKeysDictionary;    /* Soundex key dictionary (optional) */
+    void                    *pvUtlMetaphoneKeysDictionary;  /* Metaphone key dictionary (optional) */
+    void                    *pvUtlPhonixKeysDictionary;     /* Phonix key dictionary (optional) */
+
+    struct srchForward      *psfSrchForward;                /* Forward index (optional) */
+
     /* Scalars */
     unsigned int            uiTermLengthMaximum;            /* Maximum term length in this index */
     unsigned int            uiTermLengthMinimum;            /* Minimum term length in this index */
@@ -165,6 +256,11 @@ struct srchIndex {
 
     unsigned int            uiFieldIDMaximum;               /* Maximum field ID */
 
+    unsigned long           ulDocumentAnsiDateMaximum;      /* Maximum document ansi date */
+    unsigned long           ulDocumentAnsiDateMinimum;      /* Minimum document ansi date */
+    unsigned int            puiDocumentLanguageIDs[SRCH_INDEX_DOCUMENT_LANGUAGE_IDS_MAXIMUM];  /* Document language IDs */
+    unsigned int            uiDocumentLanguageIDsLength;    /* Document language IDs length - 0 if not known */
+
      time_t                 tLastUpdateTime;                /* Last update time */
     /* End of scalars */
 
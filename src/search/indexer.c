@@ -280,7 +280,7 @@ static int iSrchIndexerIndexCreate
     /* Initialize the index for adding documents */
     if ( (iError = iSrchInvertInit(*ppsiSrchIndex, psiSrchIndexer->pucLanguageCode, psiSrchIndexer->pucTokenizerName, 
                 psiSrchIndexer->pucStemmerName, psiSrchIndexer->pucStopListName, psiSrchIndexer->pucStopListFilePath, 
-                psiSrchIndexer->uiIndexerMemorySizeMaximum, psiSrchIndexer->uiTermLengthMinimum, psiSrchIndexer->uiTermLengthMaximum, 
+                psiSrchIndexer->uiIndexBlockFeatures, psiSrchIndexer->uiIndexerMemorySizeMaximum, psiSrchIndexer->uiTermLengthMinimum, psiSrchIndexer->uiTermLengthMaximum, 
                 psiSrchIndexer->pucTemporaryDirectoryPath)) != SRCH_NoError ) {
         
         /* Abort the index */
@@ -65,6 +65,19 @@ extern "C" {
 #define SRCH_INDEXER_MEMORY_MAXIMUM         (2048)
 
 
+/* Postings codec names, these select how the index block data is stored */
+#define SRCH_INDEXER_POSTINGS_CODEC_COMPRESSED_NAME     (unsigned char *)"compressed"
+#define SRCH_INDEXER_POSTINGS_CODEC_BIT_PACKED_NAME     (unsigned char *)"bitpacked"
+
+
+/* Phonetic key names, these select the phonetic key dictionaries to create */
+#define SRCH_INDEXER_PHONETIC_KEYS_SOUNDEX_NAME         (unsigned char *)"soundex"
+#define SRCH_INDEXER_PHONETIC_KEYS_METAPHONE_NAME       (unsigned char *)"metaphone"
+#define SRCH_INDEXER_PHONETIC_KEYS_PHONIX_NAME          (unsigned char *)"phonix"
+
+#define SRCH_INDEXER_PHONETIC_KEYS_SEPARATORS           (unsigned char *)", "
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -89,6 +102,7 @@ struct srchIndexer {
     unsigned char   *pucStemmerName;                    /* Stemmer name */
     unsigned char   *pucStopListName;                   /* Stop list name */
     unsigned char   *pucStopListFilePath;               /* Stop list file path */
+    unsigned int    uiIndexBlockFeatures;               /* Index block features, set from the postings codec */
 
     unsigned int    uiIndexerMemorySizeMaximum;         /* Maximum memory to use (megabytes) */
     boolean         bSuppressMessages;                  /* Suppress messages if set to true */
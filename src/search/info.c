@@ -65,6 +65,7 @@
 
 /* Version information key */
 #define SRCH_INFO_VERSION_INFO_KEY                          (unsigned char *)"Version"
+#define SRCH_INFO_INDEX_BLOCK_FEATURES_INFO_KEY             (unsigned char *)"IndexBlockFeatures"
 
 
 /* Language information key */
@@ -140,6 +141,16 @@
 /* Maximum field ID information key */
 #define SRCH_INFO_MAXIMUM_FIELD_ID_INFO_KEY                 (unsigned char *)"MaximumFieldID"
 
+/* Document ansi date maximum information key */
+#define SRCH_INFO_DOCUMENT_ANSI_DATE_MAXIMUM_INFO_KEY       (unsigned char *)"DocumentAnsiDateMaximum"
+
+/* Document ansi date minimum information key */
+#define SRCH_INFO_DOCUMENT_ANSI_DATE_MINIMUM_INFO_KEY       (unsigned char *)"DocumentAnsiDateMinimum"
+
+/* Document languages information key, and the separator for the language codes */
+#define SRCH_INFO_DOCUMENT_LANGUAGES_INFO_KEY               (unsigned char *)"DocumentLanguages"
+#define SRCH_INFO_DOCUMENT_LANGUAGES_SEPARATORS             (unsigned char *)","
+
 /* Last update time information key */
 #define SRCH_INFO_LAST_UPDATE_TIME_INFO_KEY                 (unsigned char *)"LastUpdateTime"
 
@@ -160,10 +171,11 @@
 
     Purpose:    Get the version information from the information file
 
-    Parameters: psiSrchIndex        search index structure
-                puiMajorVersion     return pointer for the major version
-                puiMinorVersion     return pointer for the minor version
-                puiPatchVersion     return pointer for the patch version
+    Parameters: psiSrchIndex            search index structure
+                puiMajorVersion         return pointer for the major version
+                puiMinorVersion         return pointer for the minor version
+                puiPatchVersion         return pointer for the patch version
+                puiIndexBlockFeatures   return pointer for the index block features
 
     Globals:    none
 
@@ -175,7 +187,8 @@ int iSrchInfoGetVersionInfo
     struct srchIndex *psiSrchIndex,
     unsigned int *puiMajorVersion,
     unsigned int *puiMinorVersion,
-    unsigned int *puiPatchVersion
+    unsigned int *puiPatchVersion,
+    unsigned int *puiIndexBlockFeatures
 )
 {
 
@@ -184,6 +197,7 @@ int iSrchInfoGetVersionInfo
     unsigned int    uiMajorVersion = 0;
     unsigned int    uiMinorVersion = 0;
     unsigned int    uiPatchVersion = 0;
+    unsigned int    uiIndexBlockFeatures = SRCH_INDEX_BLOCK_FEATURE_NONE;
     
 
     /* Check the parameters */
@@ -197,6 +211,21 @@ int iSrchInfoGetVersionInfo
         return (SRCH_ReturnParameterError);
     }
 
+    if ( puiMinorVersion == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiMinorVersion' parameter passed to 'iSrchInfoGetVersionInfo'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiPatchVersion == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiPatchVersion' parameter passed to 'iSrchInfoGetVersionInfo'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiIndexBlockFeatures == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiIndexBlockFeatures' parameter passed to 'iSrchInfoGetVersionInfo'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
 
     /* Get the version information value */
     if ( (iError = iUtlConfigGetValue(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_VERSION_INFO_KEY, pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1)) != UTL_NoError ) {
@@ -210,10 +239,19 @@ int iSrchInfoGetVersionInfo
     }
 
 
+    /* Get the index block features value, indexes created before the 
+    ** index block features were introduced don't have this symbol
+    */
+    if ( iUtlConfigGetValue(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_INDEX_BLOCK_FEATURES_INFO_KEY, pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1) == UTL_NoError ) {
+        uiIndexBlockFeatures = s_strtol(pucConfigValue, NULL, 10);
+    }
+
+
     /* Set the return pointers */
     *puiMajorVersion = uiMajorVersion;
     *puiMinorVersion = uiMinorVersion;
     *puiPatchVersion = uiPatchVersion;
+    *puiIndexBlockFeatures = uiIndexBlockFeatures;
 
 
     return (SRCH_NoError);
@@ -269,6 +307,51 @@ int iSrchInfoSetVersionInfo
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchInfoSetIndexBlockFeaturesInfo()
+
+    Purpose:    Write the index block features to the information file
+
+    Parameters: psiSrchIndex        search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchInfoSetIndexBlockFeaturesInfo
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   pucConfigValue[SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1] = {'\0'};
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchInfoSetIndexBlockFeaturesInfo'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Add the index block features entry */
+    snprintf(pucConfigValue, UTL_CONFIG_VALUE_MAXIMUM_LENGTH + 1, "%u", psiSrchIndex->uiIndexBlockFeatures);
+    if ( (iError = iUtlConfigAddEntry(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_INDEX_BLOCK_FEATURES_INFO_KEY, pucConfigValue)) != UTL_NoError ) {
+        return (SRCH_InfoSymbolSetFailed);
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /* 
 ** ======================================
 ** ===  Language Information Support  ===
@@ -1774,6 +1857,7 @@ int iSrchInfoGetScalars
 
     int             iError = SRCH_NoError;
     unsigned char   pucConfigValue[SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1] = {'\0'};
+    unsigned char   pucConfigValueMinimum[SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1] = {'\0'};
     
 
     /* Check the parameters */
@@ -1873,6 +1957,46 @@ int iSrchInfoGetScalars
     psiSrchIndex->tLastUpdateTime = (time_t)s_strtol(pucConfigValue, NULL, 10);
 
 
+
+    /* The document summary was added later so it may not be there, in which case 
+    ** we keep the defaults which don't allow the index to be skipped when searching
+    */
+
+    /* Get the document ansi date maximum and minimum information values */
+    if ( (iUtlConfigGetValue(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_DOCUMENT_ANSI_DATE_MAXIMUM_INFO_KEY, pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1) == UTL_NoError) &&
+            (iUtlConfigGetValue(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_DOCUMENT_ANSI_DATE_MINIMUM_INFO_KEY, pucConfigValueMinimum, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1) == UTL_NoError) ) {
+        
+        /* Set the document ansi date maximum and minimum */
+        psiSrchIndex->ulDocumentAnsiDateMaximum = s_strtol(pucConfigValue, NULL, 10);
+        psiSrchIndex->ulDocumentAnsiDateMinimum = s_strtol(pucConfigValueMinimum, NULL, 10);
+    }
+
+
+    /* Get the document languages information value */
+    if ( iUtlConfigGetValue(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_DOCUMENT_LANGUAGES_INFO_KEY, pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1) == UTL_NoError ) {
+    
+        unsigned char   *pucLanguageCodePtr = NULL;
+        unsigned char   *pucLanguageCodeStrtokPtr = NULL;
+        unsigned int    uiLanguageID = 0;
+
+        /* Parse out the language codes, dropping all of them if any one is not valid */
+        for ( pucLanguageCodePtr = (unsigned char *)s_strtok_r(pucConfigValue, SRCH_INFO_DOCUMENT_LANGUAGES_SEPARATORS, (char **)&pucLanguageCodeStrtokPtr), 
+                    psiSrchIndex->uiDocumentLanguageIDsLength = 0; 
+                pucLanguageCodePtr != NULL; 
+                pucLanguageCodePtr = (unsigned char *)s_strtok_r(NULL, SRCH_INFO_DOCUMENT_LANGUAGES_SEPARATORS, (char **)&pucLanguageCodeStrtokPtr) ) {
+
+            if ( (psiSrchIndex->uiDocumentLanguageIDsLength == SRCH_INDEX_DOCUMENT_LANGUAGE_IDS_MAXIMUM) || 
+                    (iLngGetLanguageIDFromCode(pucLanguageCodePtr, &uiLanguageID) != LNG_NoError) ) {
+                psiSrchIndex->uiDocumentLanguageIDsLength = 0;
+                break;
+            }
+        
+            psiSrchIndex->puiDocumentLanguageIDs[psiSrchIndex->uiDocumentLanguageIDsLength] = uiLanguageID;
+            psiSrchIndex->uiDocumentLanguageIDsLength++;
+        }
+    }
+
+
     return (SRCH_NoError);
 
 }
@@ -1967,6 +2091,48 @@ int iSrchInfoSetScalars
     }
 
 
+    /* Add the document ansi date maximum information entry */
+    snprintf(pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1, "%lu", psiSrchIndex->ulDocumentAnsiDateMaximum);
+    if ( (iError = iUtlConfigAddEntry(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_DOCUMENT_ANSI_DATE_MAXIMUM_INFO_KEY, pucConfigValue)) != UTL_NoError ) {
+        return (iError);
+    }
+
+
+    /* Add the document ansi date minimum information entry */
+    snprintf(pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1, "%lu", psiSrchIndex->ulDocumentAnsiDateMinimum);
+    if ( (iError = iUtlConfigAddEntry(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_DOCUMENT_ANSI_DATE_MINIMUM_INFO_KEY, pucConfigValue)) != UTL_NoError ) {
+        return (iError);
+    }
+
+
+    /* Add the document languages information entry, the entry is left out if the document languages are not known */
+    if ( psiSrchIndex->uiDocumentLanguageIDsLength > 0 ) {
+        
+        unsigned char   pucLanguageCode[SPI_INDEX_LANGUAGE_MAXIMUM_LENGTH + 1] = {'\0'};
+        unsigned int    uiI = 0;
+        
+        for ( uiI = 0, pucConfigValue[0] = '\0'; uiI < psiSrchIndex->uiDocumentLanguageIDsLength; uiI++ ) {
+
+            /* Get the language code from the language ID, leave out the entry if we can't */
+            if ( iLngGetLanguageCodeFromID(psiSrchIndex->puiDocumentLanguageIDs[uiI], pucLanguageCode, SPI_INDEX_LANGUAGE_MAXIMUM_LENGTH + 1) != LNG_NoError ) {
+                pucConfigValue[0] = '\0';
+                break;
+            }
+            
+            if ( uiI > 0 ) {
+                s_strnncat(pucConfigValue, SRCH_INFO_DOCUMENT_LANGUAGES_SEPARATORS, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1);
+            }
+            s_strnncat(pucConfigValue, pucLanguageCode, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1);
+        }
+        
+        if ( bUtlStringsIsStringNULL(pucConfigValue) == false ) {
+            if ( (iError = iUtlConfigAddEntry(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_DOCUMENT_LANGUAGES_INFO_KEY, pucConfigValue)) != UTL_NoError ) {
+                return (iError);
+            }
+        }
+    }
+
+
     /* Add the last update time information entry */
     snprintf(pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1, "%ld", psiSrchIndex->tLastUpdateTime);
     if ( (iError = iUtlConfigAddEntry(psiSrchIndex->pvUtlIndexInformation, SRCH_INFO_LAST_UPDATE_TIME_INFO_KEY, pucConfigValue)) != UTL_NoError ) {
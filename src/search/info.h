@@ -141,10 +141,12 @@ extern "C" {
 
 int iSrchInfoGetVersionInfo (struct srchIndex *psiSrchIndex, 
         unsigned int *puiMajorVersion, unsigned int *puiMinorVersion, 
-        unsigned int *puiPatchVersion);
+        unsigned int *puiPatchVersion, unsigned int *puiIndexBlockFeatures);
 
 int iSrchInfoSetVersionInfo (struct srchIndex *psiSrchIndex);
 
+int iSrchInfoSetIndexBlockFeaturesInfo (struct srchIndex *psiSrchIndex);
+
 
 int iSrchInfoGetLanguageInfo (struct srchIndex *psiSrchIndex, 
         unsigned char *pucLanguageCode, unsigned int uiLanguageCodeLength);
@@ -86,6 +86,134 @@
 #define SRCH_INVERT_MERGE_WIDTH                                 (FOPEN_MAX - 15)
 
 
+/* Skip list, this is appended to the index block data in the final index if the 
+** term has more than SRCH_INVERT_SKIP_LIST_INTERVAL postings. The skip list is 
+** made up of a compressed entry count followed by the entries, each entry being 
+** a compressed delta of the last document ID of a run of postings and a compressed 
+** delta of the offset of the next run of postings in the index block data. Runs 
+** only ever end on a document boundary.
+**
+** If the index has the SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX feature, each entry is 
+** followed by the compressed maximum number of postings any one document has in 
+** the run, and the entries are followed by that same maximum for the last run.
+** This gives an upper bound on the weight of a document within each run, which 
+** is used to skip runs when searching for the top documents.
+**
+** If the index has the SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM feature, the offset
+** is the offset of the next run of postings in the document stream, and it is 
+** followed by a compressed delta of the offset of the term positions of that run 
+** in the term position stream (before the maximum if there is one).
+*/
+#define SRCH_INVERT_SKIP_LIST_INTERVAL                          (128)
+
+/* Maximum skip list length for a term with a given number of postings */
+#define SRCH_INVERT_SKIP_LIST_MAXIMUM_LENGTH(n)                 (UTL_NUM_COMPRESSED_UINT_MAX_SIZE + \
+                                                                        ((((n) / SRCH_INVERT_SKIP_LIST_INTERVAL) + 1) * \
+                                                                        (UTL_NUM_COMPRESSED_UINT_MAX_SIZE * 4)) + \
+                                                                        UTL_NUM_COMPRESSED_UINT_MAX_SIZE)
+
+
+/* Number of compressed uints in an index entry (document ID, term position and field ID) */
+#define SRCH_INVERT_INDEX_ENTRY_LENGTH                          (3)
+
+/* Number of index entries decoded from the index block at a time when compressing it,
+** this is also the number of entries in a frame when bit packing it
+*/
+#define SRCH_INVERT_INDEX_ENTRIES_LENGTH                        (SRCH_INDEX_BLOCK_FRAME_LENGTH)
+
+
+/* Bit packed index block data, this replaces the compressed index block data in the 
+** final index if the index has the SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED feature, and no
+** skip list is appended. The index entries are packed into frames of 
+** SRCH_INDEX_BLOCK_FRAME_LENGTH entries (the last frame may be shorter). Each frame is 
+** made up of a header followed by the bit packed delta document IDs, the bit packed 
+** term positions and the bit packed field IDs of its entries. The header is made up of 
+** the compressed entry count, the compressed delta of the last document ID in the frame
+** from the last document ID in the previous frame, and one byte each for the bit widths 
+** of the delta document IDs, the term positions and the field IDs.
+**
+** If the index has the SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX feature, the compressed maximum
+** number of postings any one document has follows the last document ID in the header. A
+** document whose postings run across frames is counted in full in the frame it starts in.
+**
+** The frame headers allow frames to be skipped over without unpacking them and give an 
+** upper bound on the weight of a document within each frame, so they take the place of 
+** the skip list.
+*/
+#define SRCH_INVERT_FRAME_BIT_WIDTH_SIZE                        (1)
+
+#define SRCH_INVERT_FRAME_HEADER_MAXIMUM_LENGTH                 ((UTL_NUM_COMPRESSED_UINT_MAX_SIZE * 3) + \
+                                                                        (SRCH_INVERT_FRAME_BIT_WIDTH_SIZE * SRCH_INVERT_INDEX_ENTRY_LENGTH))
+
+/* Split index block data, this replaces the compressed index block data in the final 
+** index if the index has the SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM feature. It is made
+** up of the compressed length of the document stream, followed by the document stream, 
+** followed by the term position stream. The document stream is made up of runs of postings
+** for the same document and field, each run being a compressed delta document ID (0 if the
+** run is in the same document as the previous run), a compressed field ID and a compressed 
+** posting count of up to SRCH_INDEX_BLOCK_FRAME_LENGTH. The term position stream is made 
+** up of the compressed term position of each posting, in the same order and with the same
+** deltas as in the compressed index block data.
+**
+** This allows the document stream to be read on its own when term positions are not needed,
+** and term position streams are usually much longer than document streams. The split index 
+** block data is never longer than the compressed index block data plus the length plus
+** one byte per posting, which is what a posting count costs for a run of one posting.
+*/
+#define SRCH_INVERT_SPLIT_INDEX_BLOCK_MAXIMUM_LENGTH(l, n)      ((l) + (n) + UTL_NUM_COMPRESSED_UINT_MAX_SIZE)
+
+
+/* Maximum bit packed index block data length for a term with a given number of postings, 
+** allowing for a partial byte at the end of each bit packed array
+*/
+#define SRCH_INVERT_BIT_PACKED_INDEX_BLOCK_MAXIMUM_LENGTH(n)    (((((n) / SRCH_INDEX_BLOCK_FRAME_LENGTH) + 1) * \
+                                                                        (SRCH_INVERT_FRAME_HEADER_MAXIMUM_LENGTH + SRCH_INVERT_INDEX_ENTRY_LENGTH)) + \
+                                                                        ((n) * SRCH_INVERT_INDEX_ENTRY_LENGTH * UTL_NUM_UINT_MAX_SIZE))
+
+
+/* Document containers, these are appended to the index block in the final index, after the
+** skip list if there is one, if the index has the SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS 
+** feature and the term is dense enough, that is if it occurs in at least 
+** SRCH_INVERT_DOCUMENT_CONTAINERS_MINIMUM_DOCUMENT_COUNT documents and in at least 
+** SRCH_INVERT_DOCUMENT_CONTAINERS_MINIMUM_COVERAGE percent of the documents in the index. They 
+** are the document IDs the term occurs in, serialized as a roaring structure, see utils/roaring.c. 
+** The compressed length of the document containers follows the compressed length of the index
+** block data at the start of the index block, it is 0 if there are no document containers.
+**
+** This allows very frequent terms to be ANDed and NOTed as a set of document IDs rather 
+** than decoding all their postings, which is most of the cost of searching on them.
+*/
+#define SRCH_INVERT_DOCUMENT_CONTAINERS_COMPRESSED_LENGTH_SIZE  UTL_NUM_COMPRESSED_UINT_MAX_SIZE
+
+#define SRCH_INVERT_DOCUMENT_CONTAINERS_MINIMUM_DOCUMENT_COUNT  (4096)
+#define SRCH_INVERT_DOCUMENT_CONTAINERS_MINIMUM_COVERAGE        (5)
+
+/* Macro to check whether a term occurring in a given number of documents is dense enough to get document containers */
+#define SRCH_INVERT_DOCUMENT_CONTAINERS_NEEDED(n, d)            (((n) >= SRCH_INVERT_DOCUMENT_CONTAINERS_MINIMUM_DOCUMENT_COUNT) && \
+                                                                        (((unsigned long)(n) * 100) >= ((unsigned long)(d) * SRCH_INVERT_DOCUMENT_CONTAINERS_MINIMUM_COVERAGE)))
+
+
+/* Impacts, these are stored in the index block in the final index if the index has the 
+** SRCH_INDEX_BLOCK_FEATURE_IMPACTS feature. The impact of a term in a document is the weight 
+** the term gives the document at search time, that is the number of postings of the term in 
+** the document times the IDF factor of the term, divided by the log of the document term 
+** count as search.c does, quantized into a byte against a scale kept for each term so that 
+** the largest impact of the term is SRCH_INVERT_IMPACT_MAXIMUM. There is one impact per 
+** document in the index block, in document ID order. The compressed impact count follows the 
+** compressed lengths at the start of the index block, followed by the scale as a float and
+** the impacts, the index block data follows the impacts.
+**
+** The block maximums in the skip list or in the frame headers are the maximum impact of any 
+** one document in the run rather than the maximum number of postings, so they are exact upper
+** bounds on the weight of a document within each run, and the weights of the documents are 
+** known without reading the document term counts at search time.
+*/
+#define SRCH_INVERT_IMPACTS_COMPRESSED_LENGTH_SIZE              UTL_NUM_COMPRESSED_UINT_MAX_SIZE
+#define SRCH_INVERT_IMPACTS_SCALE_SIZE                          UTL_NUM_COMPRESSED_FLOAT_SIZE
+
+#define SRCH_INVERT_IMPACT_MAXIMUM                              (UCHAR_MAX)
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -180,6 +308,25 @@ static int iSrchInvertStoreTermInIndex (struct srchIndex *psiSrchIndex, unsigned
 static int iSrchInvertCompressIndexBlock (unsigned char *pucTerm, unsigned char *pucIndexBlock, unsigned int *puiIndexBlockLength, 
         unsigned char *pucFieldIDBitmap, unsigned int uiFieldIDBitmapLength);
 
+static int iSrchInvertBitPackIndexBlock (unsigned char *pucIndexBlock, unsigned int uiIndexBlockLength, 
+        unsigned int uiIndexEntriesCount, boolean bBlockMax, unsigned char *pucImpacts, 
+        unsigned char *pucBitPackedIndexBlock, unsigned int *puiBitPackedIndexBlockLength);
+
+static int iSrchInvertSplitIndexBlock (unsigned char *pucIndexBlock, unsigned int uiIndexBlockLength, 
+        unsigned char *pucSplitIndexBlock, unsigned int *puiSplitIndexBlockLength);
+
+static int iSrchInvertCreateSkipList (unsigned char *pucIndexBlock, unsigned int uiIndexBlockLength, 
+        boolean bPositionStream, boolean bBlockMax, unsigned char *pucImpacts, unsigned char *pucSkipList, 
+        unsigned int *puiSkipListLength);
+
+static int iSrchInvertCreateDocumentContainers (unsigned char *pucIndexBlock, unsigned int uiIndexBlockLength, 
+        void **ppvUtlRoaring);
+
+static int iSrchInvertCreateImpacts (struct srchIndex *psiSrchIndex, unsigned char *pucIndexBlock, 
+        unsigned int uiIndexBlockLength, unsigned int uiTermCount, unsigned int uiDocumentCount, 
+        unsigned char *pucImpacts, unsigned int uiImpactsCapacity, unsigned int *puiImpactsLength, 
+        float *pfImpactsScale);
+
 
 static unsigned char *pucSrchInvertPrettyPrintFileNumbers (struct srchIndex *psiSrchIndex,
         unsigned int uiStartVersion, unsigned int uiEndVersion, unsigned char *pucBuffer,
@@ -207,6 +354,7 @@ static unsigned char *pucSrchInvertPrettyPrintFileNumbers (struct srchIndex *psi
                 pucStemmerName                  stemmer name
                 pucStopListName                 stop list name (optional)
                 pucStopListFilePath             stop list file path (optional)
+                uiIndexBlockFeatures            index block features
                 uiIndexerMemorySizeMaximum      memory to use in megabytes
                 uiTermLengthMinimum             min term length
                 uiTermLengthMaximum             max term length
@@ -225,6 +373,7 @@ int iSrchInvertInit
     unsigned char *pucStemmerName,
     unsigned char *pucStopListName,
     unsigned char *pucStopListFilePath,
+    unsigned int uiIndexBlockFeatures,
     unsigned int uiIndexerMemorySizeMaximum,
     unsigned int uiTermLengthMinimum,
     unsigned int uiTermLengthMaximum,
@@ -261,6 +410,11 @@ int iSrchInvertInit
         return (SRCH_InvertInvalidStopListName);
     }
 
+    if ( SRCH_INDEX_BLOCK_FEATURES_VALID(uiIndexBlockFeatures) == false ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiIndexBlockFeatures' parameter passed to 'iSrchInvertInit'."); 
+        return (SRCH_InvertInvalidIndexBlockFeatures);
+    }
+
     if ( (uiIndexerMemorySizeMaximum < SRCH_INDEXER_MEMORY_MINIMUM) || (uiIndexerMemorySizeMaximum > SRCH_INDEXER_MEMORY_MAXIMUM) ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiIndexerMemorySizeMaximum' parameter passed to 'iSrchInvertInit'."); 
         return (SRCH_InvertInvalidMemorySizeMax);
@@ -322,6 +476,16 @@ int iSrchInvertInit
         return (iError);
     }
 
+    /* Set the index block features and write them to the information file, 
+    ** this is the earliest point at which they are known
+    */
+    psiSrchIndex->uiIndexBlockFeatures = uiIndexBlockFeatures;
+    if ( (iError = iSrchInfoSetIndexBlockFeaturesInfo(psiSrchIndex)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to set the index block features in the information file, index: '%s', srch error: %d.", 
+                psiSrchIndex->pucIndexName, iError);
+        return (iError);
+    }
+
 
     /* Create the stemmer */
     if ( (iError = iLngStemmerCreateByID(psiSrchIndex->uiStemmerID, psiSrchIndex->uiLanguageID, &psiSrchIndex->psibSrchIndexBuild->pvLngStemmer)) != LNG_NoError ) {
@@ -2574,6 +2738,17 @@ static int iSrchInvertStoreTermInIndex
     unsigned int                    uiIndexBlockLength = 0;
     unsigned int                    uiIndexBlockDataLength = 0;
     unsigned int                    uiIndexBlockDataLengthSize = 0;
+    unsigned int                    uiSkipListLength = 0;
+    unsigned int                    uiBitPackedIndexBlockDataLength = 0;
+    unsigned int                    uiSplitIndexBlockDataLength = 0;
+    void                            *pvUtlRoaring = NULL;
+    unsigned int                    uiDocumentContainersLength = 0;
+    unsigned int                    uiDocumentContainersLengthSize = 0;
+    unsigned int                    uiImpactsLength = 0;
+    unsigned int                    uiImpactsLengthSize = 0;
+    float                           fImpactsScale = 0;
+    unsigned int                    uiImpactsScale = 0;
+    unsigned int                    uiIndexBlockHeaderLength = 0;
     struct srchInvertIndexMerge     *psiimSrchInvertIndexMergePtr = NULL;
     
     unsigned int                    uiVariableIndexBlockDataLengthSize = 0;
@@ -2593,6 +2768,11 @@ static int iSrchInvertStoreTermInIndex
     /* Get the variable index block data length size */
     uiVariableIndexBlockDataLengthSize = (bFinalMerge == true) ? SRCH_INVERT_INDEX_BLOCK_DATA_COMPRESSED_LENGTH_SIZE: SRCH_INVERT_INDEX_BLOCK_DATA_LENGTH_SIZE;
 
+    /* Make space for the document containers length as well if the index has document containers */
+    if ( (bFinalMerge == true) && (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS) ) {
+        uiVariableIndexBlockDataLengthSize += SRCH_INVERT_DOCUMENT_CONTAINERS_COMPRESSED_LENGTH_SIZE;
+    }
+
 
     /* Calculate the index block data length and increment some counts  */
     for ( uiI = 0, psiimSrchInvertIndexMergePtr = psiimSrchInvertIndexMerge; uiI < uiSrchInvertIndexMergeLength; uiI++, psiimSrchInvertIndexMergePtr++ ) {
@@ -2629,9 +2809,37 @@ static int iSrchInvertStoreTermInIndex
     bIncludeInCounts = psiimSrchInvertIndexMerge->bIncludeInCounts;
 
 
+    /* Make space for the impact count, the scale and the impacts as well if the index has impacts, there is one impact per document */
+    if ( (bFinalMerge == true) && (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_IMPACTS) ) {
+        uiVariableIndexBlockDataLengthSize += SRCH_INVERT_IMPACTS_COMPRESSED_LENGTH_SIZE + SRCH_INVERT_IMPACTS_SCALE_SIZE + uiTotalDocumentCount;
+    }
+
+
     /* Calculate the index block length */
     uiIndexBlockLength = uiVariableIndexBlockDataLengthSize + uiIndexBlockDataLength;
 
+    /* Make space for the bit packed index block data if we are going to bit pack it, it gets 
+    ** packed after the compressed index block data and moved over it, so there is no skip list
+    */
+    if ( (bFinalMerge == true) && (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED) ) {
+        uiIndexBlockLength += SRCH_INVERT_BIT_PACKED_INDEX_BLOCK_MAXIMUM_LENGTH(uiTotalTermCount);
+    }
+
+    else if ( bFinalMerge == true ) {
+
+        /* Make space for the split index block data if we are going to split it, it gets 
+        ** split after the compressed index block data and moved over it
+        */
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM ) {
+            uiIndexBlockLength += SRCH_INVERT_SPLIT_INDEX_BLOCK_MAXIMUM_LENGTH(uiIndexBlockDataLength, uiTotalTermCount);
+        }
+
+        /* Make space for the skip list if there is going to be one, it gets appended to the index block data */
+        if ( (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_SKIP_LIST) && (uiTotalTermCount > SRCH_INVERT_SKIP_LIST_INTERVAL) ) {
+            uiIndexBlockLength += SRCH_INVERT_SKIP_LIST_MAXIMUM_LENGTH(uiTotalTermCount);
+        }
+    }
+
 
     /* Allocate space for the index block, this is preserved across calls to make 
     ** the process faster, this index block is released when we close the index
@@ -2703,7 +2911,7 @@ static int iSrchInvertStoreTermInIndex
         }
 
         /* Get a pointer to the start of the index block data */
-        pucIndexBlockDataPtr = psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + SRCH_INVERT_INDEX_BLOCK_DATA_COMPRESSED_LENGTH_SIZE;
+        pucIndexBlockDataPtr = psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + uiVariableIndexBlockDataLengthSize;
     
         /* Compress the index block, and create the field ID bitmap while we are at it */
         if ( (iError = iSrchInvertCompressIndexBlock(pucTerm, pucIndexBlockDataPtr, &uiIndexBlockDataLength, 
@@ -2712,24 +2920,206 @@ static int iSrchInvertStoreTermInIndex
         }
 
 
+        /* Add the term to the forward index if requested, this is done from the compressed index 
+        ** block data since that is the last place where all the index entries are easy to read,
+        ** the term is identified by the term ID it will be given when it is added to the term dictionary
+        */
+        if ( (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_FORWARD_INDEX) && (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS) && 
+                (uiTermType == SPI_TERM_TYPE_REGULAR) && (uiIndexBlockDataLength > 0) ) {
+
+            unsigned int    uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
+
+            if ( (iError = iSrchTermDictGetNextTermID(psiSrchIndex, &uiTermID)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            if ( (iError = iSrchForwardAddTerm(psiSrchIndex, uiTermID, pucIndexBlockDataPtr, uiIndexBlockDataLength)) != SRCH_NoError ) {
+                return (iError);
+            }
+        }
+
+
+        /* Create the impacts from the compressed index block data if requested, they go in the space 
+        ** we saved for them, and are moved up against the index block data since there may be fewer 
+        ** of them than we saved space for
+        */
+        if ( (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_IMPACTS) && (uiIndexBlockDataLength > 0) ) {
+
+            if ( (iError = iSrchInvertCreateImpacts(psiSrchIndex, pucIndexBlockDataPtr, uiIndexBlockDataLength, uiTotalTermCount, uiTotalDocumentCount,
+                    pucIndexBlockDataPtr - uiTotalDocumentCount, uiTotalDocumentCount, &uiImpactsLength, &fImpactsScale)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            if ( uiImpactsLength < uiTotalDocumentCount ) {
+                s_memmove(pucIndexBlockDataPtr - uiImpactsLength, pucIndexBlockDataPtr - uiTotalDocumentCount, uiImpactsLength);
+            }
+        }
+
+
+        /* Create the document containers from the compressed index block data if the term is dense enough, 
+        ** they get serialized at the end of the index block so we make space for them there
+        */
+        if ( (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS) && (uiIndexBlockDataLength > 0) &&
+                (SRCH_INVERT_DOCUMENT_CONTAINERS_NEEDED(uiTotalDocumentCount, psiSrchIndex->uiDocumentCount) == true) ) {
+
+            if ( (iError = iSrchInvertCreateDocumentContainers(pucIndexBlockDataPtr, uiIndexBlockDataLength, &pvUtlRoaring)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            if ( (iError = iUtlRoaringGetSerializedLength(pvUtlRoaring, &uiDocumentContainersLength)) != UTL_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the document containers length, utl error: %d.", iError);
+                iUtlRoaringFree(pvUtlRoaring);
+                return (SRCH_InvertDocumentContainersFailed);
+            }
+
+            /* Extend the index block, the index block data pointer needs to be reset since the index block may move */
+            if ( (uiIndexBlockLength + uiDocumentContainersLength) > psiSrchIndex->psibSrchIndexBuild->uiIndexBlockLength ) {
+
+                unsigned char   *pucIndexBlock = NULL;
+
+                if ( (pucIndexBlock = (unsigned char *)s_realloc(psiSrchIndex->psibSrchIndexBuild->pucIndexBlock, 
+                        (size_t)((uiIndexBlockLength + uiDocumentContainersLength) * sizeof(unsigned char)))) == NULL ) {
+                    iUtlRoaringFree(pvUtlRoaring);
+                    return (SRCH_MemError);
+                }
+
+                psiSrchIndex->psibSrchIndexBuild->pucIndexBlock = pucIndexBlock;
+                psiSrchIndex->psibSrchIndexBuild->uiIndexBlockLength = uiIndexBlockLength + uiDocumentContainersLength;
+                pucIndexBlockDataPtr = psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + uiVariableIndexBlockDataLengthSize;
+            }
+
+            uiIndexBlockLength += uiDocumentContainersLength;
+        }
+
+
+        /* Bit pack the compressed index block data if requested, packing it after the compressed 
+        ** index block data and moving it over the compressed index block data
+        */
+        if ( (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED) && (uiIndexBlockDataLength > 0) ) {
+
+            if ( (iError = iSrchInvertBitPackIndexBlock(pucIndexBlockDataPtr, uiIndexBlockDataLength, uiTotalTermCount,
+                    (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX) ? true : false, 
+                    (uiImpactsLength > 0) ? pucIndexBlockDataPtr - uiImpactsLength : NULL, 
+                    pucIndexBlockDataPtr + uiIndexBlockDataLength, &uiBitPackedIndexBlockDataLength)) != SRCH_NoError ) {
+                iUtlRoaringFree(pvUtlRoaring);
+                return (iError);
+            }
+
+            ASSERT(uiBitPackedIndexBlockDataLength <= SRCH_INVERT_BIT_PACKED_INDEX_BLOCK_MAXIMUM_LENGTH(uiTotalTermCount));
+            ASSERT((pucIndexBlockDataPtr + uiIndexBlockDataLength + uiBitPackedIndexBlockDataLength) <= (psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + uiIndexBlockLength));
+
+            s_memmove(pucIndexBlockDataPtr, pucIndexBlockDataPtr + uiIndexBlockDataLength, uiBitPackedIndexBlockDataLength);
+            uiIndexBlockDataLength = uiBitPackedIndexBlockDataLength;
+        }
+
+        else if ( uiIndexBlockDataLength > 0 ) {
+
+            /* Split the compressed index block data into a document stream and a term position stream if 
+            ** requested, splitting it after the compressed index block data and moving it over the 
+            ** compressed index block data
+            */
+            if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM ) {
+
+                if ( (iError = iSrchInvertSplitIndexBlock(pucIndexBlockDataPtr, uiIndexBlockDataLength, 
+                        pucIndexBlockDataPtr + uiIndexBlockDataLength, &uiSplitIndexBlockDataLength)) != SRCH_NoError ) {
+                    iUtlRoaringFree(pvUtlRoaring);
+                    return (iError);
+                }
+
+                ASSERT(uiSplitIndexBlockDataLength <= SRCH_INVERT_SPLIT_INDEX_BLOCK_MAXIMUM_LENGTH(uiIndexBlockDataLength, uiTotalTermCount));
+                ASSERT((pucIndexBlockDataPtr + uiIndexBlockDataLength + uiSplitIndexBlockDataLength) <= (psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + uiIndexBlockLength));
+
+                s_memmove(pucIndexBlockDataPtr, pucIndexBlockDataPtr + uiIndexBlockDataLength, uiSplitIndexBlockDataLength);
+                uiIndexBlockDataLength = uiSplitIndexBlockDataLength;
+            }
+
+            /* Append the skip list to the index block data if this term has enough postings to warrant one */
+            if ( (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_SKIP_LIST) && (uiTotalTermCount > SRCH_INVERT_SKIP_LIST_INTERVAL) ) {
+
+                if ( (iError = iSrchInvertCreateSkipList(pucIndexBlockDataPtr, uiIndexBlockDataLength, 
+                        (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM) ? true : false, 
+                        (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX) ? true : false, 
+                        (uiImpactsLength > 0) ? pucIndexBlockDataPtr - uiImpactsLength : NULL, 
+                        pucIndexBlockDataPtr + uiIndexBlockDataLength, &uiSkipListLength)) != SRCH_NoError ) {
+                    iUtlRoaringFree(pvUtlRoaring);
+                    return (iError);
+                }
+
+                ASSERT(uiSkipListLength <= SRCH_INVERT_SKIP_LIST_MAXIMUM_LENGTH(uiTotalTermCount));
+                ASSERT((pucIndexBlockDataPtr + uiIndexBlockDataLength + uiSkipListLength) <= (psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + uiIndexBlockLength));
+            }
+        }
+
+
+        /* Serialize the document containers after the index block data and the skip list if there is one */
+        if ( pvUtlRoaring != NULL ) {
+
+            iError = iUtlRoaringSerialize(pvUtlRoaring, pucIndexBlockDataPtr + uiIndexBlockDataLength + uiSkipListLength, &uiDocumentContainersLength);
+
+            iUtlRoaringFree(pvUtlRoaring);
+            pvUtlRoaring = NULL;
+
+            if ( iError != UTL_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to serialize the document containers, utl error: %d.", iError);
+                return (SRCH_InvertDocumentContainersFailed);
+            }
+
+            ASSERT((pucIndexBlockDataPtr + uiIndexBlockDataLength + uiSkipListLength + uiDocumentContainersLength) <= 
+                    (psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + uiIndexBlockLength));
+        }
+
+
         /* Get the size we will need to store the index block data length in compressed form */
         UTL_NUM_GET_COMPRESSED_UINT_SIZE(uiIndexBlockDataLength, uiIndexBlockDataLengthSize);
         ASSERT(uiIndexBlockDataLengthSize <= SRCH_INVERT_INDEX_BLOCK_DATA_COMPRESSED_LENGTH_SIZE);
 
+        /* Get the size we will need to store the document containers length in compressed form if the index has document containers */
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS ) {
+            UTL_NUM_GET_COMPRESSED_UINT_SIZE(uiDocumentContainersLength, uiDocumentContainersLengthSize);
+            ASSERT(uiDocumentContainersLengthSize <= SRCH_INVERT_DOCUMENT_CONTAINERS_COMPRESSED_LENGTH_SIZE);
+        }
+
+        /* Get the size we will need to store the impact count in compressed form if the index has impacts */
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_IMPACTS ) {
+            UTL_NUM_GET_COMPRESSED_UINT_SIZE(uiImpactsLength, uiImpactsLengthSize);
+            ASSERT(uiImpactsLengthSize <= SRCH_INVERT_IMPACTS_COMPRESSED_LENGTH_SIZE);
+        }
+
+        /* Get the length of the index block header, the impacts are part of it */
+        uiIndexBlockHeaderLength = uiIndexBlockDataLengthSize + uiDocumentContainersLengthSize;
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_IMPACTS ) {
+            uiIndexBlockHeaderLength += uiImpactsLengthSize + SRCH_INVERT_IMPACTS_SCALE_SIZE + uiImpactsLength;
+        }
+        ASSERT(uiIndexBlockHeaderLength <= uiVariableIndexBlockDataLengthSize);
+
         /* Get the a pointer to the place where we need to write the compressed index block data 
         ** length, this is also the start of the index block
         */
-        pucIndexBlockPtr = psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + (SRCH_INVERT_INDEX_BLOCK_DATA_COMPRESSED_LENGTH_SIZE - uiIndexBlockDataLengthSize);
+        pucIndexBlockPtr = pucIndexBlockDataPtr - uiIndexBlockHeaderLength;
 
-        /* Write the size of the index block in the space we saved for it */
+        /* Write the size of the index block, the size of the document containers, and the impact 
+        ** count and the scale, in the space we saved for it, the impacts are already in place
+        */
         UTL_NUM_WRITE_COMPRESSED_UINT(uiIndexBlockDataLength, pucIndexBlockPtr);
-        ASSERT((pucIndexBlockPtr - psiSrchIndex->psibSrchIndexBuild->pucIndexBlock) == SRCH_INVERT_INDEX_BLOCK_DATA_COMPRESSED_LENGTH_SIZE);
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS ) {
+            UTL_NUM_WRITE_COMPRESSED_UINT(uiDocumentContainersLength, pucIndexBlockPtr);
+        }
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_IMPACTS ) {
+            UTL_NUM_WRITE_COMPRESSED_UINT(uiImpactsLength, pucIndexBlockPtr);
+
+            /* The scale is stored as the bits of the float, copied rather than cast to keep clear of aliasing */
+            s_memcpy(&uiImpactsScale, &fImpactsScale, sizeof(float));
+            UTL_NUM_WRITE_UINT(uiImpactsScale, sizeof(float), pucIndexBlockPtr);
+        }
+        ASSERT(pucIndexBlockPtr == (pucIndexBlockDataPtr - uiImpactsLength));
 
         /* Get the a pointer to the start of the index block */
-        pucIndexBlockPtr = psiSrchIndex->psibSrchIndexBuild->pucIndexBlock + (SRCH_INVERT_INDEX_BLOCK_DATA_COMPRESSED_LENGTH_SIZE - uiIndexBlockDataLengthSize);
+        pucIndexBlockPtr = pucIndexBlockDataPtr - uiIndexBlockHeaderLength;
 
         /* Store the block */
-        if ( (iError = iUtlDataAddEntry(psiSrchIndex->pvUtlIndexData, (void *)pucIndexBlockPtr, uiIndexBlockDataLength + uiIndexBlockDataLengthSize, &ulIndexBlockObjectID)) != UTL_NoError ) {
+        if ( (iError = iUtlDataAddEntry(psiSrchIndex->pvUtlIndexData, (void *)pucIndexBlockPtr, 
+                uiIndexBlockHeaderLength + uiIndexBlockDataLength + uiSkipListLength + uiDocumentContainersLength, 
+                &ulIndexBlockObjectID)) != UTL_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to store an index block in the repository, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
             return (SRCH_InvertBlockObjectStoreFailed);
         }
@@ -2807,8 +3197,13 @@ static int iSrchInvertCompressIndexBlock
 {
     
     unsigned char   *pucReadPtr = NULL;
+    unsigned char   *pucReadEnd = NULL;
     unsigned char   *pucWritePtr = NULL;
 
+    unsigned int    puiIndexEntries[SRCH_INVERT_INDEX_ENTRIES_LENGTH * SRCH_INVERT_INDEX_ENTRY_LENGTH];
+    unsigned int    *puiIndexEntriesPtr = NULL;
+    unsigned int    *puiIndexEntriesEnd = NULL;
+
     unsigned int    uiIndexEntryDocumentID = 0;
     unsigned int    uiIndexEntryTermPosition = 0;
     unsigned int    uiIndexEntryFieldID = 0;
@@ -2834,17 +3229,34 @@ static int iSrchInvertCompressIndexBlock
 
     /* Initialize the pointers */
     pucReadPtr = pucIndexBlock;
+    pucReadEnd = pucIndexBlock + (*puiIndexBlockLength);
     pucWritePtr = pucIndexBlock;
 
 
-    /* Loop while there is stuff to scan */
-    while ( pucReadPtr < (pucIndexBlock + (*puiIndexBlockLength)) ) {
+    /* Loop while there is stuff to scan, the index entries are decoded in bulk ahead of 
+    ** where we write, this is safe because an entry never gets longer when it is compressed
+    */
+    while ( (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucReadPtr < pucReadEnd) ) {
 
 /* Compressed int */
+        /* Decode the next index entries if we have used them all up */
+        if ( puiIndexEntriesPtr >= puiIndexEntriesEnd ) {
+
+            unsigned int    uiIndexEntriesLength = 0;
+
+            iUtlNumReadCompressedUIntArray(&pucReadPtr, pucReadEnd, puiIndexEntries, 
+                    SRCH_INVERT_INDEX_ENTRIES_LENGTH * SRCH_INVERT_INDEX_ENTRY_LENGTH, &uiIndexEntriesLength);
+            ASSERT((uiIndexEntriesLength % SRCH_INVERT_INDEX_ENTRY_LENGTH) == 0);
+
+            puiIndexEntriesPtr = puiIndexEntries;
+            puiIndexEntriesEnd = puiIndexEntries + uiIndexEntriesLength;
+        }
+
         /* Read the index entry */
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDocumentID, pucReadPtr);
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermPosition, pucReadPtr);
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucReadPtr);
+        uiIndexEntryDocumentID = puiIndexEntriesPtr[0];
+        uiIndexEntryTermPosition = puiIndexEntriesPtr[1];
+        uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+        puiIndexEntriesPtr += SRCH_INVERT_INDEX_ENTRY_LENGTH;
 /*         UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucReadPtr); */
 
 
@@ -2940,6 +3352,785 @@ static int iSrchInvertCompressIndexBlock
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchInvertBitPackIndexBlock()
+
+    Purpose:    Bit packs a compressed index block into frames, the format is 
+                described with the defines at the top of this file.
+
+                This is a scalar bit packing, each array in a frame is packed 
+                in the bit width of its largest number, so a frame costs as 
+                much as its largest delta document ID, term position and field 
+                ID allow, and frames are unpacked an array at a time.
+
+    Parameters: pucIndexBlock                   compressed index block
+                uiIndexBlockLength              compressed index block length
+                uiIndexEntriesCount             maximum number of index entries in the compressed index block
+                bBlockMax                       set to true to add block maximums
+                pucImpacts                      impacts, one per document, the block maximums are 
+                                                maximum impacts if these are set (optional)
+                pucBitPackedIndexBlock          bit packed index block (allocated by caller)
+                puiBitPackedIndexBlockLength    return pointer for the bit packed index block length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchInvertBitPackIndexBlock
+(
+    unsigned char *pucIndexBlock,
+    unsigned int uiIndexBlockLength,
+    unsigned int uiIndexEntriesCount,
+    boolean bBlockMax,
+    unsigned char *pucImpacts,
+    unsigned char *pucBitPackedIndexBlock,
+    unsigned int *puiBitPackedIndexBlockLength
+)
+{
+
+    int             iError = SRCH_NoError;
+
+    unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned char   *pucIndexBlockEndPtr = NULL;
+    unsigned char   *pucBitPackedIndexBlockPtr = NULL;
+
+    unsigned int    puiIndexEntries[SRCH_INVERT_INDEX_ENTRIES_LENGTH * SRCH_INVERT_INDEX_ENTRY_LENGTH];
+    unsigned int    uiIndexEntriesLength = 0;
+    unsigned int    *puiIndexEntriesPtr = NULL;
+    unsigned int    *puiIndexEntriesEnd = NULL;
+
+    unsigned int    uiFrameCount = 0;
+    unsigned int    uiFrameIndex = 0;
+    unsigned int    uiFrameEntriesCount = 0;
+    unsigned int    uiFrameDocumentID = 0;
+    unsigned int    uiIndexEntryDocumentID = 0;
+    unsigned int    puiBitWidths[SRCH_INVERT_INDEX_ENTRY_LENGTH];
+    unsigned int    uiI = 0;
+
+    unsigned int    *puiMaximumDocumentPostingsCounts = NULL;
+    unsigned int    uiDocumentFrameIndex = 0;
+    unsigned int    uiDocumentPostingsCount = 0;
+    unsigned int    uiDocumentCount = 0;
+
+
+    ASSERT(pucIndexBlock != NULL);
+    ASSERT(uiIndexBlockLength > 0);
+    ASSERT(uiIndexEntriesCount > 0);
+    ASSERT(pucBitPackedIndexBlock != NULL);
+    ASSERT(puiBitPackedIndexBlockLength != NULL);
+
+
+    /* Work out the maximum number of postings per document for each frame if block maximums were requested, 
+    ** we need these up front because they go in the frame headers and documents can run across frames
+    */
+    if ( bBlockMax == true ) {
+
+        /* Allocate the maximums, one per frame */
+        uiFrameCount = (uiIndexEntriesCount / SRCH_INVERT_INDEX_ENTRIES_LENGTH) + 1;
+        if ( (puiMaximumDocumentPostingsCounts = (unsigned int *)s_malloc((size_t)(uiFrameCount * sizeof(unsigned int)))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchInvertBitPackIndexBlock;
+        }
+
+        /* Loop over the frames */
+        for ( pucIndexBlockPtr = pucIndexBlock, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockLength, uiFrameIndex = 0; 
+                pucIndexBlockPtr < pucIndexBlockEndPtr; uiFrameIndex++ ) {
+
+            /* Decode the frame */
+            iUtlNumReadCompressedUIntArray(&pucIndexBlockPtr, pucIndexBlockEndPtr, puiIndexEntries, 
+                    SRCH_INVERT_INDEX_ENTRIES_LENGTH * SRCH_INVERT_INDEX_ENTRY_LENGTH, &uiIndexEntriesLength);
+            ASSERT((uiIndexEntriesLength % SRCH_INVERT_INDEX_ENTRY_LENGTH) == 0);
+            ASSERT(uiFrameIndex < uiFrameCount);
+
+            /* Loop over the index entries, folding the postings count of the previous document, or its 
+            ** impact, into the maximum of the frame it started in if we are on a new document
+            */
+            for ( puiIndexEntriesPtr = puiIndexEntries, puiIndexEntriesEnd = puiIndexEntries + uiIndexEntriesLength; 
+                    puiIndexEntriesPtr < puiIndexEntriesEnd; puiIndexEntriesPtr += SRCH_INVERT_INDEX_ENTRY_LENGTH ) {
+
+                if ( puiIndexEntriesPtr[0] != 0 ) {
+                    if ( uiDocumentCount > 0 ) {
+                        puiMaximumDocumentPostingsCounts[uiDocumentFrameIndex] = UTL_MACROS_MAX(puiMaximumDocumentPostingsCounts[uiDocumentFrameIndex], 
+                                (pucImpacts != NULL) ? pucImpacts[uiDocumentCount - 1] : uiDocumentPostingsCount);
+                    }
+                    uiDocumentFrameIndex = uiFrameIndex;
+                    uiDocumentPostingsCount = 0;
+                    uiDocumentCount++;
+                }
+
+                uiDocumentPostingsCount++;
+            }
+        }
+
+        /* Fold in the postings count, or the impact, of the last document */
+        puiMaximumDocumentPostingsCounts[uiDocumentFrameIndex] = UTL_MACROS_MAX(puiMaximumDocumentPostingsCounts[uiDocumentFrameIndex], 
+                (pucImpacts != NULL) ? pucImpacts[uiDocumentCount - 1] : uiDocumentPostingsCount);
+    }
+
+
+    /* Loop over the frames */
+    for ( pucIndexBlockPtr = pucIndexBlock, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockLength, pucBitPackedIndexBlockPtr = pucBitPackedIndexBlock, uiFrameIndex = 0; 
+            pucIndexBlockPtr < pucIndexBlockEndPtr; uiFrameIndex++ ) {
+
+        /* Decode the frame */
+        iUtlNumReadCompressedUIntArray(&pucIndexBlockPtr, pucIndexBlockEndPtr, puiIndexEntries, 
+                SRCH_INVERT_INDEX_ENTRIES_LENGTH * SRCH_INVERT_INDEX_ENTRY_LENGTH, &uiIndexEntriesLength);
+        ASSERT((uiIndexEntriesLength % SRCH_INVERT_INDEX_ENTRY_LENGTH) == 0);
+        ASSERT(uiIndexEntriesLength > 0);
+
+        uiFrameEntriesCount = uiIndexEntriesLength / SRCH_INVERT_INDEX_ENTRY_LENGTH;
+
+
+        /* Get the last document ID in the frame, and the largest delta document ID, term position and field ID */
+        for ( uiI = 0; uiI < SRCH_INVERT_INDEX_ENTRY_LENGTH; uiI++ ) {
+            puiBitWidths[uiI] = 0;
+        }
+
+        for ( puiIndexEntriesPtr = puiIndexEntries, puiIndexEntriesEnd = puiIndexEntries + uiIndexEntriesLength; 
+                puiIndexEntriesPtr < puiIndexEntriesEnd; puiIndexEntriesPtr += SRCH_INVERT_INDEX_ENTRY_LENGTH ) {
+            uiIndexEntryDocumentID += puiIndexEntriesPtr[0];
+            puiBitWidths[0] |= puiIndexEntriesPtr[0];
+            puiBitWidths[1] |= puiIndexEntriesPtr[1];
+            puiBitWidths[2] |= puiIndexEntriesPtr[2];
+        }
+
+        /* Turn them into bit widths */
+        for ( uiI = 0; uiI < SRCH_INVERT_INDEX_ENTRY_LENGTH; uiI++ ) {
+            UTL_NUM_GET_BIT_PACKED_UINT_WIDTH(puiBitWidths[uiI], puiBitWidths[uiI]);
+        }
+
+
+        /* Write the frame header */
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiFrameEntriesCount, pucBitPackedIndexBlockPtr);
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiIndexEntryDocumentID - uiFrameDocumentID, pucBitPackedIndexBlockPtr);
+        if ( bBlockMax == true ) {
+            ASSERT(uiFrameIndex < uiFrameCount);
+            UTL_NUM_WRITE_COMPRESSED_UINT(puiMaximumDocumentPostingsCounts[uiFrameIndex], pucBitPackedIndexBlockPtr);
+        }
+        for ( uiI = 0; uiI < SRCH_INVERT_INDEX_ENTRY_LENGTH; uiI++ ) {
+            UTL_NUM_WRITE_UINT(puiBitWidths[uiI], SRCH_INVERT_FRAME_BIT_WIDTH_SIZE, pucBitPackedIndexBlockPtr);
+        }
+
+        uiFrameDocumentID = uiIndexEntryDocumentID;
+
+
+        /* Write the bit packed delta document IDs, term positions and field IDs */
+        for ( uiI = 0; uiI < SRCH_INVERT_INDEX_ENTRY_LENGTH; uiI++ ) {
+            if ( (iError = iUtlNumWriteBitPackedUIntArray(puiIndexEntries + uiI, uiFrameEntriesCount, SRCH_INVERT_INDEX_ENTRY_LENGTH, 
+                    puiBitWidths[uiI], &pucBitPackedIndexBlockPtr)) != UTL_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to bit pack an index block frame, utl error: %d.", iError);
+                iError = SRCH_InvertIndexBlockWriteFailed;
+                goto bailFromiSrchInvertBitPackIndexBlock;
+            }
+        }
+    }
+
+
+    /* Set the return pointer */
+    *puiBitPackedIndexBlockLength = pucBitPackedIndexBlockPtr - pucBitPackedIndexBlock;
+
+
+
+    /* Bail label */
+    bailFromiSrchInvertBitPackIndexBlock:
+
+    /* Free the maximums */
+    s_free(puiMaximumDocumentPostingsCounts);
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchInvertSplitIndexBlock()
+
+    Purpose:    Splits a compressed index block into a document stream and a 
+                term position stream, the format is described with the defines 
+                at the top of this file.
+
+                The term position stream is built over the start of the 
+                compressed index block as it is read, so the compressed index 
+                block is overwritten.
+
+    Parameters: pucIndexBlock               compressed index block
+                uiIndexBlockLength          compressed index block length
+                pucSplitIndexBlock          split index block (allocated by caller)
+                puiSplitIndexBlockLength    return pointer for the split index block length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchInvertSplitIndexBlock
+(
+    unsigned char *pucIndexBlock,
+    unsigned int uiIndexBlockLength,
+    unsigned char *pucSplitIndexBlock,
+    unsigned int *puiSplitIndexBlockLength
+)
+{
+
+    unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned char   *pucIndexBlockEndPtr = NULL;
+    unsigned char   *pucTermPositionsPtr = NULL;
+    unsigned char   *pucDocumentsPtr = NULL;
+    unsigned char   *pucSplitIndexBlockPtr = NULL;
+
+    unsigned int    uiIndexEntryDeltaDocumentID = 0;
+    unsigned int    uiIndexEntryTermPosition = 0;
+    unsigned int    uiIndexEntryFieldID = 0;
+
+    unsigned int    uiRunDeltaDocumentID = 0;
+    unsigned int    uiRunFieldID = 0;
+    unsigned int    uiRunPostingsCount = 0;
+
+    unsigned int    uiDocumentsLength = 0;
+    unsigned int    uiTermPositionsLength = 0;
+
+
+    ASSERT(pucIndexBlock != NULL);
+    ASSERT(uiIndexBlockLength > 0);
+    ASSERT(pucSplitIndexBlock != NULL);
+    ASSERT(puiSplitIndexBlockLength != NULL);
+
+
+    /* Loop over the index entries, writing the runs to the document stream, leaving space for its length,
+    ** and writing the term positions to the term position stream over the index entries already read
+    */
+    for ( pucIndexBlockPtr = pucIndexBlock, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockLength, pucTermPositionsPtr = pucIndexBlock,
+            pucDocumentsPtr = pucSplitIndexBlock + UTL_NUM_COMPRESSED_UINT_MAX_SIZE; pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+
+        /* Read the index entry */
+        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
+        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermPosition, pucIndexBlockPtr);
+        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
+
+        /* Write out the current run if this posting is in another document or field, or if the run is full */
+        if ( (uiRunPostingsCount > 0) && 
+                ((uiIndexEntryDeltaDocumentID != 0) || (uiIndexEntryFieldID != uiRunFieldID) || (uiRunPostingsCount == SRCH_INDEX_BLOCK_FRAME_LENGTH)) ) {
+            UTL_NUM_WRITE_COMPRESSED_UINT(uiRunDeltaDocumentID, pucDocumentsPtr);
+            UTL_NUM_WRITE_COMPRESSED_UINT(uiRunFieldID, pucDocumentsPtr);
+            UTL_NUM_WRITE_COMPRESSED_UINT(uiRunPostingsCount, pucDocumentsPtr);
+            uiRunPostingsCount = 0;
+        }
+
+        /* Start a new run */
+        if ( uiRunPostingsCount == 0 ) {
+            uiRunDeltaDocumentID = uiIndexEntryDeltaDocumentID;
+            uiRunFieldID = uiIndexEntryFieldID;
+        }
+
+        /* Add the posting to the run, its term position is never longer than the index entry it came from */
+        uiRunPostingsCount++;
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiIndexEntryTermPosition, pucTermPositionsPtr);
+        ASSERT(pucTermPositionsPtr <= pucIndexBlockPtr);
+    }
+
+    /* Write out the last run */
+    if ( uiRunPostingsCount > 0 ) {
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiRunDeltaDocumentID, pucDocumentsPtr);
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiRunFieldID, pucDocumentsPtr);
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiRunPostingsCount, pucDocumentsPtr);
+    }
+
+
+    /* Get the stream lengths */
+    uiDocumentsLength = pucDocumentsPtr - (pucSplitIndexBlock + UTL_NUM_COMPRESSED_UINT_MAX_SIZE);
+    uiTermPositionsLength = pucTermPositionsPtr - pucIndexBlock;
+
+    /* Write the document stream length, and move the document stream up behind it */
+    pucSplitIndexBlockPtr = pucSplitIndexBlock;
+    UTL_NUM_WRITE_COMPRESSED_UINT(uiDocumentsLength, pucSplitIndexBlockPtr);
+    s_memmove(pucSplitIndexBlockPtr, pucSplitIndexBlock + UTL_NUM_COMPRESSED_UINT_MAX_SIZE, uiDocumentsLength);
+    pucSplitIndexBlockPtr += uiDocumentsLength;
+
+    /* Copy the term position stream behind the document stream */
+    s_memcpy(pucSplitIndexBlockPtr, pucIndexBlock, uiTermPositionsLength);
+    pucSplitIndexBlockPtr += uiTermPositionsLength;
+
+
+    /* Set the return pointer */
+    *puiSplitIndexBlockLength = pucSplitIndexBlockPtr - pucSplitIndexBlock;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchInvertCreateSkipList()
+
+    Purpose:    Creates a skip list for an index block. A skip list entry 
+                is added every SRCH_INVERT_SKIP_LIST_INTERVAL postings, but 
+                only on a document boundary so that decoding can be started
+                at any entry offset with the document ID of that entry.
+
+                The maximum number of postings per document in each run is 
+                added if block maximums were requested, or the maximum impact
+                per document if impacts are passed.
+
+    Parameters: pucIndexBlock           compressed or split index block
+                uiIndexBlockLength      compressed or split index block length
+                bPositionStream         set to true if the index block is split
+                bBlockMax               set to true to add block maximums
+                pucImpacts              impacts, one per document (optional)
+                pucSkipList             skip list (allocated by caller)
+                puiSkipListLength       return pointer for the skip list length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchInvertCreateSkipList
+(
+    unsigned char *pucIndexBlock,
+    unsigned int uiIndexBlockLength,
+    boolean bPositionStream,
+    boolean bBlockMax,
+    unsigned char *pucImpacts,
+    unsigned char *pucSkipList,
+    unsigned int *puiSkipListLength
+)
+{
+
+    unsigned char   *pucIndexBlockStartPtr = NULL;
+    unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned char   *pucIndexBlockEndPtr = NULL;
+    unsigned char   *pucIndexEntryPtr = NULL;
+    unsigned char   *pucTermPositionsStartPtr = NULL;
+    unsigned char   *pucTermPositionsPtr = NULL;
+    unsigned char   *pucTermPositionEntryPtr = NULL;
+    unsigned char   *pucSkipListPtr = NULL;
+
+    unsigned int    uiDocumentsLength = 0;
+
+    unsigned int    uiIndexEntryDocumentID = 0;
+    unsigned int    uiIndexEntryDeltaDocumentID = 0;
+    unsigned int    uiIndexEntryPostingsCount = 0;
+
+    unsigned int    uiPostingsCount = 0;
+
+    unsigned int    uiSkipEntryCount = 0;
+    unsigned int    uiSkipEntryDocumentID = 0;
+    unsigned int    uiSkipEntryOffset = 0;
+    unsigned int    uiSkipEntryTermPositionsOffset = 0;
+    unsigned int    uiSkipEntryDeltaDocumentID = 0;
+    unsigned int    uiSkipEntryDeltaOffset = 0;
+    unsigned int    uiSkipEntryDeltaTermPositionsOffset = 0;
+
+    unsigned int    uiDocumentPostingsCount = 0;
+    unsigned int    uiMaximumDocumentPostingsCount = 0;
+    unsigned int    uiDocumentCount = 0;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(pucIndexBlock != NULL);
+    ASSERT(uiIndexBlockLength > 0);
+    ASSERT(pucSkipList != NULL);
+    ASSERT(puiSkipListLength != NULL);
+
+
+    /* Get the start and the end of the index entries, these are the runs in the 
+    ** document stream if the index block is split
+    */
+    pucIndexBlockStartPtr = pucIndexBlock;
+    pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockLength;
+    if ( bPositionStream == true ) {
+        UTL_NUM_READ_COMPRESSED_UINT(uiDocumentsLength, pucIndexBlockStartPtr);
+        pucIndexBlockEndPtr = pucIndexBlockStartPtr + uiDocumentsLength;
+        pucTermPositionsStartPtr = pucIndexBlockEndPtr;
+    }
+
+
+    /* Count the skip list entries, we need this up front because the count leads the skip list */
+    for ( pucIndexBlockPtr = pucIndexBlockStartPtr, uiPostingsCount = 0, uiSkipEntryCount = 0; pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+
+        /* Read the index entry */
+        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+        if ( bPositionStream == true ) {
+            UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryPostingsCount, pucIndexBlockPtr);
+        }
+        else {
+            UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+            uiIndexEntryPostingsCount = 1;
+        }
+
+        /* Count an entry if we are on a new document and we have seen enough postings */
+        if ( (uiIndexEntryDeltaDocumentID != 0) && (uiPostingsCount >= SRCH_INVERT_SKIP_LIST_INTERVAL) ) {
+            uiSkipEntryCount++;
+            uiPostingsCount = 0;
+        }
+
+        uiPostingsCount += uiIndexEntryPostingsCount;
+    }
+
+
+    /* Write the skip list entry count */
+    pucSkipListPtr = pucSkipList;
+    UTL_NUM_WRITE_COMPRESSED_UINT(uiSkipEntryCount, pucSkipListPtr);
+    
+    /* No entries, a single document can hold all the postings */
+    if ( uiSkipEntryCount == 0 ) {
+        *puiSkipListLength = 0;
+        return (SRCH_NoError);
+    }
+
+
+    /* Write the skip list entries */
+    for ( pucIndexBlockPtr = pucIndexBlockStartPtr, pucTermPositionsPtr = pucTermPositionsStartPtr, uiPostingsCount = 0, uiIndexEntryDocumentID = 0; 
+            pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+
+        /* Save the start of this index entry, and of its term positions */
+        pucIndexEntryPtr = pucIndexBlockPtr;
+        pucTermPositionEntryPtr = pucTermPositionsPtr;
+
+        /* Read the index entry, skipping over its term positions */
+        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+        if ( bPositionStream == true ) {
+            UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryPostingsCount, pucIndexBlockPtr);
+            for ( uiI = 0; uiI < uiIndexEntryPostingsCount; uiI++ ) {
+                UTL_NUM_SKIP_COMPRESSED_UINT(pucTermPositionsPtr);
+            }
+        }
+        else {
+            UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+            uiIndexEntryPostingsCount = 1;
+        }
+
+        /* Fold the postings count of the previous document, or its impact, into the run maximum if we are on a new document */
+        if ( uiIndexEntryDeltaDocumentID != 0 ) {
+            if ( uiDocumentCount > 0 ) {
+                uiMaximumDocumentPostingsCount = UTL_MACROS_MAX(uiMaximumDocumentPostingsCount, 
+                        (pucImpacts != NULL) ? pucImpacts[uiDocumentCount - 1] : uiDocumentPostingsCount);
+            }
+            uiDocumentPostingsCount = 0;
+            uiDocumentCount++;
+        }
+
+        /* Add an entry if we are on a new document and we have seen enough postings, the 
+        ** entry marks the last document ID of the run and the offset of the next run
+        */
+        if ( (uiIndexEntryDeltaDocumentID != 0) && (uiPostingsCount >= SRCH_INVERT_SKIP_LIST_INTERVAL) ) {
+            
+            /* Work out the deltas */
+            uiSkipEntryDeltaDocumentID = uiIndexEntryDocumentID - uiSkipEntryDocumentID;
+            uiSkipEntryDeltaOffset = (pucIndexEntryPtr - pucIndexBlockStartPtr) - uiSkipEntryOffset;
+
+            ASSERT(uiSkipEntryDeltaDocumentID > 0);
+            ASSERT(uiSkipEntryDeltaOffset > 0);
+
+            /* Write the entry */
+            UTL_NUM_WRITE_COMPRESSED_UINT(uiSkipEntryDeltaDocumentID, pucSkipListPtr);
+            UTL_NUM_WRITE_COMPRESSED_UINT(uiSkipEntryDeltaOffset, pucSkipListPtr);
+            if ( bPositionStream == true ) {
+                uiSkipEntryDeltaTermPositionsOffset = (pucTermPositionEntryPtr - pucTermPositionsStartPtr) - uiSkipEntryTermPositionsOffset;
+                UTL_NUM_WRITE_COMPRESSED_UINT(uiSkipEntryDeltaTermPositionsOffset, pucSkipListPtr);
+                uiSkipEntryTermPositionsOffset = pucTermPositionEntryPtr - pucTermPositionsStartPtr;
+            }
+            if ( bBlockMax == true ) {
+                UTL_NUM_WRITE_COMPRESSED_UINT(uiMaximumDocumentPostingsCount, pucSkipListPtr);
+            }
+
+            uiSkipEntryDocumentID = uiIndexEntryDocumentID;
+            uiSkipEntryOffset = pucIndexEntryPtr - pucIndexBlockStartPtr;
+            uiPostingsCount = 0;
+            uiMaximumDocumentPostingsCount = 0;
+        }
+
+        /* Set the document ID and count the postings against it */
+        uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
+        uiDocumentPostingsCount += uiIndexEntryPostingsCount;
+        uiPostingsCount += uiIndexEntryPostingsCount;
+    }
+
+
+    /* Write the maximum for the last run */
+    if ( bBlockMax == true ) {
+        uiMaximumDocumentPostingsCount = UTL_MACROS_MAX(uiMaximumDocumentPostingsCount, 
+                (pucImpacts != NULL) ? pucImpacts[uiDocumentCount - 1] : uiDocumentPostingsCount);
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiMaximumDocumentPostingsCount, pucSkipListPtr);
+    }
+
+
+    /* Set the return pointer */
+    *puiSkipListLength = pucSkipListPtr - pucSkipList;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchInvertCreateDocumentContainers()
+
+    Purpose:    Creates the document containers for an index block, these are
+                a roaring structure holding the document IDs in the index block.
+
+    Parameters: pucIndexBlock           compressed index block
+                uiIndexBlockLength      compressed index block length
+                ppvUtlRoaring           return pointer for the roaring structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchInvertCreateDocumentContainers
+(
+    unsigned char *pucIndexBlock,
+    unsigned int uiIndexBlockLength,
+    void **ppvUtlRoaring
+)
+{
+
+    int             iError = UTL_NoError;
+    unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned char   *pucIndexBlockEndPtr = NULL;
+    unsigned int    uiIndexEntryDocumentID = 0;
+    unsigned int    uiIndexEntryDeltaDocumentID = 0;
+    void            *pvUtlRoaring = NULL;
+
+
+    ASSERT(pucIndexBlock != NULL);
+    ASSERT(uiIndexBlockLength > 0);
+    ASSERT(ppvUtlRoaring != NULL);
+
+
+    /* Create the roaring structure */
+    if ( (iError = iUtlRoaringCreate(&pvUtlRoaring)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a roaring structure, utl error: %d.", iError);
+        return (SRCH_InvertDocumentContainersFailed);
+    }
+
+
+    /* Loop over the index entries, adding the document ID of every new document */
+    for ( pucIndexBlockPtr = pucIndexBlock, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockLength; pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+
+        /* Read the index entry, we only need the document ID */
+        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+
+        /* Add the document ID if this is a new document */
+        if ( uiIndexEntryDeltaDocumentID != 0 ) {
+
+            uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
+
+            if ( (iError = iUtlRoaringAddValue(pvUtlRoaring, uiIndexEntryDocumentID)) != UTL_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to add a document ID to a roaring structure, utl error: %d.", iError);
+                iUtlRoaringFree(pvUtlRoaring);
+                return (SRCH_InvertDocumentContainersFailed);
+            }
+        }
+    }
+
+
+    /* Set the return pointer */
+    *ppvUtlRoaring = pvUtlRoaring;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchInvertCreateImpacts()
+
+    Purpose:    Creates the impacts for an index block, one per document in 
+                the index block, the format is described with the defines at 
+                the top of this file.
+
+                The document term counts are read from the document table the 
+                first time this is called, they are needed for all the terms.
+
+    Parameters: psiSrchIndex            search index structure
+                pucIndexBlock           compressed index block
+                uiIndexBlockLength      compressed index block length
+                uiTermCount             term count
+                uiDocumentCount         document count
+                pucImpacts              impacts (allocated by caller)
+                uiImpactsCapacity       impacts capacity
+                puiImpactsLength        return pointer for the impact count
+                pfImpactsScale          return pointer for the impacts scale
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchInvertCreateImpacts
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucIndexBlock,
+    unsigned int uiIndexBlockLength,
+    unsigned int uiTermCount,
+    unsigned int uiDocumentCount,
+    unsigned char *pucImpacts,
+    unsigned int uiImpactsCapacity,
+    unsigned int *puiImpactsLength,
+    float *pfImpactsScale
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned int    *puiDocumentTermCounts = NULL;
+    unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned char   *pucIndexBlockEndPtr = NULL;
+    unsigned int    uiIndexEntryDocumentID = 0;
+    unsigned int    uiIndexEntryDeltaDocumentID = 0;
+    float           *pfImpacts = NULL;
+    unsigned int    uiImpactsLength = 0;
+    float           fIDFFactor = 0;
+    float           fMaximumImpact = 0;
+    float           fImpactsScale = 0;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild != NULL);
+    ASSERT(pucIndexBlock != NULL);
+    ASSERT(uiIndexBlockLength > 0);
+    ASSERT(pucImpacts != NULL);
+    ASSERT(puiImpactsLength != NULL);
+    ASSERT(pfImpactsScale != NULL);
+
+
+    /* Read the document term counts if we have not done so already */
+    if ( psiSrchIndex->psibSrchIndexBuild->puiDocumentTermCounts == NULL ) {
+
+        unsigned int    uiDocumentID = 0;
+
+        if ( (puiDocumentTermCounts = (unsigned int *)s_malloc((size_t)((psiSrchIndex->uiDocumentCount + 1) * sizeof(unsigned int)))) == NULL ) {
+            return (SRCH_MemError);
+        }
+
+        for ( uiDocumentID = 1; uiDocumentID <= psiSrchIndex->uiDocumentCount; uiDocumentID++ ) {
+            if ( (iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, uiDocumentID, NULL, NULL, NULL, puiDocumentTermCounts + uiDocumentID, 
+                    NULL, NULL, NULL, NULL, 0, false, false, false)) != SRCH_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the document information for document ID: %u, index: '%s', srch error: %d.", 
+                        uiDocumentID, psiSrchIndex->pucIndexName, iError);
+                s_free(puiDocumentTermCounts);
+                return (SRCH_InvertImpactsFailed);
+            }
+        }
+
+        psiSrchIndex->psibSrchIndexBuild->puiDocumentTermCounts = puiDocumentTermCounts;
+    }
+
+    puiDocumentTermCounts = psiSrchIndex->psibSrchIndexBuild->puiDocumentTermCounts;
+
+
+    /* Allocate the unquantized impacts */
+    if ( (pfImpacts = (float *)s_malloc((size_t)(UTL_MACROS_MAX(uiImpactsCapacity, 1) * sizeof(float)))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+
+    /* Get the IDF factor the same way the search does, falling back to the default term weight if it went pear-shaped */
+    fIDFFactor = SRCH_SEARCH_IDF_FACTOR(uiTermCount, uiDocumentCount, psiSrchIndex->uiDocumentCount);
+    if ( fIDFFactor <= 0 ) {
+        fIDFFactor = SRCH_SEARCH_TERM_WEIGHT_DEFAULT;
+    }
+
+
+    /* Loop over the index entries, adding the IDF factor to the impact of the document for each posting */
+    for ( pucIndexBlockPtr = pucIndexBlock, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockLength; pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+
+        /* Read the index entry, we only need the document ID */
+        UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+
+        /* Start a new impact if this is a new document, normalizing the impact of the previous document */
+        if ( uiIndexEntryDeltaDocumentID != 0 ) {
+
+            if ( uiImpactsLength == uiImpactsCapacity ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Index block has more documents than expected: %u.", uiImpactsCapacity);
+                iError = SRCH_InvertImpactsFailed;
+                goto bailFromiSrchInvertCreateImpacts;
+            }
+
+            if ( (uiImpactsLength > 0) && (puiDocumentTermCounts[uiIndexEntryDocumentID] > 0) ) {
+                pfImpacts[uiImpactsLength - 1] /= log(puiDocumentTermCounts[uiIndexEntryDocumentID] + 1);
+            }
+
+            uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
+            ASSERT(uiIndexEntryDocumentID <= psiSrchIndex->uiDocumentCount);
+
+            pfImpacts[uiImpactsLength] = 0;
+            uiImpactsLength++;
+        }
+
+        pfImpacts[uiImpactsLength - 1] += fIDFFactor;
+    }
+
+    /* Normalize the impact of the last document */
+    if ( (uiImpactsLength > 0) && (puiDocumentTermCounts[uiIndexEntryDocumentID] > 0) ) {
+        pfImpacts[uiImpactsLength - 1] /= log(puiDocumentTermCounts[uiIndexEntryDocumentID] + 1);
+    }
+
+
+    /* Get the scale from the largest impact */
+    for ( uiI = 0; uiI < uiImpactsLength; uiI++ ) {
+        fMaximumImpact = UTL_MACROS_MAX(fMaximumImpact, pfImpacts[uiI]);
+    }
+    fImpactsScale = fMaximumImpact / SRCH_INVERT_IMPACT_MAXIMUM;
+
+    /* Quantize the impacts, an impact is never quantized to 0 since the document does contain the term */
+    for ( uiI = 0; uiI < uiImpactsLength; uiI++ ) {
+        pucImpacts[uiI] = (fImpactsScale > 0) ? 
+                (unsigned char)UTL_MACROS_MIN(UTL_MACROS_MAX((unsigned int)((pfImpacts[uiI] / fImpactsScale) + 0.5), 1), SRCH_INVERT_IMPACT_MAXIMUM) : 1;
+    }
+
+
+    /* Set the return pointers */
+    *puiImpactsLength = uiImpactsLength;
+    *pfImpactsScale = fImpactsScale;
+
+
+
+    /* Bail label */
+    bailFromiSrchInvertCreateImpacts:
+
+    /* Free the unquantized impacts */
+    s_free(pfImpacts);
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   pucSrchInvertPrettyPrintFileNumbers()
@@ -61,8 +61,8 @@ extern "C" {
 
 int iSrchInvertInit (struct srchIndex *psiSrchIndex, unsigned char *pucLanguageCode, unsigned char *pucTokenizerName, 
         unsigned char *pucStemmerName, unsigned char *pucStopListName, unsigned char *pucStopListFilePath, 
-        unsigned int uiIndexerMemorySizeMaximum, unsigned int uiTermLengthMinimum,  unsigned int uiTermLengthMaximum, 
-        unsigned char *pucTemporaryDirectoryPath);
+        unsigned int uiIndexBlockFeatures, unsigned int uiIndexerMemorySizeMaximum, unsigned int uiTermLengthMinimum,  
+        unsigned int uiTermLengthMaximum, unsigned char *pucTemporaryDirectoryPath);
 
 int iSrchInvertSwitchLanguage (struct srchIndex *psiSrchIndex, unsigned char *pucLanguageCode);
 
@@ -161,6 +161,15 @@ int iSrchKeyDictGenerate
     unsigned int    uiDocumentTermCountMaximum = 0;
     unsigned int    uiDocumentTermCountMinimum = UINT_MAX;
 
+    unsigned long   ulDocumentAnsiDate = 0;
+    unsigned long   ulDocumentAnsiDateMaximum = 0;
+    unsigned long   ulDocumentAnsiDateMinimum = ULONG_MAX;
+    unsigned int    uiDocumentLanguageID = 0;
+    unsigned int    puiDocumentLanguageIDs[SRCH_INDEX_DOCUMENT_LANGUAGE_IDS_MAXIMUM];
+    unsigned int    uiDocumentLanguageIDsLength = 0;
+    boolean         bDocumentLanguageIDsOverflow = false;
+    unsigned int    uiI = 0;
+
     unsigned char   pucDuplicateDocumentKeysCount[UTL_FILE_PATH_MAX + 1] = {'\0'};
     unsigned char   pucNumberString[UTL_FILE_PATH_MAX + 1] = {'\0'};
 
@@ -194,7 +203,7 @@ int iSrchKeyDictGenerate
 
         /* Read the document information */
         iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, uiDocumentID, NULL, &pucDocumentKeyPtr, 
-                NULL, &uiDocumentTermCount, NULL, NULL, NULL, NULL, 0, false, false, false);
+                NULL, &uiDocumentTermCount, &ulDocumentAnsiDate, &uiDocumentLanguageID, NULL, NULL, 0, false, false, false);
 
         /* Check the error */
         if ( iError != SRCH_NoError ) {
@@ -298,6 +307,33 @@ int iSrchKeyDictGenerate
         
         /* Set the flag telling us that the term counts were set */
         bDocumentTermCountsSet = true;
+        
+        
+        /* Set the max and min document ansi dates */
+        ulDocumentAnsiDateMaximum = UTL_MACROS_MAX(ulDocumentAnsiDateMaximum, ulDocumentAnsiDate);
+        ulDocumentAnsiDateMinimum = UTL_MACROS_MIN(ulDocumentAnsiDateMinimum, ulDocumentAnsiDate);
+        
+        /* Add the document language ID to the document language IDs if it is not there already, 
+        ** we stop keeping them if there are too many languages to be useful
+        */
+        if ( bDocumentLanguageIDsOverflow == false ) {
+            
+            for ( uiI = 0; uiI < uiDocumentLanguageIDsLength; uiI++ ) {
+                if ( puiDocumentLanguageIDs[uiI] == uiDocumentLanguageID ) {
+                    break;
+                }
+            }
+
+            if ( uiI == uiDocumentLanguageIDsLength ) {
+                if ( uiDocumentLanguageIDsLength < SRCH_INDEX_DOCUMENT_LANGUAGE_IDS_MAXIMUM ) {
+                    puiDocumentLanguageIDs[uiDocumentLanguageIDsLength] = uiDocumentLanguageID;
+                    uiDocumentLanguageIDsLength++;
+                }
+                else {
+                    bDocumentLanguageIDsOverflow = true;
+                }
+            }
+        }
     }
 
         
@@ -329,6 +365,27 @@ int iSrchKeyDictGenerate
     }
 
 
+    /* Set the max and min document ansi dates and the document language IDs in the search index structure, 
+    ** these summarize the index so that searches which can't match any document in it can skip it
+    */
+    if ( bDocumentTermCountsSet == true ) {
+        psiSrchIndex->ulDocumentAnsiDateMaximum = ulDocumentAnsiDateMaximum;
+        psiSrchIndex->ulDocumentAnsiDateMinimum = ulDocumentAnsiDateMinimum;
+    }
+    else {
+        psiSrchIndex->ulDocumentAnsiDateMaximum = 0;
+        psiSrchIndex->ulDocumentAnsiDateMinimum = 0;
+    }
+
+    if ( bDocumentLanguageIDsOverflow == false ) {
+        s_memcpy(psiSrchIndex->puiDocumentLanguageIDs, puiDocumentLanguageIDs, sizeof(unsigned int) * uiDocumentLanguageIDsLength);
+        psiSrchIndex->uiDocumentLanguageIDsLength = uiDocumentLanguageIDsLength;
+    }
+    else {
+        psiSrchIndex->uiDocumentLanguageIDsLength = 0;
+    }
+
+
 
     /* Bail label */
     bailFromiSrchKeyDictGenerate:
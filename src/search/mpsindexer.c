@@ -72,6 +72,9 @@
 /* The default stop list name */
 #define SRCH_INDEXER_STOP_LIST_NAME_DEFAULT                 LNG_STOP_LIST_GOOGLE_MODIFIED_NAME
 
+/* The default postings codec name */
+#define SRCH_INDEXER_POSTINGS_CODEC_NAME_DEFAULT            SRCH_INDEXER_POSTINGS_CODEC_COMPRESSED_NAME
+
 
 /*---------------------------------------------------------------------------*/
 
@@ -120,6 +123,11 @@ int main
 
     unsigned char           *pucLocaleName = SRCH_INDEXER_LOCALE_NAME_DEFAULT;
 
+    boolean                 bForwardIndex = false;
+    boolean                 bImpacts = false;
+    boolean                 bTermGrams = false;
+    unsigned int            uiPhoneticKeysFeatures = SRCH_INDEX_BLOCK_FEATURE_NONE;
+
     unsigned char           *pucLogFilePath = UTL_LOG_FILE_STDERR;    
     unsigned int            uiLogLevel = UTL_LOG_LEVEL_INFO;
 
@@ -147,6 +155,7 @@ int main
     siSrchIndexer.pucTokenizerName = NULL;
     siSrchIndexer.pucStopListName = SRCH_INDEXER_STOP_LIST_NAME_DEFAULT;
     siSrchIndexer.pucStopListFilePath = NULL;
+    siSrchIndexer.uiIndexBlockFeatures = SRCH_INDEX_BLOCK_FEATURES_DEFAULT;
 
     siSrchIndexer.uiIndexerMemorySizeMaximum = SRCH_INDEXER_MEMORY_SIZE_DEFAULT;
     siSrchIndexer.bSuppressMessages = false;
@@ -357,6 +366,76 @@ int main
             siSrchIndexer.pucStemmerName = pucNextArgument;
         }
 
+        /* Check for postings codec */
+        else if ( s_strncmp("--postings-codec=", pucNextArgument, s_strlen("--postings-codec=")) == 0 ) {
+
+            /* Get the postings codec name */
+            pucNextArgument += s_strlen("--postings-codec=");
+
+            /* Check the postings codec name and set the index block features from it */
+            if ( s_strcmp(pucNextArgument, SRCH_INDEXER_POSTINGS_CODEC_COMPRESSED_NAME) == 0 ) {
+                siSrchIndexer.uiIndexBlockFeatures = SRCH_INDEX_BLOCK_FEATURES_DEFAULT;
+            }
+            else if ( s_strcmp(pucNextArgument, SRCH_INDEXER_POSTINGS_CODEC_BIT_PACKED_NAME) == 0 ) {
+                siSrchIndexer.uiIndexBlockFeatures = SRCH_INDEX_BLOCK_FEATURES_BIT_PACKED;
+            }
+            else {
+                vVersion();
+                iUtlLogPanic(UTL_LOG_CONTEXT, "Invalid postings codec name: '%s'", pucNextArgument);
+            }
+        }
+
+        /* Check for forward index */
+        else if ( s_strcmp("--forward-index", pucNextArgument) == 0 ) {
+
+            /* Set the forward index flag */
+            bForwardIndex = true;
+        }
+
+        /* Check for impacts */
+        else if ( s_strcmp("--impacts", pucNextArgument) == 0 ) {
+
+            /* Set the impacts flag */
+            bImpacts = true;
+        }
+
+        /* Check for term grams */
+        else if ( s_strcmp("--term-grams", pucNextArgument) == 0 ) {
+
+            /* Set the term grams flag */
+            bTermGrams = true;
+        }
+
+        /* Check for phonetic keys */
+        else if ( s_strncmp("--phonetic-keys=", pucNextArgument, s_strlen("--phonetic-keys=")) == 0 ) {
+
+            unsigned char   *pucPhoneticKeysNamePtr = NULL;
+            unsigned char   *pucPhoneticKeysNamesStrtokPtr = NULL;
+
+            /* Get the phonetic key names */
+            pucNextArgument += s_strlen("--phonetic-keys=");
+
+            /* Check the phonetic key names and set the phonetic keys features from them */
+            for ( pucPhoneticKeysNamePtr = (unsigned char *)s_strtok_r(pucNextArgument, SRCH_INDEXER_PHONETIC_KEYS_SEPARATORS, (char **)&pucPhoneticKeysNamesStrtokPtr); 
+                    pucPhoneticKeysNamePtr != NULL; 
+                    pucPhoneticKeysNamePtr = (unsigned char *)s_strtok_r(NULL, SRCH_INDEXER_PHONETIC_KEYS_SEPARATORS, (char **)&pucPhoneticKeysNamesStrtokPtr) ) {
+
+                if ( s_strcmp(pucPhoneticKeysNamePtr, SRCH_INDEXER_PHONETIC_KEYS_SOUNDEX_NAME) == 0 ) {
+                    uiPhoneticKeysFeatures |= SRCH_INDEX_BLOCK_FEATURE_SOUNDEX_KEYS;
+                }
+                else if ( s_strcmp(pucPhoneticKeysNamePtr, SRCH_INDEXER_PHONETIC_KEYS_METAPHONE_NAME) == 0 ) {
+                    uiPhoneticKeysFeatures |= SRCH_INDEX_BLOCK_FEATURE_METAPHONE_KEYS;
+                }
+                else if ( s_strcmp(pucPhoneticKeysNamePtr, SRCH_INDEXER_PHONETIC_KEYS_PHONIX_NAME) == 0 ) {
+                    uiPhoneticKeysFeatures |= SRCH_INDEX_BLOCK_FEATURE_PHONIX_KEYS;
+                }
+                else {
+                    vVersion();
+                    iUtlLogPanic(UTL_LOG_CONTEXT, "Invalid phonetic key name: '%s'", pucPhoneticKeysNamePtr);
+                }
+            }
+        }
+
         /* Check for minimum term length */
         else if ( s_strncmp("--minimum-term-length=", pucNextArgument, s_strlen("--minimum-term-length=")) == 0 ) {
 
@@ -514,6 +593,29 @@ int main
     }
 
 
+    /* Add the forward index to the index block features, this is done here because the postings codec sets all the index block features,
+    ** the forward index stores term IDs so it needs them too
+    */
+    if ( bForwardIndex == true ) {
+        siSrchIndexer.uiIndexBlockFeatures |= (SRCH_INDEX_BLOCK_FEATURE_FORWARD_INDEX | SRCH_INDEX_BLOCK_FEATURE_TERM_IDS);
+    }
+
+    /* Add the impacts to the index block features, the block maximums are only worth having as maximum impacts */
+    if ( bImpacts == true ) {
+        siSrchIndexer.uiIndexBlockFeatures |= SRCH_INDEX_BLOCK_FEATURE_IMPACTS;
+    }
+
+    /* Add the term grams to the index block features, the term grams map to term IDs so they need them too */
+    if ( bTermGrams == true ) {
+        siSrchIndexer.uiIndexBlockFeatures |= (SRCH_INDEX_BLOCK_FEATURE_TERM_GRAMS | SRCH_INDEX_BLOCK_FEATURE_TERM_IDS);
+    }
+
+    /* Add the phonetic keys to the index block features, the phonetic keys map to term IDs so they need them too */
+    if ( uiPhoneticKeysFeatures != SRCH_INDEX_BLOCK_FEATURE_NONE ) {
+        siSrchIndexer.uiIndexBlockFeatures |= (uiPhoneticKeysFeatures | SRCH_INDEX_BLOCK_FEATURE_TERM_IDS);
+    }
+
+
 
     /* Install signal handlers */
     if ( (iError = iUtlSignalsInstallFatalHandler((void (*)())vUtlSignalsFatalHandler)) != UTL_NoError ) {
@@ -758,6 +860,20 @@ static void vUsage
     printf("                  Stop list term file, overriding the internal stop list, one term per line. \n");
     printf("  --stemmer=name  Stemmer to use, default: '%s', stemmers available: '%s', \n", SRCH_INDEXER_STEMMER_NAME_DEFAULT, LNG_STEMMER_NONE_NAME);
     printf("                  '%s', '%s', '%s'.\n", LNG_STEMMER_PLURAL_NAME, LNG_STEMMER_PORTER_NAME, LNG_STEMMER_LOVINS_NAME);
+    printf("  --postings-codec=name \n");
+    printf("                  Postings codec to use, default: '%s', postings codecs available: '%s', '%s'. \n", 
+            SRCH_INDEXER_POSTINGS_CODEC_NAME_DEFAULT, SRCH_INDEXER_POSTINGS_CODEC_COMPRESSED_NAME, SRCH_INDEXER_POSTINGS_CODEC_BIT_PACKED_NAME);
+    printf("  --forward-index Create a forward index of document term vectors, used for relevance \n");
+    printf("                  feedback by document key. \n");
+    printf("  --impacts       Store a precomputed quantized impact per document in the index blocks, \n");
+    printf("                  trading a byte per document for exact block maximums at search time. \n");
+    printf("  --term-grams    Create a term gram dictionary of the terms, used to look up wildcard \n");
+    printf("                  terms which start with a wildcard without scanning the term dictionary. \n");
+    printf("  --phonetic-keys=name[,name] \n");
+    printf("                  Create phonetic key dictionaries of the terms, used to look up soundex, \n");
+    printf("                  metaphone and phonix terms without scanning the term dictionary, \n");
+    printf("                  phonetic keys available: '%s', '%s', '%s'. \n", 
+            SRCH_INDEXER_PHONETIC_KEYS_SOUNDEX_NAME, SRCH_INDEXER_PHONETIC_KEYS_METAPHONE_NAME, SRCH_INDEXER_PHONETIC_KEYS_PHONIX_NAME);
     printf("  --minimum-term-length=# \n");
     printf("                  Minimum length of a term, defaults to %d, minimum: %d. \n", SRCH_TERM_LENGTH_MINIMUM_DEFAULT, SRCH_TERM_LENGTH_MINIMUM);
     printf("  --maximum-term-length=# \n");
@@ -1917,6 +1917,7 @@ static int iSrchPhrasesSetTermWeight
     unsigned int    uiTermCount = 0;
     unsigned int    uiDocumentCount = 0;
     unsigned long   ulIndexBlockID = 0;
+    unsigned int    uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
 
     unsigned char   pucTerm[SRCH_PHRASES_MAX_TERM_LENGTH + 1] = {'\0'};
     unsigned int    ulTermLength = 0;
@@ -1962,7 +1963,7 @@ static int iSrchPhrasesSetTermWeight
         }
 
         /* Look up the term */
-        if ( (iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, NULL, 0, &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID)) == SRCH_NoError ) {
+        if ( (iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, NULL, 0, &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID)) == SRCH_NoError ) {
     
             /* Check if this term is frequent if the frequent term coverage has been set */
             if ( (fFrequentTermCoverage >  0) && (uiTermType == SPI_TERM_TYPE_REGULAR) ) {
@@ -2061,7 +2062,7 @@ static int iSrchPhrasesSetTermWeight
         }
 
         /* Look up the term */
-        if ( (iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, NULL, 0, &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID)) == SRCH_NoError ) {
+        if ( (iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, NULL, 0, &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID)) == SRCH_NoError ) {
     
             /* Check if this term is frequent if the frequent term coverage has been set */
             if ( (fFrequentTermCoverage >  0) && (uiTermType == SPI_TERM_TYPE_REGULAR) ) {
@@ -2004,6 +2004,7 @@ static int iSrchTermsCallBackFunction
     unsigned int        uiTermCount = 0;
     unsigned int        uiDocumentCount = 0;
     unsigned long       ulIndexBlockID = 0;
+    unsigned int        uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
 
 
 /*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermsCallBackFunction - [%s][%u]", pucKey, (unsigned int)pvData); */
@@ -2081,7 +2082,7 @@ static int iSrchTermsCallBackFunction
 
 
     /* Look up the term */
-    if ( (iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, NULL, 0, &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID)) == SRCH_NoError ) {
+    if ( (iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, NULL, 0, &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID)) == SRCH_NoError ) {
 
 /*         iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: '%s', uiTermCount: %u, uiDocumentCount: %u",  */
 /*                 pucTerm, uiTermCount, uiDocumentCount); */
@@ -51,10 +51,19 @@
 ** Feature Defines
 */
 
-/* Enable proximity reweighting */
+/* Enable proximity reweighting, this needs the term positions for all the terms
+** in a search so it goes with SRCH_SEARCH_ENABLE_TERM_POSITIONS_FOR_ALL_TERMS 
+** in search.c, and it needs to match cursor.c
+*/
 #define SRCH_POSTING_ENABLE_PROXIMITY_REWEIGHTING
 
 
+/* Enable galloping, this allows the AND, NOT, ADJ and NEAR merges to skip 
+** over runs of postings which cannot match rather than stepping through them
+*/
+#define SRCH_POSTING_ENABLE_GALLOPING
+
+
 /*---------------------------------------------------------------------------*/
 
 /*
@@ -66,6 +75,10 @@
 #endif    /* defined(SRCH_POSTING_ENABLE_PROXIMITY_REWEIGHTING) */
 
 
+/* Number of search postings in a search posting block, this matches the skip list interval in invert.c */
+#define SRCH_POSTING_BLOCK_LENGTH                           (128)
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -109,6 +122,20 @@
 }
 
 
+/* Macro to check whether a search posting precedes another when merging postings arrays, 
+** search postings are ordered on document ID and term position, and then on the
+** postings array index they came from
+*/
+#define SRCH_POSTING_MERGE_PRECEDES(psp1, ui1, psp2, ui2) \
+    ((((psp1)->uiDocumentID < (psp2)->uiDocumentID) || \
+    (((psp1)->uiDocumentID == (psp2)->uiDocumentID) && ((psp1)->uiTermPosition < (psp2)->uiTermPosition)) || \
+    (((psp1)->uiDocumentID == (psp2)->uiDocumentID) && ((psp1)->uiTermPosition == (psp2)->uiTermPosition) && ((ui1) < (ui2)))) ? true : false)
+
+/* Macro to check whether a postings array has been exhausted when merging postings arrays */
+#define SRCH_POSTING_MERGE_EXHAUSTED(ppsp, pui1, pui2, ui) \
+    ((((ppsp)[(ui)] == NULL) || ((pui2)[(ui)] >= (pui1)[(ui)])) ? true : false)
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -116,6 +143,17 @@
 ** Private function prototypes
 */
 
+static int iSrchPostingMergeDocumentContainers (struct srchPostingsList *psplSrchPostingsList1, 
+        struct srchPostingsList *psplSrchPostingsList2, boolean bAND);
+
+static int iSrchPostingMergeSrchPostingsLoserTree (struct srchPosting **ppspSrchPostingsList, 
+        unsigned int *puiSrchPostingsLengthList, unsigned int uiSrchPostingsListLength, 
+        boolean bProximityReweighting, struct srchPosting *pspSrchPostings);
+
+static int iSrchPostingAdjustLoserTree (struct srchPosting **ppspSrchPostingsList, 
+        unsigned int *puiSrchPostingsLengthList, unsigned int *puiOffsets, 
+        unsigned int *puiLoserTree, unsigned int uiLoserTreeLength, unsigned int uiIndex);
+
 static int iSrchPostingPrintSrchPostingsList (struct srchPostingsList *psplSrchPostingsList);
 
 
@@ -230,6 +268,9 @@ int iSrchPostingFreeSrchPostingsList
     /* Free the search postings list structure */
     if ( psplSrchPostingsList != NULL ) {
         s_free(psplSrchPostingsList->pspSrchPostings);
+        s_free(psplSrchPostingsList->pspbSrchPostingBlocks);
+        iUtlRoaringFree(psplSrchPostingsList->pvUtlRoaring);
+        iSrchTermSearchFreeDecoder(psplSrchPostingsList->pvSrchTermSearchDecoder);
         s_free(psplSrchPostingsList);
     }
 
@@ -397,6 +438,19 @@ int iSrchPostingMergeSrchPostingsListsOR
     }
 
 
+    /* Decode any search postings which have not been decoded yet, expand any document containers 
+    ** into search postings and load any term positions which have not been loaded yet 
+    */
+    if ( ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList1, NULL, 0)) != SRCH_NoError) || 
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList2, NULL, 0)) != SRCH_NoError) ) {
+        return (iError);
+    }
+
+
     /* If either of the postings lists are NULL or of zero length we try to return the
     ** other one, if they are both null then we just return an empty search postings list structure
     */
@@ -645,6 +699,247 @@ int iSrchPostingMergeSrchPostingsListsOR
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchPostingMergeSrchPostingsListsMultiOR()
+
+    Purpose:    This function ORs a list of search postings list structures in a 
+                single pass and returns a pointer to a new search postings list structure.
+                
+                The postings are merged over a loser tree rather than by chaining
+                iSrchPostingMergeSrchPostingsListsOR(), so each posting is copied once 
+                rather than once per merge. Postings are ordered as they would be by
+                the chained merges and proximity reweighting is applied the same way, 
+                but only once to each posting rather than once per merge.
+                
+                Required terms are handed off to the chained merges because they 
+                turn the OR into an AND or an IOR.
+
+                The search postings list structures passed are freed.
+
+    Parameters: ppsplSrchPostingsLists              search postings list structures list
+                uiSrchPostingsListsLength           search postings list structures list length
+                uiSrchPostingBooleanOperationID     posting boolean operation ID
+                ppsplSrchPostingsList               return pointer for the search postings list structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchPostingMergeSrchPostingsListsMultiOR
+(
+    struct srchPostingsList **ppsplSrchPostingsLists,
+    unsigned int uiSrchPostingsListsLength,
+    unsigned int uiSrchPostingBooleanOperationID,
+    struct srchPostingsList **ppsplSrchPostingsList
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchPostingsList     *psplSrchPostingsList = NULL;
+    struct srchPosting          **ppspSrchPostingsList = NULL;
+    unsigned int                *puiSrchPostingsLengthList = NULL;
+    unsigned int                uiSrchPostingsListLength = 0;
+    unsigned int                uiSrchPostingsLength = 0;
+    unsigned int                uiI = 0;
+    boolean                     bRequired = false;
+    boolean                     bStop = true;
+    struct srchPosting          *pspSrchPostingsPtr = NULL;
+    struct srchPosting          *pspSrchPostingsEnd = NULL;
+    unsigned int                uiCurrentDocumentID = 0;
+
+
+    /* Check the parameters */
+    if ( (ppsplSrchPostingsLists == NULL) && (uiSrchPostingsListsLength > 0) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppsplSrchPostingsLists' parameter passed to 'iSrchPostingMergeSrchPostingsListsMultiOR'."); 
+        return (SRCH_PostingInvalidPostingsList);
+    }
+
+    for ( uiI = 0; uiI < uiSrchPostingsListsLength; uiI++ ) {
+        if ( (ppsplSrchPostingsLists[uiI] != NULL) && (iSrchPostingCheckSrchPostingsList(ppsplSrchPostingsLists[uiI]) != SRCH_NoError) ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'ppsplSrchPostingsLists' parameter passed to 'iSrchPostingMergeSrchPostingsListsMultiOR'."); 
+            return (SRCH_PostingInvalidPostingsList);
+        }
+    }
+
+    if ( !((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID) || (uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID)) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiSrchPostingBooleanOperationID' parameter passed to 'iSrchPostingMergeSrchPostingsListsMultiOR'."); 
+        return (SRCH_PostingInvalidSearchBooleanModifier);
+    }
+
+    if ( ppsplSrchPostingsList == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppsplSrchPostingsList' parameter passed to 'iSrchPostingMergeSrchPostingsListsMultiOR'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Decode any search postings which have not been decoded yet, expand any document containers into 
+    ** search postings, load any term positions which have not been loaded yet, and check for required terms 
+    */
+    for ( uiI = 0; uiI < uiSrchPostingsListsLength; uiI++ ) {
+        
+        if ( ((iError = iSrchPostingDecodeSrchPostings(ppsplSrchPostingsLists[uiI])) != SRCH_NoError) ||
+                ((iError = iSrchPostingExpandDocumentContainers(ppsplSrchPostingsLists[uiI])) != SRCH_NoError) ||
+                ((iError = iSrchPostingLoadTermPositions(ppsplSrchPostingsLists[uiI], NULL, 0)) != SRCH_NoError) ) {
+            goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+        }
+        
+        if ( (ppsplSrchPostingsLists[uiI] != NULL) && (ppsplSrchPostingsLists[uiI]->bRequired == true) ) {
+            bRequired = true;
+        }
+    }
+
+
+    /* Chain the merges if there are required terms */
+    if ( bRequired == true ) {
+
+        for ( uiI = 0; uiI < uiSrchPostingsListsLength; uiI++ ) {
+            
+            /* OR this search postings list structure into the merged search postings list structure */
+            if ( (iError = iSrchPostingMergeSrchPostingsListsOR(psplSrchPostingsList, ppsplSrchPostingsLists[uiI], uiSrchPostingBooleanOperationID, 
+                    &psplSrchPostingsList)) != SRCH_NoError ) {
+
+                /* The merge may have freed the search postings list structures it was passed */
+                ppsplSrchPostingsLists[uiI] = NULL;
+                psplSrchPostingsList = NULL;
+                goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+            }
+
+            /* NULL out the search postings list structure, it was freed in the merge */
+            ppsplSrchPostingsLists[uiI] = NULL;
+        }
+        
+        goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+    }
+
+
+    /* Allocate the postings arrays list and the postings arrays lengths list */
+    if ( uiSrchPostingsListsLength > 0 ) {
+
+        if ( (ppspSrchPostingsList = (struct srchPosting **)s_malloc((size_t)(sizeof(struct srchPosting *) * uiSrchPostingsListsLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+        }
+    
+        if ( (puiSrchPostingsLengthList = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiSrchPostingsListsLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+        }
+    }
+
+
+    /* Collect the non-empty postings arrays, we collect them in reverse order because the 
+    ** loser tree puts lower indices first on ties, and the chained merges put later 
+    ** search postings list structures first
+    */
+    for ( uiI = uiSrchPostingsListsLength; uiI > 0; uiI-- ) {
+
+        struct srchPostingsList     *psplSrchPostingsListPtr = ppsplSrchPostingsLists[uiI - 1];
+
+        /* The merged search postings list structure is a stop word if they all are */
+        if ( (psplSrchPostingsListPtr == NULL) || (psplSrchPostingsListPtr->uiTermType != SPI_TERM_TYPE_STOP) ) {
+            bStop = false;
+        }
+        
+        if ( (psplSrchPostingsListPtr != NULL) && (psplSrchPostingsListPtr->uiSrchPostingsLength > 0) ) {
+            ppspSrchPostingsList[uiSrchPostingsListLength] = psplSrchPostingsListPtr->pspSrchPostings;
+            puiSrchPostingsLengthList[uiSrchPostingsListLength] = psplSrchPostingsListPtr->uiSrchPostingsLength;
+            uiSrchPostingsLength += psplSrchPostingsListPtr->uiSrchPostingsLength;
+            uiSrchPostingsListLength++;
+        }
+    }
+
+
+    /* Return an empty postings list if there is nothing to merge */
+    if ( uiSrchPostingsListLength == 0 ) {
+        
+        if ( (iError = iSrchPostingCreateSrchPostingsList((((uiSrchPostingsListsLength > 0) && (bStop == true)) ? SPI_TERM_TYPE_STOP : SPI_TERM_TYPE_UNKNOWN), 
+                SPI_TERM_COUNT_UNKNOWN, SPI_TERM_DOCUMENT_COUNT_UNKNOWN, false, NULL, 0, &psplSrchPostingsList)) != SRCH_NoError ) {
+            goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+        }
+        
+        goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+    }
+    
+    /* Return the non-empty search postings list structure if there is only one */
+    else if ( uiSrchPostingsListLength == 1 ) {
+        
+        for ( uiI = 0; uiI < uiSrchPostingsListsLength; uiI++ ) {
+            if ( (ppsplSrchPostingsLists[uiI] != NULL) && (ppsplSrchPostingsLists[uiI]->uiSrchPostingsLength > 0) ) {
+                psplSrchPostingsList = ppsplSrchPostingsLists[uiI];
+                ppsplSrchPostingsLists[uiI] = NULL;
+                break;
+            }
+        }
+        
+        goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+    }
+
+
+    /* Create a new search postings list structure */
+    if ( (iError = iSrchPostingCreateSrchPostingsList(SPI_TERM_TYPE_REGULAR, uiSrchPostingsLength, 0, false, NULL, 
+            uiSrchPostingsLength, &psplSrchPostingsList)) != SRCH_NoError ) {
+        goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+    }
+
+    /* Merge the postings arrays into the new postings array */
+    if ( (iError = iSrchPostingMergeSrchPostingsLoserTree(ppspSrchPostingsList, puiSrchPostingsLengthList, uiSrchPostingsListLength, 
+            true, psplSrchPostingsList->pspSrchPostings)) != SRCH_NoError ) {
+        goto bailFromiSrchPostingMergeSrchPostingsListsMultiOR;
+    }
+
+
+    /* Count up the number of documents in this posting */
+    for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pspSrchPostingsEnd = psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength, 
+            psplSrchPostingsList->uiDocumentCount = 0, uiCurrentDocumentID = 0; pspSrchPostingsPtr < pspSrchPostingsEnd; pspSrchPostingsPtr++ ) {
+        
+        if ( pspSrchPostingsPtr->uiDocumentID != uiCurrentDocumentID ) {
+            psplSrchPostingsList->uiDocumentCount++;
+            uiCurrentDocumentID = pspSrchPostingsPtr->uiDocumentID;
+        }
+    }
+
+
+    ASSERT(iSrchPostingCheckSrchPostingsList(psplSrchPostingsList) == SRCH_NoError);
+
+
+
+    /* Bail label */
+    bailFromiSrchPostingMergeSrchPostingsListsMultiOR:
+
+
+    /* Free the postings arrays list and the postings arrays lengths list */
+    s_free(ppspSrchPostingsList);
+    s_free(puiSrchPostingsLengthList);
+
+    /* Free the old search postings list structures */
+    for ( uiI = 0; uiI < uiSrchPostingsListsLength; uiI++ ) {
+        iSrchPostingFreeSrchPostingsList(ppsplSrchPostingsLists[uiI]);
+        ppsplSrchPostingsLists[uiI] = NULL;
+    }
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointer */
+        *ppsplSrchPostingsList = psplSrchPostingsList;
+    }
+    else {
+        iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
+        psplSrchPostingsList = NULL;
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchPostingMergeSrchPostingsListsIOR()
@@ -712,6 +1007,19 @@ int iSrchPostingMergeSrchPostingsListsIOR
     }
 
 
+    /* Decode any search postings which have not been decoded yet, expand any document containers 
+    ** into search postings and load any term positions which have not been loaded yet 
+    */
+    if ( ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList1, NULL, 0)) != SRCH_NoError) || 
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList2, NULL, 0)) != SRCH_NoError) ) {
+        return (iError);
+    }
+
+
     /* If either of the postings lists are NULL or of zero length we try to return the
     ** other one, if they are both null then we just return an empty search postings list structure
     */
@@ -1032,6 +1340,19 @@ int iSrchPostingMergeSrchPostingsListsXOR
     }
 
 
+    /* Decode any search postings which have not been decoded yet, expand any document containers 
+    ** into search postings and load any term positions which have not been loaded yet 
+    */
+    if ( ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList1, NULL, 0)) != SRCH_NoError) || 
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList2, NULL, 0)) != SRCH_NoError) ) {
+        return (iError);
+    }
+
+
     /* If either of the postings lists are NULL or of zero length we try to return the
     ** other one, if they are both null then we just return an empty search postings list structure
     */
@@ -1315,6 +1636,35 @@ int iSrchPostingMergeSrchPostingsListsAND
     }
 
 
+    /* AND the document containers straight into the search postings if we can */
+    if ( (psplSrchPostingsList1 != NULL) && (psplSrchPostingsList1->pvUtlRoaring == NULL) && (psplSrchPostingsList1->uiSrchPostingsLength > 0) &&
+            (psplSrchPostingsList2 != NULL) && (psplSrchPostingsList2->pvUtlRoaring != NULL) ) {
+
+        if ( (iError = iSrchPostingMergeDocumentContainers(psplSrchPostingsList1, psplSrchPostingsList2, true)) != SRCH_NoError ) {
+            return (iError);
+        }
+
+        iSrchPostingFreeSrchPostingsList(psplSrchPostingsList2);
+        psplSrchPostingsList2 = NULL;
+
+        *ppsplSrchPostingsList = psplSrchPostingsList1;
+        return (SRCH_NoError);
+    }
+
+
+    /* Decode any search postings which have not been decoded yet, expand any document containers 
+    ** into search postings and load any term positions which have not been loaded yet 
+    */
+    if ( ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList1, NULL, 0)) != SRCH_NoError) || 
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList2, NULL, 0)) != SRCH_NoError) ) {
+        return (iError);
+    }
+
+
     /* If either of the postings lists are NULL or of zero length we try to return the
     ** other one, if they are both null then we just return an empty search postings list structure
     */
@@ -1420,6 +1770,29 @@ int iSrchPostingMergeSrchPostingsListsAND
     /* Loop through the outer postings */
     for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings; pspSrchPostingsPtr1 < pspSrchPostingsEnd1; pspSrchPostingsPtr1++ ) {
 
+#if defined(SRCH_POSTING_ENABLE_GALLOPING)
+        /* Skip ahead in the outer postings if they are behind the inner postings and we are not tracking a document,
+        ** and stop if we have run out of inner postings since there is nothing else to match
+        */
+        if ( pspSrchPostingsPtr1->uiDocumentID != uiCurrentDocumentID ) {
+
+            if ( pspSrchPostingsPtr2 >= pspSrchPostingsEnd2 ) {
+                break;
+            }
+
+            if ( pspSrchPostingsPtr1->uiDocumentID < pspSrchPostingsPtr2->uiDocumentID ) {
+                if ( (pspSrchPostingsPtr1 = pspSrchPostingSeekDocumentID(pspSrchPostingsPtr1, pspSrchPostingsEnd1, pspSrchPostingsPtr2->uiDocumentID)) >= pspSrchPostingsEnd1 ) {
+                    break;
+                }
+            }
+        }
+
+        /* Skip ahead in the inner postings if they are behind the outer postings and we are not tracking a document */
+        if ( (pspSrchPostingsCurrentPtr == NULL) && (pspSrchPostingsPtr2 < pspSrchPostingsEnd2) && (pspSrchPostingsPtr2->uiDocumentID < pspSrchPostingsPtr1->uiDocumentID) ) {
+            pspSrchPostingsPtr2 = pspSrchPostingSeekDocumentID(pspSrchPostingsPtr2, pspSrchPostingsEnd2, pspSrchPostingsPtr1->uiDocumentID);
+        }
+#endif    /* defined(SRCH_POSTING_ENABLE_GALLOPING) */
+
 /*         iUtlLogDebug(UTL_LOG_CONTEXT, "uiDocumentID1 [%u], uiTermPosition [%d] fWeight [%.4f] (tracking/1)",  */
 /*                 pspSrchPostingsPtr1->uiDocumentID, pspSrchPostingsPtr1->uiTermPosition, pspSrchPostingsPtr1->fWeight); */
 
@@ -1693,6 +2066,35 @@ int iSrchPostingMergeSrchPostingsListsNOT
     }
 
 
+    /* NOT the document containers straight into the search postings if we can */
+    if ( (psplSrchPostingsList1 != NULL) && (psplSrchPostingsList1->pvUtlRoaring == NULL) && (psplSrchPostingsList1->uiSrchPostingsLength > 0) &&
+            (psplSrchPostingsList2 != NULL) && (psplSrchPostingsList2->pvUtlRoaring != NULL) ) {
+
+        if ( (iError = iSrchPostingMergeDocumentContainers(psplSrchPostingsList1, psplSrchPostingsList2, false)) != SRCH_NoError ) {
+            return (iError);
+        }
+
+        iSrchPostingFreeSrchPostingsList(psplSrchPostingsList2);
+        psplSrchPostingsList2 = NULL;
+
+        *ppsplSrchPostingsList = psplSrchPostingsList1;
+        return (SRCH_NoError);
+    }
+
+
+    /* Decode any search postings which have not been decoded yet, expand any document containers 
+    ** into search postings and load any term positions which have not been loaded yet 
+    */
+    if ( ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList1, NULL, 0)) != SRCH_NoError) || 
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList2, NULL, 0)) != SRCH_NoError) ) {
+        return (iError);
+    }
+
+
     /* If either of the postings lists are NULL or of zero length, we need to check what we can actually return */
     if ( (psplSrchPostingsList1 == NULL) || (psplSrchPostingsList1->uiSrchPostingsLength == 0) || 
             (psplSrchPostingsList2 == NULL) || (psplSrchPostingsList2->uiSrchPostingsLength == 0) ) {
@@ -1759,6 +2161,13 @@ int iSrchPostingMergeSrchPostingsListsNOT
     /* Loop through the outer postings array */
     for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings; pspSrchPostingsPtr1 < pspSrchPostingsEnd1; pspSrchPostingsPtr1++ ) {
 
+#if defined(SRCH_POSTING_ENABLE_GALLOPING)
+        /* Skip ahead in the inner postings array if it is behind the outer postings array */
+        if ( (pspSrchPostingsPtr2 < pspSrchPostingsEnd2) && (pspSrchPostingsPtr2->uiDocumentID < pspSrchPostingsPtr1->uiDocumentID) ) {
+            pspSrchPostingsPtr2 = pspSrchPostingSeekDocumentID(pspSrchPostingsPtr2, pspSrchPostingsEnd2, pspSrchPostingsPtr1->uiDocumentID);
+        }
+#endif    /* defined(SRCH_POSTING_ENABLE_GALLOPING) */
+
 /*         iUtlLogDebug(UTL_LOG_CONTEXT, "uiDocumentID1 [%u], uiTermPosition [%d] fWeight [%.4f] (tracking/1)",  */
 /*                 pspSrchPostingsPtr1->uiDocumentID, pspSrchPostingsPtr1->uiTermPosition, pspSrchPostingsPtr1->fWeight); */
 
@@ -1924,6 +2333,19 @@ int iSrchPostingMergeSrchPostingsListsADJ
     }
 
 
+    /* Decode any search postings which have not been decoded yet, expand any document containers 
+    ** into search postings and load any term positions which have not been loaded yet 
+    */
+    if ( ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList1, NULL, 0)) != SRCH_NoError) || 
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList2, NULL, 0)) != SRCH_NoError) ) {
+        return (iError);
+    }
+
+
     /* If either of the postings lists are NULL or of zero length we try to return the
     ** other one, if they are both null then we just return an empty search postings list structure
     */
@@ -2020,6 +2442,25 @@ int iSrchPostingMergeSrchPostingsListsADJ
     /* Loop on the inner postings array */
     for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings; pspSrchPostingsPtr2 < pspSrchPostingsEnd2; pspSrchPostingsPtr2++ ) {
 
+#if defined(SRCH_POSTING_ENABLE_GALLOPING)
+        /* Stop if we have run out of outer postings since there is nothing else to match */
+        if ( pspSrchPostingsPtr1 >= pspSrchPostingsEnd1 ) {
+            break;
+        }
+
+        /* Skip ahead in the inner postings array if it is behind the outer postings array */
+        if ( pspSrchPostingsPtr2->uiDocumentID < pspSrchPostingsPtr1->uiDocumentID ) {
+            if ( (pspSrchPostingsPtr2 = pspSrchPostingSeekDocumentID(pspSrchPostingsPtr2, pspSrchPostingsEnd2, pspSrchPostingsPtr1->uiDocumentID)) >= pspSrchPostingsEnd2 ) {
+                break;
+            }
+        }
+
+        /* Skip ahead in the outer postings array if it is behind the inner postings array */
+        if ( pspSrchPostingsPtr1->uiDocumentID < pspSrchPostingsPtr2->uiDocumentID ) {
+            pspSrchPostingsPtr1 = pspSrchPostingSeekDocumentID(pspSrchPostingsPtr1, pspSrchPostingsEnd1, pspSrchPostingsPtr2->uiDocumentID);
+        }
+#endif    /* defined(SRCH_POSTING_ENABLE_GALLOPING) */
+
 /*         iUtlLogDebug(UTL_LOG_CONTEXT, "uiDocumentID2 [%u], uiTermPosition [%d] fWeight [%.4f] (tracking/2)",  */
 /*                 pspSrchPostingsPtr2->uiDocumentID, pspSrchPostingsPtr2->uiTermPosition, pspSrchPostingsPtr2->fWeight); */
 
@@ -2195,6 +2636,19 @@ int iSrchPostingMergeSrchPostingsListsNEAR
     }
 
 
+    /* Decode any search postings which have not been decoded yet, expand any document containers 
+    ** into search postings and load any term positions which have not been loaded yet 
+    */
+    if ( ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList1)) != SRCH_NoError) || 
+            ((iError = iSrchPostingExpandDocumentContainers(psplSrchPostingsList2)) != SRCH_NoError) ||
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList1, NULL, 0)) != SRCH_NoError) || 
+            ((iError = iSrchPostingLoadTermPositions(psplSrchPostingsList2, NULL, 0)) != SRCH_NoError) ) {
+        return (iError);
+    }
+
+
     /* If either of the postings lists are NULL or of zero length we try to return the
     ** other one, if they are both null then we just return an empty search postings list structure
     */
@@ -2291,6 +2745,25 @@ int iSrchPostingMergeSrchPostingsListsNEAR
     /* Loop on the inner postings array */
     for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings; pspSrchPostingsPtr2 < pspSrchPostingsEnd2; pspSrchPostingsPtr2++ ) {
 
+#if defined(SRCH_POSTING_ENABLE_GALLOPING)
+        /* Stop if we have run out of outer postings since there is nothing else to match */
+        if ( pspSrchPostingsPtr1 >= pspSrchPostingsEnd1 ) {
+            break;
+        }
+
+        /* Skip ahead in the inner postings array if it is behind the outer postings array */
+        if ( pspSrchPostingsPtr2->uiDocumentID < pspSrchPostingsPtr1->uiDocumentID ) {
+            if ( (pspSrchPostingsPtr2 = pspSrchPostingSeekDocumentID(pspSrchPostingsPtr2, pspSrchPostingsEnd2, pspSrchPostingsPtr1->uiDocumentID)) >= pspSrchPostingsEnd2 ) {
+                break;
+            }
+        }
+
+        /* Skip ahead in the outer postings array if it is behind the inner postings array */
+        if ( pspSrchPostingsPtr1->uiDocumentID < pspSrchPostingsPtr2->uiDocumentID ) {
+            pspSrchPostingsPtr1 = pspSrchPostingSeekDocumentID(pspSrchPostingsPtr1, pspSrchPostingsEnd1, pspSrchPostingsPtr2->uiDocumentID);
+        }
+#endif    /* defined(SRCH_POSTING_ENABLE_GALLOPING) */
+
 /*         iUtlLogDebug(UTL_LOG_CONTEXT, "uiDocumentID2 [%u], uiTermPosition [%d] fWeight [%.4f] (tracking/2)",  */
 /*                 pspSrchPostingsPtr2->uiDocumentID, pspSrchPostingsPtr2->uiTermPosition, pspSrchPostingsPtr2->fWeight); */
 
@@ -2493,6 +2966,846 @@ int iSrchPostingSortDocumentIDAsc
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchPostingMergeSrchPostings()
+
+    Purpose:    This function merges a list of postings arrays, each of which
+                is sorted in ascending document ID and term position order, into
+                a single postings array in the same order. This is a single
+                multiway merge over a loser tree, so it is cheaper than concatenating 
+                the postings arrays and sorting the result when there are many of them.
+
+                The postings arrays passed are not freed.
+
+    Parameters: ppspSrchPostingsList            postings arrays list
+                puiSrchPostingsLengthList       postings arrays lengths list
+                uiSrchPostingsListLength        postings arrays list length
+                ppspSrchPostings                return pointer for the merged postings array
+                puiSrchPostingsLength           return pointer for the merged postings array length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchPostingMergeSrchPostings
+(
+    struct srchPosting **ppspSrchPostingsList,
+    unsigned int *puiSrchPostingsLengthList,
+    unsigned int uiSrchPostingsListLength,
+    struct srchPosting **ppspSrchPostings,
+    unsigned int *puiSrchPostingsLength
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchPosting      *pspSrchPostings = NULL;
+    unsigned int            uiSrchPostingsLength = 0;
+    unsigned int            uiI = 0;
+
+
+    /* Check the parameters */
+    if ( ((ppspSrchPostingsList == NULL) || (puiSrchPostingsLengthList == NULL)) && (uiSrchPostingsListLength > 0) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppspSrchPostingsList' or 'puiSrchPostingsLengthList' parameter passed to 'iSrchPostingMergeSrchPostings'."); 
+        return (SRCH_PostingInvalidPostings);
+    }
+
+    if ( ppspSrchPostings == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppspSrchPostings' parameter passed to 'iSrchPostingMergeSrchPostings'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiSrchPostingsLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiSrchPostingsLength' parameter passed to 'iSrchPostingMergeSrchPostings'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Add up the postings */
+    for ( uiI = 0; uiI < uiSrchPostingsListLength; uiI++ ) {
+        if ( ppspSrchPostingsList[uiI] != NULL ) {
+            uiSrchPostingsLength += puiSrchPostingsLengthList[uiI];
+        }
+    }
+
+    /* Nothing to merge */
+    if ( uiSrchPostingsLength == 0 ) {
+        goto bailFromiSrchPostingMergeSrchPostings;
+    }
+
+
+    /* Allocate the merged postings array */
+    if ( (pspSrchPostings = (struct srchPosting *)s_malloc((size_t)(sizeof(struct srchPosting) * uiSrchPostingsLength))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchPostingMergeSrchPostings;
+    }
+
+    /* Merge the postings arrays into the merged postings array */
+    if ( (iError = iSrchPostingMergeSrchPostingsLoserTree(ppspSrchPostingsList, puiSrchPostingsLengthList, uiSrchPostingsListLength, 
+            false, pspSrchPostings)) != SRCH_NoError ) {
+        goto bailFromiSrchPostingMergeSrchPostings;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchPostingMergeSrchPostings:
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+        
+        /* Set the return pointers */
+        *ppspSrchPostings = pspSrchPostings;
+        *puiSrchPostingsLength = uiSrchPostingsLength;
+    }
+    else {
+        s_free(pspSrchPostings);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   pspSrchPostingSeekDocumentID()
+
+    Purpose:    This function returns a pointer to the first posting in the 
+                postings array whose document ID is greater than or equal to 
+                the passed document ID, or the end pointer if there is none.
+
+                The search gallops, doubling the step until it overshoots, 
+                and then does a binary search over the last step, so the 
+                cost depends on how far we skip rather than on the length 
+                of the postings array.
+
+    Parameters: pspSrchPostingsPtr      postings array pointer to start from
+                pspSrchPostingsEnd      postings array end pointer
+                uiDocumentID            document ID to seek to
+
+    Globals:    none
+
+    Returns:    a pointer to the posting
+
+*/
+struct srchPosting *pspSrchPostingSeekDocumentID
+(
+    struct srchPosting *pspSrchPostingsPtr,
+    struct srchPosting *pspSrchPostingsEnd,
+    unsigned int uiDocumentID
+)
+{
+
+    size_t      zLow = 0;
+    size_t      zHigh = 0;
+    size_t      zMiddle = 0;
+    size_t      zLength = 0;
+
+
+    ASSERT(pspSrchPostingsPtr != NULL);
+    ASSERT(pspSrchPostingsEnd != NULL);
+    ASSERT(pspSrchPostingsPtr <= pspSrchPostingsEnd);
+
+
+    /* Get the length of the postings array */
+    zLength = pspSrchPostingsEnd - pspSrchPostingsPtr;
+
+    /* Nothing to do if we are already there */
+    if ( (zLength == 0) || (pspSrchPostingsPtr->uiDocumentID >= uiDocumentID) ) {
+        return (pspSrchPostingsPtr);
+    }
+
+
+    /* Gallop until we overshoot, zLow is always behind the document ID */
+    for ( zLow = 0, zHigh = 1; (zHigh < zLength) && (pspSrchPostingsPtr[zHigh].uiDocumentID < uiDocumentID); zLow = zHigh, zHigh *= 2 ) {
+        ;
+    }
+
+    /* Clamp the high end */
+    if ( zHigh > zLength ) {
+        zHigh = zLength;
+    }
+
+
+    /* Binary search between the low end and the high end, zHigh is either at or past the document ID */
+    while ( (zHigh - zLow) > 1 ) {
+
+        zMiddle = zLow + ((zHigh - zLow) / 2);
+
+        if ( pspSrchPostingsPtr[zMiddle].uiDocumentID < uiDocumentID ) {
+            zLow = zMiddle;
+        }
+        else {
+            zHigh = zMiddle;
+        }
+    }
+
+
+    return (pspSrchPostingsPtr + zHigh);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchPostingCreateSrchPostingBlocks()
+
+    Purpose:    This function creates the search posting blocks for a search 
+                postings list if it does not already have them, this is the 
+                case for search postings lists which were merged or which were
+                read from an index which does not store block maximums.
+
+                A block is closed on the first document boundary after 
+                SRCH_POSTING_BLOCK_LENGTH search postings, and its maximum 
+                weight is the largest total weight of any one document in it.
+
+    Parameters: psplSrchPostingsList    search postings list structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchPostingCreateSrchPostingBlocks
+(
+    struct srchPostingsList *psplSrchPostingsList
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchPosting          *pspSrchPostingsPtr = NULL;
+    struct srchPosting          *pspSrchPostingsEnd = NULL;
+    struct srchPostingBlock     *pspbSrchPostingBlocks = NULL;
+    struct srchPostingBlock     *pspbSrchPostingBlocksPtr = NULL;
+    unsigned int                uiSrchPostingsCount = 0;
+    float                       fDocumentWeight = 0;
+
+
+    /* Check the parameters */
+    if ( psplSrchPostingsList == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psplSrchPostingsList' parameter passed to 'iSrchPostingCreateSrchPostingBlocks'."); 
+        return (SRCH_PostingInvalidPostingsList);
+    }
+
+
+    /* Nothing to do if there are search posting blocks already */
+    if ( psplSrchPostingsList->pspbSrchPostingBlocks != NULL ) {
+        return (SRCH_NoError);
+    }
+
+    /* Decode any search postings which have not been decoded yet, the blocks cover all of them */
+    if ( (iError = iSrchPostingDecodeSrchPostings(psplSrchPostingsList)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    /* Nothing to do if there are no search postings */
+    if ( psplSrchPostingsList->uiSrchPostingsLength == 0 ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Allocate the search posting blocks, there can be no more blocks than this */
+    if ( (pspbSrchPostingBlocks = (struct srchPostingBlock *)s_malloc((size_t)(((psplSrchPostingsList->uiSrchPostingsLength / SRCH_POSTING_BLOCK_LENGTH) + 1) * 
+            sizeof(struct srchPostingBlock)))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+
+    /* Loop over the search postings, adding up the weight for each document */
+    for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pspSrchPostingsEnd = psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength,
+            pspbSrchPostingBlocksPtr = pspbSrchPostingBlocks; pspSrchPostingsPtr < pspSrchPostingsEnd; pspSrchPostingsPtr++ ) {
+
+        fDocumentWeight += pspSrchPostingsPtr->fWeight;
+        uiSrchPostingsCount++;
+
+        /* Last search posting for this document */
+        if ( ((pspSrchPostingsPtr + 1) == pspSrchPostingsEnd) || ((pspSrchPostingsPtr + 1)->uiDocumentID != pspSrchPostingsPtr->uiDocumentID) ) {
+
+            /* Update the maximum weight for the block */
+            pspbSrchPostingBlocksPtr->uiDocumentID = pspSrchPostingsPtr->uiDocumentID;
+            pspbSrchPostingBlocksPtr->fMaxWeight = UTL_MACROS_MAX(pspbSrchPostingBlocksPtr->fMaxWeight, fDocumentWeight);
+            fDocumentWeight = 0;
+
+            /* Close the block if it is long enough */
+            if ( uiSrchPostingsCount >= SRCH_POSTING_BLOCK_LENGTH ) {
+                pspbSrchPostingBlocksPtr++;
+                uiSrchPostingsCount = 0;
+            }
+        }
+    }
+
+    /* Count the last block if it was not closed */
+    if ( uiSrchPostingsCount > 0 ) {
+        pspbSrchPostingBlocksPtr++;
+    }
+
+
+    /* Hand over the search posting blocks */
+    psplSrchPostingsList->pspbSrchPostingBlocks = pspbSrchPostingBlocks;
+    psplSrchPostingsList->uiSrchPostingBlocksLength = pspbSrchPostingBlocksPtr - pspbSrchPostingBlocks;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchPostingDecodeSrchPostings()
+
+    Purpose:    This function decodes the search postings of a search postings list 
+                which have not been decoded yet, this is used when a search postings
+                list whose search postings are decoded on demand needs to be handled 
+                like any other search postings list.
+
+    Parameters: psplSrchPostingsList    search postings list structure (optional)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchPostingDecodeSrchPostings
+(
+    struct srchPostingsList *psplSrchPostingsList
+)
+{
+
+    /* Nothing to do if there is no search postings list or if its search postings have all been decoded */
+    if ( (psplSrchPostingsList == NULL) || (psplSrchPostingsList->pvSrchTermSearchDecoder == NULL) ) {
+        return (SRCH_NoError);
+    }
+
+
+    return (iSrchTermSearchDecodeSrchPostings(psplSrchPostingsList));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchPostingExpandDocumentContainers()
+
+    Purpose:    This function expands the document containers of a search postings 
+                list into search postings, one search posting is created for each 
+                document, it carries the document containers weight and has no 
+                term position.
+
+                This is used when a search postings list with document containers
+                needs to be handled like any other search postings list.
+
+    Parameters: psplSrchPostingsList    search postings list structure (optional)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchPostingExpandDocumentContainers
+(
+    struct srchPostingsList *psplSrchPostingsList
+)
+{
+
+    int                     iError = UTL_NoError;
+    struct srchPosting      *pspSrchPostings = NULL;
+    struct srchPosting      *pspSrchPostingsPtr = NULL;
+    unsigned int            uiValuesCount = 0;
+    unsigned int            uiDocumentID = 0;
+
+
+    /* Nothing to do if there is no search postings list or if it does not have document containers */
+    if ( (psplSrchPostingsList == NULL) || (psplSrchPostingsList->pvUtlRoaring == NULL) ) {
+        return (SRCH_NoError);
+    }
+
+    ASSERT(psplSrchPostingsList->uiSrchPostingsLength == 0);
+
+
+    /* Get the number of documents */
+    if ( (iError = iUtlRoaringGetValuesCount(psplSrchPostingsList->pvUtlRoaring, &uiValuesCount)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the number of documents in the document containers, utl error: %d.", iError); 
+        return (SRCH_PostingInvalidPostingsList);
+    }
+
+
+    /* Allocate the search postings */
+    if ( uiValuesCount > 0 ) {
+        
+        if ( (pspSrchPostings = (struct srchPosting *)s_malloc((size_t)(uiValuesCount * sizeof(struct srchPosting)))) == NULL ) {
+            return (SRCH_MemError);
+        }
+    
+        /* Add a search posting for each document, document IDs start at 1 */
+        for ( pspSrchPostingsPtr = pspSrchPostings, uiDocumentID = 0; 
+                iUtlRoaringGetNextValue(psplSrchPostingsList->pvUtlRoaring, uiDocumentID + 1, &uiDocumentID) == UTL_NoError; pspSrchPostingsPtr++ ) {
+    
+            ASSERT(pspSrchPostingsPtr < (pspSrchPostings + uiValuesCount));
+    
+            pspSrchPostingsPtr->uiDocumentID = uiDocumentID;
+            pspSrchPostingsPtr->uiTermPosition = 0;
+            pspSrchPostingsPtr->fWeight = psplSrchPostingsList->fDocumentContainersWeight;
+        }
+    
+        ASSERT(pspSrchPostingsPtr == (pspSrchPostings + uiValuesCount));
+    }
+
+
+    /* Hand over the search postings and release the document containers */
+    psplSrchPostingsList->pspSrchPostings = pspSrchPostings;
+    psplSrchPostingsList->uiSrchPostingsLength = uiValuesCount;
+
+    iUtlRoaringFree(psplSrchPostingsList->pvUtlRoaring);
+    psplSrchPostingsList->pvUtlRoaring = NULL;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchPostingLoadTermPositions()
+
+    Purpose:    This function loads the term positions of a range of search postings 
+                in a search postings list whose term positions have not been loaded
+                yet, the range has to start at the first search posting of a document
+                and end at the last search posting of a document. All the term positions 
+                are loaded if pspSrchPostingsPtr is NULL.
+
+                Term positions are loaded in order, the term positions of the search 
+                postings before the range which have not been loaded yet are skipped
+                and stay set to 0, so a range has to come after the ranges loaded before it.
+
+    Parameters: psplSrchPostingsList    search postings list structure (optional)
+                pspSrchPostingsPtr      search postings pointer (optional)
+                uiSrchPostingsLength    search postings length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchPostingLoadTermPositions
+(
+    struct srchPostingsList *psplSrchPostingsList,
+    struct srchPosting *pspSrchPostingsPtr,
+    unsigned int uiSrchPostingsLength
+)
+{
+
+    unsigned char           *pucTermPositionsPtr = NULL;
+    struct srchPosting      *pspSrchPostingsSkipPtr = NULL;
+    struct srchPosting      *pspSrchPostingsEnd = NULL;
+    unsigned int            uiTermPosition = 0;
+    unsigned int            uiDeltaTermPosition = 0;
+
+
+    /* Nothing to do if there is no search postings list or if all its term positions have been loaded */
+    if ( (psplSrchPostingsList == NULL) || (psplSrchPostingsList->pucTermPositions == NULL) ) {
+        return (SRCH_NoError);
+    }
+
+    ASSERT(psplSrchPostingsList->uiTermPositionsIndex <= psplSrchPostingsList->uiSrchPostingsLength);
+
+
+    /* Load all the term positions which have not been loaded yet if no range was passed */
+    if ( pspSrchPostingsPtr == NULL ) {
+        pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiTermPositionsIndex;
+        uiSrchPostingsLength = psplSrchPostingsList->uiSrchPostingsLength - psplSrchPostingsList->uiTermPositionsIndex;
+    }
+
+    ASSERT(pspSrchPostingsPtr >= psplSrchPostingsList->pspSrchPostings);
+    ASSERT((pspSrchPostingsPtr + uiSrchPostingsLength) <= (psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength));
+
+
+    /* Nothing to do if the term positions of this range have already been loaded */
+    if ( pspSrchPostingsPtr < (psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiTermPositionsIndex) ) {
+        ASSERT((pspSrchPostingsPtr + uiSrchPostingsLength) <= (psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiTermPositionsIndex));
+        return (SRCH_NoError);
+    }
+
+
+    /* Skip the term positions of the search postings before the range */
+    for ( pucTermPositionsPtr = psplSrchPostingsList->pucTermPositions, pspSrchPostingsSkipPtr = psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiTermPositionsIndex;
+            pspSrchPostingsSkipPtr < pspSrchPostingsPtr; pspSrchPostingsSkipPtr++ ) {
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucTermPositionsPtr);
+    }
+
+    /* Load the term positions of the range, they are deltas from the previous term position in the same document */
+    for ( pspSrchPostingsEnd = pspSrchPostingsPtr + uiSrchPostingsLength; pspSrchPostingsPtr < pspSrchPostingsEnd; pspSrchPostingsPtr++ ) {
+
+        /* Reset the term position if this is a new document */
+        if ( (pspSrchPostingsPtr == pspSrchPostingsSkipPtr) || (pspSrchPostingsPtr->uiDocumentID != (pspSrchPostingsPtr - 1)->uiDocumentID) ) {
+            uiTermPosition = 0;
+        }
+
+        UTL_NUM_READ_COMPRESSED_UINT(uiDeltaTermPosition, pucTermPositionsPtr);
+        uiTermPosition += uiDeltaTermPosition;
+        
+        pspSrchPostingsPtr->uiTermPosition = uiTermPosition;
+    }
+
+
+    /* Move the term positions along, clearing them once they have all been loaded, the search 
+    ** postings which have not been decoded yet still need them if there is a decoder
+    */
+    psplSrchPostingsList->uiTermPositionsIndex = pspSrchPostingsEnd - psplSrchPostingsList->pspSrchPostings;
+    psplSrchPostingsList->pucTermPositions = ((psplSrchPostingsList->uiTermPositionsIndex < psplSrchPostingsList->uiSrchPostingsLength) || 
+            (psplSrchPostingsList->pvSrchTermSearchDecoder != NULL)) ? pucTermPositionsPtr : NULL;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchPostingMergeDocumentContainers()
+
+    Purpose:    This function ANDs or NOTs the document containers of psplSrchPostingsList2 
+                in the search postings of psplSrchPostingsList1, the search postings are 
+                filtered in place so this can be done without allocating anything.
+
+                When ANDing, the search postings of each document are folded into one search 
+                posting the way iSrchPostingMergeSrchPostingsListsAND() does, and the document 
+                containers weight is added to it.
+
+    Parameters: psplSrchPostingsList1       search postings list structure
+                psplSrchPostingsList2       search postings list structure with document containers
+                bAND                        true to AND the document containers, false to NOT them
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchPostingMergeDocumentContainers
+(
+    struct srchPostingsList *psplSrchPostingsList1,
+    struct srchPostingsList *psplSrchPostingsList2,
+    boolean bAND
+)
+{
+
+    struct srchPosting      *pspSrchPostingsReadPtr = NULL;
+    struct srchPosting      *pspSrchPostingsWritePtr = NULL;
+    struct srchPosting      *pspSrchPostingsEnd = NULL;
+    unsigned int            uiCurrentDocumentID = 0;
+    boolean                 bCurrentDocumentMatch = false;
+    float                   fCurrentWeight = 0;
+
+
+    ASSERT(psplSrchPostingsList1 != NULL);
+    ASSERT(psplSrchPostingsList1->pvUtlRoaring == NULL);
+    ASSERT(psplSrchPostingsList2 != NULL);
+    ASSERT(psplSrchPostingsList2->pvUtlRoaring != NULL);
+
+
+    /* Filter the search postings, the membership test is only done once per document */
+    for ( pspSrchPostingsReadPtr = psplSrchPostingsList1->pspSrchPostings, pspSrchPostingsWritePtr = psplSrchPostingsList1->pspSrchPostings,
+            pspSrchPostingsEnd = psplSrchPostingsList1->pspSrchPostings + psplSrchPostingsList1->uiSrchPostingsLength, 
+            psplSrchPostingsList1->uiDocumentCount = 0; pspSrchPostingsReadPtr < pspSrchPostingsEnd; pspSrchPostingsReadPtr++ ) {
+
+        /* New document */
+        if ( pspSrchPostingsReadPtr->uiDocumentID != uiCurrentDocumentID ) {
+            uiCurrentDocumentID = pspSrchPostingsReadPtr->uiDocumentID;
+            bCurrentDocumentMatch = (bUtlRoaringContainsValue(psplSrchPostingsList2->pvUtlRoaring, uiCurrentDocumentID) == bAND) ? true : false;
+            fCurrentWeight = psplSrchPostingsList2->fDocumentContainersWeight;
+        }
+
+        /* Skip this search posting if the document does not match */
+        if ( bCurrentDocumentMatch == false ) {
+            continue;
+        }
+
+        /* Keep the search posting as is when NOTing */
+        if ( bAND == false ) {
+            if ( (pspSrchPostingsWritePtr == psplSrchPostingsList1->pspSrchPostings) || ((pspSrchPostingsWritePtr - 1)->uiDocumentID != uiCurrentDocumentID) ) {
+                psplSrchPostingsList1->uiDocumentCount++;
+            }
+            SRCH_POSTING_COPY_SRCH_POSTING(pspSrchPostingsWritePtr, pspSrchPostingsReadPtr);
+            pspSrchPostingsWritePtr++;
+            continue;
+        }
+
+        /* Add up the weight when ANDing, and keep the last search posting for the document */
+        fCurrentWeight += pspSrchPostingsReadPtr->fWeight;
+
+        if ( ((pspSrchPostingsReadPtr + 1) == pspSrchPostingsEnd) || ((pspSrchPostingsReadPtr + 1)->uiDocumentID != uiCurrentDocumentID) ) {
+            SRCH_POSTING_COPY_SRCH_POSTING(pspSrchPostingsWritePtr, pspSrchPostingsReadPtr);
+            pspSrchPostingsWritePtr->fWeight = fCurrentWeight;
+            pspSrchPostingsWritePtr++;
+            psplSrchPostingsList1->uiDocumentCount++;
+        }
+    }
+
+
+    /* Set the postings length and the term count */
+    psplSrchPostingsList1->uiSrchPostingsLength = pspSrchPostingsWritePtr - psplSrchPostingsList1->pspSrchPostings;
+    psplSrchPostingsList1->uiTermCount = psplSrchPostingsList1->uiSrchPostingsLength;
+
+    /* Free the search postings if they were all filtered out */
+    if ( psplSrchPostingsList1->uiSrchPostingsLength == 0 ) {
+        s_free(psplSrchPostingsList1->pspSrchPostings);
+    }
+
+    /* Release the search posting blocks, they dont reflect the search postings anymore */
+    s_free(psplSrchPostingsList1->pspbSrchPostingBlocks);
+    psplSrchPostingsList1->uiSrchPostingBlocksLength = 0;
+
+    /* Set the term type and the required flag the way a merge would */
+    psplSrchPostingsList1->uiTermType = SPI_TERM_TYPE_REGULAR;
+    psplSrchPostingsList1->bRequired = ((psplSrchPostingsList1->bRequired == true) || (psplSrchPostingsList2->bRequired == true)) ? true : false;
+
+
+    ASSERT(iSrchPostingCheckSrchPostingsList(psplSrchPostingsList1) == SRCH_NoError);
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchPostingMergeSrchPostingsLoserTree()
+
+    Purpose:    This function merges a list of postings arrays into the passed 
+                postings array using a loser tree, the postings arrays are 
+                each sorted in ascending document ID and term position order
+                and the merged postings array is sorted in the same order.
+
+                Ties are broken on the postings array index, the lower index 
+                goes first, and the passed postings array must be large enough
+                to hold all the postings.
+
+                Proximity reweighting is applied to each merged posting in 
+                the same way as iSrchPostingMergeSrchPostingsListsOR() applies 
+                it if requested.
+
+    Parameters: ppspSrchPostingsList            postings arrays list
+                puiSrchPostingsLengthList       postings arrays lengths list
+                uiSrchPostingsListLength        postings arrays list length
+                bProximityReweighting           set to true to apply proximity reweighting
+                pspSrchPostings                 merged postings array
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchPostingMergeSrchPostingsLoserTree
+(
+    struct srchPosting **ppspSrchPostingsList,
+    unsigned int *puiSrchPostingsLengthList,
+    unsigned int uiSrchPostingsListLength,
+    boolean bProximityReweighting,
+    struct srchPosting *pspSrchPostings
+)
+{
+
+    int                     iError = SRCH_NoError;
+    struct srchPosting      *pspSrchPostingsPtr = NULL;
+    unsigned int            *puiOffsets = NULL;
+    unsigned int            *puiLoserTree = NULL;
+    unsigned int            uiI = 0;
+
+
+    ASSERT(ppspSrchPostingsList != NULL);
+    ASSERT(puiSrchPostingsLengthList != NULL);
+    ASSERT(uiSrchPostingsListLength > 0);
+    ASSERT(pspSrchPostings != NULL);
+
+
+    /* Allocate the offsets, these are the current offsets in the postings arrays */
+    if ( (puiOffsets = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiSrchPostingsListLength))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchPostingMergeSrchPostingsLoserTree;
+    }
+
+    /* Allocate the loser tree, the first entry holds the index of the winning postings array 
+    ** and the other entries hold the indices of the losing postings arrays at each node
+    */
+    if ( (puiLoserTree = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiSrchPostingsListLength))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchPostingMergeSrchPostingsLoserTree;
+    }
+
+
+    /* Build the loser tree, the nodes are seeded with the postings arrays list length which 
+    ** stands for a postings array which wins against all others, these get pushed out of the 
+    ** loser tree as the postings arrays are added to it
+    */
+    for ( uiI = 0; uiI < uiSrchPostingsListLength; uiI++ ) {
+        puiLoserTree[uiI] = uiSrchPostingsListLength;
+    }
+    for ( uiI = uiSrchPostingsListLength; uiI > 0; uiI-- ) {
+        iSrchPostingAdjustLoserTree(ppspSrchPostingsList, puiSrchPostingsLengthList, puiOffsets, puiLoserTree, uiSrchPostingsListLength, uiI - 1);
+    }
+
+
+    /* Pull the postings off the loser tree in order until the winning postings array is exhausted */
+    pspSrchPostingsPtr = pspSrchPostings;
+    while ( SRCH_POSTING_MERGE_EXHAUSTED(ppspSrchPostingsList, puiSrchPostingsLengthList, puiOffsets, puiLoserTree[0]) == false ) {
+        
+        unsigned int    uiIndex = puiLoserTree[0];
+        
+        /* Copy the posting from the winning postings array */
+        SRCH_POSTING_COPY_SRCH_POSTING(pspSrchPostingsPtr, ppspSrchPostingsList[uiIndex] + puiOffsets[uiIndex]);
+
+#if defined(SRCH_POSTING_ENABLE_PROXIMITY_REWEIGHTING)
+        if ( (bProximityReweighting == true) && (pspSrchPostingsPtr > pspSrchPostings) && 
+                (pspSrchPostingsPtr->uiDocumentID == (pspSrchPostingsPtr - 1)->uiDocumentID) && 
+                (pspSrchPostingsPtr->uiTermPosition == ((pspSrchPostingsPtr - 1)->uiTermPosition + 1)) ) {
+            pspSrchPostingsPtr->fWeight *= SRCH_POSTING_PROXIMITY_REWEIGHTING;
+        }
+#endif    /* defined(SRCH_POSTING_ENABLE_PROXIMITY_REWEIGHTING) */
+
+        pspSrchPostingsPtr++;
+        
+        /* Move on in the winning postings array and replay its matches up the loser tree */
+        puiOffsets[uiIndex]++;
+        iSrchPostingAdjustLoserTree(ppspSrchPostingsList, puiSrchPostingsLengthList, puiOffsets, puiLoserTree, uiSrchPostingsListLength, uiIndex);
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchPostingMergeSrchPostingsLoserTree:
+
+
+    /* Free the offsets and the loser tree */
+    s_free(puiOffsets);
+    s_free(puiLoserTree);
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchPostingAdjustLoserTree()
+
+    Purpose:    This function replays the matches for a postings array from its 
+                leaf to the root of the loser tree used by iSrchPostingMergeSrchPostingsLoserTree(), 
+                the loser of each match is kept at the node and the winner moves up. 
+                
+                A postings array index equal to the loser tree length wins against 
+                all postings arrays, exhausted postings arrays lose against all 
+                postings arrays, and the other postings arrays are ordered on their 
+                current posting.
+
+    Parameters: ppspSrchPostingsList            postings arrays list
+                puiSrchPostingsLengthList       postings arrays lengths list
+                puiOffsets                      current offsets in the postings arrays
+                puiLoserTree                    loser tree
+                uiLoserTreeLength               loser tree length
+                uiIndex                         index of the postings array to replay
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchPostingAdjustLoserTree
+(
+    struct srchPosting **ppspSrchPostingsList,
+    unsigned int *puiSrchPostingsLengthList,
+    unsigned int *puiOffsets,
+    unsigned int *puiLoserTree,
+    unsigned int uiLoserTreeLength,
+    unsigned int uiIndex
+)
+{
+
+    unsigned int    uiNode = 0;
+    unsigned int    uiLoser = 0;
+    boolean         bLoserWins = false;
+
+
+    ASSERT(ppspSrchPostingsList != NULL);
+    ASSERT(puiSrchPostingsLengthList != NULL);
+    ASSERT(puiOffsets != NULL);
+    ASSERT(puiLoserTree != NULL);
+    ASSERT(uiIndex < uiLoserTreeLength);
+
+
+    /* Replay the matches from the leaf to the root, the leaves sit below the nodes */
+    for ( uiNode = (uiIndex + uiLoserTreeLength) / 2; uiNode > 0; uiNode /= 2 ) {
+        
+        uiLoser = puiLoserTree[uiNode];
+
+        /* Work out whether the loser at this node wins against the current winner */
+        if ( uiLoser == uiLoserTreeLength ) {
+            bLoserWins = true;
+        }
+        else if ( uiIndex == uiLoserTreeLength ) {
+            bLoserWins = false;
+        }
+        else if ( SRCH_POSTING_MERGE_EXHAUSTED(ppspSrchPostingsList, puiSrchPostingsLengthList, puiOffsets, uiLoser) == true ) {
+            bLoserWins = false;
+        }
+        else if ( SRCH_POSTING_MERGE_EXHAUSTED(ppspSrchPostingsList, puiSrchPostingsLengthList, puiOffsets, uiIndex) == true ) {
+            bLoserWins = true;
+        }
+        else {
+            bLoserWins = SRCH_POSTING_MERGE_PRECEDES(ppspSrchPostingsList[uiLoser] + puiOffsets[uiLoser], uiLoser, 
+                    ppspSrchPostingsList[uiIndex] + puiOffsets[uiIndex], uiIndex);
+        }
+        
+        /* Swap the winner and the loser if the loser won */
+        if ( bLoserWins == true ) {
+            puiLoserTree[uiNode] = uiIndex;
+            uiIndex = uiLoser;
+        }
+    }
+    
+    /* Set the winner */
+    puiLoserTree[0] = uiIndex;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchPostingPrintSrchPostingsList()
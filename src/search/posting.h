@@ -78,6 +78,16 @@ struct srchPosting {
 };    
 
 
+/* Search posting block structure, this gives an upper bound on the weight 
+** any one document can get from the search postings in a block, blocks 
+** are consecutive and each one ends on the document ID given
+*/
+struct srchPostingBlock {
+    unsigned int            uiDocumentID;                   /* Last document ID in the block */
+    float                   fMaxWeight;                     /* Maximum document weight in the block */
+};
+
+
 /* Search postings list structure */
 struct srchPostingsList {
     unsigned int            uiTermType;                     /* Term type */
@@ -86,6 +96,14 @@ struct srchPostingsList {
     boolean                 bRequired;                      /* Required flag */
     struct srchPosting      *pspSrchPostings;               /* Search postings array */
     unsigned int            uiSrchPostingsLength;           /* Search postings array length - same as uiTermCount */
+    struct srchPostingBlock *pspbSrchPostingBlocks;         /* Search posting blocks array (optional) */
+    unsigned int            uiSrchPostingBlocksLength;      /* Search posting blocks array length */
+    void                    *pvUtlRoaring;                  /* Document containers, these hold the document IDs instead of the search postings (optional) */
+    float                   fDocumentContainersWeight;      /* Term weight for the documents in the document containers */
+    unsigned char           *pucTermPositions;              /* Term positions which have not been loaded yet, see iSrchPostingLoadTermPositions() (optional) */
+    unsigned int            uiTermPositionsIndex;           /* Index of the first search posting whose term position has not been loaded yet */
+    void                    *pvSrchTermSearchDecoder;       /* Decoder for the search postings which have not been decoded yet, the search postings 
+                                                            ** array then only holds the current ones, see iSrchTermSearchDecodeNextSrchPostings() (optional) */
 };
 
 
@@ -107,12 +125,32 @@ int iSrchPostingCheckSrchPostingsList (struct srchPostingsList *psplSrchPostings
 int iSrchPostingSortDocumentIDAsc (struct srchPosting *pspSrchPostings, 
         int iSrchSearchPostingsLeftIndex, int iSrchSearchPostingsRightIndex);
 
+int iSrchPostingMergeSrchPostings (struct srchPosting **ppspSrchPostingsList, 
+        unsigned int *puiSrchPostingsLengthList, unsigned int uiSrchPostingsListLength, 
+        struct srchPosting **ppspSrchPostings, unsigned int *puiSrchPostingsLength);
+
+struct srchPosting *pspSrchPostingSeekDocumentID (struct srchPosting *pspSrchPostingsPtr, 
+        struct srchPosting *pspSrchPostingsEnd, unsigned int uiDocumentID);
+
+int iSrchPostingDecodeSrchPostings (struct srchPostingsList *psplSrchPostingsList);
+
+int iSrchPostingExpandDocumentContainers (struct srchPostingsList *psplSrchPostingsList);
+
+int iSrchPostingLoadTermPositions (struct srchPostingsList *psplSrchPostingsList, 
+        struct srchPosting *pspSrchPostingsPtr, unsigned int uiSrchPostingsLength);
+
+int iSrchPostingCreateSrchPostingBlocks (struct srchPostingsList *psplSrchPostingsList);
+
 
 
 int iSrchPostingMergeSrchPostingsListsOR (struct srchPostingsList *psplSrchPostingsList1, 
         struct srchPostingsList *psplSrchPostingsList2, unsigned int uiSrchPostingBooleanOperationID,
         struct srchPostingsList **ppsplSrchPostingsList);
 
+int iSrchPostingMergeSrchPostingsListsMultiOR (struct srchPostingsList **ppsplSrchPostingsLists, 
+        unsigned int uiSrchPostingsListsLength, unsigned int uiSrchPostingBooleanOperationID,
+        struct srchPostingsList **ppsplSrchPostingsList);
+
 int iSrchPostingMergeSrchPostingsListsIOR (struct srchPostingsList *psplSrchPostingsList1, 
         struct srchPostingsList *psplSrchPostingsList2, unsigned int uiSrchPostingBooleanOperationID,
         struct srchPostingsList **ppsplSrchPostingsList);
@@ -667,6 +667,179 @@ int iSrchReportAppend
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchReportCreateSubReport()
+
+    Purpose:    This function creates an in-memory sub report for a search 
+                report, this is used to collect the part of the search report 
+                generated by a search running in its own thread, the sub report 
+                is then appended to the search report with iSrchReportAppendSubReport().
+
+                The sub report is only active if the search report is active.
+
+    Parameters: pvSrchReport        search report structure
+                ppvSrchSubReport    return pointer for the sub report structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchReportCreateSubReport
+(
+    void *pvSrchReport,
+    void **ppvSrchSubReport
+)
+{
+
+    int                 iError = SRCH_NoError;
+    struct srchReport   *psrSrchReport = (struct srchReport *)pvSrchReport;
+    struct srchReport   *psrSrchSubReport = NULL;
+
+
+    /* Check the parameters */
+    if ( pvSrchReport == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvSrchReport' parameter passed to 'iSrchReportCreateSubReport'."); 
+        return (SRCH_ReportInvalidReport);
+    }
+
+    if ( ppvSrchSubReport == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppvSrchSubReport' parameter passed to 'iSrchReportCreateSubReport'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Allocate a search report structure */
+    if ( (psrSrchSubReport = (struct srchReport *)s_malloc((size_t)(sizeof(struct srchReport)))) == NULL ) {
+        return (SRCH_MemError);
+    } 
+
+    /* Sub reports are always in memory, and are off if the search report is off */
+    psrSrchSubReport->uiSearchReportType = SRCH_REPORT_TYPE_MEMORY;
+    psrSrchSubReport->uiSearchReportMode = SRCH_REPORT_MODE_OFF;
+
+    /* Create the string buffer handle */
+    if ( (iError = iUtlStringBufferCreate(&psrSrchSubReport->pvUtlStringBuffer)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the string buffer for the in-memory search sub report, utl error: %d.", iError);
+        iError = SRCH_MemError;
+        goto bailFromiSrchReportCreateSubReport;
+    }
+
+    /* Set the search report mode */
+    if ( psrSrchReport->uiSearchReportMode == SRCH_REPORT_MODE_READ_WRITE ) {
+        psrSrchSubReport->uiSearchReportMode = SRCH_REPORT_MODE_READ_WRITE;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchReportCreateSubReport:
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointer */
+        *ppvSrchSubReport = psrSrchSubReport;
+    }
+    else {
+
+        /* Free resources */
+        iSrchReportClose((void *)psrSrchSubReport);
+        psrSrchSubReport = NULL;
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchReportAppendSubReport()
+
+    Purpose:    This function appends a sub report to the search report
+                and clears the sub report.
+
+    Parameters: pvSrchReport        search report structure
+                pvSrchSubReport     sub report structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchReportAppendSubReport
+(
+    void *pvSrchReport,
+    void *pvSrchSubReport
+)
+{
+
+    struct srchReport   *psrSrchReport = (struct srchReport *)pvSrchReport;
+    struct srchReport   *psrSrchSubReport = (struct srchReport *)pvSrchSubReport;
+    unsigned char       *pucSearchSubReportText = NULL;
+
+
+    /* Check the parameters */
+    if ( pvSrchReport == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvSrchReport' parameter passed to 'iSrchReportAppendSubReport'."); 
+        return (SRCH_ReportInvalidReport);
+    }
+
+    if ( pvSrchSubReport == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvSrchSubReport' parameter passed to 'iSrchReportAppendSubReport'."); 
+        return (SRCH_ReportInvalidReport);
+    }
+
+
+    /* Check the report modes, we cant append to a report file if we cant read and write */
+    if ( (psrSrchReport->uiSearchReportMode != SRCH_REPORT_MODE_READ_WRITE) || (psrSrchSubReport->uiSearchReportMode != SRCH_REPORT_MODE_READ_WRITE) ) {
+        return (SRCH_ReportInvalidMode);
+    }
+
+    /* Check the report type, we can't handle an unknown cache type */
+    if ( psrSrchReport->uiSearchReportType == SRCH_REPORT_TYPE_UNKNOWN ) {
+        return (SRCH_ReportInvalidType);
+    }
+
+
+    /* Get the sub report text */
+    iUtlStringBufferGetString(psrSrchSubReport->pvUtlStringBuffer, &pucSearchSubReportText);
+
+    /* Append the sub report text, we dont go through iSrchReportAppend() because the text can be longer than a report entry */
+    if ( bUtlStringsIsStringNULL(pucSearchSubReportText) == false ) {
+
+        /* Memory type */
+        if ( psrSrchReport->uiSearchReportType == SRCH_REPORT_TYPE_MEMORY ) {
+            iUtlStringBufferAppend(psrSrchReport->pvUtlStringBuffer, pucSearchSubReportText);
+        }
+        
+        /* File type */
+        else if ( psrSrchReport->uiSearchReportType == SRCH_REPORT_TYPE_FILE ) {
+            if ( psrSrchReport->pfSearchReportFile != NULL ) {
+                s_fputs(pucSearchSubReportText, psrSrchReport->pfSearchReportFile); 
+            }
+        }
+    }
+
+    /* Clear the sub report */
+    iUtlStringBufferClear(psrSrchSubReport->pvUtlStringBuffer);
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchReportGetReportKey()
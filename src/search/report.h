@@ -69,6 +69,10 @@ int iSrchReportCloseReport (void *pvSrchReport);
 
 int iSrchReportAppend (void *pvSrchReport, unsigned char *pucFormat, ...);
 
+int iSrchReportCreateSubReport (void *pvSrchReport, void **ppvSrchSubReport);
+
+int iSrchReportAppendSubReport (void *pvSrchReport, void *pvSrchSubReport);
+
 int iSrchReportGetReportKey (void *pvSrchReport, unsigned char *pucSearchReportKey, 
         unsigned int uiSearchReportKeyLength);
 
@@ -77,6 +77,44 @@
 /* #define SRCH_SEARCH_ENABLE_CASELESS_SOUNDEX */
 
 
+/* Enable posting cursors, these evaluate the parser term cluster a document 
+** at a time rather than materializing a postings list at every level
+*/
+#define SRCH_SEARCH_ENABLE_POSTING_CURSORS
+
+
+/* Enable block-max WAND, this only fully evaluates the documents which can make it 
+** into the top results of a relevance ranked free text search, it needs posting 
+** cursors and a document weight normalization with a known upper bound
+*/
+#define SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND
+
+
+/* Enable term positions for all the terms in a search, otherwise only the terms in ADJ 
+** and NEAR term clusters get them. The proximity reweighting in posting.c and cursor.c 
+** boosts adjacent postings in OR, IOR and AND merges so it needs them, turn this off 
+** along with the proximity reweighting. The term positions are loaded lazily from the 
+** term position stream when the index has one, so cursors only read them for the 
+** documents where search postings actually get merged
+*/
+#define SRCH_SEARCH_ENABLE_TERM_POSITIONS_FOR_ALL_TERMS
+
+
+/* Enable search plans, these estimate the document count of every term and term
+** cluster from the term dictionary before any postings are read
+*/
+#define SRCH_SEARCH_ENABLE_SEARCH_PLANS
+
+
+/* Enable search plan reordering, the terms of AND and OR term clusters are processed 
+** in order of increasing estimated document count so the smallest term drives 
+** intersections and an empty term completes them early. The proximity reweighting 
+** in posting.c and cursor.c depends on the order in which the terms are merged 
+** so this changes the weights, only turn this on if the proximity reweighting is off
+*/
+/* #define SRCH_SEARCH_ENABLE_SEARCH_PLAN_REORDERING */
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -107,6 +145,25 @@
                                                                             ((n) <= SRCH_SEARCH_INDEX_TYPE_VIRTUAL))
 
 
+/* Whether term positions are needed for a term outside of an ADJ or NEAR term cluster */
+#if defined(SRCH_SEARCH_ENABLE_TERM_POSITIONS_FOR_ALL_TERMS)
+#define SRCH_SEARCH_TERM_POSITIONS_DEFAULT                          (true)
+#else
+#define SRCH_SEARCH_TERM_POSITIONS_DEFAULT                          (false)
+#endif    /* defined(SRCH_SEARCH_ENABLE_TERM_POSITIONS_FOR_ALL_TERMS) */
+
+/* Whether term positions are needed for the terms in a term cluster */
+#define SRCH_SEARCH_TERM_CLUSTER_NEEDS_TERM_POSITIONS(b, n)         (((b) == true) || ((n) == SRCH_PARSER_OPERATOR_ADJ_ID) || \
+                                                                            ((n) == SRCH_PARSER_OPERATOR_NEAR_ID))
+
+/* Whether a term in a term cluster can be searched as document containers rather than postings, this is only 
+** done for terms which are ANDed or NOTed into what comes before them, where only the document IDs matter, 
+** and only if the term positions are not needed
+*/
+#define SRCH_SEARCH_TERM_CLUSTER_USES_DOCUMENT_CONTAINERS(b, n, i)  ((SRCH_SEARCH_TERM_CLUSTER_NEEDS_TERM_POSITIONS((b), (n)) == false) && ((i) > 0) && \
+                                                                            (((n) == SRCH_PARSER_OPERATOR_AND_ID) || ((n) == SRCH_PARSER_OPERATOR_NOT_ID)))
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -163,6 +220,26 @@
 /*---------------------------------------------------------------------------*/
 
 
+/* Maximum number of segment threads default, the segments of a virtual 
+** index are searched serially unless this is overridden in the configuration
+*/
+#define SRCH_SEARCH_SEGMENT_THREADS_DEFAULT                         (1)
+
+
+/* Maximum number of term threads default, the terms an expanded term 
+** expands to are fetched serially unless this is overridden in the configuration
+*/
+#define SRCH_SEARCH_TERM_THREADS_DEFAULT                            (1)
+
+/* Minimum number of terms an expanded term has to expand to before we fetch 
+** them in more than one thread, fewer terms than that are not worth the thread overhead
+*/
+#define SRCH_SEARCH_TERM_THREADS_MINIMUM_TERMS                      (16)
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /* Long string length */
 #define SRCH_SEARCH_LONG_STRING_LENGTH                              (4096)
 
@@ -170,6 +247,33 @@
 /*---------------------------------------------------------------------------*/
 
 
+/* Block-max WAND needs posting cursors, and the document weight normalization 
+** needs to have an upper bound, which rules out the average and the log2
+*/
+#if defined(SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND)
+#if !defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS) || defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_AVERAGE) || \
+        defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG2)
+#undef SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND
+#endif
+#endif    /* defined(SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND) */
+
+
+/* Upper bound of the normalized document weight over the raw document weight, 
+** documents have at least one term so the log normalization divides by at least log(2)
+*/
+#if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG)
+#define SRCH_SEARCH_BLOCK_MAX_WAND_NORMALIZATION_BOUND              (1.0 / log(2.0))
+#else
+#define SRCH_SEARCH_BLOCK_MAX_WAND_NORMALIZATION_BOUND              (1.0)
+#endif    /* defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG) */
+
+/* Slack applied to the minimum weight to absorb rounding differences */
+#define SRCH_SEARCH_BLOCK_MAX_WAND_SLACK                            (0.9999)
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 ** Structures
 */
@@ -190,9 +294,73 @@ struct srchSearchIndex {
     struct srchSearchIndexSort      *psisSrchSearchIndexSorts;                          /* Search index sorts array */
     unsigned int                    uiSrchSearchIndexSortsLength;                       /* Search index sorts array length */
     boolean                         bIgnoreIndexOpenError;                              /* Open error flag */
+};
+
+
+/* Search plan structure, there is one per parser term cluster */
+struct srchSearchPlan {
+    unsigned int                    uiDocumentCount;                                    /* Estimated document count */
+    unsigned int                    *puiTermIndices;                                    /* Term indices, in processing order */
+    unsigned int                    *puiDocumentCounts;                                 /* Estimated document counts, indexed like the terms */
+    struct srchSearchPlan           **ppsspSrchSearchPlans;                             /* Search plans, indexed like the terms, NULL for terms */
+    unsigned int                    uiTermsLength;                                      /* Terms length */
+    boolean                         bReordered;                                         /* Set if the terms were reordered */
+};
+
+
+/* Search top document structure, block-max WAND keeps a heap of these */
+struct srchSearchTopDocument {
+    unsigned int                    uiDocumentID;                                       /* Document ID */
+    float                           fWeight;                                            /* Raw document weight */
+    float                           fNormalizedWeight;                                  /* Normalized document weight */
 };    
 
 
+/* Search segment structure, there is one per segment of a virtual index searched in its own thread */
+struct srchSearchSegment {
+    struct srchSearch               ssSrchSearch;                                       /* Search structure, with its own search report */
+    struct srchIndex                *psiSrchIndex;                                      /* Index structure */
+    unsigned int                    uiLanguageID;                                       /* Language ID */
+    wchar_t                         *pwcSearchText;                                     /* Search text */
+    wchar_t                         *pwcPositiveFeedbackText;                           /* Positive feedback text */
+    wchar_t                         *pwcNegativeFeedbackText;                           /* Negative feedback text */
+    unsigned int                    uiEndIndex;                                         /* End index */
+    unsigned int                    uiSortFieldType;                                    /* Sort field type */
+    unsigned int                    uiSortType;                                         /* Sort type */
+    struct srchShortResult          *pssrSrchShortResults;                              /* Short results (returned) */
+    unsigned int                    uiSrchShortResultsLength;                           /* Short results length (returned) */
+    unsigned int                    uiTotalResults;                                     /* Total results (returned) */
+    double                          dMaxSortKey;                                        /* Max sort key (returned) */
+    int                             iError;                                             /* Search error (returned) */
+    pthread_t                       tThread;                                            /* Search thread */
+    boolean                         bThreaded;                                          /* Set if the search is running in its own thread */
+    boolean                         bStarted;                                           /* Set if the search was started */
+};
+
+
+/* Search term fetch structure, the terms an expanded term expands to are split 
+** between these, each one fetching every uiTermStep term from uiFirstTerm on
+*/
+struct srchSearchTermFetch {
+    struct srchSearch               *pssSrchSearch;                                     /* Search structure */
+    struct srchIndex                *psiSrchIndex;                                      /* Index structure */
+    struct srchTermDictInfo         *pstdiSrchTermDictInfos;                            /* Term dictionary info array */
+    unsigned int                    uiSrchTermDictInfosLength;                          /* Term dictionary info array length */
+    unsigned int                    uiFirstTerm;                                        /* First term to fetch */
+    unsigned int                    uiTermStep;                                         /* Step between the terms to fetch */
+    float                           fTermWeight;                                        /* Term weight */
+    unsigned char                   *pucFieldIDBitmap;                                  /* Field ID bitmap */
+    float                           fFrequentTermCoverageThreshold;                     /* Frequent term coverage threshold */
+    unsigned int                    uiStartDocumentID;                                  /* Start document ID */
+    unsigned int                    uiEndDocumentID;                                    /* End document ID */
+    boolean                         bTermPositions;                                     /* Term positions flag */
+    struct srchPostingsList         **ppsplSrchPostingsLists;                           /* Postings lists, indexed like the terms (returned) */
+    int                             iError;                                             /* Fetch error (returned) */
+    pthread_t                       tThread;                                            /* Fetch thread */
+    boolean                         bThreaded;                                          /* Set if the fetch is running in its own thread */
+};
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -213,16 +381,24 @@ static int iSrchSearchGetShortResultsFromSearch (struct srchSearch *pssSrchSearc
         unsigned int uiSortFieldType, unsigned int uiSortType, struct srchShortResult **ppssrSrchShortResults, 
         unsigned int *puiSrchShortResultsLength, unsigned int *puiTotalResults, double *pdMaxSortKey);
 
+static int iSrchSearchCheckIndexSummary (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex, 
+        boolean *pbSkipIndex);
+
+static int iSrchSearchCheckIndexTermFilter (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex, 
+        boolean *pbSkipIndex);
+
 static int iSrchSearchGetRawResultsFromSearch (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex,
         unsigned int uiLanguageID, wchar_t *pwcSearchText, wchar_t *pwcPositiveFeedbackText, 
-        wchar_t *pwcNegativeFeedbackText, unsigned int uiSortFieldType, unsigned int uiSortType, 
+        wchar_t *pwcNegativeFeedbackText, unsigned int uiEndIndex, unsigned int uiSortFieldType, unsigned int uiSortType, 
         struct srchPostingsList **ppsplSrchPostingsList, struct srchWeight **ppswSrchWeight, boolean *pbDocumentTable, 
-        struct srchBitmap **ppsbSrchBitmapExclusion, struct srchBitmap **ppsbSrchBitmapInclusion);
+        struct srchBitmap **ppsbSrchBitmapExclusion, struct srchBitmap **ppsbSrchBitmapInclusion, 
+        struct srchBitmap **ppsbSrchBitmapDates, unsigned int *puiTopDocumentsTotalResults, 
+        boolean *pbTopDocumentsTotalResultsEstimated);
 
 static int iSrchSearchGetShortResultsFromRawResults (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex, 
         struct srchPostingsList *psplSrchPostingsList, struct srchWeight *pswSrchWeight, boolean bDocumentTable, 
         struct srchBitmap *psbSrchBitmapExclusion, struct srchBitmap *psbSrchBitmapInclusion, 
-        unsigned int uiSortFieldType, unsigned int uiSortType, 
+        struct srchBitmap *psbSrchBitmapDates, unsigned int uiEndIndex, unsigned int uiSortFieldType, unsigned int uiSortType, 
         struct srchShortResult **ppssrSrchShortResults, unsigned int *puiSrchShortResultsLength,
         unsigned int *puiTotalResults, double *pdMaxSortKey);
 
@@ -230,19 +406,62 @@ static int iSrchSearchGetSpiSearchResultsFromShortResults (struct srchSearch *ps
         struct srchShortResult *pssrSrchShortResults, unsigned int uiSrchShortResultsLength, struct spiSearchResult *pssrSpiSearchResults,
         unsigned int uiSortType);
 
+#if defined(SRCH_SEARCH_ENABLE_SEARCH_PLANS)
+static int iSrchSearchCreatePlanFromParserTermCluster (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex,
+        struct srchParserTermCluster *psptcSrchParserTermCluster, struct srchSearchPlan **ppsspSrchSearchPlan);
+
+static int iSrchSearchGetDocumentCountEstimateFromParserTerm (struct srchIndex *psiSrchIndex,
+        struct srchParserTerm *psptSrchParserTerm, unsigned int *puiDocumentCount);
+
+static int iSrchSearchReportPlan (struct srchSearch *pssSrchSearch, struct srchParserTermCluster *psptcSrchParserTermCluster, 
+        struct srchSearchPlan *psspSrchSearchPlan, unsigned int uiLevel);
+
+static int iSrchSearchFreePlan (struct srchSearchPlan *psspSrchSearchPlan);
+#endif    /* defined(SRCH_SEARCH_ENABLE_SEARCH_PLANS) */
+
+#if defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS)
+static int iSrchSearchGetCursorFromParserTermCluster (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex,
+        unsigned int uiLanguageID, struct srchParserTermCluster *psptcSrchParserTermCluster, 
+        struct srchSearchPlan *psspSrchSearchPlan, boolean bTermPositions, struct srchCursor **ppscSrchCursor);
+#else
 static int iSrchSearchGetPostingsListFromParserTermCluster (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex,
         unsigned int uiLanguageID, struct srchParserTermCluster *psptcSrchParserTermCluster, 
-        struct srchPostingsList **ppsplSrchPostingsList);
+        struct srchSearchPlan *psspSrchSearchPlan, boolean bTermPositions, struct srchPostingsList **ppsplSrchPostingsList);
+#endif    /* defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS) */
+
+#if defined(SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND)
+static int iSrchSearchGetTopPostingsListFromParserTermCluster (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex,
+        unsigned int uiLanguageID, struct srchParserTermCluster *psptcSrchParserTermCluster, unsigned int uiTopDocumentsLength,
+        struct srchPostingsList **ppsplSrchPostingsList, unsigned int *puiTopDocumentsTotalResults, 
+        boolean *pbTopDocumentsTotalResultsEstimated);
+
+static int iSrchSearchCompareTopDocumentByDocumentIDAsc (struct srchSearchTopDocument *psstdSrchSearchTopDocument1, 
+        struct srchSearchTopDocument *psstdSrchSearchTopDocument2);
+#endif    /* defined(SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND) */
 
 static int iSrchSearchGetPostingsListFromParserTerm (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex,
         unsigned int uiLanguageID, struct srchParserTerm *psptSrchParserTerm, unsigned int uiStartDocumentID, unsigned int uiEndDocumentID,
-        struct srchPostingsList **ppsplSrchPostingsList);
+        boolean bTermPositions, boolean bDocumentContainers, boolean bDecodeOnDemand, struct srchPostingsList **ppsplSrchPostingsList);
 
 
+static int iSrchSearchGetSearchBitmapFromDates (struct srchIndex *psiSrchIndex, struct srchParserNumber *pspnSrchParserNumberDates, 
+        unsigned int uiSrchParserNumberDatesLength, struct srchBitmap **ppsbSrchBitmap);
+
 static int iSrchSearchFilterNumberAgainstSrchParserNumbers (unsigned long ulNumber, struct srchParserNumber *ppspnSrchParserNumber, 
         unsigned int uiSrchParserNumberLength);
 
 
+static int iSrchSearchStartSearchSegment (struct srchSearch *pssSrchSearch, struct srchSearchSegment *psssSrchSearchSegment);
+
+static int iSrchSearchSearchSegment (struct srchSearchSegment *psssSrchSearchSegment);
+
+static int iSrchSearchFinishSearchSegment (struct srchSearchSegment *psssSrchSearchSegment);
+
+static int iSrchSearchFreeSearchSegments (struct srchSearchSegment *psssSrchSearchSegments, 
+        unsigned int uiSrchSearchSegmentsLength);
+
+static int iSrchSearchFetchTerms (struct srchSearchTermFetch *psstfSrchSearchTermFetch);
+
 static int iSrchSearchAddEntryToSpiDocumentItems (unsigned char *pucItemName, unsigned char *pucMimeType, 
         unsigned char *pucUrl, unsigned int uiLength, void *pvData, unsigned int uiDataLength, boolean bCopyData, 
         struct spiDocumentItem **ppsdiSpiDocumentItems, unsigned int *puiDocumentItemsLength);
@@ -1245,6 +1464,16 @@ int iSpiSearchIndex
     double                      dMaxSortKey = 0;
     
     boolean                     bSearchResultsTotalMainEstimated = false;
+    boolean                     bMainSrchShortResultsSorted = false;
+    
+    unsigned int                uiSearchSegmentThreads = SRCH_SEARCH_SEGMENT_THREADS_DEFAULT;
+    struct srchSearchSegment    *psssSrchSearchSegments = NULL;
+    unsigned int                uiSrchSearchSegmentsLength = 0;
+    unsigned int                uiSrchSearchSegmentsStarted = 0;
+    struct srchShortResult      **ppssrSrchShortResultsList = NULL;
+    unsigned int                *puiSrchShortResultsLengthList = NULL;
+    unsigned int                uiSrchShortResultsListLength = 0;
+    unsigned int                uiSrchShortResultsListTotal = 0;
     
     unsigned char               pucConfigValue[SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1] = {'\0'};
     
@@ -1414,6 +1643,19 @@ int iSpiSearchIndex
     }
 
 
+    /* Get the search maximum number of segment threads */
+    if ( iUtlConfigGetValue(pssSrchSearch->pvUtlConfig, SRCH_SEARCH_CONFIG_SEARCH_MAXIMUM_SEGMENT_THREADS, pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1) == UTL_NoError ) {
+        
+        if ( s_strtol(pucConfigValue, NULL, 10) <= 0 ) {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Invalid search maximum segment threads found in the search configuration file, config key: '%s', config value: '%s'.", 
+                    SRCH_SEARCH_CONFIG_SEARCH_MAXIMUM_SEGMENT_THREADS, pucConfigValue);
+        }
+        else {
+            uiSearchSegmentThreads = s_strtol(pucConfigValue, NULL, 10);
+        }
+    }
+
+
     
     /* Set the search start time */
     s_gettimeofday(&tvSearchStartTimeVal, NULL);
@@ -1899,6 +2141,68 @@ int iSpiSearchIndex
             */
             iIndexListIndex = (bEarlyCompletion == false) ? 0 : ((bReverseOrder == false) ? 0 : (pssiSrchSearchIndex->uiSrchIndexListLength - 1));
 
+
+            /* Search the segments in their own threads if we are allowed more than one thread and if there is more than one segment,
+            ** the search segments are in search order, and up to the maximum number of segment threads are kept running ahead
+            ** of the segment we are processing, the short results of each segment are collected and merged at the end
+            */
+            uiSrchSearchSegmentsLength = 0;
+            uiSrchSearchSegmentsStarted = 0;
+            uiSrchShortResultsListLength = 0;
+            uiSrchShortResultsListTotal = 0;
+            
+            if ( (uiSearchSegmentThreads > 1) && (pssiSrchSearchIndex->uiSrchIndexListLength > 1) ) {
+
+                wchar_t     *pwcSrchParserNormalizedSearchText = NULL;
+
+                /* Create the normalized search texts before any search segment thread is started, the parser 
+                ** creates them the first time they are asked for and the search segment threads share the parser
+                */
+                if ( (iError = iSrchParserGetNormalizedSearchText(pssSrchSearch->pvSrchParser, &pwcSrchParserNormalizedSearchText)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser normalized search text, srch error: %d.", iError);
+                    goto bailFromiSrchSearchIndex;
+                }
+
+                if ( (iError = iSrchParserGetFullNormalizedSearchText(pssSrchSearch->pvSrchParser, &pwcSrchParserNormalizedSearchText)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser full normalized search text, srch error: %d.", iError);
+                    goto bailFromiSrchSearchIndex;
+                }
+
+                /* Allocate the search segments */
+                if ( (psssSrchSearchSegments = (struct srchSearchSegment *)s_malloc((size_t)(sizeof(struct srchSearchSegment) * pssiSrchSearchIndex->uiSrchIndexListLength))) == NULL ) {
+                    iError = SPI_MemError;
+                    goto bailFromiSrchSearchIndex;
+                }
+                uiSrchSearchSegmentsLength = pssiSrchSearchIndex->uiSrchIndexListLength;
+
+                /* Allocate the short results list */
+                if ( (ppssrSrchShortResultsList = (struct srchShortResult **)s_malloc((size_t)(sizeof(struct srchShortResult *) * uiSrchSearchSegmentsLength))) == NULL ) {
+                    iError = SPI_MemError;
+                    goto bailFromiSrchSearchIndex;
+                }
+
+                /* Allocate the short results length list */
+                if ( (puiSrchShortResultsLengthList = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiSrchSearchSegmentsLength))) == NULL ) {
+                    iError = SPI_MemError;
+                    goto bailFromiSrchSearchIndex;
+                }
+
+                /* Set up the search segments in search order */
+                for ( uiJ = 0; uiJ < uiSrchSearchSegmentsLength; uiJ++ ) {
+                    
+                    struct srchSearchSegment    *psssSrchSearchSegment = psssSrchSearchSegments + uiJ;
+
+                    psssSrchSearchSegment->psiSrchIndex = pssiSrchSearchIndex->ppsiSrchIndexList[(bReverseOrder == true) ? ((uiSrchSearchSegmentsLength - 1) - uiJ) : uiJ];
+                    psssSrchSearchSegment->uiLanguageID = uiLanguageID;
+                    psssSrchSearchSegment->pwcSearchText = pwcSearchText;
+                    psssSrchSearchSegment->pwcPositiveFeedbackText = pwcPositiveFeedbackText;
+                    psssSrchSearchSegment->pwcNegativeFeedbackText = pwcNegativeFeedbackText;
+                    psssSrchSearchSegment->uiEndIndex = uiEndIndex;
+                    psssSrchSearchSegment->uiSortFieldType = uiSortFieldType;
+                    psssSrchSearchSegment->uiSortType = uiSortType;
+                }
+            }
+
             /* Loop while we are still within the range */
             while ( (iIndexListIndex >= 0) && (iIndexListIndex < pssiSrchSearchIndex->uiSrchIndexListLength) ) {
         
@@ -1917,10 +2221,46 @@ int iSpiSearchIndex
 /*                     iUtlLogDebug(UTL_LOG_CONTEXT, "Searching: %d - '%s'", iIndexListIndex, psiSrchIndex->pucIndexName); */
 /*                 } */
 
-                /* Do the search - note that we override the doc start index, setting it to 0, if this is a multi index search */
-                if ( (iError = iSrchSearchGetShortResultsFromSearch(pssSrchSearch, psiSrchIndex, uiLanguageID, pwcSearchText, pwcPositiveFeedbackText,
-                        pwcNegativeFeedbackText, ((uiIndexCount > 1) ? 0 : uiStartIndex), uiEndIndex, uiSortFieldType, 
-                        uiSortType, &pssrSrchShortResults, &uiSrchShortResultsLength, &uiTotalResults, &dMaxSortKey)) == SRCH_NoError ) {
+                /* Get the search results from the search segment if we are searching the segments in their own threads */
+                if ( psssSrchSearchSegments != NULL ) {
+                
+                    unsigned int                uiSrchSearchSegmentIndex = (bReverseOrder == true) ? ((uiSrchSearchSegmentsLength - 1) - (unsigned int)iIndexListIndex) : (unsigned int)iIndexListIndex;
+                    struct srchSearchSegment    *psssSrchSearchSegment = psssSrchSearchSegments + uiSrchSearchSegmentIndex;
+
+                    /* Start the search segments up to the maximum number of segment threads ahead of this one */
+                    while ( (uiSrchSearchSegmentsStarted < uiSrchSearchSegmentsLength) && (uiSrchSearchSegmentsStarted < (uiSrchSearchSegmentIndex + uiSearchSegmentThreads)) ) {
+                        if ( (iError = iSrchSearchStartSearchSegment(pssSrchSearch, psssSrchSearchSegments + uiSrchSearchSegmentsStarted)) != SRCH_NoError ) {
+                            goto bailFromiSrchSearchIndex;
+                        }
+                        uiSrchSearchSegmentsStarted++;
+                    }
+
+                    /* Wait for the search of this segment to finish */
+                    iError = iSrchSearchFinishSearchSegment(psssSrchSearchSegment);
+
+                    /* Append the search report for this segment, ignoring any errors since the search report may be off */
+                    iSrchReportAppendSubReport(pssSrchSearch->pvSrchReport, psssSrchSearchSegment->ssSrchSearch.pvSrchReport);
+
+                    /* Hand over the search results */
+                    if ( iError == SRCH_NoError ) {
+                        pssrSrchShortResults = psssSrchSearchSegment->pssrSrchShortResults;
+                        uiSrchShortResultsLength = psssSrchSearchSegment->uiSrchShortResultsLength;
+                        uiTotalResults = psssSrchSearchSegment->uiTotalResults;
+                        dMaxSortKey = psssSrchSearchSegment->dMaxSortKey;
+                        psssSrchSearchSegment->pssrSrchShortResults = NULL;
+                        psssSrchSearchSegment->uiSrchShortResultsLength = 0;
+                    }
+                }
+                else {
+                
+                    /* Do the search - note that we override the doc start index, setting it to 0, if this is a multi index search */
+                    iError = iSrchSearchGetShortResultsFromSearch(pssSrchSearch, psiSrchIndex, uiLanguageID, pwcSearchText, pwcPositiveFeedbackText,
+                            pwcNegativeFeedbackText, ((uiIndexCount > 1) ? 0 : uiStartIndex), uiEndIndex, uiSortFieldType, 
+                            uiSortType, &pssrSrchShortResults, &uiSrchShortResultsLength, &uiTotalResults, &dMaxSortKey);
+                }
+
+                /* Process the search results */
+                if ( iError == SRCH_NoError ) {
                     
                     /* Set the search results total */
                     uiTotalResultsLocal += uiTotalResults;
@@ -1961,12 +2301,21 @@ int iSpiSearchIndex
                     /* Process the search short results if there were any */
                     if ( uiSrchShortResultsLength > 0 ) {
 
+                        /* Collect the short results if we are searching the segments in their own threads, they get merged later */
+                        if ( psssSrchSearchSegments != NULL ) {
+                            ppssrSrchShortResultsList[uiSrchShortResultsListLength] = pssrSrchShortResults;
+                            puiSrchShortResultsLengthList[uiSrchShortResultsListLength] = uiSrchShortResultsLength;
+                            uiSrchShortResultsListLength++;
+                            uiSrchShortResultsListTotal += uiSrchShortResultsLength;
+                            pssrSrchShortResults = NULL;
+                        }
+
                         /* Check to see if we already have any short results we have already processed,
                         ** if we do we need to add the new search results to the end of the current
                         ** search results, otherwise we just pass over the pointers and save ourselves
                         ** an allocation and a memory copy
                         */
-                        if ( (pssrMainSrchShortResults != NULL) && (uiMainSrchShortResultsLength > 0) ) {
+                        else if ( (pssrMainSrchShortResults != NULL) && (uiMainSrchShortResultsLength > 0) ) {
                         
                             struct srchShortResult      *pssrMainSrchShortResultsPtr = NULL;
     
@@ -2002,14 +2351,14 @@ int iSpiSearchIndex
                 }
                 else {
 
-                    /* The error is set by the iSrchSearchGetShortResultsFromSearch() call above */
+                    /* The error is set by the iSrchSearchGetShortResultsFromSearch() call above, or by the search segment */
                     goto bailFromiSrchSearchIndex;
                 }
                 
                 /* We have an opportunity to stop the search early, if the early completion flag is set, 
                 ** and we have gathered enough data, and this is not the last index to search
                 */
-                if ( (bEarlyCompletion == true) && (uiMainSrchShortResultsLength > uiEndIndex) && 
+                if ( (bEarlyCompletion == true) && ((uiMainSrchShortResultsLength + uiSrchShortResultsListTotal) > uiEndIndex) && 
                         (((bReverseOrder == true) && (iIndexListIndex > 0)) || ((bReverseOrder != true) && (iIndexListIndex < (pssiSrchSearchIndex->uiSrchIndexListLength - 1)))) ) {
 
                     unsigned long   ulDocumentPartialCount = 0;
@@ -2082,6 +2431,78 @@ int iSpiSearchIndex
             }    /* while ( (iIndexListIndex >= 0) && (iIndexListIndex < pssiSrchSearchIndex->uiSrchIndexListLength) ) */
 
 
+            /* Merge the short results if we searched the segments in their own threads */
+            if ( psssSrchSearchSegments != NULL ) {
+
+                /* Free the search segments, this waits for the segment searches still running if we completed early */
+                iSrchSearchFreeSearchSegments(psssSrchSearchSegments, uiSrchSearchSegmentsLength);
+                psssSrchSearchSegments = NULL;
+                uiSrchSearchSegmentsLength = 0;
+
+                /* Merge the short results, the short results for each segment are already sorted, this frees the short results list entries */
+                if ( uiSrchShortResultsListLength > 0 ) {
+                    if ( (iError = iSrchShortResultMerge(ppssrSrchShortResultsList, puiSrchShortResultsLengthList, uiSrchShortResultsListLength, 
+                            uiEndIndex, uiSortType, &pssrSrchShortResults, &uiSrchShortResultsLength)) != SRCH_NoError ) {
+                        iUtlLogError(UTL_LOG_CONTEXT, "Failed to merge the short results: srch error: %d.", iError);
+                        goto bailFromiSrchSearchIndex;
+                    }
+                }
+                uiSrchShortResultsListLength = 0;
+                uiSrchShortResultsListTotal = 0;
+
+                /* Free the short results lists */
+                s_free(ppssrSrchShortResultsList);
+                s_free(puiSrchShortResultsLengthList);
+
+                /* Add the merged short results to the end of the current search results, or hand them over */
+                if ( (pssrSrchShortResults != NULL) && (uiSrchShortResultsLength > 0) ) {
+                    
+                    if ( (pssrMainSrchShortResults != NULL) && (uiMainSrchShortResultsLength > 0) ) {
+                        
+                        struct srchShortResult      *pssrMainSrchShortResultsPtr = NULL;
+    
+                        /* Make sure we have enough space in our stored short results array for the merged ones */
+                        if ( (pssrMainSrchShortResultsPtr = (struct srchShortResult *)s_realloc(pssrMainSrchShortResults, 
+                                (size_t)(sizeof(struct srchShortResult) * (uiMainSrchShortResultsLength + uiSrchShortResultsLength)))) == NULL ) {
+                            iError = SPI_MemError;
+                            goto bailFromiSrchSearchIndex;
+                        }
+    
+                        /* Hand over the pointer */
+                        pssrMainSrchShortResults = pssrMainSrchShortResultsPtr;
+    
+                        /* Move over the merged short results array to the stored one */
+                        s_memcpy(pssrMainSrchShortResults + uiMainSrchShortResultsLength, pssrSrchShortResults, uiSrchShortResultsLength * sizeof(struct srchShortResult));
+                        uiMainSrchShortResultsLength += uiSrchShortResultsLength;
+    
+                        /* Free the merged short results, leaving the pucSortKey alone */
+                        s_free(pssrSrchShortResults);
+                        
+                        /* The stored short results need to be sorted */
+                        bMainSrchShortResultsSorted = false;
+                    }
+                    else {
+                        /* Hand over the short results, they are sorted */
+                        pssrMainSrchShortResults = pssrSrchShortResults;
+                        uiMainSrchShortResultsLength = uiSrchShortResultsLength;
+                        pssrSrchShortResults = NULL;
+                        bMainSrchShortResultsSorted = true;
+                    }
+                }
+                
+                /* Free the merged short results if they were empty */
+                else if ( pssrSrchShortResults != NULL ) {
+                    s_free(pssrSrchShortResults);
+                }
+                uiSrchShortResultsLength = 0;
+            }
+            
+            /* The stored short results need to be sorted if we got any from a serial search */
+            else if ( uiMainSrchShortResultsLength > 0 ) {
+                bMainSrchShortResultsSorted = false;
+            }
+
+
             /* Set the search results total */
             uiTotalResultsMain += uiTotalResultsMainLocal;
 
@@ -2112,9 +2533,9 @@ int iSpiSearchIndex
         ** array if we got any results, if any document are going to be returned
         ** and if we searched more than one index
         */
-        if ( (uiMainSrchShortResultsLength > 0) && (uiStartIndex < uiMainSrchShortResultsLength) && (uiIndexCount > 1) ) {
+        if ( (uiMainSrchShortResultsLength > 0) && (uiStartIndex < uiMainSrchShortResultsLength) && (uiIndexCount > 1) && (bMainSrchShortResultsSorted == false) ) {
             
-            if ( (iError = iSrchShortResultSort(&pssrMainSrchShortResults, uiMainSrchShortResultsLength, uiSortType)) != SRCH_NoError ) {
+            if ( (iError = iSrchShortResultSort(&pssrMainSrchShortResults, uiMainSrchShortResultsLength, uiEndIndex, uiSortType)) != SRCH_NoError ) {
                 iUtlLogError(UTL_LOG_CONTEXT, "Failed to sort the short results: srch error: %d.", iError);
                 goto bailFromiSrchSearchIndex;
             }
@@ -2505,6 +2926,18 @@ int iSpiSearchIndex
         unsigned char               pucIndexNames[SPI_INDEX_NAME_MAXIMUM_LENGTH * 3] = {'\0'};
         struct spiSearchResponse    *pssrSpiSearchResponse = NULL;
 
+
+        /* Free the search segments, this waits for the segment searches still running if we bailed */
+        iSrchSearchFreeSearchSegments(psssSrchSearchSegments, uiSrchSearchSegmentsLength);
+        psssSrchSearchSegments = NULL;
+
+        /* Free the short results lists */
+        for ( uiI = 0; uiI < uiSrchShortResultsListLength; uiI++ ) {
+            iSrchShortResultFree(ppssrSrchShortResultsList[uiI], puiSrchShortResultsLengthList[uiI], uiSortType);
+        }
+        s_free(ppssrSrchShortResultsList);
+        s_free(puiSrchShortResultsLengthList);
+
         /* Create a nice, comma delimited, index name from the index name list for the log */
         for ( uiI = 0; ppvIndexList[uiI] != NULL; uiI++ ) {
             
@@ -4647,11 +5080,15 @@ static int iSrchSearchGetShortResultsFromSearch
     boolean                     bDocumentTable = false;
     struct srchBitmap           *psbSrchBitmapExclusion = NULL;
     struct srchBitmap           *psbSrchBitmapInclusion = NULL;
+    struct srchBitmap           *psbSrchBitmapDates = NULL;
     off_t                       zSearchReportStartOffset = 0;
     off_t                       zSearchReportEndOffset = 0;
     unsigned char               *pucSearchReportSnippet = NULL;
     unsigned int                uiSrchParserSearchCacheID = SRCH_PARSER_MODIFIER_UNKNOWN_ID;
     wchar_t                     *pwcSrchParserFullNormalizedSearchText = NULL;
+    unsigned int                uiTopDocumentsTotalResults = 0;
+    boolean                     bTopDocumentsTotalResultsEstimated = false;
+    boolean                     bSkipIndex = false;
 
 
     ASSERT(pssSrchSearch != NULL);
@@ -4696,6 +5133,28 @@ static int iSrchSearchGetShortResultsFromSearch
     }
 
 
+    /* Check the restrictions in the search against the index summary, there are no results to get if the index can be skipped */
+    if ( (iError = iSrchSearchCheckIndexSummary(pssSrchSearch, psiSrchIndex, &bSkipIndex)) != SRCH_NoError ) {
+        goto bailFromiSrchSearchGetShortResultsFromSearch;
+    }
+
+    /* Check the required terms in the search against the index term filter, feedback can 
+    ** add documents to the results so we only do this if there is no feedback
+    */
+    if ( (bSkipIndex == false) && (bUtlStringsIsWideStringNULL(pwcPositiveFeedbackText) == true) && 
+            (bUtlStringsIsWideStringNULL(pwcNegativeFeedbackText) == true) ) {
+        if ( (iError = iSrchSearchCheckIndexTermFilter(pssSrchSearch, psiSrchIndex, &bSkipIndex)) != SRCH_NoError ) {
+            goto bailFromiSrchSearchGetShortResultsFromSearch;
+        }
+    }
+
+    if ( bSkipIndex == true ) {
+        *puiTotalResults = 0;
+        *pdMaxSortKey = 0;
+        goto bailFromiSrchSearchGetShortResultsFromSearch;
+    }
+
+
     /* Get the parser search cache ID */
     if ( (iError = iSrchParserGetModifierID(pssSrchSearch->pvSrchParser, SRCH_PARSER_MODIFIER_SEARCH_CACHE_ID, &uiSrchParserSearchCacheID)) != SRCH_NoError ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser search cache ID, srch error: %d.", iError);
@@ -4754,8 +5213,9 @@ static int iSrchSearchGetShortResultsFromSearch
 
     /* Do the search */
     if ( (iError = iSrchSearchGetRawResultsFromSearch(pssSrchSearch, psiSrchIndex, uiLanguageID, pwcSearchText, 
-            pwcPositiveFeedbackText, pwcNegativeFeedbackText, uiSortFieldType, uiSortType, &psplSrchPostingsList, &pswSrchWeight, 
-            &bDocumentTable, &psbSrchBitmapExclusion, &psbSrchBitmapInclusion)) != SRCH_NoError ) {
+            pwcPositiveFeedbackText, pwcNegativeFeedbackText, uiEndIndex, uiSortFieldType, uiSortType, &psplSrchPostingsList, &pswSrchWeight, 
+            &bDocumentTable, &psbSrchBitmapExclusion, &psbSrchBitmapInclusion, &psbSrchBitmapDates, 
+            &uiTopDocumentsTotalResults, &bTopDocumentsTotalResultsEstimated)) != SRCH_NoError ) {
         goto bailFromiSrchSearchGetShortResultsFromSearch;
     }
 
@@ -4764,10 +5224,14 @@ static int iSrchSearchGetShortResultsFromSearch
     /* Do we have any results to merge? */
     if ( (psplSrchPostingsList != NULL) || (pswSrchWeight != NULL) || (bDocumentTable == true) ) {
 
-        /* We have now got all our results - merge them into a short results array */
+        /* We have now got all our results - merge them into a short results array, the short results
+        ** are saved in the cache and spliced differently by later searches, so they need a full sort
+        ** if the cache is enabled and can save them
+        */
         iError = iSrchSearchGetShortResultsFromRawResults(pssSrchSearch, psiSrchIndex, psplSrchPostingsList, pswSrchWeight, bDocumentTable,
-                psbSrchBitmapExclusion, psbSrchBitmapInclusion, uiSortFieldType, uiSortType, &pssrSrchShortResults, &uiSrchShortResultsLength, 
-                puiTotalResults, pdMaxSortKey);
+                psbSrchBitmapExclusion, psbSrchBitmapInclusion, psbSrchBitmapDates, 
+                ((uiSrchParserSearchCacheID == SRCH_PARSER_MODIFIER_SEARCH_CACHE_ENABLE_ID) && (bSrchCacheSaveEnabled(pssSrchSearch->pvSrchCache) == true)) ? 0 : uiEndIndex, 
+                uiSortFieldType, uiSortType, &pssrSrchShortResults, &uiSrchShortResultsLength, puiTotalResults, pdMaxSortKey);
 
         /* Free the search postings list */
         iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
@@ -4785,10 +5249,30 @@ static int iSrchSearchGetShortResultsFromSearch
         iSrchBitmapFree(psbSrchBitmapInclusion);
         psbSrchBitmapInclusion = NULL;
 
+        /* Free the dates bitmap */
+        iSrchBitmapFree(psbSrchBitmapDates);
+        psbSrchBitmapDates = NULL;
+
         /* Did we hit an error on merging */
         if ( iError != SRCH_NoError ) {
             goto bailFromiSrchSearchGetShortResultsFromSearch;
         }
+
+
+        /* Only the top documents were kept, so the total results come from the top documents search */
+        if ( uiTopDocumentsTotalResults > *puiTotalResults ) {
+
+            /* Send a bogus retrieval count to the search report so that the numbers tally */
+            iSrchReportAppend(pssSrchSearch->pvSrchReport, "%s %u 0 0 0 0 0 0\n", REP_RETRIEVAL_COUNTS, uiTopDocumentsTotalResults - *puiTotalResults); 
+
+            /* Tell the user that the total was estimated, if it was */
+            if ( bTopDocumentsTotalResultsEstimated == true ) {
+                iSrchReportAppend(pssSrchSearch->pvSrchReport, "%s The search only evaluated the top: %u documents, the total number of documents was estimated\n",
+                        REP_SEARCH_WARNING, *puiTotalResults);
+            }
+
+            *puiTotalResults = uiTopDocumentsTotalResults;
+        }
     }
 
 
@@ -4862,100 +5346,406 @@ static int iSrchSearchGetShortResultsFromSearch
 
 /*
 
-    Function:   iSrchSearchGetRawResultsFromSearch()
+    Function:   iSrchSearchCheckIndexSummary()
 
-    Purpose:    This function searches for the passed search and
-                returns the results as a search postings list structure,
-                a weight array and an exclusion bitmap
+    Purpose:    This function checks the date and language restrictions in the
+                search against the summary of the documents in the index, and 
+                tells us whether the index can be skipped because none of its 
+                documents could match the restrictions.
 
-                If no documents were returned from the search
-                then the weights array return pointer will be NULL.
+                An index which does not have a summary is never skipped.
 
-    Parameters: pssSrchSearch               search structure
-                psiSrchIndex                search index structure
-                uiLanguageID                language ID
-                pwcSearchText               search text (optional)
-                pwcPositiveFeedbackText     positive feedback text (optional)
-                pwcNegativeFeedbackText     negative feedback text (optional)
-                uiSortFieldType             sort field ID
-                uiSortType                  sort type
-                ppsplSrchPostingsList       return pointer for the search postings list structure
-                ppswSrchWeight              return pointer for the search weight structure
-                pbDocumentTable             return pointer for the document table flag
-                ppsbSrchBitmapExclusion     return pointer for the exclusion search bitmap structure
-                ppsbSrchBitmapInclusion     return pointer for the inclusion search bitmap structure
+    Parameters: pssSrchSearch       search structure
+                psiSrchIndex        index structure
+                pbSkipIndex         return pointer for the skip index flag
 
     Globals:    none
 
-    Returns:    SRCH error
+    Returns:    SRCH error code
 
 */
-static int iSrchSearchGetRawResultsFromSearch
+static int iSrchSearchCheckIndexSummary
 (
     struct srchSearch *pssSrchSearch,
-    struct srchIndex* psiSrchIndex,
-    unsigned int uiLanguageID, 
-    wchar_t *pwcSearchText,
-    wchar_t *pwcPositiveFeedbackText,
-    wchar_t *pwcNegativeFeedbackText,
-    unsigned int uiSortFieldType, 
-    unsigned int uiSortType,
-    struct srchPostingsList **ppsplSrchPostingsList,
-    struct srchWeight **ppswSrchWeight,
-    boolean *pbDocumentTable,
-    struct srchBitmap **ppsbSrchBitmapExclusion,
-    struct srchBitmap **ppsbSrchBitmapInclusion
+    struct srchIndex *psiSrchIndex,
+    boolean *pbSkipIndex
 )
 {
 
-    int                             iError = SRCH_NoError;
-    unsigned int                    uiSrchParserDebugID = SRCH_PARSER_MODIFIER_UNKNOWN_ID;
-    struct srchParserTermCluster    *psptcSrchParserTermCluster = NULL;
-    wchar_t                         *pwcSrchParserNormalizedSearchText = NULL;
-    struct srchParserNumber         *pspnSrchParserNumberDates = NULL;
-    struct srchParserNumber         *pspnSrchParserNumberDatesPtr = NULL;
-    unsigned int                    uiSrchParserNumberDatesLength = 0;
-    struct srchParserFilter         *pspfSrchParserFilterExclusionFilters = NULL;
-    unsigned int                    uiSrchParserFilterExclusionFiltersLength = 0;
-    struct srchParserFilter         *pspfSrchParserFilterInclusionFilters = NULL;
-    unsigned int                    uiSrchParserFilterInclusionFiltersLength = 0;
-    struct srchParserNumber         *pspnSrchParserNumberLanguageIDs = NULL;
-    unsigned int                    uiSrchParserNumberLanguageIDsLength = 0;
-    struct srchPostingsList         *psplSrchPostingsList = NULL;
-    struct srchWeight               *pswSrchWeight = NULL;
-    unsigned int                    uiI = 0;
-    unsigned char                   pucNumberString[UTL_FILE_PATH_MAX + 1] = {'\0'};
-    
-    unsigned int                    uiStartDocumentID = 0;
-    unsigned int                    uiEndDocumentID = 0;
+    int                         iError = SRCH_NoError;
+    struct srchParserNumber     *pspnSrchParserNumberDates = NULL;
+    struct srchParserNumber     *pspnSrchParserNumberDatesPtr = NULL;
+    unsigned int                uiSrchParserNumberDatesLength = 0;
+    struct srchParserNumber     *pspnSrchParserNumberLanguageIDs = NULL;
+    struct srchParserNumber     *pspnSrchParserNumberLanguageIDsPtr = NULL;
+    unsigned int                uiSrchParserNumberLanguageIDsLength = 0;
+    boolean                     bSkipIndex = false;
+    unsigned int                uiI = 0;
+    unsigned int                uiJ = 0;
 
 
     ASSERT(pssSrchSearch != NULL);
     ASSERT(psiSrchIndex != NULL);
-    ASSERT(uiLanguageID >= 0);
-    ASSERT((bUtlStringsIsWideStringNULL(pwcSearchText) == false) || (bUtlStringsIsWideStringNULL(pwcSearchText) == true));
-    ASSERT((bUtlStringsIsWideStringNULL(pwcPositiveFeedbackText) == false) || (bUtlStringsIsWideStringNULL(pwcPositiveFeedbackText) == true));
-    ASSERT((bUtlStringsIsWideStringNULL(pwcNegativeFeedbackText) == false) || (bUtlStringsIsWideStringNULL(pwcNegativeFeedbackText) == true));
-    ASSERT(SRCH_SEARCH_SORT_FIELD_TYPE_VALID(uiSortFieldType) == true);
-    ASSERT(SPI_SORT_TYPE_VALID(uiSortType) == true);
-    ASSERT(ppsplSrchPostingsList != NULL);
-    ASSERT(ppswSrchWeight != NULL);
-    ASSERT(pbDocumentTable != NULL);
-    ASSERT(ppsbSrchBitmapExclusion != NULL);
-    ASSERT(ppsbSrchBitmapInclusion != NULL);
-
-
+    ASSERT(pbSkipIndex != NULL);
 
-    /* Get the parser term cluster */
-    if ( (iError = iSrchParserGetTermCluster(pssSrchSearch->pvSrchParser, &psptcSrchParserTermCluster)) != SRCH_NoError ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser term cluster, srch error: %d.", iError);
-        goto bailFromiSrchSearchGetRawResultsFromSearch;
-    }
 
-    /* Get the parser date restriction */
+    /* Get the parser date/time restriction */
     if ( (iError = iSrchParserGetDates(pssSrchSearch->pvSrchParser, &pspnSrchParserNumberDates, &uiSrchParserNumberDatesLength)) != SRCH_NoError ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser date restriction, srch error: %d.", iError);
-        goto bailFromiSrchSearchGetRawResultsFromSearch;
+        return (iError);
+    }
+
+    /* Skip the index if any of the date restrictions falls outside the document dates in the index */
+    for ( uiI = 0, pspnSrchParserNumberDatesPtr = pspnSrchParserNumberDates; 
+            (pspnSrchParserNumberDates != NULL) && (uiI < uiSrchParserNumberDatesLength) && (bSkipIndex == false); uiI++, pspnSrchParserNumberDatesPtr++ ) {
+
+        switch ( pspnSrchParserNumberDatesPtr->uiRangeID ) {
+        
+            case SRCH_PARSER_RANGE_EQUAL_ID:
+                bSkipIndex = ((pspnSrchParserNumberDatesPtr->ulNumber < psiSrchIndex->ulDocumentAnsiDateMinimum) || 
+                        (pspnSrchParserNumberDatesPtr->ulNumber > psiSrchIndex->ulDocumentAnsiDateMaximum)) ? true : false;
+                break;
+        
+            case SRCH_PARSER_RANGE_NOT_EQUAL_ID:
+                bSkipIndex = ((pspnSrchParserNumberDatesPtr->ulNumber == psiSrchIndex->ulDocumentAnsiDateMinimum) && 
+                        (pspnSrchParserNumberDatesPtr->ulNumber == psiSrchIndex->ulDocumentAnsiDateMaximum)) ? true : false;
+                break;
+
+            case SRCH_PARSER_RANGE_GREATER_ID:
+                bSkipIndex = (psiSrchIndex->ulDocumentAnsiDateMaximum <= pspnSrchParserNumberDatesPtr->ulNumber) ? true : false;
+                break;
+
+            case SRCH_PARSER_RANGE_LESS_ID:
+                bSkipIndex = (psiSrchIndex->ulDocumentAnsiDateMinimum >= pspnSrchParserNumberDatesPtr->ulNumber) ? true : false;
+                break;
+        
+            case SRCH_PARSER_RANGE_GREATER_OR_EQUAL_ID:
+                bSkipIndex = (psiSrchIndex->ulDocumentAnsiDateMaximum < pspnSrchParserNumberDatesPtr->ulNumber) ? true : false;
+                break;
+        
+            case SRCH_PARSER_RANGE_LESS_OR_EQUAL_ID:
+                bSkipIndex = (psiSrchIndex->ulDocumentAnsiDateMinimum > pspnSrchParserNumberDatesPtr->ulNumber) ? true : false;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+
+    /* Check the language restriction if we have not decided to skip the index yet and if the index knows its document languages */
+    if ( (bSkipIndex == false) && (psiSrchIndex->uiDocumentLanguageIDsLength > 0) ) {
+
+        /* Get the parser language ID restriction */
+        if ( (iError = iSrchParserGetLanguage(pssSrchSearch->pvSrchParser, &pspnSrchParserNumberLanguageIDs, &uiSrchParserNumberLanguageIDsLength)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser language ID restriction, srch error: %d.", iError);
+            return (iError);
+        }
+
+        /* Skip the index if none of the document languages in the index match any of the languages in the restriction */
+        if ( pspnSrchParserNumberLanguageIDs != NULL ) {
+
+            for ( uiI = 0, bSkipIndex = true, pspnSrchParserNumberLanguageIDsPtr = pspnSrchParserNumberLanguageIDs; 
+                    (uiI < uiSrchParserNumberLanguageIDsLength) && (bSkipIndex == true); uiI++, pspnSrchParserNumberLanguageIDsPtr++ ) {
+                
+                boolean     bCanonical = false;
+                
+                /* Check whether the language is canonical or not, keep the index if we can't tell */
+                if ( iLngIsLanguageIDCanonical(pspnSrchParserNumberLanguageIDsPtr->ulNumber, &bCanonical) != LNG_NoError ) {
+                    bSkipIndex = false;
+                    break;
+                }
+
+                for ( uiJ = 0; uiJ < psiSrchIndex->uiDocumentLanguageIDsLength; uiJ++ ) {
+                
+                    unsigned int    uiDocumentLanguageID = psiSrchIndex->puiDocumentLanguageIDs[uiJ];
+                
+                    /* Canonicalize the document language ID if the parser language ID is canonical, keep the index if we can't */
+                    if ( (bCanonical == true) && (iLngGetCanonicalLanguageID(uiDocumentLanguageID, &uiDocumentLanguageID) != LNG_NoError) ) {
+                        bSkipIndex = false;
+                        break;
+                    }
+
+                    /* Keep the index if the languages match */
+                    if ( pspnSrchParserNumberLanguageIDsPtr->ulNumber == uiDocumentLanguageID ) {
+                        bSkipIndex = false;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+
+    /* Set the return pointer */
+    *pbSkipIndex = bSkipIndex;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchCheckIndexTermFilter()
+
+    Purpose:    This function checks the terms in the search which are required
+                for a document to match against the term filter of the index, and
+                tells us whether the index can be skipped because one of these 
+                terms is definitely not in the index.
+
+                Only the terms directly in the top level term cluster are checked,
+                and only those which are looked up as they are, so terms which are
+                expanded or which may get stemmed are not checked.
+
+                An index which does not have a term filter is never skipped.
+
+    Parameters: pssSrchSearch       search structure
+                psiSrchIndex        index structure
+                pbSkipIndex         return pointer for the skip index flag
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchCheckIndexTermFilter
+(
+    struct srchSearch *pssSrchSearch,
+    struct srchIndex *psiSrchIndex,
+    boolean *pbSkipIndex
+)
+{
+
+    int                             iError = SRCH_NoError;
+    struct srchParserTermCluster    *psptcSrchParserTermCluster = NULL;
+    unsigned int                    uiSrchParserBooleanOperationID = SRCH_PARSER_INVALID_ID;
+    boolean                         bRequiredOperator = false;
+    boolean                         bSkipIndex = false;
+    unsigned int                    uiI = 0;
+
+
+    ASSERT(pssSrchSearch != NULL);
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(pbSkipIndex != NULL);
+
+
+    /* Set the return pointer */
+    *pbSkipIndex = false;
+
+
+    /* Nothing to check if the index does not have a term filter */
+    if ( psiSrchIndex->pstdfSrchTermDictFilter == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Get the parser term cluster */
+    if ( (iError = iSrchParserGetTermCluster(pssSrchSearch->pvSrchParser, &psptcSrchParserTermCluster)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser term cluster, srch error: %d.", iError);
+        return (iError);
+    }
+
+    /* Nothing to check if there is no term cluster */
+    if ( (psptcSrchParserTermCluster == NULL) || (psptcSrchParserTermCluster->uiTermsLength == 0) ) {
+        return (SRCH_NoError);
+    }
+
+    /* Get the parser boolean operation */
+    if ( (iError = iSrchParserGetModifierID(pssSrchSearch->pvSrchParser, SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_ID, &uiSrchParserBooleanOperationID)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser boolean operation ID, srch error: %d.", iError);
+        return (iError);
+    }
+
+
+    /* All the terms are required if there is only one term, or if we are using strict boolean and 
+    ** the operator boils down to an intersection, otherwise only the terms flagged as required are
+    */
+    bRequiredOperator = ((psptcSrchParserTermCluster->uiOperatorID != SRCH_PARSER_OPERATOR_NOT_ID) && (psptcSrchParserTermCluster->uiTermsLength == 1)) || 
+            ((uiSrchParserBooleanOperationID == SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_STRICT_ID) &&
+            ((psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID) || 
+            (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID))) ? true : false;
+
+
+    /* Loop over the terms until we find a required term which is definitely not in the index */
+    for ( uiI = 0; (uiI < psptcSrchParserTermCluster->uiTermsLength) && (bSkipIndex == false); uiI++ ) {
+
+        struct srchParserTerm   *psptSrchParserTerm = NULL;
+        unsigned char           *pucTerm = NULL;
+        boolean                 bTermMayExist = true;
+
+        /* Skip term clusters */
+        if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiI] != SRCH_PARSER_TERM_TYPE_TERM_ID ) {
+            continue;
+        }
+
+        psptSrchParserTerm = (struct srchParserTerm *)psptcSrchParserTermCluster->ppvTerms[uiI];
+
+        /* Skip terms which are not required, for relaxed boolean the required flag has to be set and only
+        ** holds for operators which boil down to an intersection
+        */
+        if ( (bRequiredOperator == false) && 
+                ((psptSrchParserTerm->bRequired == false) || 
+                ((psptcSrchParserTermCluster->uiOperatorID != SRCH_PARSER_OPERATOR_AND_ID) && (psptcSrchParserTermCluster->uiOperatorID != SRCH_PARSER_OPERATOR_ADJ_ID) && 
+                (psptcSrchParserTermCluster->uiOperatorID != SRCH_PARSER_OPERATOR_NEAR_ID))) ) {
+            continue;
+        }
+
+        /* Skip terms which get expanded */
+        if ( ((psptSrchParserTerm->uiFunctionID != SRCH_PARSER_INVALID_ID) && (psptSrchParserTerm->uiFunctionID != SRCH_PARSER_FUNCTION_LITERAL_ID)) ||
+                ((psptSrchParserTerm->uiRangeID != SRCH_PARSER_INVALID_ID) && (psptSrchParserTerm->uiRangeID != SRCH_PARSER_RANGE_EQUAL_ID)) ||
+                (psptSrchParserTerm->bWildCardSearch == true) ) {
+            continue;
+        }
+
+        /* Skip terms which may get stemmed, literals and upper case terms are never stemmed */
+        if ( (psptSrchParserTerm->uiFunctionID != SRCH_PARSER_FUNCTION_LITERAL_ID) && (psiSrchIndex->uiStemmerID != LNG_STEMMER_NONE_ID) && 
+                (bLngCaseIsWideStringAllUpperCase(psptSrchParserTerm->pwcTerm) == false) ) {
+            continue;
+        }
+
+        /* Convert the term from wide characters to utf-8, pucTerm is allocated, skip the term if we can't */
+        if ( iLngConvertWideStringToUtf8_d(psptSrchParserTerm->pwcTerm, 0, &pucTerm) != LNG_NoError ) {
+            continue;
+        }
+
+        /* Check the term against the term filter, skip the index if the term is definitely not in it */
+        if ( (iSrchTermDictCheckTermFilter(psiSrchIndex, pucTerm, &bTermMayExist) == SRCH_NoError) && (bTermMayExist == false) ) {
+            bSkipIndex = true;
+        }
+
+        /* Free the term */
+        s_free(pucTerm);
+    }
+
+
+    /* Set the return pointer */
+    *pbSkipIndex = bSkipIndex;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchGetRawResultsFromSearch()
+
+    Purpose:    This function searches for the passed search and
+                returns the results as a search postings list structure,
+                a weight array and an exclusion bitmap
+
+                If no documents were returned from the search
+                then the weights array return pointer will be NULL.
+
+    Parameters: pssSrchSearch               search structure
+                psiSrchIndex                search index structure
+                uiLanguageID                language ID
+                pwcSearchText               search text (optional)
+                pwcPositiveFeedbackText     positive feedback text (optional)
+                pwcNegativeFeedbackText     negative feedback text (optional)
+                uiEndIndex                  end index, 0 if there is no end index
+                uiSortFieldType             sort field ID
+                uiSortType                  sort type
+                ppsplSrchPostingsList       return pointer for the search postings list structure
+                ppswSrchWeight              return pointer for the search weight structure
+                pbDocumentTable             return pointer for the document table flag
+                ppsbSrchBitmapExclusion     return pointer for the exclusion search bitmap structure
+                ppsbSrchBitmapInclusion     return pointer for the inclusion search bitmap structure
+                ppsbSrchBitmapDates         return pointer for the dates search bitmap structure
+                puiTopDocumentsTotalResults return pointer for the total results if only the top 
+                                            documents were kept, 0 otherwise
+                pbTopDocumentsTotalResultsEstimated
+                                            return pointer for the top documents total results 
+                                            estimated flag
+
+    Globals:    none
+
+    Returns:    SRCH error
+
+*/
+static int iSrchSearchGetRawResultsFromSearch
+(
+    struct srchSearch *pssSrchSearch,
+    struct srchIndex* psiSrchIndex,
+    unsigned int uiLanguageID, 
+    wchar_t *pwcSearchText,
+    wchar_t *pwcPositiveFeedbackText,
+    wchar_t *pwcNegativeFeedbackText,
+    unsigned int uiEndIndex,
+    unsigned int uiSortFieldType, 
+    unsigned int uiSortType,
+    struct srchPostingsList **ppsplSrchPostingsList,
+    struct srchWeight **ppswSrchWeight,
+    boolean *pbDocumentTable,
+    struct srchBitmap **ppsbSrchBitmapExclusion,
+    struct srchBitmap **ppsbSrchBitmapInclusion,
+    struct srchBitmap **ppsbSrchBitmapDates,
+    unsigned int *puiTopDocumentsTotalResults,
+    boolean *pbTopDocumentsTotalResultsEstimated
+)
+{
+
+    int                             iError = SRCH_NoError;
+    unsigned int                    uiSrchParserDebugID = SRCH_PARSER_MODIFIER_UNKNOWN_ID;
+    struct srchParserTermCluster    *psptcSrchParserTermCluster = NULL;
+    wchar_t                         *pwcSrchParserNormalizedSearchText = NULL;
+    struct srchParserNumber         *pspnSrchParserNumberDates = NULL;
+    struct srchParserNumber         *pspnSrchParserNumberDatesPtr = NULL;
+    unsigned int                    uiSrchParserNumberDatesLength = 0;
+    struct srchParserFilter         *pspfSrchParserFilterExclusionFilters = NULL;
+    unsigned int                    uiSrchParserFilterExclusionFiltersLength = 0;
+    struct srchParserFilter         *pspfSrchParserFilterInclusionFilters = NULL;
+    unsigned int                    uiSrchParserFilterInclusionFiltersLength = 0;
+    struct srchParserNumber         *pspnSrchParserNumberLanguageIDs = NULL;
+    unsigned int                    uiSrchParserNumberLanguageIDsLength = 0;
+    struct srchPostingsList         *psplSrchPostingsList = NULL;
+    struct srchWeight               *pswSrchWeight = NULL;
+    struct srchSearchPlan           *psspSrchSearchPlan = NULL;
+    unsigned int                    uiI = 0;
+    unsigned char                   pucNumberString[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    
+    unsigned int                    uiStartDocumentID = 0;
+    unsigned int                    uiEndDocumentID = 0;
+
+
+    ASSERT(pssSrchSearch != NULL);
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(uiLanguageID >= 0);
+    ASSERT((bUtlStringsIsWideStringNULL(pwcSearchText) == false) || (bUtlStringsIsWideStringNULL(pwcSearchText) == true));
+    ASSERT((bUtlStringsIsWideStringNULL(pwcPositiveFeedbackText) == false) || (bUtlStringsIsWideStringNULL(pwcPositiveFeedbackText) == true));
+    ASSERT((bUtlStringsIsWideStringNULL(pwcNegativeFeedbackText) == false) || (bUtlStringsIsWideStringNULL(pwcNegativeFeedbackText) == true));
+    ASSERT(SRCH_SEARCH_SORT_FIELD_TYPE_VALID(uiSortFieldType) == true);
+    ASSERT(SPI_SORT_TYPE_VALID(uiSortType) == true);
+    ASSERT(ppsplSrchPostingsList != NULL);
+    ASSERT(ppswSrchWeight != NULL);
+    ASSERT(pbDocumentTable != NULL);
+    ASSERT(ppsbSrchBitmapExclusion != NULL);
+    ASSERT(ppsbSrchBitmapInclusion != NULL);
+    ASSERT(ppsbSrchBitmapDates != NULL);
+    ASSERT(puiTopDocumentsTotalResults != NULL);
+    ASSERT(pbTopDocumentsTotalResultsEstimated != NULL);
+
+
+
+    /* Get the parser term cluster */
+    if ( (iError = iSrchParserGetTermCluster(pssSrchSearch->pvSrchParser, &psptcSrchParserTermCluster)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser term cluster, srch error: %d.", iError);
+        goto bailFromiSrchSearchGetRawResultsFromSearch;
+    }
+
+    /* Get the parser date restriction */
+    if ( (iError = iSrchParserGetDates(pssSrchSearch->pvSrchParser, &pspnSrchParserNumberDates, &uiSrchParserNumberDatesLength)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser date restriction, srch error: %d.", iError);
+        goto bailFromiSrchSearchGetRawResultsFromSearch;
     }
 
     /* Get the parser exclusion filter */
@@ -5075,16 +5865,100 @@ static int iSrchSearchGetRawResultsFromSearch
     /* Process the parser term cluster */
     if ( psptcSrchParserTermCluster != NULL ) {
         
-        if ( (iError = iSrchSearchGetPostingsListFromParserTermCluster(pssSrchSearch, psiSrchIndex, uiLanguageID, 
-                psptcSrchParserTermCluster, &psplSrchPostingsList)) != SRCH_NoError ) {
-            iUtlLogError(UTL_LOG_CONTEXT, "Failed to run the search, srch error: %d.", iError);
+#if defined(SRCH_SEARCH_ENABLE_SEARCH_PLANS)
+        /* Plan the search before any postings are read */
+        if ( (iError = iSrchSearchCreatePlanFromParserTermCluster(pssSrchSearch, psiSrchIndex, psptcSrchParserTermCluster, &psspSrchSearchPlan)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to plan the search, srch error: %d.", iError);
             goto bailFromiSrchSearchGetRawResultsFromSearch;
         }
 
-        // Set the start and end document ID if there is a posting list */
-        if ( (psplSrchPostingsList != NULL) && (psplSrchPostingsList->pspSrchPostings != NULL) && (psplSrchPostingsList->uiSrchPostingsLength > 0) ) {
-            uiStartDocumentID = psplSrchPostingsList->pspSrchPostings->uiDocumentID;
-            uiEndDocumentID = (psplSrchPostingsList->pspSrchPostings + (psplSrchPostingsList->uiSrchPostingsLength - 1))->uiDocumentID;
+        /* Search report - list the search plan */
+        if ( uiSrchParserDebugID == SRCH_PARSER_MODIFIER_DEBUG_ENABLE_ID ) {
+            iSrchSearchReportPlan(pssSrchSearch, psptcSrchParserTermCluster, psspSrchSearchPlan, 1);
+        }
+#endif    /* defined(SRCH_SEARCH_ENABLE_SEARCH_PLANS) */
+
+#if defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS)
+        {
+            struct srchCursor   *pscSrchCursor = NULL;
+            boolean             bTopDocuments = false;
+
+#if defined(SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND)
+            /* We only need the top documents if this is a relevance ranked search of ORed terms with nothing 
+            ** else which could change the weights or drop documents, and the results are not going to be saved 
+            ** in the cache, which is the case if the cache is disabled for this search or if there is no cache
+            */
+            if ( (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_OR_ID) && (psptcSrchParserTermCluster->uiTermsLength > 1) &&
+                    (bUtlStringsIsWideStringNULL(pwcPositiveFeedbackText) == true) && (bUtlStringsIsWideStringNULL(pwcNegativeFeedbackText) == true) &&
+                    (pspnSrchParserNumberDates == NULL) && 
+                    (pspfSrchParserFilterExclusionFilters == NULL) && (pspfSrchParserFilterInclusionFilters == NULL) &&
+                    (pspnSrchParserNumberLanguageIDs == NULL) && (uiEndIndex > 0) && 
+                    (uiSortFieldType == SRCH_SEARCH_SORT_FIELD_TYPE_RELEVANCE) && (uiSortType == SPI_SORT_TYPE_FLOAT_DESC) ) {
+
+                unsigned int    uiSrchParserSearchCacheID = SRCH_PARSER_MODIFIER_UNKNOWN_ID;
+
+                /* Get the parser search cache ID */
+                if ( (iError = iSrchParserGetModifierID(pssSrchSearch->pvSrchParser, SRCH_PARSER_MODIFIER_SEARCH_CACHE_ID, &uiSrchParserSearchCacheID)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser search cache ID, srch error: %d.", iError);
+                    goto bailFromiSrchSearchGetRawResultsFromSearch;
+                }
+
+                bTopDocuments = ((uiSrchParserSearchCacheID == SRCH_PARSER_MODIFIER_SEARCH_CACHE_ENABLE_ID) && 
+                        (bSrchCacheSaveEnabled(pssSrchSearch->pvSrchCache) == true)) ? false : true;
+
+                /* The cluster can only contain terms, none of which are required */
+                for ( uiI = 0; (bTopDocuments == true) && (uiI < psptcSrchParserTermCluster->uiTermsLength); uiI++ ) {
+                    if ( (psptcSrchParserTermCluster->puiTermTypeIDs[uiI] != SRCH_PARSER_TERM_TYPE_TERM_ID) || 
+                            (((struct srchParserTerm *)psptcSrchParserTermCluster->ppvTerms[uiI])->bRequired == true) ) {
+                        bTopDocuments = false;
+                    }
+                }
+            }
+
+            /* Get the search postings list for the top documents, note that the end index is inclusive */
+            if ( bTopDocuments == true ) {
+                if ( (iError = iSrchSearchGetTopPostingsListFromParserTermCluster(pssSrchSearch, psiSrchIndex, uiLanguageID, 
+                        psptcSrchParserTermCluster, uiEndIndex + 1, &psplSrchPostingsList, 
+                        puiTopDocumentsTotalResults, pbTopDocumentsTotalResultsEstimated)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to run the search, srch error: %d.", iError);
+                    goto bailFromiSrchSearchGetRawResultsFromSearch;
+                }
+            }
+#endif    /* defined(SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND) */
+
+            /* Get the search cursor for the parser term cluster */
+            if ( (bTopDocuments == false) && (iError = iSrchSearchGetCursorFromParserTermCluster(pssSrchSearch, psiSrchIndex, uiLanguageID, 
+                    psptcSrchParserTermCluster, psspSrchSearchPlan, SRCH_SEARCH_TERM_POSITIONS_DEFAULT, &pscSrchCursor)) != SRCH_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to run the search, srch error: %d.", iError);
+                goto bailFromiSrchSearchGetRawResultsFromSearch;
+            }
+
+            /* Drain the search cursor into a search postings list */
+            if ( pscSrchCursor != NULL ) {
+
+                iError = iSrchCursorGetSrchPostingsList(pscSrchCursor, &psplSrchPostingsList);
+
+                iSrchCursorFree(pscSrchCursor);
+                pscSrchCursor = NULL;
+
+                if ( iError != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to run the search, srch error: %d.", iError);
+                    goto bailFromiSrchSearchGetRawResultsFromSearch;
+                }
+            }
+        }
+#else
+        if ( (iError = iSrchSearchGetPostingsListFromParserTermCluster(pssSrchSearch, psiSrchIndex, uiLanguageID, 
+                psptcSrchParserTermCluster, psspSrchSearchPlan, SRCH_SEARCH_TERM_POSITIONS_DEFAULT, &psplSrchPostingsList)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to run the search, srch error: %d.", iError);
+            goto bailFromiSrchSearchGetRawResultsFromSearch;
+        }
+#endif    /* defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS) */
+
+        // Set the start and end document ID if there is a posting list */
+        if ( (psplSrchPostingsList != NULL) && (psplSrchPostingsList->pspSrchPostings != NULL) && (psplSrchPostingsList->uiSrchPostingsLength > 0) ) {
+            uiStartDocumentID = psplSrchPostingsList->pspSrchPostings->uiDocumentID;
+            uiEndDocumentID = (psplSrchPostingsList->pspSrchPostings + (psplSrchPostingsList->uiSrchPostingsLength - 1))->uiDocumentID;
         }
     }
 
@@ -5125,6 +5999,17 @@ static int iSrchSearchGetRawResultsFromSearch
     }
 
 
+    /* Process the date restriction, this only returns a bitmap if the index has a date index */
+    if ( pspnSrchParserNumberDates != NULL ) {
+
+        if ( (iError = iSrchSearchGetSearchBitmapFromDates(psiSrchIndex, pspnSrchParserNumberDates, uiSrchParserNumberDatesLength, 
+                ppsbSrchBitmapDates)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to run the date restriction, srch error: %d.", iError);
+            goto bailFromiSrchSearchGetRawResultsFromSearch;
+        }
+    }
+
+
     /* Flag the document table if there was no term cluster or search weights, but there are restrictions */
     if ( (psptcSrchParserTermCluster == NULL) && (pswSrchWeight == NULL) && 
             ((pspnSrchParserNumberDates != NULL) || 
@@ -5140,6 +6025,13 @@ static int iSrchSearchGetRawResultsFromSearch
     bailFromiSrchSearchGetRawResultsFromSearch:
 
 
+#if defined(SRCH_SEARCH_ENABLE_SEARCH_PLANS)
+    /* Free the search plan */
+    iSrchSearchFreePlan(psspSrchSearchPlan);
+    psspSrchSearchPlan = NULL;
+#endif    /* defined(SRCH_SEARCH_ENABLE_SEARCH_PLANS) */
+
+
     /* Handle the error */
     if ( iError == SRCH_NoError ) {
 
@@ -5172,7 +6064,8 @@ static int iSrchSearchGetRawResultsFromSearch
     Function:   iSrchSearchGetShortResultsFromRawResults()
 
     Purpose:    This functions merges a search postings list and a weights array
-                into a search short results array. The array is sorted.
+                into a search short results array. The array is sorted, only up to
+                the end index if one is passed.
 
     Parameters: pssSrchSearch               search structure
                 psiSrchIndex                index structure
@@ -5181,6 +6074,8 @@ static int iSrchSearchGetRawResultsFromSearch
                 bDocumentTable              document table flag
                 psbSrchBitmapExclusion      exclusion search bitmap structure
                 psbSrchBitmapInclusion      inclusion search bitmap structure
+                psbSrchBitmapDates          dates search bitmap structure
+                uiEndIndex                  end index, 0 if there is no end index
                 uiSortFieldType             sort field ID
                 uiSortType                  sort type
                 ppssrSrchShortResults       return pointer for an array of search short results
@@ -5202,6 +6097,8 @@ static int iSrchSearchGetShortResultsFromRawResults
     boolean bDocumentTable,
     struct srchBitmap *psbSrchBitmapExclusion,
     struct srchBitmap *psbSrchBitmapInclusion,
+    struct srchBitmap *psbSrchBitmapDates,
+    unsigned int uiEndIndex,
     unsigned int uiSortFieldType, 
     unsigned int uiSortType,
     struct srchShortResult **ppssrSrchShortResults,
@@ -5219,6 +6116,8 @@ static int iSrchSearchGetShortResultsFromRawResults
     struct srchShortResult      *pssrSrchShortResultsPtr = NULL;
     float                       *pfWeightsPtr = NULL;
     float                       *pfWeightsEnd = NULL;
+    unsigned int                uiWeightsIndex = 0;
+    float                       fDocumentWeight = 0;
     unsigned int                uiSrchShortResultsLength = 0;
     unsigned int                uiFailedDateMatchCount = 0;
     unsigned int                uiFailedLanguageMatchCount = 0;
@@ -5241,6 +6140,8 @@ static int iSrchSearchGetShortResultsFromRawResults
     
     unsigned int                uiItemID = 0;
 
+    boolean                     bImpacts = false;
+
 #if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_AVERAGE)
     float                       fAverageDocumentTermCount = 0;
 #endif /* defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_AVERAGE) */
@@ -5253,6 +6154,7 @@ static int iSrchSearchGetShortResultsFromRawResults
     ASSERT((bDocumentTable == true) || (bDocumentTable == false));
     ASSERT((psbSrchBitmapExclusion != NULL) || (psbSrchBitmapExclusion == NULL));
     ASSERT((psbSrchBitmapInclusion != NULL) || (psbSrchBitmapInclusion == NULL));
+    ASSERT((psbSrchBitmapDates != NULL) || (psbSrchBitmapDates == NULL));
     ASSERT(SRCH_SEARCH_SORT_FIELD_TYPE_VALID(uiSortFieldType) == true);
     ASSERT(SPI_SORT_TYPE_VALID(uiSortType) == true);
     ASSERT(ppssrSrchShortResults != NULL);
@@ -5293,14 +6195,10 @@ static int iSrchSearchGetShortResultsFromRawResults
     /* Got weights */
     else if ( pswSrchWeight != NULL ) {
 
-        /* Count up the number of actual results in the weights array, documentID 0 does not exist, hence the '+ 1' */
-        for ( pfWeightsPtr = pswSrchWeight->pfWeights + 1, pfWeightsEnd = pswSrchWeight->pfWeights + pswSrchWeight->uiWeightsLength, uiSrchShortResultsLength = 0; 
-                pfWeightsPtr < pfWeightsEnd; pfWeightsPtr++ ) {
-
-            /* Increment the number of documents we hit upon */
-            if ( *pfWeightsPtr > 0 ) {
-                uiSrchShortResultsLength += 1;
-            }
+        /* Count up the number of actual results in the weights array */
+        if ( (iError = iSrchWeightGetDocumentCount(pswSrchWeight, &uiSrchShortResultsLength)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the document count from the search weight, srch error: %d.", iError);
+            goto bailFromiSrchSearchGetShortResultsFromRawResults;
         }
     }
     /* Got document table */
@@ -5318,6 +6216,10 @@ static int iSrchSearchGetShortResultsFromRawResults
     }
 
 
+    /* The weights are already normalized if the index blocks carry impacts */
+    bImpacts = (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_IMPACTS) ? true : false;
+
+
     /* Allocate the array of short results based on the initial estimated number of short results */
     if ( (pssrSrchShortResults = (struct srchShortResult *)s_malloc((size_t)(sizeof(struct srchShortResult) * uiSrchShortResultsLength))) == NULL ) {
         iError = SRCH_MemError;
@@ -5332,6 +6234,12 @@ static int iSrchSearchGetShortResultsFromRawResults
         goto bailFromiSrchSearchGetShortResultsFromRawResults;
     }
 
+    /* The dates bitmap covers the date restriction, so there is no need to check the date of each document */
+    if ( psbSrchBitmapDates != NULL ) {
+        pspnSrchParserNumberDates = NULL;
+        uiSrchParserNumberDatesLength = 0;
+    }
+
     /* Get the parser language ID restriction */
     if ( (iError = iSrchParserGetLanguage(pssSrchSearch->pvSrchParser, &pspnSrchParserNumberLanguageIDs, &uiSrchParserNumberLanguageIDsLength)) != SRCH_NoError ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser language ID restriction, srch error: %d.", iError);
@@ -5472,10 +6380,6 @@ static int iSrchSearchGetShortResultsFromRawResults
                                             (uiSortFieldType == SRCH_SEARCH_SORT_FIELD_TYPE_ITEM_DOUBLE) || 
                                             (uiSortFieldType == SRCH_SEARCH_SORT_FIELD_TYPE_ITEM_UCHAR)) ? &uiSrchDocumentItemsLength : NULL;
 
-        /* Dereference the exclusion and inclusion bitmap array */
-        unsigned char               *pucExclusionBitmapPtr = (psbSrchBitmapExclusion != NULL) ? psbSrchBitmapExclusion->pucBitmap : NULL;
-        unsigned char               *pucInclusionBitmapPtr = (psbSrchBitmapInclusion != NULL) ? psbSrchBitmapInclusion->pucBitmap : NULL;
-
 
         /* Initialize our variables */
         pssrSrchShortResultsPtr = pssrSrchShortResults;
@@ -5487,10 +6391,10 @@ static int iSrchSearchGetShortResultsFromRawResults
         while ( pspSrchPostingsPtr < pspSrchPostingsEnd ) {
 
             /* Skip this entry if there is an exclusion bitmap array and this document is in there */
-            if ( pucExclusionBitmapPtr != NULL ) {
+            if ( psbSrchBitmapExclusion != NULL ) {
 
                 /* Skip this document if the bit is set */
-                if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucExclusionBitmapPtr, pspSrchPostingsPtr->uiDocumentID) ) {
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapExclusion, pspSrchPostingsPtr->uiDocumentID) == true ) {
 
                     unsigned int uiExcludedDocumentID = pspSrchPostingsPtr->uiDocumentID;
 
@@ -5506,10 +6410,10 @@ static int iSrchSearchGetShortResultsFromRawResults
 
 
             /* Skip this entry if there is an inclusion bitmap array and this document is *not* in there */
-            if ( pucInclusionBitmapPtr != NULL ) {
+            if ( psbSrchBitmapInclusion != NULL ) {
 
                 /* Skip this document if the bit is *not* set */
-                if ( !UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucInclusionBitmapPtr, pspSrchPostingsPtr->uiDocumentID) ) {
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapInclusion, pspSrchPostingsPtr->uiDocumentID) == false ) {
 
                     unsigned int uiIncludedDocumentID = pspSrchPostingsPtr->uiDocumentID;
 
@@ -5525,6 +6429,25 @@ static int iSrchSearchGetShortResultsFromRawResults
             }
 
 
+            /* Skip this entry if there is a dates bitmap array and this document is *not* in there */
+            if ( psbSrchBitmapDates != NULL ) {
+
+                /* Skip this document if the bit is *not* set */
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapDates, pspSrchPostingsPtr->uiDocumentID) == false ) {
+
+                    unsigned int uiFailedDateDocumentID = pspSrchPostingsPtr->uiDocumentID;
+
+                    /* Loop while the document ID is the same and there are postings left */
+                    while ( (pspSrchPostingsPtr < pspSrchPostingsEnd) && (pspSrchPostingsPtr->uiDocumentID == uiFailedDateDocumentID) ) {
+                        pspSrchPostingsPtr++;
+                    }
+                
+                    uiFailedDateMatchCount++;
+                    continue;
+                }
+            }
+
+
             /* Create a new short result */
             pssrSrchShortResultsPtr->uiDocumentID = pspSrchPostingsPtr->uiDocumentID;
             pssrSrchShortResultsPtr->psiSrchIndexPtr = psiSrchIndex;
@@ -5544,11 +6467,34 @@ static int iSrchSearchGetShortResultsFromRawResults
             }
 
 
-            /* Increment the weight if we have a weight array and the weight is set for this document */
-            if ( (pswSrchWeight != NULL) && (pswSrchWeight->pfWeights[pssrSrchShortResultsPtr->uiDocumentID] != 0) ) {
+            /* Get the weight for this document if we have a weight array, sparse weights are 
+            ** looked up with a cursor since the postings are in document ID order
+            */
+            fDocumentWeight = 0;
+            if ( pswSrchWeight != NULL ) {
+                
+                if ( pswSrchWeight->bSparseFlag == true ) {
+
+                    while ( (uiWeightsIndex < pswSrchWeight->uiDocumentIDsLength) && 
+                            (pswSrchWeight->puiDocumentIDs[uiWeightsIndex] < pssrSrchShortResultsPtr->uiDocumentID) ) {
+                        uiWeightsIndex++;
+                    }
+
+                    if ( (uiWeightsIndex < pswSrchWeight->uiDocumentIDsLength) && 
+                            (pswSrchWeight->puiDocumentIDs[uiWeightsIndex] == pssrSrchShortResultsPtr->uiDocumentID) ) {
+                        fDocumentWeight = pswSrchWeight->pfWeights[uiWeightsIndex];
+                    }
+                }
+                else {
+                    fDocumentWeight = pswSrchWeight->pfWeights[pssrSrchShortResultsPtr->uiDocumentID];
+                }
+            }
+
+            /* Increment the weight if the weight is set for this document */
+            if ( fDocumentWeight != 0 ) {
 
                 /* Increment the weight, note that the weight could be negative */
-                fWeight += pswSrchWeight->pfWeights[pssrSrchShortResultsPtr->uiDocumentID];
+                fWeight += fDocumentWeight;
 
                 /* Apply minimal document weighting if the weight decremented below 0 */
                 if ( fWeight < 0 ) {
@@ -5557,8 +6503,13 @@ static int iSrchSearchGetShortResultsFromRawResults
             }
 
 
-            /* Get the document information for this short result */
-            if ( (iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, pssrSrchShortResultsPtr->uiDocumentID, NULL, NULL, puiDocumentRank, 
+            /* Get the document information for this short result, straight from the document columns if we can */
+            if ( (psiSrchIndex->psdcSrchDocumentColumns != NULL) && (ppsdiSrchDocumentItems == NULL) && 
+                    (pssrSrchShortResultsPtr->uiDocumentID <= psiSrchIndex->psdcSrchDocumentColumns->uiDocumentCount) ) {
+                SRCH_DOCUMENT_COLUMNS_GET_DOCUMENT_INFO(psiSrchIndex->psdcSrchDocumentColumns, pssrSrchShortResultsPtr->uiDocumentID, puiDocumentRank, 
+                        &uiDocumentTermCount, pulDocumentAnsiDate, puiDocumentLanguageID);
+            }
+            else if ( (iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, pssrSrchShortResultsPtr->uiDocumentID, NULL, NULL, puiDocumentRank, 
                     &uiDocumentTermCount, pulDocumentAnsiDate, puiDocumentLanguageID, ppsdiSrchDocumentItems, puiSrchDocumentItemsLength, 
                     uiItemID, false, false, false)) != SRCH_NoError ) {
 
@@ -5611,8 +6562,8 @@ static int iSrchSearchGetShortResultsFromRawResults
 #if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_RAW) || defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_AVERAGE) || \
         defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG) || defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG2)
 
-            /* Adjust the weight based on the stated term count */
-            if ( uiDocumentTermCount > 0 ) {
+            /* Adjust the weight based on the stated term count, unless the impacts already did */
+            if ( (uiDocumentTermCount > 0) && (bImpacts == false) ) {
                 
 #if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_RAW)
                 /* Division by term count */
@@ -5741,42 +6692,55 @@ static int iSrchSearchGetShortResultsFromRawResults
                                             (uiSortFieldType == SRCH_SEARCH_SORT_FIELD_TYPE_ITEM_DOUBLE) || 
                                             (uiSortFieldType == SRCH_SEARCH_SORT_FIELD_TYPE_ITEM_UCHAR)) ? &uiSrchDocumentItemsLength : NULL;
 
-        /* Dereference the exclusion and inclusion bitmap array */
-        unsigned char               *pucExclusionBitmapPtr = (psbSrchBitmapExclusion != NULL) ? psbSrchBitmapExclusion->pucBitmap : NULL;
-        unsigned char               *pucInclusionBitmapPtr = (psbSrchBitmapInclusion != NULL) ? psbSrchBitmapInclusion->pucBitmap : NULL;
-
 
-        /* Loop over each entry in the weights array, documentID 0 does not exist, hence the '+ 1' */
-        for ( uiDocumentID = 1, pssrSrchShortResultsPtr = pssrSrchShortResults, pfWeightsPtr = pswSrchWeight->pfWeights + 1, pfWeightsEnd = pswSrchWeight->pfWeights + pswSrchWeight->uiWeightsLength; 
-                pfWeightsPtr < pfWeightsEnd; uiDocumentID++, pfWeightsPtr++ ) {
+        /* Loop over each entry in the weights array, sparse weights only hold the documents which were 
+        ** weighted, otherwise documentID 0 does not exist, hence the '+ 1'
+        */
+        for ( uiWeightsIndex = (pswSrchWeight->bSparseFlag == true) ? 0 : 1, pssrSrchShortResultsPtr = pssrSrchShortResults, 
+                pfWeightsPtr = pswSrchWeight->pfWeights + uiWeightsIndex, 
+                pfWeightsEnd = pswSrchWeight->pfWeights + ((pswSrchWeight->bSparseFlag == true) ? pswSrchWeight->uiDocumentIDsLength : pswSrchWeight->uiWeightsLength); 
+                pfWeightsPtr < pfWeightsEnd; uiWeightsIndex++, pfWeightsPtr++ ) {
 
             /* Skip this entry if there is no weight or if the weight is negative */
             if ( *pfWeightsPtr <= 0 ) {
                 continue;
             }
 
+            /* Set the document ID */
+            uiDocumentID = (pswSrchWeight->bSparseFlag == true) ? pswSrchWeight->puiDocumentIDs[uiWeightsIndex] : uiWeightsIndex;
+
 
             /* Skip this entry if there is an exclusion bitmap array and this document is in there */
-            if ( pucExclusionBitmapPtr != NULL ) {
+            if ( psbSrchBitmapExclusion != NULL ) {
 
                 /* Skip this document if the bit is set */
-                if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucExclusionBitmapPtr, uiDocumentID) ) {
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapExclusion, uiDocumentID) == true ) {
                     uiExcludedDocumentCount++;
                     continue;
                 }
             }
 
             /* Skip this entry if there is an inclusion bitmap array and this document is *not* in there */
-            if ( pucInclusionBitmapPtr != NULL ) {
+            if ( psbSrchBitmapInclusion != NULL ) {
 
                 /* Skip this document if the bit is *not* set */
-                if ( !UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucInclusionBitmapPtr, uiDocumentID) ) {
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapInclusion, uiDocumentID) == false ) {
                     continue;
                 }
 
                 uiIncludedDocumentCount++;
             }
 
+            /* Skip this entry if there is a dates bitmap array and this document is *not* in there */
+            if ( psbSrchBitmapDates != NULL ) {
+
+                /* Skip this document if the bit is *not* set */
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapDates, uiDocumentID) == false ) {
+                    uiFailedDateMatchCount++;
+                    continue;
+                }
+            }
+
 
             /* Create a new short result */
             pssrSrchShortResultsPtr->uiDocumentID = uiDocumentID;
@@ -5786,8 +6750,13 @@ static int iSrchSearchGetShortResultsFromRawResults
             fWeight = *pfWeightsPtr;
 
 
-            /* Get the document information for this short result */
-            if ( (iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, pssrSrchShortResultsPtr->uiDocumentID, NULL, NULL, puiDocumentRank, 
+            /* Get the document information for this short result, straight from the document columns if we can */
+            if ( (psiSrchIndex->psdcSrchDocumentColumns != NULL) && (ppsdiSrchDocumentItems == NULL) && 
+                    (pssrSrchShortResultsPtr->uiDocumentID <= psiSrchIndex->psdcSrchDocumentColumns->uiDocumentCount) ) {
+                SRCH_DOCUMENT_COLUMNS_GET_DOCUMENT_INFO(psiSrchIndex->psdcSrchDocumentColumns, pssrSrchShortResultsPtr->uiDocumentID, puiDocumentRank, 
+                        &uiDocumentTermCount, pulDocumentAnsiDate, puiDocumentLanguageID);
+            }
+            else if ( (iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, pssrSrchShortResultsPtr->uiDocumentID, NULL, NULL, puiDocumentRank, 
                     &uiDocumentTermCount, pulDocumentAnsiDate, puiDocumentLanguageID, ppsdiSrchDocumentItems, puiSrchDocumentItemsLength, 
                     uiItemID, false, false, false)) != SRCH_NoError ) {
 
@@ -5840,8 +6809,8 @@ static int iSrchSearchGetShortResultsFromRawResults
 #if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_RAW) || defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_AVERAGE) || \
         defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG) || defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG2)
 
-            /* Adjust the weight based on the stated term count */
-            if ( uiDocumentTermCount > 0 ) {
+            /* Adjust the weight based on the stated term count, unless the impacts already did */
+            if ( (uiDocumentTermCount > 0) && (bImpacts == false) ) {
                 
 #if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_RAW)
                 /* Division by term count */
@@ -5970,35 +6939,41 @@ static int iSrchSearchGetShortResultsFromRawResults
                                             (uiSortFieldType == SRCH_SEARCH_SORT_FIELD_TYPE_ITEM_DOUBLE) || 
                                             (uiSortFieldType == SRCH_SEARCH_SORT_FIELD_TYPE_ITEM_UCHAR)) ? &uiSrchDocumentItemsLength : NULL;
 
-        /* Dereference the exclusion and inclusion bitmap array */
-        unsigned char               *pucExclusionBitmapPtr = (psbSrchBitmapExclusion != NULL) ? psbSrchBitmapExclusion->pucBitmap : NULL;
-        unsigned char               *pucInclusionBitmapPtr = (psbSrchBitmapInclusion != NULL) ? psbSrchBitmapInclusion->pucBitmap : NULL;
-
 
         /* Loop over each document ID, documentID 0 does not exist, hence the '+ 1' */
         for ( uiDocumentID = 1, pssrSrchShortResultsPtr = pssrSrchShortResults; uiDocumentID < psiSrchIndex->uiDocumentCount + 1; uiDocumentID++ ) {
 
             /* Skip this entry if there is an exclusion bitmap array and this document is in there */
-            if ( pucExclusionBitmapPtr != NULL ) {
+            if ( psbSrchBitmapExclusion != NULL ) {
 
                 /* Skip this document if the bit is set */
-                if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucExclusionBitmapPtr, uiDocumentID) != 0 ) {
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapExclusion, uiDocumentID) == true ) {
                     uiExcludedDocumentCount++;
                     continue;
                 }
             }
 
             /* Skip this entry if there is an inclusion bitmap array and this document is *not* in there */
-            if ( pucInclusionBitmapPtr != NULL ) {
+            if ( psbSrchBitmapInclusion != NULL ) {
                 
                 /* Skip this document if the bit is *not* set */
-                if ( !UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucInclusionBitmapPtr, uiDocumentID) ) {
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapInclusion, uiDocumentID) == false ) {
                     continue;
                 }
 
                 uiIncludedDocumentCount++;
             }
 
+            /* Skip this entry if there is a dates bitmap array and this document is *not* in there */
+            if ( psbSrchBitmapDates != NULL ) {
+
+                /* Skip this document if the bit is *not* set */
+                if ( SRCH_BITMAP_IS_BIT_SET(psbSrchBitmapDates, uiDocumentID) == false ) {
+                    uiFailedDateMatchCount++;
+                    continue;
+                }
+            }
+
 
             /* Create a new short result */
             pssrSrchShortResultsPtr->uiDocumentID = uiDocumentID;
@@ -6008,8 +6983,13 @@ static int iSrchSearchGetShortResultsFromRawResults
             fWeight = 1;
 
 
-            /* Get the document information for this short result */
-            if ( (iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, pssrSrchShortResultsPtr->uiDocumentID, NULL, NULL, puiDocumentRank, 
+            /* Get the document information for this short result, straight from the document columns if we can */
+            if ( (psiSrchIndex->psdcSrchDocumentColumns != NULL) && (ppsdiSrchDocumentItems == NULL) && 
+                    (pssrSrchShortResultsPtr->uiDocumentID <= psiSrchIndex->psdcSrchDocumentColumns->uiDocumentCount) ) {
+                SRCH_DOCUMENT_COLUMNS_GET_DOCUMENT_INFO(psiSrchIndex->psdcSrchDocumentColumns, pssrSrchShortResultsPtr->uiDocumentID, puiDocumentRank, 
+                        &uiDocumentTermCount, pulDocumentAnsiDate, puiDocumentLanguageID);
+            }
+            else if ( (iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, pssrSrchShortResultsPtr->uiDocumentID, NULL, NULL, puiDocumentRank, 
                     &uiDocumentTermCount, pulDocumentAnsiDate, puiDocumentLanguageID, ppsdiSrchDocumentItems, puiSrchDocumentItemsLength, 
                     uiItemID, false, false, false)) != SRCH_NoError ) {
 
@@ -6062,8 +7042,8 @@ static int iSrchSearchGetShortResultsFromRawResults
 #if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_RAW) || defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_AVERAGE) || \
         defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG) || defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG2)
 
-            /* Adjust the weight based on the stated term count */
-            if ( uiDocumentTermCount > 0 ) {
+            /* Adjust the weight based on the stated term count, unless the impacts already did */
+            if ( (uiDocumentTermCount > 0) && (bImpacts == false) ) {
                 
 #if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_RAW)
                 /* Division by term count */
@@ -6199,7 +7179,7 @@ static int iSrchSearchGetShortResultsFromRawResults
     /* Sort if need be */
     if ( uiSrchShortResultsLength > 0  ) {
         
-        if ( (iError = iSrchShortResultSort(&pssrSrchShortResults, uiSrchShortResultsLength, uiSortType)) != SRCH_NoError ) {
+        if ( (iError = iSrchShortResultSort(&pssrSrchShortResults, uiSrchShortResultsLength, uiEndIndex, uiSortType)) != SRCH_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to sort the short results: srch error: %d.", iError);
             goto bailFromiSrchSearchGetShortResultsFromRawResults;
         }
@@ -6425,341 +7405,1586 @@ static int iSrchSearchGetSpiSearchResultsFromShortResults
 /*---------------------------------------------------------------------------*/
 
 
+#if defined(SRCH_SEARCH_ENABLE_SEARCH_PLANS)
+
 /*
 
-    Function:   iSrchSearchGetPostingsListFromParserTermCluster()
+    Function:   iSrchSearchCreatePlanFromParserTermCluster()
 
-    Purpose:    This function searches for the term in a term cluster
-                and merges the results into a posting array, passing 
-                it back via the search postings list structure 
-                return pointer.
+    Purpose:    This function creates a search plan for a search parser
+                term cluster, estimating the number of documents each term
+                will match from the term dictionary before any postings
+                are read.
 
-                If no document were retrieved from this search,
-                the search postings list structure return pointer 
-                will be NULL.
+                If search plan reordering is enabled, the terms of AND and
+                OR term clusters are ordered by increasing estimated document 
+                count, so the smallest term drives the intersection and the 
+                search completes early when that term is empty. The terms of 
+                the other operators keep their order since it is significant, 
+                IOR is not commutative, and the estimate of a NOT term cluster
+                is the estimate of its first term so it gets placed on its 
+                positive side when it is part of an AND.
 
     Parameters: pssSrchSearch                   search structure
                 psiSrchIndex                    index structure
-                uiLanguageID                    language ID
-                psptcSrchParserTermCluster      search parser term cluster to process
-                ppsplSrchPostingsList           return pointer for the search postings list structure
+                psptcSrchParserTermCluster      search parser term cluster to plan
+                ppsspSrchSearchPlan             return pointer for the search plan
 
     Globals:    none
 
     Returns:    SRCH error code
 
 */
-static int iSrchSearchGetPostingsListFromParserTermCluster
+static int iSrchSearchCreatePlanFromParserTermCluster
 (
     struct srchSearch *pssSrchSearch,
     struct srchIndex *psiSrchIndex,
-    unsigned int uiLanguageID, 
     struct srchParserTermCluster *psptcSrchParserTermCluster,
-    struct srchPostingsList **ppsplSrchPostingsList
+    struct srchSearchPlan **ppsspSrchSearchPlan
 )
 {
 
     int                         iError = SRCH_NoError;
-    unsigned int                uiSrchParserBooleanOperationID = SRCH_PARSER_INVALID_ID;
-    unsigned int                uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_INVALID_ID;
+    struct srchSearchPlan       *psspSrchSearchPlan = NULL;
     unsigned int                uiI = 0;
-    struct srchPostingsList     *psplSrchPostingsList1 = NULL;
-    struct srchPostingsList     *psplSrchPostingsList2 = NULL;
-    
-    /* ADJ Term distance must be pre-set to 1 */
-    int                         iTermDistanceADJ = 1;
-    
-    /* NEAR Term distance must be pre-set to 0 */
-    int                         iTermDistanceNEAR = 0;
-    
-    boolean                     bSearchCompletionLogged = false;
+#if defined(SRCH_SEARCH_ENABLE_SEARCH_PLAN_REORDERING)
+    unsigned int                uiJ = 0;
+#endif    /* defined(SRCH_SEARCH_ENABLE_SEARCH_PLAN_REORDERING) */
 
 
     ASSERT(pssSrchSearch != NULL);
     ASSERT(psiSrchIndex != NULL);
-    ASSERT(uiLanguageID >= 0);
     ASSERT(psptcSrchParserTermCluster != NULL);
-    ASSERT(ppsplSrchPostingsList != NULL);
+    ASSERT(ppsspSrchSearchPlan != NULL);
 
 
-    /* Pre-set the return parameter */
-    *ppsplSrchPostingsList = NULL;
+    /* Allocate the search plan */
+    if ( (psspSrchSearchPlan = (struct srchSearchPlan *)s_malloc((size_t)(sizeof(struct srchSearchPlan)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchSearchCreatePlanFromParserTermCluster;
+    }
 
+    /* Set the terms length */
+    psspSrchSearchPlan->uiTermsLength = psptcSrchParserTermCluster->uiTermsLength;
 
-    /* Get the parser boolean operation ID */
-    if ( (iError = iSrchParserGetModifierID(pssSrchSearch->pvSrchParser, SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_ID, &uiSrchParserBooleanOperationID)) != SRCH_NoError ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser boolean operation ID, srch error: %d.", iError);
-        return (iError);
+    /* Nothing else to do if the term cluster is empty */
+    if ( psspSrchSearchPlan->uiTermsLength == 0 ) {
+        goto bailFromiSrchSearchCreatePlanFromParserTermCluster;
     }
-    
-    /* Set the posting boolean operation ID from the parser boolean operation ID */
-    if ( uiSrchParserBooleanOperationID == SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_STRICT_ID ) {
-        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID;
+
+    /* Allocate the term indices, the document counts and the search plans */
+    if ( (psspSrchSearchPlan->puiTermIndices = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * psspSrchSearchPlan->uiTermsLength))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchSearchCreatePlanFromParserTermCluster;
     }
-    else if ( uiSrchParserBooleanOperationID == SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_RELAXED_ID ) {
-        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID;
+
+    if ( (psspSrchSearchPlan->puiDocumentCounts = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * psspSrchSearchPlan->uiTermsLength))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchSearchCreatePlanFromParserTermCluster;
     }
-    else {
-        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID;
+
+    if ( (psspSrchSearchPlan->ppsspSrchSearchPlans = (struct srchSearchPlan **)s_malloc((size_t)(sizeof(struct srchSearchPlan *) * psspSrchSearchPlan->uiTermsLength))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchSearchCreatePlanFromParserTermCluster;
     }
-    
 
-    /* Loop over each entry */
-    for ( uiI = 0; uiI < psptcSrchParserTermCluster->uiTermsLength; uiI++ ) {
 
+    /* Loop over each term, estimating its document count */
+    for ( uiI = 0; uiI < psspSrchSearchPlan->uiTermsLength; uiI++ ) {
 
-        /* We can skip this term list entry if the (non-stop) term we just searched for has no occurences, 
-        ** we are using strict boolean or the term is required, and the operator boils down to an 
-        ** intersection of some sort
-        */
-        if ( (psplSrchPostingsList2 != NULL) && (psplSrchPostingsList2->uiTermType != SPI_TERM_TYPE_STOP) && (psplSrchPostingsList2->uiSrchPostingsLength == 0) && 
-                ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID) || 
-                    ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID) && (psplSrchPostingsList2->bRequired == true))) &&
-                ((psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NOT_ID) ||
-                (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID)) ) {
-        
-            /* Log if we have not logged already */
-            if ( bSearchCompletionLogged == false ) {
-                iSrchReportAppend(pssSrchSearch->pvSrchReport, "%s The search was completed early due to boolean constraints\n", REP_SEARCH_WARNING);
-                bSearchCompletionLogged = true;
-            }
+        /* Set the term index */
+        psspSrchSearchPlan->puiTermIndices[uiI] = uiI;
 
-            /* Skip to the next term list entry */
-            continue;
+        /* Estimate the document count for the term */
+        if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiI] == SRCH_PARSER_TERM_TYPE_TERM_ID ) {
+            iSrchSearchGetDocumentCountEstimateFromParserTerm(psiSrchIndex, (struct srchParserTerm *)psptcSrchParserTermCluster->ppvTerms[uiI], 
+                    &psspSrchSearchPlan->puiDocumentCounts[uiI]);
         }
 
-
-        /* Hand over the second search postings list structure pointer to the first search postings list structure pointer if it is populated */
-        if ( psplSrchPostingsList2 != NULL ) {
-            ASSERT(psplSrchPostingsList1 == NULL);
-            psplSrchPostingsList1 = psplSrchPostingsList2;
-            psplSrchPostingsList2 = NULL;
+        /* Plan the term cluster and use its estimate */
+        else if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiI] == SRCH_PARSER_TERM_TYPE_TERM_CLUSTER_ID ) {
+            
+            if ( (iError = iSrchSearchCreatePlanFromParserTermCluster(pssSrchSearch, psiSrchIndex, 
+                    (struct srchParserTermCluster *)psptcSrchParserTermCluster->ppvTerms[uiI], &psspSrchSearchPlan->ppsspSrchSearchPlans[uiI])) != SRCH_NoError ) {
+                goto bailFromiSrchSearchCreatePlanFromParserTermCluster;
+            }
+            
+            psspSrchSearchPlan->puiDocumentCounts[uiI] = psspSrchSearchPlan->ppsspSrchSearchPlans[uiI]->uiDocumentCount;
         }
 
+        /* Unknown term type, assume the worst */
+        else {
+            psspSrchSearchPlan->puiDocumentCounts[uiI] = psiSrchIndex->uiDocumentCount;
+        }
+    }
 
-        /* Its a term!! */
-        if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiI] == SRCH_PARSER_TERM_TYPE_TERM_ID ) {
 
-            /* Start and end document ID */
-            unsigned int uiStartDocumentID = 0;
-            unsigned int uiEndDocumentID = 0;
+#if defined(SRCH_SEARCH_ENABLE_SEARCH_PLAN_REORDERING)
+    /* Order the terms by increasing document count for commutative operators, 
+    ** this is an insertion sort which is stable and more than adequate for the
+    ** handful of terms found in a term cluster
+    */
+    if ( (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID) || 
+            (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_OR_ID) ) {
 
-            // Set the start and end document ID if there is a posting list and the operator is an 'and', a 'not', an 'adj' or a 'near' */
-            if ( (psplSrchPostingsList1 != NULL) && (psplSrchPostingsList1->pspSrchPostings != NULL) && (psplSrchPostingsList1->uiSrchPostingsLength > 0) &&
-                    ((psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NOT_ID) ||
-                    (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID)) ) {
-                uiStartDocumentID = psplSrchPostingsList1->pspSrchPostings->uiDocumentID;
-                uiEndDocumentID = (psplSrchPostingsList1->pspSrchPostings + (psplSrchPostingsList1->uiSrchPostingsLength - 1))->uiDocumentID;
+        for ( uiI = 1; uiI < psspSrchSearchPlan->uiTermsLength; uiI++ ) {
+    
+            unsigned int    uiTermIndex = psspSrchSearchPlan->puiTermIndices[uiI];
+    
+            for ( uiJ = uiI; (uiJ > 0) && 
+                    (psspSrchSearchPlan->puiDocumentCounts[psspSrchSearchPlan->puiTermIndices[uiJ - 1]] > psspSrchSearchPlan->puiDocumentCounts[uiTermIndex]); uiJ-- ) {
+                psspSrchSearchPlan->puiTermIndices[uiJ] = psspSrchSearchPlan->puiTermIndices[uiJ - 1];
+                psspSrchSearchPlan->bReordered = true;
             }
+    
+            psspSrchSearchPlan->puiTermIndices[uiJ] = uiTermIndex;
+        }
+    }
+#endif    /* defined(SRCH_SEARCH_ENABLE_SEARCH_PLAN_REORDERING) */
 
 
-            /* Get the search postings list structure for this term */
-            if ( (iError = iSrchSearchGetPostingsListFromParserTerm(pssSrchSearch, psiSrchIndex, uiLanguageID, 
-                    (struct srchParserTerm *)psptcSrchParserTermCluster->ppvTerms[uiI], uiStartDocumentID, uiEndDocumentID, &psplSrchPostingsList2)) != SRCH_NoError ) {
-                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the postings list for a term, index: '%s', srch error: %d.", 
-                        psiSrchIndex->pucIndexName, iError);
-                return (iError);
+    /* Work out the estimated document count for the term cluster */
+    switch ( psptcSrchParserTermCluster->uiOperatorID ) {
+
+        /* Intersections, bounded by the smallest term */
+        case SRCH_PARSER_OPERATOR_AND_ID:
+        case SRCH_PARSER_OPERATOR_ADJ_ID:
+        case SRCH_PARSER_OPERATOR_NEAR_ID:
+            psspSrchSearchPlan->uiDocumentCount = psspSrchSearchPlan->puiDocumentCounts[0];
+            for ( uiI = 1; uiI < psspSrchSearchPlan->uiTermsLength; uiI++ ) {
+                psspSrchSearchPlan->uiDocumentCount = UTL_MACROS_MIN(psspSrchSearchPlan->uiDocumentCount, psspSrchSearchPlan->puiDocumentCounts[uiI]);
             }
-        }
+            break;
 
-        /* Its a term cluster */
-        else if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiI] == SRCH_PARSER_TERM_TYPE_TERM_CLUSTER_ID ) {
+        /* Exclusion, bounded by the first term */
+        case SRCH_PARSER_OPERATOR_NOT_ID:
+            psspSrchSearchPlan->uiDocumentCount = psspSrchSearchPlan->puiDocumentCounts[0];
+            break;
 
-            /* Call ourselves */
-            if ( (iError = iSrchSearchGetPostingsListFromParserTermCluster(pssSrchSearch, psiSrchIndex, uiLanguageID, 
-                    (struct srchParserTermCluster *)psptcSrchParserTermCluster->ppvTerms[uiI], &psplSrchPostingsList2)) != SRCH_NoError ) {
-                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the postings list for a term cluster, index: '%s', srch error: %d.", 
-                        psiSrchIndex->pucIndexName, iError);
-                return (iError);
+        /* Unions, bounded by the sum of the terms and by the document count */
+        default:
+            for ( uiI = 0; uiI < psspSrchSearchPlan->uiTermsLength; uiI++ ) {
+                psspSrchSearchPlan->uiDocumentCount = UTL_MACROS_MIN(psspSrchSearchPlan->uiDocumentCount + psspSrchSearchPlan->puiDocumentCounts[uiI], 
+                        psiSrchIndex->uiDocumentCount);
             }
-        }
+            break;
+    }
 
-        /* Ouch - invalid term type ?? */
-        else {
-            ASSERT(false);
-        }
 
 
-        /* Merge the search postings list structures if the first search postings list structure is defined */
-        if ( psplSrchPostingsList1 != NULL ) {
+    /* Bail label */
+    bailFromiSrchSearchCreatePlanFromParserTermCluster:
 
-            /* AND */
-            if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID ) {
-                
-                /* AND the two search postings list structures */
-                if ( (iError = iSrchPostingMergeSrchPostingsListsAND(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID, 
-                        &psplSrchPostingsList2)) != SRCH_NoError ) {
-                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to AND merge postings list, srch error: %d.", iError);
-                    return (iError);
-                }
-                
-                /* NULL out the first search postings list structure */
-                psplSrchPostingsList1 = NULL;
-            }
 
-            /* OR */
-            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_OR_ID ) {
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
 
-                /* OR the two search postings list structures */
-                if ( (iError = iSrchPostingMergeSrchPostingsListsOR(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID, 
-                        &psplSrchPostingsList2)) != SRCH_NoError ) {
-                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to OR merge postings list, srch error: %d.", iError);
-                    return (iError);
-                }
-                
-                /* NULL out the first search postings list structure */
-                psplSrchPostingsList1 = NULL;
-            }
+        /* Set the return pointer */
+        *ppsspSrchSearchPlan = psspSrchSearchPlan;
+    }
+    else {
 
-            /* IOR */
+        /* Free the search plan */
+        iSrchSearchFreePlan(psspSrchSearchPlan);
+        psspSrchSearchPlan = NULL;
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchGetDocumentCountEstimateFromParserTerm()
+
+    Purpose:    This function estimates the number of documents a search
+                parser term will match from the term dictionary. 
+
+                The estimate is only used to plan the search so it errs on 
+                the high side, wildcards, functions, ranges and stop terms
+                are assumed to match every document, as are terms which 
+                are not in the dictionary as is if the index is stemmed.
+
+    Parameters: psiSrchIndex            index structure
+                psptSrchParserTerm      search parser term
+                puiDocumentCount        return pointer for the estimated document count
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchGetDocumentCountEstimateFromParserTerm
+(
+    struct srchIndex *psiSrchIndex,
+    struct srchParserTerm *psptSrchParserTerm,
+    unsigned int *puiDocumentCount
+)
+{
+
+    int             iError = SRCH_NoError;
+    wchar_t         pwcTerm[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+    unsigned char   pucTerm[SRCH_TERM_LENGTH_MAXIMUM + 1] = {'\0'};
+    unsigned int    uiTermType = SPI_TERM_TYPE_UNKNOWN;
+    unsigned int    uiTermCount = 0;
+    unsigned int    uiDocumentCount = 0;
+    unsigned long   ulIndexBlockID = 0;
+    unsigned int    uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psptSrchParserTerm != NULL);
+    ASSERT(puiDocumentCount != NULL);
+
+
+    /* Assume the worst */
+    *puiDocumentCount = psiSrchIndex->uiDocumentCount;
+
+
+    /* Wildcards, functions and ranges other than equality cant be estimated from a single term */
+    if ( (psptSrchParserTerm->bWildCardSearch == true) || (psptSrchParserTerm->uiFunctionID != SRCH_PARSER_INVALID_ID) || 
+            ((psptSrchParserTerm->uiRangeID != SRCH_PARSER_INVALID_ID) && (psptSrchParserTerm->uiRangeID != SRCH_PARSER_RANGE_EQUAL_ID)) ) {
+        return (SRCH_NoError);
+    }
+
+    /* Skip empty terms */
+    if ( bUtlStringsIsWideStringNULL(psptSrchParserTerm->pwcTerm) == true ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Copy the term and convert it to lower case, this is the form most terms are indexed in */
+    s_wcsncpy(pwcTerm, psptSrchParserTerm->pwcTerm, SRCH_TERM_LENGTH_MAXIMUM + 1);
+    pwcLngCaseConvertWideStringToLowerCase(pwcTerm);
+
+    /* Convert the term from wide characters to utf-8 */
+    if ( (iError = iLngConvertWideStringToUtf8_s(pwcTerm, 0, pucTerm, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Look up the term */
+    iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, NULL, 0, &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID);
+
+    /* Use the document count if the term was found and it is not a stop term */
+    if ( iError == SRCH_NoError ) {
+        if ( (uiTermType != SPI_TERM_TYPE_STOP) && (uiDocumentCount > 0) ) {
+            *puiDocumentCount = uiDocumentCount;
+        }
+    }
+
+    /* The term does not exist, it wont match anything unless the index is stemmed */
+    else if ( (iError == SRCH_TermDictTermNotFound) && (psiSrchIndex->uiStemmerID == LNG_STEMMER_NONE_ID) ) {
+        *puiDocumentCount = 0;
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchReportPlan()
+
+    Purpose:    This function adds a search plan to the search report, 
+                one line per term cluster.
+
+    Parameters: pssSrchSearch                   search structure
+                psptcSrchParserTermCluster      search parser term cluster
+                psspSrchSearchPlan              search plan for the search parser term cluster
+                uiLevel                         term cluster level
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchReportPlan
+(
+    struct srchSearch *pssSrchSearch,
+    struct srchParserTermCluster *psptcSrchParserTermCluster,
+    struct srchSearchPlan *psspSrchSearchPlan,
+    unsigned int uiLevel
+)
+{
+
+    unsigned int    uiI = 0;
+
+
+    ASSERT(pssSrchSearch != NULL);
+    ASSERT(psptcSrchParserTermCluster != NULL);
+
+
+    /* Nothing to report if there is no search plan */
+    if ( psspSrchSearchPlan == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Add the term cluster to the search report */
+    iSrchReportAppend(pssSrchSearch->pvSrchReport, "%s Search plan, level: %u, operator: '%ls', estimated documents: %u%s, terms:", 
+            REP_SEARCH_DEBUG, uiLevel, pwcSrchParserGetStringFromID(pssSrchSearch->pvSrchParser, psptcSrchParserTermCluster->uiOperatorID), 
+            psspSrchSearchPlan->uiDocumentCount, (psspSrchSearchPlan->bReordered == true) ? " (reordered)" : "");
+
+    /* Add the terms to the search report in the order they will be processed */
+    for ( uiI = 0; uiI < psspSrchSearchPlan->uiTermsLength; uiI++ ) {
+
+        unsigned int    uiTermIndex = psspSrchSearchPlan->puiTermIndices[uiI];
+
+        if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiTermIndex] == SRCH_PARSER_TERM_TYPE_TERM_ID ) {
+            iSrchReportAppend(pssSrchSearch->pvSrchReport, " '%ls' %u", 
+                    ((struct srchParserTerm *)psptcSrchParserTermCluster->ppvTerms[uiTermIndex])->pwcTerm, psspSrchSearchPlan->puiDocumentCounts[uiTermIndex]);
+        }
+        else {
+            iSrchReportAppend(pssSrchSearch->pvSrchReport, " (level: %u) %u", uiLevel + 1, psspSrchSearchPlan->puiDocumentCounts[uiTermIndex]);
+        }
+    }
+
+    iSrchReportAppend(pssSrchSearch->pvSrchReport, "\n");
+
+
+    /* Add the sub-term clusters to the search report */
+    for ( uiI = 0; uiI < psspSrchSearchPlan->uiTermsLength; uiI++ ) {
+
+        unsigned int    uiTermIndex = psspSrchSearchPlan->puiTermIndices[uiI];
+
+        if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiTermIndex] == SRCH_PARSER_TERM_TYPE_TERM_CLUSTER_ID ) {
+            iSrchSearchReportPlan(pssSrchSearch, (struct srchParserTermCluster *)psptcSrchParserTermCluster->ppvTerms[uiTermIndex], 
+                    psspSrchSearchPlan->ppsspSrchSearchPlans[uiTermIndex], uiLevel + 1);
+        }
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchFreePlan()
+
+    Purpose:    This function frees a search plan.
+
+    Parameters: psspSrchSearchPlan      search plan (optional)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchFreePlan
+(
+    struct srchSearchPlan *psspSrchSearchPlan
+)
+{
+
+    unsigned int    uiI = 0;
+
+
+    /* Nothing to free */
+    if ( psspSrchSearchPlan == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Free the search plans */
+    if ( psspSrchSearchPlan->ppsspSrchSearchPlans != NULL ) {
+        for ( uiI = 0; uiI < psspSrchSearchPlan->uiTermsLength; uiI++ ) {
+            iSrchSearchFreePlan(psspSrchSearchPlan->ppsspSrchSearchPlans[uiI]);
+        }
+    }
+
+    s_free(psspSrchSearchPlan->ppsspSrchSearchPlans);
+    s_free(psspSrchSearchPlan->puiDocumentCounts);
+    s_free(psspSrchSearchPlan->puiTermIndices);
+    s_free(psspSrchSearchPlan);
+
+
+    return (SRCH_NoError);
+
+}
+
+#endif    /* defined(SRCH_SEARCH_ENABLE_SEARCH_PLANS) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if !defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS)
+
+/*
+
+    Function:   iSrchSearchGetPostingsListFromParserTermCluster()
+
+    Purpose:    This function searches for the term in a term cluster
+                and merges the results into a posting array, passing 
+                it back via the search postings list structure 
+                return pointer.
+
+                If no document were retrieved from this search,
+                the search postings list structure return pointer 
+                will be NULL.
+
+    Parameters: pssSrchSearch                   search structure
+                psiSrchIndex                    index structure
+                uiLanguageID                    language ID
+                psptcSrchParserTermCluster      search parser term cluster to process
+                psspSrchSearchPlan              search plan for the search parser term cluster (optional)
+                bTermPositions                  set to true if the term positions are needed
+                ppsplSrchPostingsList           return pointer for the search postings list structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchGetPostingsListFromParserTermCluster
+(
+    struct srchSearch *pssSrchSearch,
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiLanguageID, 
+    struct srchParserTermCluster *psptcSrchParserTermCluster,
+    struct srchSearchPlan *psspSrchSearchPlan,
+    boolean bTermPositions,
+    struct srchPostingsList **ppsplSrchPostingsList
+)
+{
+
+    int                         iError = SRCH_NoError;
+    unsigned int                uiSrchParserBooleanOperationID = SRCH_PARSER_INVALID_ID;
+    unsigned int                uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_INVALID_ID;
+    unsigned int                uiI = 0;
+    unsigned int                uiTermIndex = 0;
+    struct srchPostingsList     *psplSrchPostingsList1 = NULL;
+    struct srchPostingsList     *psplSrchPostingsList2 = NULL;
+    struct srchCursor           **ppscSrchCursorsOR = NULL;
+    unsigned int                uiSrchCursorsORLength = 0;
+    
+    /* ADJ Term distance must be pre-set to 1 */
+    int                         iTermDistanceADJ = 1;
+    
+    /* NEAR Term distance must be pre-set to 0 */
+    int                         iTermDistanceNEAR = 0;
+    
+    boolean                     bSearchCompletionLogged = false;
+
+
+    ASSERT(pssSrchSearch != NULL);
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(uiLanguageID >= 0);
+    ASSERT(psptcSrchParserTermCluster != NULL);
+    ASSERT(ppsplSrchPostingsList != NULL);
+
+
+    /* Pre-set the return parameter */
+    *ppsplSrchPostingsList = NULL;
+
+
+    /* Get the parser boolean operation ID */
+    if ( (iError = iSrchParserGetModifierID(pssSrchSearch->pvSrchParser, SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_ID, &uiSrchParserBooleanOperationID)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser boolean operation ID, srch error: %d.", iError);
+        return (iError);
+    }
+    
+    /* Set the posting boolean operation ID from the parser boolean operation ID */
+    if ( uiSrchParserBooleanOperationID == SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_STRICT_ID ) {
+        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID;
+    }
+    else if ( uiSrchParserBooleanOperationID == SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_RELAXED_ID ) {
+        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID;
+    }
+    else {
+        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID;
+    }
+    
+
+    /* Allocate the search postings list structures list for OR, the terms are collected 
+    ** and merged in a single pass rather than being merged one at a time
+    */
+    if ( (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_OR_ID) && (psptcSrchParserTermCluster->uiTermsLength > 2) ) {
+        if ( (ppsplSrchPostingsListsOR = (struct srchPostingsList **)s_malloc((size_t)(sizeof(struct srchPostingsList *) * psptcSrchParserTermCluster->uiTermsLength))) == NULL ) {
+            return (SRCH_MemError);
+        }
+    }
+
+
+    /* Loop over each entry */
+    for ( uiI = 0; uiI < psptcSrchParserTermCluster->uiTermsLength; uiI++ ) {
+
+        /* Get the index of the term to process, the search plan may have reordered the terms */
+        uiTermIndex = (psspSrchSearchPlan != NULL) ? psspSrchSearchPlan->puiTermIndices[uiI] : uiI;
+
+
+
+        /* We can skip this term list entry if the (non-stop) term we just searched for has no occurences, 
+        ** we are using strict boolean or the term is required, and the operator boils down to an 
+        ** intersection of some sort
+        */
+        if ( (psplSrchPostingsList2 != NULL) && (psplSrchPostingsList2->uiTermType != SPI_TERM_TYPE_STOP) && 
+                (psplSrchPostingsList2->uiSrchPostingsLength == 0) && (psplSrchPostingsList2->pvUtlRoaring == NULL) && 
+                ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID) || 
+                    ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID) && (psplSrchPostingsList2->bRequired == true))) &&
+                ((psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NOT_ID) ||
+                (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID)) ) {
+        
+            /* Log if we have not logged already */
+            if ( bSearchCompletionLogged == false ) {
+                iSrchReportAppend(pssSrchSearch->pvSrchReport, "%s The search was completed early due to boolean constraints\n", REP_SEARCH_WARNING);
+                bSearchCompletionLogged = true;
+            }
+
+            /* Skip to the next term list entry */
+            continue;
+        }
+
+
+        /* Hand over the second search postings list structure pointer to the first search postings list structure pointer if it is populated */
+        if ( psplSrchPostingsList2 != NULL ) {
+            ASSERT(psplSrchPostingsList1 == NULL);
+            psplSrchPostingsList1 = psplSrchPostingsList2;
+            psplSrchPostingsList2 = NULL;
+        }
+
+
+        /* Its a term!! */
+        if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiTermIndex] == SRCH_PARSER_TERM_TYPE_TERM_ID ) {
+
+            /* Start and end document ID */
+            unsigned int uiStartDocumentID = 0;
+            unsigned int uiEndDocumentID = 0;
+
+            // Set the start and end document ID if there is a posting list and the operator is an 'and', a 'not', an 'adj' or a 'near' */
+            if ( (psplSrchPostingsList1 != NULL) && (psplSrchPostingsList1->pspSrchPostings != NULL) && (psplSrchPostingsList1->uiSrchPostingsLength > 0) &&
+                    ((psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NOT_ID) ||
+                    (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID)) ) {
+                uiStartDocumentID = psplSrchPostingsList1->pspSrchPostings->uiDocumentID;
+                uiEndDocumentID = (psplSrchPostingsList1->pspSrchPostings + (psplSrchPostingsList1->uiSrchPostingsLength - 1))->uiDocumentID;
+            }
+
+
+            /* Get the search postings list structure for this term, the document containers can be used
+            ** if the term positions are not needed and the term is being ANDed or NOTed into a postings list
+            */
+            if ( (iError = iSrchSearchGetPostingsListFromParserTerm(pssSrchSearch, psiSrchIndex, uiLanguageID, 
+                    (struct srchParserTerm *)psptcSrchParserTermCluster->ppvTerms[uiTermIndex], uiStartDocumentID, uiEndDocumentID, 
+                    SRCH_SEARCH_TERM_CLUSTER_NEEDS_TERM_POSITIONS(bTermPositions, psptcSrchParserTermCluster->uiOperatorID), 
+                    SRCH_SEARCH_TERM_CLUSTER_USES_DOCUMENT_CONTAINERS(bTermPositions, psptcSrchParserTermCluster->uiOperatorID, uiI),
+                    false, &psplSrchPostingsList2)) != SRCH_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the postings list for a term, index: '%s', srch error: %d.", 
+                        psiSrchIndex->pucIndexName, iError);
+                if ( ppsplSrchPostingsListsOR != NULL ) {
+                    while ( uiSrchPostingsListsORLength > 0 ) {
+                        iSrchPostingFreeSrchPostingsList(ppsplSrchPostingsListsOR[--uiSrchPostingsListsORLength]);
+                    }
+                    s_free(ppsplSrchPostingsListsOR);
+                }
+                return (iError);
+            }
+        }
+
+        /* Its a term cluster */
+        else if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiTermIndex] == SRCH_PARSER_TERM_TYPE_TERM_CLUSTER_ID ) {
+
+            /* Call ourselves */
+            if ( (iError = iSrchSearchGetPostingsListFromParserTermCluster(pssSrchSearch, psiSrchIndex, uiLanguageID, 
+                    (struct srchParserTermCluster *)psptcSrchParserTermCluster->ppvTerms[uiTermIndex], 
+                    (psspSrchSearchPlan != NULL) ? psspSrchSearchPlan->ppsspSrchSearchPlans[uiTermIndex] : NULL,
+                    SRCH_SEARCH_TERM_CLUSTER_NEEDS_TERM_POSITIONS(bTermPositions, psptcSrchParserTermCluster->uiOperatorID), &psplSrchPostingsList2)) != SRCH_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the postings list for a term cluster, index: '%s', srch error: %d.", 
+                        psiSrchIndex->pucIndexName, iError);
+                if ( ppsplSrchPostingsListsOR != NULL ) {
+                    while ( uiSrchPostingsListsORLength > 0 ) {
+                        iSrchPostingFreeSrchPostingsList(ppsplSrchPostingsListsOR[--uiSrchPostingsListsORLength]);
+                    }
+                    s_free(ppsplSrchPostingsListsOR);
+                }
+                return (iError);
+            }
+        }
+
+        /* Ouch - invalid term type ?? */
+        else {
+            ASSERT(false);
+        }
+
+
+        /* Collect the search postings list structure if we are merging the OR in a single pass */
+        if ( ppsplSrchPostingsListsOR != NULL ) {
+            ASSERT(psplSrchPostingsList1 == NULL);
+            ppsplSrchPostingsListsOR[uiSrchPostingsListsORLength++] = psplSrchPostingsList2;
+            psplSrchPostingsList2 = NULL;
+            continue;
+        }
+
+
+        /* Merge the search postings list structures if the first search postings list structure is defined */
+        if ( psplSrchPostingsList1 != NULL ) {
+
+            /* AND */
+            if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID ) {
+                
+                /* AND the two search postings list structures */
+                if ( (iError = iSrchPostingMergeSrchPostingsListsAND(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID, 
+                        &psplSrchPostingsList2)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to AND merge postings list, srch error: %d.", iError);
+                    return (iError);
+                }
+                
+                /* NULL out the first search postings list structure */
+                psplSrchPostingsList1 = NULL;
+            }
+
+            /* OR */
+            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_OR_ID ) {
+
+                /* OR the two search postings list structures */
+                if ( (iError = iSrchPostingMergeSrchPostingsListsOR(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID, 
+                        &psplSrchPostingsList2)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to OR merge postings list, srch error: %d.", iError);
+                    return (iError);
+                }
+                
+                /* NULL out the first search postings list structure */
+                psplSrchPostingsList1 = NULL;
+            }
+
+            /* IOR */
             else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_IOR_ID ) {
 
-                /* IOR the two search postings list structures */
-                if ( (iError = iSrchPostingMergeSrchPostingsListsIOR(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID,     
-                        &psplSrchPostingsList2)) != SRCH_NoError ) {
-                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to IOR merge postings list, srch error: %d.", iError);
-                    return (iError);
-                }
-                
-                /* NULL out the first search postings list structure */
-                psplSrchPostingsList1 = NULL;
-            }
+                /* IOR the two search postings list structures */
+                if ( (iError = iSrchPostingMergeSrchPostingsListsIOR(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID,     
+                        &psplSrchPostingsList2)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to IOR merge postings list, srch error: %d.", iError);
+                    return (iError);
+                }
+                
+                /* NULL out the first search postings list structure */
+                psplSrchPostingsList1 = NULL;
+            }
+
+            /* XOR */
+            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_XOR_ID ) {
+
+                /* XOR the two search postings list structures */
+                if ( (iError = iSrchPostingMergeSrchPostingsListsXOR(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID, 
+                        &psplSrchPostingsList2)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to XOR merge postings list, srch error: %d.", iError);
+                    return (iError);
+                }
+                
+                /* NULL out the first search postings list structure */
+                psplSrchPostingsList1 = NULL;
+            }
+
+            /* NOT */
+            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NOT_ID ) {
+
+                /* NOT the two search postings list structures */
+                if ( (iError = iSrchPostingMergeSrchPostingsListsNOT(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID, 
+                        &psplSrchPostingsList2)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to NOT merge postings list, srch error: %d.", iError);
+                    return (iError);
+                }
+                
+                /* NULL out the first search postings list structure */
+                psplSrchPostingsList1 = NULL;
+            }
+
+            /* ADJ */
+            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID ) {
+            
+                /* ADJ the two search postings list structures */
+            
+                /* Here we need to skip over stop terms in the phrase, but we 
+                ** still take account of them in the term distance.
+                */
+                if ( (psplSrchPostingsList2 != NULL) && (psplSrchPostingsList2->uiTermType == SPI_TERM_TYPE_STOP) ) {
+                    
+                    /* Increment the term distance */
+                    iTermDistanceADJ++;
+                    
+                    /* Free the stop term search postings list structure */
+                    iSrchPostingFreeSrchPostingsList(psplSrchPostingsList2);
+                    psplSrchPostingsList2 = NULL;
+                    
+                    /* Hand the first search postings list structure pointer to the second search postings list structure 
+                    ** structure pointer, and null out the second posting structure pointer
+                    */
+                    psplSrchPostingsList2 = psplSrchPostingsList1;
+                    psplSrchPostingsList1 = NULL;
+                }
+                else {
+                    
+                    /* ADJ the two search postings list structures */
+                    if ( (iError = iSrchPostingMergeSrchPostingsListsADJ(psplSrchPostingsList1, psplSrchPostingsList2, iTermDistanceADJ, 
+                            uiSrchPostingBooleanOperationID, &psplSrchPostingsList2)) != SRCH_NoError ) {
+                        iUtlLogError(UTL_LOG_CONTEXT, "Failed to ADJ merge postings list, srch error: %d.", iError);
+                        return (iError);
+                    }
+                
+                    /* Reset the term distance to 1 for the next term */
+                    iTermDistanceADJ = 1;
+            
+                    /* NULL out the first search postings list structure */
+                    psplSrchPostingsList1 = NULL;
+                }
+            }
+
+            /* NEAR */
+            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID ) {
+
+                /* NEAR the two search postings list structures */
+            
+                /* Here we need to skip over stop terms in the phrase, but we 
+                ** still take account of them in the term distance.
+                */
+                if ( (psplSrchPostingsList2 != NULL) && (psplSrchPostingsList2->uiTermType == SPI_TERM_TYPE_STOP) ) {
+                    
+                    /* Increment the term distance */
+                    iTermDistanceNEAR++;
+                    
+                    /* Free the stop term search postings list structure */
+                    iSrchPostingFreeSrchPostingsList(psplSrchPostingsList2);
+                    psplSrchPostingsList2 = NULL;
+                    
+                    /* Hand the first search postings list structure pointer to the second search postings list structure 
+                    ** structure pointer, and null out the second posting structure pointer
+                    */
+                    psplSrchPostingsList2 = psplSrchPostingsList1;
+                    psplSrchPostingsList1 = NULL;
+                }
+                else {
+                    
+                    /* Set the term distance, default to SRCH_SEARCH_TERM_NEAR_DISTANCE_DEFAULT */
+                    int    iTermDistance = (psptcSrchParserTermCluster->iTermDistance != 0) ? psptcSrchParserTermCluster->iTermDistance : SRCH_SEARCH_TERM_NEAR_DISTANCE_DEFAULT;
+                    
+                    /* Adjust the term distance */
+                    iTermDistance += (iTermDistance > 0) ? iTermDistanceNEAR : -iTermDistanceNEAR;
+
+                    /* NEAR the two search postings list structures */
+                    if ( (iError = iSrchPostingMergeSrchPostingsListsNEAR(psplSrchPostingsList1, psplSrchPostingsList2, iTermDistance, 
+                            psptcSrchParserTermCluster->bDistanceOrderMatters, uiSrchPostingBooleanOperationID, &psplSrchPostingsList2)) != SRCH_NoError ) {
+                        iUtlLogError(UTL_LOG_CONTEXT, "Failed to NEAR merge postings list, srch error: %d.", iError);
+                        return (iError);
+                    }
+
+                
+                    /* Reset the term distance to 0 for the next term */
+                    iTermDistanceNEAR = 0;
+            
+                    /* NULL out the first search postings list structure */
+                    psplSrchPostingsList1 = NULL;
+                }
+            }
+
+            /* Ouch - invalid operator tag ?? */
+            else {
+/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchSearchGetPostingsListFromParserTermCluster - psptcSrchParserTermCluster->uiOperatorID [%u].", psptcSrchParserTermCluster->uiOperatorID); */
+                ASSERT(false);
+            }
+        }
+    }
+
+
+    /* OR the collected search postings list structures */
+    if ( ppsplSrchPostingsListsOR != NULL ) {
+
+        iError = iSrchPostingMergeSrchPostingsListsMultiOR(ppsplSrchPostingsListsOR, uiSrchPostingsListsORLength, 
+                uiSrchPostingBooleanOperationID, &psplSrchPostingsList2);
+
+        s_free(ppsplSrchPostingsListsOR);
+        
+        if ( iError != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to OR merge postings list, srch error: %d.", iError);
+            return (iError);
+        }
+    }
+
+
+    ASSERT(psplSrchPostingsList1 == NULL);
+
+
+    /* Set the return pointer */
+    *ppsplSrchPostingsList = psplSrchPostingsList2;
+
+
+    return (SRCH_NoError);
+
+}
+
+#endif    /* !defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS)
+
+/*
+
+    Function:   iSrchSearchGetCursorFromParserTermCluster()
+
+    Purpose:    This function searches for the term in a term cluster
+                and combines the results into a search cursor, passing
+                it back via the search cursor structure return pointer.
+
+                This mirrors iSrchSearchGetPostingsListFromParserTermCluster()
+                except that the terms are combined lazily, the documents
+                being matched when the search cursor is drained. The entries
+                of an OR of more than two are combined with a single multi 
+                OR search cursor rather than a chain of OR search cursors.
+
+                If no document were retrieved from this search,
+                the search cursor structure return pointer
+                will be NULL.
+
+    Parameters: pssSrchSearch                   search structure
+                psiSrchIndex                    index structure
+                uiLanguageID                    language ID
+                psptcSrchParserTermCluster      search parser term cluster to process
+                psspSrchSearchPlan              search plan for the search parser term cluster (optional)
+                bTermPositions                  set to true if the term positions are needed
+                ppscSrchCursor                  return pointer for the search cursor structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchGetCursorFromParserTermCluster
+(
+    struct srchSearch *pssSrchSearch,
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiLanguageID,
+    struct srchParserTermCluster *psptcSrchParserTermCluster,
+    struct srchSearchPlan *psspSrchSearchPlan,
+    boolean bTermPositions,
+    struct srchCursor **ppscSrchCursor
+)
+{
+
+    int                         iError = SRCH_NoError;
+    unsigned int                uiSrchParserBooleanOperationID = SRCH_PARSER_INVALID_ID;
+    unsigned int                uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_INVALID_ID;
+    unsigned int                uiI = 0;
+    unsigned int                uiTermIndex = 0;
+    struct srchCursor           *pscSrchCursor1 = NULL;
+    struct srchCursor           *pscSrchCursor2 = NULL;
+    struct srchCursor           **ppscSrchCursorsOR = NULL;
+    unsigned int                uiSrchCursorsORLength = 0;
+
+    /* ADJ Term distance must be pre-set to 1 */
+    int                         iTermDistanceADJ = 1;
+
+    /* NEAR Term distance must be pre-set to 0 */
+    int                         iTermDistanceNEAR = 0;
+
+    boolean                     bSearchCompletionLogged = false;
+
+
+    ASSERT(pssSrchSearch != NULL);
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(uiLanguageID >= 0);
+    ASSERT(psptcSrchParserTermCluster != NULL);
+    ASSERT(ppscSrchCursor != NULL);
+
+
+    /* Pre-set the return parameter */
+    *ppscSrchCursor = NULL;
+
+
+    /* Get the parser boolean operation ID */
+    if ( (iError = iSrchParserGetModifierID(pssSrchSearch->pvSrchParser, SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_ID, &uiSrchParserBooleanOperationID)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the parser boolean operation ID, srch error: %d.", iError);
+        return (iError);
+    }
+
+    /* Set the posting boolean operation ID from the parser boolean operation ID */
+    if ( uiSrchParserBooleanOperationID == SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_STRICT_ID ) {
+        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID;
+    }
+    else if ( uiSrchParserBooleanOperationID == SRCH_PARSER_MODIFIER_BOOLEAN_OPERATION_RELAXED_ID ) {
+        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID;
+    }
+    else {
+        uiSrchPostingBooleanOperationID = SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID;
+    }
+
+
+    /* Allocate the search cursor structures list for OR, the search cursors are collected 
+    ** and combined all at once rather than being combined one at a time
+    */
+    if ( (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_OR_ID) && (psptcSrchParserTermCluster->uiTermsLength > 2) ) {
+        if ( (ppscSrchCursorsOR = (struct srchCursor **)s_malloc((size_t)(sizeof(struct srchCursor *) * psptcSrchParserTermCluster->uiTermsLength))) == NULL ) {
+            return (SRCH_MemError);
+        }
+    }
+
+
+    /* Loop over each entry */
+    for ( uiI = 0; uiI < psptcSrchParserTermCluster->uiTermsLength; uiI++ ) {
+
+        unsigned int    uiCursorTypeID = SRCH_CURSOR_TYPE_INVALID_ID;
+        int             iTermDistance = 0;
+
+
+        /* Get the index of the term to process, the search plan may have reordered the terms */
+        uiTermIndex = (psspSrchSearchPlan != NULL) ? psspSrchSearchPlan->puiTermIndices[uiI] : uiI;
+
+
+        /* We can skip this term list entry if the (non-stop) term we just searched for has no occurences,
+        ** we are using strict boolean or the term is required, and the operator boils down to an
+        ** intersection of some sort
+        */
+        if ( (pscSrchCursor2 != NULL) && (pscSrchCursor2->uiTermType != SPI_TERM_TYPE_STOP) && (pscSrchCursor2->uiDocumentID == SRCH_CURSOR_DOCUMENT_ID_NONE) &&
+                ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_STRICT_ID) ||
+                    ((uiSrchPostingBooleanOperationID == SRCH_POSTING_BOOLEAN_OPERATION_RELAXED_ID) && (pscSrchCursor2->bRequired == true))) &&
+                ((psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NOT_ID) ||
+                (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID)) ) {
+
+            /* Log if we have not logged already */
+            if ( bSearchCompletionLogged == false ) {
+                iSrchReportAppend(pssSrchSearch->pvSrchReport, "%s The search was completed early due to boolean constraints\n", REP_SEARCH_WARNING);
+                bSearchCompletionLogged = true;
+            }
+
+            /* Skip to the next term list entry */
+            continue;
+        }
+
+
+        /* Hand over the second search cursor structure pointer to the first search cursor structure pointer if it is populated */
+        if ( pscSrchCursor2 != NULL ) {
+            ASSERT(pscSrchCursor1 == NULL);
+            pscSrchCursor1 = pscSrchCursor2;
+            pscSrchCursor2 = NULL;
+        }
+
+
+        /* Its a term!! */
+        if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiTermIndex] == SRCH_PARSER_TERM_TYPE_TERM_ID ) {
+
+            /* Start document ID, the end document ID is not known until the first search cursor is drained */
+            unsigned int                uiStartDocumentID = 0;
+            struct srchPostingsList     *psplSrchPostingsList = NULL;
+
+            // Set the start document ID if there is a search cursor and the operator is an 'and', a 'not', an 'adj' or a 'near' */
+            if ( (pscSrchCursor1 != NULL) && (pscSrchCursor1->uiDocumentID != SRCH_CURSOR_DOCUMENT_ID_NONE) &&
+                    ((psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_AND_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NOT_ID) ||
+                    (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID) || (psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID)) ) {
+                uiStartDocumentID = pscSrchCursor1->uiDocumentID;
+            }
+
+
+            /* Get the search postings list structure for this term, the search cursor can step through the 
+            ** document containers if the term positions are not needed and the term is being ANDed or NOTed,
+            ** and it decodes the postings on demand
+            */
+            if ( (iError = iSrchSearchGetPostingsListFromParserTerm(pssSrchSearch, psiSrchIndex, uiLanguageID,
+                    (struct srchParserTerm *)psptcSrchParserTermCluster->ppvTerms[uiTermIndex], uiStartDocumentID, 0, 
+                    SRCH_SEARCH_TERM_CLUSTER_NEEDS_TERM_POSITIONS(bTermPositions, psptcSrchParserTermCluster->uiOperatorID), 
+                    SRCH_SEARCH_TERM_CLUSTER_USES_DOCUMENT_CONTAINERS(bTermPositions, psptcSrchParserTermCluster->uiOperatorID, uiI),
+                    true, &psplSrchPostingsList)) != SRCH_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the postings list for a term, index: '%s', srch error: %d.",
+                        psiSrchIndex->pucIndexName, iError);
+                goto bailFromiSrchSearchGetCursorFromParserTermCluster;
+            }
+
+            /* And wrap it in a search cursor */
+            if ( (iError = iSrchCursorCreateFromSrchPostingsList(psplSrchPostingsList, &pscSrchCursor2)) != SRCH_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a search cursor for a term, index: '%s', srch error: %d.",
+                        psiSrchIndex->pucIndexName, iError);
+                iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
+                goto bailFromiSrchSearchGetCursorFromParserTermCluster;
+            }
+        }
+
+        /* Its a term cluster */
+        else if ( psptcSrchParserTermCluster->puiTermTypeIDs[uiTermIndex] == SRCH_PARSER_TERM_TYPE_TERM_CLUSTER_ID ) {
+
+            /* Call ourselves */
+            if ( (iError = iSrchSearchGetCursorFromParserTermCluster(pssSrchSearch, psiSrchIndex, uiLanguageID,
+                    (struct srchParserTermCluster *)psptcSrchParserTermCluster->ppvTerms[uiTermIndex], 
+                    (psspSrchSearchPlan != NULL) ? psspSrchSearchPlan->ppsspSrchSearchPlans[uiTermIndex] : NULL,
+                    SRCH_SEARCH_TERM_CLUSTER_NEEDS_TERM_POSITIONS(bTermPositions, psptcSrchParserTermCluster->uiOperatorID), &pscSrchCursor2)) != SRCH_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the search cursor for a term cluster, index: '%s', srch error: %d.",
+                        psiSrchIndex->pucIndexName, iError);
+                goto bailFromiSrchSearchGetCursorFromParserTermCluster;
+            }
+        }
+
+        /* Ouch - invalid term type ?? */
+        else {
+            ASSERT(false);
+        }
+
+
+        /* Collect the search cursor structure if we are combining the OR all at once */
+        if ( ppscSrchCursorsOR != NULL ) {
+            ASSERT(pscSrchCursor1 == NULL);
+            ppscSrchCursorsOR[uiSrchCursorsORLength++] = pscSrchCursor2;
+            pscSrchCursor2 = NULL;
+            continue;
+        }
+
+
+        /* Nothing to combine if the first search cursor structure is not defined */
+        if ( pscSrchCursor1 == NULL ) {
+            continue;
+        }
+
+
+        /* Set the cursor type from the operator */
+        switch ( psptcSrchParserTermCluster->uiOperatorID ) {
+
+            case SRCH_PARSER_OPERATOR_AND_ID:
+                uiCursorTypeID = SRCH_CURSOR_TYPE_AND_ID;
+                break;
+
+            case SRCH_PARSER_OPERATOR_OR_ID:
+                uiCursorTypeID = SRCH_CURSOR_TYPE_OR_ID;
+                break;
+
+            case SRCH_PARSER_OPERATOR_IOR_ID:
+                uiCursorTypeID = SRCH_CURSOR_TYPE_IOR_ID;
+                break;
+
+            case SRCH_PARSER_OPERATOR_XOR_ID:
+                uiCursorTypeID = SRCH_CURSOR_TYPE_XOR_ID;
+                break;
+
+            case SRCH_PARSER_OPERATOR_NOT_ID:
+                uiCursorTypeID = SRCH_CURSOR_TYPE_NOT_ID;
+                break;
+
+            case SRCH_PARSER_OPERATOR_ADJ_ID:
+                uiCursorTypeID = SRCH_CURSOR_TYPE_ADJ_ID;
+                break;
+
+            case SRCH_PARSER_OPERATOR_NEAR_ID:
+                uiCursorTypeID = SRCH_CURSOR_TYPE_NEAR_ID;
+                break;
+
+            /* Ouch - invalid operator tag ?? */
+            default:
+                ASSERT(false);
+                break;
+        }
+
 
-            /* XOR */
-            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_XOR_ID ) {
+        /* Here we need to skip over stop terms in the phrase, but we
+        ** still take account of them in the term distance.
+        */
+        if ( ((uiCursorTypeID == SRCH_CURSOR_TYPE_ADJ_ID) || (uiCursorTypeID == SRCH_CURSOR_TYPE_NEAR_ID)) &&
+                (pscSrchCursor2 != NULL) && (pscSrchCursor2->uiTermType == SPI_TERM_TYPE_STOP) ) {
 
-                /* XOR the two search postings list structures */
-                if ( (iError = iSrchPostingMergeSrchPostingsListsXOR(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID, 
-                        &psplSrchPostingsList2)) != SRCH_NoError ) {
-                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to XOR merge postings list, srch error: %d.", iError);
-                    return (iError);
-                }
-                
-                /* NULL out the first search postings list structure */
-                psplSrchPostingsList1 = NULL;
+            /* Increment the term distance */
+            if ( uiCursorTypeID == SRCH_CURSOR_TYPE_ADJ_ID ) {
+                iTermDistanceADJ++;
+            }
+            else {
+                iTermDistanceNEAR++;
             }
 
-            /* NOT */
-            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NOT_ID ) {
+            /* Free the stop term search cursor structure */
+            iSrchCursorFree(pscSrchCursor2);
+            pscSrchCursor2 = NULL;
 
-                /* NOT the two search postings list structures */
-                if ( (iError = iSrchPostingMergeSrchPostingsListsNOT(psplSrchPostingsList1, psplSrchPostingsList2, uiSrchPostingBooleanOperationID, 
-                        &psplSrchPostingsList2)) != SRCH_NoError ) {
-                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to NOT merge postings list, srch error: %d.", iError);
-                    return (iError);
-                }
-                
-                /* NULL out the first search postings list structure */
-                psplSrchPostingsList1 = NULL;
-            }
+            /* Hand the first search cursor structure pointer to the second search cursor structure
+            ** pointer, and null out the first search cursor structure pointer
+            */
+            pscSrchCursor2 = pscSrchCursor1;
+            pscSrchCursor1 = NULL;
 
-            /* ADJ */
-            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_ADJ_ID ) {
-            
-                /* ADJ the two search postings list structures */
-            
-                /* Here we need to skip over stop terms in the phrase, but we 
-                ** still take account of them in the term distance.
-                */
-                if ( (psplSrchPostingsList2 != NULL) && (psplSrchPostingsList2->uiTermType == SPI_TERM_TYPE_STOP) ) {
-                    
-                    /* Increment the term distance */
-                    iTermDistanceADJ++;
-                    
-                    /* Free the stop term search postings list structure */
-                    iSrchPostingFreeSrchPostingsList(psplSrchPostingsList2);
-                    psplSrchPostingsList2 = NULL;
-                    
-                    /* Hand the first search postings list structure pointer to the second search postings list structure 
-                    ** structure pointer, and null out the second posting structure pointer
-                    */
-                    psplSrchPostingsList2 = psplSrchPostingsList1;
-                    psplSrchPostingsList1 = NULL;
-                }
-                else {
-                    
-                    /* ADJ the two search postings list structures */
-                    if ( (iError = iSrchPostingMergeSrchPostingsListsADJ(psplSrchPostingsList1, psplSrchPostingsList2, iTermDistanceADJ, 
-                            uiSrchPostingBooleanOperationID, &psplSrchPostingsList2)) != SRCH_NoError ) {
-                        iUtlLogError(UTL_LOG_CONTEXT, "Failed to ADJ merge postings list, srch error: %d.", iError);
-                        return (iError);
-                    }
-                
-                    /* Reset the term distance to 1 for the next term */
-                    iTermDistanceADJ = 1;
-            
-                    /* NULL out the first search postings list structure */
-                    psplSrchPostingsList1 = NULL;
-                }
-            }
+            continue;
+        }
 
-            /* NEAR */
-            else if ( psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_NEAR_ID ) {
 
-                /* NEAR the two search postings list structures */
-            
-                /* Here we need to skip over stop terms in the phrase, but we 
-                ** still take account of them in the term distance.
-                */
-                if ( (psplSrchPostingsList2 != NULL) && (psplSrchPostingsList2->uiTermType == SPI_TERM_TYPE_STOP) ) {
-                    
-                    /* Increment the term distance */
-                    iTermDistanceNEAR++;
-                    
-                    /* Free the stop term search postings list structure */
-                    iSrchPostingFreeSrchPostingsList(psplSrchPostingsList2);
-                    psplSrchPostingsList2 = NULL;
-                    
-                    /* Hand the first search postings list structure pointer to the second search postings list structure 
-                    ** structure pointer, and null out the second posting structure pointer
-                    */
-                    psplSrchPostingsList2 = psplSrchPostingsList1;
-                    psplSrchPostingsList1 = NULL;
+        /* Set the term distance */
+        if ( uiCursorTypeID == SRCH_CURSOR_TYPE_ADJ_ID ) {
+            iTermDistance = iTermDistanceADJ;
+        }
+        else if ( uiCursorTypeID == SRCH_CURSOR_TYPE_NEAR_ID ) {
+
+            /* Default to SRCH_SEARCH_TERM_NEAR_DISTANCE_DEFAULT */
+            iTermDistance = (psptcSrchParserTermCluster->iTermDistance != 0) ? psptcSrchParserTermCluster->iTermDistance : SRCH_SEARCH_TERM_NEAR_DISTANCE_DEFAULT;
+
+            /* Adjust the term distance */
+            iTermDistance += (iTermDistance > 0) ? iTermDistanceNEAR : -iTermDistanceNEAR;
+        }
+
+
+        /* Combine the two search cursor structures, this takes over both of them */
+        iError = iSrchCursorCreateFromSrchCursors(uiCursorTypeID, pscSrchCursor1, pscSrchCursor2, iTermDistance,
+                psptcSrchParserTermCluster->bDistanceOrderMatters, uiSrchPostingBooleanOperationID, &pscSrchCursor2);
+
+        /* NULL out the first search cursor structure */
+        pscSrchCursor1 = NULL;
+
+        if ( iError != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to combine search cursors, srch error: %d.", iError);
+            pscSrchCursor2 = NULL;
+            goto bailFromiSrchSearchGetCursorFromParserTermCluster;
+        }
+
+        /* Reset the term distances for the next term */
+        iTermDistanceADJ = 1;
+        iTermDistanceNEAR = 0;
+    }
+
+
+    ASSERT(pscSrchCursor1 == NULL);
+
+
+    /* Combine the collected search cursor structures, this takes over all of them */
+    if ( ppscSrchCursorsOR != NULL ) {
+
+        ASSERT(pscSrchCursor2 == NULL);
+
+        iError = iSrchCursorCreateMultiORFromSrchCursors(ppscSrchCursorsOR, uiSrchCursorsORLength, 
+                uiSrchPostingBooleanOperationID, &pscSrchCursor2);
+
+        uiSrchCursorsORLength = 0;
+
+        if ( iError != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to combine search cursors, srch error: %d.", iError);
+            pscSrchCursor2 = NULL;
+            goto bailFromiSrchSearchGetCursorFromParserTermCluster;
+        }
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchSearchGetCursorFromParserTermCluster:
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointer */
+        *ppscSrchCursor = pscSrchCursor2;
+    }
+    else {
+
+        /* Free the search cursor structures */
+        iSrchCursorFree(pscSrchCursor1);
+        pscSrchCursor1 = NULL;
+
+        iSrchCursorFree(pscSrchCursor2);
+        pscSrchCursor2 = NULL;
+    }
+
+    /* Free the collected search cursor structures */
+    while ( uiSrchCursorsORLength > 0 ) {
+        iSrchCursorFree(ppscSrchCursorsOR[--uiSrchCursorsORLength]);
+    }
+    s_free(ppscSrchCursorsOR);
+
+
+    return (iError);
+
+}
+
+#endif    /* defined(SRCH_SEARCH_ENABLE_POSTING_CURSORS) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if defined(SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND)
+
+/*
+
+    Function:   iSrchSearchGetTopPostingsListFromParserTermCluster()
+
+    Purpose:    This function searches for the terms in a term cluster of
+                ORed terms and returns a search postings list containing 
+                only the top documents, one search posting per document 
+                carrying the document weight, passing it back via the 
+                search postings list structure return pointer.
+
+                The terms are combined with a WAND search cursor, and a 
+                heap of the top documents is kept as the search cursor is 
+                drained. Once the heap is full, the weight of the lowest 
+                document in the heap sets the minimum weight a document 
+                needs to get in, allowing the search cursor to skip over
+                documents which cannot make it. That minimum weight is 
+                adjusted for the document weight normalization since the 
+                ranking is done on normalized document weights.
+
+                If the search cursor passed over any documents, the total 
+                results are estimated from the document counts of the terms, 
+                assuming they are independent, otherwise they are the exact 
+                number of documents the search cursor matched.
+
+                If no document were retrieved from this search,
+                the search postings list structure return pointer
+                will be NULL.
+
+    Parameters: pssSrchSearch                   search structure
+                psiSrchIndex                    index structure
+                uiLanguageID                    language ID
+                psptcSrchParserTermCluster      search parser term cluster to process
+                uiTopDocumentsLength            number of top documents to return
+                ppsplSrchPostingsList           return pointer for the search postings list structure
+                puiTopDocumentsTotalResults     return pointer for the total results
+                pbTopDocumentsTotalResultsEstimated
+                                                return pointer for the total results estimated flag
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchGetTopPostingsListFromParserTermCluster
+(
+    struct srchSearch *pssSrchSearch,
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiLanguageID,
+    struct srchParserTermCluster *psptcSrchParserTermCluster,
+    unsigned int uiTopDocumentsLength,
+    struct srchPostingsList **ppsplSrchPostingsList,
+    unsigned int *puiTopDocumentsTotalResults,
+    boolean *pbTopDocumentsTotalResultsEstimated
+)
+{
+
+    int                             iError = SRCH_NoError;
+    struct srchCursor               **ppscSrchCursors = NULL;
+    struct srchCursor               *pscSrchCursor = NULL;
+    struct srchSearchTopDocument    *psstdSrchSearchTopDocuments = NULL;
+    unsigned int                    uiSrchSearchTopDocumentsLength = 0;
+    struct srchPosting              *pspSrchPostings = NULL;
+    struct srchPostingsList         *psplSrchPostingsList = NULL;
+    unsigned int                    uiI = 0;
+    unsigned int                    uiMaxDocumentCount = 0;
+    double                          dMissingProbability = 1.0;
+    unsigned int                    uiDocumentsCount = 0;
+    boolean                         bImpacts = false;
+
+
+    ASSERT(pssSrchSearch != NULL);
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(uiLanguageID >= 0);
+    ASSERT(psptcSrchParserTermCluster != NULL);
+    ASSERT(psptcSrchParserTermCluster->uiOperatorID == SRCH_PARSER_OPERATOR_OR_ID);
+    ASSERT(uiTopDocumentsLength > 0);
+    ASSERT(ppsplSrchPostingsList != NULL);
+    ASSERT(puiTopDocumentsTotalResults != NULL);
+    ASSERT(pbTopDocumentsTotalResultsEstimated != NULL);
+
+
+    /* Pre-set the return parameters */
+    *ppsplSrchPostingsList = NULL;
+    *puiTopDocumentsTotalResults = 0;
+    *pbTopDocumentsTotalResultsEstimated = false;
+
+
+    /* The weights are already normalized if the index blocks carry impacts, so the block maximums are exact bounds */
+    bImpacts = (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_IMPACTS) ? true : false;
+
+
+    /* Allocate the search cursors */
+    if ( (ppscSrchCursors = (struct srchCursor **)s_malloc((size_t)(psptcSrchParserTermCluster->uiTermsLength * sizeof(struct srchCursor *)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+    }
+
+
+    /* Get a search cursor for each term, in term order */
+    for ( uiI = 0; uiI < psptcSrchParserTermCluster->uiTermsLength; uiI++ ) {
+
+        struct srchPostingsList     *psplSrchPostingsListTerm = NULL;
+
+        ASSERT(psptcSrchParserTermCluster->puiTermTypeIDs[uiI] == SRCH_PARSER_TERM_TYPE_TERM_ID);
+
+        /* Get the search postings list structure for this term, the search cursor decodes the postings on demand */
+        if ( (iError = iSrchSearchGetPostingsListFromParserTerm(pssSrchSearch, psiSrchIndex, uiLanguageID,
+                (struct srchParserTerm *)psptcSrchParserTermCluster->ppvTerms[uiI], 0, 0, SRCH_SEARCH_TERM_POSITIONS_DEFAULT, false, true, &psplSrchPostingsListTerm)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the postings list for a term, index: '%s', srch error: %d.",
+                    psiSrchIndex->pucIndexName, iError);
+            goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+        }
+
+        /* Accumulate the document counts for the estimated total results, terms
+        ** with no search postings list are skipped just as they are when ORing,
+        ** they get a NULL cursor which the WAND cursor drops
+        */
+        if ( (psplSrchPostingsListTerm != NULL) && (psplSrchPostingsListTerm->uiDocumentCount > 0) && (psiSrchIndex->uiDocumentCount > 0) ) {
+            uiMaxDocumentCount = UTL_MACROS_MAX(uiMaxDocumentCount, psplSrchPostingsListTerm->uiDocumentCount);
+            dMissingProbability *= 1.0 - UTL_MACROS_MIN(1.0, (double)psplSrchPostingsListTerm->uiDocumentCount / psiSrchIndex->uiDocumentCount);
+        }
+
+        /* And wrap it in a search cursor */
+        if ( (iError = iSrchCursorCreateFromSrchPostingsList(psplSrchPostingsListTerm, &ppscSrchCursors[uiI])) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a search cursor for a term, index: '%s', srch error: %d.",
+                    psiSrchIndex->pucIndexName, iError);
+            iSrchPostingFreeSrchPostingsList(psplSrchPostingsListTerm);
+            goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+        }
+    }
+
+
+    /* Combine the search cursors, this takes over all of them */
+    if ( (iError = iSrchCursorCreateWANDFromSrchCursors(ppscSrchCursors, psptcSrchParserTermCluster->uiTermsLength, &pscSrchCursor)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to combine search cursors, srch error: %d.", iError);
+        goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+    }
+
+
+    /* Allocate the top documents heap */
+    if ( (psstdSrchSearchTopDocuments = (struct srchSearchTopDocument *)s_malloc((size_t)(uiTopDocumentsLength * sizeof(struct srchSearchTopDocument)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+    }
+
+
+    /* Drain the search cursor into the top documents heap, a min-heap on the normalized document weight */
+    while ( pscSrchCursor->uiDocumentID != SRCH_CURSOR_DOCUMENT_ID_NONE ) {
+
+        float                           fWeight = 0;
+        float                           fNormalizedWeight = 0;
+        unsigned int                    uiDocumentTermCount = 0;
+        struct srchSearchTopDocument    *psstdSrchSearchTopDocumentsPtr = NULL;
+        unsigned int                    uiJ = 0;
+        unsigned int                    uiK = 0;
+
+
+        /* Count the document */
+        uiDocumentsCount++;
+
+        /* Get the weight of the current document */
+        if ( (iError = iSrchCursorGetWeight(pscSrchCursor, &fWeight)) != SRCH_NoError ) {
+            goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+        }
+
+        /* Get the document term count, we dont need it if the impacts already normalized the weight */
+        if ( (bImpacts == false) && (iError = iSrchDocumentGetDocumentInfo(psiSrchIndex, pscSrchCursor->uiDocumentID, NULL, NULL, NULL, 
+                &uiDocumentTermCount, NULL, NULL, NULL, NULL, 0, false, false, false)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the document information for document ID: %u, index: '%s', srch error: %d.", 
+                    pscSrchCursor->uiDocumentID, psiSrchIndex->pucIndexName, iError);
+            goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+        }
+
+        /* Normalize the weight the same way iSrchSearchGetShortResultsFromRawResults() does */
+        fNormalizedWeight = fWeight;
+
+        if ( uiDocumentTermCount > 0 ) {
+#if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_RAW)
+            fNormalizedWeight /= uiDocumentTermCount;
+#endif /* defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_RAW) */
+
+#if defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG)
+            fNormalizedWeight /= log(uiDocumentTermCount + 1);
+#endif /* defined(SRCH_SEARCH_ENABLE_DOCUMENT_WEIGHT_NORMALIZATION_LOG) */
+        }
+
+
+        /* Add the document to the heap if the heap is not full, sifting it up */
+        if ( uiSrchSearchTopDocumentsLength < uiTopDocumentsLength ) {
+
+            for ( uiJ = uiSrchSearchTopDocumentsLength; uiJ > 0; uiJ = uiK ) {
+                uiK = (uiJ - 1) / 2;
+                if ( psstdSrchSearchTopDocuments[uiK].fNormalizedWeight <= fNormalizedWeight ) {
+                    break;
                 }
-                else {
-                    
-                    /* Set the term distance, default to SRCH_SEARCH_TERM_NEAR_DISTANCE_DEFAULT */
-                    int    iTermDistance = (psptcSrchParserTermCluster->iTermDistance != 0) ? psptcSrchParserTermCluster->iTermDistance : SRCH_SEARCH_TERM_NEAR_DISTANCE_DEFAULT;
-                    
-                    /* Adjust the term distance */
-                    iTermDistance += (iTermDistance > 0) ? iTermDistanceNEAR : -iTermDistanceNEAR;
+                psstdSrchSearchTopDocuments[uiJ] = psstdSrchSearchTopDocuments[uiK];
+            }
 
-                    /* NEAR the two search postings list structures */
-                    if ( (iError = iSrchPostingMergeSrchPostingsListsNEAR(psplSrchPostingsList1, psplSrchPostingsList2, iTermDistance, 
-                            psptcSrchParserTermCluster->bDistanceOrderMatters, uiSrchPostingBooleanOperationID, &psplSrchPostingsList2)) != SRCH_NoError ) {
-                        iUtlLogError(UTL_LOG_CONTEXT, "Failed to NEAR merge postings list, srch error: %d.", iError);
-                        return (iError);
-                    }
+            psstdSrchSearchTopDocumentsPtr = psstdSrchSearchTopDocuments + uiJ;
+            uiSrchSearchTopDocumentsLength++;
+        }
+
+        /* Replace the lowest document in the heap if this document is better, sifting it down */
+        else if ( fNormalizedWeight > psstdSrchSearchTopDocuments[0].fNormalizedWeight ) {
 
-                
-                    /* Reset the term distance to 0 for the next term */
-                    iTermDistanceNEAR = 0;
-            
-                    /* NULL out the first search postings list structure */
-                    psplSrchPostingsList1 = NULL;
+            for ( uiJ = 0; (uiK = (uiJ * 2) + 1) < uiSrchSearchTopDocumentsLength; uiJ = uiK ) {
+                if ( ((uiK + 1) < uiSrchSearchTopDocumentsLength) && 
+                        (psstdSrchSearchTopDocuments[uiK + 1].fNormalizedWeight < psstdSrchSearchTopDocuments[uiK].fNormalizedWeight) ) {
+                    uiK++;
+                }
+                if ( psstdSrchSearchTopDocuments[uiK].fNormalizedWeight >= fNormalizedWeight ) {
+                    break;
                 }
+                psstdSrchSearchTopDocuments[uiJ] = psstdSrchSearchTopDocuments[uiK];
             }
 
-            /* Ouch - invalid operator tag ?? */
-            else {
-/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchSearchGetPostingsListFromParserTermCluster - psptcSrchParserTermCluster->uiOperatorID [%u].", psptcSrchParserTermCluster->uiOperatorID); */
-                ASSERT(false);
+            psstdSrchSearchTopDocumentsPtr = psstdSrchSearchTopDocuments + uiJ;
+        }
+
+        /* Set the document in the heap */
+        if ( psstdSrchSearchTopDocumentsPtr != NULL ) {
+            psstdSrchSearchTopDocumentsPtr->uiDocumentID = pscSrchCursor->uiDocumentID;
+            psstdSrchSearchTopDocumentsPtr->fWeight = fWeight;
+            psstdSrchSearchTopDocumentsPtr->fNormalizedWeight = fNormalizedWeight;
+        }
+
+
+        /* Raise the minimum weight once the heap is full, a document can only get into the heap if its 
+        ** normalized weight exceeds that of the lowest document, which it cannot do unless its raw weight
+        ** exceeds that normalized weight divided by the normalization bound, from here on documents can get skipped
+        */
+        if ( uiSrchSearchTopDocumentsLength == uiTopDocumentsLength ) {
+            if ( (iError = iSrchCursorSetMinimumWeight(pscSrchCursor, (psstdSrchSearchTopDocuments[0].fNormalizedWeight / 
+                    ((bImpacts == true) ? 1.0 : SRCH_SEARCH_BLOCK_MAX_WAND_NORMALIZATION_BOUND)) * SRCH_SEARCH_BLOCK_MAX_WAND_SLACK)) != SRCH_NoError ) {
+                goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
             }
         }
+
+
+        /* Move to the next document */
+        if ( (iError = iSrchCursorNextDocument(pscSrchCursor)) != SRCH_NoError ) {
+            goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+        }
     }
 
 
-    ASSERT(psplSrchPostingsList1 == NULL);
+    /* The total results are the documents matched, unless the search cursor passed over any, in which case they are estimated */
+    *puiTopDocumentsTotalResults = uiDocumentsCount;
 
+    if ( pscSrchCursor->bSkippedDocuments == true ) {
+        *puiTopDocumentsTotalResults = UTL_MACROS_MAX((unsigned int)(psiSrchIndex->uiDocumentCount * (1.0 - dMissingProbability)), uiMaxDocumentCount);
+        *puiTopDocumentsTotalResults = UTL_MACROS_MAX(*puiTopDocumentsTotalResults, uiDocumentsCount);
+        *pbTopDocumentsTotalResultsEstimated = true;
+    }
 
-    /* Set the return pointer */
-    *ppsplSrchPostingsList = psplSrchPostingsList2;
+
+    /* Nothing to return if there were no documents */
+    if ( uiSrchSearchTopDocumentsLength == 0 ) {
+        goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+    }
 
 
-    return (SRCH_NoError);
+    /* Sort the top documents by document ID, search postings lists are in document ID order */
+    s_qsort(psstdSrchSearchTopDocuments, uiSrchSearchTopDocumentsLength, sizeof(struct srchSearchTopDocument), 
+            (int (*)(const void *, const void *))iSrchSearchCompareTopDocumentByDocumentIDAsc);
+
+
+    /* Allocate the search postings */
+    if ( (pspSrchPostings = (struct srchPosting *)s_malloc((size_t)(uiSrchSearchTopDocumentsLength * sizeof(struct srchPosting)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+    }
+
+    /* Populate the search postings, one per document */
+    for ( uiI = 0; uiI < uiSrchSearchTopDocumentsLength; uiI++ ) {
+        pspSrchPostings[uiI].uiDocumentID = psstdSrchSearchTopDocuments[uiI].uiDocumentID;
+        pspSrchPostings[uiI].fWeight = psstdSrchSearchTopDocuments[uiI].fWeight;
+    }
+
+    /* Create the search postings list, this takes over the search postings */
+    if ( (iError = iSrchPostingCreateSrchPostingsList(SPI_TERM_TYPE_REGULAR, uiSrchSearchTopDocumentsLength, uiSrchSearchTopDocumentsLength, 
+            false, pspSrchPostings, uiSrchSearchTopDocumentsLength, &psplSrchPostingsList)) != SRCH_NoError ) {
+        goto bailFromiSrchSearchGetTopPostingsListFromParserTermCluster;
+    }
+    pspSrchPostings = NULL;
+
+
+
+    /* Bail label */
+    bailFromiSrchSearchGetTopPostingsListFromParserTermCluster:
+
+
+    /* Free the search cursors, the WAND search cursor will have taken them over */
+    if ( ppscSrchCursors != NULL ) {
+        for ( uiI = 0; uiI < psptcSrchParserTermCluster->uiTermsLength; uiI++ ) {
+            iSrchCursorFree(ppscSrchCursors[uiI]);
+        }
+        s_free(ppscSrchCursors);
+    }
+
+    /* Free the WAND search cursor */
+    iSrchCursorFree(pscSrchCursor);
+    pscSrchCursor = NULL;
+
+    /* Free the top documents heap */
+    s_free(psstdSrchSearchTopDocuments);
+
+    /* Free the search postings */
+    s_free(pspSrchPostings);
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointer */
+        *ppsplSrchPostingsList = psplSrchPostingsList;
+    }
+    else {
+
+        /* Free the search postings list */
+        iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
+        psplSrchPostingsList = NULL;
+
+        *puiTopDocumentsTotalResults = 0;
+        *pbTopDocumentsTotalResultsEstimated = false;
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchCompareTopDocumentByDocumentIDAsc()
+
+    Purpose:    This functions takes a two search top document structures and compares their document IDs.
+                This function is used by the qsort call in iSrchSearchGetTopPostingsListFromParserTermCluster().
+
+    Parameters: psstdSrchSearchTopDocument1     pointer to a search top document structure
+                psstdSrchSearchTopDocument2     pointer to a search top document structure
+
+    Globals:    none
+
+    Returns:    1 if psstdSrchSearchTopDocument1 > psstdSrchSearchTopDocument2, 
+                -1 if psstdSrchSearchTopDocument2 > psstdSrchSearchTopDocument1, 
+                and 0 if psstdSrchSearchTopDocument1 == psstdSrchSearchTopDocument2
+
+*/
+static int iSrchSearchCompareTopDocumentByDocumentIDAsc
+(
+    struct srchSearchTopDocument *psstdSrchSearchTopDocument1,
+    struct srchSearchTopDocument *psstdSrchSearchTopDocument2
+)
+{
+
+    ASSERT(psstdSrchSearchTopDocument1 != NULL);
+    ASSERT(psstdSrchSearchTopDocument2 != NULL);
+
+
+    if ( psstdSrchSearchTopDocument1->uiDocumentID < psstdSrchSearchTopDocument2->uiDocumentID ) {
+        return (-1);
+    }
+    else if ( psstdSrchSearchTopDocument1->uiDocumentID > psstdSrchSearchTopDocument2->uiDocumentID ) {
+        return (1);
+    }
+
+    return (0);
 
 }
 
+#endif    /* defined(SRCH_SEARCH_ENABLE_BLOCK_MAX_WAND) */
+
 
 /*---------------------------------------------------------------------------*/
 
@@ -6779,6 +9004,11 @@ static int iSrchSearchGetPostingsListFromParserTermCluster
                 psptSrchParserTerm      search parser term to search for
                 uiStartDocumentID       start document ID (0 for no limit)
                 uiEndDocumentID         end document ID (0 for no limit)
+                bTermPositions          set to true if the term positions are needed
+                bDocumentContainers     set to true if the document containers can be used instead 
+                                        of the postings, this does not apply to expanded terms
+                bDecodeOnDemand         set to true if the postings can be decoded on demand, this 
+                                        does not apply to expanded terms or to cachable searches
                 ppsplSrchPostingsList   return pointer for the search postings list structure
 
     Globals:    none
@@ -6794,6 +9024,9 @@ static int iSrchSearchGetPostingsListFromParserTerm
     struct srchParserTerm *psptSrchParserTerm,
     unsigned int uiStartDocumentID, 
     unsigned int uiEndDocumentID, 
+    boolean bTermPositions,
+    boolean bDocumentContainers,
+    boolean bDecodeOnDemand,
     struct srchPostingsList **ppsplSrchPostingsList
 )
 {
@@ -6826,6 +9059,13 @@ static int iSrchSearchGetPostingsListFromParserTerm
     unsigned int                uiSrchTermDictInfosLength = 0;
     unsigned int                uiI = 0;
 
+    struct srchSearchTermFetch  *psstfSrchSearchTermFetches = NULL;
+    unsigned int                uiSrchSearchTermFetchesLength = 0;
+    struct srchPostingsList     **ppsplSrchPostingsLists = NULL;
+    struct srchPosting          **ppspSrchPostingsList = NULL;
+    unsigned int                *puiSrchPostingsLengthList = NULL;
+    unsigned int                uiSrchPostingsListLength = 0;
+
     struct srchPostingsList     *psplSrchPostingsList = NULL;
 
 
@@ -6856,7 +9096,10 @@ static int iSrchSearchGetPostingsListFromParserTerm
         goto bailFromiSrchSearchGetPostingsListFromParserTerm;
     }
 
-    /* Check the cache */
+    /* Check the cache, a cached postings list has term positions so it can be used whether 
+    ** they are needed or not, but postings lists without term positions are not saved in the
+    ** cache since they would not be usable by searches which need the term positions
+    */
     if ( uiSrchParserSearchCacheID == SRCH_PARSER_MODIFIER_SEARCH_CACHE_ENABLE_ID ) {
     
         /* This is not a cachable search until we say that it is */
@@ -7605,9 +9848,10 @@ static int iSrchSearchGetPostingsListFromParserTerm
         /* Select the stemmed term if we stemmed and if this is not a literal search */
         pucTermPtr = ((pwcTermStemmed != NULL) && (psptSrchParserTerm->uiFunctionID != SRCH_PARSER_FUNCTION_LITERAL_ID)) ? pucTermStemmed : pucTerm;
 
-        /* Look up the term */
+        /* Look up the term, the postings list needs to be decoded in full if it is going to be saved in the cache */
         if ( (iError = iSrchTermSearchGetSearchPostingsListFromTerm(pssSrchSearch, psiSrchIndex, pucTermPtr, fTermWeight, pucFieldIDBitmap, 
-                (pucFieldIDBitmap != NULL) ? psiSrchIndex->uiFieldIDMaximum : 0, fFrequentTermCoverageThreshold, uiStartDocumentID, uiEndDocumentID, &psplSrchPostingsList)) != SRCH_NoError ) {
+                (pucFieldIDBitmap != NULL) ? psiSrchIndex->uiFieldIDMaximum : 0, fFrequentTermCoverageThreshold, uiStartDocumentID, uiEndDocumentID, 
+                bTermPositions, bDocumentContainers, ((bDecodeOnDemand == true) && (bCachableSearch == false)), &psplSrchPostingsList)) != SRCH_NoError ) {
             goto bailFromiSrchSearchGetPostingsListFromParserTerm;
         }
 
@@ -7673,34 +9917,115 @@ static int iSrchSearchGetPostingsListFromParserTerm
         }
 
 
-        /* Loop through all the terms in the term list */
-        for ( pstdiSrchTermDictInfosPtr = pstdiSrchTermDictInfos, uiI = 0, pvLngStemmer = NULL; uiI < uiSrchTermDictInfosLength; pstdiSrchTermDictInfosPtr++, uiI++ ) {
+        /* Get the search maximum number of term threads, only if there are enough terms to make it worthwhile */
+        uiSrchSearchTermFetchesLength = SRCH_SEARCH_TERM_THREADS_DEFAULT;
+        if ( uiSrchTermDictInfosLength >= SRCH_SEARCH_TERM_THREADS_MINIMUM_TERMS ) {
+            if ( iUtlConfigGetValue(pssSrchSearch->pvUtlConfig, SRCH_SEARCH_CONFIG_SEARCH_MAXIMUM_TERM_THREADS, pucConfigValue, SRCH_INFO_SYMBOL_MAXIMUM_LENGTH + 1) == UTL_NoError ) {
+                if ( s_strtol(pucConfigValue, NULL, 10) <= 0 ) {
+                    iUtlLogWarn(UTL_LOG_CONTEXT, "Invalid search maximum term threads found in the search configuration file, config key: '%s', config value: '%s'.", 
+                            SRCH_SEARCH_CONFIG_SEARCH_MAXIMUM_TERM_THREADS, pucConfigValue);
+                }
+                else {
+                    uiSrchSearchTermFetchesLength = s_strtol(pucConfigValue, NULL, 10);
+                }
+            }
+        }
+        uiSrchSearchTermFetchesLength = UTL_MACROS_MIN(uiSrchSearchTermFetchesLength, uiSrchTermDictInfosLength);
+
+
+        /* Allocate the postings lists, one per term */
+        if ( (ppsplSrchPostingsLists = (struct srchPostingsList **)s_malloc((size_t)(sizeof(struct srchPostingsList *) * uiSrchTermDictInfosLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchSearchGetPostingsListFromParserTerm;
+        }
 
-            wchar_t                     *pwcLocalTerm = NULL;
-            struct srchPostingsList     *psplSrchPostingsListTmp = NULL;
+        /* Allocate the term fetches */
+        if ( (psstfSrchSearchTermFetches = (struct srchSearchTermFetch *)s_malloc((size_t)(sizeof(struct srchSearchTermFetch) * uiSrchSearchTermFetchesLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchSearchGetPostingsListFromParserTerm;
+        }
 
-            /* Convert the term from utf-8 to wide characters, pwcLocalTerm is allocated */
-            if ( (iError = iLngConvertUtf8ToWideString_d(pstdiSrchTermDictInfosPtr->pucTerm, 0, &pwcLocalTerm)) != LNG_NoError ) {
-                iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert a term from utf-8 to wide characters, lng error: %d.", iError);
-                iError = SRCH_SearchCharacterSetConvertionFailed;
-                goto bailFromiSrchSearchGetPostingsListFromParserTerm;
-            }
+        /* Set up the term fetches, the terms are dealt out to them in turn */
+        for ( uiI = 0; uiI < uiSrchSearchTermFetchesLength; uiI++ ) {
 
-            /* Search for the term */
-            iError = iSrchTermSearchGetSearchPostingsListFromTerm(pssSrchSearch, psiSrchIndex, pstdiSrchTermDictInfosPtr->pucTerm, 
-                    fTermWeight, pucFieldIDBitmap, (pucFieldIDBitmap != NULL) ? psiSrchIndex->uiFieldIDMaximum : 0, fFrequentTermCoverageThreshold, 
-                    uiStartDocumentID, uiEndDocumentID, &psplSrchPostingsListTmp);
+            struct srchSearchTermFetch  *psstfSrchSearchTermFetch = psstfSrchSearchTermFetches + uiI;
 
-            ASSERT(psplSrchPostingsListTmp != NULL);
+            psstfSrchSearchTermFetch->pssSrchSearch = pssSrchSearch;
+            psstfSrchSearchTermFetch->psiSrchIndex = psiSrchIndex;
+            psstfSrchSearchTermFetch->pstdiSrchTermDictInfos = pstdiSrchTermDictInfos;
+            psstfSrchSearchTermFetch->uiSrchTermDictInfosLength = uiSrchTermDictInfosLength;
+            psstfSrchSearchTermFetch->uiFirstTerm = uiI;
+            psstfSrchSearchTermFetch->uiTermStep = uiSrchSearchTermFetchesLength;
+            psstfSrchSearchTermFetch->fTermWeight = fTermWeight;
+            psstfSrchSearchTermFetch->pucFieldIDBitmap = pucFieldIDBitmap;
+            psstfSrchSearchTermFetch->fFrequentTermCoverageThreshold = fFrequentTermCoverageThreshold;
+            psstfSrchSearchTermFetch->uiStartDocumentID = uiStartDocumentID;
+            psstfSrchSearchTermFetch->uiEndDocumentID = uiEndDocumentID;
+            psstfSrchSearchTermFetch->bTermPositions = bTermPositions;
+            psstfSrchSearchTermFetch->ppsplSrchPostingsLists = ppsplSrchPostingsLists;
+        }
+
+        /* Kick off the term fetch threads, all but the first which we run in this thread */
+        for ( uiI = 1; uiI < uiSrchSearchTermFetchesLength; uiI++ ) {
             
-            /* Free the wide character term */
-            s_free(pwcLocalTerm);
+            struct srchSearchTermFetch  *psstfSrchSearchTermFetch = psstfSrchSearchTermFetches + uiI;
+
+            if ( s_pthread_create(&psstfSrchSearchTermFetch->tThread, NULL, (void *)iSrchSearchFetchTerms, (void *)psstfSrchSearchTermFetch) == 0 ) {
+                psstfSrchSearchTermFetch->bThreaded = true;
+            }
+            else {
+                iUtlLogWarn(UTL_LOG_CONTEXT, "Failed to create a thread, fetching the terms serially.");
+                iSrchSearchFetchTerms(psstfSrchSearchTermFetch);
+            }
+        }
         
-            /* Check for non recoverable errors */
-            if ( iError != SRCH_NoError ) {
-                goto bailFromiSrchSearchGetPostingsListFromParserTerm;
+        /* Run the first term fetch */
+        iSrchSearchFetchTerms(psstfSrchSearchTermFetches);
+
+        /* Collect the term fetch threads, and pick up the first error */
+        for ( uiI = 0; uiI < uiSrchSearchTermFetchesLength; uiI++ ) {
+            
+            struct srchSearchTermFetch  *psstfSrchSearchTermFetch = psstfSrchSearchTermFetches + uiI;
+
+            if ( psstfSrchSearchTermFetch->bThreaded == true ) {
+                if ( s_pthread_join(psstfSrchSearchTermFetch->tThread, NULL) != 0 ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to join to a thread.");
+                    psstfSrchSearchTermFetch->iError = SRCH_MiscError;
+                }
+                psstfSrchSearchTermFetch->bThreaded = false;
+            }
+
+            if ( (iError == SRCH_NoError) && (psstfSrchSearchTermFetch->iError != SRCH_NoError) ) {
+                iError = psstfSrchSearchTermFetch->iError;
             }
+        }
+        
+        /* Check for non recoverable errors */
+        if ( iError != SRCH_NoError ) {
+            goto bailFromiSrchSearchGetPostingsListFromParserTerm;
+        }
+
+
+        /* Allocate the postings arrays list, these get merged */
+        if ( (ppspSrchPostingsList = (struct srchPosting **)s_malloc((size_t)(sizeof(struct srchPosting *) * uiSrchTermDictInfosLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchSearchGetPostingsListFromParserTerm;
+        }
+
+        /* Allocate the postings arrays lengths list */
+        if ( (puiSrchPostingsLengthList = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiSrchTermDictInfosLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchSearchGetPostingsListFromParserTerm;
+        }
+
 
+        /* Loop through all the terms in the term list, in order */
+        for ( pstdiSrchTermDictInfosPtr = pstdiSrchTermDictInfos, uiI = 0, uiSrchPostingsListLength = 0; uiI < uiSrchTermDictInfosLength; pstdiSrchTermDictInfosPtr++, uiI++ ) {
+
+            struct srchPostingsList     *psplSrchPostingsListTmp = ppsplSrchPostingsLists[uiI];
+
+            ASSERT(psplSrchPostingsListTmp != NULL);
+            
             /* Set the required flag */
             psplSrchPostingsListTmp->bRequired = psptSrchParserTerm->bRequired;
 
@@ -7734,61 +10059,65 @@ static int iSrchSearchGetPostingsListFromParserTerm
             }
     
 
-            /* Just hand over the data and pointer from the temp postings if the postings is not yet populated */
-            if ( psplSrchPostingsList->pspSrchPostings == NULL ) {
-            
-                /* Hand over the pointers */
+            /* Just take over the data from the temp postings if the postings are not yet populated */
+            if ( uiSrchPostingsListLength == 0 ) {
                 psplSrchPostingsList->uiTermType = psplSrchPostingsListTmp->uiTermType;
                 psplSrchPostingsList->uiTermCount = psplSrchPostingsListTmp->uiTermCount;
                 psplSrchPostingsList->uiDocumentCount = psplSrchPostingsListTmp->uiDocumentCount;
-                psplSrchPostingsList->pspSrchPostings = psplSrchPostingsListTmp->pspSrchPostings;
-                psplSrchPostingsList->uiSrchPostingsLength = psplSrchPostingsListTmp->uiSrchPostingsLength;
             }
-            else {
-                
-                /* Append the new postings to the existing postings array */
-                if ( (psplSrchPostingsListTmp->uiSrchPostingsLength > 0) && (psplSrchPostingsListTmp->pspSrchPostings != NULL) ) {
-
-                    struct srchPosting      *pspSrchPostingsPtr = NULL;
-
-                    /* Extend the existing postings array */
-                    if ( (pspSrchPostingsPtr = (struct srchPosting *)s_realloc(psplSrchPostingsList->pspSrchPostings, 
-                            (size_t)(sizeof(struct srchPosting) * (psplSrchPostingsList->uiSrchPostingsLength + psplSrchPostingsListTmp->uiSrchPostingsLength)))) == NULL ) {
-                        iError = SRCH_MemError;
-                        goto bailFromiSrchSearchGetPostingsListFromParserTerm;
-                    }
+            /* Increment the lengths, the doc count is now off, but gets recalculated below */
+            else if ( (psplSrchPostingsListTmp->uiSrchPostingsLength > 0) && (psplSrchPostingsListTmp->pspSrchPostings != NULL) ) {
+                psplSrchPostingsList->uiTermCount += psplSrchPostingsListTmp->uiSrchPostingsLength;
+                psplSrchPostingsList->uiDocumentCount += psplSrchPostingsListTmp->uiDocumentCount;
+            }
 
-                    /* Hand over the pointer */
-                    psplSrchPostingsList->pspSrchPostings = pspSrchPostingsPtr;
+            /* Add the postings to the postings arrays list */
+            if ( psplSrchPostingsListTmp->pspSrchPostings != NULL ) {
+                ppspSrchPostingsList[uiSrchPostingsListLength] = psplSrchPostingsListTmp->pspSrchPostings;
+                puiSrchPostingsLengthList[uiSrchPostingsListLength] = psplSrchPostingsListTmp->uiSrchPostingsLength;
+                uiSrchPostingsListLength++;
+            }
+        }
 
-                    /* Copy the new postings to the newly extended area */
-                    s_memcpy(psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength, psplSrchPostingsListTmp->pspSrchPostings,
-                        (sizeof(struct srchPosting) * psplSrchPostingsListTmp->uiSrchPostingsLength));
 
-                    /* Increment the lengths, the doc count is now off, but gets recalculated below */
-                    psplSrchPostingsList->uiTermCount += psplSrchPostingsListTmp->uiSrchPostingsLength;
-                    psplSrchPostingsList->uiDocumentCount += psplSrchPostingsListTmp->uiDocumentCount;
-                    psplSrchPostingsList->uiSrchPostingsLength += psplSrchPostingsListTmp->uiSrchPostingsLength;
+        /* Hand over the postings if there is only one postings array, otherwise merge them, 
+        ** each postings array is sorted so the merged postings array is too
+        */
+        if ( uiSrchPostingsListLength == 1 ) {
+            
+            /* Find the postings list and hand over the postings array, along with the term positions which have not been loaded yet */
+            for ( uiI = 0; uiI < uiSrchTermDictInfosLength; uiI++ ) {
+                if ( ppsplSrchPostingsLists[uiI]->pspSrchPostings != NULL ) {
+                    psplSrchPostingsList->pspSrchPostings = ppsplSrchPostingsLists[uiI]->pspSrchPostings;
+                    psplSrchPostingsList->uiSrchPostingsLength = ppsplSrchPostingsLists[uiI]->uiSrchPostingsLength;
+                    psplSrchPostingsList->pucTermPositions = ppsplSrchPostingsLists[uiI]->pucTermPositions;
+                    psplSrchPostingsList->uiTermPositionsIndex = ppsplSrchPostingsLists[uiI]->uiTermPositionsIndex;
+                    ppsplSrchPostingsLists[uiI]->pspSrchPostings = NULL;
+                    ppsplSrchPostingsLists[uiI]->uiSrchPostingsLength = 0;
+                    ppsplSrchPostingsLists[uiI]->pucTermPositions = NULL;
+                    ppsplSrchPostingsLists[uiI]->uiTermPositionsIndex = 0;
+                    break;
                 }
-
-                /* Free the temp postings list postings array */
-                s_free(psplSrchPostingsListTmp->pspSrchPostings);
             }
-            
-            /* Free the temp postings list */
-            s_free(psplSrchPostingsListTmp);
         }
-
-
-        /* Post-process the postings if needed */
-        if ( (psplSrchPostingsList->pspSrchPostings != NULL) && (uiSrchTermDictInfosLength > 1) ) {
+        else if ( uiSrchPostingsListLength > 1 ) {
 
             struct srchPosting      *pspSrchPostingsPtr = NULL;
             struct srchPosting      *pspSrchPostingsEnd = NULL;
             unsigned int            uiDocumentID = 0;
 
-            /* Sort the postings */
-            iSrchPostingSortDocumentIDAsc(psplSrchPostingsList->pspSrchPostings, 0, psplSrchPostingsList->uiSrchPostingsLength - 1);
+            /* Load the term positions, the postings are merged in term position order */
+            for ( uiI = 0; uiI < uiSrchTermDictInfosLength; uiI++ ) {
+                if ( (iError = iSrchPostingLoadTermPositions(ppsplSrchPostingsLists[uiI], NULL, 0)) != SRCH_NoError ) {
+                    goto bailFromiSrchSearchGetPostingsListFromParserTerm;
+                }
+            }
+
+            /* Merge the postings */
+            if ( (iError = iSrchPostingMergeSrchPostings(ppspSrchPostingsList, puiSrchPostingsLengthList, uiSrchPostingsListLength, 
+                    &psplSrchPostingsList->pspSrchPostings, &psplSrchPostingsList->uiSrchPostingsLength)) != SRCH_NoError ) {
+                goto bailFromiSrchSearchGetPostingsListFromParserTerm;
+            }
 
             /* Count up the number of documents in this postings array and set the value in the search postings list structure */
             for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pspSrchPostingsEnd = psplSrchPostingsList->pspSrchPostings + psplSrchPostingsList->uiSrchPostingsLength, 
@@ -7814,8 +10143,11 @@ static int iSrchSearchGetPostingsListFromParserTerm
     **
     */
 
-    /* Save the search in the cache */
-    if ( (uiSrchParserSearchCacheID == SRCH_PARSER_MODIFIER_SEARCH_CACHE_ENABLE_ID) && (bCachableSearch == true) ) {
+    /* Save the search in the cache if it has the term positions and if it was not 
+    ** skipped ahead to the start document ID, in which case it is not complete
+    */
+    if ( (uiSrchParserSearchCacheID == SRCH_PARSER_MODIFIER_SEARCH_CACHE_ENABLE_ID) && (bCachableSearch == true) && (bTermPositions == true) && 
+            (uiStartDocumentID == 0) ) {
 
         /* Get the search report end index */
         if ( iSrchReportGetReportOffset(pssSrchSearch->pvSrchReport, &zSearchReportEndOffset) != SRCH_NoError ) {
@@ -7829,66 +10161,254 @@ static int iSrchSearchGetPostingsListFromParserTerm
             }
         }
 
-        /* Save in cache, ignore error */
-        iSrchCacheSaveSearchPostingsList(pssSrchSearch->pvSrchCache, psiSrchIndex, uiLanguageID, psptSrchParserTerm, psplSrchPostingsList, pucSearchReportSnippet);
+        /* Save in cache, ignore error, the term positions need to be loaded first */
+        if ( iSrchPostingLoadTermPositions(psplSrchPostingsList, NULL, 0) == SRCH_NoError ) {
+            iSrchCacheSaveSearchPostingsList(pssSrchSearch->pvSrchCache, psiSrchIndex, uiLanguageID, psptSrchParserTerm, psplSrchPostingsList, pucSearchReportSnippet);
+        }
     }
     
 
-    
+    
+
+    /* Bail label */
+    bailFromiSrchSearchGetPostingsListFromParserTerm:
+
+
+    /* Free the postings lists for the expanded terms, the term fetches and the postings arrays lists */
+    if ( ppsplSrchPostingsLists != NULL ) {
+        for ( uiI = 0; uiI < uiSrchTermDictInfosLength; uiI++ ) {
+            iSrchPostingFreeSrchPostingsList(ppsplSrchPostingsLists[uiI]);
+        }
+        s_free(ppsplSrchPostingsLists);
+    }
+    s_free(psstfSrchSearchTermFetches);
+    s_free(ppspSrchPostingsList);
+    s_free(puiSrchPostingsLengthList);
+
+    /* Free the field IDs bit map */
+    s_free(pucFieldIDBitmap);
+
+    /* Free the search report snippet */
+    s_free(pucSearchReportSnippet);
+
+    /* Free the term dict information structure */
+    if ( pstdiSrchTermDictInfos != NULL ) {
+        for ( pstdiSrchTermDictInfosPtr = pstdiSrchTermDictInfos, uiI = 0; uiI < uiSrchTermDictInfosLength; pstdiSrchTermDictInfosPtr++, uiI++ ) {
+            s_free(pstdiSrchTermDictInfosPtr->pucTerm);
+        }
+        s_free(pstdiSrchTermDictInfos);
+    }
+
+    /* Free the term */
+    s_free(pucTerm);
+
+    /* Free the stemmed term */
+    s_free(pwcTermStemmed);
+
+    /* Free the stemmed term */
+    s_free(pucTermStemmed);
+
+    /* Free the lower case term */
+    s_free(pwcTermLowerCase);
+
+    /* Free the lower case term */
+    s_free(pucTermLowerCase);
+
+    /* Free the stemmer */
+    iLngStemmerFree(pvLngStemmer);
+    pvLngStemmer = NULL;
+
+
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: '%s', iError: %d, psplSrchPostingsList %s NULL",  */
+/*             pucTerm, iError, (psplSrchPostingsList != NULL) ? "!=" : "="); */
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointer */
+        *ppsplSrchPostingsList = psplSrchPostingsList;        
+    }
+    else {
+
+        /* Free the search postings list */
+        iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
+        psplSrchPostingsList = NULL;
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchGetSearchBitmapFromDates()
+
+    Purpose:    This function creates a search bitmap with the bits set for the
+                documents which pass the date restriction, using the date index 
+                so the date of each document does not need to be checked.
+
+                Each date restriction maps to a contiguous run of entries in 
+                the date index, the runs for the restrictions are intersected 
+                first and the 'not equal' restrictions are cleared out after.
+
+                A search bitmap is not returned if the index does not have a date index.
+
+    Parameters: psiSrchIndex                    index structure
+                pspnSrchParserNumberDates       search parser numbers structure for the dates
+                uiSrchParserNumberDatesLength   search parser numbers structure length
+                ppsbSrchBitmap                  return pointer for the search bitmap structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchGetSearchBitmapFromDates
+(
+    struct srchIndex *psiSrchIndex,
+    struct srchParserNumber *pspnSrchParserNumberDates,
+    unsigned int uiSrchParserNumberDatesLength,
+    struct srchBitmap **ppsbSrchBitmap
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchBitmap           *psbSrchBitmap = NULL;
+    struct srchParserNumber     *pspnSrchParserNumberDatesPtr = NULL;
+    unsigned int                *puiDateIndex = NULL;
+    unsigned int                uiDocumentCount = 0;
+    unsigned int                uiStartOffset = 0;
+    unsigned int                uiEndOffset = 0;
+    unsigned int                uiDateStartOffset = 0;
+    unsigned int                uiDateEndOffset = 0;
+    unsigned int                uiI = 0;
+    unsigned int                uiJ = 0;
+
 
-    /* Bail label */
-    bailFromiSrchSearchGetPostingsListFromParserTerm:
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(((pspnSrchParserNumberDates != NULL) && (uiSrchParserNumberDatesLength > 0)) ||
+            ((pspnSrchParserNumberDates == NULL) && (uiSrchParserNumberDatesLength == 0)));
+    ASSERT(ppsbSrchBitmap != NULL);
 
 
-    /* Free the field IDs bit map */
-    s_free(pucFieldIDBitmap);
+    /* Pre-set the return pointer */
+    *ppsbSrchBitmap = NULL;
 
-    /* Free the search report snippet */
-    s_free(pucSearchReportSnippet);
 
-    /* Free the term dict information structure */
-    if ( pstdiSrchTermDictInfos != NULL ) {
-        for ( pstdiSrchTermDictInfosPtr = pstdiSrchTermDictInfos, uiI = 0; uiI < uiSrchTermDictInfosLength; pstdiSrchTermDictInfosPtr++, uiI++ ) {
-            s_free(pstdiSrchTermDictInfosPtr->pucTerm);
-        }
-        s_free(pstdiSrchTermDictInfos);
+    /* Nothing to do if there is no date restriction or no date index */
+    if ( (pspnSrchParserNumberDates == NULL) || (psiSrchIndex->psdcSrchDocumentColumns == NULL) || 
+            (psiSrchIndex->psdcSrchDocumentColumns->puiDateIndex == NULL) ) {
+        return (SRCH_NoError);
     }
 
-    /* Free the term */
-    s_free(pucTerm);
 
-    /* Free the stemmed term */
-    s_free(pwcTermStemmed);
+    /* Dereference the date index for convenience */
+    puiDateIndex = psiSrchIndex->psdcSrchDocumentColumns->puiDateIndex;
+    uiDocumentCount = psiSrchIndex->psdcSrchDocumentColumns->uiDocumentCount;
 
-    /* Free the stemmed term */
-    s_free(pucTermStemmed);
 
-    /* Free the lower case term */
-    s_free(pwcTermLowerCase);
+    /* Intersect the runs of date index entries for the restrictions, there are
+    ** two passes, the first one for the ranges and the second one for the 'not equal'
+    */
+    uiStartOffset = 0;
+    uiEndOffset = uiDocumentCount;
 
-    /* Free the lower case term */
-    s_free(pucTermLowerCase);
+    for ( uiJ = 0; uiJ < 2; uiJ++ ) {
 
-    /* Free the stemmer */
-    iLngStemmerFree(pvLngStemmer);
-    pvLngStemmer = NULL;
+        for ( uiI = 0, pspnSrchParserNumberDatesPtr = pspnSrchParserNumberDates; uiI < uiSrchParserNumberDatesLength; uiI++, pspnSrchParserNumberDatesPtr++ ) {
+    
+            /* Skip the restrictions which are not part of this pass */
+            if ( ((uiJ == 0) && (pspnSrchParserNumberDatesPtr->uiRangeID == SRCH_PARSER_RANGE_NOT_EQUAL_ID)) ||
+                    ((uiJ == 1) && (pspnSrchParserNumberDatesPtr->uiRangeID != SRCH_PARSER_RANGE_NOT_EQUAL_ID)) ) {
+                continue;
+            }
+    
+            /* Get the run of date index entries for this date, the first entry dated on or after it, and the first entry dated after it */
+            if ( (iError = iSrchDocumentGetDateIndexOffset(psiSrchIndex, pspnSrchParserNumberDatesPtr->ulNumber, &uiDateStartOffset)) != SRCH_NoError ) {
+                goto bailFromiSrchSearchGetSearchBitmapFromDates;
+            }
+            
+            if ( pspnSrchParserNumberDatesPtr->ulNumber == ULONG_MAX ) {
+                uiDateEndOffset = uiDocumentCount;
+            }
+            else if ( (iError = iSrchDocumentGetDateIndexOffset(psiSrchIndex, pspnSrchParserNumberDatesPtr->ulNumber + 1, &uiDateEndOffset)) != SRCH_NoError ) {
+                goto bailFromiSrchSearchGetSearchBitmapFromDates;
+            }
+    
+            /* Narrow down the run of date index entries */
+            switch ( pspnSrchParserNumberDatesPtr->uiRangeID ) {
+            
+                case SRCH_PARSER_RANGE_EQUAL_ID:
+                    uiStartOffset = UTL_MACROS_MAX(uiStartOffset, uiDateStartOffset);
+                    uiEndOffset = UTL_MACROS_MIN(uiEndOffset, uiDateEndOffset);
+                    break;
+            
+                case SRCH_PARSER_RANGE_GREATER_ID:
+                    uiStartOffset = UTL_MACROS_MAX(uiStartOffset, uiDateEndOffset);
+                    break;
+    
+                case SRCH_PARSER_RANGE_LESS_ID:
+                    uiEndOffset = UTL_MACROS_MIN(uiEndOffset, uiDateStartOffset);
+                    break;
+            
+                case SRCH_PARSER_RANGE_GREATER_OR_EQUAL_ID:
+                    uiStartOffset = UTL_MACROS_MAX(uiStartOffset, uiDateStartOffset);
+                    break;
+            
+                case SRCH_PARSER_RANGE_LESS_OR_EQUAL_ID:
+                    uiEndOffset = UTL_MACROS_MIN(uiEndOffset, uiDateEndOffset);
+                    break;
+                    
+                /* Clear out the documents with this date */
+                case SRCH_PARSER_RANGE_NOT_EQUAL_ID:
+                    for ( uiDateStartOffset = UTL_MACROS_MAX(uiStartOffset, uiDateStartOffset); 
+                            uiDateStartOffset < UTL_MACROS_MIN(uiEndOffset, uiDateEndOffset); uiDateStartOffset++ ) {
+                        UTL_BITMAP_CLEAR_BIT_IN_POINTER(psbSrchBitmap->pucBitmap, puiDateIndex[uiDateStartOffset]);
+                    }
+                    break;
+    
+                default:
+                    break;
+            }
+        }
+
+
+        /* Create the search bitmap at the end of the first pass and set the bits for the documents in the run */
+        if ( uiJ == 0 ) {
+
+            if ( (iError = iSrchBitmapCreate(NULL, uiDocumentCount + 1, false, &psbSrchBitmap)) != SRCH_NoError ) {
+                goto bailFromiSrchSearchGetSearchBitmapFromDates;
+            }
+            
+            for ( uiI = uiStartOffset; uiI < uiEndOffset; uiI++ ) {
+                UTL_BITMAP_SET_BIT_IN_POINTER(psbSrchBitmap->pucBitmap, puiDateIndex[uiI]);
+            }
+        }
+    }
 
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: '%s', iError: %d, psplSrchPostingsList %s NULL",  */
-/*             pucTerm, iError, (psplSrchPostingsList != NULL) ? "!=" : "="); */
+
+    /* Bail label */
+    bailFromiSrchSearchGetSearchBitmapFromDates:
 
 
     /* Handle the error */
     if ( iError == SRCH_NoError ) {
-
+    
         /* Set the return pointer */
-        *ppsplSrchPostingsList = psplSrchPostingsList;        
+        *ppsbSrchBitmap = psbSrchBitmap;
     }
     else {
-
-        /* Free the search postings list */
-        iSrchPostingFreeSrchPostingsList(psplSrchPostingsList);
-        psplSrchPostingsList = NULL;
+        
+        /* Free the search bitmap */
+        iSrchBitmapFree(psbSrchBitmap);
+        psbSrchBitmap = NULL;
     }
 
 
@@ -7990,6 +10510,290 @@ static int iSrchSearchFilterNumberAgainstSrchParserNumbers
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchSearchStartSearchSegment()
+
+    Purpose:    This function starts the search of a segment of a virtual
+                index in its own thread. The segment gets its own copy of
+                the search structure with its own search report so that the
+                part of the search report it generates can be appended to
+                the search report in segment order.
+
+                The search is run in the current thread if the thread
+                could not be created.
+
+    Parameters: pssSrchSearch               search structure
+                psssSrchSearchSegment       search segment structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchStartSearchSegment
+(
+    struct srchSearch *pssSrchSearch,
+    struct srchSearchSegment *psssSrchSearchSegment
+)
+{
+
+    int     iError = SRCH_NoError;
+    int     iStatus = 0;
+
+
+    ASSERT(pssSrchSearch != NULL);
+    ASSERT(psssSrchSearchSegment != NULL);
+    ASSERT(psssSrchSearchSegment->bStarted == false);
+
+
+    /* Copy the search structure, the parser and the cache are only read by the search, the normalized
+    ** search texts the parser creates on demand will already have been created before we got here
+    */
+    psssSrchSearchSegment->ssSrchSearch = *pssSrchSearch;
+    psssSrchSearchSegment->ssSrchSearch.pvSrchReport = NULL;
+
+    /* Create the sub report for this segment */
+    if ( (iError = iSrchReportCreateSubReport(pssSrchSearch->pvSrchReport, &psssSrchSearchSegment->ssSrchSearch.pvSrchReport)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a search sub report, srch error: %d.", iError);
+        return (iError);
+    }
+
+    /* Set the started flag */
+    psssSrchSearchSegment->bStarted = true;
+
+
+    /* Kick off the search thread */
+    if ( (iStatus = s_pthread_create(&psssSrchSearchSegment->tThread, NULL, (void *)iSrchSearchSearchSegment, (void *)psssSrchSearchSegment)) == 0 ) {
+        psssSrchSearchSegment->bThreaded = true;
+    }
+    else {
+        
+        /* Run the search in this thread if we could not create a thread */
+        iUtlLogWarn(UTL_LOG_CONTEXT, "Failed to create a thread, searching the segment serially.");
+        psssSrchSearchSegment->bThreaded = false;
+        iSrchSearchSearchSegment(psssSrchSearchSegment);
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchSearchSegment()
+
+    Purpose:    This function searches a segment of a virtual index, this 
+                function is run in its own thread.
+
+    Parameters: psssSrchSearchSegment       search segment structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchSearchSegment
+(
+    struct srchSearchSegment *psssSrchSearchSegment
+)
+{
+
+    ASSERT(psssSrchSearchSegment != NULL);
+
+
+    /* Do the search - note that the start index is 0 since this is a multi index search */
+    psssSrchSearchSegment->iError = iSrchSearchGetShortResultsFromSearch(&psssSrchSearchSegment->ssSrchSearch, psssSrchSearchSegment->psiSrchIndex, 
+            psssSrchSearchSegment->uiLanguageID, psssSrchSearchSegment->pwcSearchText, psssSrchSearchSegment->pwcPositiveFeedbackText,
+            psssSrchSearchSegment->pwcNegativeFeedbackText, 0, psssSrchSearchSegment->uiEndIndex, psssSrchSearchSegment->uiSortFieldType, 
+            psssSrchSearchSegment->uiSortType, &psssSrchSearchSegment->pssrSrchShortResults, &psssSrchSearchSegment->uiSrchShortResultsLength, 
+            &psssSrchSearchSegment->uiTotalResults, &psssSrchSearchSegment->dMaxSortKey);
+
+
+    return (psssSrchSearchSegment->iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchFinishSearchSegment()
+
+    Purpose:    This function waits for the search of a segment of a 
+                virtual index to finish.
+
+    Parameters: psssSrchSearchSegment       search segment structure
+
+    Globals:    none
+
+    Returns:    SRCH error code, the error returned by the search
+
+*/
+static int iSrchSearchFinishSearchSegment
+(
+    struct srchSearchSegment *psssSrchSearchSegment
+)
+{
+
+    int     iStatus = 0;
+
+
+    ASSERT(psssSrchSearchSegment != NULL);
+    ASSERT(psssSrchSearchSegment->bStarted == true);
+
+
+    /* Join the thread */
+    if ( psssSrchSearchSegment->bThreaded == true ) {
+
+        iStatus = s_pthread_join(psssSrchSearchSegment->tThread, NULL);
+
+        /* Clear the threaded flag, we are done with the thread */
+        psssSrchSearchSegment->bThreaded = false;
+
+        /* Handle the thread status */
+        if ( iStatus != 0 ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to join to a thread.");
+            return (SRCH_MiscError);
+        }
+    }
+
+
+    return (psssSrchSearchSegment->iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchFreeSearchSegments()
+
+    Purpose:    This function frees a search segments array, waiting for
+                any search still running to finish.
+
+    Parameters: psssSrchSearchSegments          search segments array
+                uiSrchSearchSegmentsLength      search segments array length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchFreeSearchSegments
+(
+    struct srchSearchSegment *psssSrchSearchSegments, 
+    unsigned int uiSrchSearchSegmentsLength
+)
+{
+
+    struct srchSearchSegment    *psssSrchSearchSegmentsPtr = NULL;
+    unsigned int                uiI = 0;
+
+
+    /* Check the parameters */
+    if ( psssSrchSearchSegments == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Loop over the search segments */
+    for ( uiI = 0, psssSrchSearchSegmentsPtr = psssSrchSearchSegments; uiI < uiSrchSearchSegmentsLength; uiI++, psssSrchSearchSegmentsPtr++ ) {
+
+        /* Wait for the search to finish */
+        if ( psssSrchSearchSegmentsPtr->bThreaded == true ) {
+            s_pthread_join(psssSrchSearchSegmentsPtr->tThread, NULL);
+            psssSrchSearchSegmentsPtr->bThreaded = false;
+        }
+
+        /* Free the short results */
+        if ( psssSrchSearchSegmentsPtr->pssrSrchShortResults != NULL ) {
+            iSrchShortResultFree(psssSrchSearchSegmentsPtr->pssrSrchShortResults, psssSrchSearchSegmentsPtr->uiSrchShortResultsLength, 
+                    psssSrchSearchSegmentsPtr->uiSortType);
+            psssSrchSearchSegmentsPtr->pssrSrchShortResults = NULL;
+        }
+
+        /* Free the sub report */
+        if ( psssSrchSearchSegmentsPtr->ssSrchSearch.pvSrchReport != NULL ) {
+            iSrchReportClose(psssSrchSearchSegmentsPtr->ssSrchSearch.pvSrchReport);
+            psssSrchSearchSegmentsPtr->ssSrchSearch.pvSrchReport = NULL;
+        }
+    }
+
+    /* Free the search segments */
+    s_free(psssSrchSearchSegments);
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchSearchFetchTerms()
+
+    Purpose:    This function fetches the postings lists for the terms an 
+                expanded term expanded to which are assigned to this term
+                fetch, this function may be run in its own thread.
+
+    Parameters: psstfSrchSearchTermFetch    search term fetch structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchSearchFetchTerms
+(
+    struct srchSearchTermFetch *psstfSrchSearchTermFetch
+)
+{
+
+    unsigned int    uiI = 0;
+
+
+    ASSERT(psstfSrchSearchTermFetch != NULL);
+    ASSERT(psstfSrchSearchTermFetch->uiTermStep > 0);
+
+
+    /* Loop over the terms assigned to this term fetch */
+    for ( uiI = psstfSrchSearchTermFetch->uiFirstTerm, psstfSrchSearchTermFetch->iError = SRCH_NoError; 
+            uiI < psstfSrchSearchTermFetch->uiSrchTermDictInfosLength; uiI += psstfSrchSearchTermFetch->uiTermStep ) {
+
+        /* Search for the term */
+        if ( (psstfSrchSearchTermFetch->iError = iSrchTermSearchGetSearchPostingsListFromTerm(psstfSrchSearchTermFetch->pssSrchSearch, 
+                psstfSrchSearchTermFetch->psiSrchIndex, psstfSrchSearchTermFetch->pstdiSrchTermDictInfos[uiI].pucTerm, 
+                psstfSrchSearchTermFetch->fTermWeight, psstfSrchSearchTermFetch->pucFieldIDBitmap, 
+                (psstfSrchSearchTermFetch->pucFieldIDBitmap != NULL) ? psstfSrchSearchTermFetch->psiSrchIndex->uiFieldIDMaximum : 0, 
+                psstfSrchSearchTermFetch->fFrequentTermCoverageThreshold, psstfSrchSearchTermFetch->uiStartDocumentID, 
+                psstfSrchSearchTermFetch->uiEndDocumentID, psstfSrchSearchTermFetch->bTermPositions, false, false, 
+                &psstfSrchSearchTermFetch->ppsplSrchPostingsLists[uiI])) != SRCH_NoError ) {
+            break;
+        }
+    }
+
+
+    return (psstfSrchSearchTermFetch->iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchSearchAddEntryToSpiDocumentItems()
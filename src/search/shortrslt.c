@@ -130,6 +130,15 @@
 #define SRCH_SHORT_RESULTS_CORRELATION_COEFFICIENT_THRESHOLD        (0.5)
 
 
+/*
+** Search result count threshold above which we consider a partial sort when
+** only the top of the search results is needed, and the ratio of search result 
+** count to the number of search results needed for the partial sort to kick in
+*/
+#define SRCH_SHORT_RESULTS_HIT_COUNT_THRESHOLD_FOR_PARTIAL_SORT     (1000)
+#define SRCH_SHORT_RESULTS_PARTIAL_SORT_RATIO                       (8)
+
+
 /* Sort orders  */
 #define SRCH_SHORT_RESULTS_SORT_INVALID_ID                          (0)
 #define SRCH_SHORT_RESULTS_SORT_QUICK_ID                            (1)
@@ -151,37 +160,37 @@ static int iSrchSearchGetCorrelationCoefficient (struct srchShortResult *pssrSrc
 
 
 static int iSrchShortResultQuickSort (struct srchShortResult *pssrSrchShortResults, 
-        unsigned int iSrchShortResultsLeftIndex, unsigned int uiSortType);
+        unsigned int iSrchShortResultsLeftIndex, unsigned int uiSrchShortResultsLimitIndex, unsigned int uiSortType);
 
 static int iSrchShortResultQuickSortDoubleAsc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortDoubleDesc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortFloatAsc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortFloatDesc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortUIntAsc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortUIntDesc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortULongAsc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortULongDesc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortCharAsc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 static int iSrchShortResultQuickSortCharDesc (struct srchShortResult *pssrSrchShortResults, 
-        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex);
+        int iSrchShortResultsLeftIndex, int iSrchShortResultsRightIndex, int iSrchShortResultsLimitIndex);
 
 
 static int iSrchShortResultRadixSort (struct srchShortResult **ppssrSrchShortResults, 
@@ -200,6 +209,15 @@ static int iSrchShortResultRadixSortULong (struct srchShortResult **ppssrSrchSea
         unsigned int uiSrchShortResultsLength, unsigned int uiSortOrder);
 
 
+static int iSrchShortResultMergeSiftDown (struct srchShortResult **ppssrSrchShortResultsList, 
+        unsigned int *puiSrchShortResultsOffsetList, unsigned int *puiHeap, unsigned int uiHeapLength, 
+        unsigned int uiHeapIndex, unsigned int uiSortType);
+
+static boolean bSrchShortResultMergePrecedes (struct srchShortResult *pssrSrchShortResult1, 
+        unsigned int uiListIndex1, struct srchShortResult *pssrSrchShortResult2, 
+        unsigned int uiListIndex2, unsigned int uiSortType);
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -309,10 +327,16 @@ static int iSrchShortResultRadixSortULong (struct srchShortResult **ppssrSrchSea
 
     Function:   iSrchShortResultSort()
 
-    Purpose:    This function sorts the short results array
+    Purpose:    This function sorts the short results array.
+
+                If an end index is passed and it is well short of the number
+                of short results, only the short results up to the end index
+                are sorted, the remaining short results are left in no particular
+                order, they are the ones that will be spliced out.
 
     Parameters: pssrSrchShortResults        pointer to an array of short result structures
                 uiSrchShortResultsLength    number of entries in the array of short result structures
+                uiSrchShortResultsEndIndex  short results end index, 0 if there is no end index
                 uiSortType                  sort type (SPI_SORT_TYPE_*)
 
     Globals:    none
@@ -324,12 +348,14 @@ int iSrchShortResultSort
 (
     struct srchShortResult **ppssrSrchShortResults,
     unsigned int uiSrchShortResultsLength,
+    unsigned int uiSrchShortResultsEndIndex,
     unsigned int uiSortType
 )
 {
 
-    int     iError = SRCH_NoError;
-    int     uiSortMethod = SRCH_SHORT_RESULTS_SORT_INVALID_ID;
+    int             iError = SRCH_NoError;
+    int             uiSortMethod = SRCH_SHORT_RESULTS_SORT_INVALID_ID;
+    unsigned int    uiSrchShortResultsLimitIndex = uiSrchShortResultsLength - 1;
 
 
     /* Check the parameters */
@@ -349,8 +375,18 @@ int iSrchShortResultSort
     }
 
 
+    /* Select a partial quicksort if only the top of the short results is needed, this beats
+    ** sorting everything with either method since most of the partitions get skipped
+    */
+    if ( (uiSrchShortResultsEndIndex > 0) && (uiSrchShortResultsLength > SRCH_SHORT_RESULTS_HIT_COUNT_THRESHOLD_FOR_PARTIAL_SORT) && 
+            ((uiSrchShortResultsEndIndex + 1) < (uiSrchShortResultsLength / SRCH_SHORT_RESULTS_PARTIAL_SORT_RATIO)) ) {
+/*         iUtlLogDebug(UTL_LOG_CONTEXT, "Selecting partial quicksort, search result count: %u, end index: %u\n", uiSrchShortResultsLength, uiSrchShortResultsEndIndex); */
+        uiSortMethod = SRCH_SHORT_RESULTS_SORT_QUICK_ID;
+        uiSrchShortResultsLimitIndex = uiSrchShortResultsEndIndex;
+    }
+
     /* Automatically select radix sorting if we reach a certain number of results, unless we are sorting alphabetically */
-    if ( (SRCH_SHORT_RESULTS_HIT_COUNT_THRESHOLD_FOR_RADIX != -1) && (uiSrchShortResultsLength > SRCH_SHORT_RESULTS_HIT_COUNT_THRESHOLD_FOR_RADIX) && 
+    else if ( (SRCH_SHORT_RESULTS_HIT_COUNT_THRESHOLD_FOR_RADIX != -1) && (uiSrchShortResultsLength > SRCH_SHORT_RESULTS_HIT_COUNT_THRESHOLD_FOR_RADIX) && 
             (uiSortType != SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_ASC) &&
             (uiSortType != SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_DESC) ) {
 /*         iUtlLogDebug(UTL_LOG_CONTEXT, "Selecting radix sort, search result count: %u (threshold: %u)\n", uiSrchShortResultsLength, SRCH_SHORT_RESULTS_HIT_COUNT_THRESHOLD_FOR_RADIX); */
@@ -404,6 +440,7 @@ int iSrchShortResultSort
 #if defined(SRCH_SHORT_RESULTS_ENABLE_FORCED_RADIX_SORT)
 
     uiSortMethod = SRCH_SHORT_RESULTS_SORT_RADIX_ID;
+    uiSrchShortResultsLimitIndex = uiSrchShortResultsLength - 1;
 
 #endif    /* defined(SRCH_SHORT_RESULTS_ENABLE_FORCED_RADIX_SORT) */
 
@@ -414,7 +451,7 @@ int iSrchShortResultSort
     /* Sort the short results array with the chosen sort method and sort order */
     if ( uiSortMethod == SRCH_SHORT_RESULTS_SORT_QUICK_ID    ) {
 
-        if ( (iError = iSrchShortResultQuickSort(*ppssrSrchShortResults, uiSrchShortResultsLength, uiSortType)) != SRCH_NoError ) {
+        if ( (iError = iSrchShortResultQuickSort(*ppssrSrchShortResults, uiSrchShortResultsLength, uiSrchShortResultsLimitIndex, uiSortType)) != SRCH_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to sort the short results: srch error: %d.", iError);
             goto bailFromiSrchShortResultSort;
         }
@@ -650,6 +687,220 @@ int iSrchShortResultSplice
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchShortResultMerge()
+
+    Purpose:    This function merges a list of short results arrays, each 
+                of which is already sorted, into a single sorted short results 
+                array using a k-way heap merge.
+
+                If an end index is passed, the merge stops once the short 
+                results up to the end index have been merged, the short results
+                which are not merged are released.
+
+                The short results arrays in the list are always released, and
+                the list is cleared, regardless of whether an error occured.
+
+    Parameters: ppssrSrchShortResultsList           list of short results arrays
+                puiSrchShortResultsLengthList       list of short results arrays lengths
+                uiSrchShortResultsListLength        number of entries in the lists
+                uiSrchShortResultsEndIndex          short results end index, 0 if there is no end index
+                uiSortType                          sort type (SPI_SORT_TYPE_*)
+                ppssrSrchShortResults               return pointer for the merged short results array
+                puiSrchShortResultsLength           return pointer for the merged short results array length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchShortResultMerge
+(
+    struct srchShortResult **ppssrSrchShortResultsList,
+    unsigned int *puiSrchShortResultsLengthList,
+    unsigned int uiSrchShortResultsListLength,
+    unsigned int uiSrchShortResultsEndIndex,
+    unsigned int uiSortType,
+    struct srchShortResult **ppssrSrchShortResults,
+    unsigned int *puiSrchShortResultsLength
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchShortResult      *pssrSrchShortResults = NULL;
+    struct srchShortResult      *pssrSrchShortResultsPtr = NULL;
+    unsigned int                uiSrchShortResultsLength = 0;
+    unsigned int                *puiSrchShortResultsOffsetList = NULL;
+    unsigned int                *puiHeap = NULL;
+    unsigned int                uiHeapLength = 0;
+    unsigned int                uiI = 0;
+    unsigned int                uiJ = 0;
+
+
+    /* Check the parameters */
+    if ( ppssrSrchShortResultsList == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppssrSrchShortResultsList' parameter passed to 'iSrchShortResultMerge'."); 
+        return (SRCH_ShortResultInvalidShortResults);
+    }
+
+    if ( puiSrchShortResultsLengthList == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiSrchShortResultsLengthList' parameter passed to 'iSrchShortResultMerge'."); 
+        return (SRCH_ShortResultInvalidShortResults);
+    }
+
+    if ( SRCH_SHORT_RESULTS_SORT_TYPE_VALID(uiSortType) == false ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiSortType' parameter passed to 'iSrchShortResultMerge: %u.", uiSortType); 
+        return (SRCH_ShortResultInvalidSortOrder);
+    }
+
+    if ( ppssrSrchShortResults == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppssrSrchShortResults' parameter passed to 'iSrchShortResultMerge'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiSrchShortResultsLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiSrchShortResultsLength' parameter passed to 'iSrchShortResultMerge'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Allocate the offsets list, this keeps track of how far we have got into each short results array */
+    if ( uiSrchShortResultsListLength > 0 ) {
+        if ( (puiSrchShortResultsOffsetList = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiSrchShortResultsListLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchShortResultMerge;
+        }
+    }
+
+    /* Count up the short results */
+    for ( uiI = 0; uiI < uiSrchShortResultsListLength; uiI++ ) {
+        uiSrchShortResultsLength += (ppssrSrchShortResultsList[uiI] != NULL) ? puiSrchShortResultsLengthList[uiI] : 0;
+    }
+
+    /* Cap the number of short results to the end index */
+    if ( (uiSrchShortResultsEndIndex > 0) && (uiSrchShortResultsLength > (uiSrchShortResultsEndIndex + 1)) ) {
+        uiSrchShortResultsLength = uiSrchShortResultsEndIndex + 1;
+    }
+
+    /* Nothing to merge */
+    if ( uiSrchShortResultsLength == 0 ) {
+        goto bailFromiSrchShortResultMerge;
+    }
+
+
+    /* Allocate the merged short results */
+    if ( (pssrSrchShortResults = (struct srchShortResult *)s_malloc((size_t)(sizeof(struct srchShortResult) * uiSrchShortResultsLength))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchShortResultMerge;
+    }
+
+
+    /* Unsorted short results are just concatenated in list order */
+    if ( (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_NO_SORT) || (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_UNKNOWN) ) {
+
+        for ( uiI = 0, pssrSrchShortResultsPtr = pssrSrchShortResults; (uiI < uiSrchShortResultsListLength) && 
+                (pssrSrchShortResultsPtr < (pssrSrchShortResults + uiSrchShortResultsLength)); uiI++ ) {
+
+            for ( ; (ppssrSrchShortResultsList[uiI] != NULL) && (puiSrchShortResultsOffsetList[uiI] < puiSrchShortResultsLengthList[uiI]) && 
+                    (pssrSrchShortResultsPtr < (pssrSrchShortResults + uiSrchShortResultsLength)); puiSrchShortResultsOffsetList[uiI]++, pssrSrchShortResultsPtr++ ) {
+                SRCH_SHORT_HIT_COPY_SRCH_SHORT_RESULT(pssrSrchShortResultsPtr, ppssrSrchShortResultsList[uiI] + puiSrchShortResultsOffsetList[uiI]);
+            }
+        }
+    }
+    
+    /* Sorted short results are merged off a heap of the list entries, ordered on their current short result */
+    else {
+
+        /* Allocate the heap */
+        if ( (puiHeap = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiSrchShortResultsListLength))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchShortResultMerge;
+        }
+
+        /* Add all the non-empty short results arrays to the heap */
+        for ( uiI = 0, uiHeapLength = 0; uiI < uiSrchShortResultsListLength; uiI++ ) {
+            if ( (ppssrSrchShortResultsList[uiI] != NULL) && (puiSrchShortResultsLengthList[uiI] > 0) ) {
+                puiHeap[uiHeapLength++] = uiI;
+            }
+        }
+
+        /* Heapify */
+        for ( uiI = uiHeapLength / 2; uiI > 0; uiI-- ) {
+            iSrchShortResultMergeSiftDown(ppssrSrchShortResultsList, puiSrchShortResultsOffsetList, puiHeap, uiHeapLength, uiI - 1, uiSortType);
+        }
+
+        /* Pull the short results off the top of the heap */
+        for ( pssrSrchShortResultsPtr = pssrSrchShortResults; pssrSrchShortResultsPtr < (pssrSrchShortResults + uiSrchShortResultsLength); pssrSrchShortResultsPtr++ ) {
+
+            ASSERT(uiHeapLength > 0);
+
+            /* Copy the short result at the top of the heap, note that we copy the whole structure to get the sort key */
+            uiJ = puiHeap[0];
+            *pssrSrchShortResultsPtr = *(ppssrSrchShortResultsList[uiJ] + puiSrchShortResultsOffsetList[uiJ]);
+            
+            /* Replace the top of the heap with the last entry if we have run out of short results in this array */
+            if ( ++puiSrchShortResultsOffsetList[uiJ] == puiSrchShortResultsLengthList[uiJ] ) {
+                puiHeap[0] = puiHeap[--uiHeapLength];
+            }
+
+            /* Restore the heap */
+            if ( uiHeapLength > 1 ) {
+                iSrchShortResultMergeSiftDown(ppssrSrchShortResultsList, puiSrchShortResultsOffsetList, puiHeap, uiHeapLength, 0, uiSortType);
+            }
+        }
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchShortResultMerge:
+
+
+    /* Release the short results arrays in the list, along with the character sort keys of the short results that were not merged */
+    for ( uiI = 0; uiI < uiSrchShortResultsListLength; uiI++ ) {
+    
+        if ( ppssrSrchShortResultsList[uiI] != NULL ) {
+
+            if ( (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_ASC) || (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_DESC) ) {
+                for ( uiJ = (puiSrchShortResultsOffsetList != NULL) ? puiSrchShortResultsOffsetList[uiI] : 0; uiJ < puiSrchShortResultsLengthList[uiI]; uiJ++ ) {
+                    s_free((ppssrSrchShortResultsList[uiI] + uiJ)->pucSortKey);
+                }
+            }
+
+            s_free(ppssrSrchShortResultsList[uiI]);
+        }
+
+        puiSrchShortResultsLengthList[uiI] = 0;
+    }
+
+    /* Free the offsets list and the heap */
+    s_free(puiSrchShortResultsOffsetList);
+    s_free(puiHeap);
+
+
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
+
+        /* Set the return pointers */
+        *ppssrSrchShortResults = pssrSrchShortResults;
+        *puiSrchShortResultsLength = uiSrchShortResultsLength;
+    }
+    else {
+    
+        /* Free the merged short results, the character sort keys have not been handed over if we failed */
+        s_free(pssrSrchShortResults);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchShortResultFree()
@@ -1299,9 +1550,15 @@ static int iSrchSearchGetCorrelationCoefficient
 
     Purpose:    This function sorts the short results array using quicksort.
 
-    Parameters: pssrSrchShortResults        pointer to an array of short result structures
-                uiSrchShortResultsLength    number of entries in the array of short result structures
-                uiSortType                  sort type
+                Only the entries up to the limit index are guaranteed to be 
+                sorted, partitions which lie entirely past the limit index 
+                are left alone, which turns the quicksort into a partial 
+                sort when only the top of the array is needed.
+
+    Parameters: pssrSrchShortResults            pointer to an array of short result structures
+                uiSrchShortResultsLength        number of entries in the array of short result structures
+                uiSrchShortResultsLimitIndex    index past which the array of short result structures does not need to be sorted
+                uiSortType                      sort type
 
     Globals:    none
 
@@ -1312,6 +1569,7 @@ static int iSrchShortResultQuickSort
 (
     struct srchShortResult *pssrSrchShortResults,
     unsigned int uiSrchShortResultsLength,
+    unsigned int uiSrchShortResultsLimitIndex,
     unsigned int uiSortType
 )
 {
@@ -1321,48 +1579,49 @@ static int iSrchShortResultQuickSort
 
     ASSERT(pssrSrchShortResults != NULL);
     ASSERT(uiSrchShortResultsLength >= 0);
+    ASSERT(uiSrchShortResultsLimitIndex < uiSrchShortResultsLength);
 
 
     switch ( uiSortType ) {
 
         case SRCH_SHORT_RESULTS_SORT_TYPE_DOUBLE_ASC:
-            iError = iSrchShortResultQuickSortDoubleAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortDoubleAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
 
         case SRCH_SHORT_RESULTS_SORT_TYPE_DOUBLE_DESC:
-            iError = iSrchShortResultQuickSortDoubleDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortDoubleDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
 
         case SRCH_SHORT_RESULTS_SORT_TYPE_FLOAT_ASC:
-            iError = iSrchShortResultQuickSortFloatAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortFloatAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
 
         case SRCH_SHORT_RESULTS_SORT_TYPE_FLOAT_DESC:
-            iError = iSrchShortResultQuickSortFloatDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortFloatDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
         
         case SRCH_SHORT_RESULTS_SORT_TYPE_UINT_ASC:
-            iError = iSrchShortResultQuickSortUIntAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortUIntAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
 
         case SRCH_SHORT_RESULTS_SORT_TYPE_UINT_DESC:
-            iError = iSrchShortResultQuickSortUIntDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortUIntDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
         
         case SRCH_SHORT_RESULTS_SORT_TYPE_ULLONG_ASC:
-            iError = iSrchShortResultQuickSortULongAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortULongAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
 
         case SRCH_SHORT_RESULTS_SORT_TYPE_ULONG_DESC:
-            iError = iSrchShortResultQuickSortULongDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortULongDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
         
         case SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_ASC:
-            iError = iSrchShortResultQuickSortCharAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortCharAsc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
 
         case SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_DESC:
-            iError = iSrchShortResultQuickSortCharDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1);
+            iError = iSrchShortResultQuickSortCharDesc(pssrSrchShortResults, 0, uiSrchShortResultsLength - 1, uiSrchShortResultsLimitIndex);
             break;
         
         case SRCH_SHORT_RESULTS_SORT_TYPE_NO_SORT:
@@ -1395,6 +1654,7 @@ static int iSrchShortResultQuickSort
     Parameters: pssrSrchShortResults        pointer to a short result structure array
                 iSrchShortResultsLeftIndex  left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1405,7 +1665,8 @@ static int iSrchShortResultQuickSortDoubleAsc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -1443,8 +1704,12 @@ static int iSrchShortResultQuickSortDoubleAsc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_DOUBLE(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
         
-        iSrchShortResultQuickSortDoubleAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortDoubleAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortDoubleAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortDoubleAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
     
 
@@ -1468,6 +1733,7 @@ static int iSrchShortResultQuickSortDoubleAsc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1478,7 +1744,8 @@ static int iSrchShortResultQuickSortDoubleDesc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -1516,8 +1783,12 @@ static int iSrchShortResultQuickSortDoubleDesc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_DOUBLE(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
         
-        iSrchShortResultQuickSortDoubleDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortDoubleDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortDoubleDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortDoubleDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
     
 
@@ -1541,6 +1812,7 @@ static int iSrchShortResultQuickSortDoubleDesc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1551,7 +1823,8 @@ static int iSrchShortResultQuickSortFloatAsc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -1589,8 +1862,12 @@ static int iSrchShortResultQuickSortFloatAsc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_FLOAT(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
         
-        iSrchShortResultQuickSortFloatAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortFloatAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortFloatAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortFloatAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
 
     
@@ -1614,6 +1891,7 @@ static int iSrchShortResultQuickSortFloatAsc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1624,7 +1902,8 @@ static int iSrchShortResultQuickSortFloatDesc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -1662,8 +1941,12 @@ static int iSrchShortResultQuickSortFloatDesc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_FLOAT(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
         
-        iSrchShortResultQuickSortFloatDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortFloatDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortFloatDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortFloatDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
 
     
@@ -1687,6 +1970,7 @@ static int iSrchShortResultQuickSortFloatDesc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1697,7 +1981,8 @@ static int iSrchShortResultQuickSortUIntAsc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -1735,8 +2020,12 @@ static int iSrchShortResultQuickSortUIntAsc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_UINT(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
 
-        iSrchShortResultQuickSortUIntAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortUIntAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortUIntAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortUIntAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
 
 
@@ -1760,6 +2049,7 @@ static int iSrchShortResultQuickSortUIntAsc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1770,7 +2060,8 @@ static int iSrchShortResultQuickSortUIntDesc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -1808,8 +2099,12 @@ static int iSrchShortResultQuickSortUIntDesc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_UINT(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
 
-        iSrchShortResultQuickSortUIntDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortUIntDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortUIntDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortUIntDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
 
 
@@ -1833,6 +2128,7 @@ static int iSrchShortResultQuickSortUIntDesc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1843,7 +2139,8 @@ static int iSrchShortResultQuickSortULongAsc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -1881,8 +2178,12 @@ static int iSrchShortResultQuickSortULongAsc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_ULLONG(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
 
-        iSrchShortResultQuickSortULongAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortULongAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortULongAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortULongAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
 
 
@@ -1906,6 +2207,7 @@ static int iSrchShortResultQuickSortULongAsc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1916,7 +2218,8 @@ static int iSrchShortResultQuickSortULongDesc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -1954,8 +2257,12 @@ static int iSrchShortResultQuickSortULongDesc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_ULLONG(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
 
-        iSrchShortResultQuickSortULongDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortULongDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortULongDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortULongDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
 
 
@@ -1979,6 +2286,7 @@ static int iSrchShortResultQuickSortULongDesc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -1989,7 +2297,8 @@ static int iSrchShortResultQuickSortCharAsc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -2027,8 +2336,12 @@ static int iSrchShortResultQuickSortCharAsc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_UCHAR(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
         
-        iSrchShortResultQuickSortCharAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortCharAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortCharAsc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortCharAsc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
     
 
@@ -2052,6 +2365,7 @@ static int iSrchShortResultQuickSortCharAsc
     Parameters: pssrSrchShortResults            pointer to a short result structure array
                 iSrchShortResultsLeftIndex      left hand index in the short result structure array to sort 
                 iSrchShortResultsRightIndex     right hand index in the short result structure array to sort 
+                iSrchShortResultsLimitIndex     index past which the short result structure array does not need to be sorted
 
     Globals:    none
 
@@ -2062,7 +2376,8 @@ static int iSrchShortResultQuickSortCharDesc
 (
     struct srchShortResult *pssrSrchShortResults,
     int iSrchShortResultsLeftIndex,
-    int iSrchShortResultsRightIndex
+    int iSrchShortResultsRightIndex,
+    int iSrchShortResultsLimitIndex
 )
 {
 
@@ -2100,8 +2415,12 @@ static int iSrchShortResultQuickSortCharDesc
             SRCH_SHORT_RESULTS_SWAP_SRCH_SHORT_RESULTS_UCHAR(psrShortResultsRightIndexPtr, (pssrSrchShortResults + iSrchShortResultsLocalLeftIndex));
         }
         
-        iSrchShortResultQuickSortCharDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1);
-        iSrchShortResultQuickSortCharDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex);
+        iSrchShortResultQuickSortCharDesc(pssrSrchShortResults, iSrchShortResultsLeftIndex, iSrchShortResultsLocalLeftIndex - 1, iSrchShortResultsLimitIndex);
+
+        /* The right hand side only needs to be sorted if it overlaps the limit */
+        if ( iSrchShortResultsLocalLeftIndex < iSrchShortResultsLimitIndex ) {
+            iSrchShortResultQuickSortCharDesc(pssrSrchShortResults, iSrchShortResultsLocalLeftIndex + 1, iSrchShortResultsRightIndex, iSrchShortResultsLimitIndex);
+        }
     }
 
     
@@ -2833,4 +3152,167 @@ static int iSrchShortResultRadixSortULong
 }
 
 
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchShortResultMergeSiftDown()
+
+    Purpose:    This functions sifts down an entry in the merge heap used by 
+                iSrchShortResultMerge(). The heap contains offsets into the
+                short results arrays list and is ordered on the current short 
+                result in each short results array, ties are broken on the 
+                list offset so the merge is stable.
+
+    Parameters: ppssrSrchShortResultsList           list of short results arrays
+                puiSrchShortResultsOffsetList       list of current offsets in the short results arrays
+                puiHeap                             heap
+                uiHeapLength                        heap length
+                uiHeapIndex                         heap index of the entry to sift down
+                uiSortType                          sort type (SPI_SORT_TYPE_*)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchShortResultMergeSiftDown
+(
+    struct srchShortResult **ppssrSrchShortResultsList,
+    unsigned int *puiSrchShortResultsOffsetList,
+    unsigned int *puiHeap,
+    unsigned int uiHeapLength,
+    unsigned int uiHeapIndex,
+    unsigned int uiSortType
+)
+{
+
+    unsigned int    uiChildHeapIndex = 0;
+    unsigned int    uiHeapEntry = 0;
+
+
+    ASSERT(ppssrSrchShortResultsList != NULL);
+    ASSERT(puiSrchShortResultsOffsetList != NULL);
+    ASSERT(puiHeap != NULL);
+    ASSERT(uiHeapIndex < uiHeapLength);
+
+
+    /* Get the entry we are sifting down */
+    uiHeapEntry = puiHeap[uiHeapIndex];
+
+    /* Sift down */
+    while ( (uiChildHeapIndex = (uiHeapIndex * 2) + 1) < uiHeapLength ) {
+
+        /* Pick the child which comes first */
+        if ( ((uiChildHeapIndex + 1) < uiHeapLength) && 
+                (bSrchShortResultMergePrecedes(ppssrSrchShortResultsList[puiHeap[uiChildHeapIndex + 1]] + puiSrchShortResultsOffsetList[puiHeap[uiChildHeapIndex + 1]], puiHeap[uiChildHeapIndex + 1],
+                        ppssrSrchShortResultsList[puiHeap[uiChildHeapIndex]] + puiSrchShortResultsOffsetList[puiHeap[uiChildHeapIndex]], puiHeap[uiChildHeapIndex], uiSortType) == true) ) {
+            uiChildHeapIndex++;
+        }
+
+        /* Stop if the entry comes before the child */
+        if ( bSrchShortResultMergePrecedes(ppssrSrchShortResultsList[puiHeap[uiChildHeapIndex]] + puiSrchShortResultsOffsetList[puiHeap[uiChildHeapIndex]], puiHeap[uiChildHeapIndex],
+                ppssrSrchShortResultsList[uiHeapEntry] + puiSrchShortResultsOffsetList[uiHeapEntry], uiHeapEntry, uiSortType) == false ) {
+            break;
+        }
+
+        /* Move the child up */
+        puiHeap[uiHeapIndex] = puiHeap[uiChildHeapIndex];
+        uiHeapIndex = uiChildHeapIndex;
+    }
+
+    /* Place the entry */
+    puiHeap[uiHeapIndex] = uiHeapEntry;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   bSrchShortResultMergePrecedes()
+
+    Purpose:    This functions returns true if the first short result comes before
+                the second short result in the sort order, ties are broken on the 
+                list offsets of the short results arrays they came from.
+
+    Parameters: pssrSrchShortResult1    first short result
+                uiListIndex1            list offset of the short results array for the first short result
+                pssrSrchShortResult2    second short result
+                uiListIndex2            list offset of the short results array for the second short result
+                uiSortType              sort type (SPI_SORT_TYPE_*)
+
+    Globals:    none
+
+    Returns:    true if the first short result comes first, false if not
+
+*/
+static boolean bSrchShortResultMergePrecedes
+(
+    struct srchShortResult *pssrSrchShortResult1,
+    unsigned int uiListIndex1,
+    struct srchShortResult *pssrSrchShortResult2,
+    unsigned int uiListIndex2,
+    unsigned int uiSortType
+)
+{
+
+    int     iComparison = 0;
+
+
+    ASSERT(pssrSrchShortResult1 != NULL);
+    ASSERT(pssrSrchShortResult2 != NULL);
+
+
+    switch ( uiSortType ) {
+
+        case SRCH_SHORT_RESULTS_SORT_TYPE_DOUBLE_ASC:
+        case SRCH_SHORT_RESULTS_SORT_TYPE_DOUBLE_DESC:
+            iComparison = (pssrSrchShortResult1->dSortKey < pssrSrchShortResult2->dSortKey) ? -1 : ((pssrSrchShortResult1->dSortKey > pssrSrchShortResult2->dSortKey) ? 1 : 0);
+            break;
+
+        case SRCH_SHORT_RESULTS_SORT_TYPE_FLOAT_ASC:
+        case SRCH_SHORT_RESULTS_SORT_TYPE_FLOAT_DESC:
+            iComparison = (pssrSrchShortResult1->fSortKey < pssrSrchShortResult2->fSortKey) ? -1 : ((pssrSrchShortResult1->fSortKey > pssrSrchShortResult2->fSortKey) ? 1 : 0);
+            break;
+
+        case SRCH_SHORT_RESULTS_SORT_TYPE_UINT_ASC:
+        case SRCH_SHORT_RESULTS_SORT_TYPE_UINT_DESC:
+            iComparison = (pssrSrchShortResult1->uiSortKey < pssrSrchShortResult2->uiSortKey) ? -1 : ((pssrSrchShortResult1->uiSortKey > pssrSrchShortResult2->uiSortKey) ? 1 : 0);
+            break;
+
+        case SRCH_SHORT_RESULTS_SORT_TYPE_ULLONG_ASC:
+        case SRCH_SHORT_RESULTS_SORT_TYPE_ULONG_DESC:
+            iComparison = (pssrSrchShortResult1->ulSortKey < pssrSrchShortResult2->ulSortKey) ? -1 : ((pssrSrchShortResult1->ulSortKey > pssrSrchShortResult2->ulSortKey) ? 1 : 0);
+            break;
+
+        case SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_ASC:
+        case SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_DESC:
+            iComparison = s_strcoll(pssrSrchShortResult1->pucSortKey, pssrSrchShortResult2->pucSortKey);
+            break;
+
+        default:
+            break;
+    }
+
+
+    /* Flip the comparison for descending sort orders */
+    if ( (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_DOUBLE_DESC) || (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_FLOAT_DESC) || 
+            (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_UINT_DESC) || (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_ULONG_DESC) || 
+            (uiSortType == SRCH_SHORT_RESULTS_SORT_TYPE_UCHAR_DESC) ) {
+        iComparison = -iComparison;
+    }
+
+
+    return ((iComparison < 0) || ((iComparison == 0) && (uiListIndex1 < uiListIndex2))) ? true : false;
+
+}
+
+
 /*---------------------------------------------------------------------------*/
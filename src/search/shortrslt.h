@@ -79,13 +79,19 @@ struct srchShortResult {
 */
 
 int iSrchShortResultSort (struct srchShortResult **ppssrSrchShortResults, 
-        unsigned int uiSrchShortResultsLeftIndex, unsigned int uiSortType);
+        unsigned int uiSrchShortResultsLeftIndex, unsigned int uiSrchShortResultsEndIndex, 
+        unsigned int uiSortType);
 
 
 int iSrchShortResultSplice (struct srchShortResult **ppssrSrchShortResults,
         unsigned int *puiSrchShortResultsLength, unsigned int uiSrchShortResultsStartIndex, 
         unsigned int uiSrchShortResultsEndIndex, unsigned int uiSortType);
 
+int iSrchShortResultMerge (struct srchShortResult **ppssrSrchShortResultsList, 
+        unsigned int *puiSrchShortResultsLengthList, unsigned int uiSrchShortResultsListLength, 
+        unsigned int uiSrchShortResultsEndIndex, unsigned int uiSortType, 
+        struct srchShortResult **ppssrSrchShortResults, unsigned int *puiSrchShortResultsLength);
+
 
 int iSrchShortResultFree (struct srchShortResult *pssrSrchShortResults, 
         unsigned int uiSrchShortResultsLength, unsigned int uiSortType);
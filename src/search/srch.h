@@ -63,6 +63,7 @@
 #include "weight.h"
 #include "bitmap.h"
 #include "posting.h"
+#include "cursor.h"
 #include "parser.h"
 
 #include "cache.h"
@@ -70,6 +71,7 @@
 #include "feedback.h"
 #include "filepaths.h"
 #include "filter.h"
+#include "forward.h"
 #include "indexer.h"
 #include "info.h"
 #include "invert.h"
@@ -123,6 +123,8 @@ extern "C" {
 /* Bitmap */
 #define SRCH_BitmapInvalidBitmap                                    (-1000)
 #define SRCH_BitmapInvalidName                                      (-1001)
+#define SRCH_BitmapSetBitFailed                                     (-1002)
+#define SRCH_BitmapMergeFailed                                      (-1003)
                 
                 
 /* Cache */                
@@ -166,6 +168,7 @@ extern "C" {
 #define SRCH_DocumentInvalidDataLength                              (-1215)
 #define SRCH_DocumentInvalidURL                                     (-1216)
 #define SRCH_DocumentInvalidFilePath                                (-1217)
+#define SRCH_DocumentInvalidColumnID                                (-1218)
                     
 #define SRCH_DocumentGetNewDocumentIDFailed                         (-1220)
 #define SRCH_DocumentCheckDocumentIDFailed                          (-1221)
@@ -176,6 +179,12 @@ extern "C" {
 #define SRCH_DocumentSaveDocumentTableEntryFailed                   (-1240)
 #define SRCH_DocumentGetDocumentTableEntryFailed                    (-1241)
 
+#define SRCH_DocumentCreateDocumentColumnsFailed                    (-1250)
+#define SRCH_DocumentOpenDocumentColumnsFailed                      (-1251)
+#define SRCH_DocumentSaveDocumentColumnsEntryFailed                 (-1252)
+#define SRCH_DocumentCreateDocumentDateIndexFailed                  (-1253)
+#define SRCH_DocumentInvalidDateIndex                               (-1254)
+
 
 /* Feedback */                
 #define SRCH_FeedbackInvalidSearch                                  (-1300)
@@ -327,6 +336,9 @@ extern "C" {
 #define SRCH_InvertBlockObjectGetFailed                             (-1933)
 #define SRCH_InvertBlockObjectStoreFailed                           (-1934)
 #define SRCH_InvertBlockObjectUpdateFailed                          (-1935)
+#define SRCH_InvertInvalidIndexBlockFeatures                        (-1936)
+#define SRCH_InvertDocumentContainersFailed                         (-1937)
+#define SRCH_InvertImpactsFailed                                    (-1938)
                             
                             
 /* Keydict */                                                
@@ -488,6 +500,18 @@ extern "C" {
 #define SRCH_TermDictTermMetaphoneFailed                            (-3019)
 #define SRCH_TermDictTermTypoFailed                                 (-3020)
 #define SRCH_TermDictCharacterSetConvertionFailed                   (-3021)
+#define SRCH_TermDictCreateTermFilterFailed                         (-3022)
+#define SRCH_TermDictOpenTermFilterFailed                           (-3023)
+#define SRCH_TermDictInvalidTermID                                  (-3024)
+#define SRCH_TermDictMissingTermIDs                                 (-3025)
+#define SRCH_TermDictAddTermIDFailed                                (-3026)
+#define SRCH_TermDictCreateTermIDsFailed                            (-3027)
+#define SRCH_TermDictOpenTermIDsFailed                              (-3028)
+#define SRCH_TermDictAddTermIDListFailed                            (-3029)
+#define SRCH_TermDictCreateTermGramsFailed                          (-3030)
+#define SRCH_TermDictOpenTermGramsFailed                            (-3031)
+#define SRCH_TermDictCreatePhoneticKeysFailed                       (-3032)
+#define SRCH_TermDictOpenPhoneticKeysFailed                         (-3033)
                 
                 
 /* TermLen */                
@@ -504,6 +528,8 @@ extern "C" {
 #define SRCH_TermSearchInvalidFrequentTermCoverageThreshold         (-3204)
 #define SRCH_TermSearchInvalidDocumentID                            (-3205)
 #define SRCH_TermSearchGetObjectFailed                              (-3206)
+#define SRCH_TermSearchInvalidIndexBlock                            (-3207)
+#define SRCH_TermSearchDocumentContainersFailed                     (-3208)
 
 
 /* Version */
@@ -514,6 +540,19 @@ extern "C" {
 #define SRCH_WeightInvalidWeight                                    (-3500)
 
 
+/* Cursor */
+#define SRCH_CursorInvalidCursor                                    (-3600)
+#define SRCH_CursorInvalidCursorType                                (-3601)
+
+
+/* Forward */
+#define SRCH_ForwardInvalidDocumentID                               (-3700)
+#define SRCH_ForwardMissingIndex                                    (-3701)
+#define SRCH_ForwardAddTermFailed                                   (-3702)
+#define SRCH_ForwardCreateIndexFailed                               (-3703)
+#define SRCH_ForwardOpenIndexFailed                                 (-3704)
+
+
 
 /*---------------------------------------------------------------------------*/
 
@@ -115,6 +115,8 @@ extern "C" {
 #define SRCH_SEARCH_CONFIG_PARSER_FREQUENT_TERMS                                (unsigned char *)"parser-frequent-terms"
     
 #define SRCH_SEARCH_CONFIG_SEARCH_MAXIMUM_DOCUMENTS_RETURNED                    (unsigned char *)"search-maximum-documents-returned"
+#define SRCH_SEARCH_CONFIG_SEARCH_MAXIMUM_SEGMENT_THREADS                      (unsigned char *)"search-maximum-segment-threads"
+#define SRCH_SEARCH_CONFIG_SEARCH_MAXIMUM_TERM_THREADS                         (unsigned char *)"search-maximum-term-threads"
 #define SRCH_SEARCH_CONFIG_SEARCH_TERM_WEIGHT                                   (unsigned char *)"search-term-weight"
 #define SRCH_SEARCH_CONFIG_SEARCH_FEEDBACK_TERM_WEIGHT                          (unsigned char *)"search-feedback-term-weight"
 #define SRCH_SEARCH_CONFIG_SEARCH_FREQUENT_TERM_COVERAGE_THRESHOLD              (unsigned char *)"search-frequent-term-coverage-threshold"
@@ -134,6 +134,26 @@
 #define SRCH_TERM_DICT_TERM_INFO_ALLOCATION                 (100)
 
 
+/* Term hashes allocation, the term hashes are collected while the term dictionary is being created */
+#define SRCH_TERM_DICT_TERM_HASHES_ALLOCATION               (10000)
+
+/* Term hash, 64 bit FNV-1a */
+#define SRCH_TERM_DICT_TERM_HASH_OFFSET_BASIS               (14695981039346656037UL)
+#define SRCH_TERM_DICT_TERM_HASH_PRIME                      (1099511628211UL)
+
+/* Term filter bit for the hash number of a term hash, the bits are derived from the two 
+** halves of the term hash (double hashing), the second half is made odd so it never is 0
+*/
+#define SRCH_TERM_DICT_TERM_FILTER_BIT(ulMacroTermHash, uiMacroHashNumber, uiMacroBitmapLength) \
+    ((((unsigned int)(ulMacroTermHash)) + ((uiMacroHashNumber) * (((unsigned int)((ulMacroTermHash) >> 32)) | 1))) % (uiMacroBitmapLength))
+
+
+/* Term ID list allocation, the term ID lists of the term grams and the phonetic keys 
+** are collected while the term dictionary is being created
+*/
+#define SRCH_TERM_DICT_TERM_ID_LIST_ALLOCATION              (64)
+
+
 /* Default names */
 #define SRCH_TERM_DICT_SOUNDEX_ID                           LNG_SOUNDEX_STANDARD_ID
 #define SRCH_TERM_DICT_METAPHONE_ID                         LNG_METAPHONE_STANDARD_ID
@@ -157,6 +177,17 @@ struct srchTermDictMatch {
 };
 
 
+/* Search term dict term ID list structure, this is the datum stored in the term 
+** grams and phonetic keys tries, the term IDs are compressed deltas from the previous term ID
+*/
+struct srchTermDictTermIDList {
+    unsigned char   *pucTermIDs;
+    unsigned int    uiTermIDsLength;
+    unsigned int    uiTermIDsCapacity;
+    unsigned int    uiTermIDLast;
+};
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -225,6 +256,65 @@ static int iSrchTermDictPrintSearchTermDictMatch (struct srchTermDictMatch *pstd
         unsigned int uiSrchTermDictMatchLength);
 
 
+/* Term filter functions */
+static unsigned long ulSrchTermDictGetTermHash (unsigned char *pucTerm);
+
+
+/* Term ID functions */
+static int iSrchTermDictUnpackEntry (unsigned char *pucEntryData, unsigned int uiEntryLength, 
+        boolean bTermIDs, unsigned char *pucFieldIDBitmap, unsigned int uiFieldIDBitmapLength, 
+        unsigned int *puiTermType, unsigned int *puiTermCount, unsigned int *puiDocumentCount, 
+        unsigned long *pulIndexBlockID, unsigned int *puiTermID);
+
+static int iSrchTermDictAddTermID (struct srchIndex *psiSrchIndex, unsigned char *pucTerm,
+        unsigned char *pucEntryData, unsigned int uiEntryLength);
+
+static int iSrchTermDictMapTermIDsFile (struct srchIndex *psiSrchIndex, unsigned int uiFileID,
+        void **ppvFile, size_t *pzFileLength);
+
+static void vSrchTermDictRemoveTermIDsFiles (struct srchIndex *psiSrchIndex);
+
+static int iSrchTermDictProcessTermIDList (struct srchIndex *psiSrchIndex, unsigned int *puiTermIDs, 
+        unsigned int uiTermIDsLength, int (*iSrchTermDictCallBackFunction)(), ...);
+
+static int iSrchTermDictAddTermIDToTrie (struct srchIndex *psiSrchIndex, void *pvUtlTrie, 
+        unsigned char *pucKey, unsigned int uiTermID);
+
+static int iSrchTermDictCreateTermIDListsDictionary (void *pvUtlTrie, unsigned char *pucFilePath, 
+        unsigned int uiKeyLength);
+
+static int iSrchTermDictGetTermIDList (void *pvUtlDictionary, unsigned char *pucKey, 
+        unsigned int **ppuiTermIDs, unsigned int *puiTermIDsLength);
+
+static int iSrchTermDictAddTermIDListCallBack (unsigned char *pucKey, void *pvData, va_list ap);
+
+static int iSrchTermDictFreeTermIDListCallBack (unsigned char *pucKey, void *pvData, va_list ap);
+
+static void vSrchTermDictFreeTermIDListsTrie (void **ppvUtlTrie);
+
+
+/* Term gram functions */
+static boolean bSrchTermDictGetTermGram (unsigned char *pucTerm, unsigned char *pucTermGram);
+
+static int iSrchTermDictAddTermGrams (struct srchIndex *psiSrchIndex, unsigned char *pucTerm, 
+        unsigned int uiTermID);
+
+static int iSrchTermDictLookupTermGrams (struct srchIndex *psiSrchIndex, 
+        struct srchTermDictMatch *pstdmSrchTermDictMatch, unsigned int uiSrchTermDictMatchLength, 
+        unsigned int **ppuiTermIDs, unsigned int *puiTermIDsLength, boolean *pbTermGrams);
+
+
+/* Phonetic key functions */
+static void vSrchTermDictGetPhoneticKeysPointers (struct srchIndex *psiSrchIndex, unsigned int uiTermMatch, 
+        unsigned int *puiIndexBlockFeature, void ***pppvUtlTrie, void ***pppvLngPhonetic, void ***pppvUtlDictionary);
+
+static int iSrchTermDictAddPhoneticKeys (struct srchIndex *psiSrchIndex, unsigned char *pucTerm, 
+        unsigned int uiTermID);
+
+static int iSrchTermDictLookupPhoneticKey (struct srchIndex *psiSrchIndex, unsigned int uiTermMatch, 
+        wchar_t *pwcPhoneticKey, unsigned int **ppuiTermIDs, unsigned int *puiTermIDsLength, boolean *pbTermIDList);
+
+
 /* Regex structure functions */
 #if defined(TRE_REGEX_ENABLE)
 static int iSrchTermDictGetRegexFromTerm (wchar_t *pwcTerm, regex_t **pprRegex);
@@ -257,6 +347,10 @@ static int iSrchTermDictMatchTermToRegex (unsigned char *pucTerm, regex_t *prReg
                 the field ID list into a flat buffer and adds it to the
                 work entry.
 
+                If the index has term IDs, the term is given the next term 
+                ID, which goes into the buffer after the index block ID, and
+                the term is added to the term ID table.
+
     Parameters: psiSrchIndex            Search index structure
                 pucTerm                 Term
                 uiTermType              Term type
@@ -289,6 +383,7 @@ int iSrchTermDictAddTerm
     unsigned char   pucBuffer[SRCH_TERM_LENGTH_MAXIMUM * 2];    /* Should be enough space for info */
     unsigned char   *pucBufferEndPtr = NULL;
     unsigned int    uiBufferLength = 0;
+    boolean         bTermIDs = false;
 
 
     /* Initialize our string variables - optimization as pucString[n] = {'0'} is very expensive */
@@ -336,6 +431,10 @@ int iSrchTermDictAddTerm
     }
 
 
+    /* Term IDs are only given out while the index is being created */
+    bTermIDs = ((psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS) && (psiSrchIndex->psibSrchIndexBuild != NULL)) ? true : false;
+
+
     /* First we create a buffer of information which will be passed to the dictionary */
     pucBufferEndPtr = pucBuffer;
 
@@ -351,6 +450,11 @@ int iSrchTermDictAddTerm
     /* Write out the index block ID (increments the pointer) */
     UTL_NUM_WRITE_COMPRESSED_ULONG(ulIndexBlockID, pucBufferEndPtr);
 
+    /* Write out the term ID, this is the next term ID (increments the pointer) */
+    if ( bTermIDs == true ) {
+        UTL_NUM_WRITE_COMPRESSED_UINT(psiSrchIndex->psibSrchIndexBuild->uiTermIDsLength + 1, pucBufferEndPtr);
+    }
+
 
     /* Write out the field IDs */
     if ( (pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0) ) {
@@ -377,6 +481,53 @@ int iSrchTermDictAddTerm
     }
 
 
+    /* Add the term and the buffer to the term ID table, this gives the term its term ID */
+    if ( bTermIDs == true ) {
+        if ( (iError = iSrchTermDictAddTermID(psiSrchIndex, pucTerm, pucBuffer, uiBufferLength)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+
+    /* Add the term grams of the term, they point to the term ID the term was just given */
+    if ( (bTermIDs == true) && (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_GRAMS) ) {
+        if ( (iError = iSrchTermDictAddTermGrams(psiSrchIndex, pucTerm, psiSrchIndex->psibSrchIndexBuild->uiTermIDsLength)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+
+    /* Add the phonetic keys of the term, they point to the term ID the term was just given */
+    if ( (bTermIDs == true) && (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURES_PHONETIC_KEYS) ) {
+        if ( (iError = iSrchTermDictAddPhoneticKeys(psiSrchIndex, pucTerm, psiSrchIndex->psibSrchIndexBuild->uiTermIDsLength)) != SRCH_NoError ) {
+            return (iError);
+        }
+    }
+
+
+    /* Add the term hash to the term hashes, these are used to create the term filter when the index is closed */
+    if ( psiSrchIndex->psibSrchIndexBuild != NULL ) {
+
+        /* Extend the term hashes if needed */
+        if ( psiSrchIndex->psibSrchIndexBuild->ulTermHashesLength == psiSrchIndex->psibSrchIndexBuild->ulTermHashesCapacity ) {
+
+            unsigned long   ulTermHashesCapacity = (psiSrchIndex->psibSrchIndexBuild->ulTermHashesCapacity > 0) ? 
+                    (psiSrchIndex->psibSrchIndexBuild->ulTermHashesCapacity * 2) : SRCH_TERM_DICT_TERM_HASHES_ALLOCATION;
+            unsigned long   *pulTermHashesPtr = NULL;
+
+            if ( (pulTermHashesPtr = (unsigned long *)s_realloc(psiSrchIndex->psibSrchIndexBuild->pulTermHashes, (size_t)(sizeof(unsigned long) * ulTermHashesCapacity))) == NULL ) {
+                return (SRCH_MemError);
+            }
+
+            psiSrchIndex->psibSrchIndexBuild->pulTermHashes = pulTermHashesPtr;
+            psiSrchIndex->psibSrchIndexBuild->ulTermHashesCapacity = ulTermHashesCapacity;
+        }
+
+        psiSrchIndex->psibSrchIndexBuild->pulTermHashes[psiSrchIndex->psibSrchIndexBuild->ulTermHashesLength] = ulSrchTermDictGetTermHash(pucTerm);
+        psiSrchIndex->psibSrchIndexBuild->ulTermHashesLength++;
+    }
+
+
     return (SRCH_NoError);
 
 }
@@ -403,6 +554,8 @@ int iSrchTermDictAddTerm
                 puiTermCount            return pointer for the term count
                 puiDocumentCount        return pointer for the document count
                 pulIndexBlockID         return pointer for the index block ID
+                puiTermID               return pointer for the term ID, SRCH_TERMDICT_TERM_ID_INVALID
+                                        if the index does not have term IDs
 
     Globals:    none
 
@@ -418,12 +571,14 @@ int iSrchTermDictLookup
     unsigned int *puiTermType,
     unsigned int *puiTermCount,
     unsigned int *puiDocumentCount,
-    unsigned long *pulIndexBlockID
+    unsigned long *pulIndexBlockID,
+    unsigned int *puiTermID
 )
 {
 
     int     iUtlError = UTL_NoError;
     int     iError = SRCH_NoError;
+    boolean bTermMayExist = true;
 
 
 /*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookup [%s]", pucTerm); */
@@ -465,10 +620,23 @@ int iSrchTermDictLookup
         return (SRCH_ReturnParameterError);
     }
 
+    if ( puiTermID == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiTermID' parameter passed to 'iSrchTermDictLookup'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Check the term filter, there is no need to look up the term if it is definitely not in the dictionary */
+    if ( (psiSrchIndex->pstdfSrchTermDictFilter != NULL) && 
+            (iSrchTermDictCheckTermFilter(psiSrchIndex, pucTerm, &bTermMayExist) == SRCH_NoError) && (bTermMayExist == false) ) {
+        return (SRCH_TermDictTermNotFound);
+    }
+
 
     /* Look up the term, note that we pass iError as a parameter to the call back function */
     iUtlError = iUtlDictProcessEntry(psiSrchIndex->pvUtlTermDictionary, pucTerm, (int (*)())iSrchTermDictLookupCallBack, 
-            pucFieldIDBitmap, uiFieldIDBitmapLength, puiTermType, puiTermCount, puiDocumentCount, pulIndexBlockID, &iError);
+            (unsigned int)((psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS) ? true : false), 
+            pucFieldIDBitmap, uiFieldIDBitmapLength, puiTermType, puiTermCount, puiDocumentCount, pulIndexBlockID, puiTermID, &iError);
 
     /* Handle the error */
     if ( iUtlError == UTL_DictKeyNotFound ) {
@@ -488,6 +656,124 @@ int iSrchTermDictLookup
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchTermDictLookupTermID()
+
+    Purpose:    This function looks up a term ID in the term ID table, 
+                returning the term and the data for it from its term 
+                dictionary entry.
+
+                The term points into the term ID table and must not be 
+                released.
+
+    Parameters: psiSrchIndex            search index structure
+                uiTermID                term ID
+                pucFieldIDBitmap        field ID bitmap (optional)
+                uiFieldIDBitmapLength   field ID bitmap length (optional)
+                ppucTerm                return pointer for the term
+                puiTermType             return pointer for the term type
+                puiTermCount            return pointer for the term count
+                puiDocumentCount        return pointer for the document count
+                pulIndexBlockID         return pointer for the index block ID
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictLookupTermID
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiTermID,
+    unsigned char *pucFieldIDBitmap,
+    unsigned int uiFieldIDBitmapLength,
+    unsigned char **ppucTerm,
+    unsigned int *puiTermType,
+    unsigned int *puiTermCount,
+    unsigned int *puiDocumentCount,
+    unsigned long *pulIndexBlockID
+)
+{
+
+    struct srchTermDictTermIDs  *pstdtiSrchTermDictTermIDs = NULL;
+    unsigned char               *pucTerm = NULL;
+    unsigned char               *pucEntryData = NULL;
+    unsigned int                uiEntryTermID = SRCH_TERMDICT_TERM_ID_INVALID;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( psiSrchIndex->pstdtiSrchTermDictTermIDs == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Missing term ID table in the 'psiSrchIndex' parameter passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_TermDictMissingTermIDs);
+    }
+
+    if ( (uiTermID == SRCH_TERMDICT_TERM_ID_INVALID) || (uiTermID > psiSrchIndex->pstdtiSrchTermDictTermIDs->uiTermIDMaximum) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiTermID' parameter passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_TermDictInvalidTermID);
+    }
+
+    if ( ((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength > 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength <= 0)) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'pucFieldIDBitmap' & 'uiFieldIDBitmapLength' parameters passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_TermDictInvalidFieldIDBitmap);
+    }
+
+    if ( ppucTerm == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppucTerm' parameter passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiTermType == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiTermType' parameter passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiTermCount == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiTermCount' parameter passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiDocumentCount == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiDocumentCount' parameter passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( pulIndexBlockID == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pulIndexBlockID' parameter passed to 'iSrchTermDictLookupTermID'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Dereference the term ID table for convenience */
+    pstdtiSrchTermDictTermIDs = psiSrchIndex->pstdtiSrchTermDictTermIDs;
+
+    /* Get the term, the term dictionary entry follows it and runs to the start of the next term */
+    pucTerm = pstdtiSrchTermDictTermIDs->pucData + pstdtiSrchTermDictTermIDs->pulTermOffsets[uiTermID];
+    pucEntryData = pucTerm + s_strlen(pucTerm) + 1;
+
+    ASSERT(pucEntryData < (pstdtiSrchTermDictTermIDs->pucData + pstdtiSrchTermDictTermIDs->pulTermOffsets[uiTermID + 1]));
+
+
+    /* Set the return pointer */
+    *ppucTerm = pucTerm;
+
+
+    /* Unpack the entry */
+    return (iSrchTermDictUnpackEntry(pucEntryData, 
+            (unsigned int)((pstdtiSrchTermDictTermIDs->pucData + pstdtiSrchTermDictTermIDs->pulTermOffsets[uiTermID + 1]) - pucEntryData), 
+            true, pucFieldIDBitmap, uiFieldIDBitmapLength, puiTermType, puiTermCount, puiDocumentCount, pulIndexBlockID, &uiEntryTermID));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchTermDictLookupList()
@@ -568,6 +854,10 @@ int iSrchTermDictLookupList
 
     unsigned int                uiKeyGenerator = SRCH_TERM_DICT_KEY_FROM_INVALID;
 
+    unsigned int                *puiTermIDs = NULL;
+    unsigned int                uiTermIDsLength = 0;
+    boolean                     bTermIDList = false;
+
 
     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupList [%s][field ID bitmap %sdefined][%u][%u]", 
             pucUtlStringsGetPrintableString(pucTerm), (pucFieldIDBitmap != NULL) ? "" : "not ", uiTermMatch, uiRangeID);
@@ -743,6 +1033,18 @@ int iSrchTermDictLookupList
             pwcCharacterListStatic[1] = L'\0';
             pwcCharacterList = pwcCharacterListStatic;
 
+            /* Look up the terms which contain the term grams of the term if it starts with a wildcard, 
+            ** this saves us from having to scan the whole term dictionary, the terms still get
+            ** matched against the term in the callback function
+            */
+            if ( (pwcCharacterListStatic[0] == L' ') && (psiSrchIndex->pvUtlTermGramsDictionary != NULL) && 
+                    (psiSrchIndex->pstdtiSrchTermDictTermIDs != NULL) ) {
+                if ( (iError = iSrchTermDictLookupTermGrams(psiSrchIndex, pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, 
+                        &puiTermIDs, &uiTermIDsLength, &bTermIDList)) != SRCH_NoError ) {
+                    goto bailFromiSrchTermDictLookupList;
+                }
+            }
+
             /* Create the encoded term from the part of the term that is before the first wildcard
             ** so the term 'comp*ing' will yield 'comp' as the encoded term
             */
@@ -1161,6 +1463,17 @@ int iSrchTermDictLookupList
     }    
 
 
+    /* Look up the terms which have the same phonetic key as the term in the phonetic key dictionary, 
+    ** this saves us from having to get the phonetic key of every term in the character list ranges,
+    ** the terms still get matched against the character list in the callback function
+    */
+    if ( SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == true ) {
+        if ( (iError = iSrchTermDictLookupPhoneticKey(psiSrchIndex, uiTermMatch, pwcEncodedTerm, &puiTermIDs, &uiTermIDsLength, &bTermIDList)) != SRCH_NoError ) {
+            goto bailFromiSrchTermDictLookupList;
+        }
+    }
+
+
 
     /* Get the encoded term length */
     uiEncodedTermLength = s_wcslen(pwcEncodedTerm);
@@ -1298,12 +1611,20 @@ int iSrchTermDictLookupList
 /*         iUtlLogDebug(UTL_LOG_CONTEXT, "pucKey [%s], wcCharacter [%lc][%d]", pucKey, wcCharacter, (wint_t)wcCharacter); */
 
 
+        /* Look up the terms we got from the term grams or the phonetic keys */
+        if ( bTermIDList == true ) {
+            
+            iSrchTermDictProcessTermIDList(psiSrchIndex, puiTermIDs, uiTermIDsLength, (int (*)())iSrchTermDictLookupListCallBack, uiTermMatch, 
+                    (unsigned int)bCaseSensitive, wcCharacter, pwcEncodedTerm, uiEncodedTermLength, pstdmSrchTermDictMatch, uiSrchTermDictMatchLength,
+                    prRegex, pvHandle, (unsigned int)true, pucFieldIDBitmap, uiFieldIDBitmapLength, &pstdiSrchTermDictInfos, &uiSrchTermDictInfosLength, &iPassedError);
+        }
         /* Look up the keys list - as a list */
-        if ( (uiTermMatch != SRCH_TERMDICT_TERM_MATCH_RANGE) && (uiTermMatch != SRCH_TERMDICT_TERM_MATCH_TERM_RANGE) ) {
+        else if ( (uiTermMatch != SRCH_TERMDICT_TERM_MATCH_RANGE) && (uiTermMatch != SRCH_TERMDICT_TERM_MATCH_TERM_RANGE) ) {
             
             if ( (iError = iUtlDictProcessEntryList(psiSrchIndex->pvUtlTermDictionary, pucKey, (int (*)())iSrchTermDictLookupListCallBack, uiTermMatch, 
                     (unsigned int)bCaseSensitive, wcCharacter, pwcEncodedTerm, uiEncodedTermLength, pstdmSrchTermDictMatch, uiSrchTermDictMatchLength,
-                    prRegex, pvHandle, pucFieldIDBitmap, uiFieldIDBitmapLength, &pstdiSrchTermDictInfos, &uiSrchTermDictInfosLength, &iPassedError)) != UTL_NoError ) {
+                    prRegex, pvHandle, (unsigned int)((psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS) ? true : false), 
+                    pucFieldIDBitmap, uiFieldIDBitmapLength, &pstdiSrchTermDictInfos, &uiSrchTermDictInfosLength, &iPassedError)) != UTL_NoError ) {
 
                 iUtlLogError(UTL_LOG_CONTEXT, "Failed to loop over the term dictionary, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
 
@@ -1322,7 +1643,8 @@ int iSrchTermDictLookupList
             if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE) ) {
 
                 if ( (iError = iUtlDictProcessEntryList(psiSrchIndex->pvUtlTermDictionary, pucKey, (int (*)())iSrchTermDictLookupRangeCallBack, 
-                        uiDictRangeMatchTerm, wcCharacter, iTermStartNumber, iTermEndNumber, uiRangeID, uiDictCaseScan, pucFieldIDBitmap, uiFieldIDBitmapLength, 
+                        uiDictRangeMatchTerm, wcCharacter, iTermStartNumber, iTermEndNumber, uiRangeID, uiDictCaseScan, 
+                        (unsigned int)((psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS) ? true : false), pucFieldIDBitmap, uiFieldIDBitmapLength, 
                         &pstdiSrchTermDictInfos, &uiSrchTermDictInfosLength, &iPassedError)) != UTL_NoError ) {
 
                     iUtlLogError(UTL_LOG_CONTEXT, "Failed to loop over the term dictionary, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
@@ -1339,7 +1661,8 @@ int iSrchTermDictLookupList
             else if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE) ) {
 
                 if ( (iError = iUtlDictProcessEntryList(psiSrchIndex->pvUtlTermDictionary, pucKey, (int (*)())iSrchTermDictLookupRangeCallBack, 
-                        uiDictRangeMatchTerm, wcCharacter, pwcTermStart, pwcTermEnd, uiRangeID, uiDictCaseScan, pucFieldIDBitmap, uiFieldIDBitmapLength, 
+                        uiDictRangeMatchTerm, wcCharacter, pwcTermStart, pwcTermEnd, uiRangeID, uiDictCaseScan, 
+                        (unsigned int)((psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS) ? true : false), pucFieldIDBitmap, uiFieldIDBitmapLength, 
                         &pstdiSrchTermDictInfos, &uiSrchTermDictInfosLength, &iPassedError)) != UTL_NoError ) {
 
                     iUtlLogError(UTL_LOG_CONTEXT, "Failed to loop over the term dictionary, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
@@ -1409,6 +1732,7 @@ int iSrchTermDictLookupList
 
     s_free(pwcCharacterListAllocated)
     s_free(pwcTerm)
+    s_free(puiTermIDs)
 
     /* Free the regex structure */
     if ( prRegex != NULL ) {
@@ -1518,151 +1842,136 @@ int iSrchTermDictFreeSearchTermDictInfo
 
 
 /*---------------------------------------------------------------------------*/
-/*---------------------------------------------------------------------------*/
+
+
+/* 
+** =====================
+** ===  Term Filter  ===
+** =====================
+*/
 
 
 /*
 
-    Function:   iSrchTermDictLookupCallBack()
+    Function:   iSrchTermDictCreateTermFilter()
 
-    Purpose:    This function is passed to the dictionary lookup function to
-                perform extra processing on a term.
+    Purpose:    This function creates the term filter from the hashes of the 
+                terms which were added to the term dictionary while the index 
+                was being created, it must be called after the last term has
+                been added to the term dictionary.
 
-                If there is a hit, the data will be unpacked and the 
-                return pointers will be populated.
+                The term filter is a bloom filter, it tells us when a term is
+                definitely not in the term dictionary, which saves a lookup 
+                in the term dictionary.
 
-    Parameters: pucKey          key (term)
-                pvEntryData     entry data
-                uiEntryLength   entry length
-                ap              args (optional)
+                The term filter file contains the hash count and the bitmap 
+                length, followed by the bitmap.
+
+    Parameters: psiSrchIndex    search index structure
 
     Globals:    none
 
-    Returns:    0 to continue processing, non-0 otherwise
+    Returns:    SRCH error code
 
 */
-static int iSrchTermDictLookupCallBack
+int iSrchTermDictCreateTermFilter
 (
-    unsigned char *pucKey,
-    void *pvEntryData,
-    unsigned int uiEntryLength,
-    va_list ap
+    struct srchIndex *psiSrchIndex
 )
 {
 
-    va_list         ap_;
-    unsigned char   *pucEntryDataPtr = NULL;
-    unsigned char   *pucEntryDataEndPtr = NULL;
-    unsigned char   *pucFieldIDBitmap = NULL;
-    unsigned int    uiFieldIDBitmapLength = 0;
-    unsigned int    *puiTermType = NULL;
-    unsigned int    *puiTermCount = NULL;
-    unsigned int    *puiDocumentCount = NULL;
-    unsigned long   *pulIndexBlockID = NULL;
-    int             *piError = NULL;
-    unsigned int    uiTermType = 0;
-    unsigned int    uiTermCount = 0;
-    unsigned int    uiDocumentCount = 0;
-    unsigned long   ulIndexBlockID = 0;
-    unsigned int    uiFieldID = 0;
-
+    int             iError = SRCH_NoError;
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    FILE            *pfFile = NULL;
+    unsigned char   *pucBitmap = NULL;
+    unsigned long   ulBitmapLength = 0;
+    unsigned int    uiBitmapLength = 0;
+    unsigned int    uiHashCount = SRCH_TERMDICT_TERM_FILTER_HASH_COUNT;
+    unsigned long   ulI = 0;
+    unsigned int    uiI = 0;
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupCallBack [%s][%u][%s]", pucKey, uiEntryLength, */
-/*             (pvEntryData != NULL) ? "(pvEntryData != NULL)" : "(pvEntryData == NULL)" ); */
 
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictCreateTermFilter'."); 
+        return (SRCH_InvalidIndex);
+    }
 
-    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
-    ASSERT(pvEntryData != NULL);
-    ASSERT(uiEntryLength > 0);
 
+    /* Nothing to create if no terms were added to the term dictionary */
+    if ( (psiSrchIndex->psibSrchIndexBuild == NULL) || (psiSrchIndex->psibSrchIndexBuild->pulTermHashes == NULL) || 
+            (psiSrchIndex->psibSrchIndexBuild->ulTermHashesLength == 0) ) {
+        return (SRCH_NoError);
+    }
 
-    /* Get all our parameters, note that we make a copy of 'ap' */
-    va_copy(ap_, ap);
-    pucFieldIDBitmap = (unsigned char *)va_arg(ap_, unsigned char *);
-    uiFieldIDBitmapLength = (unsigned int)va_arg(ap_, unsigned int);
-    puiTermType = (unsigned int *)va_arg(ap_, unsigned int *);
-    puiTermCount = (unsigned int *)va_arg(ap_, unsigned int *);
-    puiDocumentCount = (unsigned int *)va_arg(ap_, unsigned int *);
-    pulIndexBlockID = (unsigned long *)va_arg(ap_, unsigned long *);
-    piError = (int *)va_arg(ap_, int *);
-    va_end(ap_);
 
+    /* Work out the bitmap length */
+    ulBitmapLength = UTL_MACROS_MAX(psiSrchIndex->psibSrchIndexBuild->ulTermHashesLength * SRCH_TERMDICT_TERM_FILTER_BITS_PER_TERM, SRCH_TERMDICT_TERM_FILTER_BITS_MINIMUM);
+    uiBitmapLength = (unsigned int)UTL_MACROS_MIN(ulBitmapLength, UINT_MAX);
 
-    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
-    ASSERT(puiTermType != NULL);
-    ASSERT(puiTermCount != NULL);
-    ASSERT(puiDocumentCount != NULL);
-    ASSERT(pulIndexBlockID != NULL);
-    ASSERT(piError != NULL);
+    /* Allocate the bitmap */
+    if ( (pucBitmap = (unsigned char *)s_malloc((size_t)(sizeof(unsigned char) * UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchTermDictCreateTermFilter;
+    }
 
+    /* Set the bits for the term hashes */
+    for ( ulI = 0; ulI < psiSrchIndex->psibSrchIndexBuild->ulTermHashesLength; ulI++ ) {
+        for ( uiI = 0; uiI < uiHashCount; uiI++ ) {
+            UTL_BITMAP_SET_BIT_IN_POINTER(pucBitmap, SRCH_TERM_DICT_TERM_FILTER_BIT(psiSrchIndex->psibSrchIndexBuild->pulTermHashes[ulI], uiI, uiBitmapLength));
+        }
+    }
 
-    /* Extract some information from the data pointer, decode to a variable and copy to the pointer for optimization */ 
-    pucEntryDataPtr = (unsigned char *)pvEntryData;
-    UTL_NUM_READ_COMPRESSED_UINT(uiTermType, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_UINT(uiTermCount, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_UINT(uiDocumentCount, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_ULONG(ulIndexBlockID, pucEntryDataPtr);
 
-    *puiTermType = uiTermType;
-    *puiTermCount = uiTermCount;
-    *puiDocumentCount = uiDocumentCount;
-    *pulIndexBlockID = ulIndexBlockID;
+    /* Get the term filter file path */
+    if ( (iError = iSrchFilePathsGetTermFilterFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term filter file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchTermDictCreateTermFilter;
+    }
 
+    /* Create the term filter file */
+    if ( (pfFile = s_fopen(pucFilePath, "w")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term filter file: '%s'.", pucFilePath);
+        iError = SRCH_TermDictCreateTermFilterFailed;
+        goto bailFromiSrchTermDictCreateTermFilter;
+    }
 
-    /* This is not a fielded lookup, so we can just return */
-    if ( pucFieldIDBitmap == NULL ) {
-        
-        /* Set the returned error, the term exists and occurs */
-        *piError = SRCH_NoError;
-                
-/*         iUtlLogDebug(UTL_LOG_CONTEXT, "pucKey [%s], *puiTermType: [%u], puiTermCount: [%u], *puiDocumentCount: [%u], *pulIndexBlockID: [%lu]",  */
-/*                 pucKey, *puiTermType, *puiTermCount, *puiDocumentCount, *pulIndexBlockID); */
-        
-        return (0);
+    /* Write out the hash count, the bitmap length and the bitmap */
+    if ( (s_fwrite(&uiHashCount, sizeof(unsigned int), 1, pfFile) != 1) || (s_fwrite(&uiBitmapLength, sizeof(unsigned int), 1, pfFile) != 1) || 
+            (s_fwrite(pucBitmap, sizeof(unsigned char), UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength), pfFile) != UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength)) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the term filter file: '%s'.", pucFilePath);
+        iError = SRCH_TermDictCreateTermFilterFailed;
+        goto bailFromiSrchTermDictCreateTermFilter;
     }
 
 
-    /* We need to check that this term occurs in the field specified by the passed field ID */
-    pucEntryDataEndPtr = (unsigned char *)pvEntryData + uiEntryLength;
 
-    /* Scan the field IDs */
-    while ( pucEntryDataPtr < pucEntryDataEndPtr ) {
+    /* Bail label */
+    bailFromiSrchTermDictCreateTermFilter:
 
-        /* Decode the field ID */
-        UTL_NUM_READ_COMPRESSED_UINT(uiFieldID, pucEntryDataPtr);
 
-        ASSERT(uiFieldID <= uiFieldIDBitmapLength); 
+    /* Close the file */
+    if ( pfFile != NULL ) {
+        s_fclose(pfFile);
+    }
 
-        /* Check for a match - field ID 0 is not a field */
-        if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucFieldIDBitmap, uiFieldID - 1) ) {
-            
-            /* Set the returned error, the term exists and occurs in the specified field */
-            *piError = SRCH_NoError;
-            
-/*             iUtlLogDebug(UTL_LOG_CONTEXT, "pucKey [%s], *puiTermType: [%u], puiTermCount: [%u], *puiDocumentCount: [%u], *pulIndexBlockID: [%lu], uiFieldID: [%u]",  */
-/*                     pucKey, *puiTermType, *puiTermCount, *puiDocumentCount, *pulIndexBlockID, uiFieldID); */
+    /* Free the bitmap */
+    s_free(pucBitmap);
 
-            return (0);
+    /* Free the term hashes, they are not needed anymore */
+    s_free(psiSrchIndex->psibSrchIndexBuild->pulTermHashes);
+    psiSrchIndex->psibSrchIndexBuild->ulTermHashesLength = 0;
+    psiSrchIndex->psibSrchIndexBuild->ulTermHashesCapacity = 0;
+
+    /* Remove the term filter file if we failed to create it, it will not be used */
+    if ( iError != SRCH_NoError ) {
+        if ( iSrchFilePathsGetTermFilterFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1) == SRCH_NoError ) {
+            s_remove(pucFilePath);
         }
     }
 
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "Dropped pucKey [%s]", pucKey); */
-
-
-    /* Dropped through from the field check without finding the term in the specific field,
-    ** so we set the term count and doc count to 0, but we leave the work type alone 
-    */
-    *puiTermCount = 0;    
-    *puiDocumentCount = 0;    
-    *pulIndexBlockID = 0;    
-    
-
-    /* Set the returned error, the term exists but does not occur */
-    *piError = SRCH_TermDictTermDoesNotOccur;
-
-
-    return (0);
+    return (iError);
 
 }
 
@@ -1672,419 +1981,316 @@ static int iSrchTermDictLookupCallBack
 
 /*
 
-    Function:   iSrchTermDictLookupListCallBack()
+    Function:   iSrchTermDictOpenTermFilter()
 
-    Purpose:    This function is passed to the dictionary lookup function to
-                perform extra processing on a term.
+    Purpose:    This function reads the term filter into memory, the term 
+                filter is optional so we just go without it if it is missing 
+                or invalid.
 
-    Parameters: pucKey          key (term)
-                pvEntryData     entry data
-                uiEntryLength   entry length
-                ap              arg list
+    Parameters: psiSrchIndex    search index structure
 
     Globals:    none
 
-    Returns:    0 to continue processing, non-0 otherwise
+    Returns:    SRCH error code
 
 */
-static int iSrchTermDictLookupListCallBack
+int iSrchTermDictOpenTermFilter
 (
-    unsigned char *pucKey,
-    void *pvEntryData,
-    unsigned int uiEntryLength,
-    va_list ap
+    struct srchIndex *psiSrchIndex
 )
 {
 
-    va_list                     ap_;
     int                         iError = SRCH_NoError;
-    int                         iStatus = 0;
-    boolean                     bFinished = false;
-
-    struct srchTermDictInfo     *pstdiSrchTermDictInfos = NULL;
-    unsigned int                uiSrchTermDictInfosLength = 0;
-    unsigned int                uiTermMatch = SRCH_TERMDICT_TERM_MATCH_UNKNOWN;
-    boolean                     bCaseSensitive = false;
-    wchar_t                     wcCharacter = L'\0';
-    wchar_t                     *pwcEncodedTerm = NULL;
-    unsigned int                uiEncodedTermLength = 0;
-    struct srchTermDictMatch    *pstdmSrchTermDictMatch = NULL;
-    unsigned int                uiSrchTermDictMatchLength = 0;
-    regex_t                     *prRegex = NULL;
-    void                        *pvHandle = NULL;
-    unsigned char               *pucFieldIDBitmap = NULL;
-    unsigned int                uiFieldIDBitmapLength = 0;
-    struct srchTermDictInfo     **ppstdiSrchTermDictInfos = NULL;
-    unsigned int                *puiSrchTermDictInfosLength = NULL;
-    unsigned int                *piError = NULL;
-    boolean                     bFieldMatch = false;
-    boolean                     bTermMatch = false;
+    unsigned char               pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    FILE                        *pfFile = NULL;
+    off_t                       zFileLength = 0;
+    unsigned int                uiHashCount = 0;
+    unsigned int                uiBitmapLength = 0;
+    struct srchTermDictFilter   *pstdfSrchTermDictFilter = NULL;
 
-    unsigned char               *pucEntryDataPtr = NULL;
-    unsigned char               *pucEntryDataEndPtr = NULL;
-    unsigned int                uiTermType = 0;
-    unsigned int                uiTermCount = 0;
-    unsigned int                uiDocumentCount = 0;
-    unsigned long               ulIndexBlockID = 0;
-    unsigned int                uiFieldID = 0;
 
-    /* This used as a return parameter for calls to soundex, phonix and metaphone */
-    wchar_t                     pwcEncodedKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
-    wchar_t                     pwcKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictOpenTermFilter'."); 
+        return (SRCH_InvalidIndex);
+    }
 
 
+    /* Get the term filter file path */
+    if ( (iError = iSrchFilePathsGetTermFilterFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term filter file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupListCallBack [%s][%u][%s]", pucKey, uiEntryLength, */
-/*             (pvEntryData != NULL) ? "(pvEntryData != NULL)" : "(pvEntryData == NULL)"); */
+    /* The term filter is optional, indices created before it was introduced don't have one */
+    if ( bUtlFileIsFile(pucFilePath) == false ) {
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
-    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
-    ASSERT(pvEntryData != NULL);
-    ASSERT(uiEntryLength > 0);
+    /* Open the term filter file */
+    if ( (pfFile = s_fopen(pucFilePath, "r")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the term filter file: '%s'.", pucFilePath);
+        iError = SRCH_TermDictOpenTermFilterFailed;
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
+    /* Get the term filter file length */
+    if ( (iError = iUtlFileGetFileLength(pfFile, &zFileLength)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the length of the term filter file: '%s', utl error: %d.", pucFilePath, iError);
+        iError = SRCH_TermDictOpenTermFilterFailed;
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
-    /* Get all our parameters, note that we make a copy of 'ap' */
-    va_copy(ap_, ap);
-    uiTermMatch = (unsigned int)va_arg(ap_, unsigned int);
-    bCaseSensitive = (boolean)va_arg(ap_, unsigned int);
-    wcCharacter = (wchar_t)va_arg(ap_, wchar_t);
-    pwcEncodedTerm = (wchar_t *)va_arg(ap_, wchar_t *);
-    uiEncodedTermLength = (unsigned int)va_arg(ap_, unsigned int);
-    pstdmSrchTermDictMatch = (struct srchTermDictMatch *)va_arg(ap_, struct srchTermDictMatch *);
-    uiSrchTermDictMatchLength = (unsigned int)va_arg(ap_, unsigned int);
-    prRegex = (regex_t *)va_arg(ap_, regex_t *);
-    pvHandle = (void *)va_arg(ap_, void *);
-    pucFieldIDBitmap = (unsigned char *)va_arg(ap_, unsigned char *);
-    uiFieldIDBitmapLength = (unsigned int)va_arg(ap_, unsigned int);
-    ppstdiSrchTermDictInfos = (struct srchTermDictInfo **)va_arg(ap_, struct srchTermDictInfo **);
-    puiSrchTermDictInfosLength = (unsigned int *)va_arg(ap_, unsigned int *);
-    piError = (int *)va_arg(ap_, int *);
-    va_end(ap_);
+    /* Read the hash count and the bitmap length */
+    if ( (zFileLength < (off_t)(sizeof(unsigned int) * 2)) || 
+            (s_fread(&uiHashCount, sizeof(unsigned int), 1, pfFile) != 1) || (s_fread(&uiBitmapLength, sizeof(unsigned int), 1, pfFile) != 1) ) {
+        iUtlLogWarn(UTL_LOG_CONTEXT, "Invalid term filter file: '%s', ignoring the term filter.", pucFilePath);
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
+    /* Check the hash count, the bitmap length and the file length */
+    if ( (uiHashCount == 0) || (uiBitmapLength == 0) || 
+            (zFileLength != (off_t)((sizeof(unsigned int) * 2) + UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength))) ) {
+        iUtlLogWarn(UTL_LOG_CONTEXT, "Invalid term filter file length: '%s', ignoring the term filter.", pucFilePath);
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupListCallBack [%u][%s][%lc][%ls][%u][%ls][%u][field ID bitmap %sdefined][%u]", */
-/*             uiTermMatch, (bCaseSensitive == true) ? "true" : "false", (wint_t)wcCharacter, pwcEncodedTerm, uiEncodedTermLength, pwcUtlStringsGetPrintableWideString(pwcEncodedTerm),  */
-/*             uiSrchTermDictMatchLength, (pucFieldIDBitmap != NULL) ? "" : "not ", *puiSrchTermDictInfosLength); */
 
+    /* Allocate the term filter */
+    if ( (pstdfSrchTermDictFilter = (struct srchTermDictFilter *)s_malloc((size_t)sizeof(struct srchTermDictFilter))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
-    ASSERT(SRCH_TERMDICT_TERM_MATCH_VALID(uiTermMatch) == true);
-    ASSERT(wcCharacter != L'\0');
-    ASSERT((bCaseSensitive == true) || (bCaseSensitive == false));
-    ASSERT(((bUtlStringsIsWideStringNULL(pwcEncodedTerm) == false) && (uiEncodedTermLength > 0)) || ((bUtlStringsIsWideStringNULL(pwcEncodedTerm) == true) && (uiEncodedTermLength == 0)));
-    ASSERT(((pstdmSrchTermDictMatch != NULL) && (uiSrchTermDictMatchLength > 0)) || ((pstdmSrchTermDictMatch == NULL) && (uiSrchTermDictMatchLength == 0)));
-    ASSERT(((pvHandle != NULL) && 
-                ((uiTermMatch == SRCH_TERMDICT_TERM_MATCH_SOUNDEX) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_PHONIX) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_METAPHONE) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_TYPO))) ||
-                ((pvHandle == NULL) && 
-                ((uiTermMatch == SRCH_TERMDICT_TERM_MATCH_REGULAR) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_STOP) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_WILDCARD) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_REGEX))));
-    ASSERT(((prRegex != NULL) && (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_REGEX)) || ((prRegex == NULL) && (uiTermMatch != SRCH_TERMDICT_TERM_MATCH_REGEX)));
-    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
-    ASSERT(ppstdiSrchTermDictInfos != NULL);
-    ASSERT(puiSrchTermDictInfosLength != NULL);
+    if ( (pstdfSrchTermDictFilter->pucBitmap = (unsigned char *)s_malloc((size_t)(sizeof(unsigned char) * UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength)))) == NULL ) {
+        iError = SRCH_MemError;
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
+    pstdfSrchTermDictFilter->uiBitmapLength = uiBitmapLength;
+    pstdfSrchTermDictFilter->uiHashCount = uiHashCount;
 
-    /* Extract some information from the data pointer */ 
-    pucEntryDataPtr = (unsigned char *)pvEntryData;
-    UTL_NUM_READ_COMPRESSED_UINT(uiTermType, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_UINT(uiTermCount, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_UINT(uiDocumentCount, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_ULONG(ulIndexBlockID, pucEntryDataPtr);
+    /* Read the bitmap, it is small enough to be kept in memory */
+    if ( s_fread(pstdfSrchTermDictFilter->pucBitmap, sizeof(unsigned char), UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength), pfFile) != UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to read the term filter file: '%s'.", pucFilePath);
+        iError = SRCH_TermDictOpenTermFilterFailed;
+        goto bailFromiSrchTermDictOpenTermFilter;
+    }
 
 
-    /* Assume that we are not going to add this term */
-    bFieldMatch = false;
 
-    /* Do we need to prequalify this term against the field ID */
-    if ( pucFieldIDBitmap != NULL ) {
+    /* Bail label */
+    bailFromiSrchTermDictOpenTermFilter:
 
-        pucEntryDataEndPtr = (unsigned char *)pvEntryData + uiEntryLength;
 
-        /* Scan the field IDs */
-        while ( pucEntryDataPtr < pucEntryDataEndPtr ) {
-        
-            /* Decode */
-            UTL_NUM_READ_COMPRESSED_UINT(uiFieldID, pucEntryDataPtr);
+    /* Close the file */
+    if ( pfFile != NULL ) {
+        s_fclose(pfFile);
+    }
 
-            ASSERT(uiFieldID <= uiFieldIDBitmapLength); 
+    /* Handle the error */
+    if ( iError == SRCH_NoError ) {
 
-            /* Check for a match - field ID 0 is not a field */
-            if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucFieldIDBitmap, uiFieldID - 1) ) {
-                /* We have a match so we break */
-                bFieldMatch = true;
-                break;
-            }
-        }
+        /* Set the term filter, it is left as NULL if there was no term filter */
+        psiSrchIndex->pstdfSrchTermDictFilter = pstdfSrchTermDictFilter;
     }
     else {
-        bFieldMatch = true;
-    }
 
-    /* Bail here if there is no field match */ 
-    if ( bFieldMatch == false ) {
-        goto bailFromiSrchTermDictLookupListCallBack;
+        /* Free the term filter */
+        if ( pstdfSrchTermDictFilter != NULL ) {
+            s_free(pstdfSrchTermDictFilter->pucBitmap);
+            s_free(pstdfSrchTermDictFilter);
+        }
     }
-    
-    
 
-    /* Convert the key from utf-8 to wide characters */
-    if ( (iError = iLngConvertUtf8ToWideString_s(pucKey, 0, pwcKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert the key from utf-8 to wide characters, lng error: %d.", iError);
-        iStatus = -1;
-        goto bailFromiSrchTermDictLookupListCallBack;
-    }
 
+    return (iError);
 
-    /* Assume that we are not going to add this term */
-    bTermMatch = false;
+}
 
-    /* And check it, adding it to the list if it matches */
-    switch ( uiTermMatch ) {
 
-        case SRCH_TERMDICT_TERM_MATCH_REGULAR:
-            
-            /* Include all regular terms */
-            if ( uiTermType == SPI_TERM_TYPE_REGULAR ) {
-                bTermMatch = true;
-            }
-            break;
+/*---------------------------------------------------------------------------*/
 
 
-        case SRCH_TERMDICT_TERM_MATCH_STOP:
-            
-            /* Include all stop terms */
-            if ( uiTermType == SPI_TERM_TYPE_STOP ) {
-                bTermMatch = true;
-            }
-            break;
+/*
 
+    Function:   iSrchTermDictCloseTermFilter()
 
-        case SRCH_TERMDICT_TERM_MATCH_WILDCARD:
-        
-            /* Match all terms if the character is a space, otherwise
-            ** match terms where the first letter of the key matches the character,
-            ** bail as soon as we exit the character range 
-            */
-            if ( wcCharacter == L' ' ) {
+    Purpose:    This function frees the term filter.
 
-/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls'", pwcKey); */
+    Parameters: psiSrchIndex    search index structure
 
-                if ( iSrchTermDictMatchTermToSearchTermDictMatch(pwcKey, pstdmSrchTermDictMatch, uiSrchTermDictMatchLength) == 0 ) {
-                    bTermMatch = true;
-                }
-            }
-            else {
-                if ( pwcKey[0] > wcCharacter ) {
-                    bFinished = true;
-                }
-                else if ( pwcKey[0] == wcCharacter ) {
-                    
-                    int iLocalStatus = s_wcsncmp(pwcEncodedTerm, pwcKey, uiEncodedTermLength);
-                    
-                    if ( iLocalStatus < 0 ) {
-                        bFinished = true;
-                    }
-                    else if ( iLocalStatus == 0 ) {
-                        
-/*                         iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls'", pwcKey); */
+    Globals:    none
 
-                        if ( iSrchTermDictMatchTermToSearchTermDictMatch(pwcKey, pstdmSrchTermDictMatch, uiSrchTermDictMatchLength) == 0 ) {
-                            bTermMatch = true;
-                        }
-                    }
-                }
-            }
-            break;
+    Returns:    SRCH error code
 
+*/
+int iSrchTermDictCloseTermFilter
+(
+    struct srchIndex *psiSrchIndex
+)
+{
 
-        case SRCH_TERMDICT_TERM_MATCH_SOUNDEX:
-            
-            /* Match terms while the first letter of the key matches the character,
-            ** bail as soon as we exit the character range
-            */
-            if ( pwcKey[0] > wcCharacter  ) {
-                bFinished = true;
-            }
-            else if ( pwcKey[0] == wcCharacter ) {
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictCloseTermFilter'."); 
+        return (SRCH_InvalidIndex);
+    }
 
-                /* Soundex the key and compare */
-                if ( (iError = iLngSoundexGetSoundexKey(pvHandle, pwcKey, pwcEncodedKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
-                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the soundex key for a term, lng error: %d.", iError);
-                    iStatus = -1;
-                    goto bailFromiSrchTermDictLookupListCallBack;
-                }
 
-/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls', pwcEncodedTerm: '%ls', pwcEncodedKey: '%ls'", pwcKey, pwcEncodedTerm, pwcEncodedKey); */
+    /* Free the term filter */
+    if ( psiSrchIndex->pstdfSrchTermDictFilter != NULL ) {
+        s_free(psiSrchIndex->pstdfSrchTermDictFilter->pucBitmap);
+        s_free(psiSrchIndex->pstdfSrchTermDictFilter);
+    }
 
-                if ( s_wcscmp(pwcEncodedTerm, pwcEncodedKey) == 0 ) {
-                    bTermMatch = true;
-                }
-            }
-            break;
 
+    return (SRCH_NoError);
 
-        case SRCH_TERMDICT_TERM_MATCH_PHONIX:
+}
 
-            /* Match terms while the first letter of the key matches the character,
-            ** bail as soon as we exit the character range
-            */
-            if ( pwcKey[0] > wcCharacter  ) {
-                bFinished = true;
-            }
-            else if ( pwcKey[0] == wcCharacter ) {
 
-                /* Phonix the key and compare */
-                if ( (iError = iLngPhonixGetPhonixKey(pvHandle, pwcKey, pwcEncodedKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
-                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the phonix key for a term, lng error: %d.", iError);
-                    iStatus = -1;
-                    goto bailFromiSrchTermDictLookupListCallBack;
-                }
+/*---------------------------------------------------------------------------*/
 
-/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls', pwcEncodedTerm: '%ls', pwcEncodedKey: '%ls'", pwcKey, pwcEncodedTerm, pwcEncodedKey); */
 
-                if ( s_wcscmp(pwcEncodedTerm, pwcEncodedKey) == 0 ) {
-                    bTermMatch = true;
-                }
-            }
-            break;
+/*
 
+    Function:   iSrchTermDictCheckTermFilter()
 
-        case SRCH_TERMDICT_TERM_MATCH_METAPHONE:
+    Purpose:    This function checks the term against the term filter, and tells 
+                us whether the term may be in the term dictionary. 
 
-            /* Match terms while the first letter of the key matches the character,
-            ** bail as soon as we exit the character range
-            */
-            if ( pwcKey[0] > wcCharacter  ) {
-                bFinished = true;
-            }
-            else if ( pwcKey[0] == wcCharacter ) {
+                A term which is not in the term dictionary may get through
+                the term filter, but a term which is in the term dictionary 
+                always gets through. All terms get through if the index does
+                not have a term filter.
 
-                /* Metaphone the key and compare */
-                if ( (iError = iLngMetaphoneGetMetaphoneKey(pvHandle, pwcKey, pwcEncodedKey, UTL_FILE_PATH_MAX + 1)) != LNG_NoError ) {
-                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the metaphone key for a term, lng error: %d.", iError);
-                    iStatus = -1;
-                    goto bailFromiSrchTermDictLookupListCallBack;
-                }
+    Parameters: psiSrchIndex        search index structure
+                pucTerm             term to check
+                pbTermMayExist      return pointer for the term may exist flag
 
-/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls', pwcEncodedTerm: '%ls', pwcEncodedKey: '%ls'", pwcKey, pwcEncodedTerm, pwcEncodedKey); */
+    Globals:    none
 
-                if ( s_wcscmp(pwcEncodedTerm, pwcEncodedKey) == 0 ) {
-                    bTermMatch = true;
-                }
-            }
-            break;
+    Returns:    SRCH error code
 
+*/
+int iSrchTermDictCheckTermFilter
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucTerm,
+    boolean *pbTermMayExist
+)
+{
 
-        case SRCH_TERMDICT_TERM_MATCH_TYPO:
-            
-            /* Match terms while the first letter of the key matches the character,
-            ** bail as soon as we exit the character range
-            */
-            if ( pwcKey[0] > wcCharacter  ) {
-                bFinished = true;
-            }
-            else if ( pwcKey[0] == wcCharacter ) {
+    struct srchTermDictFilter   *pstdfSrchTermDictFilter = NULL;
+    unsigned long               ulTermHash = 0;
+    unsigned int                uiI = 0;
 
-/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls', pwcEncodedTerm: '%ls'", pwcKey, pwcEncodedTerm); */
 
-                /* Check for typo match */
-                if ( (iError = iLngTypoGetTypoMatch(pvHandle, pwcEncodedTerm, pwcKey, bCaseSensitive, SRCH_TERM_DICT_TYPO_COUNT_MAX)) == LNG_NoError ) {
-                    bTermMatch = true;
-                }
-            }
-            break;
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictCheckTermFilter'."); 
+        return (SRCH_InvalidIndex);
+    }
 
+    if ( bUtlStringsIsStringNULL(pucTerm) == true ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null or empty 'pucTerm' parameter passed to 'iSrchTermDictCheckTermFilter'."); 
+        return (SRCH_TermDictInvalidTerm);
+    }
 
-        case SRCH_TERMDICT_TERM_MATCH_REGEX:
-            
-            /* Match terms while the first letter of the key matches the character,
-            ** bail as soon as we exit the character range
-            */
-            if ( pwcKey[0] > wcCharacter  ) {
-                bFinished = true;
-            }
-            else if ( pwcKey[0] == wcCharacter ) {
-                if ( s_wcsncasecmp(pwcEncodedTerm, pwcKey, uiEncodedTermLength) == 0 ) {
-#if defined(TRE_REGEX_ENABLE)
-                    if ( iSrchTermDictMatchTermToRegex(pwcKey, prRegex) == 0 ) {
-                        bTermMatch = true;
-                    }
-#else
-                    if ( iSrchTermDictMatchTermToRegex(pucKey, prRegex) == 0 ) {
-                        bTermMatch = true;
-                    }
-#endif    /* TRE_REGEX_ENABLE */
-                }
-            }
-            break;
+    if ( pbTermMayExist == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pbTermMayExist' parameter passed to 'iSrchTermDictCheckTermFilter'."); 
+        return (SRCH_ReturnParameterError);
+    }
 
 
-        default:
-            return (-1);
+    /* The term may exist if there is no term filter */
+    if ( (pstdfSrchTermDictFilter = psiSrchIndex->pstdfSrchTermDictFilter) == NULL ) {
+        *pbTermMayExist = true;
+        return (SRCH_NoError);
     }
 
 
+    /* Hash the term */
+    ulTermHash = ulSrchTermDictGetTermHash(pucTerm);
 
-    /* Bail label */
-    bailFromiSrchTermDictLookupListCallBack:
+    /* The term is definitely not in the term dictionary if any of its bits is not set */
+    for ( uiI = 0; uiI < pstdfSrchTermDictFilter->uiHashCount; uiI++ ) {
+        if ( !UTL_BITMAP_IS_BIT_SET_IN_POINTER(pstdfSrchTermDictFilter->pucBitmap, SRCH_TERM_DICT_TERM_FILTER_BIT(ulTermHash, uiI, pstdfSrchTermDictFilter->uiBitmapLength)) ) {
+            *pbTermMayExist = false;
+            return (SRCH_NoError);
+        }
+    }
 
+    /* Set the return pointer */
+    *pbTermMayExist = true;
 
-    /* Handle the status - part i */
-    if ( iStatus == 0 ) {
 
-        /* Add the term */
-        if ( (bFieldMatch == true) && (bTermMatch == true) ) {
-    
-            struct srchTermDictInfo     *pstdiSrchTermDictInfosPtr = NULL;
-                
-/*             iUtlLogDebug(UTL_LOG_CONTEXT, "pucKey [%s], uiTermCount: [%u], uiDocumentCount: [%u]",  pucKey, uiTermCount, uiDocumentCount); */
-    
-            /* Derefence the term list and the term list length */
-            pstdiSrchTermDictInfos = *ppstdiSrchTermDictInfos;
-            uiSrchTermDictInfosLength = *puiSrchTermDictInfosLength;
-    
-            /* Allocate in blocks of SRCH_TERM_DICT_TERM_INFO_ALLOCATION */
-            if ( (uiSrchTermDictInfosLength % SRCH_TERM_DICT_TERM_INFO_ALLOCATION) == 0 ) {
-                
-                /* Note that we loop back to the bail label here, this is intentional and taken care of by iStatus */
-                if ( (pstdiSrchTermDictInfosPtr = (struct srchTermDictInfo *)s_realloc(pstdiSrchTermDictInfos, 
-                        (size_t)((uiSrchTermDictInfosLength + SRCH_TERM_DICT_TERM_INFO_ALLOCATION) * sizeof(struct srchTermDictInfo)))) == NULL ) {
-                    iStatus = -1;
-                    goto bailFromiSrchTermDictLookupListCallBack;
-                }
-                pstdiSrchTermDictInfos = pstdiSrchTermDictInfosPtr;
-            }
-    
-            /* Dereference the pointer and add the term */
-            pstdiSrchTermDictInfosPtr = pstdiSrchTermDictInfos + uiSrchTermDictInfosLength;
-            if ( (pstdiSrchTermDictInfosPtr->pucTerm = (unsigned char *)s_strdup(pucKey)) == NULL ) {
-                iStatus = -1;
-                goto bailFromiSrchTermDictLookupListCallBack;
-            }
-            pstdiSrchTermDictInfosPtr->uiTermType = uiTermType;
-            pstdiSrchTermDictInfosPtr->uiTermCount = uiTermCount;
-            pstdiSrchTermDictInfosPtr->uiDocumentCount = uiDocumentCount;
-            uiSrchTermDictInfosLength++;
-    
-            /* Set the return pointers */
-            *ppstdiSrchTermDictInfos = pstdiSrchTermDictInfos;
-            *puiSrchTermDictInfosLength = uiSrchTermDictInfosLength;
-        }
-    }
+    return (SRCH_NoError);
 
+}
 
-    /* Handle the status - part ii */
-    if ( iStatus != 0 ) {
 
-        /* Free allocations */
-        struct spiTermInfo *pstiSpiTermInfos = (struct spiTermInfo *)pstdiSrchTermDictInfos;
+/*---------------------------------------------------------------------------*/
 
-        iSpiFreeTermInfo(pstiSpiTermInfos, uiSrchTermDictInfosLength);
-        pstiSpiTermInfos = NULL;
 
-        *ppstdiSrchTermDictInfos = NULL;
-        *puiSrchTermDictInfosLength = 0;
+/* 
+** ==================
+** ===  Term IDs  ===
+** ==================
+*/
+
+
+/*
+
+    Function:   iSrchTermDictGetNextTermID()
+
+    Purpose:    This function returns the term ID which will be given to the 
+                next term added to the term dictionary while the index is 
+                being created.
+
+    Parameters: psiSrchIndex    search index structure
+                puiTermID       return pointer for the term ID
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictGetNextTermID
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int *puiTermID
+)
+{
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictGetNextTermID'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( psiSrchIndex->psibSrchIndexBuild == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex->psibSrchIndexBuild' parameter passed to 'iSrchTermDictGetNextTermID'."); 
+        return (SRCH_InvalidIndex);
     }
 
+    if ( !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Term IDs are not enabled in the 'psiSrchIndex' parameter passed to 'iSrchTermDictGetNextTermID'."); 
+        return (SRCH_TermDictMissingTermIDs);
+    }
 
-    return ((iStatus != 0) ? iStatus : ((bFinished == true) ? -1 : 0));
+    if ( puiTermID == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiTermID' parameter passed to 'iSrchTermDictGetNextTermID'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Set the return pointer, term IDs start at 1 */
+    *puiTermID = psiSrchIndex->psibSrchIndexBuild->uiTermIDsLength + 1;
+
+
+    return (SRCH_NoError);
 
 }
 
@@ -2094,106 +2300,1337 @@ static int iSrchTermDictLookupListCallBack
 
 /*
 
-    Function:   iSrchTermDictLookupRangeCallBack()
+    Function:   iSrchTermDictCreateTermIDs()
 
-    Purpose:    This function is passed to the dictionary lookup function to
-                perform extra processing on a term.
+    Purpose:    This function creates the term ID table from the terms which 
+                were added to the term dictionary while the index was being 
+                created, it must be called after the last term has been added
+                to the term dictionary.
 
-    Parameters: pucKey          key (term)
-                pvEntryData     entry data
-                uiEntryLength   entry length
-                ap              arg list
+                The data file was written as the terms were added, so all 
+                that is left to do is to write out the term offsets. The term 
+                ID table files are removed if it could not be created.
+
+    Parameters: psiSrchIndex    search index structure
 
     Globals:    none
 
-    Returns:    0 to continue processing, non-0 otherwise
+    Returns:    SRCH error code
 
 */
-static int iSrchTermDictLookupRangeCallBack
+int iSrchTermDictCreateTermIDs
 (
-    unsigned char *pucKey,
-    void *pvEntryData,
-    unsigned int uiEntryLength,
-    va_list ap
+    struct srchIndex *psiSrchIndex
 )
 {
 
-    va_list                     ap_;
     int                         iError = SRCH_NoError;
-    int                         iStatus = 0;
-    boolean                     bFinished = false;
+    struct srchIndexBuild       *psibSrchIndexBuild = NULL;
+    unsigned char               pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    FILE                        *pfFile = NULL;
 
-    struct srchTermDictInfo     *pstdiSrchTermDictInfos = NULL;
-    unsigned int                uiSrchTermDictInfosLength = 0;
-    unsigned int                uiDictRangeMatchTerm = SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA;
-    wchar_t                     wcCharacter = L'\0';
-    int                         iTermStartNumber = 0;
-    int                         iTermEndNumber = 0;
-    wchar_t                     *pwcTermStart = NULL;
-    wchar_t                     *pwcTermEnd = NULL;
-    unsigned int                uiRangeID = 0;
-    unsigned int                uiDictCaseScan = 0;
-    unsigned char               *pucFieldIDBitmap = NULL;
-    unsigned int                uiFieldIDBitmapLength = 0;
-    struct srchTermDictInfo     **ppstdiSrchTermDictInfos = NULL;
-    unsigned int                *puiSrchTermDictInfosLength = 0;
-    unsigned int                *piError = NULL;
 
-    unsigned char               *pucEntryDataPtr = NULL;
-    unsigned char               *pucEntryDataEndPtr = NULL;
-    unsigned int                uiFieldID = 0;
-    unsigned int                uiTermType = 0;
-    unsigned int                uiTermCount = 0;
-    unsigned int                uiDocumentCount = 0;
-    unsigned int                ulIndexBlockID = 0;
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictCreateTermIDs'."); 
+        return (SRCH_InvalidIndex);
+    }
 
-    unsigned char               *pucKeyPtr = NULL;
 
-    int                         iDictTermNumber = 0;
-    boolean                     bFieldMatch = false;
-    boolean                     bTermMatch = false;
-    
-    wchar_t                     pwcKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+    /* Nothing to do if no terms were given term IDs */
+    if ( (psiSrchIndex->psibSrchIndexBuild == NULL) || (psiSrchIndex->psibSrchIndexBuild->pfTermIDsDataFile == NULL) ) {
+        return (SRCH_NoError);
+    }
 
+    /* Dereference the index build structure for convenience */
+    psibSrchIndexBuild = psiSrchIndex->psibSrchIndexBuild;
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupRangeCallBack [%s][%u][%s]", pucKey, uiEntryLength, */
-/*             (pvEntryData != NULL) ? "(pvEntryData != NULL)" : "(pvEntryData == NULL)"); */
 
+    /* Close the data file, it is complete */
+    s_fclose(psibSrchIndexBuild->pfTermIDsDataFile);
 
-    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
-    ASSERT(pvEntryData != NULL);
-    ASSERT(uiEntryLength > 0);
+    /* Set the offset for the end of the data, there is space for it */
+    psibSrchIndexBuild->pulTermIDOffsets[psibSrchIndexBuild->uiTermIDsLength + 1] = psibSrchIndexBuild->ulTermIDsDataLength;
 
 
-    /* Get all our parameters, note that we make a copy of 'ap' */
-    va_copy(ap_, ap);
-    uiDictRangeMatchTerm = (unsigned int)va_arg(ap_, unsigned int);
-    wcCharacter = (wchar_t)va_arg(ap_, wchar_t);
+    /* Write the term offsets to the index file */
+    if ( (iError = iSrchFilePathsGetTermIDsFilePathFromIndex(psiSrchIndex, SRCH_TERMDICT_TERM_IDS_FILE_INDEX_ID, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term ID table index file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        goto bailFromiSrchTermDictCreateTermIDs;
+    }
 
-    if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE) ) {
-        iTermStartNumber = (int)va_arg(ap_, int);
-        iTermEndNumber = (int)va_arg(ap_, int);
+    if ( (pfFile = s_fopen(pucFilePath, "w")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term ID table index file: '%s'.", pucFilePath);
+        iError = SRCH_TermDictCreateTermIDsFailed;
+        goto bailFromiSrchTermDictCreateTermIDs;
     }
-    else if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE) ) {
-        pwcTermStart = (wchar_t *)va_arg(ap_, wchar_t *);
-        pwcTermEnd = (wchar_t *)va_arg(ap_, wchar_t *);
+
+    if ( s_fwrite(psibSrchIndexBuild->pulTermIDOffsets, sizeof(unsigned long), psibSrchIndexBuild->uiTermIDsLength + 2, pfFile) != (psibSrchIndexBuild->uiTermIDsLength + 2) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the term ID table index file: '%s'.", pucFilePath);
+        iError = SRCH_TermDictCreateTermIDsFailed;
+        goto bailFromiSrchTermDictCreateTermIDs;
     }
 
-    uiRangeID = (unsigned int)va_arg(ap_, unsigned int);
-    uiDictCaseScan = (unsigned int)va_arg(ap_, unsigned int);
-    pucFieldIDBitmap = (unsigned char *)va_arg(ap_, unsigned char *);
-    uiFieldIDBitmapLength = (unsigned int)va_arg(ap_, unsigned int);
-    ppstdiSrchTermDictInfos = (struct srchTermDictInfo **)va_arg(ap_, struct srchTermDictInfo **);
-    puiSrchTermDictInfosLength = (unsigned int *)va_arg(ap_, unsigned int *);
-    piError = (int *)va_arg(ap_, int *);
-    va_end(ap_);
 
 
-/*     if ( bUtlLogIsDebug(UTL_LOG_CONTEXT) == true ) { */
-/*         if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE) ) { */
-/*             iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupRangeCallBack [%u][%lc][%d][%d][%u][%u][field ID bitmap %defined][%u]", uiDictRangeMatchTerm, wcCharacter,  */
-/*                     iTermStartNumber, iTermEndNumber, uiRangeID, uiDictCaseScan, (pucFieldIDBitmap != NULL) ? "" : "not ", *puiSrchTermDictInfosLength); */
-/*         } */
+    /* Bail label */
+    bailFromiSrchTermDictCreateTermIDs:
+
+
+    /* Close the index file */
+    if ( pfFile != NULL ) {
+        s_fclose(pfFile);
+    }
+
+    /* Free the term offsets, we are done with them */
+    s_free(psibSrchIndexBuild->pulTermIDOffsets);
+    psibSrchIndexBuild->uiTermIDsCapacity = 0;
+
+    /* Remove the term ID table files if we failed to create the term ID table, it will not be used */
+    if ( iError != SRCH_NoError ) {
+        vSrchTermDictRemoveTermIDsFiles(psiSrchIndex);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictOpenTermIDs()
+
+    Purpose:    This function opens the term ID table, mapping in its files.
+
+                The term ID table is optional so we just go without it if 
+                the index was not created with term IDs, or if its files 
+                are missing or invalid.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictOpenTermIDs
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchTermDictTermIDs  *pstdtiSrchTermDictTermIDs = NULL;
+    size_t                      zTermOffsetsLength = 0;
+    boolean                     bValid = false;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictOpenTermIDs'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Nothing to open if the index was not created with term IDs */
+    if ( !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_IDS) ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Allocate the term ID table structure */
+    if ( (pstdtiSrchTermDictTermIDs = (struct srchTermDictTermIDs *)s_malloc((size_t)sizeof(struct srchTermDictTermIDs))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+
+    /* Map in the files */
+    if ( (iError = iSrchTermDictMapTermIDsFile(psiSrchIndex, SRCH_TERMDICT_TERM_IDS_FILE_INDEX_ID, (void **)&pstdtiSrchTermDictTermIDs->pulTermOffsets,
+            &pstdtiSrchTermDictTermIDs->zTermOffsetsLength)) != SRCH_NoError ) {
+        goto bailFromiSrchTermDictOpenTermIDs;
+    }
+
+    if ( (iError = iSrchTermDictMapTermIDsFile(psiSrchIndex, SRCH_TERMDICT_TERM_IDS_FILE_DATA_ID, (void **)&pstdtiSrchTermDictTermIDs->pucData,
+            &pstdtiSrchTermDictTermIDs->zDataLength)) != SRCH_NoError ) {
+        goto bailFromiSrchTermDictOpenTermIDs;
+    }
+
+
+    /* Check that both files are there and that they agree, the term offsets 
+    ** have an entry for term ID 0 and an entry for the end of the data
+    */
+    zTermOffsetsLength = pstdtiSrchTermDictTermIDs->zTermOffsetsLength / sizeof(unsigned long);
+
+    if ( (pstdtiSrchTermDictTermIDs->pulTermOffsets != NULL) && (pstdtiSrchTermDictTermIDs->pucData != NULL) &&
+            ((pstdtiSrchTermDictTermIDs->zTermOffsetsLength % sizeof(unsigned long)) == 0) && (zTermOffsetsLength >= 2) &&
+            (pstdtiSrchTermDictTermIDs->pulTermOffsets[zTermOffsetsLength - 1] == (unsigned long)pstdtiSrchTermDictTermIDs->zDataLength) ) {
+
+        pstdtiSrchTermDictTermIDs->uiTermIDMaximum = (unsigned int)(zTermOffsetsLength - 2);
+        bValid = true;
+    }
+    else {
+        iUtlLogWarn(UTL_LOG_CONTEXT, "Missing or invalid term ID table files, ignoring the term ID table, index: '%s'.", psiSrchIndex->pucIndexName);
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchTermDictOpenTermIDs:
+
+
+    /* Handle the error, we only use the term ID table if all of it was mapped in */
+    if ( (iError == SRCH_NoError) && (bValid == true) ) {
+        psiSrchIndex->pstdtiSrchTermDictTermIDs = pstdtiSrchTermDictTermIDs;
+    }
+    else {
+        if ( pstdtiSrchTermDictTermIDs->pulTermOffsets != NULL ) {
+            iUtlFileMemoryUnMap(pstdtiSrchTermDictTermIDs->pulTermOffsets, pstdtiSrchTermDictTermIDs->zTermOffsetsLength);
+        }
+        if ( pstdtiSrchTermDictTermIDs->pucData != NULL ) {
+            iUtlFileMemoryUnMap(pstdtiSrchTermDictTermIDs->pucData, pstdtiSrchTermDictTermIDs->zDataLength);
+        }
+        s_free(pstdtiSrchTermDictTermIDs);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictCloseTermIDs()
+
+    Purpose:    This function closes the term ID table, unmapping its files,
+                and removing the data file if the term ID table was not 
+                created.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictCloseTermIDs
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    struct srchTermDictTermIDs  *pstdtiSrchTermDictTermIDs = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictCloseTermIDs'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Close and remove the data file, it will only still be open if the term ID table was not created */
+    if ( (psiSrchIndex->psibSrchIndexBuild != NULL) && (psiSrchIndex->psibSrchIndexBuild->pfTermIDsDataFile != NULL) ) {
+        s_fclose(psiSrchIndex->psibSrchIndexBuild->pfTermIDsDataFile);
+        s_free(psiSrchIndex->psibSrchIndexBuild->pulTermIDOffsets);
+        vSrchTermDictRemoveTermIDsFiles(psiSrchIndex);
+    }
+
+
+    /* Unmap the term ID table */
+    if ( psiSrchIndex->pstdtiSrchTermDictTermIDs != NULL ) {
+
+        pstdtiSrchTermDictTermIDs = psiSrchIndex->pstdtiSrchTermDictTermIDs;
+
+        iUtlFileMemoryUnMap(pstdtiSrchTermDictTermIDs->pulTermOffsets, pstdtiSrchTermDictTermIDs->zTermOffsetsLength);
+        iUtlFileMemoryUnMap(pstdtiSrchTermDictTermIDs->pucData, pstdtiSrchTermDictTermIDs->zDataLength);
+
+        s_free(psiSrchIndex->pstdtiSrchTermDictTermIDs);
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/* 
+** ====================
+** ===  Term Grams  ===
+** ====================
+*/
+
+
+/*
+
+    Function:   iSrchTermDictCreateTermGrams()
+
+    Purpose:    This function creates the term gram dictionary from the term 
+                grams collected while the term dictionary was being created.
+
+                The term gram dictionary maps each term gram to the list of
+                IDs of the terms which contain it.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictCreateTermGrams
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictCreateTermGrams'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Nothing to create if no term grams were collected */
+    if ( (psiSrchIndex->psibSrchIndexBuild == NULL) || (psiSrchIndex->psibSrchIndexBuild->pvUtlTermGramsTrie == NULL) ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Get the term gram dictionary file path */
+    if ( (iError = iSrchFilePathsGetTermGramsFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term gram dictionary file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+    }
+
+    /* Create the term gram dictionary */
+    else if ( (iError = iSrchTermDictCreateTermIDListsDictionary(psiSrchIndex->psibSrchIndexBuild->pvUtlTermGramsTrie, pucFilePath, SRCH_TERMDICT_TERM_GRAM_LENGTH)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term gram dictionary: '%s', utl error: %d.", pucFilePath, iError);
+        iError = SRCH_TermDictCreateTermGramsFailed;
+    }
+
+
+    /* Free the term grams, they are not needed anymore */
+    vSrchTermDictFreeTermIDListsTrie(&psiSrchIndex->psibSrchIndexBuild->pvUtlTermGramsTrie);
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictOpenTermGrams()
+
+    Purpose:    This function opens the term gram dictionary.
+
+                The term gram dictionary is optional so we just go without 
+                it if the index was not created with term grams, or if the 
+                term ID table it points into is not there.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictOpenTermGrams
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictOpenTermGrams'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Nothing to open if the index was not created with term grams */
+    if ( !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_TERM_GRAMS) ) {
+        return (SRCH_NoError);
+    }
+
+    /* The term grams point to term IDs, so they are no use without the term ID table */
+    if ( psiSrchIndex->pstdtiSrchTermDictTermIDs == NULL ) {
+        iUtlLogWarn(UTL_LOG_CONTEXT, "Missing term ID table, ignoring the term gram dictionary, index: '%s'.", psiSrchIndex->pucIndexName);
+        return (SRCH_NoError);
+    }
+
+
+    /* Get the term gram dictionary file path */
+    if ( (iError = iSrchFilePathsGetTermGramsFilePathFromIndex(psiSrchIndex, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term gram dictionary file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        return (iError);
+    }
+
+    /* The term gram dictionary is not created if there were no terms to index */
+    if ( bUtlFileIsFile(pucFilePath) == false ) {
+        iUtlLogWarn(UTL_LOG_CONTEXT, "Missing term gram dictionary: '%s', ignoring the term gram dictionary.", pucFilePath);
+        return (SRCH_NoError);
+    }
+
+    /* Open the term gram dictionary */
+    if ( (iError = iUtlDictOpen(pucFilePath, &psiSrchIndex->pvUtlTermGramsDictionary)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the term gram dictionary: '%s', utl error: %d.", pucFilePath, iError);
+        psiSrchIndex->pvUtlTermGramsDictionary = NULL;
+        return (SRCH_TermDictOpenTermGramsFailed);
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictCloseTermGrams()
+
+    Purpose:    This function closes the term gram dictionary, and frees
+                the term grams if the term gram dictionary was not created.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictCloseTermGrams
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictCloseTermGrams'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Free the term grams, they will only still be there if the term gram dictionary was not created */
+    if ( psiSrchIndex->psibSrchIndexBuild != NULL ) {
+        vSrchTermDictFreeTermIDListsTrie(&psiSrchIndex->psibSrchIndexBuild->pvUtlTermGramsTrie);
+    }
+
+
+    /* Close the term gram dictionary */
+    if ( psiSrchIndex->pvUtlTermGramsDictionary != NULL ) {
+        iUtlDictClose(psiSrchIndex->pvUtlTermGramsDictionary);
+        psiSrchIndex->pvUtlTermGramsDictionary = NULL;
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/* 
+** =======================
+** ===  Phonetic Keys  ===
+** =======================
+*/
+
+
+/*
+
+    Function:   iSrchTermDictCreatePhoneticKeys()
+
+    Purpose:    This function creates the phonetic key dictionaries from the 
+                phonetic keys collected while the term dictionary was being 
+                created, one for each phonetic key enabled in the index block
+                features.
+
+                The phonetic key dictionaries map each phonetic key to the 
+                list of IDs of the terms which have it.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictCreatePhoneticKeys
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    unsigned int    uiTermMatch = SRCH_TERMDICT_TERM_MATCH_UNKNOWN;
+    unsigned int    uiIndexBlockFeature = SRCH_INDEX_BLOCK_FEATURE_NONE;
+    void            **ppvUtlTrie = NULL;
+    void            **ppvLngPhonetic = NULL;
+    void            **ppvUtlDictionary = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictCreatePhoneticKeys'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Nothing to create if the index is not being created */
+    if ( psiSrchIndex->psibSrchIndexBuild == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Loop over the phonetic keys */
+    for ( uiTermMatch = SRCH_TERMDICT_TERM_MATCH_SOUNDEX; SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == true; uiTermMatch++ ) {
+
+        int     iLocalError = SRCH_NoError;
+
+        /* Get the pointers, and skip the phonetic key if no phonetic keys were collected */
+        vSrchTermDictGetPhoneticKeysPointers(psiSrchIndex, uiTermMatch, &uiIndexBlockFeature, &ppvUtlTrie, &ppvLngPhonetic, &ppvUtlDictionary);
+
+        if ( *ppvUtlTrie == NULL ) {
+            continue;
+        }
+
+        /* Get the phonetic key dictionary file path */
+        if ( (iLocalError = iSrchFilePathsGetPhoneticKeysFilePathFromIndex(psiSrchIndex, uiTermMatch, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the phonetic key dictionary file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iLocalError);
+            iError = iLocalError;
+        }
+
+        /* Create the phonetic key dictionary */
+        else if ( (iLocalError = iSrchTermDictCreateTermIDListsDictionary(*ppvUtlTrie, pucFilePath, SRCH_TERMDICT_PHONETIC_KEY_LENGTH_MAXIMUM)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the phonetic key dictionary: '%s', utl error: %d.", pucFilePath, iLocalError);
+            iError = SRCH_TermDictCreatePhoneticKeysFailed;
+        }
+
+        /* Free the phonetic keys, they are not needed anymore */
+        vSrchTermDictFreeTermIDListsTrie(ppvUtlTrie);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictOpenPhoneticKeys()
+
+    Purpose:    This function opens the phonetic key dictionaries.
+
+                The phonetic key dictionaries are optional so we just go without 
+                them if the index was not created with phonetic keys, or if the 
+                term ID table they point into is not there.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictOpenPhoneticKeys
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    unsigned int    uiTermMatch = SRCH_TERMDICT_TERM_MATCH_UNKNOWN;
+    unsigned int    uiIndexBlockFeature = SRCH_INDEX_BLOCK_FEATURE_NONE;
+    void            **ppvUtlTrie = NULL;
+    void            **ppvLngPhonetic = NULL;
+    void            **ppvUtlDictionary = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictOpenPhoneticKeys'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Loop over the phonetic keys */
+    for ( uiTermMatch = SRCH_TERMDICT_TERM_MATCH_SOUNDEX; SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == true; uiTermMatch++ ) {
+
+        /* Get the pointers, and skip the phonetic key if the index was not created with it */
+        vSrchTermDictGetPhoneticKeysPointers(psiSrchIndex, uiTermMatch, &uiIndexBlockFeature, &ppvUtlTrie, &ppvLngPhonetic, &ppvUtlDictionary);
+
+        if ( !(psiSrchIndex->uiIndexBlockFeatures & uiIndexBlockFeature) ) {
+            continue;
+        }
+
+        /* The phonetic keys point to term IDs, so they are no use without the term ID table */
+        if ( psiSrchIndex->pstdtiSrchTermDictTermIDs == NULL ) {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Missing term ID table, ignoring the phonetic key dictionaries, index: '%s'.", psiSrchIndex->pucIndexName);
+            return (SRCH_NoError);
+        }
+
+        /* Get the phonetic key dictionary file path */
+        if ( (iError = iSrchFilePathsGetPhoneticKeysFilePathFromIndex(psiSrchIndex, uiTermMatch, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the phonetic key dictionary file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+            return (iError);
+        }
+
+        /* The phonetic key dictionary is not created if none of the terms had a phonetic key */
+        if ( bUtlFileIsFile(pucFilePath) == false ) {
+            iUtlLogWarn(UTL_LOG_CONTEXT, "Missing phonetic key dictionary: '%s', ignoring the phonetic key dictionary.", pucFilePath);
+            continue;
+        }
+
+        /* Open the phonetic key dictionary */
+        if ( (iError = iUtlDictOpen(pucFilePath, ppvUtlDictionary)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the phonetic key dictionary: '%s', utl error: %d.", pucFilePath, iError);
+            *ppvUtlDictionary = NULL;
+            return (SRCH_TermDictOpenPhoneticKeysFailed);
+        }
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictClosePhoneticKeys()
+
+    Purpose:    This function closes the phonetic key dictionaries, and frees
+                the phonetic keys and the phonetic handles used to create them.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermDictClosePhoneticKeys
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    unsigned int    uiTermMatch = SRCH_TERMDICT_TERM_MATCH_UNKNOWN;
+    unsigned int    uiIndexBlockFeature = SRCH_INDEX_BLOCK_FEATURE_NONE;
+    void            **ppvUtlTrie = NULL;
+    void            **ppvLngPhonetic = NULL;
+    void            **ppvUtlDictionary = NULL;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermDictClosePhoneticKeys'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+
+    /* Loop over the phonetic keys */
+    for ( uiTermMatch = SRCH_TERMDICT_TERM_MATCH_SOUNDEX; SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == true; uiTermMatch++ ) {
+
+        vSrchTermDictGetPhoneticKeysPointers(psiSrchIndex, uiTermMatch, &uiIndexBlockFeature, &ppvUtlTrie, &ppvLngPhonetic, &ppvUtlDictionary);
+
+        /* Free the phonetic keys, they will only still be there if the phonetic key dictionary was not created */
+        if ( ppvUtlTrie != NULL ) {
+            vSrchTermDictFreeTermIDListsTrie(ppvUtlTrie);
+        }
+
+        /* Free the phonetic handle */
+        if ( (ppvLngPhonetic != NULL) && (*ppvLngPhonetic != NULL) ) {
+
+            if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_SOUNDEX ) {
+                iLngSoundexFree(*ppvLngPhonetic);
+            }
+            else if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_METAPHONE ) {
+                iLngMetaphoneFree(*ppvLngPhonetic);
+            }
+            else if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_PHONIX ) {
+                iLngPhonixFree(*ppvLngPhonetic);
+            }
+
+            *ppvLngPhonetic = NULL;
+        }
+
+        /* Close the phonetic key dictionary */
+        if ( *ppvUtlDictionary != NULL ) {
+            iUtlDictClose(*ppvUtlDictionary);
+            *ppvUtlDictionary = NULL;
+        }
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictLookupCallBack()
+
+    Purpose:    This function is passed to the dictionary lookup function to
+                perform extra processing on a term.
+
+                If there is a hit, the data will be unpacked and the 
+                return pointers will be populated.
+
+    Parameters: pucKey          key (term)
+                pvEntryData     entry data
+                uiEntryLength   entry length
+                ap              args (optional)
+
+    Globals:    none
+
+    Returns:    0 to continue processing, non-0 otherwise
+
+*/
+static int iSrchTermDictLookupCallBack
+(
+    unsigned char *pucKey,
+    void *pvEntryData,
+    unsigned int uiEntryLength,
+    va_list ap
+)
+{
+
+    va_list         ap_;
+    boolean         bTermIDs = false;
+    unsigned char   *pucFieldIDBitmap = NULL;
+    unsigned int    uiFieldIDBitmapLength = 0;
+    unsigned int    *puiTermType = NULL;
+    unsigned int    *puiTermCount = NULL;
+    unsigned int    *puiDocumentCount = NULL;
+    unsigned long   *pulIndexBlockID = NULL;
+    unsigned int    *puiTermID = NULL;
+    int             *piError = NULL;
+
+
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupCallBack [%s][%u][%s]", pucKey, uiEntryLength, */
+/*             (pvEntryData != NULL) ? "(pvEntryData != NULL)" : "(pvEntryData == NULL)" ); */
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(pvEntryData != NULL);
+    ASSERT(uiEntryLength > 0);
+
+
+    /* Get all our parameters, note that we make a copy of 'ap' */
+    va_copy(ap_, ap);
+    bTermIDs = (boolean)va_arg(ap_, unsigned int);
+    pucFieldIDBitmap = (unsigned char *)va_arg(ap_, unsigned char *);
+    uiFieldIDBitmapLength = (unsigned int)va_arg(ap_, unsigned int);
+    puiTermType = (unsigned int *)va_arg(ap_, unsigned int *);
+    puiTermCount = (unsigned int *)va_arg(ap_, unsigned int *);
+    puiDocumentCount = (unsigned int *)va_arg(ap_, unsigned int *);
+    pulIndexBlockID = (unsigned long *)va_arg(ap_, unsigned long *);
+    puiTermID = (unsigned int *)va_arg(ap_, unsigned int *);
+    piError = (int *)va_arg(ap_, int *);
+    va_end(ap_);
+
+
+    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
+    ASSERT(puiTermType != NULL);
+    ASSERT(puiTermCount != NULL);
+    ASSERT(puiDocumentCount != NULL);
+    ASSERT(pulIndexBlockID != NULL);
+    ASSERT(puiTermID != NULL);
+    ASSERT(piError != NULL);
+
+
+    /* Unpack the entry, this sets the returned error */
+    *piError = iSrchTermDictUnpackEntry((unsigned char *)pvEntryData, uiEntryLength, bTermIDs, pucFieldIDBitmap, uiFieldIDBitmapLength, 
+            puiTermType, puiTermCount, puiDocumentCount, pulIndexBlockID, puiTermID);
+
+
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "pucKey [%s], *puiTermType: [%u], puiTermCount: [%u], *puiDocumentCount: [%u], *pulIndexBlockID: [%lu], *puiTermID: [%u]",  */
+/*             pucKey, *puiTermType, *puiTermCount, *puiDocumentCount, *pulIndexBlockID, *puiTermID); */
+
+
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictLookupListCallBack()
+
+    Purpose:    This function is passed to the dictionary lookup function to
+                perform extra processing on a term.
+
+    Parameters: pucKey          key (term)
+                pvEntryData     entry data
+                uiEntryLength   entry length
+                ap              arg list
+
+    Globals:    none
+
+    Returns:    0 to continue processing, non-0 otherwise
+
+*/
+static int iSrchTermDictLookupListCallBack
+(
+    unsigned char *pucKey,
+    void *pvEntryData,
+    unsigned int uiEntryLength,
+    va_list ap
+)
+{
+
+    va_list                     ap_;
+    int                         iError = SRCH_NoError;
+    int                         iStatus = 0;
+    boolean                     bFinished = false;
+
+    struct srchTermDictInfo     *pstdiSrchTermDictInfos = NULL;
+    unsigned int                uiSrchTermDictInfosLength = 0;
+    unsigned int                uiTermMatch = SRCH_TERMDICT_TERM_MATCH_UNKNOWN;
+    boolean                     bCaseSensitive = false;
+    wchar_t                     wcCharacter = L'\0';
+    wchar_t                     *pwcEncodedTerm = NULL;
+    unsigned int                uiEncodedTermLength = 0;
+    struct srchTermDictMatch    *pstdmSrchTermDictMatch = NULL;
+    unsigned int                uiSrchTermDictMatchLength = 0;
+    regex_t                     *prRegex = NULL;
+    void                        *pvHandle = NULL;
+    boolean                     bTermIDs = false;
+    unsigned char               *pucFieldIDBitmap = NULL;
+    unsigned int                uiFieldIDBitmapLength = 0;
+    struct srchTermDictInfo     **ppstdiSrchTermDictInfos = NULL;
+    unsigned int                *puiSrchTermDictInfosLength = NULL;
+    unsigned int                *piError = NULL;
+    boolean                     bFieldMatch = false;
+    boolean                     bTermMatch = false;
+
+    unsigned char               *pucEntryDataPtr = NULL;
+    unsigned char               *pucEntryDataEndPtr = NULL;
+    unsigned int                uiTermType = 0;
+    unsigned int                uiTermCount = 0;
+    unsigned int                uiDocumentCount = 0;
+    unsigned long               ulIndexBlockID = 0;
+    unsigned int                uiFieldID = 0;
+
+    /* This used as a return parameter for calls to soundex, phonix and metaphone */
+    wchar_t                     pwcEncodedKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+    wchar_t                     pwcKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+
+
+
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupListCallBack [%s][%u][%s]", pucKey, uiEntryLength, */
+/*             (pvEntryData != NULL) ? "(pvEntryData != NULL)" : "(pvEntryData == NULL)"); */
+
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(pvEntryData != NULL);
+    ASSERT(uiEntryLength > 0);
+
+
+    /* Get all our parameters, note that we make a copy of 'ap' */
+    va_copy(ap_, ap);
+    uiTermMatch = (unsigned int)va_arg(ap_, unsigned int);
+    bCaseSensitive = (boolean)va_arg(ap_, unsigned int);
+    wcCharacter = (wchar_t)va_arg(ap_, wchar_t);
+    pwcEncodedTerm = (wchar_t *)va_arg(ap_, wchar_t *);
+    uiEncodedTermLength = (unsigned int)va_arg(ap_, unsigned int);
+    pstdmSrchTermDictMatch = (struct srchTermDictMatch *)va_arg(ap_, struct srchTermDictMatch *);
+    uiSrchTermDictMatchLength = (unsigned int)va_arg(ap_, unsigned int);
+    prRegex = (regex_t *)va_arg(ap_, regex_t *);
+    pvHandle = (void *)va_arg(ap_, void *);
+    bTermIDs = (boolean)va_arg(ap_, unsigned int);
+    pucFieldIDBitmap = (unsigned char *)va_arg(ap_, unsigned char *);
+    uiFieldIDBitmapLength = (unsigned int)va_arg(ap_, unsigned int);
+    ppstdiSrchTermDictInfos = (struct srchTermDictInfo **)va_arg(ap_, struct srchTermDictInfo **);
+    puiSrchTermDictInfosLength = (unsigned int *)va_arg(ap_, unsigned int *);
+    piError = (int *)va_arg(ap_, int *);
+    va_end(ap_);
+
+
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupListCallBack [%u][%s][%lc][%ls][%u][%ls][%u][field ID bitmap %sdefined][%u]", */
+/*             uiTermMatch, (bCaseSensitive == true) ? "true" : "false", (wint_t)wcCharacter, pwcEncodedTerm, uiEncodedTermLength, pwcUtlStringsGetPrintableWideString(pwcEncodedTerm),  */
+/*             uiSrchTermDictMatchLength, (pucFieldIDBitmap != NULL) ? "" : "not ", *puiSrchTermDictInfosLength); */
+
+
+    ASSERT(SRCH_TERMDICT_TERM_MATCH_VALID(uiTermMatch) == true);
+    ASSERT(wcCharacter != L'\0');
+    ASSERT((bCaseSensitive == true) || (bCaseSensitive == false));
+    ASSERT(((bUtlStringsIsWideStringNULL(pwcEncodedTerm) == false) && (uiEncodedTermLength > 0)) || ((bUtlStringsIsWideStringNULL(pwcEncodedTerm) == true) && (uiEncodedTermLength == 0)));
+    ASSERT(((pstdmSrchTermDictMatch != NULL) && (uiSrchTermDictMatchLength > 0)) || ((pstdmSrchTermDictMatch == NULL) && (uiSrchTermDictMatchLength == 0)));
+    ASSERT(((pvHandle != NULL) && 
+                ((uiTermMatch == SRCH_TERMDICT_TERM_MATCH_SOUNDEX) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_PHONIX) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_METAPHONE) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_TYPO))) ||
+                ((pvHandle == NULL) && 
+                ((uiTermMatch == SRCH_TERMDICT_TERM_MATCH_REGULAR) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_STOP) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_WILDCARD) || (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_REGEX))));
+    ASSERT(((prRegex != NULL) && (uiTermMatch == SRCH_TERMDICT_TERM_MATCH_REGEX)) || ((prRegex == NULL) && (uiTermMatch != SRCH_TERMDICT_TERM_MATCH_REGEX)));
+    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
+    ASSERT(ppstdiSrchTermDictInfos != NULL);
+    ASSERT(puiSrchTermDictInfosLength != NULL);
+
+
+    /* Extract some information from the data pointer */ 
+    pucEntryDataPtr = (unsigned char *)pvEntryData;
+    UTL_NUM_READ_COMPRESSED_UINT(uiTermType, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_UINT(uiTermCount, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_UINT(uiDocumentCount, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_ULONG(ulIndexBlockID, pucEntryDataPtr);
+
+    /* Skip the term ID, the field IDs follow it */
+    if ( bTermIDs == true ) {
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucEntryDataPtr);
+    }
+
+
+    /* Assume that we are not going to add this term */
+    bFieldMatch = false;
+
+    /* Do we need to prequalify this term against the field ID */
+    if ( pucFieldIDBitmap != NULL ) {
+
+        pucEntryDataEndPtr = (unsigned char *)pvEntryData + uiEntryLength;
+
+        /* Scan the field IDs */
+        while ( pucEntryDataPtr < pucEntryDataEndPtr ) {
+        
+            /* Decode */
+            UTL_NUM_READ_COMPRESSED_UINT(uiFieldID, pucEntryDataPtr);
+
+            ASSERT(uiFieldID <= uiFieldIDBitmapLength); 
+
+            /* Check for a match - field ID 0 is not a field */
+            if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucFieldIDBitmap, uiFieldID - 1) ) {
+                /* We have a match so we break */
+                bFieldMatch = true;
+                break;
+            }
+        }
+    }
+    else {
+        bFieldMatch = true;
+    }
+
+    /* Bail here if there is no field match */ 
+    if ( bFieldMatch == false ) {
+        goto bailFromiSrchTermDictLookupListCallBack;
+    }
+    
+    
+
+    /* Convert the key from utf-8 to wide characters */
+    if ( (iError = iLngConvertUtf8ToWideString_s(pucKey, 0, pwcKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert the key from utf-8 to wide characters, lng error: %d.", iError);
+        iStatus = -1;
+        goto bailFromiSrchTermDictLookupListCallBack;
+    }
+
+
+    /* Assume that we are not going to add this term */
+    bTermMatch = false;
+
+    /* And check it, adding it to the list if it matches */
+    switch ( uiTermMatch ) {
+
+        case SRCH_TERMDICT_TERM_MATCH_REGULAR:
+            
+            /* Include all regular terms */
+            if ( uiTermType == SPI_TERM_TYPE_REGULAR ) {
+                bTermMatch = true;
+            }
+            break;
+
+
+        case SRCH_TERMDICT_TERM_MATCH_STOP:
+            
+            /* Include all stop terms */
+            if ( uiTermType == SPI_TERM_TYPE_STOP ) {
+                bTermMatch = true;
+            }
+            break;
+
+
+        case SRCH_TERMDICT_TERM_MATCH_WILDCARD:
+        
+            /* Match all terms if the character is a space, otherwise
+            ** match terms where the first letter of the key matches the character,
+            ** bail as soon as we exit the character range 
+            */
+            if ( wcCharacter == L' ' ) {
+
+/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls'", pwcKey); */
+
+                if ( iSrchTermDictMatchTermToSearchTermDictMatch(pwcKey, pstdmSrchTermDictMatch, uiSrchTermDictMatchLength) == 0 ) {
+                    bTermMatch = true;
+                }
+            }
+            else {
+                if ( pwcKey[0] > wcCharacter ) {
+                    bFinished = true;
+                }
+                else if ( pwcKey[0] == wcCharacter ) {
+                    
+                    int iLocalStatus = s_wcsncmp(pwcEncodedTerm, pwcKey, uiEncodedTermLength);
+                    
+                    if ( iLocalStatus < 0 ) {
+                        bFinished = true;
+                    }
+                    else if ( iLocalStatus == 0 ) {
+                        
+/*                         iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls'", pwcKey); */
+
+                        if ( iSrchTermDictMatchTermToSearchTermDictMatch(pwcKey, pstdmSrchTermDictMatch, uiSrchTermDictMatchLength) == 0 ) {
+                            bTermMatch = true;
+                        }
+                    }
+                }
+            }
+            break;
+
+
+        case SRCH_TERMDICT_TERM_MATCH_SOUNDEX:
+            
+            /* Match terms while the first letter of the key matches the character,
+            ** bail as soon as we exit the character range
+            */
+            if ( pwcKey[0] > wcCharacter  ) {
+                bFinished = true;
+            }
+            else if ( pwcKey[0] == wcCharacter ) {
+
+                /* Soundex the key and compare */
+                if ( (iError = iLngSoundexGetSoundexKey(pvHandle, pwcKey, pwcEncodedKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the soundex key for a term, lng error: %d.", iError);
+                    iStatus = -1;
+                    goto bailFromiSrchTermDictLookupListCallBack;
+                }
+
+/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls', pwcEncodedTerm: '%ls', pwcEncodedKey: '%ls'", pwcKey, pwcEncodedTerm, pwcEncodedKey); */
+
+                if ( s_wcscmp(pwcEncodedTerm, pwcEncodedKey) == 0 ) {
+                    bTermMatch = true;
+                }
+            }
+            break;
+
+
+        case SRCH_TERMDICT_TERM_MATCH_PHONIX:
+
+            /* Match terms while the first letter of the key matches the character,
+            ** bail as soon as we exit the character range
+            */
+            if ( pwcKey[0] > wcCharacter  ) {
+                bFinished = true;
+            }
+            else if ( pwcKey[0] == wcCharacter ) {
+
+                /* Phonix the key and compare */
+                if ( (iError = iLngPhonixGetPhonixKey(pvHandle, pwcKey, pwcEncodedKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the phonix key for a term, lng error: %d.", iError);
+                    iStatus = -1;
+                    goto bailFromiSrchTermDictLookupListCallBack;
+                }
+
+/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls', pwcEncodedTerm: '%ls', pwcEncodedKey: '%ls'", pwcKey, pwcEncodedTerm, pwcEncodedKey); */
+
+                if ( s_wcscmp(pwcEncodedTerm, pwcEncodedKey) == 0 ) {
+                    bTermMatch = true;
+                }
+            }
+            break;
+
+
+        case SRCH_TERMDICT_TERM_MATCH_METAPHONE:
+
+            /* Match terms while the first letter of the key matches the character,
+            ** bail as soon as we exit the character range
+            */
+            if ( pwcKey[0] > wcCharacter  ) {
+                bFinished = true;
+            }
+            else if ( pwcKey[0] == wcCharacter ) {
+
+                /* Metaphone the key and compare */
+                if ( (iError = iLngMetaphoneGetMetaphoneKey(pvHandle, pwcKey, pwcEncodedKey, UTL_FILE_PATH_MAX + 1)) != LNG_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the metaphone key for a term, lng error: %d.", iError);
+                    iStatus = -1;
+                    goto bailFromiSrchTermDictLookupListCallBack;
+                }
+
+/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls', pwcEncodedTerm: '%ls', pwcEncodedKey: '%ls'", pwcKey, pwcEncodedTerm, pwcEncodedKey); */
+
+                if ( s_wcscmp(pwcEncodedTerm, pwcEncodedKey) == 0 ) {
+                    bTermMatch = true;
+                }
+            }
+            break;
+
+
+        case SRCH_TERMDICT_TERM_MATCH_TYPO:
+            
+            /* Match terms while the first letter of the key matches the character,
+            ** bail as soon as we exit the character range
+            */
+            if ( pwcKey[0] > wcCharacter  ) {
+                bFinished = true;
+            }
+            else if ( pwcKey[0] == wcCharacter ) {
+
+/*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pwcKey: '%ls', pwcEncodedTerm: '%ls'", pwcKey, pwcEncodedTerm); */
+
+                /* Check for typo match */
+                if ( (iError = iLngTypoGetTypoMatch(pvHandle, pwcEncodedTerm, pwcKey, bCaseSensitive, SRCH_TERM_DICT_TYPO_COUNT_MAX)) == LNG_NoError ) {
+                    bTermMatch = true;
+                }
+            }
+            break;
+
+
+        case SRCH_TERMDICT_TERM_MATCH_REGEX:
+            
+            /* Match terms while the first letter of the key matches the character,
+            ** bail as soon as we exit the character range
+            */
+            if ( pwcKey[0] > wcCharacter  ) {
+                bFinished = true;
+            }
+            else if ( pwcKey[0] == wcCharacter ) {
+                if ( s_wcsncasecmp(pwcEncodedTerm, pwcKey, uiEncodedTermLength) == 0 ) {
+#if defined(TRE_REGEX_ENABLE)
+                    if ( iSrchTermDictMatchTermToRegex(pwcKey, prRegex) == 0 ) {
+                        bTermMatch = true;
+                    }
+#else
+                    if ( iSrchTermDictMatchTermToRegex(pucKey, prRegex) == 0 ) {
+                        bTermMatch = true;
+                    }
+#endif    /* TRE_REGEX_ENABLE */
+                }
+            }
+            break;
+
+
+        default:
+            return (-1);
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchTermDictLookupListCallBack:
+
+
+    /* Handle the status - part i */
+    if ( iStatus == 0 ) {
+
+        /* Add the term */
+        if ( (bFieldMatch == true) && (bTermMatch == true) ) {
+    
+            struct srchTermDictInfo     *pstdiSrchTermDictInfosPtr = NULL;
+                
+/*             iUtlLogDebug(UTL_LOG_CONTEXT, "pucKey [%s], uiTermCount: [%u], uiDocumentCount: [%u]",  pucKey, uiTermCount, uiDocumentCount); */
+    
+            /* Derefence the term list and the term list length */
+            pstdiSrchTermDictInfos = *ppstdiSrchTermDictInfos;
+            uiSrchTermDictInfosLength = *puiSrchTermDictInfosLength;
+    
+            /* Allocate in blocks of SRCH_TERM_DICT_TERM_INFO_ALLOCATION */
+            if ( (uiSrchTermDictInfosLength % SRCH_TERM_DICT_TERM_INFO_ALLOCATION) == 0 ) {
+                
+                /* Note that we loop back to the bail label here, this is intentional and taken care of by iStatus */
+                if ( (pstdiSrchTermDictInfosPtr = (struct srchTermDictInfo *)s_realloc(pstdiSrchTermDictInfos, 
+                        (size_t)((uiSrchTermDictInfosLength + SRCH_TERM_DICT_TERM_INFO_ALLOCATION) * sizeof(struct srchTermDictInfo)))) == NULL ) {
+                    iStatus = -1;
+                    goto bailFromiSrchTermDictLookupListCallBack;
+                }
+                pstdiSrchTermDictInfos = pstdiSrchTermDictInfosPtr;
+            }
+    
+            /* Dereference the pointer and add the term */
+            pstdiSrchTermDictInfosPtr = pstdiSrchTermDictInfos + uiSrchTermDictInfosLength;
+            if ( (pstdiSrchTermDictInfosPtr->pucTerm = (unsigned char *)s_strdup(pucKey)) == NULL ) {
+                iStatus = -1;
+                goto bailFromiSrchTermDictLookupListCallBack;
+            }
+            pstdiSrchTermDictInfosPtr->uiTermType = uiTermType;
+            pstdiSrchTermDictInfosPtr->uiTermCount = uiTermCount;
+            pstdiSrchTermDictInfosPtr->uiDocumentCount = uiDocumentCount;
+            uiSrchTermDictInfosLength++;
+    
+            /* Set the return pointers */
+            *ppstdiSrchTermDictInfos = pstdiSrchTermDictInfos;
+            *puiSrchTermDictInfosLength = uiSrchTermDictInfosLength;
+        }
+    }
+
+
+    /* Handle the status - part ii */
+    if ( iStatus != 0 ) {
+
+        /* Free allocations */
+        struct spiTermInfo *pstiSpiTermInfos = (struct spiTermInfo *)pstdiSrchTermDictInfos;
+
+        iSpiFreeTermInfo(pstiSpiTermInfos, uiSrchTermDictInfosLength);
+        pstiSpiTermInfos = NULL;
+
+        *ppstdiSrchTermDictInfos = NULL;
+        *puiSrchTermDictInfosLength = 0;
+    }
+
+
+    return ((iStatus != 0) ? iStatus : ((bFinished == true) ? -1 : 0));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictLookupRangeCallBack()
+
+    Purpose:    This function is passed to the dictionary lookup function to
+                perform extra processing on a term.
+
+    Parameters: pucKey          key (term)
+                pvEntryData     entry data
+                uiEntryLength   entry length
+                ap              arg list
+
+    Globals:    none
+
+    Returns:    0 to continue processing, non-0 otherwise
+
+*/
+static int iSrchTermDictLookupRangeCallBack
+(
+    unsigned char *pucKey,
+    void *pvEntryData,
+    unsigned int uiEntryLength,
+    va_list ap
+)
+{
+
+    va_list                     ap_;
+    int                         iError = SRCH_NoError;
+    int                         iStatus = 0;
+    boolean                     bFinished = false;
+
+    struct srchTermDictInfo     *pstdiSrchTermDictInfos = NULL;
+    unsigned int                uiSrchTermDictInfosLength = 0;
+    unsigned int                uiDictRangeMatchTerm = SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA;
+    wchar_t                     wcCharacter = L'\0';
+    int                         iTermStartNumber = 0;
+    int                         iTermEndNumber = 0;
+    wchar_t                     *pwcTermStart = NULL;
+    wchar_t                     *pwcTermEnd = NULL;
+    unsigned int                uiRangeID = 0;
+    unsigned int                uiDictCaseScan = 0;
+    boolean                     bTermIDs = false;
+    unsigned char               *pucFieldIDBitmap = NULL;
+    unsigned int                uiFieldIDBitmapLength = 0;
+    struct srchTermDictInfo     **ppstdiSrchTermDictInfos = NULL;
+    unsigned int                *puiSrchTermDictInfosLength = 0;
+    unsigned int                *piError = NULL;
+
+    unsigned char               *pucEntryDataPtr = NULL;
+    unsigned char               *pucEntryDataEndPtr = NULL;
+    unsigned int                uiFieldID = 0;
+    unsigned int                uiTermType = 0;
+    unsigned int                uiTermCount = 0;
+    unsigned int                uiDocumentCount = 0;
+    unsigned int                ulIndexBlockID = 0;
+
+    unsigned char               *pucKeyPtr = NULL;
+
+    int                         iDictTermNumber = 0;
+    boolean                     bFieldMatch = false;
+    boolean                     bTermMatch = false;
+    
+    wchar_t                     pwcKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+
+
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupRangeCallBack [%s][%u][%s]", pucKey, uiEntryLength, */
+/*             (pvEntryData != NULL) ? "(pvEntryData != NULL)" : "(pvEntryData == NULL)"); */
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(pvEntryData != NULL);
+    ASSERT(uiEntryLength > 0);
+
+
+    /* Get all our parameters, note that we make a copy of 'ap' */
+    va_copy(ap_, ap);
+    uiDictRangeMatchTerm = (unsigned int)va_arg(ap_, unsigned int);
+    wcCharacter = (wchar_t)va_arg(ap_, wchar_t);
+
+    if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE) ) {
+        iTermStartNumber = (int)va_arg(ap_, int);
+        iTermEndNumber = (int)va_arg(ap_, int);
+    }
+    else if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE) ) {
+        pwcTermStart = (wchar_t *)va_arg(ap_, wchar_t *);
+        pwcTermEnd = (wchar_t *)va_arg(ap_, wchar_t *);
+    }
+
+    uiRangeID = (unsigned int)va_arg(ap_, unsigned int);
+    uiDictCaseScan = (unsigned int)va_arg(ap_, unsigned int);
+    bTermIDs = (boolean)va_arg(ap_, unsigned int);
+    pucFieldIDBitmap = (unsigned char *)va_arg(ap_, unsigned char *);
+    uiFieldIDBitmapLength = (unsigned int)va_arg(ap_, unsigned int);
+    ppstdiSrchTermDictInfos = (struct srchTermDictInfo **)va_arg(ap_, struct srchTermDictInfo **);
+    puiSrchTermDictInfosLength = (unsigned int *)va_arg(ap_, unsigned int *);
+    piError = (int *)va_arg(ap_, int *);
+    va_end(ap_);
+
+
+/*     if ( bUtlLogIsDebug(UTL_LOG_CONTEXT) == true ) { */
+/*         if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE) ) { */
+/*             iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupRangeCallBack [%u][%lc][%d][%d][%u][%u][field ID bitmap %defined][%u]", uiDictRangeMatchTerm, wcCharacter,  */
+/*                     iTermStartNumber, iTermEndNumber, uiRangeID, uiDictCaseScan, (pucFieldIDBitmap != NULL) ? "" : "not ", *puiSrchTermDictInfosLength); */
+/*         } */
 /*         else if ( (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE) ) { */
 /*             iUtlLogDebug(UTL_LOG_CONTEXT, "iSrchTermDictLookupRangeCallBack [%u][%lc][%ls][%ls][%u][%u][field ID bitmap %defined][%u]", uiDictRangeMatchTerm, wcCharacter,  */
 /*                     pwcUtlStringsGetPrintableWideString(pwcTermStart), pwcUtlStringsGetPrintableWideString(pwcTermEnd), uiRangeID, uiDictCaseScan,  */
@@ -2201,408 +3638,1840 @@ static int iSrchTermDictLookupRangeCallBack
 /*         } */
 /*     } */
 
-    ASSERT(SRCH_TERM_DICT_RANGE_MATCH_TERM_VALID(uiDictRangeMatchTerm) == true);
-    
-    ASSERT( ((uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE)) ||
-            (((uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE)) && 
-            (bUtlStringsIsWideStringNULL(pwcTermStart) == false)) );
+    ASSERT(SRCH_TERM_DICT_RANGE_MATCH_TERM_VALID(uiDictRangeMatchTerm) == true);
+    
+    ASSERT( ((uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE)) ||
+            (((uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE)) && 
+            (bUtlStringsIsWideStringNULL(pwcTermStart) == false)) );
+
+    ASSERT( ((bUtlStringsIsWideStringNULL(pwcTermStart) == true) && (bUtlStringsIsWideStringNULL(pwcTermEnd) == true)) ||
+            ((bUtlStringsIsWideStringNULL(pwcTermStart) == false) && (bUtlStringsIsWideStringNULL(pwcTermEnd) == true)) ||
+            ((bUtlStringsIsWideStringNULL(pwcTermStart) == false) && (bUtlStringsIsWideStringNULL(pwcTermEnd) == false)) );
+
+    ASSERT(SRCH_PARSER_RANGE_VALID(uiRangeID) == true);
+    
+    ASSERT( ((uiRangeID == SRCH_PARSER_RANGE_EQUAL_ID) && ((uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE) || 
+            (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE))) || 
+            (((uiRangeID == SRCH_PARSER_RANGE_EQUAL_ID) || (uiRangeID == SRCH_PARSER_RANGE_NOT_EQUAL_ID) || (uiRangeID == SRCH_PARSER_RANGE_GREATER_ID) || 
+            (uiRangeID == SRCH_PARSER_RANGE_LESS_ID) || (uiRangeID == SRCH_PARSER_RANGE_GREATER_OR_EQUAL_ID) || (uiRangeID == SRCH_PARSER_RANGE_LESS_OR_EQUAL_ID)) && 
+            ((uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA))) );
+    
+    ASSERT(SRCH_TERM_DICT_CASE_SCAN_VALID(uiDictCaseScan) == true);
+    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
+    ASSERT(ppstdiSrchTermDictInfos != NULL);
+    ASSERT(puiSrchTermDictInfosLength != NULL);
+    ASSERT(piError != NULL);
+
+
+    /* Extract some information from the data pointer */ 
+    pucEntryDataPtr = (unsigned char *)pvEntryData;
+    UTL_NUM_READ_COMPRESSED_UINT(uiTermType, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_UINT(uiTermCount, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_UINT(uiDocumentCount, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_ULONG(ulIndexBlockID, pucEntryDataPtr);
+
+    /* Skip the term ID, the field IDs follow it */
+    if ( bTermIDs == true ) {
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucEntryDataPtr);
+    }
+
+
+    /* Assume that we are not going to add this term */
+    bFieldMatch = false;
+
+    /* Do we need to prequalify this term against the field ID */
+    if ( pucFieldIDBitmap != NULL ) {
+
+        pucEntryDataEndPtr = (unsigned char *)pvEntryData + uiEntryLength;
+
+        /* Scan the field IDs */
+        while ( pucEntryDataPtr < pucEntryDataEndPtr ) {
+        
+            /* Decode */
+            UTL_NUM_READ_COMPRESSED_UINT(uiFieldID, pucEntryDataPtr);
+
+            ASSERT(uiFieldID <= uiFieldIDBitmapLength); 
+
+            /* Check for a match - field ID 0 is not a field */
+            if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucFieldIDBitmap, uiFieldID - 1) ) {
+                /* We have a match so we break */
+                bFieldMatch = true;
+                break;
+            }
+        }
+    }
+    else {
+        bFieldMatch = true;
+    }
+
+    /* Bail here if there is no field match */ 
+    if ( bFieldMatch == false ) {
+        goto bailFromlLookUpRangeInTermDictCallBack;
+    }
+
+    
+
+    /* Assume that we are not going to add this term */
+    bTermMatch = false;
+
+    /* Are we looking for numbers or strings ? */
+    switch ( uiDictRangeMatchTerm ) {
+        
+        /* We are looking for numerics */
+        case SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC:
+        case SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE:
+
+            /* Assume that we are not going to add this term */
+            bTermMatch = false;
+
+            /* Check that we have not reached the end of the numeric part of the dictionary */
+            if ( pucKey[0] > '9' ) {
+                bFinished = true;
+                goto bailFromlLookUpRangeInTermDictCallBack;
+            }
+
+            /* See if the number is numeric (check the first character of this term) */
+            if ( ((isdigit(pucKey[0]) == 0) && (pucKey[0] != '-') && (pucKey[0] != '.')) == true ) {
+                bTermMatch = false;
+                goto bailFromlLookUpRangeInTermDictCallBack;
+            }
+
+            /* See if the number is numeric (check all the other characters of this term) */
+            for ( bTermMatch = true, pucKeyPtr = pucKey + 1; *pucKeyPtr != '\0'; pucKeyPtr++ ) {
+                if ( (isdigit(*pucKeyPtr) == 0) && (*pucKeyPtr != '.') ) {
+                    bTermMatch = false;
+                    goto bailFromlLookUpRangeInTermDictCallBack;
+                }
+            }
+
+
+            /* Assume that we are not going to add this term */
+            bTermMatch = false;
+
+            iDictTermNumber = s_strtol(pucKey, NULL, 10);
+            
+            switch ( uiRangeID ) {
+                
+                case SRCH_PARSER_RANGE_EQUAL_ID:
+                    
+                    if ( uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC ) {
+                        if ( iDictTermNumber == iTermStartNumber ) {
+                            bTermMatch = true;
+                            bFinished = true;
+                        }
+                    }
+                    else if ( uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE ) {
+                        if ( (iDictTermNumber >= iTermStartNumber) && (iDictTermNumber <= iTermEndNumber) ) {
+                            bTermMatch = true;
+                        }
+                    }
+                    break;
+                
+                
+                case SRCH_PARSER_RANGE_NOT_EQUAL_ID:
+                    
+                    if ( iDictTermNumber != iTermStartNumber ) {
+                        bTermMatch = true;
+                    }
+                    break;
+                
+                
+                case SRCH_PARSER_RANGE_GREATER_ID:
+                    
+                    if ( iDictTermNumber > iTermStartNumber ) {
+                        bTermMatch = true;
+                    }
+                    break;
+                
+                
+                case SRCH_PARSER_RANGE_LESS_ID:
+                    
+                    if ( iDictTermNumber < iTermStartNumber ) {
+                        bTermMatch = true;
+                    }
+                    break;
+                
+                
+                case SRCH_PARSER_RANGE_GREATER_OR_EQUAL_ID:
+                    
+                    if ( iDictTermNumber >= iTermStartNumber ) {
+                        bTermMatch = true;
+                    }
+                    break;
+                
+                
+                case SRCH_PARSER_RANGE_LESS_OR_EQUAL_ID:
+                    
+                    if ( iDictTermNumber <= iTermStartNumber ) {
+                        bTermMatch = true;
+                    }
+                    break;
+                
+                
+                default:
+                    return (-1);
+            }
+            break;
+        
+        
+        /* We are looking for non-numerics */
+        case SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA:
+        case SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE:
+
+            /* Assume that we are not going to add this term */
+            bTermMatch = false;
+
+            /* Check that we are still in the correct part of the dictionary */
+            if ( uiDictCaseScan == SRCH_TERM_DICT_CASE_SCAN_NUMERIC ) {
+                if ( (pucKey[0] >= '0') && (pucKey[0] <= '9') ) {
+                    bTermMatch = true;
+                }
+                else if ( pucKey[0] > '9' ) {
+                    bFinished = true;
+                }
+            }
+            else if ( uiDictCaseScan == SRCH_TERM_DICT_CASE_SCAN_UPPER ) {
+                if ( (pucKey[0] >= 'A') && (pucKey[0] <= 'Z') ) {
+                    bTermMatch = true;
+                }
+                else if ( pucKey[0] > 'Z' ) {
+                    bFinished = true;
+                }
+            }
+            else if ( uiDictCaseScan == SRCH_TERM_DICT_CASE_SCAN_LOWER ) {
+                if ( (pucKey[0] >= 'a') && (pucKey[0] <= 'z') ) {
+                    bTermMatch = true;
+                }
+                else if ( pucKey[0] > 'z' ) {
+                    bFinished = true;
+                }
+            }
+            else if ( uiDictCaseScan == SRCH_TERM_DICT_CASE_SCAN_HIGH ) {
+                if ( pucKey[0] > 127 ) {
+                    bTermMatch = true;
+                }
+            }
+
+            /* Check that we can still potentially add this term */
+            if ( bTermMatch == false ) {
+                goto bailFromlLookUpRangeInTermDictCallBack;
+            }
+
+
+            /* Assume that we are not going to add this term */
+            bTermMatch = false;
+
+            /* Convert the key from utf-8 to wide characters */
+            if ( (iError = iLngConvertUtf8ToWideString_s(pucKey, 0, pwcKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert the key from utf-8 to wide characters, lng error: %d.", iError);
+                iStatus = -1;
+                goto bailFromlLookUpRangeInTermDictCallBack;
+            }
+
+            switch ( uiRangeID ) {
+                
+                case SRCH_PARSER_RANGE_EQUAL_ID:
+                    
+                    /* Match terms while the first letter of the key matches the character,
+                    ** bail as soon as we exit the character range
+                    */
+                    if ( uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA ) {
+                        if ( pwcKey[0] > wcCharacter ) {
+                            bFinished = true;
+                        }
+                        else if ( pwcKey[0] == wcCharacter ) {
+                        
+                            int iLocalStatus = s_wcscasecmp(pwcKey, pwcTermStart);
+
+                            if ( iLocalStatus == 0 ) {
+                                bTermMatch = true;
+                            }
+                            else if ( iLocalStatus > 0 ) {
+                                if ( s_wcscmp(pwcKey + 1, pwcTermStart + 1) > 0 ) {
+                                    bFinished = true;
+                                    goto bailFromlLookUpRangeInTermDictCallBack;
+                                }
+                            }
+                        }
+                    }
+                    else if ( uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE ) {
+                        if ( pwcKey[0] > wcCharacter ) {
+                            bFinished = true;
+                        }
+                        else if ( pwcKey[0] == wcCharacter ) {
+                        
+                            int iLocalStatus = s_wcscasecmp(pwcKey, pwcTermEnd);
+                            
+                            if ( (s_wcscasecmp(pwcKey, pwcTermStart) >= 0) && (iLocalStatus <= 0) ) {
+                                bTermMatch = true;
+                            }
+                            else if ( iLocalStatus > 0 ) {
+                                bFinished = true;
+                                goto bailFromlLookUpRangeInTermDictCallBack;
+                            }
+                        }
+                    }
+                    break;
+
+
+                case SRCH_PARSER_RANGE_NOT_EQUAL_ID:
+
+                    if ( s_wcscasecmp(pwcKey, pwcTermStart) != 0 ) {
+                        bTermMatch = true;
+                    }
+                    break;
+
+
+                case SRCH_PARSER_RANGE_GREATER_ID:
+
+                    /* Match terms while the first letter of the key is greater or equal to the character*/
+                    if ( pwcKey[0] >= wcCharacter ) {
+                        if ( s_wcscasecmp(pwcKey, pwcTermStart) > 0 ) {
+                            bTermMatch = true;
+                        }
+                    }
+                    break;
+            
+            
+                case SRCH_PARSER_RANGE_LESS_ID:
+                    
+                    /* Match terms while the first letter of the key is less than or equal to the character*/
+                    if ( pwcKey[0] > pwcTermStart[0] ) {
+                        bFinished = true;
+                    }
+                    else {
+                        if ( s_wcscasecmp(pwcKey, pwcTermStart) < 0 ) {
+                            bTermMatch = true;
+                        }
+                    } 
+                    break;
+
+
+                case SRCH_PARSER_RANGE_GREATER_OR_EQUAL_ID:
+
+                    /* Match terms while the first letter of the key is greater or equal to the character*/
+                    if ( pwcKey[0] >= wcCharacter ) {
+                        if ( s_wcscasecmp(pwcKey, pwcTermStart) >= 0 ) {
+                            bTermMatch = true;
+                        }
+                    }
+                    break;
+                
+                
+                case SRCH_PARSER_RANGE_LESS_OR_EQUAL_ID:
+
+                    /* Match terms while the first letter of the key is less than or equal to the character*/
+                    if ( pwcKey[0] > pwcTermStart[0] ) {
+                        bFinished = true;
+                    }
+                    else {
+                        if ( s_wcscasecmp(pwcKey, pwcTermStart) <= 0 ) {
+                            bTermMatch = true;
+                        }
+                    } 
+                    break;
+
+
+                default:
+                    return (-1);
+            }
+            break;
+        
+        default:
+            return (-1);
+    }
+
+
+
+    /* Bail label */
+    bailFromlLookUpRangeInTermDictCallBack:
+
+    /* Handle the status - part i */
+    if ( iStatus == 0 ) {
+
+        /* Add the term */
+        if ( (bFieldMatch == true) && (bTermMatch == true) ) {
+    
+            struct srchTermDictInfo     *pstdiSrchTermDictInfosPtr = NULL;
+    
+/*             iUtlLogDebug(UTL_LOG_CONTEXT, "pucKey [%s], uiTermType: [%u], uiTermCount: [%u], uiDocumentCount: [%u]",  pucKey, uiTermType, uiTermCount, uiDocumentCount); */
+    
+            /* Derefence the term list and the term list length */
+            pstdiSrchTermDictInfos = *ppstdiSrchTermDictInfos;
+            uiSrchTermDictInfosLength = *puiSrchTermDictInfosLength;
+    
+            /* Allocate in blocks of SRCH_TERM_DICT_TERM_INFO_ALLOCATION */
+            if ( (uiSrchTermDictInfosLength % SRCH_TERM_DICT_TERM_INFO_ALLOCATION) == 0 ) {
+
+                /* Note that we loop back to the bail label here, this is intentional and taken care of by iStatus */
+                if ( (pstdiSrchTermDictInfosPtr = (struct srchTermDictInfo *)s_realloc(pstdiSrchTermDictInfos, 
+                        (size_t)((uiSrchTermDictInfosLength + SRCH_TERM_DICT_TERM_INFO_ALLOCATION) * sizeof(struct srchTermDictInfo)))) == NULL ) {
+                    iStatus = -1;
+                    goto bailFromlLookUpRangeInTermDictCallBack;
+                }
+                pstdiSrchTermDictInfos = pstdiSrchTermDictInfosPtr;
+            }
+    
+            /* Dereference the pointer and add the term */
+            pstdiSrchTermDictInfosPtr = pstdiSrchTermDictInfos + uiSrchTermDictInfosLength;
+            if ( (pstdiSrchTermDictInfosPtr->pucTerm = (unsigned char *)s_strdup(pucKey)) == NULL ) {
+                iStatus = -1;
+                goto bailFromlLookUpRangeInTermDictCallBack;
+            }
+            pstdiSrchTermDictInfosPtr->uiTermType = uiTermType;
+            pstdiSrchTermDictInfosPtr->uiTermCount = uiTermCount;
+            pstdiSrchTermDictInfosPtr->uiDocumentCount = uiDocumentCount;
+            uiSrchTermDictInfosLength++;
+    
+            /* Set the return pointers */
+            *ppstdiSrchTermDictInfos = pstdiSrchTermDictInfos;
+            *puiSrchTermDictInfosLength = uiSrchTermDictInfosLength;
+        }
+    }
+
+
+    /* Handle the status - part ii */
+    if ( iStatus != 0 ) {
+
+        /* Free allocations */
+        struct spiTermInfo *pstiSpiTermInfos = (struct spiTermInfo *)pstdiSrchTermDictInfos;
+
+        iSpiFreeTermInfo(pstiSpiTermInfos, uiSrchTermDictInfosLength);
+        pstiSpiTermInfos = NULL;
+
+        *ppstdiSrchTermDictInfos = NULL;
+        *puiSrchTermDictInfosLength = 0;
+    }
+
+
+    return ((iStatus != 0) ? iStatus : ((bFinished == true) ? -1 : 0));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/* 
+** =========================
+** ===  Match Structure  ===
+** =========================
+*/
+
+
+/*
+
+    Function:   iSrchTermDictGetSearchTermDictMatchFromTerm()
+
+    Purpose:    Parse a term into a match structure.
+
+    Parameters: pwcTerm                        term to parse
+                bCaseSensitive                  true if case sensitive
+                ppstdmSrchTermDictMatch         return pointer for the search term dict structure array
+                puiSrchTermDictMatchLength      return pointer for the number of entries 
+                                                in the array of match search term dict structures
+
+    Globals:    none
+
+    Returns:     SRCH error code
+
+*/
+static int iSrchTermDictGetSearchTermDictMatchFromTerm
+(
+    wchar_t *pwcTerm,
+    boolean bCaseSensitive,
+    struct srchTermDictMatch **ppstdmSrchTermDictMatch,
+    unsigned int *puiSrchTermDictMatchLength
+)
+{
+
+    wchar_t                     *pwcTermPtr = NULL;
+
+    wchar_t                     pwcBuffer[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+    wchar_t                     *pwcBufferPtr = NULL;
+
+    struct srchTermDictMatch    *pstdmSrchTermDictMatch = NULL;
+    unsigned int                uiSrchTermDictMatchLength = 0;
+
+    unsigned int                uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_LITERAL;
+
+
+    ASSERT(bUtlStringsIsWideStringNULL(pwcTerm) == false);
+    ASSERT((bCaseSensitive == true) || (bCaseSensitive == false));
+    ASSERT(ppstdmSrchTermDictMatch != NULL);
+    ASSERT(puiSrchTermDictMatchLength != NULL);
+
+
+    /* Parse the term into a match structure */
+    for ( pwcTermPtr = pwcTerm, pwcBufferPtr = pwcBuffer, uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_LITERAL; *pwcTermPtr != L'\0'; pwcTermPtr++ ) {
+
+        /* This will never match, but it makes the defines below a little easier to read */        
+        if ( *pwcTermPtr == L' ' ) {
+            ;
+        }
+
+#if defined(SRCH_TERM_DICT_ENABLE_MULTI_WILDCARD)
+        else if ( *pwcTermPtr == SRCH_PARSER_WILDCARD_MULTI_WCHAR ) {
+
+            /* Terminate the current buffer and add it to the match entry list */
+            *pwcBufferPtr = L'\0';
+            SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
+
+            /* Set the next match type and reset the buffer */
+            uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_MULTI;
+            pwcBufferPtr = pwcBuffer;
+            *pwcBufferPtr = L'\0';
+
+        }
+#endif /* defined(SRCH_TERM_DICT_ENABLE_MULTI_WILDCARD) */
+
+#if defined(SRCH_TERM_DICT_ENABLE_SINGLE_WILDCARD)
+        else if ( *pwcTermPtr == SRCH_PARSER_WILDCARD_SINGLE_WCHAR ) {
+
+            /* Terminate the current buffer and add it to the match entry list */
+            *pwcBufferPtr = L'\0';
+            SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
+
+            /* Set the next match type and reset the buffer */
+            uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_SINGLE;
+            pwcBufferPtr = pwcBuffer;
+            *pwcBufferPtr = L'\0';
+
+        }
+#endif /* defined(SRCH_TERM_DICT_ENABLE_SINGLE_WILDCARD) */
+
+#if defined(SRCH_TERM_DICT_ENABLE_ALPHA_WILDCARD)
+        else if ( *pwcTermPtr == SRCH_PARSER_WILDCARD_ALPHA_WCHAR ) {
+
+            /* Terminate the current buffer and add it to the match entry list */
+            *pwcBufferPtr = L'\0';
+            SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
+
+            /* Set the next match type and reset the buffer */
+            uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_ALPHA;
+            pwcBufferPtr = pwcBuffer;
+            *pwcBufferPtr = L'\0';
+
+        }
+#endif /* defined(SRCH_TERM_DICT_ENABLE_ALPHA_WILDCARD) */
+
+#if defined(SRCH_TERM_DICT_ENABLE_NUMERIC_WILDCARD)
+        else if ( *pwcTermPtr == SRCH_PARSER_WILDCARD_NUMERIC_WCHAR ) {
+
+            /* Terminate the current buffer and add it to the match entry list */
+            *pwcBufferPtr = L'\0';
+            SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
+
+            /* Set the next match type and reset the buffer */
+            uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_NUMERIC;
+            pwcBufferPtr = pwcBuffer;
+            *pwcBufferPtr = L'\0';
+
+        }
+#endif /* defined(SRCH_TERM_DICT_ENABLE_NUMERIC_WILDCARD) */
+
+        else {
+            /* Cummulate the current letter into the buffer */
+            *pwcBufferPtr = *pwcTermPtr;
+            pwcBufferPtr++;
+        }
+    }
+
+    /* And add the final match entry to the match entry list */
+    *pwcBufferPtr = L'\0';
+    SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
+
+
+    /* Set the return pointers */
+    *ppstdmSrchTermDictMatch = pstdmSrchTermDictMatch;
+    *puiSrchTermDictMatchLength = uiSrchTermDictMatchLength;
+
+
+/*     iSrchTermDictPrintSearchTermDictMatch(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength); */
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictMatchTermToSearchTermDictMatch()
+
+    Purpose:    Match a term to a match structure.
+
+    Parameters: pwcTerm                     term to parse
+                pstdmSrchTermDictMatch      search term dict structure array
+                uiSrchTermDictMatchLength   number of entries in the array of match search term dict structures
+
+    Globals:    none
+
+    Returns:     0 on match, non-0 otherwise
+
+*/
+static int iSrchTermDictMatchTermToSearchTermDictMatch
+(
+    wchar_t *pwcTerm,
+    struct srchTermDictMatch *pstdmSrchTermDictMatch,
+    unsigned int uiSrchTermDictMatchLength
+)
+{
+
+    unsigned int                uiI = 0;
+    wchar_t                     *pwcPtr = NULL;
+    wchar_t                     *pwcTermPtr = NULL;
+    struct srchTermDictMatch    *pstdmSrchTermDictMatchPtr = NULL;
+
+
+    ASSERT(bUtlStringsIsWideStringNULL(pwcTerm) == false);
+    ASSERT(pstdmSrchTermDictMatch != NULL);
+    ASSERT(uiSrchTermDictMatchLength > 0);
+
+
+    /* Loop over the match entry list */
+    for ( uiI = 0, pwcTermPtr = pwcTerm, pstdmSrchTermDictMatchPtr = pstdmSrchTermDictMatch; (uiI < uiSrchTermDictMatchLength) && (*pwcTermPtr != L'\0'); uiI++, pstdmSrchTermDictMatchPtr++ ) {
+
+        switch ( pstdmSrchTermDictMatchPtr->uiMatchType ) {
+
+            case SRCH_TERM_DICT_MATCH_TYPE_LITERAL:
+
+                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
+                    if ( s_wcsncmp(pwcTermPtr, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0 ) {
+                        pwcTermPtr += pstdmSrchTermDictMatchPtr->uiMatchStringLength;
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                else {
+                    if ( s_wcsncasecmp(pwcTermPtr, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0 ) {
+                        pwcTermPtr += pstdmSrchTermDictMatchPtr->uiMatchStringLength;
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                break;
+
+
+#if defined(SRCH_TERM_DICT_ENABLE_MULTI_WILDCARD)
+            case SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_MULTI:
+
+                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
+                    if ( (pwcPtr = s_wcsstr(pwcTermPtr, pstdmSrchTermDictMatchPtr->pwcMatchString)) != NULL ) {
+                        if ( (uiI >= (uiSrchTermDictMatchLength - 1)) && ((bUtlStringsIsWideStringNULL(pstdmSrchTermDictMatchPtr->pwcMatchString) == true)) ) {
+                            pwcTermPtr = s_wcschr(pwcTermPtr, L'\0');
+                        }
+                        else {
+                            pwcTermPtr = pwcPtr + pstdmSrchTermDictMatchPtr->uiMatchStringLength;
+                        }
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                else {
+                    if ( (pwcPtr = s_wcscasestr(pwcTermPtr, pstdmSrchTermDictMatchPtr->pwcMatchString)) != NULL ) {
+                        if ( (uiI >= (uiSrchTermDictMatchLength - 1)) && ((bUtlStringsIsWideStringNULL(pstdmSrchTermDictMatchPtr->pwcMatchString) == true)) ) {
+                            pwcTermPtr = s_wcschr(pwcTermPtr, L'\0');
+                        }
+                        else {
+                            pwcTermPtr = pwcPtr + pstdmSrchTermDictMatchPtr->uiMatchStringLength;
+                        }
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                break;
+#endif /* defined(SRCH_TERM_DICT_ENABLE_MULTI_WILDCARD) */
+
+
+#if defined(SRCH_TERM_DICT_ENABLE_SINGLE_WILDCARD)
+            case SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_SINGLE:
+
+                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
+                    if ( s_wcsncmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0 ) {
+                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                else {
+                    if ( s_wcsncasecmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0 ) {
+                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                break;
+#endif /* defined(SRCH_TERM_DICT_ENABLE_SINGLE_WILDCARD) */
+
+
+#if defined(SRCH_TERM_DICT_ENABLE_ALPHA_WILDCARD)
+            case SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_ALPHA:
+
+                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
+                    if ( (s_wcsncmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0) &&
+                            (iswalpha(*pwcTermPtr) != 0) ) {
+                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                else {
+                    if ( (s_wcsncasecmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0) &&
+                            (iswalpha(*pwcTermPtr) != 0) ) {
+                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                break;
+#endif /* defined(SRCH_TERM_DICT_ENABLE_ALPHA_WILDCARD) */
+
+
+#if defined(SRCH_TERM_DICT_ENABLE_NUMERIC_WILDCARD)
+            case SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_NUMERIC:
+
+                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
+                    if ( (s_wcsncasecmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0) &&
+                            (iswdigit(*pwcTermPtr) != 0) ) {
+                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                else {
+                    if ( (s_wcsncasecmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0) &&
+                            (iswdigit(*pwcTermPtr) != 0) ) {
+                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
+                    }
+                    else {
+                        return (-1); 
+                    }
+                }
+                break;
+#endif /* defined(SRCH_TERM_DICT_ENABLE_NUMERIC_WILDCARD) */
+
+
+            default:
+                /* Error - invalid match type entry */
+                return (-1); 
+
+        }
+    }
+
+
+    /* Check to see if there is only one more match record and that it is a wildard entry, 
+    ** this is to take care of cases such as 'animal*' where the wildcard is at the end of
+    ** the term because the loop bails on us at '(*pwcTermPtr != L'\0')' and we dont make 
+    ** a match when we should have done so.
+    */ 
+    if ( (bUtlStringsIsWideStringNULL(pwcTermPtr) == true) && (uiI == (uiSrchTermDictMatchLength - 1)) && 
+            ((pstdmSrchTermDictMatch + uiI)->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_MULTI) && ((pstdmSrchTermDictMatch + uiI)->uiMatchStringLength == 0) ) {
+        uiI = uiSrchTermDictMatchLength;
+    }
+
+    /* We failed to make a match if there was anything left in our term pointer of in the match entries */
+    if ( (bUtlStringsIsWideStringNULL(pwcTermPtr) == false) || (uiI < uiSrchTermDictMatchLength) ) {
+        return (-1);
+    }
+
+
+    /* Return a match */
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictPrintSearchTermDictMatch()
+
+    Purpose:    Print a match structure.
+
+    Parameters: pstdmSrchTermDictMatch      search term dict structure array
+                uiSrchTermDictMatchLength   number of entries in the array of match search term dict structures
+
+    Globals:    none
+
+    Returns:     0 on match, non-0 otherwise
+
+*/
+static int iSrchTermDictPrintSearchTermDictMatch
+(
+    struct srchTermDictMatch *pstdmSrchTermDictMatch,
+    unsigned int uiSrchTermDictMatchLength
+)
+{
+
+    unsigned int                uiI = 0;
+    struct srchTermDictMatch    *pstdmSrchTermDictMatchPtr = NULL;
+
+
+    ASSERT(pstdmSrchTermDictMatch != NULL);
+    ASSERT(uiSrchTermDictMatchLength > 0);
+
+
+    /* Loop over the match entry list */
+    for ( uiI = 0, pstdmSrchTermDictMatchPtr = pstdmSrchTermDictMatch; uiI < uiSrchTermDictMatchLength; uiI++, pstdmSrchTermDictMatchPtr++ ) {
+
+        printf("uiMatchType: [");
+        
+        if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_LITERAL ) {
+            printf("literal");
+        }
+        else if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_MULTI ) {
+            printf("wildcard multi (%c)", SRCH_PARSER_WILDCARD_MULTI_CHAR);
+        }
+        else if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_SINGLE ) {
+            printf("wildcard single (%c)", SRCH_PARSER_WILDCARD_SINGLE_CHAR);
+        }
+        else if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_ALPHA ) {
+            printf("wildcard alpha (%c)", SRCH_PARSER_WILDCARD_ALPHA_CHAR);
+        }
+        else if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_NUMERIC ) {
+            printf("wildcard numeric (%c)", SRCH_PARSER_WILDCARD_NUMERIC_CHAR);
+        }
+        else {
+            printf("invalid wildcard");
+        }
+        
+        printf("], pwcMatchString: [%ls], uiMatchStringLength: [%u], bCaseSensitive: [%s]\n", pstdmSrchTermDictMatchPtr->pwcMatchString, 
+                pstdmSrchTermDictMatchPtr->uiMatchStringLength, (pstdmSrchTermDictMatchPtr->bCaseSensitive == true) ? "true" : "false");
+    }
+
+
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/* 
+** ===================
+** ===  Term Hash  ===
+** ===================
+*/
+
+
+/*
+
+    Function:   ulSrchTermDictGetTermHash()
+
+    Purpose:    This function returns the hash of a term, this is a 64 bit
+                FNV-1a hash of the term bytes.
+
+    Parameters: pucTerm     term
+
+    Globals:    none
+
+    Returns:    The term hash
+
+*/
+static unsigned long ulSrchTermDictGetTermHash
+(
+    unsigned char *pucTerm
+)
+{
+
+    unsigned long   ulTermHash = SRCH_TERM_DICT_TERM_HASH_OFFSET_BASIS;
+    unsigned char   *pucTermPtr = NULL;
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucTerm) == false);
+
+
+    /* Hash the term */
+    for ( pucTermPtr = pucTerm; *pucTermPtr != '\0'; pucTermPtr++ ) {
+        ulTermHash ^= (unsigned long)*pucTermPtr;
+        ulTermHash *= SRCH_TERM_DICT_TERM_HASH_PRIME;
+    }
+
+
+    return (ulTermHash);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/* 
+** ==================
+** ===  Term IDs  ===
+** ==================
+*/
+
+
+/*
+
+    Function:   iSrchTermDictUnpackEntry()
+
+    Purpose:    This function unpacks a term dictionary entry into the
+                return pointers.
+
+                If a field ID bitmap is passed, the term count, document 
+                count and index block ID are set to 0 if the term does not
+                occur in any of the fields, the term type is left alone.
+
+    Parameters: pucEntryData            entry data
+                uiEntryLength           entry length
+                bTermIDs                true if the entry contains a term ID
+                pucFieldIDBitmap        field ID bitmap (optional)
+                uiFieldIDBitmapLength   field ID bitmap length (optional)
+                puiTermType             return pointer for the term type
+                puiTermCount            return pointer for the term count
+                puiDocumentCount        return pointer for the document count
+                pulIndexBlockID         return pointer for the index block ID
+                puiTermID               return pointer for the term ID
+
+    Globals:    none
+
+    Returns:    SRCH_NoError if the term occurs, SRCH_TermDictTermDoesNotOccur 
+                if it does not occur in the fields
+
+*/
+static int iSrchTermDictUnpackEntry
+(
+    unsigned char *pucEntryData,
+    unsigned int uiEntryLength,
+    boolean bTermIDs,
+    unsigned char *pucFieldIDBitmap,
+    unsigned int uiFieldIDBitmapLength,
+    unsigned int *puiTermType,
+    unsigned int *puiTermCount,
+    unsigned int *puiDocumentCount,
+    unsigned long *pulIndexBlockID,
+    unsigned int *puiTermID
+)
+{
+
+    unsigned char   *pucEntryDataPtr = NULL;
+    unsigned char   *pucEntryDataEndPtr = NULL;
+    unsigned int    uiTermType = 0;
+    unsigned int    uiTermCount = 0;
+    unsigned int    uiDocumentCount = 0;
+    unsigned long   ulIndexBlockID = 0;
+    unsigned int    uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
+    unsigned int    uiFieldID = 0;
+
+
+    ASSERT(pucEntryData != NULL);
+    ASSERT(uiEntryLength > 0);
+    ASSERT((bTermIDs == true) || (bTermIDs == false));
+    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
+    ASSERT(puiTermType != NULL);
+    ASSERT(puiTermCount != NULL);
+    ASSERT(puiDocumentCount != NULL);
+    ASSERT(pulIndexBlockID != NULL);
+    ASSERT(puiTermID != NULL);
+
+
+    /* Extract some information from the data pointer, decode to a variable and copy to the pointer for optimization */ 
+    pucEntryDataPtr = pucEntryData;
+    UTL_NUM_READ_COMPRESSED_UINT(uiTermType, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_UINT(uiTermCount, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_UINT(uiDocumentCount, pucEntryDataPtr);
+    UTL_NUM_READ_COMPRESSED_ULONG(ulIndexBlockID, pucEntryDataPtr);
+
+    if ( bTermIDs == true ) {
+        UTL_NUM_READ_COMPRESSED_UINT(uiTermID, pucEntryDataPtr);
+    }
+
+    *puiTermType = uiTermType;
+    *puiTermCount = uiTermCount;
+    *puiDocumentCount = uiDocumentCount;
+    *pulIndexBlockID = ulIndexBlockID;
+    *puiTermID = uiTermID;
+
+
+    /* This is not a fielded lookup, so we can just return, the term exists and occurs */
+    if ( pucFieldIDBitmap == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* We need to check that this term occurs in the field specified by the passed field ID */
+    pucEntryDataEndPtr = pucEntryData + uiEntryLength;
+
+    /* Scan the field IDs */
+    while ( pucEntryDataPtr < pucEntryDataEndPtr ) {
+
+        /* Decode the field ID */
+        UTL_NUM_READ_COMPRESSED_UINT(uiFieldID, pucEntryDataPtr);
+
+        ASSERT(uiFieldID <= uiFieldIDBitmapLength); 
+
+        /* Check for a match - field ID 0 is not a field, the term exists and occurs in the specified field */
+        if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucFieldIDBitmap, uiFieldID - 1) ) {
+            return (SRCH_NoError);
+        }
+    }
+
+
+    /* Dropped through from the field check without finding the term in the specific field,
+    ** so we set the term count and doc count to 0, but we leave the work type alone 
+    */
+    *puiTermCount = 0;    
+    *puiDocumentCount = 0;    
+    *pulIndexBlockID = 0;    
+
+
+    /* The term exists but does not occur */
+    return (SRCH_TermDictTermDoesNotOccur);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictAddTermID()
+
+    Purpose:    This function adds a term and its term dictionary entry to 
+                the term ID table data file, giving the term the next term ID.
+
+    Parameters: psiSrchIndex    search index structure
+                pucTerm         term
+                pucEntryData    entry data
+                uiEntryLength   entry length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermDictAddTermID
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucTerm,
+    unsigned char *pucEntryData,
+    unsigned int uiEntryLength
+)
+{
+
+    int                         iError = SRCH_NoError;
+    struct srchIndexBuild       *psibSrchIndexBuild = NULL;
+    unsigned char               pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    unsigned int                uiTermLength = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucTerm) == false);
+    ASSERT(pucEntryData != NULL);
+    ASSERT(uiEntryLength > 0);
+
+
+    /* Dereference the index build structure for convenience */
+    psibSrchIndexBuild = psiSrchIndex->psibSrchIndexBuild;
+
+
+    /* Create the data file if this is the first term */
+    if ( psibSrchIndexBuild->pfTermIDsDataFile == NULL ) {
+
+        if ( (iError = iSrchFilePathsGetTermIDsFilePathFromIndex(psiSrchIndex, SRCH_TERMDICT_TERM_IDS_FILE_DATA_ID, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term ID table data file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+            return (iError);
+        }
+
+        if ( (psibSrchIndexBuild->pfTermIDsDataFile = s_fopen(pucFilePath, "w")) == NULL ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term ID table data file: '%s'.", pucFilePath);
+            return (SRCH_TermDictAddTermIDFailed);
+        }
+    }
+
+
+    /* Extend the term offsets if needed, leaving space for term ID 0 and for the end of the data */
+    if ( (psibSrchIndexBuild->uiTermIDsLength + 3) > psibSrchIndexBuild->uiTermIDsCapacity ) {
+
+        unsigned int    uiTermIDsCapacity = UTL_MACROS_MAX(psibSrchIndexBuild->uiTermIDsCapacity * 2, psibSrchIndexBuild->uiTermIDsLength + 3);
+        unsigned long   *pulTermIDOffsets = NULL;
+
+        if ( (pulTermIDOffsets = (unsigned long *)s_realloc(psibSrchIndexBuild->pulTermIDOffsets, (size_t)(sizeof(unsigned long) * uiTermIDsCapacity))) == NULL ) {
+            return (SRCH_MemError);
+        }
+
+        psibSrchIndexBuild->pulTermIDOffsets = pulTermIDOffsets;
+        psibSrchIndexBuild->uiTermIDsCapacity = uiTermIDsCapacity;
+    }
+
+
+    /* Set the term offset, term ID 0 is not a term */
+    psibSrchIndexBuild->pulTermIDOffsets[0] = 0;
+    psibSrchIndexBuild->pulTermIDOffsets[psibSrchIndexBuild->uiTermIDsLength + 1] = psibSrchIndexBuild->ulTermIDsDataLength;
+
+
+    /* Write the term, NULL terminated, followed by the entry */
+    uiTermLength = s_strlen(pucTerm) + 1;
+
+    if ( (s_fwrite(pucTerm, uiTermLength, 1, psibSrchIndexBuild->pfTermIDsDataFile) != 1) || 
+            (s_fwrite(pucEntryData, uiEntryLength, 1, psibSrchIndexBuild->pfTermIDsDataFile) != 1) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to write to the term ID table data file, index: '%s'.", psiSrchIndex->pucIndexName);
+        return (SRCH_TermDictAddTermIDFailed);
+    }
+
+    psibSrchIndexBuild->ulTermIDsDataLength += uiTermLength + uiEntryLength;
+    psibSrchIndexBuild->uiTermIDsLength++;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictMapTermIDsFile()
+
+    Purpose:    This function maps in a term ID table file, the pointer is
+                left NULL if the file does not exist or is empty.
+
+    Parameters: psiSrchIndex    search index structure
+                uiFileID        term ID table file ID
+                ppvFile         return pointer for the mapped file
+                pzFileLength    return pointer for the mapped file length
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermDictMapTermIDsFile
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiFileID,
+    void **ppvFile,
+    size_t *pzFileLength
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    FILE            *pfFile = NULL;
+    off_t           zFileLength = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(SRCH_TERMDICT_TERM_IDS_FILE_VALID(uiFileID) == true);
+    ASSERT(ppvFile != NULL);
+    ASSERT(pzFileLength != NULL);
+
+
+    /* Get the file path */
+    if ( (iError = iSrchFilePathsGetTermIDsFilePathFromIndex(psiSrchIndex, uiFileID, pucFilePath, UTL_FILE_PATH_MAX + 1)) != SRCH_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term ID table file path, index: '%s', srch error: %d.", psiSrchIndex->pucIndexName, iError);
+        return (iError);
+    }
+
+    /* Skip the file if it does not exist */
+    if ( bUtlFileIsFile(pucFilePath) == false ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Open the file */
+    if ( (pfFile = s_fopen(pucFilePath, "r")) == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the term ID table file: '%s'.", pucFilePath);
+        return (SRCH_TermDictOpenTermIDsFailed);
+    }
+
+    /* Get the file length */
+    if ( (iError = iUtlFileGetFileLength(pfFile, &zFileLength)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the length of the term ID table file: '%s', utl error: %d.", pucFilePath, iError);
+        iError = SRCH_TermDictOpenTermIDsFailed;
+        goto bailFromiSrchTermDictMapTermIDsFile;
+    }
+
+    /* Map in the file if it is not empty */
+    if ( zFileLength > 0 ) {
+        if ( (iError = iUtlFileMemoryMap(fileno(pfFile), 0, (size_t)zFileLength, PROT_READ, ppvFile)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to map in the term ID table file: '%s', utl error: %d.", pucFilePath, iError);
+            iError = SRCH_TermDictOpenTermIDsFailed;
+            goto bailFromiSrchTermDictMapTermIDsFile;
+        }
+        *pzFileLength = (size_t)zFileLength;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchTermDictMapTermIDsFile:
+
+
+    /* Close the file, the mapping stays in place */
+    s_fclose(pfFile);
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vSrchTermDictRemoveTermIDsFiles()
+
+    Purpose:    This function removes the term ID table files.
+
+    Parameters: psiSrchIndex    search index structure
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vSrchTermDictRemoveTermIDsFiles
+(
+    struct srchIndex *psiSrchIndex
+)
+{
+
+    unsigned char   pucFilePath[UTL_FILE_PATH_MAX + 1] = {'\0'};
+    unsigned int    uiFileID = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+
+
+    /* Remove the files */
+    for ( uiFileID = SRCH_TERMDICT_TERM_IDS_FILE_INDEX_ID; SRCH_TERMDICT_TERM_IDS_FILE_VALID(uiFileID) == true; uiFileID++ ) {
+        if ( iSrchFilePathsGetTermIDsFilePathFromIndex(psiSrchIndex, uiFileID, pucFilePath, UTL_FILE_PATH_MAX + 1) == SRCH_NoError ) {
+            s_remove(pucFilePath);
+        }
+    }
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictProcessTermIDList()
+
+    Purpose:    This function calls the callback function for each term ID 
+                in the term ID list, passing it the term and its term 
+                dictionary entry from the term ID table, just as if the terms
+                had been read from the term dictionary.
+
+                The callback function gets called as follows:
+
+                    iSrchTermDictCallBackFunction(pucKey, pvEntryData, uiEntryLength, ap)
+
+                and processing stops if the callback function returns non-0.
+
+    Parameters: psiSrchIndex                        search index structure
+                puiTermIDs                          term ID list, sorted
+                uiTermIDsLength                     term ID list length
+                (*iSrchTermDictCallBackFunction)()  callback function
+                ...                                 args (optional)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermDictProcessTermIDList
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int *puiTermIDs,
+    unsigned int uiTermIDsLength,
+    int (*iSrchTermDictCallBackFunction)(),
+    ...
+)
+{
 
-    ASSERT( ((bUtlStringsIsWideStringNULL(pwcTermStart) == true) && (bUtlStringsIsWideStringNULL(pwcTermEnd) == true)) ||
-            ((bUtlStringsIsWideStringNULL(pwcTermStart) == false) && (bUtlStringsIsWideStringNULL(pwcTermEnd) == true)) ||
-            ((bUtlStringsIsWideStringNULL(pwcTermStart) == false) && (bUtlStringsIsWideStringNULL(pwcTermEnd) == false)) );
+    va_list                     ap;
+    struct srchTermDictTermIDs  *pstdtiSrchTermDictTermIDs = NULL;
+    unsigned char               *pucTerm = NULL;
+    unsigned char               *pucEntryData = NULL;
+    unsigned char               *pucEntryDataEndPtr = NULL;
+    unsigned int                uiI = 0;
 
-    ASSERT(SRCH_PARSER_RANGE_VALID(uiRangeID) == true);
-    
-    ASSERT( ((uiRangeID == SRCH_PARSER_RANGE_EQUAL_ID) && ((uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE) || 
-            (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE))) || 
-            (((uiRangeID == SRCH_PARSER_RANGE_EQUAL_ID) || (uiRangeID == SRCH_PARSER_RANGE_NOT_EQUAL_ID) || (uiRangeID == SRCH_PARSER_RANGE_GREATER_ID) || 
-            (uiRangeID == SRCH_PARSER_RANGE_LESS_ID) || (uiRangeID == SRCH_PARSER_RANGE_GREATER_OR_EQUAL_ID) || (uiRangeID == SRCH_PARSER_RANGE_LESS_OR_EQUAL_ID)) && 
-            ((uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC) || (uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA))) );
-    
-    ASSERT(SRCH_TERM_DICT_CASE_SCAN_VALID(uiDictCaseScan) == true);
-    ASSERT(((pucFieldIDBitmap == NULL) && (uiFieldIDBitmapLength <= 0)) || ((pucFieldIDBitmap != NULL) && (uiFieldIDBitmapLength > 0)));
-    ASSERT(ppstdiSrchTermDictInfos != NULL);
-    ASSERT(puiSrchTermDictInfosLength != NULL);
-    ASSERT(piError != NULL);
 
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->pstdtiSrchTermDictTermIDs != NULL);
+    ASSERT(((puiTermIDs != NULL) && (uiTermIDsLength > 0)) || ((puiTermIDs == NULL) && (uiTermIDsLength == 0)));
+    ASSERT(iSrchTermDictCallBackFunction != NULL);
 
-    /* Extract some information from the data pointer */ 
-    pucEntryDataPtr = (unsigned char *)pvEntryData;
-    UTL_NUM_READ_COMPRESSED_UINT(uiTermType, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_UINT(uiTermCount, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_UINT(uiDocumentCount, pucEntryDataPtr);
-    UTL_NUM_READ_COMPRESSED_ULONG(ulIndexBlockID, pucEntryDataPtr);
 
+    pstdtiSrchTermDictTermIDs = psiSrchIndex->pstdtiSrchTermDictTermIDs;
+
+    va_start(ap, iSrchTermDictCallBackFunction);
+
+    /* Loop over the term IDs */
+    for ( uiI = 0; uiI < uiTermIDsLength; uiI++ ) {
+
+        /* Skip invalid term IDs */
+        if ( (puiTermIDs[uiI] == 0) || (puiTermIDs[uiI] > pstdtiSrchTermDictTermIDs->uiTermIDMaximum) ) {
+            continue;
+        }
+
+        /* Get the term and its entry, the entry runs from the end of the term to the start of the next term */
+        pucTerm = pstdtiSrchTermDictTermIDs->pucData + pstdtiSrchTermDictTermIDs->pulTermOffsets[puiTermIDs[uiI]];
+        pucEntryData = pucTerm + s_strlen(pucTerm) + 1;
+        pucEntryDataEndPtr = pstdtiSrchTermDictTermIDs->pucData + pstdtiSrchTermDictTermIDs->pulTermOffsets[puiTermIDs[uiI] + 1];
+
+        /* Call the callback function, stopping if it tells us to */
+        if ( iSrchTermDictCallBackFunction(pucTerm, (void *)pucEntryData, (unsigned int)(pucEntryDataEndPtr - pucEntryData), ap) != 0 ) {
+            break;
+        }
+    }
+
+    va_end(ap);
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictAddTermIDToTrie()
+
+    Purpose:    This function adds the term ID to the term ID list of the key
+                in the trie, this is used to collect the term grams and the 
+                phonetic keys while the term dictionary is being created.
+
+                Term IDs are given out in order so the term ID lists are 
+                sorted and are stored as compressed deltas, a term ID is 
+                only added once to a term ID list.
+
+    Parameters: psiSrchIndex    search index structure
+                pvUtlTrie       trie
+                pucKey          key
+                uiTermID        term ID
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermDictAddTermIDToTrie
+(
+    struct srchIndex *psiSrchIndex,
+    void *pvUtlTrie,
+    unsigned char *pucKey,
+    unsigned int uiTermID
+)
+{
+
+    int                             iError = UTL_NoError;
+    struct srchTermDictTermIDList   **ppstdtilSrchTermDictTermIDList = NULL;
+    struct srchTermDictTermIDList   *pstdtilSrchTermDictTermIDList = NULL;
+    unsigned char                   *pucTermIDsPtr = NULL;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(pvUtlTrie != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(uiTermID > 0);
+
+
+    /* Add the key to the trie */
+    if ( (iError = iUtlTrieAdd(pvUtlTrie, pucKey, (void ***)&ppstdtilSrchTermDictTermIDList)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to add a key to a term ID list trie, key: '%s', index: '%s', utl error: %d.", 
+                pucKey, psiSrchIndex->pucIndexName, iError);
+        return (SRCH_TermDictAddTermIDListFailed);
+    }
+
+    /* Allocate the term ID list if this is the first time we see the key */
+    if ( *ppstdtilSrchTermDictTermIDList == NULL ) {
+        if ( (*ppstdtilSrchTermDictTermIDList = (struct srchTermDictTermIDList *)s_malloc((size_t)sizeof(struct srchTermDictTermIDList))) == NULL ) {
+            return (SRCH_MemError);
+        }
+    }
+
+    pstdtilSrchTermDictTermIDList = *ppstdtilSrchTermDictTermIDList;
+
+    /* Skip the term ID if it was already added, this happens when a key occurs more than once in a term */
+    if ( pstdtilSrchTermDictTermIDList->uiTermIDLast == uiTermID ) {
+        return (SRCH_NoError);
+    }
+
+    /* Extend the term IDs if needed */
+    if ( (pstdtilSrchTermDictTermIDList->uiTermIDsLength + UTL_NUM_COMPRESSED_UINT_MAX_SIZE) > pstdtilSrchTermDictTermIDList->uiTermIDsCapacity ) {
+
+        unsigned int    uiTermIDsCapacity = (pstdtilSrchTermDictTermIDList->uiTermIDsCapacity > 0) ? 
+                (pstdtilSrchTermDictTermIDList->uiTermIDsCapacity * 2) : SRCH_TERM_DICT_TERM_ID_LIST_ALLOCATION;
+
+        if ( (pucTermIDsPtr = (unsigned char *)s_realloc(pstdtilSrchTermDictTermIDList->pucTermIDs, (size_t)(sizeof(unsigned char) * uiTermIDsCapacity))) == NULL ) {
+            return (SRCH_MemError);
+        }
+
+        pstdtilSrchTermDictTermIDList->pucTermIDs = pucTermIDsPtr;
+        pstdtilSrchTermDictTermIDList->uiTermIDsCapacity = uiTermIDsCapacity;
+    }
+
+    /* Write out the term ID as a delta from the last term ID (increments the pointer) */
+    pucTermIDsPtr = pstdtilSrchTermDictTermIDList->pucTermIDs + pstdtilSrchTermDictTermIDList->uiTermIDsLength;
+    UTL_NUM_WRITE_COMPRESSED_UINT(uiTermID - pstdtilSrchTermDictTermIDList->uiTermIDLast, pucTermIDsPtr);
+
+    pstdtilSrchTermDictTermIDList->uiTermIDsLength = pucTermIDsPtr - pstdtilSrchTermDictTermIDList->pucTermIDs;
+    pstdtilSrchTermDictTermIDList->uiTermIDLast = uiTermID;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictCreateTermIDListsDictionary()
+
+    Purpose:    This function creates a dictionary from the term ID lists
+                in the trie, each key in the trie becomes a key in the 
+                dictionary with its term ID list as the entry.
+
+                The dictionary file is removed if it could not be created.
+
+    Parameters: pvUtlTrie       trie
+                pucFilePath     dictionary file path
+                uiKeyLength     dictionary key length
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iSrchTermDictCreateTermIDListsDictionary
+(
+    void *pvUtlTrie,
+    unsigned char *pucFilePath,
+    unsigned int uiKeyLength
+)
+{
+
+    int     iError = UTL_NoError;
+    void    *pvUtlDictionary = NULL;
+
+
+    ASSERT(pvUtlTrie != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucFilePath) == false);
+    ASSERT(uiKeyLength > 0);
+
+
+    /* Create the dictionary */
+    if ( (iError = iUtlDictCreate(pucFilePath, uiKeyLength, &pvUtlDictionary)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the dictionary: '%s', utl error: %d.", pucFilePath, iError);
+        goto bailFromiSrchTermDictCreateTermIDListsDictionary;
+    }
+
+    /* Add the term ID lists to the dictionary, the trie hands them to us in order */
+    if ( (iError = iUtlTrieLoop(pvUtlTrie, NULL, (int (*)())iSrchTermDictAddTermIDListCallBack, pvUtlDictionary)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to add the term ID lists to the dictionary: '%s', utl error: %d.", pucFilePath, iError);
+        goto bailFromiSrchTermDictCreateTermIDListsDictionary;
+    }
+
+
+
+    /* Bail label */
+    bailFromiSrchTermDictCreateTermIDListsDictionary:
+
+
+    /* Close the dictionary */
+    if ( pvUtlDictionary != NULL ) {
+        
+        int     iLocalError = UTL_NoError;
+        
+        if ( ((iLocalError = iUtlDictClose(pvUtlDictionary)) != UTL_NoError) && (iError == UTL_NoError) ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to close the dictionary: '%s', utl error: %d.", pucFilePath, iLocalError);
+            iError = iLocalError;
+        }
+        
+        pvUtlDictionary = NULL;
+    }
+
+    /* Remove the dictionary if we failed to create it, it will not be used */
+    if ( iError != UTL_NoError ) {
+        s_remove(pucFilePath);
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictGetTermIDList()
+
+    Purpose:    This function looks up the key in the dictionary and decodes
+                its term ID list, an empty term ID list is returned if the 
+                key is not in the dictionary.
+
+    Parameters: pvUtlDictionary     dictionary
+                pucKey              key
+                ppuiTermIDs         return pointer for the term IDs
+                puiTermIDsLength    return pointer for the term IDs length
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iSrchTermDictGetTermIDList
+(
+    void *pvUtlDictionary,
+    unsigned char *pucKey,
+    unsigned int **ppuiTermIDs,
+    unsigned int *puiTermIDsLength
+)
+{
+
+    int             iError = UTL_NoError;
+    unsigned char   *pucEntryData = NULL;
+    unsigned char   *pucEntryDataPtr = NULL;
+    unsigned char   *pucEntryDataEndPtr = NULL;
+    unsigned int    uiEntryLength = 0;
+    unsigned int    *puiTermIDs = NULL;
+    unsigned int    uiTermIDsLength = 0;
+    unsigned int    uiTermIDDelta = 0;
+    unsigned int    uiTermID = 0;
+
+
+    ASSERT(pvUtlDictionary != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(ppuiTermIDs != NULL);
+    ASSERT(puiTermIDsLength != NULL);
+
+
+    /* Look up the key, the term ID list is empty if it is not there */
+    if ( (iError = iUtlDictGetEntry(pvUtlDictionary, pucKey, (void **)&pucEntryData, &uiEntryLength)) != UTL_NoError ) {
+        
+        if ( iError == UTL_DictKeyNotFound ) {
+            *ppuiTermIDs = NULL;
+            *puiTermIDsLength = 0;
+            return (UTL_NoError);
+        }
+        
+        return (iError);
+    }
+
+
+    /* Allocate the term IDs, each term ID takes at least one byte */
+    if ( (puiTermIDs = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiEntryLength))) == NULL ) {
+        return (UTL_MemError);
+    }
+
+    /* Decode the term IDs */
+    for ( pucEntryDataPtr = pucEntryData, pucEntryDataEndPtr = pucEntryData + uiEntryLength; pucEntryDataPtr < pucEntryDataEndPtr; uiTermIDsLength++ ) {
+        UTL_NUM_READ_COMPRESSED_UINT(uiTermIDDelta, pucEntryDataPtr);
+        uiTermID += uiTermIDDelta;
+        puiTermIDs[uiTermIDsLength] = uiTermID;
+    }
+
+
+    /* Set the return pointers */
+    *ppuiTermIDs = puiTermIDs;
+    *puiTermIDsLength = uiTermIDsLength;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictAddTermIDListCallBack()
+
+    Purpose:    This function is passed to the trie loop to add each key
+                and its term ID list to the dictionary.
+
+    Parameters: pucKey      key
+                pvData      data
+                ap          args (optional)
+
+    Globals:    none
+
+    Returns:    0 on success, non-0 on error
+
+*/
+static int iSrchTermDictAddTermIDListCallBack
+(
+    unsigned char *pucKey,
+    void *pvData,
+    va_list ap
+)
+{
+
+    va_list                         ap_;
+    void                            *pvUtlDictionary = NULL;
+    struct srchTermDictTermIDList   *pstdtilSrchTermDictTermIDList = (struct srchTermDictTermIDList *)pvData;
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(pvData != NULL);
+
+
+    /* Get all our parameters, note that we make a copy of 'ap' */
+    va_copy(ap_, ap);
+    pvUtlDictionary = (void *)va_arg(ap_, void *);
+    va_end(ap_);
+
+    ASSERT(pvUtlDictionary != NULL);
+
+
+    /* Add the key and its term ID list to the dictionary */
+    return (iUtlDictAddEntry(pvUtlDictionary, pucKey, pstdtilSrchTermDictTermIDList->pucTermIDs, pstdtilSrchTermDictTermIDList->uiTermIDsLength));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermDictFreeTermIDListCallBack()
+
+    Purpose:    This function is passed to the trie loop to free the term 
+                IDs of each term ID list, the term ID list itself is freed 
+                with the trie.
+
+    Parameters: pucKey      key
+                pvData      data
+                ap          args (optional)
+
+    Globals:    none
+
+    Returns:    0 on success, non-0 on error
+
+*/
+static int iSrchTermDictFreeTermIDListCallBack
+(
+    unsigned char *pucKey,
+    void *pvData,
+    va_list ap
+)
+{
+
+    struct srchTermDictTermIDList   *pstdtilSrchTermDictTermIDList = (struct srchTermDictTermIDList *)pvData;
+
+
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+
+
+    /* Free the term IDs */
+    if ( pstdtilSrchTermDictTermIDList != NULL ) {
+        s_free(pstdtilSrchTermDictTermIDList->pucTermIDs);
+    }
+
+
+    return (0);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vSrchTermDictFreeTermIDListsTrie()
+
+    Purpose:    This function frees a term ID lists trie.
 
-    /* Assume that we are not going to add this term */
-    bFieldMatch = false;
+    Parameters: ppvUtlTrie      trie pointer, set to NULL
 
-    /* Do we need to prequalify this term against the field ID */
-    if ( pucFieldIDBitmap != NULL ) {
+    Globals:    none
 
-        pucEntryDataEndPtr = (unsigned char *)pvEntryData + uiEntryLength;
+    Returns:    void
 
-        /* Scan the field IDs */
-        while ( pucEntryDataPtr < pucEntryDataEndPtr ) {
-        
-            /* Decode */
-            UTL_NUM_READ_COMPRESSED_UINT(uiFieldID, pucEntryDataPtr);
+*/
+static void vSrchTermDictFreeTermIDListsTrie
+(
+    void **ppvUtlTrie
+)
+{
 
-            ASSERT(uiFieldID <= uiFieldIDBitmapLength); 
+    ASSERT(ppvUtlTrie != NULL);
 
-            /* Check for a match - field ID 0 is not a field */
-            if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucFieldIDBitmap, uiFieldID - 1) ) {
-                /* We have a match so we break */
-                bFieldMatch = true;
-                break;
-            }
-        }
-    }
-    else {
-        bFieldMatch = true;
-    }
 
-    /* Bail here if there is no field match */ 
-    if ( bFieldMatch == false ) {
-        goto bailFromlLookUpRangeInTermDictCallBack;
+    /* Free the trie, freeing the term IDs first */
+    if ( *ppvUtlTrie != NULL ) {
+        iUtlTrieLoop(*ppvUtlTrie, NULL, (int (*)())iSrchTermDictFreeTermIDListCallBack, NULL);
+        iUtlTrieFree(*ppvUtlTrie, true);
+        *ppvUtlTrie = NULL;
     }
 
-    
 
-    /* Assume that we are not going to add this term */
-    bTermMatch = false;
+    return;
 
-    /* Are we looking for numbers or strings ? */
-    switch ( uiDictRangeMatchTerm ) {
-        
-        /* We are looking for numerics */
-        case SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC:
-        case SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE:
+}
 
-            /* Assume that we are not going to add this term */
-            bTermMatch = false;
 
-            /* Check that we have not reached the end of the numeric part of the dictionary */
-            if ( pucKey[0] > '9' ) {
-                bFinished = true;
-                goto bailFromlLookUpRangeInTermDictCallBack;
-            }
+/*---------------------------------------------------------------------------*/
 
-            /* See if the number is numeric (check the first character of this term) */
-            if ( ((isdigit(pucKey[0]) == 0) && (pucKey[0] != '-') && (pucKey[0] != '.')) == true ) {
-                bTermMatch = false;
-                goto bailFromlLookUpRangeInTermDictCallBack;
-            }
 
-            /* See if the number is numeric (check all the other characters of this term) */
-            for ( bTermMatch = true, pucKeyPtr = pucKey + 1; *pucKeyPtr != '\0'; pucKeyPtr++ ) {
-                if ( (isdigit(*pucKeyPtr) == 0) && (*pucKeyPtr != '.') ) {
-                    bTermMatch = false;
-                    goto bailFromlLookUpRangeInTermDictCallBack;
-                }
-            }
+/* 
+** ====================
+** ===  Term Grams  ===
+** ====================
+*/
 
 
-            /* Assume that we are not going to add this term */
-            bTermMatch = false;
+/*
 
-            iDictTermNumber = s_strtol(pucKey, NULL, 10);
-            
-            switch ( uiRangeID ) {
-                
-                case SRCH_PARSER_RANGE_EQUAL_ID:
-                    
-                    if ( uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC ) {
-                        if ( iDictTermNumber == iTermStartNumber ) {
-                            bTermMatch = true;
-                            bFinished = true;
-                        }
-                    }
-                    else if ( uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_NUMERIC_RANGE ) {
-                        if ( (iDictTermNumber >= iTermStartNumber) && (iDictTermNumber <= iTermEndNumber) ) {
-                            bTermMatch = true;
-                        }
-                    }
-                    break;
-                
-                
-                case SRCH_PARSER_RANGE_NOT_EQUAL_ID:
-                    
-                    if ( iDictTermNumber != iTermStartNumber ) {
-                        bTermMatch = true;
-                    }
-                    break;
-                
-                
-                case SRCH_PARSER_RANGE_GREATER_ID:
-                    
-                    if ( iDictTermNumber > iTermStartNumber ) {
-                        bTermMatch = true;
-                    }
-                    break;
-                
-                
-                case SRCH_PARSER_RANGE_LESS_ID:
-                    
-                    if ( iDictTermNumber < iTermStartNumber ) {
-                        bTermMatch = true;
-                    }
-                    break;
-                
-                
-                case SRCH_PARSER_RANGE_GREATER_OR_EQUAL_ID:
-                    
-                    if ( iDictTermNumber >= iTermStartNumber ) {
-                        bTermMatch = true;
-                    }
-                    break;
-                
-                
-                case SRCH_PARSER_RANGE_LESS_OR_EQUAL_ID:
-                    
-                    if ( iDictTermNumber <= iTermStartNumber ) {
-                        bTermMatch = true;
-                    }
-                    break;
-                
-                
-                default:
-                    return (-1);
-            }
-            break;
-        
-        
-        /* We are looking for non-numerics */
-        case SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA:
-        case SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE:
+    Function:   bSrchTermDictGetTermGram()
 
-            /* Assume that we are not going to add this term */
-            bTermMatch = false;
+    Purpose:    This function copies the term gram at the start of the term 
+                into the term gram, checking that all its bytes can be indexed,
+                which rules out control characters and spaces.
 
-            /* Check that we are still in the correct part of the dictionary */
-            if ( uiDictCaseScan == SRCH_TERM_DICT_CASE_SCAN_NUMERIC ) {
-                if ( (pucKey[0] >= '0') && (pucKey[0] <= '9') ) {
-                    bTermMatch = true;
-                }
-                else if ( pucKey[0] > '9' ) {
-                    bFinished = true;
-                }
-            }
-            else if ( uiDictCaseScan == SRCH_TERM_DICT_CASE_SCAN_UPPER ) {
-                if ( (pucKey[0] >= 'A') && (pucKey[0] <= 'Z') ) {
-                    bTermMatch = true;
-                }
-                else if ( pucKey[0] > 'Z' ) {
-                    bFinished = true;
-                }
-            }
-            else if ( uiDictCaseScan == SRCH_TERM_DICT_CASE_SCAN_LOWER ) {
-                if ( (pucKey[0] >= 'a') && (pucKey[0] <= 'z') ) {
-                    bTermMatch = true;
-                }
-                else if ( pucKey[0] > 'z' ) {
-                    bFinished = true;
-                }
-            }
-            else if ( uiDictCaseScan == SRCH_TERM_DICT_CASE_SCAN_HIGH ) {
-                if ( pucKey[0] > 127 ) {
-                    bTermMatch = true;
-                }
-            }
+                The term gram needs to be at least SRCH_TERMDICT_TERM_GRAM_LENGTH + 1 
+                bytes long.
 
-            /* Check that we can still potentially add this term */
-            if ( bTermMatch == false ) {
-                goto bailFromlLookUpRangeInTermDictCallBack;
-            }
+    Parameters: pucTerm         term
+                pucTermGram     return pointer for the term gram
 
+    Globals:    none
 
-            /* Assume that we are not going to add this term */
-            bTermMatch = false;
+    Returns:    true if the term gram can be indexed, false if not
 
-            /* Convert the key from utf-8 to wide characters */
-            if ( (iError = iLngConvertUtf8ToWideString_s(pucKey, 0, pwcKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
-                iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert the key from utf-8 to wide characters, lng error: %d.", iError);
-                iStatus = -1;
-                goto bailFromlLookUpRangeInTermDictCallBack;
-            }
+*/
+static boolean bSrchTermDictGetTermGram
+(
+    unsigned char *pucTerm,
+    unsigned char *pucTermGram
+)
+{
 
-            switch ( uiRangeID ) {
-                
-                case SRCH_PARSER_RANGE_EQUAL_ID:
-                    
-                    /* Match terms while the first letter of the key matches the character,
-                    ** bail as soon as we exit the character range
-                    */
-                    if ( uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA ) {
-                        if ( pwcKey[0] > wcCharacter ) {
-                            bFinished = true;
-                        }
-                        else if ( pwcKey[0] == wcCharacter ) {
-                        
-                            int iLocalStatus = s_wcscasecmp(pwcKey, pwcTermStart);
+    unsigned int    uiI = 0;
 
-                            if ( iLocalStatus == 0 ) {
-                                bTermMatch = true;
-                            }
-                            else if ( iLocalStatus > 0 ) {
-                                if ( s_wcscmp(pwcKey + 1, pwcTermStart + 1) > 0 ) {
-                                    bFinished = true;
-                                    goto bailFromlLookUpRangeInTermDictCallBack;
-                                }
-                            }
-                        }
-                    }
-                    else if ( uiDictRangeMatchTerm == SRCH_TERM_DICT_RANGE_MATCH_TERM_ALPHA_RANGE ) {
-                        if ( pwcKey[0] > wcCharacter ) {
-                            bFinished = true;
-                        }
-                        else if ( pwcKey[0] == wcCharacter ) {
-                        
-                            int iLocalStatus = s_wcscasecmp(pwcKey, pwcTermEnd);
-                            
-                            if ( (s_wcscasecmp(pwcKey, pwcTermStart) >= 0) && (iLocalStatus <= 0) ) {
-                                bTermMatch = true;
-                            }
-                            else if ( iLocalStatus > 0 ) {
-                                bFinished = true;
-                                goto bailFromlLookUpRangeInTermDictCallBack;
-                            }
-                        }
-                    }
-                    break;
 
+    ASSERT(pucTerm != NULL);
+    ASSERT(pucTermGram != NULL);
 
-                case SRCH_PARSER_RANGE_NOT_EQUAL_ID:
 
-                    if ( s_wcscasecmp(pwcKey, pwcTermStart) != 0 ) {
-                        bTermMatch = true;
-                    }
-                    break;
+    /* Copy the term gram, this also stops at the end of the term */
+    for ( uiI = 0; uiI < SRCH_TERMDICT_TERM_GRAM_LENGTH; uiI++ ) {
+        if ( pucTerm[uiI] < SRCH_TERMDICT_TERM_GRAM_BYTE_MINIMUM ) {
+            return (false);
+        }
+        pucTermGram[uiI] = pucTerm[uiI];
+    }
 
+    pucTermGram[SRCH_TERMDICT_TERM_GRAM_LENGTH] = '\0';
 
-                case SRCH_PARSER_RANGE_GREATER_ID:
 
-                    /* Match terms while the first letter of the key is greater or equal to the character*/
-                    if ( pwcKey[0] >= wcCharacter ) {
-                        if ( s_wcscasecmp(pwcKey, pwcTermStart) > 0 ) {
-                            bTermMatch = true;
-                        }
-                    }
-                    break;
-            
-            
-                case SRCH_PARSER_RANGE_LESS_ID:
-                    
-                    /* Match terms while the first letter of the key is less than or equal to the character*/
-                    if ( pwcKey[0] > pwcTermStart[0] ) {
-                        bFinished = true;
-                    }
-                    else {
-                        if ( s_wcscasecmp(pwcKey, pwcTermStart) < 0 ) {
-                            bTermMatch = true;
-                        }
-                    } 
-                    break;
+    return (true);
 
+}
 
-                case SRCH_PARSER_RANGE_GREATER_OR_EQUAL_ID:
 
-                    /* Match terms while the first letter of the key is greater or equal to the character*/
-                    if ( pwcKey[0] >= wcCharacter ) {
-                        if ( s_wcscasecmp(pwcKey, pwcTermStart) >= 0 ) {
-                            bTermMatch = true;
-                        }
-                    }
-                    break;
-                
-                
-                case SRCH_PARSER_RANGE_LESS_OR_EQUAL_ID:
+/*---------------------------------------------------------------------------*/
 
-                    /* Match terms while the first letter of the key is less than or equal to the character*/
-                    if ( pwcKey[0] > pwcTermStart[0] ) {
-                        bFinished = true;
-                    }
-                    else {
-                        if ( s_wcscasecmp(pwcKey, pwcTermStart) <= 0 ) {
-                            bTermMatch = true;
-                        }
-                    } 
-                    break;
 
+/*
 
-                default:
-                    return (-1);
-            }
-            break;
-        
-        default:
-            return (-1);
-    }
+    Function:   iSrchTermDictAddTermGrams()
 
+    Purpose:    This function adds the term grams in the term to the term
+                grams trie, each term gram getting the term ID added to 
+                its term ID list.
 
+    Parameters: psiSrchIndex    search index structure
+                pucTerm         term
+                uiTermID        term ID
 
-    /* Bail label */
-    bailFromlLookUpRangeInTermDictCallBack:
+    Globals:    none
 
-    /* Handle the status - part i */
-    if ( iStatus == 0 ) {
+    Returns:    SRCH error code
 
-        /* Add the term */
-        if ( (bFieldMatch == true) && (bTermMatch == true) ) {
-    
-            struct srchTermDictInfo     *pstdiSrchTermDictInfosPtr = NULL;
-    
-/*             iUtlLogDebug(UTL_LOG_CONTEXT, "pucKey [%s], uiTermType: [%u], uiTermCount: [%u], uiDocumentCount: [%u]",  pucKey, uiTermType, uiTermCount, uiDocumentCount); */
-    
-            /* Derefence the term list and the term list length */
-            pstdiSrchTermDictInfos = *ppstdiSrchTermDictInfos;
-            uiSrchTermDictInfosLength = *puiSrchTermDictInfosLength;
-    
-            /* Allocate in blocks of SRCH_TERM_DICT_TERM_INFO_ALLOCATION */
-            if ( (uiSrchTermDictInfosLength % SRCH_TERM_DICT_TERM_INFO_ALLOCATION) == 0 ) {
+*/
+static int iSrchTermDictAddTermGrams
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucTerm,
+    unsigned int uiTermID
+)
+{
 
-                /* Note that we loop back to the bail label here, this is intentional and taken care of by iStatus */
-                if ( (pstdiSrchTermDictInfosPtr = (struct srchTermDictInfo *)s_realloc(pstdiSrchTermDictInfos, 
-                        (size_t)((uiSrchTermDictInfosLength + SRCH_TERM_DICT_TERM_INFO_ALLOCATION) * sizeof(struct srchTermDictInfo)))) == NULL ) {
-                    iStatus = -1;
-                    goto bailFromlLookUpRangeInTermDictCallBack;
-                }
-                pstdiSrchTermDictInfos = pstdiSrchTermDictInfosPtr;
-            }
-    
-            /* Dereference the pointer and add the term */
-            pstdiSrchTermDictInfosPtr = pstdiSrchTermDictInfos + uiSrchTermDictInfosLength;
-            if ( (pstdiSrchTermDictInfosPtr->pucTerm = (unsigned char *)s_strdup(pucKey)) == NULL ) {
-                iStatus = -1;
-                goto bailFromlLookUpRangeInTermDictCallBack;
-            }
-            pstdiSrchTermDictInfosPtr->uiTermType = uiTermType;
-            pstdiSrchTermDictInfosPtr->uiTermCount = uiTermCount;
-            pstdiSrchTermDictInfosPtr->uiDocumentCount = uiDocumentCount;
-            uiSrchTermDictInfosLength++;
-    
-            /* Set the return pointers */
-            *ppstdiSrchTermDictInfos = pstdiSrchTermDictInfos;
-            *puiSrchTermDictInfosLength = uiSrchTermDictInfosLength;
+    int             iError = UTL_NoError;
+    unsigned char   pucTermGram[SRCH_TERMDICT_TERM_GRAM_LENGTH + 1] = {'\0'};
+    unsigned int    uiTermLength = 0;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucTerm) == false);
+    ASSERT(uiTermID > 0);
+
+
+    /* Create the term grams trie if this is the first term */
+    if ( psiSrchIndex->psibSrchIndexBuild->pvUtlTermGramsTrie == NULL ) {
+        if ( (iError = iUtlTrieCreate(&psiSrchIndex->psibSrchIndexBuild->pvUtlTermGramsTrie)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the term grams trie, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
+            return (SRCH_TermDictAddTermIDListFailed);
         }
     }
 
 
-    /* Handle the status - part ii */
-    if ( iStatus != 0 ) {
-
-        /* Free allocations */
-        struct spiTermInfo *pstiSpiTermInfos = (struct spiTermInfo *)pstdiSrchTermDictInfos;
+    /* Loop over the term grams in the term */
+    uiTermLength = s_strlen(pucTerm);
+    
+    for ( uiI = 0; (uiI + SRCH_TERMDICT_TERM_GRAM_LENGTH) <= uiTermLength; uiI++ ) {
 
-        iSpiFreeTermInfo(pstiSpiTermInfos, uiSrchTermDictInfosLength);
-        pstiSpiTermInfos = NULL;
+        /* Get the term gram, skipping it if it cannot be indexed */
+        if ( bSrchTermDictGetTermGram(pucTerm + uiI, pucTermGram) == false ) {
+            continue;
+        }
 
-        *ppstdiSrchTermDictInfos = NULL;
-        *puiSrchTermDictInfosLength = 0;
+        /* Add the term ID to the term gram */
+        if ( (iError = iSrchTermDictAddTermIDToTrie(psiSrchIndex, psiSrchIndex->psibSrchIndexBuild->pvUtlTermGramsTrie, pucTermGram, uiTermID)) != SRCH_NoError ) {
+            return (iError);
+        }
     }
 
 
-    return ((iStatus != 0) ? iStatus : ((bFinished == true) ? -1 : 0));
+    return (SRCH_NoError);
 
 }
 
@@ -2610,145 +5479,286 @@ static int iSrchTermDictLookupRangeCallBack
 /*---------------------------------------------------------------------------*/
 
 
-/* 
-** =========================
-** ===  Match Structure  ===
-** =========================
-*/
-
-
 /*
 
-    Function:   iSrchTermDictGetSearchTermDictMatchFromTerm()
+    Function:   iSrchTermDictLookupTermGrams()
 
-    Purpose:    Parse a term into a match structure.
+    Purpose:    This function looks up the term grams of the literal parts of 
+                the match structure in the term gram dictionary and intersects
+                their term ID lists, giving us the IDs of the terms which may 
+                match.
 
-    Parameters: pwcTerm                        term to parse
-                bCaseSensitive                  true if case sensitive
-                ppstdmSrchTermDictMatch         return pointer for the search term dict structure array
-                puiSrchTermDictMatchLength      return pointer for the number of entries 
-                                                in the array of match search term dict structures
+                The term IDs are only candidates, the terms still need to be 
+                matched against the match structure. If none of the literal 
+                parts is long enough to contain a term gram, the term grams
+                flag is set to false and the term dictionary needs to be 
+                scanned.
+
+    Parameters: psiSrchIndex                search index structure
+                pstdmSrchTermDictMatch      search term dict match structure
+                uiSrchTermDictMatchLength   search term dict match structure length
+                ppuiTermIDs                 return pointer for the term IDs
+                puiTermIDsLength            return pointer for the term IDs length
+                pbTermGrams                 return pointer for the term grams flag
 
     Globals:    none
 
-    Returns:     SRCH error code
+    Returns:    SRCH error code
 
 */
-static int iSrchTermDictGetSearchTermDictMatchFromTerm
+static int iSrchTermDictLookupTermGrams
 (
-    wchar_t *pwcTerm,
-    boolean bCaseSensitive,
-    struct srchTermDictMatch **ppstdmSrchTermDictMatch,
-    unsigned int *puiSrchTermDictMatchLength
+    struct srchIndex *psiSrchIndex,
+    struct srchTermDictMatch *pstdmSrchTermDictMatch,
+    unsigned int uiSrchTermDictMatchLength,
+    unsigned int **ppuiTermIDs,
+    unsigned int *puiTermIDsLength,
+    boolean *pbTermGrams
 )
 {
 
-    wchar_t                     *pwcTermPtr = NULL;
+    int                         iError = SRCH_NoError;
+    struct srchTermDictMatch    *pstdmSrchTermDictMatchPtr = NULL;
+    unsigned int                uiI = 0;
+    unsigned char               pucLiteral[SRCH_TERM_LENGTH_MAXIMUM + 1] = {'\0'};
+    unsigned int                uiLiteralLength = 0;
+    unsigned char               pucTermGram[SRCH_TERMDICT_TERM_GRAM_LENGTH + 1] = {'\0'};
+    unsigned int                uiJ = 0;
+    unsigned char               *pucEntryData = NULL;
+    unsigned char               *pucEntryDataPtr = NULL;
+    unsigned char               *pucEntryDataEndPtr = NULL;
+    unsigned int                uiEntryLength = 0;
+    unsigned int                *puiTermIDs = NULL;
+    unsigned int                uiTermIDsLength = 0;
+    unsigned int                uiTermIDsIndex = 0;
+    unsigned int                uiTermIDDelta = 0;
+    unsigned int                uiTermID = 0;
+    boolean                     bTermGrams = false;
 
-    wchar_t                     pwcBuffer[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
-    wchar_t                     *pwcBufferPtr = NULL;
 
-    struct srchTermDictMatch    *pstdmSrchTermDictMatch = NULL;
-    unsigned int                uiSrchTermDictMatchLength = 0;
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->pvUtlTermGramsDictionary != NULL);
+    ASSERT(((pstdmSrchTermDictMatch != NULL) && (uiSrchTermDictMatchLength > 0)) || ((pstdmSrchTermDictMatch == NULL) && (uiSrchTermDictMatchLength == 0)));
+    ASSERT(ppuiTermIDs != NULL);
+    ASSERT(puiTermIDsLength != NULL);
+    ASSERT(pbTermGrams != NULL);
 
-    unsigned int                uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_LITERAL;
 
+    /* Loop over the literal parts of the match structure, the term grams are case sensitive */
+    for ( uiI = 0, pstdmSrchTermDictMatchPtr = pstdmSrchTermDictMatch; uiI < uiSrchTermDictMatchLength; uiI++, pstdmSrchTermDictMatchPtr++ ) {
 
-    ASSERT(bUtlStringsIsWideStringNULL(pwcTerm) == false);
-    ASSERT((bCaseSensitive == true) || (bCaseSensitive == false));
-    ASSERT(ppstdmSrchTermDictMatch != NULL);
-    ASSERT(puiSrchTermDictMatchLength != NULL);
+        if ( (pstdmSrchTermDictMatchPtr->uiMatchType != SRCH_TERM_DICT_MATCH_TYPE_LITERAL) || (pstdmSrchTermDictMatchPtr->bCaseSensitive == false) ||
+                (pstdmSrchTermDictMatchPtr->uiMatchStringLength == 0) ) {
+            continue;
+        }
 
+        /* Convert the literal from wide characters to utf-8, the term grams are byte term grams */
+        if ( iLngConvertWideStringToUtf8_s(pstdmSrchTermDictMatchPtr->pwcMatchString, 0, pucLiteral, SRCH_TERM_LENGTH_MAXIMUM + 1) != LNG_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert a literal from wide characters to utf-8.");
+            iError = SRCH_TermDictCharacterSetConvertionFailed;
+            goto bailFromiSrchTermDictLookupTermGrams;
+        }
 
-    /* Parse the term into a match structure */
-    for ( pwcTermPtr = pwcTerm, pwcBufferPtr = pwcBuffer, uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_LITERAL; *pwcTermPtr != L'\0'; pwcTermPtr++ ) {
+        uiLiteralLength = s_strlen(pucLiteral);
 
-        /* This will never match, but it makes the defines below a little easier to read */        
-        if ( *pwcTermPtr == L' ' ) {
-            ;
-        }
+        /* Loop over the term grams in the literal */
+        for ( uiJ = 0; (uiJ + SRCH_TERMDICT_TERM_GRAM_LENGTH) <= uiLiteralLength; uiJ++ ) {
 
-#if defined(SRCH_TERM_DICT_ENABLE_MULTI_WILDCARD)
-        else if ( *pwcTermPtr == SRCH_PARSER_WILDCARD_MULTI_WCHAR ) {
+            /* Get the term gram, skipping it if it cannot be indexed */
+            if ( bSrchTermDictGetTermGram(pucLiteral + uiJ, pucTermGram) == false ) {
+                continue;
+            }
 
-            /* Terminate the current buffer and add it to the match entry list */
-            *pwcBufferPtr = L'\0';
-            SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
+            /* We have a term gram to work from */
+            bTermGrams = true;
 
-            /* Set the next match type and reset the buffer */
-            uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_MULTI;
-            pwcBufferPtr = pwcBuffer;
-            *pwcBufferPtr = L'\0';
+            /* Look up the term gram, no term can match if the term gram does not occur */
+            if ( (iError = iUtlDictGetEntry(psiSrchIndex->pvUtlTermGramsDictionary, pucTermGram, (void **)&pucEntryData, &uiEntryLength)) != UTL_NoError ) {
+                
+                if ( iError != UTL_DictKeyNotFound ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to look up a term gram in the term gram dictionary, term gram: '%s', index: '%s', utl error: %d.", 
+                            pucTermGram, psiSrchIndex->pucIndexName, iError);
+                    iError = SRCH_TermDictTermLookupFailed;
+                    goto bailFromiSrchTermDictLookupTermGrams;
+                }
 
-        }
-#endif /* defined(SRCH_TERM_DICT_ENABLE_MULTI_WILDCARD) */
+                iError = SRCH_NoError;
+                uiTermIDsLength = 0;
+                goto bailFromiSrchTermDictLookupTermGrams;
+            }
 
-#if defined(SRCH_TERM_DICT_ENABLE_SINGLE_WILDCARD)
-        else if ( *pwcTermPtr == SRCH_PARSER_WILDCARD_SINGLE_WCHAR ) {
+            pucEntryDataEndPtr = pucEntryData + uiEntryLength;
 
-            /* Terminate the current buffer and add it to the match entry list */
-            *pwcBufferPtr = L'\0';
-            SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
+            /* Decode the term ID list if this is the first term gram, each term ID takes at least one byte */
+            if ( puiTermIDs == NULL ) {
 
-            /* Set the next match type and reset the buffer */
-            uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_SINGLE;
-            pwcBufferPtr = pwcBuffer;
-            *pwcBufferPtr = L'\0';
+                if ( (puiTermIDs = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * uiEntryLength))) == NULL ) {
+                    iError = SRCH_MemError;
+                    goto bailFromiSrchTermDictLookupTermGrams;
+                }
 
-        }
-#endif /* defined(SRCH_TERM_DICT_ENABLE_SINGLE_WILDCARD) */
+                for ( pucEntryDataPtr = pucEntryData, uiTermID = 0, uiTermIDsLength = 0; pucEntryDataPtr < pucEntryDataEndPtr; uiTermIDsLength++ ) {
+                    UTL_NUM_READ_COMPRESSED_UINT(uiTermIDDelta, pucEntryDataPtr);
+                    uiTermID += uiTermIDDelta;
+                    puiTermIDs[uiTermIDsLength] = uiTermID;
+                }
+            }
+            
+            /* Otherwise intersect the term ID list with the term IDs we have so far, in place */
+            else {
 
-#if defined(SRCH_TERM_DICT_ENABLE_ALPHA_WILDCARD)
-        else if ( *pwcTermPtr == SRCH_PARSER_WILDCARD_ALPHA_WCHAR ) {
+                unsigned int    uiTermIDsNewLength = 0;
 
-            /* Terminate the current buffer and add it to the match entry list */
-            *pwcBufferPtr = L'\0';
-            SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
+                for ( pucEntryDataPtr = pucEntryData, uiTermID = 0, uiTermIDsIndex = 0; 
+                        (pucEntryDataPtr < pucEntryDataEndPtr) && (uiTermIDsIndex < uiTermIDsLength); ) {
 
-            /* Set the next match type and reset the buffer */
-            uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_ALPHA;
-            pwcBufferPtr = pwcBuffer;
-            *pwcBufferPtr = L'\0';
+                    UTL_NUM_READ_COMPRESSED_UINT(uiTermIDDelta, pucEntryDataPtr);
+                    uiTermID += uiTermIDDelta;
 
+                    /* Skip over the term IDs we have which are not in the term ID list */
+                    while ( (uiTermIDsIndex < uiTermIDsLength) && (puiTermIDs[uiTermIDsIndex] < uiTermID) ) {
+                        uiTermIDsIndex++;
+                    }
+
+                    if ( (uiTermIDsIndex < uiTermIDsLength) && (puiTermIDs[uiTermIDsIndex] == uiTermID) ) {
+                        puiTermIDs[uiTermIDsNewLength] = uiTermID;
+                        uiTermIDsNewLength++;
+                        uiTermIDsIndex++;
+                    }
+                }
+
+                uiTermIDsLength = uiTermIDsNewLength;
+            }
+
+            /* No term can match if the intersection is empty */
+            if ( uiTermIDsLength == 0 ) {
+                goto bailFromiSrchTermDictLookupTermGrams;
+            }
         }
-#endif /* defined(SRCH_TERM_DICT_ENABLE_ALPHA_WILDCARD) */
+    }
 
-#if defined(SRCH_TERM_DICT_ENABLE_NUMERIC_WILDCARD)
-        else if ( *pwcTermPtr == SRCH_PARSER_WILDCARD_NUMERIC_WCHAR ) {
 
-            /* Terminate the current buffer and add it to the match entry list */
-            *pwcBufferPtr = L'\0';
-            SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
 
-            /* Set the next match type and reset the buffer */
-            uiMatchType = SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_NUMERIC;
-            pwcBufferPtr = pwcBuffer;
-            *pwcBufferPtr = L'\0';
+    /* Bail label */
+    bailFromiSrchTermDictLookupTermGrams:
 
-        }
-#endif /* defined(SRCH_TERM_DICT_ENABLE_NUMERIC_WILDCARD) */
 
-        else {
-            /* Cummulate the current letter into the buffer */
-            *pwcBufferPtr = *pwcTermPtr;
-            pwcBufferPtr++;
-        }
+    /* Handle the error */
+    if ( (iError == SRCH_NoError) && (bTermGrams == true) && (uiTermIDsLength > 0) ) {
+
+        /* Set the return pointers */
+        *ppuiTermIDs = puiTermIDs;
+        *puiTermIDsLength = uiTermIDsLength;
+        *pbTermGrams = true;
+    }
+    else {
+        
+        s_free(puiTermIDs);
+
+        /* Set the return pointers, an empty term ID list means no term can match */
+        *ppuiTermIDs = NULL;
+        *puiTermIDsLength = 0;
+        *pbTermGrams = (iError == SRCH_NoError) ? bTermGrams : false;
     }
 
-    /* And add the final match entry to the match entry list */
-    *pwcBufferPtr = L'\0';
-    SRCH_TERM_DICT_MATCH_ADD(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength, uiMatchType, pwcBuffer, bCaseSensitive);
 
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/* 
+** =======================
+** ===  Phonetic Keys  ===
+** =======================
+*/
+
+
+/*
+
+    Function:   vSrchTermDictGetPhoneticKeysPointers()
+
+    Purpose:    This function returns the index block feature, and pointers 
+                to the trie, the phonetic handle and the dictionary for the 
+                phonetic keys of a term match.
+
+                The trie and the phonetic handle pointers are set to NULL 
+                if the index is not being created.
+
+    Parameters: psiSrchIndex            search index structure
+                uiTermMatch             term match
+                puiIndexBlockFeature    return pointer for the index block feature
+                pppvUtlTrie             return pointer for the trie pointer
+                pppvLngPhonetic         return pointer for the phonetic handle pointer
+                pppvUtlDictionary       return pointer for the dictionary pointer
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vSrchTermDictGetPhoneticKeysPointers
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiTermMatch,
+    unsigned int *puiIndexBlockFeature,
+    void ***pppvUtlTrie,
+    void ***pppvLngPhonetic,
+    void ***pppvUtlDictionary
+)
+{
+
+    struct srchIndexBuild   *psibSrchIndexBuild = NULL;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == true);
+    ASSERT(puiIndexBlockFeature != NULL);
+    ASSERT(pppvUtlTrie != NULL);
+    ASSERT(pppvLngPhonetic != NULL);
+    ASSERT(pppvUtlDictionary != NULL);
 
-    /* Set the return pointers */
-    *ppstdmSrchTermDictMatch = pstdmSrchTermDictMatch;
-    *puiSrchTermDictMatchLength = uiSrchTermDictMatchLength;
 
+    psibSrchIndexBuild = psiSrchIndex->psibSrchIndexBuild;
 
-/*     iSrchTermDictPrintSearchTermDictMatch(pstdmSrchTermDictMatch, uiSrchTermDictMatchLength); */
+    *pppvUtlTrie = NULL;
+    *pppvLngPhonetic = NULL;
+
+    switch ( uiTermMatch ) {
 
+        case SRCH_TERMDICT_TERM_MATCH_SOUNDEX:
+            *puiIndexBlockFeature = SRCH_INDEX_BLOCK_FEATURE_SOUNDEX_KEYS;
+            if ( psibSrchIndexBuild != NULL ) {
+                *pppvUtlTrie = &psibSrchIndexBuild->pvUtlSoundexKeysTrie;
+                *pppvLngPhonetic = &psibSrchIndexBuild->pvLngSoundex;
+            }
+            *pppvUtlDictionary = &psiSrchIndex->pvUtlSoundexKeysDictionary;
+            break;
 
-    return (SRCH_NoError);
+        case SRCH_TERMDICT_TERM_MATCH_METAPHONE:
+            *puiIndexBlockFeature = SRCH_INDEX_BLOCK_FEATURE_METAPHONE_KEYS;
+            if ( psibSrchIndexBuild != NULL ) {
+                *pppvUtlTrie = &psibSrchIndexBuild->pvUtlMetaphoneKeysTrie;
+                *pppvLngPhonetic = &psibSrchIndexBuild->pvLngMetaphone;
+            }
+            *pppvUtlDictionary = &psiSrchIndex->pvUtlMetaphoneKeysDictionary;
+            break;
+
+        case SRCH_TERMDICT_TERM_MATCH_PHONIX:
+            *puiIndexBlockFeature = SRCH_INDEX_BLOCK_FEATURE_PHONIX_KEYS;
+            if ( psibSrchIndexBuild != NULL ) {
+                *pppvUtlTrie = &psibSrchIndexBuild->pvUtlPhonixKeysTrie;
+                *pppvLngPhonetic = &psibSrchIndexBuild->pvLngPhonix;
+            }
+            *pppvUtlDictionary = &psiSrchIndex->pvUtlPhonixKeysDictionary;
+            break;
+    }
+
+
+    return;
 
 }
 
@@ -2758,196 +5768,129 @@ static int iSrchTermDictGetSearchTermDictMatchFromTerm
 
 /*
 
-    Function:   iSrchTermDictMatchTermToSearchTermDictMatch()
+    Function:   iSrchTermDictAddPhoneticKeys()
 
-    Purpose:    Match a term to a match structure.
+    Purpose:    This function adds the phonetic keys of the term to the 
+                phonetic keys tries, one for each phonetic key enabled
+                in the index block features, each phonetic key getting 
+                the term ID added to its term ID list.
 
-    Parameters: pwcTerm                     term to parse
-                pstdmSrchTermDictMatch      search term dict structure array
-                uiSrchTermDictMatchLength   number of entries in the array of match search term dict structures
+                Terms for which a phonetic key cannot be generated are 
+                skipped, they cannot be matched phonetically anyway.
+
+    Parameters: psiSrchIndex    search index structure
+                pucTerm         term
+                uiTermID        term ID
 
     Globals:    none
 
-    Returns:     0 on match, non-0 otherwise
+    Returns:    SRCH error code
 
 */
-static int iSrchTermDictMatchTermToSearchTermDictMatch
+static int iSrchTermDictAddPhoneticKeys
 (
-    wchar_t *pwcTerm,
-    struct srchTermDictMatch *pstdmSrchTermDictMatch,
-    unsigned int uiSrchTermDictMatchLength
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucTerm,
+    unsigned int uiTermID
 )
 {
 
-    unsigned int                uiI = 0;
-    wchar_t                     *pwcPtr = NULL;
-    wchar_t                     *pwcTermPtr = NULL;
-    struct srchTermDictMatch    *pstdmSrchTermDictMatchPtr = NULL;
-
-
-    ASSERT(bUtlStringsIsWideStringNULL(pwcTerm) == false);
-    ASSERT(pstdmSrchTermDictMatch != NULL);
-    ASSERT(uiSrchTermDictMatchLength > 0);
-
-
-    /* Loop over the match entry list */
-    for ( uiI = 0, pwcTermPtr = pwcTerm, pstdmSrchTermDictMatchPtr = pstdmSrchTermDictMatch; (uiI < uiSrchTermDictMatchLength) && (*pwcTermPtr != L'\0'); uiI++, pstdmSrchTermDictMatchPtr++ ) {
-
-        switch ( pstdmSrchTermDictMatchPtr->uiMatchType ) {
-
-            case SRCH_TERM_DICT_MATCH_TYPE_LITERAL:
-
-                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
-                    if ( s_wcsncmp(pwcTermPtr, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0 ) {
-                        pwcTermPtr += pstdmSrchTermDictMatchPtr->uiMatchStringLength;
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                else {
-                    if ( s_wcsncasecmp(pwcTermPtr, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0 ) {
-                        pwcTermPtr += pstdmSrchTermDictMatchPtr->uiMatchStringLength;
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                break;
-
-
-#if defined(SRCH_TERM_DICT_ENABLE_MULTI_WILDCARD)
-            case SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_MULTI:
+    int             iError = SRCH_NoError;
+    wchar_t         pwcTerm[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+    wchar_t         pwcPhoneticKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {L'\0'};
+    unsigned char   pucPhoneticKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {'\0'};
+    unsigned int    uiTermMatch = SRCH_TERMDICT_TERM_MATCH_UNKNOWN;
+    unsigned int    uiIndexBlockFeature = SRCH_INDEX_BLOCK_FEATURE_NONE;
+    void            **ppvUtlTrie = NULL;
+    void            **ppvLngPhonetic = NULL;
+    void            **ppvUtlDictionary = NULL;
 
-                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
-                    if ( (pwcPtr = s_wcsstr(pwcTermPtr, pstdmSrchTermDictMatchPtr->pwcMatchString)) != NULL ) {
-                        if ( (uiI >= (uiSrchTermDictMatchLength - 1)) && ((bUtlStringsIsWideStringNULL(pstdmSrchTermDictMatchPtr->pwcMatchString) == true)) ) {
-                            pwcTermPtr = s_wcschr(pwcTermPtr, L'\0');
-                        }
-                        else {
-                            pwcTermPtr = pwcPtr + pstdmSrchTermDictMatchPtr->uiMatchStringLength;
-                        }
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                else {
-                    if ( (pwcPtr = s_wcscasestr(pwcTermPtr, pstdmSrchTermDictMatchPtr->pwcMatchString)) != NULL ) {
-                        if ( (uiI >= (uiSrchTermDictMatchLength - 1)) && ((bUtlStringsIsWideStringNULL(pstdmSrchTermDictMatchPtr->pwcMatchString) == true)) ) {
-                            pwcTermPtr = s_wcschr(pwcTermPtr, L'\0');
-                        }
-                        else {
-                            pwcTermPtr = pwcPtr + pstdmSrchTermDictMatchPtr->uiMatchStringLength;
-                        }
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                break;
-#endif /* defined(SRCH_TERM_DICT_ENABLE_MULTI_WILDCARD) */
 
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->psibSrchIndexBuild != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucTerm) == false);
+    ASSERT(uiTermID > 0);
 
-#if defined(SRCH_TERM_DICT_ENABLE_SINGLE_WILDCARD)
-            case SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_SINGLE:
 
-                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
-                    if ( s_wcsncmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0 ) {
-                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                else {
-                    if ( s_wcsncasecmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0 ) {
-                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                break;
-#endif /* defined(SRCH_TERM_DICT_ENABLE_SINGLE_WILDCARD) */
+    /* Loop over the phonetic keys */
+    for ( uiTermMatch = SRCH_TERMDICT_TERM_MATCH_SOUNDEX; SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == true; uiTermMatch++ ) {
 
+        /* Get the pointers, and skip the phonetic key if it is not enabled */
+        vSrchTermDictGetPhoneticKeysPointers(psiSrchIndex, uiTermMatch, &uiIndexBlockFeature, &ppvUtlTrie, &ppvLngPhonetic, &ppvUtlDictionary);
 
-#if defined(SRCH_TERM_DICT_ENABLE_ALPHA_WILDCARD)
-            case SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_ALPHA:
+        if ( !(psiSrchIndex->uiIndexBlockFeatures & uiIndexBlockFeature) ) {
+            continue;
+        }
 
-                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
-                    if ( (s_wcsncmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0) &&
-                            (iswalpha(*pwcTermPtr) != 0) ) {
-                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                else {
-                    if ( (s_wcsncasecmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0) &&
-                            (iswalpha(*pwcTermPtr) != 0) ) {
-                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                break;
-#endif /* defined(SRCH_TERM_DICT_ENABLE_ALPHA_WILDCARD) */
+        /* Convert the term from utf-8 to wide characters, this is only done once */
+        if ( pwcTerm[0] == L'\0' ) {
+            if ( (iError = iLngConvertUtf8ToWideString_s(pucTerm, 0, pwcTerm, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert a term from utf-8 to wide characters, lng error: %d.", iError);
+                return (SRCH_TermDictCharacterSetConvertionFailed);
+            }
+        }
 
+        /* Create the phonetic handle if this is the first term */
+        if ( *ppvLngPhonetic == NULL ) {
 
-#if defined(SRCH_TERM_DICT_ENABLE_NUMERIC_WILDCARD)
-            case SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_NUMERIC:
+            if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_SOUNDEX ) {
+                iError = iLngSoundexCreateByID(SRCH_TERM_DICT_SOUNDEX_ID, psiSrchIndex->uiLanguageID, ppvLngPhonetic);
+            }
+            else if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_METAPHONE ) {
+                iError = iLngMetaphoneCreateByID(SRCH_TERM_DICT_METAPHONE_ID, psiSrchIndex->uiLanguageID, ppvLngPhonetic);
+            }
+            else if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_PHONIX ) {
+                iError = iLngPhonixCreateByID(SRCH_TERM_DICT_PHONIX_ID, psiSrchIndex->uiLanguageID, ppvLngPhonetic);
+            }
 
-                if ( pstdmSrchTermDictMatchPtr->bCaseSensitive == true ) {
-                    if ( (s_wcsncasecmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0) &&
-                            (iswdigit(*pwcTermPtr) != 0) ) {
-                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                else {
-                    if ( (s_wcsncasecmp(pwcTermPtr + 1, pstdmSrchTermDictMatchPtr->pwcMatchString, pstdmSrchTermDictMatchPtr->uiMatchStringLength) == 0) &&
-                            (iswdigit(*pwcTermPtr) != 0) ) {
-                        pwcTermPtr += (pstdmSrchTermDictMatchPtr->uiMatchStringLength + 1);
-                    }
-                    else {
-                        return (-1); 
-                    }
-                }
-                break;
-#endif /* defined(SRCH_TERM_DICT_ENABLE_NUMERIC_WILDCARD) */
+            if ( iError != LNG_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a phonetic handle for the phonetic keys, term match: %u, lng error: %d.", uiTermMatch, iError);
+                return (SRCH_TermDictAddTermIDListFailed);
+            }
+        }
 
+        /* Get the phonetic key for the term, skipping the term if there is none */
+        if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_SOUNDEX ) {
+            iError = iLngSoundexGetSoundexKey(*ppvLngPhonetic, pwcTerm, pwcPhoneticKey, SRCH_TERM_LENGTH_MAXIMUM + 1);
+        }
+        else if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_METAPHONE ) {
+            iError = iLngMetaphoneGetMetaphoneKey(*ppvLngPhonetic, pwcTerm, pwcPhoneticKey, SRCH_TERM_LENGTH_MAXIMUM + 1);
+        }
+        else if ( uiTermMatch == SRCH_TERMDICT_TERM_MATCH_PHONIX ) {
+            iError = iLngPhonixGetPhonixKey(*ppvLngPhonetic, pwcTerm, pwcPhoneticKey, SRCH_TERM_LENGTH_MAXIMUM + 1);
+        }
 
-            default:
-                /* Error - invalid match type entry */
-                return (-1); 
+        if ( (iError != LNG_NoError) || (bUtlStringsIsWideStringNULL(pwcPhoneticKey) == true) ) {
+            continue;
+        }
 
+        /* Convert the phonetic key from wide characters to utf-8 */
+        if ( (iError = iLngConvertWideStringToUtf8_s(pwcPhoneticKey, 0, pucPhoneticKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert a phonetic key from wide characters to utf-8, lng error: %d.", iError);
+            return (SRCH_TermDictCharacterSetConvertionFailed);
         }
-    }
 
+        /* Skip phonetic keys which are too long for the phonetic key dictionary */
+        if ( s_strlen(pucPhoneticKey) > SRCH_TERMDICT_PHONETIC_KEY_LENGTH_MAXIMUM ) {
+            continue;
+        }
 
-    /* Check to see if there is only one more match record and that it is a wildard entry, 
-    ** this is to take care of cases such as 'animal*' where the wildcard is at the end of
-    ** the term because the loop bails on us at '(*pwcTermPtr != L'\0')' and we dont make 
-    ** a match when we should have done so.
-    */ 
-    if ( (bUtlStringsIsWideStringNULL(pwcTermPtr) == true) && (uiI == (uiSrchTermDictMatchLength - 1)) && 
-            ((pstdmSrchTermDictMatch + uiI)->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_MULTI) && ((pstdmSrchTermDictMatch + uiI)->uiMatchStringLength == 0) ) {
-        uiI = uiSrchTermDictMatchLength;
-    }
+        /* Create the phonetic keys trie if this is the first term */
+        if ( *ppvUtlTrie == NULL ) {
+            if ( (iError = iUtlTrieCreate(ppvUtlTrie)) != UTL_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to create the phonetic keys trie, index: '%s', utl error: %d.", psiSrchIndex->pucIndexName, iError);
+                return (SRCH_TermDictAddTermIDListFailed);
+            }
+        }
 
-    /* We failed to make a match if there was anything left in our term pointer of in the match entries */
-    if ( (bUtlStringsIsWideStringNULL(pwcTermPtr) == false) || (uiI < uiSrchTermDictMatchLength) ) {
-        return (-1);
+        /* Add the term ID to the phonetic key */
+        if ( (iError = iSrchTermDictAddTermIDToTrie(psiSrchIndex, *ppvUtlTrie, pucPhoneticKey, uiTermID)) != SRCH_NoError ) {
+            return (iError);
+        }
     }
 
 
-    /* Return a match */
-    return (0);
+    return (SRCH_NoError);
 
 }
 
@@ -2957,63 +5900,85 @@ static int iSrchTermDictMatchTermToSearchTermDictMatch
 
 /*
 
-    Function:   iSrchTermDictPrintSearchTermDictMatch()
+    Function:   iSrchTermDictLookupPhoneticKey()
 
-    Purpose:    Print a match structure.
+    Purpose:    This function looks up the phonetic key in the phonetic key 
+                dictionary for the term match, giving us the IDs of the terms 
+                which have that phonetic key.
 
-    Parameters: pstdmSrchTermDictMatch      search term dict structure array
-                uiSrchTermDictMatchLength   number of entries in the array of match search term dict structures
+                The term IDs are only candidates, the terms still need to be 
+                matched against the character list. If there is no phonetic key 
+                dictionary, the term ID list flag is set to false and the term 
+                dictionary needs to be scanned.
+
+    Parameters: psiSrchIndex        search index structure
+                uiTermMatch         term match
+                pwcPhoneticKey      phonetic key
+                ppuiTermIDs         return pointer for the term IDs
+                puiTermIDsLength    return pointer for the term IDs length
+                pbTermIDList        return pointer for the term ID list flag
 
     Globals:    none
 
-    Returns:     0 on match, non-0 otherwise
+    Returns:    SRCH error code
 
 */
-static int iSrchTermDictPrintSearchTermDictMatch
+static int iSrchTermDictLookupPhoneticKey
 (
-    struct srchTermDictMatch *pstdmSrchTermDictMatch,
-    unsigned int uiSrchTermDictMatchLength
+    struct srchIndex *psiSrchIndex,
+    unsigned int uiTermMatch,
+    wchar_t *pwcPhoneticKey,
+    unsigned int **ppuiTermIDs,
+    unsigned int *puiTermIDsLength,
+    boolean *pbTermIDList
 )
 {
 
-    unsigned int                uiI = 0;
-    struct srchTermDictMatch    *pstdmSrchTermDictMatchPtr = NULL;
+    int             iError = SRCH_NoError;
+    unsigned char   pucPhoneticKey[SRCH_TERM_LENGTH_MAXIMUM + 1] = {'\0'};
+    unsigned int    uiIndexBlockFeature = SRCH_INDEX_BLOCK_FEATURE_NONE;
+    void            **ppvUtlTrie = NULL;
+    void            **ppvLngPhonetic = NULL;
+    void            **ppvUtlDictionary = NULL;
 
 
-    ASSERT(pstdmSrchTermDictMatch != NULL);
-    ASSERT(uiSrchTermDictMatchLength > 0);
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(uiTermMatch) == true);
+    ASSERT(ppuiTermIDs != NULL);
+    ASSERT(puiTermIDsLength != NULL);
+    ASSERT(pbTermIDList != NULL);
 
 
-    /* Loop over the match entry list */
-    for ( uiI = 0, pstdmSrchTermDictMatchPtr = pstdmSrchTermDictMatch; uiI < uiSrchTermDictMatchLength; uiI++, pstdmSrchTermDictMatchPtr++ ) {
+    *ppuiTermIDs = NULL;
+    *puiTermIDsLength = 0;
+    *pbTermIDList = false;
 
-        printf("uiMatchType: [");
-        
-        if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_LITERAL ) {
-            printf("literal");
-        }
-        else if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_MULTI ) {
-            printf("wildcard multi (%c)", SRCH_PARSER_WILDCARD_MULTI_CHAR);
-        }
-        else if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_SINGLE ) {
-            printf("wildcard single (%c)", SRCH_PARSER_WILDCARD_SINGLE_CHAR);
-        }
-        else if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_ALPHA ) {
-            printf("wildcard alpha (%c)", SRCH_PARSER_WILDCARD_ALPHA_CHAR);
-        }
-        else if ( pstdmSrchTermDictMatchPtr->uiMatchType == SRCH_TERM_DICT_MATCH_TYPE_WILDCARD_NUMERIC ) {
-            printf("wildcard numeric (%c)", SRCH_PARSER_WILDCARD_NUMERIC_CHAR);
-        }
-        else {
-            printf("invalid wildcard");
-        }
-        
-        printf("], pwcMatchString: [%ls], uiMatchStringLength: [%u], bCaseSensitive: [%s]\n", pstdmSrchTermDictMatchPtr->pwcMatchString, 
-                pstdmSrchTermDictMatchPtr->uiMatchStringLength, (pstdmSrchTermDictMatchPtr->bCaseSensitive == true) ? "true" : "false");
+
+    /* Get the pointers, we need the phonetic key dictionary and the term ID table */
+    vSrchTermDictGetPhoneticKeysPointers(psiSrchIndex, uiTermMatch, &uiIndexBlockFeature, &ppvUtlTrie, &ppvLngPhonetic, &ppvUtlDictionary);
+
+    if ( (*ppvUtlDictionary == NULL) || (psiSrchIndex->pstdtiSrchTermDictTermIDs == NULL) || (bUtlStringsIsWideStringNULL(pwcPhoneticKey) == true) ) {
+        return (SRCH_NoError);
     }
 
 
-    return (0);
+    /* Convert the phonetic key from wide characters to utf-8 */
+    if ( (iError = iLngConvertWideStringToUtf8_s(pwcPhoneticKey, 0, pucPhoneticKey, SRCH_TERM_LENGTH_MAXIMUM + 1)) != LNG_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to convert a phonetic key from wide characters to utf-8, lng error: %d.", iError);
+        return (SRCH_TermDictCharacterSetConvertionFailed);
+    }
+
+    /* Look up the phonetic key */
+    if ( (iError = iSrchTermDictGetTermIDList(*ppvUtlDictionary, pucPhoneticKey, ppuiTermIDs, puiTermIDsLength)) != UTL_NoError ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to look up a phonetic key in the phonetic key dictionary, phonetic key: '%s', index: '%s', utl error: %d.", 
+                pucPhoneticKey, psiSrchIndex->pucIndexName, iError);
+        return (SRCH_TermDictTermLookupFailed);
+    }
+
+    *pbTermIDList = true;
+
+
+    return (SRCH_NoError);
 
 }
 
@@ -75,6 +75,45 @@ extern "C" {
                                                                 ((n) <= SRCH_TERMDICT_TERM_MATCH_TERM_RANGE))
 
 
+/* Term filter, the bits per term and the hash count give a false positive rate of about 1% */
+#define SRCH_TERMDICT_TERM_FILTER_BITS_PER_TERM         (10)
+#define SRCH_TERMDICT_TERM_FILTER_BITS_MINIMUM          (64)
+#define SRCH_TERMDICT_TERM_FILTER_HASH_COUNT            (7)
+
+
+/* Term IDs, terms are given dense term IDs in the order they are added to the
+** term dictionary, which is alphabetical order, term ID 0 is not a term
+*/
+#define SRCH_TERMDICT_TERM_ID_INVALID                   (0)
+
+
+/* Term ID table files */
+#define SRCH_TERMDICT_TERM_IDS_FILE_INDEX_ID            (0)         /* Term offsets into the data file, indexed by term ID */
+#define SRCH_TERMDICT_TERM_IDS_FILE_DATA_ID             (1)         /* Terms, NULL terminated, each followed by its term dictionary entry */
+
+#define SRCH_TERMDICT_TERM_IDS_FILE_VALID(n)            (((n) >= SRCH_TERMDICT_TERM_IDS_FILE_INDEX_ID) && \
+                                                                ((n) <= SRCH_TERMDICT_TERM_IDS_FILE_DATA_ID))
+
+
+/* Term grams, terms are indexed by the byte trigrams of their utf-8 form, 
+** trigrams containing bytes below this minimum are not indexed
+*/
+#define SRCH_TERMDICT_TERM_GRAM_LENGTH                  (3)
+#define SRCH_TERMDICT_TERM_GRAM_BYTE_MINIMUM            (33)        /* Ascii 33, excludes spaces and control characters */
+
+
+/* Phonetic keys, terms can be indexed by their soundex, metaphone and phonix keys, 
+** there is a phonetic key dictionary for each of these term matches
+*/
+#define SRCH_TERMDICT_PHONETIC_KEYS_TERM_MATCH_VALID(n) (((n) >= SRCH_TERMDICT_TERM_MATCH_SOUNDEX) && \
+                                                                ((n) <= SRCH_TERMDICT_TERM_MATCH_PHONIX))
+
+/* Phonetic key dictionary key length, phonetic keys are only a few characters long,
+** longer keys are not indexed
+*/
+#define SRCH_TERMDICT_PHONETIC_KEY_LENGTH_MAXIMUM       (255)
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -91,6 +130,29 @@ struct srchTermDictInfo {
 };
 
 
+/* Term filter - bloom filter of the terms in the term dictionary, tells us 
+** when a term is definitely not in the term dictionary
+*/
+struct srchTermDictFilter {
+    unsigned char   *pucBitmap;             /* Bitmap */
+    unsigned int    uiBitmapLength;         /* Bitmap length (bits) */
+    unsigned int    uiHashCount;            /* Number of hashes per term */
+};
+
+
+/* Term ID table - maps term IDs to the terms and their term dictionary 
+** entries, the term offsets have an entry for term ID 0 and an entry 
+** for the end of the data
+*/
+struct srchTermDictTermIDs {
+    unsigned long   *pulTermOffsets;        /* Term offsets into the data, indexed by term ID */
+    size_t          zTermOffsetsLength;     /* Term offsets mapping length */
+    unsigned char   *pucData;               /* Terms and term dictionary entries */
+    size_t          zDataLength;            /* Terms and term dictionary entries mapping length */
+    unsigned int    uiTermIDMaximum;        /* Maximum term ID */
+};
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -105,7 +167,13 @@ int iSrchTermDictAddTerm  (struct srchIndex *psiSrchIndex, unsigned char *pucTer
 
 int iSrchTermDictLookup (struct srchIndex *psiSrchIndex, unsigned char *pucTerm, 
         unsigned char *pucFieldIDBitmap, unsigned int uiFieldIDBitmapLength, unsigned int *puiTermType, 
-        unsigned int *puiTermCount, unsigned int *puiDocumentCount, unsigned long *pulIndexBlockID);
+        unsigned int *puiTermCount, unsigned int *puiDocumentCount, unsigned long *pulIndexBlockID,
+        unsigned int *puiTermID);
+
+int iSrchTermDictLookupTermID (struct srchIndex *psiSrchIndex, unsigned int uiTermID, 
+        unsigned char *pucFieldIDBitmap, unsigned int uiFieldIDBitmapLength, unsigned char **ppucTerm,
+        unsigned int *puiTermType, unsigned int *puiTermCount, unsigned int *puiDocumentCount, 
+        unsigned long *pulIndexBlockID);
 
 int iSrchTermDictLookupList (struct srchIndex *psiSrchIndex, unsigned int uiLanguageID, 
         unsigned char *pucTerm, unsigned char *pucFieldIDBitmap, unsigned int uiFieldIDBitmapLength, 
@@ -127,6 +195,39 @@ int iSrchTermDictLookupList (struct srchIndex *psiSrchIndex, unsigned int uiLang
 int iSrchTermDictFreeSearchTermDictInfo (struct srchTermDictInfo *pstdiSrchTermDictInfos, unsigned int uiSrchTermDictInfosLength);
 
 
+int iSrchTermDictCreateTermFilter (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictOpenTermFilter (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictCloseTermFilter (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictCheckTermFilter (struct srchIndex *psiSrchIndex, unsigned char *pucTerm, 
+        boolean *pbTermMayExist);
+
+
+int iSrchTermDictGetNextTermID (struct srchIndex *psiSrchIndex, unsigned int *puiTermID);
+
+int iSrchTermDictCreateTermIDs (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictOpenTermIDs (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictCloseTermIDs (struct srchIndex *psiSrchIndex);
+
+
+int iSrchTermDictCreateTermGrams (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictOpenTermGrams (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictCloseTermGrams (struct srchIndex *psiSrchIndex);
+
+
+int iSrchTermDictCreatePhoneticKeys (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictOpenPhoneticKeys (struct srchIndex *psiSrchIndex);
+
+int iSrchTermDictClosePhoneticKeys (struct srchIndex *psiSrchIndex);
+
+
 /*---------------------------------------------------------------------------*/
 
 
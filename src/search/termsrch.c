@@ -53,6 +53,112 @@
 /* Enable document ID range restrictions */
 /* #define SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS */
 
+/* Enable skipping to the start document ID, this uses the skip list to start 
+** decoding a postings list at the run which contains the start document ID 
+** rather than at the start of the index block, the documents before the start 
+** document ID in that run are still returned, this is on its own because it 
+** does not need the document ID range restrictions to be enabled
+*/
+#define SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Defines
+*/
+
+/* Macro to make sure there is an index entry decoded and ready to be read at puiIndexEntriesPtr, 
+** the index entries array is refilled from the index block in bulk when it has all been read,
+** term positions are only decoded if ppucMacroTermPositionsPtr is not NULL
+*/
+#define SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiMacroSrchIndex, pucMacroIndexBlockPtr, pucMacroIndexBlockEndPtr, ppucMacroTermPositionsPtr, puiMacroIndexEntries, puiMacroIndexEntriesPtr, puiMacroIndexEntriesEnd) \
+    {   \
+        if ( puiMacroIndexEntriesPtr >= puiMacroIndexEntriesEnd ) {  \
+            unsigned int uiMacroIndexEntriesLength = 0; \
+            iSrchTermSearchDecodeIndexEntries(psiMacroSrchIndex, &pucMacroIndexBlockPtr, pucMacroIndexBlockEndPtr, \
+                    ppucMacroTermPositionsPtr, puiMacroIndexEntries, &uiMacroIndexEntriesLength); \
+            ASSERT((uiMacroIndexEntriesLength % SRCH_TERMSRCH_INDEX_ENTRY_LENGTH) == 0); \
+            puiMacroIndexEntriesPtr = puiMacroIndexEntries; \
+            puiMacroIndexEntriesEnd = puiMacroIndexEntries + uiMacroIndexEntriesLength; \
+        }   \
+    }
+
+
+/* Place of the term position in a decoded index entry */
+#define SRCH_TERMSRCH_INDEX_ENTRY_TERM_POSITION         (1)
+
+
+/* Size of a bit width in a frame header of bit packed index block data */
+#define SRCH_TERMSRCH_FRAME_BIT_WIDTH_SIZE              (1)
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Structures
+*/
+
+/* Term search decoder structure, this holds the state needed to carry on decoding 
+** an index block into a search postings list, see iSrchTermSearchDecodeNextSrchPostings()
+*/
+struct srchTermSearchDecoder {
+    struct srchIndex    *psiSrchIndex;                  /* Index structure */
+    unsigned char       *pucIndexBlock;                 /* Index block */
+    unsigned int        uiIndexBlockLength;             /* Index block length, without the document containers */
+    unsigned int        uiIndexBlockHeaderLength;       /* Index block header length */
+    unsigned int        uiIndexBlockDataLength;         /* Index block data length */
+    unsigned char       *pucIndexBlockPtr;              /* Index block data pointer */
+    unsigned char       *pucIndexBlockEndPtr;           /* Index block data end */
+    unsigned char       *pucTermPositionsPtr;           /* Term positions pointer */
+    boolean             bDecodeTermPositions;           /* Set to true if the term positions are decoded with the index entries */
+    boolean             bLoadTermPositions;             /* Set to true if the term positions are left to be loaded, see iSrchPostingLoadTermPositions() */
+    unsigned int        puiIndexEntries[SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH];     /* Index entries */
+    unsigned int        *puiIndexEntriesPtr;            /* Index entries pointer */
+    unsigned int        *puiIndexEntriesEnd;            /* Index entries end */
+    unsigned int        uiIndexEntryDocumentID;         /* Document ID of the last index entry decoded */
+    unsigned int        uiIndexEntryTermPosition;       /* Term position of the last index entry decoded */
+    unsigned char       *pucImpacts;                    /* Impacts (optional) */
+    unsigned int        uiImpactsIndex;                 /* Impacts index */
+    float               fTermWeight;                    /* Term weight */
+    unsigned int        uiSrchPostingsCapacity;         /* Search postings array capacity */
+    unsigned int        uiSrchPostingBlocksIndex;       /* Index of the first search posting block which does not end before the search postings decoded */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Private function prototypes
+*/
+
+#if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) || defined(SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING)
+static int iSrchTermSearchSkipIndexBlock (struct srchIndex *psiSrchIndex, unsigned char *pucIndexBlock, 
+        unsigned int uiIndexBlockLength, unsigned int uiIndexBlockHeaderLength, unsigned int uiIndexBlockDataLength, 
+        unsigned int uiDocumentID, unsigned char **ppucIndexBlockPtr, unsigned char **ppucTermPositionsPtr, 
+        unsigned int *puiIndexEntryDocumentID);
+#endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) || defined(SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING) */
+
+static int iSrchTermSearchGetSrchPostingBlocksFromIndexBlock (struct srchIndex *psiSrchIndex, 
+        unsigned char *pucIndexBlock, unsigned int uiIndexBlockLength, unsigned int uiIndexBlockHeaderLength, 
+        unsigned int uiIndexBlockDataLength, float fTermWeight, struct srchPostingsList *psplSrchPostingsList);
+
+static int iSrchTermSearchReadIndexFrameHeader (struct srchIndex *psiSrchIndex, unsigned char **ppucIndexBlockPtr, 
+        unsigned int *puiFrameEntriesCount, unsigned int *puiFrameDeltaDocumentID, 
+        unsigned int *puiMaximumDocumentPostingsCount, unsigned int *puiBitWidths, unsigned int *puiFrameDataLength);
+
+static int iSrchTermSearchAddSparseWeight (struct srchWeight *pswSrchWeight, 
+        unsigned int *puiDocumentIDsCapacity, unsigned int uiDocumentID, float fWeight);
+
+static int iSrchTermSearchDecodeSrchPostingsFromDecoder (struct srchPostingsList *psplSrchPostingsList, 
+        unsigned int uiSrchPostingsMinimum);
+
+static void vSrchTermSearchSpreadImpacts (struct srchPosting *pspSrchPostings, 
+        unsigned int uiSrchPostingsLength);
+
 
 /*---------------------------------------------------------------------------*/
 
@@ -74,8 +180,21 @@
                 pucFieldIDBitmap                    field id bitmap to search (optional)
                 uiFieldIDBitmapLength               field id bitmap length (optional)
                 fFrequentTermCoverageThreshold      frequent term coverage threshold (0 indicates no threshold)
-                uiStartDocumentID                   start document ID restriction (0 for no restriction)
+                uiStartDocumentID                   start document ID restriction (0 for no restriction), decoding 
+                                                    skips ahead to the run which contains it
                 uiEndDocumentID                     end document ID restriction (0 for no restriction)
+                bTermPositions                      set to true if the term positions are needed, they 
+                                                    may be left as 0 otherwise, they are left to be loaded 
+                                                    with iSrchPostingLoadTermPositions() where they can be
+                bDocumentContainers                 set to true if the document containers can be returned 
+                                                    instead of the postings, the postings list will then
+                                                    carry the document IDs and the term weight but no postings,
+                                                    this only applies to unfielded searches and the document 
+                                                    ID restrictions are not applied
+                bDecodeOnDemand                     set to true if the search postings can be decoded on demand, 
+                                                    the postings list will then only hold the first search postings 
+                                                    and carry a decoder for the rest, see iSrchTermSearchDecodeNextSrchPostings(), 
+                                                    this only applies to unfielded searches
                 ppsplSrchPostingsList               return pointer for the search postings list structure (allocated)
 
     Globals:    none
@@ -94,6 +213,9 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
     float fFrequentTermCoverageThreshold,
     unsigned int uiStartDocumentID,
     unsigned int uiEndDocumentID,
+    boolean bTermPositions,
+    boolean bDocumentContainers,
+    boolean bDecodeOnDemand,
     struct srchPostingsList **ppsplSrchPostingsList
 )
 {
@@ -101,10 +223,17 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
     int                         iError = UTL_NoError;
 
     unsigned long               ulIndexBlockID = 0;
+    unsigned int                uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
     unsigned char               *pucIndexBlock = NULL;
     unsigned int                uiIndexBlockLength = 0;
     unsigned int                uiIndexBlockHeaderLength = 0;
     unsigned int                uiIndexBlockDataLength = 0;
+    unsigned int                uiDocumentContainersLength = 0;
+    unsigned char               *pucImpacts = NULL;
+    unsigned int                uiImpactsLength = 0;
+    float                       fImpactsScale = 0;
+
+    boolean                     bFrequentTerm = false;
 
     float                       fTermWeight = 0;
     
@@ -163,6 +292,20 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 /* printf("pucTerm: '%s'\n", pucTerm); */
 /* printf("pucTerm: '%s', uiStartDocumentID: %u, uiEndDocumentID: %u\n", pucTerm, uiStartDocumentID, uiEndDocumentID); */
 
+    /* Only use the document containers on unfielded searches of indices which have them */
+    if ( (pucFieldIDBitmap != NULL) || !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS) ) {
+        bDocumentContainers = false;
+    }
+
+    /* Only decode the search postings on demand on unfielded searches, the document ID range restrictions are not applied on demand */
+#if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS)
+    bDecodeOnDemand = false;
+#endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
+    if ( pucFieldIDBitmap != NULL ) {
+        bDecodeOnDemand = false;
+    }
+
+
     /* Look up the term in the term dict, process any errors */
     {
         unsigned int    uiTermCount = SPI_TERM_COUNT_UNKNOWN;
@@ -179,7 +322,7 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 
         /* Look up the term */
         iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, pucFieldIDBitmap, uiFieldIDBitmapLength, 
-                &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID);
+                &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID);
 
         /* Return an empty postings list if the term does not exist or does not occur
         ** (subject to constraints, like field ID), otherwise return an error if
@@ -227,16 +370,24 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 /*             iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: '%s', uiTermCount: %u, uiDocumentCount: %u, psiSrchIndex->uiDocumentCount: %u, fTermCoverage: %9.4f%%.",  */
 /*                     pucTerm, uiTermCount, uiDocumentCount, psiSrchIndex->uiDocumentCount, fTermCoverage); */
         
-            /* Flag this term as frequent if its coverage is greater than the threshold */
+            /* Flag this term as frequent if its coverage is greater than the threshold, unless
+            ** we can use the document containers in which case we check the index block first
+            */
             if ( fTermCoverage > fFrequentTermCoverageThreshold ) {
 
-                /* Populate the search postings list structure */
-                psplSrchPostingsList->uiTermType = SPI_TERM_TYPE_FREQUENT;
-                psplSrchPostingsList->uiTermCount = uiTermCount;
-                psplSrchPostingsList->uiDocumentCount = uiDocumentCount;
+                if ( bDocumentContainers == true ) {
+                    bFrequentTerm = true;
+                }
+                else {
 
-                iError = SRCH_NoError;
-                goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+                    /* Populate the search postings list structure */
+                    psplSrchPostingsList->uiTermType = SPI_TERM_TYPE_FREQUENT;
+                    psplSrchPostingsList->uiTermCount = uiTermCount;
+                    psplSrchPostingsList->uiDocumentCount = uiDocumentCount;
+    
+                    iError = SRCH_NoError;
+                    goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+                }
             }
         }
 
@@ -253,8 +404,6 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 
     /* Get the index block for this term, processing any errors */
     {
-        unsigned char   *pucIndexBlockPtr = NULL;
-
         /* Get the index block data */
         if ( (iError = iUtlDataGetEntry(psiSrchIndex->pvUtlIndexData, ulIndexBlockID, (void **)&pucIndexBlock, &uiIndexBlockLength)) != UTL_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to get index data, index object ID: %lu, index: '%s', utl error: %d.", 
@@ -263,13 +412,22 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
             goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
         }
     
-        /* Set the pointer to start reading from */
-        pucIndexBlockPtr = pucIndexBlock;
-    
         /* Get the size of the index block */
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexBlockDataLength, pucIndexBlockPtr);
-        uiIndexBlockHeaderLength = pucIndexBlockPtr - pucIndexBlock;
+        if ( (iError = iSrchTermSearchGetIndexBlockHeader(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, &uiIndexBlockHeaderLength, 
+                &uiIndexBlockDataLength, &uiDocumentContainersLength, &pucImpacts, &uiImpactsLength, &fImpactsScale)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+        }
+
+        /* Leave the document containers off the index block, the skip list is at the end of what is left */
+        uiIndexBlockLength -= uiDocumentContainersLength;
     
+        /* Flag frequent terms which dont have document containers */
+        if ( (bFrequentTerm == true) && (uiDocumentContainersLength == 0) ) {
+            psplSrchPostingsList->uiTermType = SPI_TERM_TYPE_FREQUENT;
+            iError = SRCH_NoError;
+            goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+        }
+
         /* Empty block - probably a stop term */
         if ( uiIndexBlockDataLength == 0 ) {
             
@@ -286,8 +444,15 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 
     /* Get the term weight */
     {
+        /* Scaled term weight if there are impacts, the IDF factor is already in the impacts */
+        if ( pucImpacts != NULL ) {
+            fTermWeight = fImpactsScale * fWeight;
+        }
+
         /* IDF term weight */
-        fTermWeight = SRCH_SEARCH_IDF_FACTOR(psplSrchPostingsList->uiTermCount, psplSrchPostingsList->uiDocumentCount, psiSrchIndex->uiDocumentCount) * fWeight;
+        else {
+            fTermWeight = SRCH_SEARCH_IDF_FACTOR(psplSrchPostingsList->uiTermCount, psplSrchPostingsList->uiDocumentCount, psiSrchIndex->uiDocumentCount) * fWeight;
+        }
 
         /* Set the term weight to the default if it went pear-shaped */
         if ( fTermWeight <= 0 ) {
@@ -299,6 +464,39 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 
 
 
+    /* Return the document containers rather than the postings if we can, the term
+    ** weight is carried along since there are no postings to carry it
+    */
+    if ( (bDocumentContainers == true) && (uiDocumentContainersLength > 0) ) {
+
+        if ( (iError = iUtlRoaringDeserialize(pucIndexBlock + uiIndexBlockLength, uiDocumentContainersLength, &psplSrchPostingsList->pvUtlRoaring)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to deserialize the document containers, index object ID: %lu, index: '%s', utl error: %d.", 
+                    ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+            iError = SRCH_TermSearchDocumentContainersFailed;
+            goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+        }
+
+        psplSrchPostingsList->fDocumentContainersWeight = fTermWeight;
+
+        /* The documents all get the mean impact if there are impacts, since we dont know which is which */
+        if ( pucImpacts != NULL ) {
+
+            unsigned int    uiI = 0;
+            unsigned long   ulImpactsTotal = 0;
+
+            for ( uiI = 0; uiI < uiImpactsLength; uiI++ ) {
+                ulImpactsTotal += pucImpacts[uiI];
+            }
+
+            psplSrchPostingsList->fDocumentContainersWeight = fTermWeight * ((float)ulImpactsTotal / uiImpactsLength);
+        }
+
+        iError = SRCH_NoError;
+        goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+    }
+
+
+
     /* Set the field ID if we can, this allows us to use an optimization further down, 
     ** mmm, optimizations, we like optimizations
     */
@@ -340,12 +538,64 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 
 
 
+    /* Set up the decoder and decode the first search postings if they are to be decoded on demand */
+    if ( bDecodeOnDemand == true ) {
+
+        struct srchTermSearchDecoder    *pstdSrchTermSearchDecoder = NULL;
+
+
+        /* Allocate the decoder, handing it over to the postings list right away so that it gets released with it */
+        if ( (pstdSrchTermSearchDecoder = (struct srchTermSearchDecoder *)s_malloc((size_t)sizeof(struct srchTermSearchDecoder))) == NULL ) {
+            iError = SRCH_MemError;
+            goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+        }
+        psplSrchPostingsList->pvSrchTermSearchDecoder = (void *)pstdSrchTermSearchDecoder;
+
+        /* Set up the decoder */
+        pstdSrchTermSearchDecoder->psiSrchIndex = psiSrchIndex;
+        pstdSrchTermSearchDecoder->pucIndexBlock = pucIndexBlock;
+        pstdSrchTermSearchDecoder->uiIndexBlockLength = uiIndexBlockLength;
+        pstdSrchTermSearchDecoder->uiIndexBlockHeaderLength = uiIndexBlockHeaderLength;
+        pstdSrchTermSearchDecoder->uiIndexBlockDataLength = uiIndexBlockDataLength;
+        pstdSrchTermSearchDecoder->puiIndexEntriesPtr = pstdSrchTermSearchDecoder->puiIndexEntries;
+        pstdSrchTermSearchDecoder->puiIndexEntriesEnd = pstdSrchTermSearchDecoder->puiIndexEntries;
+        pstdSrchTermSearchDecoder->pucImpacts = pucImpacts;
+        pstdSrchTermSearchDecoder->fTermWeight = fTermWeight;
+
+        /* Set the start and end pointers and the term positions pointer */
+        if ( (iError = iSrchTermSearchGetIndexBlockStreams(psiSrchIndex, pucIndexBlock + uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+                &pstdSrchTermSearchDecoder->pucIndexBlockPtr, &pstdSrchTermSearchDecoder->pucIndexBlockEndPtr, &pstdSrchTermSearchDecoder->pucTermPositionsPtr)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+        }
+
+        /* Only decode the term positions if they were requested, leaving them to be loaded later if they are in their own stream */
+        pstdSrchTermSearchDecoder->bDecodeTermPositions = bTermPositions;
+        if ( (bTermPositions == true) && (pstdSrchTermSearchDecoder->pucTermPositionsPtr != NULL) ) {
+            pstdSrchTermSearchDecoder->bDecodeTermPositions = false;
+            pstdSrchTermSearchDecoder->bLoadTermPositions = true;
+            psplSrchPostingsList->pucTermPositions = pstdSrchTermSearchDecoder->pucTermPositionsPtr;
+            psplSrchPostingsList->uiTermPositionsIndex = 0;
+        }
+
+        /* Decode the first search postings, skipping ahead to the start document ID if we can */
+        if ( (iError = iSrchTermSearchDecodeNextSrchPostings(psplSrchPostingsList, uiStartDocumentID)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+        }
+    }
+
     /* Loop over the index block, decoding it and populating the postings array */
-    {
+    else {
         struct srchPosting      *pspSrchPostingsPtr = NULL;
 
         unsigned char           *pucIndexBlockPtr = NULL;
+        unsigned char           *pucIndexBlockStartPtr = NULL;
         unsigned char           *pucIndexBlockEndPtr = NULL;
+        unsigned char           *pucTermPositionsPtr = NULL;
+        unsigned char           **ppucTermPositionsPtr = NULL;
+
+        unsigned int            puiIndexEntries[SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH];
+        unsigned int            *puiIndexEntriesPtr = NULL;
+        unsigned int            *puiIndexEntriesEnd = NULL;
 
         unsigned int            uiIndexEntryDocumentID = 0;
         unsigned int            uiIndexEntryDeltaDocumentID = 0;
@@ -355,6 +605,7 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 /*         unsigned int            uiIndexEntryTermWeight = 0; */
         
         unsigned int            uiDocumentCount = 0;
+        unsigned int            uiImpactsIndex = 0;
 
 
         /* Set the postings length, initially need as many as there are terms */
@@ -367,18 +618,50 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
         }
 
 
+        /* Set the start and end pointers and the term positions pointer, skipping ahead to the start document ID if we can */
+        if ( (iError = iSrchTermSearchGetIndexBlockStreams(psiSrchIndex, pucIndexBlock + uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+                &pucIndexBlockStartPtr, &pucIndexBlockEndPtr, &pucTermPositionsPtr)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+        }
+#if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) || defined(SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING)
+        /* Impacts are matched to documents by counting them, so we cant skip ahead if there are impacts */
+        if ( (uiStartDocumentID > 0) && (pucImpacts == NULL) ) {
+            if ( (iError = iSrchTermSearchSkipIndexBlock(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+                    uiStartDocumentID, &pucIndexBlockStartPtr, &pucTermPositionsPtr, &uiIndexEntryDocumentID)) != SRCH_NoError ) {
+                goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+            }
+        }
+#endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) || defined(SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING) */
+
+        /* Only decode the term positions if they were requested */
+        ppucTermPositionsPtr = (bTermPositions == true) ? &pucTermPositionsPtr : NULL;
+
+#if !defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS)
+        /* Leave the term positions to be loaded later if they are in their own stream and if this is not a fielded 
+        ** search, every index entry becomes a search posting so iSrchPostingLoadTermPositions() can match them up
+        */
+        if ( (ppucTermPositionsPtr != NULL) && (pucTermPositionsPtr != NULL) && (uiFieldID == 0) && (pucFieldIDBitmap == NULL) ) {
+            psplSrchPostingsList->pucTermPositions = pucTermPositionsPtr;
+            psplSrchPostingsList->uiTermPositionsIndex = 0;
+            ppucTermPositionsPtr = NULL;
+        }
+#endif    /* !defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
+
+
         /* uiFieldID > 0 means that this is a fielded search and that there is only one field to match */
         if ( uiFieldID > 0 ) {
 
             /* Loop over all the entries in the index block */
-            for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength,
-                    pucIndexBlockEndPtr = (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength); pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pucIndexBlockPtr = pucIndexBlockStartPtr;
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
         
 /* Compressed int */
                 /* Read the index block */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaTermPosition, pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, ppucTermPositionsPtr, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                uiIndexEntryDeltaTermPosition = puiIndexEntriesPtr[1];
+                uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -395,6 +678,11 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
                 /* Set the document ID */
                 uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
 
+                /* Move on to the impact of this document if this is a new document */
+                if ( uiIndexEntryDeltaDocumentID != 0 ) {
+                    uiImpactsIndex++;
+                }
+
                 /* Skip this document if this is not the field we are searching on */
                 if ( uiIndexEntryFieldID != uiFieldID ) {
                     continue;
@@ -428,7 +716,7 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
                 /* Set the posting information */
                 pspSrchPostingsPtr->uiDocumentID = uiIndexEntryDocumentID;
                 pspSrchPostingsPtr->uiTermPosition = uiIndexEntryTermPosition;
-                pspSrchPostingsPtr->fWeight = fTermWeight;
+                pspSrchPostingsPtr->fWeight = (pucImpacts != NULL) ? pucImpacts[uiImpactsIndex - 1] * fTermWeight : fTermWeight;
 
 /*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: [%s], pspSrchPostingsPtr->uiDocumentID: %u, uiIndexEntryFieldID: %u, pspSrchPostingsPtr->uiTermPosition: %u, pspSrchPostingsPtr->fWeight: %f",  */
 /*                         pucTerm, pspSrchPostingsPtr->uiDocumentID, uiIndexEntryFieldID, pspSrchPostingsPtr->uiTermPosition, pspSrchPostingsPtr->fWeight); */
@@ -442,14 +730,16 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
         else if ( pucFieldIDBitmap != NULL ) {
 
             /* Loop over all the entries in the index block */
-            for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength,
-                    pucIndexBlockEndPtr = (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength); pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pucIndexBlockPtr = pucIndexBlockStartPtr;
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
         
 /* Compressed int */
                 /* Read the index block */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaTermPosition, pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, ppucTermPositionsPtr, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                uiIndexEntryDeltaTermPosition = puiIndexEntriesPtr[1];
+                uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -464,6 +754,11 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 
                 /* Set the document ID */
                 uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
+
+                /* Move on to the impact of this document if this is a new document */
+                if ( uiIndexEntryDeltaDocumentID != 0 ) {
+                    uiImpactsIndex++;
+                }
         
                 /* Skip this document if this is not the field we are searching on - field ID 0 is not a field */
                 if ( !UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucFieldIDBitmap, uiIndexEntryFieldID - 1) ) {
@@ -498,7 +793,7 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
                 /* Set the posting information */
                 pspSrchPostingsPtr->uiDocumentID = uiIndexEntryDocumentID;
                 pspSrchPostingsPtr->uiTermPosition = uiIndexEntryTermPosition;
-                pspSrchPostingsPtr->fWeight = fTermWeight;
+                pspSrchPostingsPtr->fWeight = (pucImpacts != NULL) ? pucImpacts[uiImpactsIndex - 1] * fTermWeight : fTermWeight;
                 
 /*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: [%s], pspSrchPostingsPtr->uiDocumentID: %u, uiIndexEntryFieldID: %u, pspSrchPostingsPtr->uiTermPosition: %u, pspSrchPostingsPtr->fWeight: %f",  */
 /*                         pucTerm, pspSrchPostingsPtr->uiDocumentID, uiIndexEntryFieldID, pspSrchPostingsPtr->uiTermPosition, pspSrchPostingsPtr->fWeight); */
@@ -512,14 +807,16 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
         else {
 
             /* Loop over all the entries in the index block */
-            for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength,
-                    pucIndexBlockEndPtr = (pucIndexBlock + uiIndexBlockDataLength + uiIndexBlockHeaderLength); pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings, pucIndexBlockPtr = pucIndexBlockStartPtr;
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
         
 /* Compressed int */
                 /* Read the index block */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaTermPosition, pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, ppucTermPositionsPtr, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                uiIndexEntryDeltaTermPosition = puiIndexEntriesPtr[1];
+                uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -536,6 +833,11 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
                 /* Set the document ID */
                 uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
 
+                /* Move on to the impact of this document if this is a new document */
+                if ( uiIndexEntryDeltaDocumentID != 0 ) {
+                    uiImpactsIndex++;
+                }
+
 #if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS)
                 /* Skip this document if we are not yet in range */
                 if ( uiIndexEntryDocumentID < uiStartDocumentID ) {
@@ -566,7 +868,7 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
                 /* Set the posting information */
                 pspSrchPostingsPtr->uiDocumentID = uiIndexEntryDocumentID;
                 pspSrchPostingsPtr->uiTermPosition = uiIndexEntryTermPosition;
-                pspSrchPostingsPtr->fWeight = fTermWeight;
+                pspSrchPostingsPtr->fWeight = (pucImpacts != NULL) ? pucImpacts[uiImpactsIndex - 1] * fTermWeight : fTermWeight;
 
 /*                 iUtlLogInfo(UTL_LOG_CONTEXT, "pucTerm: [%s], pspSrchPostingsPtr->uiDocumentID: %u, pspSrchPostingsPtr->uiTermPosition: %u, pspSrchPostingsPtr->fWeight: %f",  */
 /*                         pucTerm, pspSrchPostingsPtr->uiDocumentID, pspSrchPostingsPtr->uiTermPosition, pspSrchPostingsPtr->fWeight); */
@@ -587,6 +889,11 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
         psplSrchPostingsList->uiTermCount = pspSrchPostingsPtr - psplSrchPostingsList->pspSrchPostings;
         psplSrchPostingsList->uiDocumentCount = uiDocumentCount;
 
+        /* Spread the impact of each document over its postings so that they add back up to the impact */
+        if ( pucImpacts != NULL ) {
+            vSrchTermSearchSpreadImpacts(psplSrchPostingsList->pspSrchPostings, psplSrchPostingsList->uiTermCount);
+        }
+
     }
 
 
@@ -597,6 +904,7 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
         /* Free the search postings */
         s_free(psplSrchPostingsList->pspSrchPostings);
         psplSrchPostingsList->uiSrchPostingsLength = 0;
+        psplSrchPostingsList->pucTermPositions = NULL;
     }
     else if ( psplSrchPostingsList->uiTermCount < psplSrchPostingsList->uiSrchPostingsLength ) {
         
@@ -612,6 +920,18 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
         psplSrchPostingsList->pspSrchPostings = pspSrchPostingsPtr;
         psplSrchPostingsList->uiSrchPostingsLength = psplSrchPostingsList->uiTermCount;
     }
+
+
+
+    /* Get the search posting blocks from the skip list, the maximums stay valid 
+    ** upper bounds even if postings were dropped by field or document ID restrictions
+    */
+    if ( psplSrchPostingsList->uiSrchPostingsLength > 0 ) {
+        if ( (iError = iSrchTermSearchGetSrchPostingBlocksFromIndexBlock(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, uiIndexBlockHeaderLength, 
+                uiIndexBlockDataLength, fTermWeight, psplSrchPostingsList)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchPostingsListFromTerm;
+        }
+    }
     
 /* if ( psplSrchPostingsList->pspSrchPostings != NULL ) { */
 /*     printf("uiDocumentID: %u - %u, term count: %u, document count: %u\n",  */
@@ -651,6 +971,222 @@ int iSrchTermSearchGetSearchPostingsListFromTerm
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchTermSearchDecodeNextSrchPostings()
+
+    Purpose:    This function replaces the search postings of a search postings list 
+                whose search postings are decoded on demand with the next ones, about 
+                SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH search postings are decoded at a
+                time and they always end with the last search posting of a document.
+
+                Decoding skips ahead to the run which contains the document ID 
+                if it can, the search postings of that run before the document ID 
+                are still decoded. 
+
+                The decoder is released once the index block has all been decoded,
+                the search postings list then holds the last search postings.
+
+    Parameters: psplSrchPostingsList    search postings list structure
+                uiDocumentID            document ID to skip ahead to (0 for no skipping)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermSearchDecodeNextSrchPostings
+(
+    struct srchPostingsList *psplSrchPostingsList,
+    unsigned int uiDocumentID
+)
+{
+
+    int                             iError = SRCH_NoError;
+    struct srchTermSearchDecoder    *pstdSrchTermSearchDecoder = NULL;
+
+
+    /* Check the parameters */
+    if ( psplSrchPostingsList == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psplSrchPostingsList' parameter passed to 'iSrchTermSearchDecodeNextSrchPostings'."); 
+        return (SRCH_PostingInvalidPostingsList);
+    }
+
+    if ( uiDocumentID < 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiDocumentID' parameter passed to 'iSrchTermSearchDecodeNextSrchPostings'."); 
+        return (SRCH_TermSearchInvalidDocumentID);
+    }
+
+
+    /* Nothing to do if the search postings have all been decoded */
+    if ( (pstdSrchTermSearchDecoder = (struct srchTermSearchDecoder *)psplSrchPostingsList->pvSrchTermSearchDecoder) == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Move the term positions along past the search postings which are being replaced */
+    if ( psplSrchPostingsList->pucTermPositions != NULL ) {
+
+        ASSERT(psplSrchPostingsList->uiTermPositionsIndex <= psplSrchPostingsList->uiSrchPostingsLength);
+
+        for ( ; psplSrchPostingsList->uiTermPositionsIndex < psplSrchPostingsList->uiSrchPostingsLength; psplSrchPostingsList->uiTermPositionsIndex++ ) {
+            UTL_NUM_SKIP_COMPRESSED_UINT(psplSrchPostingsList->pucTermPositions);
+        }
+    }
+
+    /* Replace the search postings */
+    psplSrchPostingsList->uiSrchPostingsLength = 0;
+    psplSrchPostingsList->uiTermPositionsIndex = 0;
+
+
+#if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) || defined(SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING)
+    /* Move along the search posting blocks, they end where the runs end, so the skip list 
+    ** does not need to be read if no run ends between what has been decoded and the document ID
+    */
+    if ( psplSrchPostingsList->pspbSrchPostingBlocks != NULL ) {
+        while ( (pstdSrchTermSearchDecoder->uiSrchPostingBlocksIndex < psplSrchPostingsList->uiSrchPostingBlocksLength) && 
+                (psplSrchPostingsList->pspbSrchPostingBlocks[pstdSrchTermSearchDecoder->uiSrchPostingBlocksIndex].uiDocumentID < pstdSrchTermSearchDecoder->uiIndexEntryDocumentID) ) {
+            pstdSrchTermSearchDecoder->uiSrchPostingBlocksIndex++;
+        }
+    }
+
+    /* Skip ahead to the document ID if the run which contains it is beyond what has been decoded, 
+    ** impacts are matched to documents by counting them, so we cant skip ahead if there are impacts 
+    */
+    if ( (uiDocumentID > 0) && (pstdSrchTermSearchDecoder->pucImpacts == NULL) && 
+            ((psplSrchPostingsList->pspbSrchPostingBlocks == NULL) || 
+            ((pstdSrchTermSearchDecoder->uiSrchPostingBlocksIndex < psplSrchPostingsList->uiSrchPostingBlocksLength) && 
+            (psplSrchPostingsList->pspbSrchPostingBlocks[pstdSrchTermSearchDecoder->uiSrchPostingBlocksIndex].uiDocumentID < uiDocumentID))) ) {
+
+        unsigned char   *pucIndexBlockPtr = NULL;
+        unsigned char   *pucTermPositionsPtr = NULL;
+        unsigned int    uiIndexEntryDocumentID = 0;
+
+        if ( (iError = iSrchTermSearchSkipIndexBlock(pstdSrchTermSearchDecoder->psiSrchIndex, pstdSrchTermSearchDecoder->pucIndexBlock, 
+                pstdSrchTermSearchDecoder->uiIndexBlockLength, pstdSrchTermSearchDecoder->uiIndexBlockHeaderLength, pstdSrchTermSearchDecoder->uiIndexBlockDataLength, 
+                uiDocumentID, &pucIndexBlockPtr, &pucTermPositionsPtr, &uiIndexEntryDocumentID)) != SRCH_NoError ) {
+            return (iError);
+        }
+
+        /* Drop the index entries which have been decoded but not read, they all come before the run */
+        if ( pucIndexBlockPtr > pstdSrchTermSearchDecoder->pucIndexBlockPtr ) {
+            pstdSrchTermSearchDecoder->pucIndexBlockPtr = pucIndexBlockPtr;
+            pstdSrchTermSearchDecoder->pucTermPositionsPtr = pucTermPositionsPtr;
+            pstdSrchTermSearchDecoder->puiIndexEntriesPtr = pstdSrchTermSearchDecoder->puiIndexEntries;
+            pstdSrchTermSearchDecoder->puiIndexEntriesEnd = pstdSrchTermSearchDecoder->puiIndexEntries;
+            pstdSrchTermSearchDecoder->uiIndexEntryDocumentID = uiIndexEntryDocumentID;
+
+            if ( pstdSrchTermSearchDecoder->bLoadTermPositions == true ) {
+                psplSrchPostingsList->pucTermPositions = pucTermPositionsPtr;
+            }
+        }
+    }
+#endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) || defined(SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING) */
+
+
+    /* Decode the next search postings */
+    if ( (iError = iSrchTermSearchDecodeSrchPostingsFromDecoder(psplSrchPostingsList, SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermSearchDecodeSrchPostings()
+
+    Purpose:    This function decodes all the search postings which have not been 
+                decoded yet in a search postings list whose search postings are 
+                decoded on demand, they are added after the search postings it
+                already holds and the decoder is released.
+
+    Parameters: psplSrchPostingsList    search postings list structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermSearchDecodeSrchPostings
+(
+    struct srchPostingsList *psplSrchPostingsList
+)
+{
+
+    int     iError = SRCH_NoError;
+
+
+    /* Check the parameters */
+    if ( psplSrchPostingsList == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psplSrchPostingsList' parameter passed to 'iSrchTermSearchDecodeSrchPostings'."); 
+        return (SRCH_PostingInvalidPostingsList);
+    }
+
+
+    /* Nothing to do if the search postings have all been decoded */
+    if ( psplSrchPostingsList->pvSrchTermSearchDecoder == NULL ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* Decode the rest of the search postings */
+    if ( (iError = iSrchTermSearchDecodeSrchPostingsFromDecoder(psplSrchPostingsList, UINT_MAX)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    ASSERT(psplSrchPostingsList->pvSrchTermSearchDecoder == NULL);
+
+    /* Set the term count, the search postings list now holds all its search postings */
+    psplSrchPostingsList->uiTermCount = psplSrchPostingsList->uiSrchPostingsLength;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermSearchFreeDecoder()
+
+    Purpose:    This function frees the decoder of a search postings list whose
+                search postings are decoded on demand.
+
+    Parameters: pvSrchTermSearchDecoder     term search decoder (optional)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermSearchFreeDecoder
+(
+    void *pvSrchTermSearchDecoder
+)
+{
+
+    /* Free the decoder */
+    s_free(pvSrchTermSearchDecoder);
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchTermSearchGetSearchWeightsFromTerm()
@@ -695,14 +1231,21 @@ int iSrchTermSearchGetSearchWeightsFromTerm
     float               fAdjustedWeight = 0;
 
     unsigned long       ulIndexBlockID = 0;
+    unsigned int        uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
     unsigned char       *pucIndexBlock = NULL;
     unsigned int        uiIndexBlockLength = 0;
     unsigned int        uiIndexBlockHeaderLength = 0;
     unsigned int        uiIndexBlockDataLength = 0;
+    unsigned char       *pucImpacts = NULL;
+    unsigned int        uiImpactsLength = 0;
+    float               fImpactsScale = 0;
     
     unsigned int        uiFieldID = 0;
 
     struct srchWeight   *pswSrchWeight = NULL;
+    struct srchWeight   *pswSrchWeightTerm = NULL;
+    unsigned int        uiDocumentIDsCapacity = 0;
+    unsigned int        uiTermDocumentCount = SPI_TERM_DOCUMENT_COUNT_UNKNOWN;
 
 
     /* Check the parameters */
@@ -764,7 +1307,7 @@ int iSrchTermSearchGetSearchWeightsFromTerm
 
         /* Look up the term */
         iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, pucFieldIDBitmap, uiFieldIDBitmapLength, 
-                &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID);
+                &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID);
     
         /* Skip setting the weights if the term does not exist or does not occur
         ** (subject to constraints, like field ID), otherwise return an error if
@@ -808,6 +1351,9 @@ int iSrchTermSearchGetSearchWeightsFromTerm
         /* IDF adjusted weight */
         fAdjustedWeight = SRCH_SEARCH_IDF_FACTOR(uiTermCount, uiDocumentCount, psiSrchIndex->uiDocumentCount) * fWeight;
 
+        /* Keep the document count, it tells us how many documents can be weighted */
+        uiTermDocumentCount = uiDocumentCount;
+
 /*         iUtlLogDebug(UTL_LOG_CONTEXT, "fAdjustedWeight [%f].", fAdjustedWeight);  */
     }
 
@@ -815,7 +1361,7 @@ int iSrchTermSearchGetSearchWeightsFromTerm
 
     /* Get the index block for this term, processing any errors */
     {
-        unsigned char   *pucIndexBlockPtr = NULL;
+        unsigned int    uiDocumentContainersLength = 0;
 
         /* Get the index block data */
         if ( (iError = iUtlDataGetEntry(psiSrchIndex->pvUtlIndexData, ulIndexBlockID, (void **)&pucIndexBlock, &uiIndexBlockLength)) != UTL_NoError ) {
@@ -825,18 +1371,25 @@ int iSrchTermSearchGetSearchWeightsFromTerm
             goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
         }
     
-        /* Set the pointer to start reading from */
-        pucIndexBlockPtr = pucIndexBlock;
-    
         /* Get the size of the index block */
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexBlockDataLength, pucIndexBlockPtr);
-        uiIndexBlockHeaderLength = pucIndexBlockPtr - pucIndexBlock;
+        if ( (iError = iSrchTermSearchGetIndexBlockHeader(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, &uiIndexBlockHeaderLength, 
+                &uiIndexBlockDataLength, &uiDocumentContainersLength, &pucImpacts, &uiImpactsLength, &fImpactsScale)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+        }
+
+        /* Leave the document containers off the index block, they are not used here */
+        uiIndexBlockLength -= uiDocumentContainersLength;
 
         /* Empty block - probably a stop term */
         if ( uiIndexBlockDataLength == 0 ) {
             iError = SRCH_NoError;
             goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
         }
+
+        /* Scaled weight if there are impacts, the IDF factor is already in the impacts */
+        if ( pucImpacts != NULL ) {
+            fAdjustedWeight = fImpactsScale * fWeight;
+        }
     }
 
 
@@ -860,6 +1413,34 @@ int iSrchTermSearchGetSearchWeightsFromTerm
         /* Adjust the length */
         pswSrchWeight->uiWeightsLength = psiSrchIndex->uiDocumentCount + 1;
     }
+
+
+    /* Collect the weights for this term in a sparse search weight structure if the passed 
+    ** search weight structure is sparse, or if none was passed and the term occurs in few 
+    ** enough documents, they get merged in once we are done. Otherwise we cumulate the
+    ** weights straight into the weights array, expanding the passed search weight structure
+    ** if it is sparse
+    */
+    if ( (uiTermDocumentCount != SPI_TERM_DOCUMENT_COUNT_UNKNOWN) && 
+            (((pswSrchWeight == NULL) && (uiTermDocumentCount <= SRCH_WEIGHT_SPARSE_LENGTH_MAXIMUM(psiSrchIndex->uiDocumentCount + 1))) ||
+            ((pswSrchWeight != NULL) && (pswSrchWeight->bSparseFlag == true))) ) {
+
+        /* Allocate a new sparse search weights structure */
+        if ( (iError = iSrchWeightCreateSparse(psiSrchIndex->uiDocumentCount + 1, uiTermDocumentCount, &pswSrchWeightTerm)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a new search weight, srch error: %d.", iError);
+            goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+        }
+        
+        uiDocumentIDsCapacity = UTL_MACROS_MAX(uiTermDocumentCount, 1);
+    }
+    else if ( pswSrchWeight != NULL ) {
+
+        /* Expand the search weights structure */
+        if ( (iError = iSrchWeightExpandSparse(pswSrchWeight)) != SRCH_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to expand the search weight, srch error: %d.", iError);
+            goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+        }
+    }
     else {
         
         /* Allocate a new search weights structure */
@@ -914,33 +1495,60 @@ int iSrchTermSearchGetSearchWeightsFromTerm
     /* Loop over the index block, decoding it and populating the postings array */
     {
         unsigned char   *pucIndexBlockPtr = NULL;
+        unsigned char   *pucIndexBlockStartPtr = NULL;
         unsigned char   *pucIndexBlockEndPtr = NULL;
 
+        unsigned int    puiIndexEntries[SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH];
+        unsigned int    *puiIndexEntriesPtr = NULL;
+        unsigned int    *puiIndexEntriesEnd = NULL;
+
         unsigned int    uiIndexEntryDocumentID = 0;
         unsigned int    uiIndexEntryDeltaDocumentID = 0;
 /*         unsigned int    uiIndexEntryDeltaTermPosition = 0; */
         unsigned int    uiIndexEntryFieldID = 0;
 /*         unsigned int    uiIndexEntryTermWeight = 0; */
+
+        unsigned int    uiImpactsIndex = 0;
+        float           fEntryWeight = fAdjustedWeight;
             
         float           *pfWeights = NULL;
 
 
-        /* Dereference the weights array */
-        pfWeights = pswSrchWeight->pfWeights;
+        /* Dereference the weights array, we only use it if we are not collecting sparse weights */
+        if ( pswSrchWeightTerm == NULL ) {
+            pfWeights = pswSrchWeight->pfWeights;
+        }
+
+
+        /* Set the start and end pointers, skipping ahead to the start document ID if we can, we dont need the term positions */
+        if ( (iError = iSrchTermSearchGetIndexBlockStreams(psiSrchIndex, pucIndexBlock + uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+                &pucIndexBlockStartPtr, &pucIndexBlockEndPtr, NULL)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+        }
+#if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS)
+        /* Impacts are matched to documents by counting them, so we cant skip ahead if there are impacts */
+        if ( (uiStartDocumentID > 0) && (pucImpacts == NULL) ) {
+            if ( (iError = iSrchTermSearchSkipIndexBlock(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+                    uiStartDocumentID, &pucIndexBlockStartPtr, NULL, &uiIndexEntryDocumentID)) != SRCH_NoError ) {
+                goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+            }
+        }
+#endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
 
 
         /* uiFieldID > 0 means that this is a fielded search and that there is only one field to match */
         if ( uiFieldID > 0 ) {
 
             /* Add the entry to the weights array */
-            for ( pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockHeaderLength + uiIndexBlockDataLength; 
-                    pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pucIndexBlockPtr = pucIndexBlockStartPtr; 
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
     
 /* Compressed int */
                 /* Read the index block, skip the term position */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, NULL, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -956,6 +1564,12 @@ int iSrchTermSearchGetSearchWeightsFromTerm
                 /* Set the document ID */
                 uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
 
+                /* Move on to the impact of this document if this is a new document, it only gets added once */
+                if ( (uiIndexEntryDeltaDocumentID != 0) && (pucImpacts != NULL) ) {
+                    uiImpactsIndex++;
+                    fEntryWeight = pucImpacts[uiImpactsIndex - 1] * fAdjustedWeight;
+                }
+
                 /* Check that this is a field we are searching on */
                 if ( uiIndexEntryFieldID == uiFieldID ) {
     
@@ -972,7 +1586,17 @@ int iSrchTermSearchGetSearchWeightsFromTerm
 #endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
     
                     /* Cumulate the weight into the weight array from the passed weigth and the adjustment */
-                    pfWeights[uiIndexEntryDocumentID] += fAdjustedWeight;
+                    if ( pswSrchWeightTerm == NULL ) {
+                        pfWeights[uiIndexEntryDocumentID] += fEntryWeight;
+                    }
+                    else if ( (iError = iSrchTermSearchAddSparseWeight(pswSrchWeightTerm, &uiDocumentIDsCapacity, uiIndexEntryDocumentID, fEntryWeight)) != SRCH_NoError ) {
+                        goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+                    }
+
+                    /* Clear the weight if there are impacts, the document has been accounted for */
+                    if ( pucImpacts != NULL ) {
+                        fEntryWeight = 0;
+                    }
     
 /*                     iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: [%s], uiIndexEntryDocumentID: %u, uiIndexEntryFieldID: %u, pfWeights[uiIndexEntryDocumentID]: %f",  */
 /*                             pucTerm, uiIndexEntryDocumentID, uiIndexEntryFieldID, pfWeights[uiIndexEntryDocumentID]); */
@@ -984,14 +1608,15 @@ int iSrchTermSearchGetSearchWeightsFromTerm
         else if ( pucFieldIDBitmap != NULL ) {
 
             /* Add the entry to the weights array */
-            for ( pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockHeaderLength + uiIndexBlockDataLength; 
-                    pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pucIndexBlockPtr = pucIndexBlockStartPtr; 
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
     
 /* Compressed int */
                 /* Read the index block, skip the term position */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, NULL, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -1007,6 +1632,12 @@ int iSrchTermSearchGetSearchWeightsFromTerm
                 /* Set the document ID */
                 uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
 
+                /* Move on to the impact of this document if this is a new document, it only gets added once */
+                if ( (uiIndexEntryDeltaDocumentID != 0) && (pucImpacts != NULL) ) {
+                    uiImpactsIndex++;
+                    fEntryWeight = pucImpacts[uiImpactsIndex - 1] * fAdjustedWeight;
+                }
+
                 /* Check that this is a field we are searching on - field ID 0 is not a field */
                 if ( UTL_BITMAP_IS_BIT_SET_IN_POINTER(pucFieldIDBitmap, uiIndexEntryFieldID - 1) ) {
     
@@ -1023,7 +1654,17 @@ int iSrchTermSearchGetSearchWeightsFromTerm
 #endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
 
                     /* Cumulate the weight into the weight array from the passed weigth and the adjustment */
-                    pfWeights[uiIndexEntryDocumentID] += fAdjustedWeight;
+                    if ( pswSrchWeightTerm == NULL ) {
+                        pfWeights[uiIndexEntryDocumentID] += fEntryWeight;
+                    }
+                    else if ( (iError = iSrchTermSearchAddSparseWeight(pswSrchWeightTerm, &uiDocumentIDsCapacity, uiIndexEntryDocumentID, fEntryWeight)) != SRCH_NoError ) {
+                        goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+                    }
+
+                    /* Clear the weight if there are impacts, the document has been accounted for */
+                    if ( pucImpacts != NULL ) {
+                        fEntryWeight = 0;
+                    }
     
 /*                     iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: [%s], uiIndexEntryDocumentID: %u, uiIndexEntryFieldID: %u, pfWeights[uiIndexEntryDocumentID]: %f",  */
 /*                             pucTerm, uiIndexEntryDocumentID, uiIndexEntryFieldID, pfWeights[uiIndexEntryDocumentID]); */
@@ -1035,14 +1676,14 @@ int iSrchTermSearchGetSearchWeightsFromTerm
         else {
 
             /* Add the entry to the weights array */
-            for ( pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockHeaderLength + uiIndexBlockDataLength; 
-                    pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pucIndexBlockPtr = pucIndexBlockStartPtr; 
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
     
 /* Compressed int */
                 /* Read the index block, skip the term position and the field ID */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
-                UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, NULL, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -1057,6 +1698,12 @@ int iSrchTermSearchGetSearchWeightsFromTerm
                 /* Set the document ID */
                 uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
 
+                /* Move on to the impact of this document if this is a new document, it only gets added once */
+                if ( (uiIndexEntryDeltaDocumentID != 0) && (pucImpacts != NULL) ) {
+                    uiImpactsIndex++;
+                    fEntryWeight = pucImpacts[uiImpactsIndex - 1] * fAdjustedWeight;
+                }
+
 #if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS)
                 /* Skip this document if we are not yet in range */
                 if ( uiIndexEntryDocumentID < uiStartDocumentID ) {
@@ -1070,7 +1717,17 @@ int iSrchTermSearchGetSearchWeightsFromTerm
 #endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
 
                 /* Cumulate the weight into the weight array from the passed weigth and the adjustment */
-                pfWeights[uiIndexEntryDocumentID] += fAdjustedWeight;
+                if ( pswSrchWeightTerm == NULL ) {
+                    pfWeights[uiIndexEntryDocumentID] += fEntryWeight;
+                }
+                else if ( (iError = iSrchTermSearchAddSparseWeight(pswSrchWeightTerm, &uiDocumentIDsCapacity, uiIndexEntryDocumentID, fEntryWeight)) != SRCH_NoError ) {
+                    goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+                }
+
+                /* Clear the weight if there are impacts, the document has been accounted for */
+                if ( pucImpacts != NULL ) {
+                    fEntryWeight = 0;
+                }
     
 /*                 iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: [%s], uiIndexEntryDocumentID: %u, pfWeights[uiIndexEntryDocumentID]: %f",  */
 /*                         pucTerm, uiIndexEntryDocumentID, pfWeights[uiIndexEntryDocumentID]); */
@@ -1080,10 +1737,48 @@ int iSrchTermSearchGetSearchWeightsFromTerm
 
 
 
+    /* Hand over the sparse weights for this term, merging them into the passed search weight structure */
+    if ( pswSrchWeightTerm != NULL ) {
+
+        if ( pswSrchWeight == NULL ) {
+
+            /* Expand the sparse weights if they turned out to be too dense */
+            if ( pswSrchWeightTerm->uiDocumentIDsLength > SRCH_WEIGHT_SPARSE_LENGTH_MAXIMUM(pswSrchWeightTerm->uiWeightsLength) ) {
+                if ( (iError = iSrchWeightExpandSparse(pswSrchWeightTerm)) != SRCH_NoError ) {
+                    iUtlLogError(UTL_LOG_CONTEXT, "Failed to expand the search weight, srch error: %d.", iError);
+                    goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+                }
+            }
+
+            pswSrchWeight = pswSrchWeightTerm;
+            pswSrchWeightTerm = NULL;
+        }
+        else {
+
+            /* OR adds up the weights, it disposes of both search weight structures if it succeeds */
+            if ( (iError = iSrchWeightMergeOR(pswSrchWeight, pswSrchWeightTerm, &pswSrchWeight)) != SRCH_NoError ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Failed to merge the search weights, srch error: %d.", iError);
+                goto bailFromiSrchTermSearchGetSearchWeightsFromTerm;
+            }
+
+            pswSrchWeightTerm = NULL;
+
+            /* Set the return pointer, the merge returns a new search weight structure */
+            *ppswSrchWeight = pswSrchWeight;
+        }
+    }
+
+
+
     /* Bail label */
     bailFromiSrchTermSearchGetSearchWeightsFromTerm:
 
 
+    /* Free the sparse weights for this term, they were not handed over */
+    iSrchWeightFree(pswSrchWeightTerm);
+    pswSrchWeightTerm = NULL;
+
+
     /* The search weights was allocated if it was not passed, so we need to do something with it */ 
     if ( *ppswSrchWeight == NULL ) {
         
@@ -1096,7 +1791,8 @@ int iSrchTermSearchGetSearchWeightsFromTerm
         else {
         
             /* Free allocations */
-            s_free(pswSrchWeight);
+            iSrchWeightFree(pswSrchWeight);
+            pswSrchWeight = NULL;
         }
     }
 
@@ -1148,10 +1844,12 @@ int iSrchTermSearchGetSearchBitmapFromTerm
     int                 iError = UTL_NoError;
 
     unsigned long       ulIndexBlockID = 0;
+    unsigned int        uiTermID = SRCH_TERMDICT_TERM_ID_INVALID;
     unsigned char       *pucIndexBlock = NULL;
     unsigned int        uiIndexBlockLength = 0;
     unsigned int        uiIndexBlockHeaderLength = 0;
     unsigned int        uiIndexBlockDataLength = 0;
+    unsigned int        uiDocumentContainersLength = 0;
     
     unsigned int        uiFieldID = 0;
 
@@ -1212,7 +1910,7 @@ int iSrchTermSearchGetSearchBitmapFromTerm
 
         /* Look up the term */
         iError = iSrchTermDictLookup(psiSrchIndex, pucTerm, pucFieldIDBitmap, uiFieldIDBitmapLength, 
-                &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID);
+                &uiTermType, &uiTermCount, &uiDocumentCount, &ulIndexBlockID, &uiTermID);
     
         /* Skip setting the bitmap if the term does not exist or does not occur
         ** (subject to constraints, like field ID), otherwise return an error if
@@ -1257,8 +1955,6 @@ int iSrchTermSearchGetSearchBitmapFromTerm
 
     /* Get the index block for this term, processing any errors */
     {
-        unsigned char   *pucIndexBlockPtr = NULL;
-
         /* Get the index block data */
         if ( (iError = iUtlDataGetEntry(psiSrchIndex->pvUtlIndexData, ulIndexBlockID, (void **)&pucIndexBlock, &uiIndexBlockLength)) != UTL_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to get index data, index object ID: %lu, index: '%s', utl error: %d.", 
@@ -1267,12 +1963,14 @@ int iSrchTermSearchGetSearchBitmapFromTerm
             goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
         }
     
-        /* Set the pointer to start reading from */
-        pucIndexBlockPtr = pucIndexBlock;
-    
         /* Get the size of the index block */
-        UTL_NUM_READ_COMPRESSED_UINT(uiIndexBlockDataLength, pucIndexBlockPtr);
-        uiIndexBlockHeaderLength = pucIndexBlockPtr - pucIndexBlock;
+        if ( (iError = iSrchTermSearchGetIndexBlockHeader(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, &uiIndexBlockHeaderLength, 
+                &uiIndexBlockDataLength, &uiDocumentContainersLength, NULL, NULL, NULL)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+        }
+
+        /* Leave the document containers off the index block, they are only used if we can set the bitmap from them */
+        uiIndexBlockLength -= uiDocumentContainersLength;
 
         /* Empty block - probably a stop term */
         if ( uiIndexBlockDataLength == 0 ) {
@@ -1304,8 +2002,8 @@ int iSrchTermSearchGetSearchBitmapFromTerm
     }
     else {
 
-        /* Allocate a new search bitmap structure */
-        if ( (iError = iSrchBitmapCreate(NULL, psiSrchIndex->uiDocumentCount + 1, false, ppsbSrchBitmap)) != SRCH_NoError ) {
+        /* Allocate a new search bitmap structure, using a roaring structure since terms tend to occur in few documents */
+        if ( (iError = iSrchBitmapCreateRoaring(NULL, psiSrchIndex->uiDocumentCount + 1, ppsbSrchBitmap)) != SRCH_NoError ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a new search bitmap, srch error: %d.", iError);
             goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
         }
@@ -1346,6 +2044,44 @@ int iSrchTermSearchGetSearchBitmapFromTerm
 
 
 
+    /* Set the bitmap from the document containers if there are any, this is only possible if this is
+    ** not a fielded search, if there are no document ID range restrictions and if the search bitmap 
+    ** structure has a roaring structure to merge them into
+    */
+    if ( (uiDocumentContainersLength > 0) && (pucFieldIDBitmap == NULL) && (uiStartDocumentID == 0) && (uiEndDocumentID == 0) && 
+            (psbSrchBitmap->pvUtlRoaring != NULL) ) {
+
+        void    *pvUtlRoaring = NULL;
+        void    *pvUtlRoaringMerged = NULL;
+
+        /* Deserialize the document containers, they follow the index block */
+        if ( (iError = iUtlRoaringDeserialize(pucIndexBlock + uiIndexBlockLength, uiDocumentContainersLength, &pvUtlRoaring)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to deserialize the document containers, index object ID: %lu, index: '%s', utl error: %d.", 
+                    ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+            iError = SRCH_TermSearchDocumentContainersFailed;
+            goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+        }
+
+        /* OR the document containers into the roaring structure */
+        if ( (iError = iUtlRoaringMerge(psbSrchBitmap->pvUtlRoaring, pvUtlRoaring, UTL_ROARING_MERGE_TYPE_OR, &pvUtlRoaringMerged)) != UTL_NoError ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to merge the document containers, index object ID: %lu, index: '%s', utl error: %d.", 
+                    ulIndexBlockID, psiSrchIndex->pucIndexName, iError);
+            iUtlRoaringFree(pvUtlRoaring);
+            iError = SRCH_TermSearchDocumentContainersFailed;
+            goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+        }
+
+        /* Swap in the merged roaring structure */
+        iUtlRoaringFree(pvUtlRoaring);
+        iUtlRoaringFree(psbSrchBitmap->pvUtlRoaring);
+        psbSrchBitmap->pvUtlRoaring = pvUtlRoaringMerged;
+
+        iError = SRCH_NoError;
+        goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+    }
+
+
+
     /* Optimize the end document ID, this allows us to remove the
     ** 'uiEndDocumentID != 0' clause from the document ID range check
     */
@@ -1358,30 +2094,48 @@ int iSrchTermSearchGetSearchBitmapFromTerm
     /* Loop over the index block, decoding it and populating the postings array */
     {
         unsigned char   *pucIndexBlockPtr = NULL;
+        unsigned char   *pucIndexBlockStartPtr = NULL;
         unsigned char   *pucIndexBlockEndPtr = NULL;
 
+        unsigned int    puiIndexEntries[SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH];
+        unsigned int    *puiIndexEntriesPtr = NULL;
+        unsigned int    *puiIndexEntriesEnd = NULL;
+
         unsigned int    uiIndexEntryDocumentID = 0;
         unsigned int    uiIndexEntryDeltaDocumentID = 0;
 /*         unsigned int    uiIndexEntryDeltaTermPosition = 0; */
         unsigned int    uiIndexEntryFieldID = 0;
 /*         unsigned int     uiIndexEntryTermWeight = 0; */
-            
-        /* Dereference the bitmap array */
-        unsigned char   *pucBitmapPtr = psbSrchBitmap->pucBitmap;
+
+
+        /* Set the start and end pointers, skipping ahead to the start document ID if we can, we dont need the term positions */
+        if ( (iError = iSrchTermSearchGetIndexBlockStreams(psiSrchIndex, pucIndexBlock + uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+                &pucIndexBlockStartPtr, &pucIndexBlockEndPtr, NULL)) != SRCH_NoError ) {
+            goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+        }
+#if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS)
+        if ( uiStartDocumentID > 0 ) {
+            if ( (iError = iSrchTermSearchSkipIndexBlock(psiSrchIndex, pucIndexBlock, uiIndexBlockLength, uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+                    uiStartDocumentID, &pucIndexBlockStartPtr, NULL, &uiIndexEntryDocumentID)) != SRCH_NoError ) {
+                goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+            }
+        }
+#endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
 
 
         /* uiFieldID > 0 means that this is a fielded search and that there is only one field to match */
         if ( uiFieldID > 0 ) {
 
             /* Add the entry to the weights array */
-            for ( pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockHeaderLength + uiIndexBlockDataLength; 
-                    pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pucIndexBlockPtr = pucIndexBlockStartPtr; 
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
     
 /* Compressed int */
                 /* Read the index block, skip the term position */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, NULL, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -1413,7 +2167,10 @@ int iSrchTermSearchGetSearchBitmapFromTerm
 #endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
 
                     /* Set the bit */
-                    UTL_BITMAP_SET_BIT_IN_POINTER(pucBitmapPtr, uiIndexEntryDocumentID);
+                    SRCH_BITMAP_SET_BIT(psbSrchBitmap, uiIndexEntryDocumentID, iError);
+                    if ( iError != SRCH_NoError ) {
+                        goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+                    }
     
 /*                     iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: [%s], uiIndexEntryDocumentID: %u, uiIndexEntryFieldID: %u",  */
 /*                             pucTerm, uiIndexEntryDocumentID, uiIndexEntryFieldID); */
@@ -1425,14 +2182,15 @@ int iSrchTermSearchGetSearchBitmapFromTerm
         else if ( pucFieldIDBitmap != NULL ) {
 
             /* Add the entry to the weights array */
-            for ( pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockHeaderLength + uiIndexBlockDataLength; 
-                    pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pucIndexBlockPtr = pucIndexBlockStartPtr; 
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
     
 /* Compressed int */
                 /* Read the index block, skip the term position */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryFieldID, pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, NULL, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                uiIndexEntryFieldID = puiIndexEntriesPtr[2];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -1463,7 +2221,10 @@ int iSrchTermSearchGetSearchBitmapFromTerm
 #endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
 
                     /* Set the bit */
-                    UTL_BITMAP_SET_BIT_IN_POINTER(pucBitmapPtr, uiIndexEntryDocumentID);
+                    SRCH_BITMAP_SET_BIT(psbSrchBitmap, uiIndexEntryDocumentID, iError);
+                    if ( iError != SRCH_NoError ) {
+                        goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+                    }
     
 /*                     iUtlLogDebug(UTL_LOG_CONTEXT, "pucTerm: [%s], uiIndexEntryDocumentID: %u, uiIndexEntryFieldID: %u",  */
 /*                             pucTerm, uiIndexEntryDocumentID, uiIndexEntryFieldID); */
@@ -1475,14 +2236,14 @@ int iSrchTermSearchGetSearchBitmapFromTerm
         else {
 
             /* Add the entry to the weights array */
-            for ( pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength, pucIndexBlockEndPtr = pucIndexBlock + uiIndexBlockHeaderLength + uiIndexBlockDataLength; 
-                    pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+            for ( pucIndexBlockPtr = pucIndexBlockStartPtr; 
+                    (puiIndexEntriesPtr < puiIndexEntriesEnd) || (pucIndexBlockPtr < pucIndexBlockEndPtr); ) {
     
 /* Compressed int */
                 /* Read the index block, skip the term position and the field ID */
-                UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryDeltaDocumentID, pucIndexBlockPtr);
-                UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
-                UTL_NUM_SKIP_COMPRESSED_UINT(pucIndexBlockPtr);
+                SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(psiSrchIndex, pucIndexBlockPtr, pucIndexBlockEndPtr, NULL, puiIndexEntries, puiIndexEntriesPtr, puiIndexEntriesEnd);
+                uiIndexEntryDeltaDocumentID = puiIndexEntriesPtr[0];
+                puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
 /*                 UTL_NUM_READ_COMPRESSED_UINT(uiIndexEntryTermWeight, pucIndexBlockPtr); */
         
 /* Varint */
@@ -1509,7 +2270,10 @@ int iSrchTermSearchGetSearchBitmapFromTerm
 #endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) */
 
                 /* Set the bit */
-                UTL_BITMAP_SET_BIT_IN_POINTER(pucBitmapPtr, uiIndexEntryDocumentID);
+                SRCH_BITMAP_SET_BIT(psbSrchBitmap, uiIndexEntryDocumentID, iError);
+                if ( iError != SRCH_NoError ) {
+                    goto bailFromiSrchTermSearchGetSearchBitmapFromTerm;
+                }
 
 /* printf("uiIndexEntryDocumentID: %u\n", uiIndexEntryDocumentID); */
     
@@ -1551,3 +2315,1194 @@ int iSrchTermSearchGetSearchBitmapFromTerm
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchTermSearchGetIndexBlockStreams()
+
+    Purpose:    This function gets the start and end of the index entries in the
+                index block data, and the start of the term positions.
+
+                If the index block data is split into a document stream and a
+                term position stream, the index entries are the runs in the 
+                document stream and the term positions are in the term position
+                stream. Otherwise the index entries are all the index block data 
+                and the term positions are in the index entries, so the term 
+                positions pointer is set to NULL.
+
+    Parameters: psiSrchIndex            index structure
+                pucIndexBlockData       index block data
+                uiIndexBlockDataLength  index block data length
+                ppucIndexBlockPtr       return pointer for the start of the index entries
+                ppucIndexBlockEndPtr    return pointer for the end of the index entries
+                ppucTermPositionsPtr    return pointer for the start of the term positions (optional)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermSearchGetIndexBlockStreams
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucIndexBlockData,
+    unsigned int uiIndexBlockDataLength,
+    unsigned char **ppucIndexBlockPtr,
+    unsigned char **ppucIndexBlockEndPtr,
+    unsigned char **ppucTermPositionsPtr
+)
+{
+
+    unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned int    uiDocumentsLength = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermSearchGetIndexBlockStreams'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( pucIndexBlockData == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucIndexBlockData' parameter passed to 'iSrchTermSearchGetIndexBlockStreams'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( ppucIndexBlockPtr == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppucIndexBlockPtr' parameter passed to 'iSrchTermSearchGetIndexBlockStreams'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( ppucIndexBlockEndPtr == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppucIndexBlockEndPtr' parameter passed to 'iSrchTermSearchGetIndexBlockStreams'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* The index entries are all the index block data if it is not split */
+    if ( !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM) || (uiIndexBlockDataLength == 0) ) {
+
+        *ppucIndexBlockPtr = pucIndexBlockData;
+        *ppucIndexBlockEndPtr = pucIndexBlockData + uiIndexBlockDataLength;
+
+        if ( ppucTermPositionsPtr != NULL ) {
+            *ppucTermPositionsPtr = NULL;
+        }
+
+        return (SRCH_NoError);
+    }
+
+
+    /* Read the document stream length */
+    pucIndexBlockPtr = pucIndexBlockData;
+    UTL_NUM_READ_COMPRESSED_UINT(uiDocumentsLength, pucIndexBlockPtr);
+
+    /* Check the document stream length */
+    if ( (pucIndexBlockPtr + uiDocumentsLength) > (pucIndexBlockData + uiIndexBlockDataLength) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid index block document stream length: %u, index: '%s'.", uiDocumentsLength, psiSrchIndex->pucIndexName);
+        return (SRCH_TermSearchInvalidIndexBlock);
+    }
+
+
+    /* Set the return pointers, the term position stream follows the document stream */
+    *ppucIndexBlockPtr = pucIndexBlockPtr;
+    *ppucIndexBlockEndPtr = pucIndexBlockPtr + uiDocumentsLength;
+
+    if ( ppucTermPositionsPtr != NULL ) {
+        *ppucTermPositionsPtr = pucIndexBlockPtr + uiDocumentsLength;
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermSearchGetIndexBlockHeader()
+
+    Purpose:    This function reads the header of an index block, the header
+                holds the index block data length, followed by the document
+                containers length if the index has document containers, followed
+                by the impact count, the impacts scale and the impacts if the 
+                index has impacts.
+
+                The document containers are at the end of the index block,
+                so callers which dont use them can leave them off the index
+                block length, the skip list is found at the end of what is left.
+
+                The impacts are counted as part of the header, so callers which
+                dont use them never see them.
+
+    Parameters: psiSrchIndex                    index structure
+                pucIndexBlock                   index block
+                uiIndexBlockLength              index block length
+                puiIndexBlockHeaderLength       return pointer for the index block header length
+                puiIndexBlockDataLength         return pointer for the index block data length
+                puiDocumentContainersLength     return pointer for the document containers length (optional)
+                ppucImpacts                     return pointer for the impacts, NULL if there are none (optional)
+                puiImpactsLength                return pointer for the impact count (optional)
+                pfImpactsScale                  return pointer for the impacts scale (optional)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermSearchGetIndexBlockHeader
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucIndexBlock,
+    unsigned int uiIndexBlockLength,
+    unsigned int *puiIndexBlockHeaderLength,
+    unsigned int *puiIndexBlockDataLength,
+    unsigned int *puiDocumentContainersLength,
+    unsigned char **ppucImpacts,
+    unsigned int *puiImpactsLength,
+    float *pfImpactsScale
+)
+{
+
+    unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned int    uiIndexBlockDataLength = 0;
+    unsigned int    uiDocumentContainersLength = 0;
+    unsigned int    uiImpactsLength = 0;
+    unsigned int    uiImpactsScale = 0;
+    float           fImpactsScale = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermSearchGetIndexBlockHeader'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( pucIndexBlock == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucIndexBlock' parameter passed to 'iSrchTermSearchGetIndexBlockHeader'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( puiIndexBlockHeaderLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiIndexBlockHeaderLength' parameter passed to 'iSrchTermSearchGetIndexBlockHeader'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+    if ( puiIndexBlockDataLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiIndexBlockDataLength' parameter passed to 'iSrchTermSearchGetIndexBlockHeader'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Read the index block data length, the document containers length if the index has them, 
+    ** and the impact count and the impacts scale if the index has impacts
+    */
+    pucIndexBlockPtr = pucIndexBlock;
+    UTL_NUM_READ_COMPRESSED_UINT(uiIndexBlockDataLength, pucIndexBlockPtr);
+    if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_DOCUMENT_CONTAINERS ) {
+        UTL_NUM_READ_COMPRESSED_UINT(uiDocumentContainersLength, pucIndexBlockPtr);
+    }
+    if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_IMPACTS ) {
+        UTL_NUM_READ_COMPRESSED_UINT(uiImpactsLength, pucIndexBlockPtr);
+
+        /* The scale is stored as the bits of the float, copied rather than cast to keep clear of aliasing */
+        UTL_NUM_READ_UINT(uiImpactsScale, sizeof(float), pucIndexBlockPtr);
+        s_memcpy(&fImpactsScale, &uiImpactsScale, sizeof(float));
+    }
+
+    /* Check the lengths */
+    if ( ((pucIndexBlockPtr - pucIndexBlock) + uiImpactsLength + uiIndexBlockDataLength + uiDocumentContainersLength) > uiIndexBlockLength ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid index block header, data length: %u, document containers length: %u, impact count: %u, index block length: %u, index: '%s'.", 
+                uiIndexBlockDataLength, uiDocumentContainersLength, uiImpactsLength, uiIndexBlockLength, psiSrchIndex->pucIndexName);
+        return (SRCH_TermSearchInvalidIndexBlock);
+    }
+
+
+    /* Set the return pointers */
+    *puiIndexBlockHeaderLength = (pucIndexBlockPtr - pucIndexBlock) + uiImpactsLength;
+    *puiIndexBlockDataLength = uiIndexBlockDataLength;
+
+    if ( puiDocumentContainersLength != NULL ) {
+        *puiDocumentContainersLength = uiDocumentContainersLength;
+    }
+
+    if ( ppucImpacts != NULL ) {
+        *ppucImpacts = (uiImpactsLength > 0) ? pucIndexBlockPtr : NULL;
+    }
+
+    if ( puiImpactsLength != NULL ) {
+        *puiImpactsLength = uiImpactsLength;
+    }
+
+    if ( pfImpactsScale != NULL ) {
+        *pfImpactsScale = fImpactsScale;
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermSearchDecodeIndexEntries()
+
+    Purpose:    This function decodes the next index entries from the index block 
+                data into an array, the array needs to be able to hold 
+                SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH index entries of 
+                SRCH_TERMSRCH_INDEX_ENTRY_LENGTH uints each. Each index entry
+                is a delta document ID, a term position delta and a field ID.
+
+                Compressed index block data gets decoded in bulk, and bit packed
+                index block data gets unpacked a frame at a time.
+
+                Split index block data gets decoded a run at a time from the
+                document stream, and the term positions are read from the term
+                position stream. 
+
+                The term positions are set to 0 if the term positions pointer is 
+                NULL, and are not read at all if the index block data is split 
+                or bit packed, so the term position stream or the term position 
+                arrays in the frames are never touched.
+
+    Parameters: psiSrchIndex            index structure
+                ppucIndexBlockPtr       pointer to the index block data pointer (updated)
+                pucIndexBlockEndPtr     index block data end
+                ppucTermPositionsPtr    pointer to the term positions pointer (updated), NULL 
+                                        if the term positions are not needed (optional)
+                puiIndexEntries         array to decode the index entries into
+                puiIndexEntriesLength   return pointer for the number of uints decoded
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchTermSearchDecodeIndexEntries
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char **ppucIndexBlockPtr,
+    unsigned char *pucIndexBlockEndPtr,
+    unsigned char **ppucTermPositionsPtr,
+    unsigned int *puiIndexEntries,
+    unsigned int *puiIndexEntriesLength
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned int    uiFrameEntriesCount = 0;
+    unsigned int    puiBitWidths[SRCH_TERMSRCH_INDEX_ENTRY_LENGTH];
+    unsigned int    uiI = 0;
+
+
+    /* Check the parameters */
+    if ( psiSrchIndex == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'psiSrchIndex' parameter passed to 'iSrchTermSearchDecodeIndexEntries'."); 
+        return (SRCH_InvalidIndex);
+    }
+
+    if ( (ppucIndexBlockPtr == NULL) || (*ppucIndexBlockPtr == NULL) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppucIndexBlockPtr' parameter passed to 'iSrchTermSearchDecodeIndexEntries'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( pucIndexBlockEndPtr == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucIndexBlockEndPtr' parameter passed to 'iSrchTermSearchDecodeIndexEntries'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM) && (ppucTermPositionsPtr != NULL) && (*ppucTermPositionsPtr == NULL) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppucTermPositionsPtr' parameter passed to 'iSrchTermSearchDecodeIndexEntries'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( puiIndexEntries == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiIndexEntries' parameter passed to 'iSrchTermSearchDecodeIndexEntries'."); 
+        return (SRCH_ParameterError);
+    }
+
+    if ( puiIndexEntriesLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiIndexEntriesLength' parameter passed to 'iSrchTermSearchDecodeIndexEntries'."); 
+        return (SRCH_ReturnParameterError);
+    }
+
+
+    /* Decode split index block data a run at a time, stopping when the next run does not fit */
+    if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM ) {
+
+        unsigned char   *pucIndexBlockPtr = *ppucIndexBlockPtr;
+        unsigned char   *pucRunPtr = NULL;
+        unsigned char   *pucTermPositionsPtr = (ppucTermPositionsPtr != NULL) ? *ppucTermPositionsPtr : NULL;
+        unsigned int    *puiIndexEntriesPtr = puiIndexEntries;
+        unsigned int    *puiIndexEntriesEnd = puiIndexEntries + (SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH);
+        unsigned int    uiRunDeltaDocumentID = 0;
+        unsigned int    uiRunFieldID = 0;
+        unsigned int    uiRunPostingsCount = 0;
+        unsigned int    uiTermPosition = 0;
+
+        while ( pucIndexBlockPtr < pucIndexBlockEndPtr ) {
+
+            /* Read the run */
+            pucRunPtr = pucIndexBlockPtr;
+            UTL_NUM_READ_COMPRESSED_UINT(uiRunDeltaDocumentID, pucIndexBlockPtr);
+            UTL_NUM_READ_COMPRESSED_UINT(uiRunFieldID, pucIndexBlockPtr);
+            UTL_NUM_READ_COMPRESSED_UINT(uiRunPostingsCount, pucIndexBlockPtr);
+
+            /* Check the run postings count, we need to be able to decode a run in one go */
+            if ( (uiRunPostingsCount == 0) || (uiRunPostingsCount > SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH) ) {
+                iUtlLogError(UTL_LOG_CONTEXT, "Invalid index block run postings count: %u, index: '%s'.", uiRunPostingsCount, psiSrchIndex->pucIndexName);
+                return (SRCH_TermSearchInvalidIndexBlock);
+            }
+
+            /* Leave the run for the next call if it does not fit */
+            if ( (puiIndexEntriesPtr + (uiRunPostingsCount * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH)) > puiIndexEntriesEnd ) {
+                pucIndexBlockPtr = pucRunPtr;
+                break;
+            }
+
+            /* Expand the run into index entries, only the first one can be in a new document */
+            for ( uiI = 0; uiI < uiRunPostingsCount; uiI++, puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH ) {
+                
+                if ( pucTermPositionsPtr != NULL ) {
+                    UTL_NUM_READ_COMPRESSED_UINT(uiTermPosition, pucTermPositionsPtr);
+                }
+
+                puiIndexEntriesPtr[0] = (uiI == 0) ? uiRunDeltaDocumentID : 0;
+                puiIndexEntriesPtr[1] = uiTermPosition;
+                puiIndexEntriesPtr[2] = uiRunFieldID;
+            }
+        }
+
+        ASSERT(pucIndexBlockPtr <= pucIndexBlockEndPtr);
+
+
+        /* Set the return pointers */
+        *ppucIndexBlockPtr = pucIndexBlockPtr;
+
+        if ( pucTermPositionsPtr != NULL ) {
+            *ppucTermPositionsPtr = pucTermPositionsPtr;
+        }
+
+        *puiIndexEntriesLength = puiIndexEntriesPtr - puiIndexEntries;
+
+        return (SRCH_NoError);
+    }
+
+
+    /* Decode compressed index block data in bulk, the term positions are interleaved so they get decoded regardless */
+    if ( !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED) ) {
+        iUtlNumReadCompressedUIntArray(ppucIndexBlockPtr, pucIndexBlockEndPtr, puiIndexEntries, 
+                SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH, puiIndexEntriesLength);
+        return (SRCH_NoError);
+    }
+
+
+    /* Nothing to unpack if we are at the end of the index block data */
+    if ( *ppucIndexBlockPtr >= pucIndexBlockEndPtr ) {
+        *puiIndexEntriesLength = 0;
+        return (SRCH_NoError);
+    }
+
+
+    /* Read the frame header */
+    if ( (iError = iSrchTermSearchReadIndexFrameHeader(psiSrchIndex, ppucIndexBlockPtr, &uiFrameEntriesCount, NULL, NULL, puiBitWidths, NULL)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    ASSERT((uiFrameEntriesCount > 0) && (uiFrameEntriesCount <= SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH));
+
+
+    /* Unpack the delta document IDs, term positions and field IDs into the index entries, 
+    ** skipping over the term positions and setting them to 0 if they are not needed
+    */
+    for ( uiI = 0; uiI < SRCH_TERMSRCH_INDEX_ENTRY_LENGTH; uiI++ ) {
+
+        if ( (uiI == SRCH_TERMSRCH_INDEX_ENTRY_TERM_POSITION) && (ppucTermPositionsPtr == NULL) ) {
+
+            unsigned int    uiJ = 0;
+
+            *ppucIndexBlockPtr += UTL_NUM_GET_BIT_PACKED_UINT_ARRAY_SIZE(uiFrameEntriesCount, puiBitWidths[uiI]);
+
+            for ( uiJ = 0; uiJ < uiFrameEntriesCount; uiJ++ ) {
+                puiIndexEntries[(uiJ * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH) + uiI] = 0;
+            }
+        }
+        else if ( (iError = iUtlNumReadBitPackedUIntArray(ppucIndexBlockPtr, puiBitWidths[uiI], puiIndexEntries + uiI, 
+                uiFrameEntriesCount, SRCH_TERMSRCH_INDEX_ENTRY_LENGTH)) != UTL_NoError ) {
+            return (SRCH_TermSearchInvalidIndexBlock);
+        }
+    }
+
+    ASSERT(*ppucIndexBlockPtr <= pucIndexBlockEndPtr);
+
+
+    /* Set the return pointer */
+    *puiIndexEntriesLength = uiFrameEntriesCount * SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) || defined(SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING)
+
+/*
+
+    Function:   iSrchTermSearchSkipIndexBlock()
+
+    Purpose:    This function uses the skip list appended to the index block 
+                data to get the place in the index block data where decoding 
+                should start in order to get to a document ID, and the document 
+                ID of the index entry preceeding that place.
+
+                Bit packed index block data has no skip list, the frame headers 
+                are used to skip frames instead.
+
+                Index blocks without a skip list get decoded from the start.
+
+                If the index block data is split, the place is in the document
+                stream and the skip list also gives the place in the term 
+                position stream where decoding should start.
+
+    Parameters: psiSrchIndex                index structure
+                pucIndexBlock               index block
+                uiIndexBlockLength          index block length
+                uiIndexBlockHeaderLength    index block header length
+                uiIndexBlockDataLength      index block data length
+                uiDocumentID                document ID to skip to
+                ppucIndexBlockPtr           return pointer for the place to start decoding from
+                ppucTermPositionsPtr        return pointer for the place to start decoding the term positions from (optional)
+                puiIndexEntryDocumentID     return pointer for the preceeding index entry document ID
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermSearchSkipIndexBlock
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucIndexBlock,
+    unsigned int uiIndexBlockLength,
+    unsigned int uiIndexBlockHeaderLength,
+    unsigned int uiIndexBlockDataLength,
+    unsigned int uiDocumentID,
+    unsigned char **ppucIndexBlockPtr,
+    unsigned char **ppucTermPositionsPtr,
+    unsigned int *puiIndexEntryDocumentID
+)
+{
+
+    int             iError = SRCH_NoError;
+    unsigned char   *pucIndexBlockStartPtr = NULL;
+    unsigned char   *pucIndexBlockEndPtr = NULL;
+    unsigned char   *pucTermPositionsStartPtr = NULL;
+    unsigned char   *pucSkipListPtr = NULL;
+    unsigned int    uiSkipEntryCount = 0;
+    unsigned int    uiSkipEntryDocumentID = 0;
+    unsigned int    uiSkipEntryOffset = 0;
+    unsigned int    uiSkipEntryTermPositionsOffset = 0;
+    unsigned int    uiSkipEntryDeltaDocumentID = 0;
+    unsigned int    uiSkipEntryDeltaOffset = 0;
+    unsigned int    uiSkipEntryDeltaTermPositionsOffset = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(pucIndexBlock != NULL);
+    ASSERT(uiIndexBlockLength >= (uiIndexBlockHeaderLength + uiIndexBlockDataLength));
+    ASSERT(uiDocumentID > 0);
+    ASSERT(ppucIndexBlockPtr != NULL);
+    ASSERT(puiIndexEntryDocumentID != NULL);
+
+
+    /* Default to the start of the index entries and of the term positions */
+    if ( (iError = iSrchTermSearchGetIndexBlockStreams(psiSrchIndex, pucIndexBlock + uiIndexBlockHeaderLength, uiIndexBlockDataLength, 
+            &pucIndexBlockStartPtr, &pucIndexBlockEndPtr, &pucTermPositionsStartPtr)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    *ppucIndexBlockPtr = pucIndexBlockStartPtr;
+    if ( ppucTermPositionsPtr != NULL ) {
+        *ppucTermPositionsPtr = pucTermPositionsStartPtr;
+    }
+    *puiIndexEntryDocumentID = 0;
+
+
+    /* Skip the frames which end before the document ID if the index block data is bit packed */
+    if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED ) {
+
+        unsigned char   *pucIndexBlockPtr = NULL;
+        unsigned int    uiFrameDocumentID = 0;
+        unsigned int    uiFrameDeltaDocumentID = 0;
+        unsigned int    uiFrameDataLength = 0;
+
+        /* Loop over the frames */
+        for ( pucIndexBlockPtr = pucIndexBlockStartPtr; pucIndexBlockPtr < pucIndexBlockEndPtr; ) {
+
+            unsigned char   *pucFramePtr = pucIndexBlockPtr;
+
+            /* Read the frame header */
+            if ( (iError = iSrchTermSearchReadIndexFrameHeader(psiSrchIndex, &pucIndexBlockPtr, NULL, &uiFrameDeltaDocumentID, 
+                    NULL, NULL, &uiFrameDataLength)) != SRCH_NoError ) {
+                return (iError);
+            }
+
+            /* Stop here if the frame contains the document ID */
+            if ( (uiFrameDocumentID + uiFrameDeltaDocumentID) >= uiDocumentID ) {
+                pucIndexBlockPtr = pucFramePtr;
+                break;
+            }
+
+            /* Skip the frame */
+            uiFrameDocumentID += uiFrameDeltaDocumentID;
+            pucIndexBlockPtr += uiFrameDataLength;
+        }
+
+        ASSERT(pucIndexBlockPtr <= pucIndexBlockEndPtr);
+
+        /* Set the return pointers */
+        *ppucIndexBlockPtr = pucIndexBlockPtr;
+        *puiIndexEntryDocumentID = uiFrameDocumentID;
+
+        return (SRCH_NoError);
+    }
+
+
+    /* Nothing to do if there is no skip list, either because the index predates 
+    ** skip lists or because there were too few postings for this term
+    */
+    if ( !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_SKIP_LIST) || 
+            (uiIndexBlockLength == (uiIndexBlockHeaderLength + uiIndexBlockDataLength)) ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* The skip list follows the index block data */
+    pucSkipListPtr = pucIndexBlock + uiIndexBlockHeaderLength + uiIndexBlockDataLength;
+
+    /* Read the skip list entry count */
+    UTL_NUM_READ_COMPRESSED_UINT(uiSkipEntryCount, pucSkipListPtr);
+
+
+    /* Loop over the skip list entries while the runs they mark end before the document ID */
+    for ( ; uiSkipEntryCount > 0; uiSkipEntryCount-- ) {
+
+        /* Read the skip list entry */
+        UTL_NUM_READ_COMPRESSED_UINT(uiSkipEntryDeltaDocumentID, pucSkipListPtr);
+        UTL_NUM_READ_COMPRESSED_UINT(uiSkipEntryDeltaOffset, pucSkipListPtr);
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM ) {
+            UTL_NUM_READ_COMPRESSED_UINT(uiSkipEntryDeltaTermPositionsOffset, pucSkipListPtr);
+        }
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX ) {
+            UTL_NUM_SKIP_COMPRESSED_UINT(pucSkipListPtr);
+        }
+
+        /* Stop here if the run contains the document ID */
+        if ( (uiSkipEntryDocumentID + uiSkipEntryDeltaDocumentID) >= uiDocumentID ) {
+            break;
+        }
+
+        /* Skip the run */
+        uiSkipEntryDocumentID += uiSkipEntryDeltaDocumentID;
+        uiSkipEntryOffset += uiSkipEntryDeltaOffset;
+        uiSkipEntryTermPositionsOffset += uiSkipEntryDeltaTermPositionsOffset;
+    }
+
+    ASSERT((pucIndexBlockStartPtr + uiSkipEntryOffset) < pucIndexBlockEndPtr);
+
+
+    /* Set the return pointers */
+    *ppucIndexBlockPtr = pucIndexBlockStartPtr + uiSkipEntryOffset;
+    if ( (ppucTermPositionsPtr != NULL) && (pucTermPositionsStartPtr != NULL) ) {
+        *ppucTermPositionsPtr = pucTermPositionsStartPtr + uiSkipEntryTermPositionsOffset;
+    }
+    *puiIndexEntryDocumentID = uiSkipEntryDocumentID;
+
+
+    return (SRCH_NoError);
+
+}
+
+#endif /* defined(SRCH_TERMSRCH_ENABLE_DOCUMENT_ID_RANGE_RESTRICTIONS) || defined(SRCH_TERMSRCH_ENABLE_START_DOCUMENT_ID_SKIPPING) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermSearchGetSrchPostingBlocksFromIndexBlock()
+
+    Purpose:    This function creates the search posting blocks for a search 
+                postings list from the block maximums stored in the skip list 
+                appended to the index block data. The maximum weight of each 
+                block is the maximum number of postings per document in the 
+                run times the term weight, or the maximum impact in the run
+                times the term weight if the index block has impacts, which
+                is an exact bound since the impacts are already normalized.
+
+                The block maximums are stored in the frame headers if the 
+                index block data is bit packed, one block per frame.
+
+                Nothing is done if the index block has no skip list or if 
+                the skip list has no block maximums.
+
+    Parameters: psiSrchIndex                index structure
+                pucIndexBlock               index block
+                uiIndexBlockLength          index block length
+                uiIndexBlockHeaderLength    index block header length
+                uiIndexBlockDataLength      index block data length
+                fTermWeight                 term weight
+                psplSrchPostingsList        search postings list structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermSearchGetSrchPostingBlocksFromIndexBlock
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char *pucIndexBlock,
+    unsigned int uiIndexBlockLength,
+    unsigned int uiIndexBlockHeaderLength,
+    unsigned int uiIndexBlockDataLength,
+    float fTermWeight,
+    struct srchPostingsList *psplSrchPostingsList
+)
+{
+
+    unsigned char               *pucSkipListPtr = NULL;
+    unsigned int                uiSkipEntryCount = 0;
+    unsigned int                uiSkipEntryDocumentID = 0;
+    unsigned int                uiSkipEntryDeltaDocumentID = 0;
+    unsigned int                uiMaximumDocumentPostingsCount = 0;
+
+    struct srchPostingBlock     *pspbSrchPostingBlocks = NULL;
+    struct srchPostingBlock     *pspbSrchPostingBlocksPtr = NULL;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(pucIndexBlock != NULL);
+    ASSERT(uiIndexBlockLength >= (uiIndexBlockHeaderLength + uiIndexBlockDataLength));
+    ASSERT(psplSrchPostingsList != NULL);
+    ASSERT(psplSrchPostingsList->uiSrchPostingsLength > 0);
+
+
+    /* Get the block maximums from the frame headers if the index block data is bit packed */
+    if ( (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED) && 
+            (psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX) ) {
+
+        int             iError = SRCH_NoError;
+        unsigned char   *pucIndexBlockPtr = NULL;
+        unsigned char   *pucIndexBlockEndPtr = NULL;
+        unsigned int    uiFrameCount = 0;
+        unsigned int    uiFrameDocumentID = 0;
+        unsigned int    uiFrameDeltaDocumentID = 0;
+        unsigned int    uiFrameDataLength = 0;
+
+        /* Count the frames */
+        for ( pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength, pucIndexBlockEndPtr = pucIndexBlockPtr + uiIndexBlockDataLength, uiFrameCount = 0;
+                pucIndexBlockPtr < pucIndexBlockEndPtr; uiFrameCount++ ) {
+            if ( (iError = iSrchTermSearchReadIndexFrameHeader(psiSrchIndex, &pucIndexBlockPtr, NULL, NULL, NULL, NULL, &uiFrameDataLength)) != SRCH_NoError ) {
+                return (iError);
+            }
+            pucIndexBlockPtr += uiFrameDataLength;
+        }
+
+        /* Allocate the search posting blocks, one per frame */
+        if ( (pspbSrchPostingBlocks = (struct srchPostingBlock *)s_malloc((size_t)(uiFrameCount * sizeof(struct srchPostingBlock)))) == NULL ) {
+            return (SRCH_MemError);
+        }
+
+        /* Loop over the frames, each one is a block */
+        for ( pucIndexBlockPtr = pucIndexBlock + uiIndexBlockHeaderLength, pspbSrchPostingBlocksPtr = pspbSrchPostingBlocks;
+                pucIndexBlockPtr < pucIndexBlockEndPtr; pspbSrchPostingBlocksPtr++ ) {
+
+            /* Read the frame header */
+            if ( (iError = iSrchTermSearchReadIndexFrameHeader(psiSrchIndex, &pucIndexBlockPtr, NULL, &uiFrameDeltaDocumentID, 
+                    &uiMaximumDocumentPostingsCount, NULL, &uiFrameDataLength)) != SRCH_NoError ) {
+                s_free(pspbSrchPostingBlocks);
+                return (iError);
+            }
+            pucIndexBlockPtr += uiFrameDataLength;
+
+            /* Set the search posting block, the last block ends with the last document */
+            uiFrameDocumentID += uiFrameDeltaDocumentID;
+            pspbSrchPostingBlocksPtr->uiDocumentID = (pucIndexBlockPtr < pucIndexBlockEndPtr) ? uiFrameDocumentID : UINT_MAX;
+            pspbSrchPostingBlocksPtr->fMaxWeight = uiMaximumDocumentPostingsCount * fTermWeight;
+        }
+
+        ASSERT((pspbSrchPostingBlocksPtr - pspbSrchPostingBlocks) == uiFrameCount);
+
+        /* Hand over the search posting blocks */
+        psplSrchPostingsList->pspbSrchPostingBlocks = pspbSrchPostingBlocks;
+        psplSrchPostingsList->uiSrchPostingBlocksLength = uiFrameCount;
+
+        return (SRCH_NoError);
+    }
+
+
+    /* Nothing to do if there are no block maximums, either because the index predates 
+    ** them or because there were too few postings for this term to have a skip list
+    */
+    if ( !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_SKIP_LIST) || 
+            !(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX) || 
+            (uiIndexBlockLength == (uiIndexBlockHeaderLength + uiIndexBlockDataLength)) ) {
+        return (SRCH_NoError);
+    }
+
+
+    /* The skip list follows the index block data */
+    pucSkipListPtr = pucIndexBlock + uiIndexBlockHeaderLength + uiIndexBlockDataLength;
+
+    /* Read the skip list entry count */
+    UTL_NUM_READ_COMPRESSED_UINT(uiSkipEntryCount, pucSkipListPtr);
+
+
+    /* Allocate the search posting blocks, one per skip list entry and one for the last run */
+    if ( (pspbSrchPostingBlocks = (struct srchPostingBlock *)s_malloc((size_t)((uiSkipEntryCount + 1) * sizeof(struct srchPostingBlock)))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+
+    /* Loop over the skip list entries, each one closes a run */
+    for ( pspbSrchPostingBlocksPtr = pspbSrchPostingBlocks; uiSkipEntryCount > 0; uiSkipEntryCount--, pspbSrchPostingBlocksPtr++ ) {
+
+        /* Read the skip list entry */
+        UTL_NUM_READ_COMPRESSED_UINT(uiSkipEntryDeltaDocumentID, pucSkipListPtr);
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucSkipListPtr);
+        if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_POSITION_STREAM ) {
+            UTL_NUM_SKIP_COMPRESSED_UINT(pucSkipListPtr);
+        }
+        UTL_NUM_READ_COMPRESSED_UINT(uiMaximumDocumentPostingsCount, pucSkipListPtr);
+
+        /* Set the search posting block */
+        uiSkipEntryDocumentID += uiSkipEntryDeltaDocumentID;
+        pspbSrchPostingBlocksPtr->uiDocumentID = uiSkipEntryDocumentID;
+        pspbSrchPostingBlocksPtr->fMaxWeight = uiMaximumDocumentPostingsCount * fTermWeight;
+    }
+
+
+    /* Read the maximum for the last run, which ends with the last document */
+    UTL_NUM_READ_COMPRESSED_UINT(uiMaximumDocumentPostingsCount, pucSkipListPtr);
+    pspbSrchPostingBlocksPtr->uiDocumentID = UINT_MAX;
+    pspbSrchPostingBlocksPtr->fMaxWeight = uiMaximumDocumentPostingsCount * fTermWeight;
+    pspbSrchPostingBlocksPtr++;
+
+    ASSERT(pucSkipListPtr <= (pucIndexBlock + uiIndexBlockLength));
+
+
+    /* Hand over the search posting blocks */
+    psplSrchPostingsList->pspbSrchPostingBlocks = pspbSrchPostingBlocks;
+    psplSrchPostingsList->uiSrchPostingBlocksLength = pspbSrchPostingBlocksPtr - pspbSrchPostingBlocks;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermSearchReadIndexFrameHeader()
+
+    Purpose:    This function reads the header of a frame of bit packed index 
+                block data, leaving the index block data pointer at the start
+                of the frame data. The frame data can be skipped by moving the
+                index block data pointer along by the frame data length.
+
+    Parameters: psiSrchIndex                        index structure
+                ppucIndexBlockPtr                   pointer to the index block data pointer (updated)
+                puiFrameEntriesCount                return pointer for the frame entries count (optional)
+                puiFrameDeltaDocumentID             return pointer for the delta of the last document ID in the frame (optional)
+                puiMaximumDocumentPostingsCount     return pointer for the maximum number of postings per document in the frame (optional)
+                puiBitWidths                        return array for the bit widths (optional)
+                puiFrameDataLength                  return pointer for the frame data length (optional)
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermSearchReadIndexFrameHeader
+(
+    struct srchIndex *psiSrchIndex,
+    unsigned char **ppucIndexBlockPtr,
+    unsigned int *puiFrameEntriesCount,
+    unsigned int *puiFrameDeltaDocumentID,
+    unsigned int *puiMaximumDocumentPostingsCount,
+    unsigned int *puiBitWidths,
+    unsigned int *puiFrameDataLength
+)
+{
+
+    unsigned char   *pucIndexBlockPtr = NULL;
+    unsigned int    uiFrameEntriesCount = 0;
+    unsigned int    uiFrameDeltaDocumentID = 0;
+    unsigned int    uiMaximumDocumentPostingsCount = 0;
+    unsigned int    uiBitWidth = 0;
+    unsigned int    uiFrameDataLength = 0;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(psiSrchIndex != NULL);
+    ASSERT(psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BIT_PACKED);
+    ASSERT((ppucIndexBlockPtr != NULL) && (*ppucIndexBlockPtr != NULL));
+
+
+    /* Read the frame entries count and the delta of the last document ID */
+    pucIndexBlockPtr = *ppucIndexBlockPtr;
+    UTL_NUM_READ_COMPRESSED_UINT(uiFrameEntriesCount, pucIndexBlockPtr);
+    UTL_NUM_READ_COMPRESSED_UINT(uiFrameDeltaDocumentID, pucIndexBlockPtr);
+
+    /* Read the maximum number of postings per document if there is one */
+    if ( psiSrchIndex->uiIndexBlockFeatures & SRCH_INDEX_BLOCK_FEATURE_BLOCK_MAX ) {
+        UTL_NUM_READ_COMPRESSED_UINT(uiMaximumDocumentPostingsCount, pucIndexBlockPtr);
+    }
+
+    /* Check the frame entries count, we need to be able to unpack the frame in one go */
+    if ( (uiFrameEntriesCount == 0) || (uiFrameEntriesCount > SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid index block frame entries count: %u, index: '%s'.", uiFrameEntriesCount, psiSrchIndex->pucIndexName);
+        return (SRCH_TermSearchInvalidIndexBlock);
+    }
+
+    /* Read the bit widths, adding up the frame data length as we go */
+    for ( uiI = 0; uiI < SRCH_TERMSRCH_INDEX_ENTRY_LENGTH; uiI++ ) {
+
+        UTL_NUM_READ_UINT(uiBitWidth, SRCH_TERMSRCH_FRAME_BIT_WIDTH_SIZE, pucIndexBlockPtr);
+
+        if ( uiBitWidth > UTL_NUM_BIT_PACKED_UINT_MAX_WIDTH ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Invalid index block frame bit width: %u, index: '%s'.", uiBitWidth, psiSrchIndex->pucIndexName);
+            return (SRCH_TermSearchInvalidIndexBlock);
+        }
+
+        if ( puiBitWidths != NULL ) {
+            puiBitWidths[uiI] = uiBitWidth;
+        }
+
+        uiFrameDataLength += UTL_NUM_GET_BIT_PACKED_UINT_ARRAY_SIZE(uiFrameEntriesCount, uiBitWidth);
+    }
+
+
+    /* Set the return pointers */
+    *ppucIndexBlockPtr = pucIndexBlockPtr;
+
+    if ( puiFrameEntriesCount != NULL ) {
+        *puiFrameEntriesCount = uiFrameEntriesCount;
+    }
+
+    if ( puiFrameDeltaDocumentID != NULL ) {
+        *puiFrameDeltaDocumentID = uiFrameDeltaDocumentID;
+    }
+
+    if ( puiMaximumDocumentPostingsCount != NULL ) {
+        *puiMaximumDocumentPostingsCount = uiMaximumDocumentPostingsCount;
+    }
+
+    if ( puiFrameDataLength != NULL ) {
+        *puiFrameDataLength = uiFrameDataLength;
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermSearchAddSparseWeight()
+
+    Purpose:    This function cumulates a weight into a sparse search weight 
+                structure, document IDs need to be added in increasing order.
+                The arrays are grown if they are full, which only happens if 
+                the term document count is off.
+
+    Parameters: pswSrchWeight               sparse search weight structure
+                puiDocumentIDsCapacity      pointer to the capacity of the sparse arrays (updated)
+                uiDocumentID                document ID
+                fWeight                     weight
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermSearchAddSparseWeight
+(
+    struct srchWeight *pswSrchWeight,
+    unsigned int *puiDocumentIDsCapacity,
+    unsigned int uiDocumentID,
+    float fWeight
+)
+{
+
+    ASSERT(pswSrchWeight != NULL);
+    ASSERT(pswSrchWeight->bSparseFlag == true);
+    ASSERT(puiDocumentIDsCapacity != NULL);
+    ASSERT(uiDocumentID < pswSrchWeight->uiWeightsLength);
+
+
+    /* Cumulate into the last entry if this is the same document */
+    if ( (pswSrchWeight->uiDocumentIDsLength > 0) && (pswSrchWeight->puiDocumentIDs[pswSrchWeight->uiDocumentIDsLength - 1] == uiDocumentID) ) {
+        pswSrchWeight->pfWeights[pswSrchWeight->uiDocumentIDsLength - 1] += fWeight;
+        return (SRCH_NoError);
+    }
+
+
+    /* Grow the arrays if they are full */
+    if ( pswSrchWeight->uiDocumentIDsLength == *puiDocumentIDsCapacity ) {
+
+        unsigned int    uiDocumentIDsCapacity = *puiDocumentIDsCapacity * 2;
+        unsigned int    *puiDocumentIDs = NULL;
+        float           *pfWeights = NULL;
+
+        if ( (puiDocumentIDs = (unsigned int *)s_realloc(pswSrchWeight->puiDocumentIDs, (size_t)(uiDocumentIDsCapacity * sizeof(unsigned int)))) == NULL ) {
+            return (SRCH_MemError);
+        }
+        pswSrchWeight->puiDocumentIDs = puiDocumentIDs;
+
+        if ( (pfWeights = (float *)s_realloc(pswSrchWeight->pfWeights, (size_t)(uiDocumentIDsCapacity * sizeof(float)))) == NULL ) {
+            return (SRCH_MemError);
+        }
+        pswSrchWeight->pfWeights = pfWeights;
+
+        *puiDocumentIDsCapacity = uiDocumentIDsCapacity;
+    }
+
+
+    /* Add the entry */
+    pswSrchWeight->puiDocumentIDs[pswSrchWeight->uiDocumentIDsLength] = uiDocumentID;
+    pswSrchWeight->pfWeights[pswSrchWeight->uiDocumentIDsLength] = fWeight;
+    pswSrchWeight->uiDocumentIDsLength++;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchTermSearchDecodeSrchPostingsFromDecoder()
+
+    Purpose:    This function decodes search postings from the decoder of a search 
+                postings list and adds them after the search postings it holds, 
+                decoding stops on the first document boundary after the minimum
+                number of search postings have been decoded. The search postings 
+                array is grown as needed.
+
+                The decoder is released once the index block has all been decoded.
+
+    Parameters: psplSrchPostingsList    search postings list structure
+                uiSrchPostingsMinimum   minimum number of search postings to decode
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchTermSearchDecodeSrchPostingsFromDecoder
+(
+    struct srchPostingsList *psplSrchPostingsList,
+    unsigned int uiSrchPostingsMinimum
+)
+{
+
+    struct srchTermSearchDecoder    *pstdSrchTermSearchDecoder = NULL;
+    struct srchPosting              *pspSrchPostingsPtr = NULL;
+    struct srchPosting              *pspSrchPostingsStartPtr = NULL;
+    unsigned char                   **ppucTermPositionsPtr = NULL;
+    unsigned int                    uiIndexEntryDeltaDocumentID = 0;
+    unsigned int                    uiIndexEntryDeltaTermPosition = 0;
+    unsigned int                    uiSrchPostingsStartIndex = 0;
+
+
+    ASSERT(psplSrchPostingsList != NULL);
+    ASSERT(psplSrchPostingsList->pvSrchTermSearchDecoder != NULL);
+
+
+    pstdSrchTermSearchDecoder = (struct srchTermSearchDecoder *)psplSrchPostingsList->pvSrchTermSearchDecoder;
+
+    /* Only decode the term positions if they were requested */
+    ppucTermPositionsPtr = (pstdSrchTermSearchDecoder->bDecodeTermPositions == true) ? &pstdSrchTermSearchDecoder->pucTermPositionsPtr : NULL;
+
+    /* Search postings get added after the ones already in the search postings list */
+    uiSrchPostingsStartIndex = psplSrchPostingsList->uiSrchPostingsLength;
+
+
+    /* Loop over the entries in the index block */
+    for ( pspSrchPostingsPtr = psplSrchPostingsList->pspSrchPostings + uiSrchPostingsStartIndex;
+            (pstdSrchTermSearchDecoder->puiIndexEntriesPtr < pstdSrchTermSearchDecoder->puiIndexEntriesEnd) || 
+            (pstdSrchTermSearchDecoder->pucIndexBlockPtr < pstdSrchTermSearchDecoder->pucIndexBlockEndPtr); ) {
+
+        /* Read the index block */
+        SRCH_TERMSRCH_DECODE_INDEX_ENTRIES(pstdSrchTermSearchDecoder->psiSrchIndex, pstdSrchTermSearchDecoder->pucIndexBlockPtr, pstdSrchTermSearchDecoder->pucIndexBlockEndPtr, 
+                ppucTermPositionsPtr, pstdSrchTermSearchDecoder->puiIndexEntries, pstdSrchTermSearchDecoder->puiIndexEntriesPtr, pstdSrchTermSearchDecoder->puiIndexEntriesEnd);
+
+        /* Break out if nothing was decoded */
+        if ( pstdSrchTermSearchDecoder->puiIndexEntriesPtr >= pstdSrchTermSearchDecoder->puiIndexEntriesEnd ) {
+            break;
+        }
+
+        uiIndexEntryDeltaDocumentID = pstdSrchTermSearchDecoder->puiIndexEntriesPtr[0];
+        uiIndexEntryDeltaTermPosition = pstdSrchTermSearchDecoder->puiIndexEntriesPtr[1];
+
+        /* Break out on the document boundary once there are enough search postings, leaving this index entry to be read next time */
+        if ( (uiIndexEntryDeltaDocumentID != 0) && 
+                ((unsigned int)(pspSrchPostingsPtr - (psplSrchPostingsList->pspSrchPostings + uiSrchPostingsStartIndex)) >= uiSrchPostingsMinimum) ) {
+            break;
+        }
+
+        pstdSrchTermSearchDecoder->puiIndexEntriesPtr += SRCH_TERMSRCH_INDEX_ENTRY_LENGTH;
+
+        ASSERT(uiIndexEntryDeltaDocumentID >= 0);
+        ASSERT(uiIndexEntryDeltaTermPosition >= 0);
+
+
+        /* Grow the search postings array if it is full */
+        if ( pspSrchPostingsPtr == (psplSrchPostingsList->pspSrchPostings + pstdSrchTermSearchDecoder->uiSrchPostingsCapacity) ) {
+
+            unsigned int    uiSrchPostingsCapacity = UTL_MACROS_MAX(pstdSrchTermSearchDecoder->uiSrchPostingsCapacity * 2, SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH);
+
+            if ( (pspSrchPostingsStartPtr = (struct srchPosting *)s_realloc(psplSrchPostingsList->pspSrchPostings, 
+                    (size_t)(uiSrchPostingsCapacity * sizeof(struct srchPosting)))) == NULL ) {
+                return (SRCH_MemError);
+            }
+
+            pspSrchPostingsPtr = pspSrchPostingsStartPtr + (pspSrchPostingsPtr - psplSrchPostingsList->pspSrchPostings);
+            psplSrchPostingsList->pspSrchPostings = pspSrchPostingsStartPtr;
+            pstdSrchTermSearchDecoder->uiSrchPostingsCapacity = uiSrchPostingsCapacity;
+        }
+
+
+        /* Set the document ID */
+        pstdSrchTermSearchDecoder->uiIndexEntryDocumentID += uiIndexEntryDeltaDocumentID;
+
+        /* Move on to the impact of this document and reset the term position if this is a new document */
+        if ( uiIndexEntryDeltaDocumentID != 0 ) {
+            pstdSrchTermSearchDecoder->uiImpactsIndex++;
+            pstdSrchTermSearchDecoder->uiIndexEntryTermPosition = 0;
+        }
+
+        /* Set the term position */
+        pstdSrchTermSearchDecoder->uiIndexEntryTermPosition += uiIndexEntryDeltaTermPosition;
+
+        /* Set the posting information */
+        pspSrchPostingsPtr->uiDocumentID = pstdSrchTermSearchDecoder->uiIndexEntryDocumentID;
+        pspSrchPostingsPtr->uiTermPosition = pstdSrchTermSearchDecoder->uiIndexEntryTermPosition;
+        pspSrchPostingsPtr->fWeight = (pstdSrchTermSearchDecoder->pucImpacts != NULL) ? 
+                pstdSrchTermSearchDecoder->pucImpacts[pstdSrchTermSearchDecoder->uiImpactsIndex - 1] * pstdSrchTermSearchDecoder->fTermWeight : 
+                pstdSrchTermSearchDecoder->fTermWeight;
+
+        /* Increment the postings pointer */
+        pspSrchPostingsPtr++;
+    }
+
+
+    /* Set the postings length */
+    psplSrchPostingsList->uiSrchPostingsLength = pspSrchPostingsPtr - psplSrchPostingsList->pspSrchPostings;
+
+    /* Spread the impact of each document over its postings, the search postings decoded end on a document boundary */
+    if ( pstdSrchTermSearchDecoder->pucImpacts != NULL ) {
+        vSrchTermSearchSpreadImpacts(psplSrchPostingsList->pspSrchPostings + uiSrchPostingsStartIndex, 
+                psplSrchPostingsList->uiSrchPostingsLength - uiSrchPostingsStartIndex);
+    }
+
+    /* Release the decoder if the index block has all been decoded */
+    if ( (pstdSrchTermSearchDecoder->puiIndexEntriesPtr >= pstdSrchTermSearchDecoder->puiIndexEntriesEnd) && 
+            (pstdSrchTermSearchDecoder->pucIndexBlockPtr >= pstdSrchTermSearchDecoder->pucIndexBlockEndPtr) ) {
+        iSrchTermSearchFreeDecoder(psplSrchPostingsList->pvSrchTermSearchDecoder);
+        psplSrchPostingsList->pvSrchTermSearchDecoder = NULL;
+    }
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vSrchTermSearchSpreadImpacts()
+
+    Purpose:    This function spreads the impact of each document evenly over 
+                the postings of that document. Each posting comes in with the 
+                full impact of its document, so each run of postings with the 
+                same document ID is divided by the length of that run, which
+                lets the weights of a document add back up to its impact.
+
+    Parameters: pspSrchPostings         search postings, in document ID order
+                uiSrchPostingsLength    search postings length
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vSrchTermSearchSpreadImpacts
+(
+    struct srchPosting *pspSrchPostings,
+    unsigned int uiSrchPostingsLength
+)
+{
+
+    struct srchPosting  *pspSrchPostingsPtr = NULL;
+    struct srchPosting  *pspSrchPostingsEnd = NULL;
+    struct srchPosting  *pspSrchPostingsRunPtr = NULL;
+    float               fRunLength = 0;
+
+
+    ASSERT(((pspSrchPostings != NULL) && (uiSrchPostingsLength > 0)) || ((pspSrchPostings == NULL) && (uiSrchPostingsLength == 0)));
+
+
+    /* Loop over each run of postings with the same document ID */
+    for ( pspSrchPostingsPtr = pspSrchPostings, pspSrchPostingsEnd = pspSrchPostings + uiSrchPostingsLength; pspSrchPostingsPtr < pspSrchPostingsEnd; ) {
+
+        /* Find the end of the run */
+        for ( pspSrchPostingsRunPtr = pspSrchPostingsPtr + 1; 
+                (pspSrchPostingsRunPtr < pspSrchPostingsEnd) && (pspSrchPostingsRunPtr->uiDocumentID == pspSrchPostingsPtr->uiDocumentID); pspSrchPostingsRunPtr++ ) {
+            ;
+        }
+
+        /* Divide the weights in the run by the run length, nothing to do if this is a single posting */
+        if ( (fRunLength = (float)(pspSrchPostingsRunPtr - pspSrchPostingsPtr)) > 1 ) {
+            for ( ; pspSrchPostingsPtr < pspSrchPostingsRunPtr; pspSrchPostingsPtr++ ) {
+                pspSrchPostingsPtr->fWeight /= fRunLength;
+            }
+        }
+
+        /* Move on to the next run */
+        pspSrchPostingsPtr = pspSrchPostingsRunPtr;
+    }
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
@@ -52,6 +52,22 @@ extern "C" {
 /*---------------------------------------------------------------------------*/
 
 
+/*
+** Defines
+*/
+
+/* Number of uints in a decoded index entry (document ID delta, term position delta and field ID) */
+#define SRCH_TERMSRCH_INDEX_ENTRY_LENGTH                (3)
+
+/* Number of index entries decoded from the index block at a time, this needs 
+** to be big enough for a frame of bit packed index block data
+*/
+#define SRCH_TERMSRCH_INDEX_ENTRIES_LENGTH              (SRCH_INDEX_BLOCK_FRAME_LENGTH)
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 ** Public function prototypes
 */
@@ -59,8 +75,16 @@ extern "C" {
 int iSrchTermSearchGetSearchPostingsListFromTerm (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex, 
         unsigned char *pucTerm, float fWeight, unsigned char *pucFieldIDBitmap, unsigned int uiFieldIDBitmapLength,
         float fFrequentTermCoverageThreshold, unsigned int uiStartDocumentID, unsigned int uiEndDocumentID,
+        boolean bTermPositions, boolean bDocumentContainers, boolean bDecodeOnDemand, 
         struct srchPostingsList **ppsplSrchPostingsList);
 
+int iSrchTermSearchDecodeNextSrchPostings (struct srchPostingsList *psplSrchPostingsList, 
+        unsigned int uiDocumentID);
+
+int iSrchTermSearchDecodeSrchPostings (struct srchPostingsList *psplSrchPostingsList);
+
+int iSrchTermSearchFreeDecoder (void *pvSrchTermSearchDecoder);
+
 int iSrchTermSearchGetSearchWeightsFromTerm (struct srchSearch *pssSrchSearch, struct srchIndex *psiSrchIndex, 
         unsigned char *pucTerm, float fWeight, unsigned char *pucFieldIDBitmap, unsigned int uiFieldIDBitmapLength,
         float fFrequentTermCoverageThreshold, unsigned int uiStartDocumentID, unsigned int uiEndDocumentID,
@@ -72,6 +96,20 @@ int iSrchTermSearchGetSearchBitmapFromTerm (struct srchSearch *pssSrchSearch, st
         struct srchBitmap **ppsbSrchBitmap);
 
 
+int iSrchTermSearchGetIndexBlockHeader (struct srchIndex *psiSrchIndex, unsigned char *pucIndexBlock, 
+        unsigned int uiIndexBlockLength, unsigned int *puiIndexBlockHeaderLength, unsigned int *puiIndexBlockDataLength,
+        unsigned int *puiDocumentContainersLength, unsigned char **ppucImpacts, unsigned int *puiImpactsLength, 
+        float *pfImpactsScale);
+
+int iSrchTermSearchGetIndexBlockStreams (struct srchIndex *psiSrchIndex, unsigned char *pucIndexBlockData, 
+        unsigned int uiIndexBlockDataLength, unsigned char **ppucIndexBlockPtr, unsigned char **ppucIndexBlockEndPtr,
+        unsigned char **ppucTermPositionsPtr);
+
+int iSrchTermSearchDecodeIndexEntries (struct srchIndex *psiSrchIndex, unsigned char **ppucIndexBlockPtr, 
+        unsigned char *pucIndexBlockEndPtr, unsigned char **ppucTermPositionsPtr, unsigned int *puiIndexEntries, 
+        unsigned int *puiIndexEntriesLength);
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -58,10 +58,11 @@
 
     Purpose:    Initialize the index version.
 
-    Parameters: psiSrchIndex        Search index structure
-                uiMajorVersion      major version
-                uiMinorVersion      minor version
-                uiPatchVersion      patch version
+    Parameters: psiSrchIndex            Search index structure
+                uiMajorVersion          major version
+                uiMinorVersion          minor version
+                uiPatchVersion          patch version
+                uiIndexBlockFeatures    index block features
 
     Globals:    none
 
@@ -73,7 +74,8 @@ int iSrchVersionInit
     struct srchIndex *psiSrchIndex,
     unsigned int uiMajorVersion,
     unsigned int uiMinorVersion, 
-    unsigned int uiPatchVersion
+    unsigned int uiPatchVersion,
+    unsigned int uiIndexBlockFeatures
 )
 {
 
@@ -89,6 +91,7 @@ int iSrchVersionInit
     psiSrchIndex->uiMajorVersion = uiMajorVersion;
     psiSrchIndex->uiMinorVersion = uiMinorVersion;
     psiSrchIndex->uiPatchVersion = uiPatchVersion;
+    psiSrchIndex->uiIndexBlockFeatures = uiIndexBlockFeatures;
         
 
     return (SRCH_NoError);
@@ -122,6 +125,7 @@ int iSrchVersionInitFromInfo
     unsigned int    uiMajorVersion = 0;
     unsigned int    uiMinorVersion = 0;
     unsigned int    uiPatchVersion = 0;
+    unsigned int    uiIndexBlockFeatures = SRCH_INDEX_BLOCK_FEATURE_NONE;
 
 
     /* Check the parameters */
@@ -133,7 +137,7 @@ int iSrchVersionInitFromInfo
 
 
     /* Get the version information from the information file */
-    if ( (iError = iSrchInfoGetVersionInfo(psiSrchIndex, &uiMajorVersion, &uiMinorVersion, &uiPatchVersion)) != SRCH_NoError ) {
+    if ( (iError = iSrchInfoGetVersionInfo(psiSrchIndex, &uiMajorVersion, &uiMinorVersion, &uiPatchVersion, &uiIndexBlockFeatures)) != SRCH_NoError ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to get the version from the information file, index: '%s', srch error: %d.", 
                 psiSrchIndex->pucIndexName, iError); 
         return (SRCH_InvalidIndex);
@@ -152,6 +156,7 @@ int iSrchVersionInitFromInfo
     psiSrchIndex->uiMajorVersion = uiMajorVersion;
     psiSrchIndex->uiMinorVersion = uiMinorVersion;
     psiSrchIndex->uiPatchVersion = uiPatchVersion;
+    psiSrchIndex->uiIndexBlockFeatures = uiIndexBlockFeatures;
         
 
     return (SRCH_NoError);
@@ -60,7 +60,8 @@ extern "C" {
 */
 
 int iSrchVersionInit (struct srchIndex *psiSrchIndex, unsigned int uiMajorVersion,
-        unsigned int uiMinorVersion, unsigned int uiPatchVersion);
+        unsigned int uiMinorVersion, unsigned int uiPatchVersion, 
+        unsigned int uiIndexBlockFeatures);
 
 int iSrchVersionInitFromInfo (struct srchIndex *psiSrchIndex);
 
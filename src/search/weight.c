@@ -50,6 +50,24 @@
 /* #define SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING */
 
 
+/* Enable SSE for merging weights arrays if the compiler targets it */
+#if defined(__SSE__)
+#define SRCH_WEIGHT_ENABLE_SSE
+#endif    /* defined(__SSE__) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#if defined(SRCH_WEIGHT_ENABLE_SSE)
+#include <xmmintrin.h>
+#endif    /* defined(SRCH_WEIGHT_ENABLE_SSE) */
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -63,6 +81,55 @@
 #endif /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
 
 
+/* Merge types */
+#define SRCH_WEIGHT_MERGE_TYPE_INVALID                  (0)
+#define SRCH_WEIGHT_MERGE_TYPE_XOR                      (1)
+#define SRCH_WEIGHT_MERGE_TYPE_OR                       (2)
+#define SRCH_WEIGHT_MERGE_TYPE_AND                      (3)
+#define SRCH_WEIGHT_MERGE_TYPE_NOT                      (4)
+
+#define SRCH_WEIGHT_MERGE_TYPE_VALID(n)                 (((n) >= SRCH_WEIGHT_MERGE_TYPE_XOR) && \
+                                                                ((n) <= SRCH_WEIGHT_MERGE_TYPE_NOT))
+
+
+/* Macros to merge two weights */
+#if defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING)
+#define SRCH_WEIGHT_MERGE_XOR(f1, f2)                   (((f1) > 0) ? ((f1) + ((f2) * SRCH_WEIGHT_TERM_WEIGHT_CO_OCCURRENCE)) : 0)
+#define SRCH_WEIGHT_MERGE_OR(f1, f2)                    (((f1) > 0) ? (((f1) + (f2)) * SRCH_WEIGHT_TERM_WEIGHT_CO_OCCURRENCE) : ((f1) + (f2)))
+#define SRCH_WEIGHT_MERGE_AND(f1, f2)                   ((((f1) > 0) && ((f2) > 0)) ? (((f1) + (f2)) * SRCH_WEIGHT_TERM_WEIGHT_CO_OCCURRENCE) : 0)
+#else
+#define SRCH_WEIGHT_MERGE_XOR(f1, f2)                   (((f1) > 0) ? ((f1) + (f2)) : 0)
+#define SRCH_WEIGHT_MERGE_OR(f1, f2)                    ((f1) + (f2))
+#define SRCH_WEIGHT_MERGE_AND(f1, f2)                   ((((f1) > 0) && ((f2) > 0)) ? ((f1) + (f2)) : 0)
+#endif /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
+#define SRCH_WEIGHT_MERGE_NOT(f1, f2)                   (((f2) > 0) ? 0 : (f1))
+
+#define SRCH_WEIGHT_MERGE_WEIGHTS(n, f1, f2)            (((n) == SRCH_WEIGHT_MERGE_TYPE_XOR) ? SRCH_WEIGHT_MERGE_XOR((f1), (f2)) : \
+                                                                ((n) == SRCH_WEIGHT_MERGE_TYPE_OR) ? SRCH_WEIGHT_MERGE_OR((f1), (f2)) : \
+                                                                ((n) == SRCH_WEIGHT_MERGE_TYPE_AND) ? SRCH_WEIGHT_MERGE_AND((f1), (f2)) : \
+                                                                SRCH_WEIGHT_MERGE_NOT((f1), (f2)))
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Private function prototypes
+*/
+
+static int iSrchWeightMerge (struct srchWeight *pswSrchWeight1, struct srchWeight *pswSrchWeight2,
+        unsigned int uiMergeType, struct srchWeight **ppswSrchWeight);
+
+static int iSrchWeightMergeSparseWeights (struct srchWeight *pswSrchWeight1, struct srchWeight *pswSrchWeight2,
+        unsigned int uiMergeType, struct srchWeight **ppswSrchWeight);
+
+static int iSrchWeightFilterSparseWeights (struct srchWeight *pswSrchWeightSparse, struct srchWeight *pswSrchWeightDense,
+        boolean bSparseFirst, unsigned int uiMergeType, struct srchWeight **ppswSrchWeight);
+
+static void vSrchWeightMergeWeights (float *pfWeights1, float *pfWeights2, unsigned int uiMergeType,
+        float *pfWeights, unsigned int uiWeightsLength);
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -140,6 +207,77 @@ int iSrchWeightCreate
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchWeightCreateSparse()
+
+    Purpose:    This function creates a sparse search weight structure, with
+                room for uiDocumentIDsLength document ID/weight pairs which
+                the caller adds in document ID order, setting uiDocumentIDsLength
+                as it goes.
+
+    Parameters: uiWeightsLength         weights length
+                uiDocumentIDsLength     number of document IDs to allocate
+                ppswSrchWeight          search weights structure return pointer
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchWeightCreateSparse
+(
+    unsigned int uiWeightsLength,
+    unsigned int uiDocumentIDsLength,
+    struct srchWeight **ppswSrchWeight
+)
+{
+
+    struct srchWeight   *pswSrchWeight = NULL;
+
+
+    /* Check the parameters */
+    if ( ppswSrchWeight == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppswSrchWeight' parameter passed to 'iSrchWeightCreateSparse'."); 
+        return (SPI_ReturnParameterError);
+    }
+
+
+    /* Allocate the search weights structure */
+    if ( (pswSrchWeight = (struct srchWeight *)s_malloc(sizeof(struct srchWeight))) == NULL ) {
+        return (SRCH_MemError);
+    }
+
+    pswSrchWeight->uiWeightsLength = uiWeightsLength;
+    pswSrchWeight->bMappedAllocationFlag = false;
+    pswSrchWeight->bSparseFlag = true;
+    pswSrchWeight->uiDocumentIDsLength = 0;
+
+    /* Allocate the document IDs and weights arrays, we always allocate at least one entry */
+    if ( (pswSrchWeight->puiDocumentIDs = (unsigned int *)s_malloc((size_t)(UTL_MACROS_MAX(uiDocumentIDsLength, 1) * sizeof(unsigned int)))) == NULL ) {
+        s_free(pswSrchWeight);
+        return (SRCH_MemError);
+    }
+
+    if ( (pswSrchWeight->pfWeights = (float *)s_malloc((size_t)(UTL_MACROS_MAX(uiDocumentIDsLength, 1) * sizeof(float)))) == NULL ) {
+        s_free(pswSrchWeight->puiDocumentIDs);
+        s_free(pswSrchWeight);
+        return (SRCH_MemError);
+    }
+
+
+    /* Set the return pointer */
+    *ppswSrchWeight = pswSrchWeight;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchWeightFree()
@@ -173,6 +311,8 @@ int iSrchWeightFree
             }
         }
 
+        s_free(pswSrchWeight->puiDocumentIDs);
+
         s_free(pswSrchWeight);
     }
 
@@ -187,117 +327,147 @@ int iSrchWeightFree
 
 /*
 
-    Function:   iSrchWeightMergeXOR()
+    Function:   iSrchWeightExpandSparse()
 
-    Purpose:    This function XORs pswSrchWeight1 and pswSrchWeight2
-                and return a pointer to the new search weight structure.
-                It disposes of the two passed search weight structures 
-                except if an error occurs.
+    Purpose:    This function expands a sparse search weight structure
+                into a weights array indexed by document ID, it does
+                nothing if the search weight structure is not sparse.
 
-    Parameters: pswSrchWeight1      search weight structure
-                pswSrchWeight2      search weight structure
-                ppswSrchWeight      return pointer for the new search weight structure
+    Parameters: pswSrchWeight   search weight structure
 
     Globals:    none
 
     Returns:    SRCH error code
 
 */
-int iSrchWeightMergeXOR
+int iSrchWeightExpandSparse
 (
-    struct srchWeight *pswSrchWeight1,
-    struct srchWeight *pswSrchWeight2,
-    struct srchWeight **ppswSrchWeight
+    struct srchWeight *pswSrchWeight
 )
 {
-    
-    int                 iError = SRCH_NoError;
 
-    struct srchWeight   *pswSrchWeight = NULL;
-
-    float               *pfWeightsPtr = NULL;
-    float               *pfWeights1Ptr = NULL;
-    float               *pfWeights2Ptr = NULL;
-    float               *pfWeightsEnd = NULL;
+    float           *pfWeights = NULL;
+    unsigned int    uiI = 0;
 
 
     /* Check the parameters */
-    if ( pswSrchWeight1 == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1' parameter passed to 'iSrchWeightMergeXOR'."); 
+    if ( pswSrchWeight == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight' parameter passed to 'iSrchWeightExpandSparse'.");
         return (SRCH_WeightInvalidWeight);
     }
 
-    if ( pswSrchWeight2 == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2' parameter passed to 'iSrchWeightMergeXOR'."); 
-        return (SRCH_WeightInvalidWeight);
+
+    /* Nothing to do if the search weight structure is not sparse */
+    if ( pswSrchWeight->bSparseFlag == false ) {
+        return (SRCH_NoError);
     }
 
 
-    if ( pswSrchWeight1->pfWeights == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1->pfWeights' parameter passed to 'iSrchWeightMergeXOR'."); 
-        return (SRCH_WeightInvalidWeight);
+    /* Allocate the weights array */
+    if ( (pfWeights = (float *)s_malloc((size_t)(pswSrchWeight->uiWeightsLength * sizeof(float)))) == NULL ) {
+        return (SRCH_MemError);
     }
 
-    if ( pswSrchWeight2->pfWeights == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2->pfWeights' parameter passed to 'iSrchWeightMergeXOR'."); 
-        return (SRCH_WeightInvalidWeight);
+    /* Scatter the sparse weights into the weights array */
+    for ( uiI = 0; uiI < pswSrchWeight->uiDocumentIDsLength; uiI++ ) {
+        ASSERT(pswSrchWeight->puiDocumentIDs[uiI] < pswSrchWeight->uiWeightsLength);
+        pfWeights[pswSrchWeight->puiDocumentIDs[uiI]] = pswSrchWeight->pfWeights[uiI];
     }
 
-    if ( pswSrchWeight1->uiWeightsLength != pswSrchWeight2->uiWeightsLength ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Unequal 'pswSrchWeight1->uiWeightsLength' & 'pswSrchWeight2->uiWeightsLength' parameters passed to 'iSrchWeightMergeXOR'."); 
-        return (SRCH_WeightInvalidWeight);
-    }
 
-    
-    /* Reuse one or the other search weight structure if we can, otherwise we allocate a new one */
-    if ( pswSrchWeight1->bMappedAllocationFlag == false ) {
-        pswSrchWeight = pswSrchWeight1;
-    }
-    else if ( pswSrchWeight2->bMappedAllocationFlag == false ) {
-        pswSrchWeight = pswSrchWeight2;
-    }
-    else {
+    /* Swap in the weights array */
+    s_free(pswSrchWeight->pfWeights);
+    s_free(pswSrchWeight->puiDocumentIDs);
+    pswSrchWeight->pfWeights = pfWeights;
+    pswSrchWeight->uiDocumentIDsLength = 0;
+    pswSrchWeight->bSparseFlag = false;
 
-        /* Allocate a new search weights structure */
-        if ( (iError = iSrchWeightCreate(NULL, pswSrchWeight1->uiWeightsLength, false, &pswSrchWeight)) != SRCH_NoError ) {
-            return (iError);
-        }
-    }
 
+    return (SRCH_NoError);
 
-    /* XOR the two search weight arrays */
-    for ( pfWeightsPtr = pswSrchWeight->pfWeights, pfWeights1Ptr = pswSrchWeight1->pfWeights, pfWeights2Ptr = pswSrchWeight2->pfWeights, 
-            pfWeightsEnd = (pswSrchWeight->pfWeights + pswSrchWeight->uiWeightsLength); pfWeightsPtr < pfWeightsEnd; pfWeightsPtr++, pfWeights1Ptr++, pfWeights2Ptr++ ) {
+}
 
-#if defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING)
 
-        *pfWeightsPtr = (*pfWeights1Ptr > 0) ? (*pfWeights1Ptr + (*pfWeights2Ptr * SRCH_WEIGHT_TERM_WEIGHT_CO_OCCURRENCE)) : 0;
+/*---------------------------------------------------------------------------*/
 
-#else
 
-        *pfWeightsPtr = (*pfWeights1Ptr > 0) ? (*pfWeights1Ptr + *pfWeights2Ptr) : 0;
+/*
 
-#endif /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
+    Function:   iSrchWeightGetDocumentCount()
+
+    Purpose:    This function returns the number of documents with a
+                weight greater than zero in the search weight structure.
+
+    Parameters: pswSrchWeight       search weight structure
+                puiDocumentCount    return pointer for the document count
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchWeightGetDocumentCount
+(
+    struct srchWeight *pswSrchWeight,
+    unsigned int *puiDocumentCount
+)
+{
+
+    float           *pfWeightsPtr = NULL;
+    float           *pfWeightsEnd = NULL;
+    unsigned int    uiDocumentCount = 0;
 
+
+    /* Check the parameters */
+    if ( pswSrchWeight == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight' parameter passed to 'iSrchWeightGetDocumentCount'.");
+        return (SRCH_WeightInvalidWeight);
     }
 
-    
-    /* Free the search weight structures */
-    if ( pswSrchWeight != pswSrchWeight1 ) {
-        iSrchWeightFree(pswSrchWeight1);
-        pswSrchWeight1 = NULL;
+    if ( puiDocumentCount == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiDocumentCount' parameter passed to 'iSrchWeightGetDocumentCount'.");
+        return (SRCH_ReturnParameterError);
     }
-    
-    if ( pswSrchWeight != pswSrchWeight2 ) {
-        iSrchWeightFree(pswSrchWeight2);
-        pswSrchWeight2 = NULL;
+
+
+    /* Sparse weights only hold the documents which were weighted, dense weights
+    ** are indexed by document ID so we skip the first entry, document IDs start at 1
+    */
+    if ( pswSrchWeight->bSparseFlag == true ) {
+        pfWeightsPtr = pswSrchWeight->pfWeights;
+        pfWeightsEnd = pswSrchWeight->pfWeights + pswSrchWeight->uiDocumentIDsLength;
     }
-    
-    
+    else {
+        pfWeightsPtr = pswSrchWeight->pfWeights + 1;
+        pfWeightsEnd = pswSrchWeight->pfWeights + pswSrchWeight->uiWeightsLength;
+    }
+
+
+#if defined(SRCH_WEIGHT_ENABLE_SSE)
+    {
+        /* Number of bits set in a four bit mask */
+        static unsigned char    pucMaskBitCounts[] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+        __m128                  mZero = _mm_setzero_ps();
+
+        /* Count the weights, four at a time */
+        for ( ; (pfWeightsPtr + 4) <= pfWeightsEnd; pfWeightsPtr += 4 ) {
+            uiDocumentCount += pucMaskBitCounts[_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(pfWeightsPtr), mZero))];
+        }
+    }
+#endif    /* defined(SRCH_WEIGHT_ENABLE_SSE) */
+
+    /* Count the (remaining) weights */
+    for ( ; pfWeightsPtr < pfWeightsEnd; pfWeightsPtr++ ) {
+        if ( *pfWeightsPtr > 0 ) {
+            uiDocumentCount++;
+        }
+    }
+
+
     /* Set the return pointer */
-    *ppswSrchWeight = pswSrchWeight;
+    *puiDocumentCount = uiDocumentCount;
+
 
-    
     return (SRCH_NoError);
 
 }
@@ -308,11 +478,11 @@ int iSrchWeightMergeXOR
 
 /*
 
-    Function:   iSrchWeightMergeOR()
+    Function:   iSrchWeightMergeXOR()
 
     Purpose:    This function XORs pswSrchWeight1 and pswSrchWeight2
                 and return a pointer to the new search weight structure.
-                It disposes of the two passed search weight structures 
+                It disposes of the two passed search weight structures
                 except if an error occurs.
 
     Parameters: pswSrchWeight1      search weight structure
@@ -324,7 +494,7 @@ int iSrchWeightMergeXOR
     Returns:    SRCH error code
 
 */
-int iSrchWeightMergeOR
+int iSrchWeightMergeXOR
 (
     struct srchWeight *pswSrchWeight1,
     struct srchWeight *pswSrchWeight2,
@@ -332,94 +502,36 @@ int iSrchWeightMergeOR
 )
 {
 
-    int                 iError = SRCH_NoError;
-
-    struct srchWeight   *pswSrchWeight = NULL;
-
-    float               *pfWeightsPtr = NULL;
-    float               *pfWeights1Ptr = NULL;
-    float               *pfWeights2Ptr = NULL;
-    float               *pfWeightsEnd = NULL;
-
-
     /* Check the parameters */
     if ( pswSrchWeight1 == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1' parameter passed to 'iSrchWeightMergeOR'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1' parameter passed to 'iSrchWeightMergeXOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight2 == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2' parameter passed to 'iSrchWeightMergeOR'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2' parameter passed to 'iSrchWeightMergeXOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
 
     if ( pswSrchWeight1->pfWeights == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1->pfWeights' parameter passed to 'iSrchWeightMergeOR'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1->pfWeights' parameter passed to 'iSrchWeightMergeXOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight2->pfWeights == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2->pfWeights' parameter passed to 'iSrchWeightMergeOR'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2->pfWeights' parameter passed to 'iSrchWeightMergeXOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight1->uiWeightsLength != pswSrchWeight2->uiWeightsLength ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Unequal 'pswSrchWeight1->uiWeightsLength' & 'pswSrchWeight2->uiWeightsLength' parameters passed to 'iSrchWeightMergeOR'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Unequal 'pswSrchWeight1->uiWeightsLength' & 'pswSrchWeight2->uiWeightsLength' parameters passed to 'iSrchWeightMergeXOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
-    
-    /* Reuse one or the other search weight structure if we can, otherwise we allocate a new one */
-    if ( pswSrchWeight1->bMappedAllocationFlag == false ) {
-        pswSrchWeight = pswSrchWeight1;
-    }
-    else if ( pswSrchWeight2->bMappedAllocationFlag == false ) {
-        pswSrchWeight = pswSrchWeight2;
-    }
-    else {
-
-        /* Allocate a new search weights structure */
-        if ( (iError = iSrchWeightCreate(NULL, pswSrchWeight1->uiWeightsLength, false, &pswSrchWeight)) != SRCH_NoError ) {
-            return (iError);
-        }
-    }
-
-
-    /* OR the two search weight arrays */
-    for ( pfWeightsPtr = pswSrchWeight->pfWeights, pfWeights1Ptr = pswSrchWeight1->pfWeights, pfWeights2Ptr = pswSrchWeight2->pfWeights, 
-            pfWeightsEnd = (pswSrchWeight->pfWeights + pswSrchWeight->uiWeightsLength); pfWeightsPtr < pfWeightsEnd; pfWeightsPtr++, pfWeights1Ptr++, pfWeights2Ptr++ ) {
-
-#if defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING)
-
-        *pfWeightsPtr = (*pfWeights1Ptr > 0) ? ((*pfWeights1Ptr + *pfWeights2Ptr) * SRCH_WEIGHT_TERM_WEIGHT_CO_OCCURRENCE) : (*pfWeights1Ptr + *pfWeights2Ptr);
-
-#else
-
-        *pfWeightsPtr = *pfWeights1Ptr + *pfWeights2Ptr;
-
-#endif /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
-
-    }
-
-    
-    /* Free the search weight structures */
-    if ( pswSrchWeight != pswSrchWeight1 ) {
-        iSrchWeightFree(pswSrchWeight1);
-        pswSrchWeight1 = NULL;
-    }
-    
-    if ( pswSrchWeight != pswSrchWeight2 ) {
-        iSrchWeightFree(pswSrchWeight2);
-        pswSrchWeight2 = NULL;
-    }
-    
-    
-    /* Set the return pointer */
-    *ppswSrchWeight = pswSrchWeight;
 
-    
-    return (SRCH_NoError);
+    /* XOR the two search weight structures */
+    return (iSrchWeightMerge(pswSrchWeight1, pswSrchWeight2, SRCH_WEIGHT_MERGE_TYPE_XOR, ppswSrchWeight));
 
 }
 
@@ -429,11 +541,11 @@ int iSrchWeightMergeOR
 
 /*
 
-    Function:   iSrchWeightMergeAND()
+    Function:   iSrchWeightMergeOR()
 
-    Purpose:    This function XORs pswSrchWeight1 and pswSrchWeight2
+    Purpose:    This function ORs pswSrchWeight1 and pswSrchWeight2
                 and return a pointer to the new search weight structure.
-                It disposes of the two passed search weight structures 
+                It disposes of the two passed search weight structures
                 except if an error occurs.
 
     Parameters: pswSrchWeight1      search weight structure
@@ -445,102 +557,107 @@ int iSrchWeightMergeOR
     Returns:    SRCH error code
 
 */
-int iSrchWeightMergeAND
+int iSrchWeightMergeOR
 (
     struct srchWeight *pswSrchWeight1,
     struct srchWeight *pswSrchWeight2,
     struct srchWeight **ppswSrchWeight
 )
 {
-    
-    int                 iError = SRCH_NoError;
-
-    struct srchWeight   *pswSrchWeight = NULL;
-
-    float               *pfWeightsPtr = NULL;
-    float               *pfWeights1Ptr = NULL;
-    float               *pfWeights2Ptr = NULL;
-    float               *pfWeightsEnd = NULL;
-
 
     /* Check the parameters */
     if ( pswSrchWeight1 == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1' parameter passed to 'iSrchWeightMergeAND'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1' parameter passed to 'iSrchWeightMergeOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight2 == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2' parameter passed to 'iSrchWeightMergeAND'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2' parameter passed to 'iSrchWeightMergeOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
 
     if ( pswSrchWeight1->pfWeights == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1->pfWeights' parameter passed to 'iSrchWeightMergeAND'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1->pfWeights' parameter passed to 'iSrchWeightMergeOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight2->pfWeights == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2->pfWeights' parameter passed to 'iSrchWeightMergeAND'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2->pfWeights' parameter passed to 'iSrchWeightMergeOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight1->uiWeightsLength != pswSrchWeight2->uiWeightsLength ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Unequal 'pswSrchWeight1->uiWeightsLength' & 'pswSrchWeight2->uiWeightsLength' parameters passed to 'iSrchWeightMergeAND'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Unequal 'pswSrchWeight1->uiWeightsLength' & 'pswSrchWeight2->uiWeightsLength' parameters passed to 'iSrchWeightMergeOR'.");
         return (SRCH_WeightInvalidWeight);
     }
 
-    
-    /* Reuse one or the other search weight structure if we can, otherwise we allocate a new one */
-    if ( pswSrchWeight1->bMappedAllocationFlag == false ) {
-        pswSrchWeight = pswSrchWeight1;
-    }
-    else if ( pswSrchWeight2->bMappedAllocationFlag == false ) {
-        pswSrchWeight = pswSrchWeight2;
-    }
-    else {
 
-        /* Allocate a new search weights structure */
-        if ( (iError = iSrchWeightCreate(NULL, pswSrchWeight1->uiWeightsLength, false, &pswSrchWeight)) != SRCH_NoError ) {
-            return (iError);
-        }
-    }
+    /* OR the two search weight structures */
+    return (iSrchWeightMerge(pswSrchWeight1, pswSrchWeight2, SRCH_WEIGHT_MERGE_TYPE_OR, ppswSrchWeight));
 
+}
 
-    /* AND the two search weight arrays */
-    for ( pfWeightsPtr = pswSrchWeight->pfWeights, pfWeights1Ptr = pswSrchWeight1->pfWeights, pfWeights2Ptr = pswSrchWeight2->pfWeights, 
-            pfWeightsEnd = (pswSrchWeight->pfWeights + pswSrchWeight->uiWeightsLength); pfWeightsPtr < pfWeightsEnd; pfWeightsPtr++, pfWeights1Ptr++, pfWeights2Ptr++ ) {
 
-#if defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING)
+/*---------------------------------------------------------------------------*/
 
-        *pfWeightsPtr = ((*pfWeights1Ptr > 0) && (*pfWeights2Ptr > 0)) ? ((*pfWeights1Ptr + *pfWeights2Ptr) * SRCH_WEIGHT_TERM_WEIGHT_CO_OCCURRENCE) : 0;
 
-#else
+/*
 
-        *pfWeightsPtr = ((*pfWeights1Ptr > 0) && (*pfWeights2Ptr > 0)) ? (*pfWeights1Ptr + *pfWeights2Ptr) : 0;
+    Function:   iSrchWeightMergeAND()
 
-#endif /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
+    Purpose:    This function ANDs pswSrchWeight1 and pswSrchWeight2
+                and return a pointer to the new search weight structure.
+                It disposes of the two passed search weight structures
+                except if an error occurs.
 
+    Parameters: pswSrchWeight1      search weight structure
+                pswSrchWeight2      search weight structure
+                ppswSrchWeight      return pointer for the new search weight structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+int iSrchWeightMergeAND
+(
+    struct srchWeight *pswSrchWeight1,
+    struct srchWeight *pswSrchWeight2,
+    struct srchWeight **ppswSrchWeight
+)
+{
+
+    /* Check the parameters */
+    if ( pswSrchWeight1 == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1' parameter passed to 'iSrchWeightMergeAND'.");
+        return (SRCH_WeightInvalidWeight);
     }
 
-    
-    /* Free the search weight structures */
-    if ( pswSrchWeight != pswSrchWeight1 ) {
-        iSrchWeightFree(pswSrchWeight1);
-        pswSrchWeight1 = NULL;
+    if ( pswSrchWeight2 == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2' parameter passed to 'iSrchWeightMergeAND'.");
+        return (SRCH_WeightInvalidWeight);
     }
-    
-    if ( pswSrchWeight != pswSrchWeight2 ) {
-        iSrchWeightFree(pswSrchWeight2);
-        pswSrchWeight2 = NULL;
+
+
+    if ( pswSrchWeight1->pfWeights == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1->pfWeights' parameter passed to 'iSrchWeightMergeAND'.");
+        return (SRCH_WeightInvalidWeight);
     }
-    
-    
-    /* Set the return pointer */
-    *ppswSrchWeight = pswSrchWeight;
 
-    
-    return (SRCH_NoError);
+    if ( pswSrchWeight2->pfWeights == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2->pfWeights' parameter passed to 'iSrchWeightMergeAND'.");
+        return (SRCH_WeightInvalidWeight);
+    }
+
+    if ( pswSrchWeight1->uiWeightsLength != pswSrchWeight2->uiWeightsLength ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Unequal 'pswSrchWeight1->uiWeightsLength' & 'pswSrchWeight2->uiWeightsLength' parameters passed to 'iSrchWeightMergeAND'.");
+        return (SRCH_WeightInvalidWeight);
+    }
+
+
+    /* AND the two search weight structures */
+    return (iSrchWeightMerge(pswSrchWeight1, pswSrchWeight2, SRCH_WEIGHT_MERGE_TYPE_AND, ppswSrchWeight));
 
 }
 
@@ -552,9 +669,9 @@ int iSrchWeightMergeAND
 
     Function:   iSrchWeightMergeNOT()
 
-    Purpose:    This function XORs pswSrchWeight1 and pswSrchWeight2
+    Purpose:    This function NOTs pswSrchWeight1 and pswSrchWeight2
                 and return a pointer to the new search weight structure.
-                It disposes of the two passed search weight structures 
+                It disposes of the two passed search weight structures
                 except if an error occurs.
 
     Parameters: pswSrchWeight1      search weight structure
@@ -573,45 +690,114 @@ int iSrchWeightMergeNOT
     struct srchWeight **ppswSrchWeight
 )
 {
-    
-    int                 iError = SRCH_NoError;
-
-    struct srchWeight   *pswSrchWeight = NULL;
-
-    float               *pfWeightsPtr = NULL;
-    float               *pfWeights1Ptr = NULL;
-    float               *pfWeights2Ptr = NULL;
-    float               *pfWeightsEnd = NULL;
-
 
     /* Check the parameters */
     if ( pswSrchWeight1 == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1' parameter passed to 'iSrchWeightMergeNOT'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1' parameter passed to 'iSrchWeightMergeNOT'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight2 == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2' parameter passed to 'iSrchWeightMergeNOT'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2' parameter passed to 'iSrchWeightMergeNOT'.");
         return (SRCH_WeightInvalidWeight);
     }
 
 
     if ( pswSrchWeight1->pfWeights == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1->pfWeights' parameter passed to 'iSrchWeightMergeNOT'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight1->pfWeights' parameter passed to 'iSrchWeightMergeNOT'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight2->pfWeights == NULL ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2->pfWeights' parameter passed to 'iSrchWeightMergeNOT'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pswSrchWeight2->pfWeights' parameter passed to 'iSrchWeightMergeNOT'.");
         return (SRCH_WeightInvalidWeight);
     }
 
     if ( pswSrchWeight1->uiWeightsLength != pswSrchWeight2->uiWeightsLength ) {
-        iUtlLogError(UTL_LOG_CONTEXT, "Unequal 'pswSrchWeight1->uiWeightsLength' & 'pswSrchWeight2->uiWeightsLength' parameters passed to 'iSrchWeightMergeNOT'."); 
+        iUtlLogError(UTL_LOG_CONTEXT, "Unequal 'pswSrchWeight1->uiWeightsLength' & 'pswSrchWeight2->uiWeightsLength' parameters passed to 'iSrchWeightMergeNOT'.");
         return (SRCH_WeightInvalidWeight);
     }
 
-    
+
+    /* NOT the two search weight structures */
+    return (iSrchWeightMerge(pswSrchWeight1, pswSrchWeight2, SRCH_WEIGHT_MERGE_TYPE_NOT, ppswSrchWeight));
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchWeightMerge()
+
+    Purpose:    This function merges pswSrchWeight1 and pswSrchWeight2
+                and return a pointer to the new search weight structure.
+                It disposes of the two passed search weight structures
+                except if an error occurs.
+
+                Two sparse search weight structures are merged into a sparse
+                one, a sparse search weight structure is filtered against a
+                dense one if the merge result can only contain its documents,
+                otherwise the sparse search weight structures are expanded
+                and the weights arrays are merged.
+
+    Parameters: pswSrchWeight1      search weight structure
+                pswSrchWeight2      search weight structure
+                uiMergeType         merge type
+                ppswSrchWeight      return pointer for the new search weight structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchWeightMerge
+(
+    struct srchWeight *pswSrchWeight1,
+    struct srchWeight *pswSrchWeight2,
+    unsigned int uiMergeType,
+    struct srchWeight **ppswSrchWeight
+)
+{
+
+    int                 iError = SRCH_NoError;
+    struct srchWeight   *pswSrchWeight = NULL;
+
+
+    ASSERT(pswSrchWeight1 != NULL);
+    ASSERT(pswSrchWeight2 != NULL);
+    ASSERT(SRCH_WEIGHT_MERGE_TYPE_VALID(uiMergeType) == true);
+    ASSERT(ppswSrchWeight != NULL);
+
+
+    /* Merge two sparse search weight structures */
+    if ( (pswSrchWeight1->bSparseFlag == true) && (pswSrchWeight2->bSparseFlag == true) ) {
+        return (iSrchWeightMergeSparseWeights(pswSrchWeight1, pswSrchWeight2, uiMergeType, ppswSrchWeight));
+    }
+
+    /* XOR, AND and NOT only keep documents weighted in the first search weight structure */
+    if ( (pswSrchWeight1->bSparseFlag == true) && (uiMergeType != SRCH_WEIGHT_MERGE_TYPE_OR) ) {
+        return (iSrchWeightFilterSparseWeights(pswSrchWeight1, pswSrchWeight2, true, uiMergeType, ppswSrchWeight));
+    }
+
+    /* AND only keeps documents weighted in the second search weight structure */
+    if ( (pswSrchWeight2->bSparseFlag == true) && (uiMergeType == SRCH_WEIGHT_MERGE_TYPE_AND) ) {
+        return (iSrchWeightFilterSparseWeights(pswSrchWeight2, pswSrchWeight1, false, uiMergeType, ppswSrchWeight));
+    }
+
+
+    /* Expand the sparse search weight structures, the merge result will be dense */
+    if ( (iError = iSrchWeightExpandSparse(pswSrchWeight1)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+    if ( (iError = iSrchWeightExpandSparse(pswSrchWeight2)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
     /* Reuse one or the other search weight structure if we can, otherwise we allocate a new one */
     if ( pswSrchWeight1->bMappedAllocationFlag == false ) {
         pswSrchWeight = pswSrchWeight1;
@@ -628,31 +814,141 @@ int iSrchWeightMergeNOT
     }
 
 
-    /* NOT the two search weight arrays */
-    for ( pfWeightsPtr = pswSrchWeight->pfWeights, pfWeights1Ptr = pswSrchWeight1->pfWeights, pfWeights2Ptr = pswSrchWeight2->pfWeights, 
-            pfWeightsEnd = (pswSrchWeight->pfWeights + pswSrchWeight->uiWeightsLength); pfWeightsPtr < pfWeightsEnd; pfWeightsPtr++, pfWeights1Ptr++, pfWeights2Ptr++ ) {
+    /* Merge the two search weight arrays */
+    vSrchWeightMergeWeights(pswSrchWeight1->pfWeights, pswSrchWeight2->pfWeights, uiMergeType,
+            pswSrchWeight->pfWeights, pswSrchWeight->uiWeightsLength);
 
-        *pfWeightsPtr = (*pfWeights2Ptr > 0) ? 0 : *pfWeights1Ptr;
 
-    }
-
-    
     /* Free the search weight structures */
     if ( pswSrchWeight != pswSrchWeight1 ) {
         iSrchWeightFree(pswSrchWeight1);
         pswSrchWeight1 = NULL;
     }
-    
+
     if ( pswSrchWeight != pswSrchWeight2 ) {
         iSrchWeightFree(pswSrchWeight2);
         pswSrchWeight2 = NULL;
     }
-    
-    
+
+
     /* Set the return pointer */
     *ppswSrchWeight = pswSrchWeight;
 
-    
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iSrchWeightMergeSparseWeights()
+
+    Purpose:    This function merges two sparse search weight structures
+                into a new one, and expands it if it turns out to be too
+                dense. It disposes of the two passed search weight structures
+                except if an error occurs.
+
+    Parameters: pswSrchWeight1      sparse search weight structure
+                pswSrchWeight2      sparse search weight structure
+                uiMergeType         merge type
+                ppswSrchWeight      return pointer for the new search weight structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchWeightMergeSparseWeights
+(
+    struct srchWeight *pswSrchWeight1,
+    struct srchWeight *pswSrchWeight2,
+    unsigned int uiMergeType,
+    struct srchWeight **ppswSrchWeight
+)
+{
+
+    int                 iError = SRCH_NoError;
+    struct srchWeight   *pswSrchWeight = NULL;
+    unsigned int        uiI1 = 0;
+    unsigned int        uiI2 = 0;
+    unsigned int        uiDocumentIDsLength = 0;
+    unsigned int        uiDocumentID = 0;
+    float               fWeight1 = 0;
+    float               fWeight2 = 0;
+    float               fWeight = 0;
+
+
+    ASSERT(pswSrchWeight1 != NULL);
+    ASSERT(pswSrchWeight1->bSparseFlag == true);
+    ASSERT(pswSrchWeight2 != NULL);
+    ASSERT(pswSrchWeight2->bSparseFlag == true);
+    ASSERT(SRCH_WEIGHT_MERGE_TYPE_VALID(uiMergeType) == true);
+    ASSERT(ppswSrchWeight != NULL);
+
+
+    /* Allocate a new sparse search weights structure, large enough for the union of the two */
+    if ( (iError = iSrchWeightCreateSparse(pswSrchWeight1->uiWeightsLength,
+            pswSrchWeight1->uiDocumentIDsLength + pswSrchWeight2->uiDocumentIDsLength, &pswSrchWeight)) != SRCH_NoError ) {
+        return (iError);
+    }
+
+
+    /* Walk the two sorted document IDs arrays, a document missing from one side has a zero weight on that side */
+    while ( (uiI1 < pswSrchWeight1->uiDocumentIDsLength) || (uiI2 < pswSrchWeight2->uiDocumentIDsLength) ) {
+
+        if ( (uiI2 >= pswSrchWeight2->uiDocumentIDsLength) ||
+                ((uiI1 < pswSrchWeight1->uiDocumentIDsLength) && (pswSrchWeight1->puiDocumentIDs[uiI1] < pswSrchWeight2->puiDocumentIDs[uiI2])) ) {
+            uiDocumentID = pswSrchWeight1->puiDocumentIDs[uiI1];
+            fWeight1 = pswSrchWeight1->pfWeights[uiI1++];
+            fWeight2 = 0;
+        }
+        else if ( (uiI1 >= pswSrchWeight1->uiDocumentIDsLength) || (pswSrchWeight2->puiDocumentIDs[uiI2] < pswSrchWeight1->puiDocumentIDs[uiI1]) ) {
+            uiDocumentID = pswSrchWeight2->puiDocumentIDs[uiI2];
+            fWeight1 = 0;
+            fWeight2 = pswSrchWeight2->pfWeights[uiI2++];
+        }
+        else {
+            uiDocumentID = pswSrchWeight1->puiDocumentIDs[uiI1];
+            fWeight1 = pswSrchWeight1->pfWeights[uiI1++];
+            fWeight2 = pswSrchWeight2->pfWeights[uiI2++];
+        }
+
+        /* Add the merged weight if it is set */
+        if ( (fWeight = SRCH_WEIGHT_MERGE_WEIGHTS(uiMergeType, fWeight1, fWeight2)) != 0 ) {
+            pswSrchWeight->puiDocumentIDs[uiDocumentIDsLength] = uiDocumentID;
+            pswSrchWeight->pfWeights[uiDocumentIDsLength] = fWeight;
+            uiDocumentIDsLength++;
+        }
+    }
+
+    pswSrchWeight->uiDocumentIDsLength = uiDocumentIDsLength;
+
+
+    /* Expand the new search weight structure if it is too dense */
+    if ( pswSrchWeight->uiDocumentIDsLength > SRCH_WEIGHT_SPARSE_LENGTH_MAXIMUM(pswSrchWeight->uiWeightsLength) ) {
+        if ( (iError = iSrchWeightExpandSparse(pswSrchWeight)) != SRCH_NoError ) {
+            iSrchWeightFree(pswSrchWeight);
+            return (iError);
+        }
+    }
+
+
+    /* Free the search weight structures */
+    iSrchWeightFree(pswSrchWeight1);
+    pswSrchWeight1 = NULL;
+
+    iSrchWeightFree(pswSrchWeight2);
+    pswSrchWeight2 = NULL;
+
+
+    /* Set the return pointer */
+    *ppswSrchWeight = pswSrchWeight;
+
+
     return (SRCH_NoError);
 
 }
@@ -661,6 +957,189 @@ int iSrchWeightMergeNOT
 /*---------------------------------------------------------------------------*/
 
 
+/*
+
+    Function:   iSrchWeightFilterSparseWeights()
+
+    Purpose:    This function merges a sparse search weight structure with
+                a dense one in place, this is only valid if the merge result
+                cannot contain documents which are not in the sparse search
+                weight structure. It disposes of the dense search weight
+                structure.
+
+    Parameters: pswSrchWeightSparse     sparse search weight structure
+                pswSrchWeightDense      dense search weight structure
+                bSparseFirst            true if the sparse search weight structure
+                                        is the first one in the merge
+                uiMergeType             merge type
+                ppswSrchWeight          return pointer for the new search weight structure
+
+    Globals:    none
+
+    Returns:    SRCH error code
+
+*/
+static int iSrchWeightFilterSparseWeights
+(
+    struct srchWeight *pswSrchWeightSparse,
+    struct srchWeight *pswSrchWeightDense,
+    boolean bSparseFirst,
+    unsigned int uiMergeType,
+    struct srchWeight **ppswSrchWeight
+)
+{
+
+    unsigned int    uiI = 0;
+    unsigned int    uiDocumentIDsLength = 0;
+    unsigned int    uiDocumentID = 0;
+    float           fWeightSparse = 0;
+    float           fWeightDense = 0;
+    float           fWeight = 0;
+
+
+    ASSERT(pswSrchWeightSparse != NULL);
+    ASSERT(pswSrchWeightSparse->bSparseFlag == true);
+    ASSERT(pswSrchWeightDense != NULL);
+    ASSERT(pswSrchWeightDense->bSparseFlag == false);
+    ASSERT(SRCH_WEIGHT_MERGE_TYPE_VALID(uiMergeType) == true);
+    ASSERT(ppswSrchWeight != NULL);
+
+
+    /* Merge the sparse weights with their dense counterparts, compacting the sparse arrays as we go */
+    for ( uiI = 0; uiI < pswSrchWeightSparse->uiDocumentIDsLength; uiI++ ) {
+
+        uiDocumentID = pswSrchWeightSparse->puiDocumentIDs[uiI];
+        fWeightSparse = pswSrchWeightSparse->pfWeights[uiI];
+        fWeightDense = pswSrchWeightDense->pfWeights[uiDocumentID];
+
+        fWeight = (bSparseFirst == true) ? SRCH_WEIGHT_MERGE_WEIGHTS(uiMergeType, fWeightSparse, fWeightDense) :
+                SRCH_WEIGHT_MERGE_WEIGHTS(uiMergeType, fWeightDense, fWeightSparse);
+
+        /* Keep the merged weight if it is set */
+        if ( fWeight != 0 ) {
+            pswSrchWeightSparse->puiDocumentIDs[uiDocumentIDsLength] = uiDocumentID;
+            pswSrchWeightSparse->pfWeights[uiDocumentIDsLength] = fWeight;
+            uiDocumentIDsLength++;
+        }
+    }
+
+    pswSrchWeightSparse->uiDocumentIDsLength = uiDocumentIDsLength;
+
+
+    /* Free the dense search weight structure */
+    iSrchWeightFree(pswSrchWeightDense);
+    pswSrchWeightDense = NULL;
+
+
+    /* Set the return pointer */
+    *ppswSrchWeight = pswSrchWeightSparse;
+
+
+    return (SRCH_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   vSrchWeightMergeWeights()
+
+    Purpose:    This function merges two weights arrays according to the
+                merge type, four weights at a time with SSE if it is enabled.
+                The merged weights array can be either of the two weights arrays.
+
+    Parameters: pfWeights1          weights array
+                pfWeights2          weights array
+                uiMergeType         merge type
+                pfWeights           weights array to merge to
+                uiWeightsLength     weights arrays length
+
+    Globals:    none
+
+    Returns:    void
+
+*/
+static void vSrchWeightMergeWeights
+(
+    float *pfWeights1,
+    float *pfWeights2,
+    unsigned int uiMergeType,
+    float *pfWeights,
+    unsigned int uiWeightsLength
+)
+{
+
+    unsigned int    uiI = 0;
+
+
+    ASSERT(pfWeights1 != NULL);
+    ASSERT(pfWeights2 != NULL);
+    ASSERT(SRCH_WEIGHT_MERGE_TYPE_VALID(uiMergeType) == true);
+    ASSERT(pfWeights != NULL);
+
+
+#if defined(SRCH_WEIGHT_ENABLE_SSE)
+    {
+        __m128      mZero = _mm_setzero_ps();
+#if defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING)
+        __m128      mCoOccurrence = _mm_set1_ps(SRCH_WEIGHT_TERM_WEIGHT_CO_OCCURRENCE);
+#endif    /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
+
+        /* Merge the weights, four at a time, the comparisons yield masks which select the weights to keep */
+        for ( uiI = 0; (uiI + 4) <= uiWeightsLength; uiI += 4 ) {
+
+            __m128      mWeights1 = _mm_loadu_ps(pfWeights1 + uiI);
+            __m128      mWeights2 = _mm_loadu_ps(pfWeights2 + uiI);
+            __m128      mSum = _mm_add_ps(mWeights1, mWeights2);
+            __m128      mWeights;
+
+            if ( uiMergeType == SRCH_WEIGHT_MERGE_TYPE_XOR ) {
+#if defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING)
+                mSum = _mm_add_ps(mWeights1, _mm_mul_ps(mWeights2, mCoOccurrence));
+#endif    /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
+                mWeights = _mm_and_ps(_mm_cmpgt_ps(mWeights1, mZero), mSum);
+            }
+            else if ( uiMergeType == SRCH_WEIGHT_MERGE_TYPE_OR ) {
+#if defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING)
+                __m128  mMask = _mm_cmpgt_ps(mWeights1, mZero);
+                mWeights = _mm_or_ps(_mm_and_ps(mMask, _mm_mul_ps(mSum, mCoOccurrence)), _mm_andnot_ps(mMask, mSum));
+#else
+                mWeights = mSum;
+#endif    /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
+            }
+            else if ( uiMergeType == SRCH_WEIGHT_MERGE_TYPE_AND ) {
+#if defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING)
+                mSum = _mm_mul_ps(mSum, mCoOccurrence);
+#endif    /* defined(SRCH_WEIGHT_ENABLE_CO_OCCURENCE_REWEIGHTING) */
+                mWeights = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(mWeights1, mZero), _mm_cmpgt_ps(mWeights2, mZero)), mSum);
+            }
+            else {
+                /* _mm_andnot_ps() negates its first operand */
+                mWeights = _mm_andnot_ps(_mm_cmpgt_ps(mWeights2, mZero), mWeights1);
+            }
+
+            _mm_storeu_ps(pfWeights + uiI, mWeights);
+        }
+    }
+#endif    /* defined(SRCH_WEIGHT_ENABLE_SSE) */
+
+    /* Merge the (remaining) weights */
+    for ( ; uiI < uiWeightsLength; uiI++ ) {
+        pfWeights[uiI] = SRCH_WEIGHT_MERGE_WEIGHTS(uiMergeType, pfWeights1[uiI], pfWeights2[uiI]);
+    }
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 
     Function:   iSrchWeightPrint()
@@ -701,8 +1180,15 @@ int iSrchWeightPrint
         unsigned int    uiI = 0;
         float           *pfWeightsPtr = NULL;
 
-        for ( uiI = 0, pfWeightsPtr = pswSrchWeight->pfWeights; uiI < pswSrchWeight->uiWeightsLength; uiI++, pfWeightsPtr++ ) {
-            printf("%8u - %9.4f\n", uiI, *pfWeightsPtr);
+        if ( pswSrchWeight->bSparseFlag == true ) {
+            for ( uiI = 0, pfWeightsPtr = pswSrchWeight->pfWeights; uiI < pswSrchWeight->uiDocumentIDsLength; uiI++, pfWeightsPtr++ ) {
+                printf("%8u - %9.4f\n", pswSrchWeight->puiDocumentIDs[uiI], *pfWeightsPtr);
+            }
+        }
+        else {
+            for ( uiI = 0, pfWeightsPtr = pswSrchWeight->pfWeights; uiI < pswSrchWeight->uiWeightsLength; uiI++, pfWeightsPtr++ ) {
+                printf("%8u - %9.4f\n", uiI, *pfWeightsPtr);
+            }
         }
     }
 
@@ -53,15 +53,34 @@ extern "C" {
 /*---------------------------------------------------------------------------*/
 
 
+/*
+** Defines
+*/
+
+/* Weights are kept sparse (document ID/weight pairs) as long as there are
+** no more than one sparse entry per this number of documents
+*/
+#define SRCH_WEIGHT_SPARSE_DENSITY_RATIO                (16)
+
+/* Maximum number of sparse entries for a weights array length */
+#define SRCH_WEIGHT_SPARSE_LENGTH_MAXIMUM(n)            ((n) / SRCH_WEIGHT_SPARSE_DENSITY_RATIO)
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 ** Structures
 */
 
 /* Weight structure */
 struct srchWeight {
-    float           *pfWeights;                 /* Weights array */
-    unsigned int    uiWeightsLength;            /* Weights array length (number of entries) */
+    float           *pfWeights;                 /* Weights array, indexed by document ID, or parallel to puiDocumentIDs if sparse */
+    unsigned int    uiWeightsLength;            /* Weights array length (number of entries), the number of documents + 1 */
     boolean         bMappedAllocationFlag;      /* Memory mapped allocation flag */
+    boolean         bSparseFlag;                /* Sparse flag */
+    unsigned int    *puiDocumentIDs;            /* Document IDs array, sorted, only set if sparse */
+    unsigned int    uiDocumentIDsLength;        /* Document IDs array length (number of entries), only set if sparse */
 };
 
 
@@ -75,9 +94,18 @@ struct srchWeight {
 int iSrchWeightCreate (float *pfWeights, unsigned int uiWeightsLength,
     boolean bMappedAllocationFlag, struct srchWeight **ppswSrchWeight);
 
+int iSrchWeightCreateSparse (unsigned int uiWeightsLength, unsigned int uiDocumentIDsLength,
+        struct srchWeight **ppswSrchWeight);
+
 int iSrchWeightFree (struct srchWeight *pswSrchWeight);
 
 
+int iSrchWeightExpandSparse (struct srchWeight *pswSrchWeight);
+
+int iSrchWeightGetDocumentCount (struct srchWeight *pswSrchWeight,
+        unsigned int *puiDocumentCount);
+
+
 int iSrchWeightMergeXOR (struct srchWeight *pswSrchWeight1, 
         struct srchWeight *pswSrchWeight2, struct srchWeight **ppswSrchWeight);
 
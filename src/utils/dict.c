@@ -23,28 +23,43 @@
 
                 The dictionary is created specifying the key size.
                 
-                The file is laid out in three parts, first the header, then
-                the key blocks and finally the super block.
+                The file is laid out in four parts, first the header, then
+                the key blocks, then the super block and finally the FST.
                 
-                    [dictionary file] => [dictionary header][key blocks, ...][super block]
+                    [dictionary file] => [dictionary header][key blocks, ...][super block][FST]
 
                     
-                The dictionary header stores the key length, the super block ID
-                and the super block entry count
+                The dictionary header stores the key length, the super block ID,
+                the super block entry count, the FST ID, the FST root state ID
+                and the key count
                 
                     [dictionary header] => [key length][super block ID][super block entry count]
+                                                [FST ID][FST root state ID][key count]
 
                     key length                          2 bytes
                     super block ID                      8 bytes
                     super block entry count             4 bytes
+                    FST ID                              8 bytes
+                    FST root state ID                   8 bytes
+                    key count                           4 bytes
 
 
                 Following that there are any number of key blocks, each key block starts
-                with a key block length, followed by any number of entries:
+                with a key block length and a restart table, followed by 
+                UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT entries, except for the last 
+                key block which can have fewer:
                 
-                    [key block] => [key block length][key blocks entries, ...]
+                    [key block] => [key block length][restart count][restart offsets, ...][key blocks entries, ...]
                     
-                    key block length                    compressed int
+                    key block length                    compressed int, excludes itself
+                    restart count                       compressed int
+                    restart offset                      4 bytes, from the first key block entry
+
+                Keys are front coded against the previous key in the key block, 
+                except for every UTL_DICT_KEY_BLOCK_RESTART_INTERVAL'th key (the 
+                restart points) which is stored in full. The restart offsets point 
+                to these, so a key block can be entered at a restart point rather 
+                than being decoded from its start.
 
                 Key block entries contain the key indent, the key snippet,
                 the entry length and the entry data:
@@ -59,14 +74,48 @@
                 The entry data is a chunk of binary data specified by the client app.
                 
                 
-                The super block consists of any number of entries:
+                The super block consists of one entry per key block, so the key
+                block holding the nth key in the dictionary is the one in the 
+                (n / UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT)th entry:
 
-                    [super block entry] => [key][key block ID]
+                    [super block entry] => [key block ID]
                     
-                    key                                 NULL terminated string, fixed field of 'key length'
                     key block ID                        8 bytes
 
 
+                The FST is a minimal acyclic finite state transducer which maps
+                each key to its ordinal in the dictionary. States are shared by
+                all the keys which end the same way and are stored children first,
+                so the root state is the last one. Each state holds its arc count,
+                a final flag, the number of keys reachable from it and its arcs
+                in label order:
+
+                    [FST state] => [arc count and final flag][key count][FST arcs, ...]
+
+                    arc count and final flag            compressed int, (arc count << 1) | final flag
+                    key count                           compressed int
+
+                    [FST arc] => [label][output][target state ID]
+
+                    label                               1 byte
+                    output                              compressed int
+                    target state ID                     compressed long, from the start of the FST
+
+                The output of an arc is the number of keys reachable from its state
+                which sort before the keys reached through that arc, so adding up 
+                the outputs along the path of a key gives its ordinal. Adding them 
+                up along a path which falls off the FST gives the number of keys 
+                which sort before a key not in the dictionary, which is how ranges
+                and prefixes get looked up. 
+                
+                A lookup only touches the FST states along the path of the key
+                and a single key block, rather than binary searching a super block
+                of keys padded to the key length. Since the ordinal gives the index
+                of the key in its key block, the lookup goes straight to the restart
+                point preceding the key and decodes at most 
+                UTL_DICT_KEY_BLOCK_RESTART_INTERVAL entries.
+
+
                 Dictionary creation functions:
 
                     iUtlDictCreate()
@@ -115,18 +164,44 @@
 
 
 /* Header defines */
+#define    UTL_DICT_HEADER_MAGIC_SIZE                       (4)
+#define    UTL_DICT_HEADER_VERSION_SIZE                     (2)
 #define    UTL_DICT_HEADER_KEY_LENGTH_SIZE                  (2)
 #define    UTL_DICT_HEADER_SUPER_BLOCK_ID_SIZE              (8)
 #define    UTL_DICT_HEADER_SUPER_BLOCK_ENTRY_COUNT_SIZE     (4)
+#define    UTL_DICT_HEADER_FST_ID_SIZE                      (8)
+#define    UTL_DICT_HEADER_FST_ROOT_STATE_ID_SIZE           (8)
+#define    UTL_DICT_HEADER_KEY_COUNT_SIZE                   (4)
 
-#define UTL_DICT_HEADER_LENGTH                              (UTL_DICT_HEADER_KEY_LENGTH_SIZE + \
+#define UTL_DICT_HEADER_LENGTH                              (UTL_DICT_HEADER_MAGIC_SIZE + \
+                                                                    UTL_DICT_HEADER_VERSION_SIZE + \
+                                                                    UTL_DICT_HEADER_KEY_LENGTH_SIZE + \
                                                                     UTL_DICT_HEADER_SUPER_BLOCK_ID_SIZE + \
-                                                                    UTL_DICT_HEADER_SUPER_BLOCK_ENTRY_COUNT_SIZE)
+                                                                    UTL_DICT_HEADER_SUPER_BLOCK_ENTRY_COUNT_SIZE + \
+                                                                    UTL_DICT_HEADER_FST_ID_SIZE + \
+                                                                    UTL_DICT_HEADER_FST_ROOT_STATE_ID_SIZE + \
+                                                                    UTL_DICT_HEADER_KEY_COUNT_SIZE)
+
+/* Header magic number ('MPSD') and format version, the version needs to be 
+** bumped whenever the dictionary file format changes
+*/
+#define    UTL_DICT_MAGIC                                   (0x4d505344)
+#define    UTL_DICT_VERSION                                 (2)
 
 /* Super block defines */
 #define    UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE           (8)
 
 
+/* FST defines, a state has at most one arc per byte value */
+#define    UTL_DICT_FST_ARC_MAXIMUM_COUNT                   (256)
+#define    UTL_DICT_FST_STATE_MAXIMUM_LENGTH                ((UTL_NUM_COMPRESSED_UINT_MAX_SIZE * 2) + \
+                                                                    (UTL_DICT_FST_ARC_MAXIMUM_COUNT * (1 + UTL_NUM_COMPRESSED_UINT_MAX_SIZE + \
+                                                                    UTL_NUM_COMPRESSED_ULONG_MAX_SIZE)))
+
+#define    UTL_DICT_FST_REGISTER_LENGTH_INITIAL             (1024)                              /* Needs to be a power of 2 */
+#define    UTL_DICT_FST_LENGTH_INITIAL                      (65536)
+
+
 
 /* The first and last keys in the dictionary, the character representations are for optimization */
 #define UTL_DICT_FIRST_KEY_STRING                           (unsigned char *)"\40"              /* Ascii 32 */
@@ -139,6 +214,13 @@
 #define    UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT           (250)
 
 
+/* Key block restart points, a key is stored in full every UTL_DICT_KEY_BLOCK_RESTART_INTERVAL keys */
+#define    UTL_DICT_KEY_BLOCK_RESTART_INTERVAL              (16)
+#define    UTL_DICT_KEY_BLOCK_RESTART_MAXIMUM_COUNT         ((UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT + UTL_DICT_KEY_BLOCK_RESTART_INTERVAL - 1) / \
+                                                                    UTL_DICT_KEY_BLOCK_RESTART_INTERVAL)
+#define    UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE           (4)
+
+
 /* Dictionary mode */
 #define    UTL_DICT_MODE_INVALID                            (0)
 #define    UTL_DICT_MODE_WRITE                              (1)
@@ -153,18 +235,54 @@
 */
 
 
+/* FST arc structure, used while the FST is being built */
+struct utlDictFstArc {
+
+    unsigned char           ucLabel;                                        /* Label */
+    unsigned long           ulTargetStateID;                                /* Target state ID, set once the target state is compiled */
+    unsigned int            uiTargetKeyCount;                               /* Number of keys reachable from the target state */
+
+};
+
+
+/* FST state structure, used while the FST is being built, these are the states along the path of the previous key */
+struct utlDictFstState {
+
+    boolean                 bFinal;                                         /* Set if a key ends at this state */
+    struct utlDictFstArc    *pudfaUtlDictFstArcs;                           /* Arcs */
+    unsigned int            uiUtlDictFstArcsLength;                         /* Arcs length */
+    unsigned int            uiUtlDictFstArcsCapacity;                       /* Arcs capacity */
+
+};
+
+
 struct utlDictWrite {
 
-    unsigned int            uiKeyCount;                                     /* Key count */
+    unsigned int            uiKeyCount;                                     /* Key count in the current key block */
 
     unsigned char           *pucKeyBlock;                                   /* Key block */
     unsigned int            uiKeyBlockLength;                               /* Key block length */
     unsigned int            uiKeyBlockCapacity;                             /* Key block capacity */
 
+    unsigned int            puiKeyBlockRestartOffsets[UTL_DICT_KEY_BLOCK_RESTART_MAXIMUM_COUNT];    /* Key block restart offsets */
+    unsigned int            uiKeyBlockRestartCount;                         /* Key block restart count */
+
     unsigned char           pucSavedKey[UTL_DICT_KEY_MAXIMUM_LENGTH + 1];   /* Saved key */
 
     unsigned char           pucDictFilePath[UTL_FILE_PATH_MAX + 1];         /* Saved dictionary file path */
 
+    unsigned char           pucPreviousKey[UTL_DICT_KEY_MAXIMUM_LENGTH + 1];                /* Previous key */
+    struct utlDictFstState  pudfsUtlDictFstStates[UTL_DICT_KEY_MAXIMUM_LENGTH + 1];         /* FST states along the path of the previous key */
+
+    unsigned char           *pucFst;                                        /* FST */
+    unsigned long           ulFstLength;                                    /* FST length */
+    unsigned long           ulFstCapacity;                                  /* FST capacity */
+
+    unsigned long           *pulFstRegisterStateIDs;                        /* FST register of compiled states, state IDs plus one so 0 is an empty slot */
+    unsigned int            *puiFstRegisterHashes;                          /* FST register of compiled states, hashes of the states */
+    unsigned long           ulFstRegisterLength;                            /* FST register length */
+    unsigned long           ulFstRegisterCount;                             /* FST register count */
+
 };
 
 
@@ -181,6 +299,11 @@ struct utlDict {
     unsigned char           *pucSuperBlock;                                 /* Super block pointer */
     unsigned int            uiSuperBlockEntryLength;                        /* Super block entry length */
 
+    unsigned long           ulFstID;                                        /* FST ID */
+    unsigned long           ulFstRootStateID;                               /* FST root state ID, from the start of the FST */
+    unsigned char           *pucFst;                                        /* FST pointer */
+    unsigned int            uiKeyCount;                                     /* Key count */
+
     void                    *pvFile;                                        /* Data pointer if the dictionary file if memory mapped */
     size_t                  zFileLength;                                    /* Data length if the dictionary file if memory mapped */
 
@@ -202,18 +325,39 @@ static int iUtlDictMapFile (struct utlDict *pudUtlDict);
 static int iUtlDictUnMapFile (struct utlDict *pudUtlDict);
 
 
-static int iUtlDictGetSuperBlockEntry (struct utlDict *pudUtlDict,
-        unsigned char *pucKey, unsigned char **ppucSuperBlockEntry);
+static int iUtlDictGetKeyBlockID (struct utlDict *pudUtlDict,
+        unsigned int uiKeyOrdinal, unsigned long *pulKeyBlockID);
 
 
 static int iUtlDictGetKeyBlockEntryData (struct utlDict *pudUtlDict,
-        unsigned long ulKeyBlockID, unsigned char *pucKey,
+        unsigned long ulKeyBlockID, unsigned int uiKeyBlockEntryIndex,
         void **ppvEntryData, unsigned int *puiEntryLength);
 
 
+static int iUtlDictGetKeyBlockRestartPoint (struct utlDict *pudUtlDict,
+        unsigned long ulKeyBlockID, unsigned int uiKeyBlockEntryIndex,
+        unsigned char **ppucKeyBlockEntryPtr, unsigned char **ppucKeyBlockEndPtr);
+
+
 static int iUtlDictProcessKeyBlockEntryList (struct utlDict *pudUtlDict,
-        unsigned long ulKeyBlockID, unsigned char *pucKey,
-        int (*iUtlDictCallBackFunction)(), va_list ap);
+        unsigned long ulKeyBlockID, unsigned int uiKeyBlockEntryIndex, 
+        unsigned char *pucKey, int (*iUtlDictCallBackFunction)(), va_list ap);
+
+
+static int iUtlDictFstAddKey (struct utlDict *pudUtlDict, unsigned char *pucKey);
+
+
+static int iUtlDictFstCompileStates (struct utlDict *pudUtlDict,
+        unsigned int uiFromDepth, unsigned int uiToDepth);
+
+
+static int iUtlDictFstCompileState (struct utlDict *pudUtlDict,
+        struct utlDictFstState *pudfsUtlDictFstState, 
+        unsigned long *pulStateID, unsigned int *puiKeyCount);
+
+
+static int iUtlDictFstGetKeyOrdinal (struct utlDict *pudUtlDict,
+        unsigned char *pucKey, unsigned int *puiKeyOrdinal, boolean *pbKeyFound);
 
 
 /*---------------------------------------------------------------------------*/
@@ -278,7 +422,11 @@ int iUtlDictCreate
     pudUtlDict->ulSuperBlockID = 0;
     pudUtlDict->uiSuperBlockEntryCount = 0;
     pudUtlDict->pucSuperBlock = NULL;
-    pudUtlDict->uiSuperBlockEntryLength = pudUtlDict->uiKeyLength + UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE;
+    pudUtlDict->uiSuperBlockEntryLength = UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE;
+    pudUtlDict->ulFstID = 0;
+    pudUtlDict->ulFstRootStateID = 0;
+    pudUtlDict->pucFst = NULL;
+    pudUtlDict->uiKeyCount = 0;
 
 
     /* Allocate a dictionary write structure */
@@ -291,8 +439,17 @@ int iUtlDictCreate
     pudUtlDict->pudwDictWrite->pucKeyBlock = NULL;
     pudUtlDict->pudwDictWrite->uiKeyBlockLength = 0;
     pudUtlDict->pudwDictWrite->uiKeyBlockCapacity = 0;
+    pudUtlDict->pudwDictWrite->uiKeyBlockRestartCount = 0;
     pudUtlDict->pudwDictWrite->pucSavedKey[0] = '\0';
     s_strnncpy(pudUtlDict->pudwDictWrite->pucDictFilePath, pucDictFilePath, UTL_FILE_PATH_MAX + 1);
+    pudUtlDict->pudwDictWrite->pucPreviousKey[0] = '\0';
+    pudUtlDict->pudwDictWrite->pucFst = NULL;
+    pudUtlDict->pudwDictWrite->ulFstLength = 0;
+    pudUtlDict->pudwDictWrite->ulFstCapacity = 0;
+    pudUtlDict->pudwDictWrite->pulFstRegisterStateIDs = NULL;
+    pudUtlDict->pudwDictWrite->puiFstRegisterHashes = NULL;
+    pudUtlDict->pudwDictWrite->ulFstRegisterLength = 0;
+    pudUtlDict->pudwDictWrite->ulFstRegisterCount = 0;
 
 
     /* Create the dictionary file - 'w+' so we can access it while we are creating it,
@@ -387,6 +544,7 @@ int iUtlDictAddEntry
     unsigned int        uiKeyIndentLengthSize = 0;
     unsigned int        uiKeyBlockEntryLength = 0;
     unsigned char       *pucKeyBlockEntryPtr = NULL;
+    int                 iError = UTL_NoError;
 
 
 /*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictAddEntry - pucDictKey: [%s]", pucDictKey); */
@@ -408,7 +566,7 @@ int iUtlDictAddEntry
         return (UTL_DictInvalidKey);
     }
 
-    if ( s_strcmp(pudUtlDict->pudwDictWrite->pucSavedKey, pucDictKey) > 0 ) {
+    if ( s_strcmp(pudUtlDict->pudwDictWrite->pucPreviousKey, pucDictKey) > 0 ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'pucDictKey' parameter passed to 'iUtlDictAddEntry'."); 
         return (UTL_DictInvalidKey);
     }
@@ -428,35 +586,31 @@ int iUtlDictAddEntry
     
 
 
-    /* Extend the super block if the key count is 0 */
-    if ( pudUtlDict->pudwDictWrite->uiKeyCount == 0 ) {
-    
-        unsigned int    uiSuperBlockCapacity = 0;
-        unsigned char    *pucSuperBlockPtr = NULL;
-
-        /* Get the new super block capacity */
-        uiSuperBlockCapacity = pudUtlDict->uiSuperBlockEntryLength * (pudUtlDict->uiSuperBlockEntryCount + 1);
-
-        /* Reallocate the super block */
-        if ( (pucSuperBlockPtr = (unsigned char *)s_realloc(pudUtlDict->pucSuperBlock, (size_t)(sizeof(unsigned char) * uiSuperBlockCapacity))) == NULL ) {
-            return (UTL_MemError);
-        }
-        
-        /* Hand over the super block pointer */
-        pudUtlDict->pucSuperBlock = pucSuperBlockPtr;
-        
-        /* Increment the super block entry count */
-        pudUtlDict->uiSuperBlockEntryCount++;
+    /* Skip duplicate keys, a lookup would only ever have returned the first entry 
+    ** for a key, and each key needs a single ordinal in the FST
+    */
+    if ( s_strcmp(pudUtlDict->pudwDictWrite->pucPreviousKey, pucDictKey) == 0 ) {
+        return (UTL_NoError);
+    }
 
-        /* Set the super block pointer to the start of the new super block entry */
-        pucSuperBlockPtr = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * (pudUtlDict->uiSuperBlockEntryCount - 1));
 
-        /* Copy the key to the super block entry */
-        s_strnncpy(pucSuperBlockPtr, pucDictKey, pudUtlDict->uiKeyLength - 1);
+    /* Add the key to the FST, its ordinal is the current key count */
+    if ( (iError = iUtlDictFstAddKey(pudUtlDict, pucDictKey)) != UTL_NoError ) {
+        return (iError);
     }
     
 
     
+    /* Start a restart point every UTL_DICT_KEY_BLOCK_RESTART_INTERVAL keys, the key
+    ** is stored in full by nulling the saved key, and its offset is recorded
+    */
+    if ( (pudUtlDict->pudwDictWrite->uiKeyCount % UTL_DICT_KEY_BLOCK_RESTART_INTERVAL) == 0 ) {
+        pudUtlDict->pudwDictWrite->puiKeyBlockRestartOffsets[pudUtlDict->pudwDictWrite->uiKeyBlockRestartCount] = pudUtlDict->pudwDictWrite->uiKeyBlockLength;
+        pudUtlDict->pudwDictWrite->uiKeyBlockRestartCount++;
+        pudUtlDict->pudwDictWrite->pucSavedKey[0] = '\0';
+    }
+
+
     /* Generate the dictionary key delta, this is done by comparing it with
     ** the saved key, we only store the difference at the end along with an 
     ** indent length, for example:
@@ -545,30 +699,45 @@ int iUtlDictAddEntry
     /* Update the key block length */
     pudUtlDict->pudwDictWrite->uiKeyBlockLength = pucKeyBlockEntryPtr - pudUtlDict->pudwDictWrite->pucKeyBlock;
 
-    /* Increment the key count */
+    /* Increment the key counts */
     pudUtlDict->pudwDictWrite->uiKeyCount++;
+    pudUtlDict->uiKeyCount++;
 
 
     /* Save the key block if we have hit the key block maximum entry count
     ** or if this is the last key (which gets added when we done adding keys
-    ** to the dictionary)
+    ** to the dictionary), key blocks need to be full so that we can get from
+    ** the ordinal of a key to its key block
     */
-    if ( (pudUtlDict->pudwDictWrite->uiKeyCount > UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT) || (s_strcmp(pucDictKey, UTL_DICT_LAST_KEY_STRING) == 0) ) {
+    if ( (pudUtlDict->pudwDictWrite->uiKeyCount == UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT) || (s_strcmp(pucDictKey, UTL_DICT_LAST_KEY_STRING) == 0) ) {
     
         unsigned long   ulKeyBlockID = 0;
         unsigned char   *pucSuperBlockPtr = NULL;
-        unsigned char   pucKeyBlockLengthBuffer[UTL_NUM_UINT_MAX_SIZE];
-        unsigned char   *pucKeyBlockLengthBufferPtr = pucKeyBlockLengthBuffer;
+        unsigned char   pucKeyBlockHeaderBuffer[(UTL_NUM_COMPRESSED_UINT_MAX_SIZE * 2) + 
+                                (UTL_DICT_KEY_BLOCK_RESTART_MAXIMUM_COUNT * UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE)];
+        unsigned char   *pucKeyBlockHeaderBufferPtr = pucKeyBlockHeaderBuffer;
+        unsigned int    uiKeyBlockRestartCountSize = 0;
+        unsigned int    uiI = 0;
         
         /* Set the key block ID from the current dict file position */
         ulKeyBlockID = s_ftell(pudUtlDict->pfFile);
 
-        /* Write the key block length */
-        pucKeyBlockLengthBufferPtr = pucKeyBlockLengthBuffer;
-        UTL_NUM_WRITE_COMPRESSED_UINT(pudUtlDict->pudwDictWrite->uiKeyBlockLength, pucKeyBlockLengthBufferPtr);
+        /* Get the compressed size of the restart count */
+        UTL_NUM_GET_COMPRESSED_UINT_SIZE(pudUtlDict->pudwDictWrite->uiKeyBlockRestartCount, uiKeyBlockRestartCountSize);
+
+        /* Write the key block length, this includes the restart table */
+        pucKeyBlockHeaderBufferPtr = pucKeyBlockHeaderBuffer;
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiKeyBlockRestartCountSize + (pudUtlDict->pudwDictWrite->uiKeyBlockRestartCount * UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE) + 
+                pudUtlDict->pudwDictWrite->uiKeyBlockLength, pucKeyBlockHeaderBufferPtr);
         
-        /* Write out the key block length to the dict file */
-        if ( s_fwrite(pucKeyBlockLengthBuffer, pucKeyBlockLengthBufferPtr - pucKeyBlockLengthBuffer, 1, pudUtlDict->pfFile) != 1 ) {
+        /* Write the restart table */
+        UTL_NUM_WRITE_COMPRESSED_UINT(pudUtlDict->pudwDictWrite->uiKeyBlockRestartCount, pucKeyBlockHeaderBufferPtr);
+        for ( uiI = 0; uiI < pudUtlDict->pudwDictWrite->uiKeyBlockRestartCount; uiI++ ) {
+            UTL_NUM_WRITE_UINT(pudUtlDict->pudwDictWrite->puiKeyBlockRestartOffsets[uiI], UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE, pucKeyBlockHeaderBufferPtr);
+        }
+
+        /* Write out the key block length and the restart table to the dict file */
+        if ( s_fwrite(pucKeyBlockHeaderBuffer, pucKeyBlockHeaderBufferPtr - pucKeyBlockHeaderBuffer, 1, pudUtlDict->pfFile) != 1 ) {
             iUtlLogError(UTL_LOG_CONTEXT, "Failed to write the dictionary key block header to the dict file."); 
             return (UTL_DictWriteFailed);
         }
@@ -579,33 +748,62 @@ int iUtlDictAddEntry
             return (UTL_DictWriteFailed);
         }
         
-        /* Set the super block pointer to the end of the last super block entry, where we write the key block ID */
-        pucSuperBlockPtr = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * (pudUtlDict->uiSuperBlockEntryCount - 1)) + pudUtlDict->uiKeyLength;
+        /* Extend the super block */
+        if ( (pucSuperBlockPtr = (unsigned char *)s_realloc(pudUtlDict->pucSuperBlock, 
+                (size_t)(sizeof(unsigned char) * pudUtlDict->uiSuperBlockEntryLength * (pudUtlDict->uiSuperBlockEntryCount + 1)))) == NULL ) {
+            return (UTL_MemError);
+        }
+
+        /* Hand over the super block pointer */
+        pudUtlDict->pucSuperBlock = pucSuperBlockPtr;
+
+        /* Set the super block pointer to the new super block entry */
+        pucSuperBlockPtr = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * pudUtlDict->uiSuperBlockEntryCount);
 
         /* Write the key block ID to the super block */
         UTL_NUM_WRITE_ULONG(ulKeyBlockID, UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE, pucSuperBlockPtr);
 
+        /* Increment the super block entry count */
+        pudUtlDict->uiSuperBlockEntryCount++;
+
         /* Reset the key block length */
         pudUtlDict->pudwDictWrite->uiKeyBlockLength = 0;
 
         /* Reset the key count */
         pudUtlDict->pudwDictWrite->uiKeyCount = 0;
 
+        /* Reset the restart count */
+        pudUtlDict->pudwDictWrite->uiKeyBlockRestartCount = 0;
+
         /* Null the saved key */
         pudUtlDict->pudwDictWrite->pucSavedKey[0] = '\0';
     }
 
 
-    /* Save the super block and write the super block ID to the header
-    ** if this is the last key
+    /* Save the super block and the FST and write the header if this is the last key
     */
     if ( s_strcmp(pucDictKey, UTL_DICT_LAST_KEY_STRING) == 0 ) {
 
         unsigned long   ulSuperBlockID = 0;
         unsigned long   ulSuperBlockLength = 0;
+        unsigned int    uiRootKeyCount = 0;
         unsigned char   pucDictHeader[UTL_DICT_HEADER_LENGTH];
         unsigned char   *pucDictHeaderPtr = pucDictHeader;
         
+
+        /* Compile the rest of the FST states along the path of the last key, and the root state */
+        if ( (iError = iUtlDictFstCompileStates(pudUtlDict, s_strlen(pudUtlDict->pudwDictWrite->pucPreviousKey), 0)) != UTL_NoError ) {
+            return (iError);
+        }
+
+        if ( (iError = iUtlDictFstCompileState(pudUtlDict, pudUtlDict->pudwDictWrite->pudfsUtlDictFstStates, 
+                &pudUtlDict->ulFstRootStateID, &uiRootKeyCount)) != UTL_NoError ) {
+            return (iError);
+        }
+
+        ASSERT(uiRootKeyCount == pudUtlDict->uiKeyCount);
+
+
         /* Get the super block ID from the current dictionary file position */
         ulSuperBlockID = s_ftell(pudUtlDict->pfFile);
 
@@ -618,11 +816,25 @@ int iUtlDictAddEntry
             return (UTL_DictWriteFailed);
         }
 
+        /* Get the FST ID from the current dictionary file position */
+        pudUtlDict->ulFstID = s_ftell(pudUtlDict->pfFile);
+
+        /* Write out the FST to the dictionary file */
+        if ( s_fwrite(pudUtlDict->pudwDictWrite->pucFst, pudUtlDict->pudwDictWrite->ulFstLength, 1, pudUtlDict->pfFile) != 1 ) {
+            iUtlLogError(UTL_LOG_CONTEXT, "Failed to write the dictionary FST to the dictionary file."); 
+            return (UTL_DictWriteFailed);
+        }
+
         /* Write the dictionary header */
         pucDictHeaderPtr = pucDictHeader;
+        UTL_NUM_WRITE_UINT(UTL_DICT_MAGIC, UTL_DICT_HEADER_MAGIC_SIZE, pucDictHeaderPtr);
+        UTL_NUM_WRITE_UINT(UTL_DICT_VERSION, UTL_DICT_HEADER_VERSION_SIZE, pucDictHeaderPtr);
         UTL_NUM_WRITE_UINT(pudUtlDict->uiKeyLength, UTL_DICT_HEADER_KEY_LENGTH_SIZE, pucDictHeaderPtr);
         UTL_NUM_WRITE_ULONG(ulSuperBlockID, UTL_DICT_HEADER_SUPER_BLOCK_ID_SIZE, pucDictHeaderPtr);
         UTL_NUM_WRITE_UINT(pudUtlDict->uiSuperBlockEntryCount, UTL_DICT_HEADER_SUPER_BLOCK_ENTRY_COUNT_SIZE, pucDictHeaderPtr);
+        UTL_NUM_WRITE_ULONG(pudUtlDict->ulFstID, UTL_DICT_HEADER_FST_ID_SIZE, pucDictHeaderPtr);
+        UTL_NUM_WRITE_ULONG(pudUtlDict->ulFstRootStateID, UTL_DICT_HEADER_FST_ROOT_STATE_ID_SIZE, pucDictHeaderPtr);
+        UTL_NUM_WRITE_UINT(pudUtlDict->uiKeyCount, UTL_DICT_HEADER_KEY_COUNT_SIZE, pucDictHeaderPtr);
         
         /* Seek to the start the dictionary file */
         if ( s_fseek(pudUtlDict->pfFile, 0, SEEK_SET) == -1 ) {
@@ -708,6 +920,22 @@ int iUtlDictClose
     /* Close the dictionary file */
     s_fclose(pudUtlDict->pfFile);
 
+    /* Release the FST build structures, the key block and the super block, which are only allocated in write mode */
+    if ( pudUtlDict->pudwDictWrite != NULL ) {
+
+        unsigned int    uiI = 0;
+
+        for ( uiI = 0; uiI < (UTL_DICT_KEY_MAXIMUM_LENGTH + 1); uiI++ ) {
+            s_free(pudUtlDict->pudwDictWrite->pudfsUtlDictFstStates[uiI].pudfaUtlDictFstArcs);
+        }
+
+        s_free(pudUtlDict->pudwDictWrite->pucFst);
+        s_free(pudUtlDict->pudwDictWrite->pulFstRegisterStateIDs);
+        s_free(pudUtlDict->pudwDictWrite->puiFstRegisterHashes);
+        s_free(pudUtlDict->pudwDictWrite->pucKeyBlock);
+        s_free(pudUtlDict->pucSuperBlock);
+    }
+
     /* Finally release the dictionary structure */
     s_free(pudUtlDict->pudwDictWrite);
     s_free(pudUtlDict);
@@ -745,6 +973,8 @@ int iUtlDictOpen
     long                iError = UTL_NoError;
     unsigned char       *pucDictHeaderPtr = NULL;
     struct utlDict      *pudUtlDict = NULL;
+    unsigned int        uiMagic = 0;
+    unsigned int        uiVersion = 0;
 
 
 /*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictOpen - pucDictFilePath: [%s]", pucDictFilePath); */
@@ -776,33 +1006,96 @@ int iUtlDictOpen
     pudUtlDict->uiSuperBlockEntryCount = 0;
     pudUtlDict->pucSuperBlock = NULL;
     pudUtlDict->uiSuperBlockEntryLength = 0;
+    pudUtlDict->ulFstID = 0;
+    pudUtlDict->ulFstRootStateID = 0;
+    pudUtlDict->pucFst = NULL;
+    pudUtlDict->uiKeyCount = 0;
 
 
     /* Open the dict file */
     if ( (pudUtlDict->pfFile = s_fopen(pucDictFilePath, "r")) == NULL ) {
         iUtlLogError(UTL_LOG_CONTEXT, "Failed to open the dictionary, dictionary file path: '%s'.", pucDictFilePath); 
-        return (UTL_DictOpenFailed);
+        iError = UTL_DictOpenFailed;
+        goto bailFromiUtlDictOpen;
     }
 
 
     /* Map the dictionary file */
     if ( (iError = iUtlDictMapFile(pudUtlDict)) != UTL_NoError ) {
-        return (iError);
+        goto bailFromiUtlDictOpen;
     }
 
 
+    /* Check that there is a dictionary header */
+    if ( pudUtlDict->zFileLength < UTL_DICT_HEADER_LENGTH ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid dictionary, the dictionary file is too short for the header, dictionary file path: '%s'.", pucDictFilePath); 
+        iError = UTL_DictInvalidDict;
+        goto bailFromiUtlDictOpen;
+    }
+
     /* Read the dictionary header */
     pucDictHeaderPtr = (unsigned char *)pudUtlDict->pvFile;
+    UTL_NUM_READ_UINT(uiMagic, UTL_DICT_HEADER_MAGIC_SIZE, pucDictHeaderPtr);
+    UTL_NUM_READ_UINT(uiVersion, UTL_DICT_HEADER_VERSION_SIZE, pucDictHeaderPtr);
+
+    /* Check the magic number and the version, dictionaries written in an older format can't be read */
+    if ( (uiMagic != UTL_DICT_MAGIC) || (uiVersion != UTL_DICT_VERSION) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid dictionary version, got: %u, expected: %u, the index needs to be rebuilt, dictionary file path: '%s'.", 
+                (uiMagic == UTL_DICT_MAGIC) ? uiVersion : 0, UTL_DICT_VERSION, pucDictFilePath); 
+        iError = UTL_DictInvalidVersion;
+        goto bailFromiUtlDictOpen;
+    }
+
     UTL_NUM_READ_UINT(pudUtlDict->uiKeyLength, UTL_DICT_HEADER_KEY_LENGTH_SIZE, pucDictHeaderPtr);
     UTL_NUM_READ_ULONG(pudUtlDict->ulSuperBlockID, UTL_DICT_HEADER_SUPER_BLOCK_ID_SIZE, pucDictHeaderPtr);
     UTL_NUM_READ_UINT(pudUtlDict->uiSuperBlockEntryCount, UTL_DICT_HEADER_SUPER_BLOCK_ENTRY_COUNT_SIZE, pucDictHeaderPtr);
+    UTL_NUM_READ_ULONG(pudUtlDict->ulFstID, UTL_DICT_HEADER_FST_ID_SIZE, pucDictHeaderPtr);
+    UTL_NUM_READ_ULONG(pudUtlDict->ulFstRootStateID, UTL_DICT_HEADER_FST_ROOT_STATE_ID_SIZE, pucDictHeaderPtr);
+    UTL_NUM_READ_UINT(pudUtlDict->uiKeyCount, UTL_DICT_HEADER_KEY_COUNT_SIZE, pucDictHeaderPtr);
+
+
+    /* Set the super block entry length */
+    pudUtlDict->uiSuperBlockEntryLength = UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE;
+
+    /* Check the header offsets against the dictionary file length, the super block is followed 
+    ** by the FST which runs to the end of the file, and the root state is inside the FST
+    */
+    if ( (pudUtlDict->uiKeyLength == 0) || (pudUtlDict->uiKeyLength > UTL_DICT_KEY_MAXIMUM_LENGTH) ||
+            (pudUtlDict->ulSuperBlockID < UTL_DICT_HEADER_LENGTH) || (pudUtlDict->ulSuperBlockID > pudUtlDict->ulFstID) ||
+            ((pudUtlDict->ulFstID - pudUtlDict->ulSuperBlockID) != ((unsigned long)pudUtlDict->uiSuperBlockEntryCount * pudUtlDict->uiSuperBlockEntryLength)) ||
+            (pudUtlDict->ulFstID >= pudUtlDict->zFileLength) || (pudUtlDict->ulFstRootStateID >= (pudUtlDict->zFileLength - pudUtlDict->ulFstID)) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid dictionary, the dictionary header does not match the dictionary file length, dictionary file path: '%s'.", pucDictFilePath); 
+        iError = UTL_DictInvalidDict;
+        goto bailFromiUtlDictOpen;
+    }
 
 
     /* Set the super block */
     pudUtlDict->pucSuperBlock = (unsigned char *)pudUtlDict->pvFile + pudUtlDict->ulSuperBlockID;
 
-    /* Set the super block entry length */
-    pudUtlDict->uiSuperBlockEntryLength = pudUtlDict->uiKeyLength + UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE;
+    /* Set the FST */
+    pudUtlDict->pucFst = (unsigned char *)pudUtlDict->pvFile + pudUtlDict->ulFstID;
+
+
+
+    /* Bail label */
+    bailFromiUtlDictOpen:
+
+
+    /* Handle the error */
+    if ( iError != UTL_NoError ) {
+
+        /* Unmap the dictionary file, ignore errors */
+        iUtlDictUnMapFile(pudUtlDict);
+
+        /* Close the dictionary file */
+        s_fclose(pudUtlDict->pfFile);
+
+        /* Release the dictionary structure */
+        s_free(pudUtlDict);
+
+        return (iError);
+    }
 
 
     /* Set the return pointer */
@@ -844,8 +1137,8 @@ int iUtlDictGetEntry
 
     int                 iError = UTL_NoError;
     struct utlDict      *pudUtlDict = (struct utlDict *)pvUtlDict;
-    unsigned char       *pucSuperBlockEntry = NULL;
-    unsigned char       *pucSuperBlockEntryPtr = NULL;
+    unsigned int        uiKeyOrdinal = 0;
+    boolean             bKeyFound = false;
     unsigned long       ulKeyBlockID = 0;
 
 
@@ -875,21 +1168,25 @@ int iUtlDictGetEntry
 
 
 
-    /* Get the super block entry for this key */
-    if ( (iError = iUtlDictGetSuperBlockEntry(pudUtlDict, pucDictKey, &pucSuperBlockEntry)) != UTL_NoError ) {
+    /* Get the ordinal of this key from the FST */
+    if ( (iError = iUtlDictFstGetKeyOrdinal(pudUtlDict, pucDictKey, &uiKeyOrdinal, &bKeyFound)) != UTL_NoError ) {
         return (iError);
     }
 
+    /* The FST tells us whether the key is there, so there is no need to look in the key block if it is not */
+    if ( bKeyFound == false ) {
+        return (UTL_DictKeyNotFound);
+    }
 
-    /* Get a pointer to the key block ID in the super block entry */
-    pucSuperBlockEntryPtr = pucSuperBlockEntry + pudUtlDict->uiKeyLength;
 
-    /* Read the key block ID from the super block entry */
-    UTL_NUM_READ_ULONG(ulKeyBlockID, UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE, pucSuperBlockEntryPtr);
+    /* Get the key block ID for this key */
+    if ( (iError = iUtlDictGetKeyBlockID(pudUtlDict, uiKeyOrdinal, &ulKeyBlockID)) != UTL_NoError ) {
+        return (iError);
+    }
 
 
-    /* Find the key in the key block entry */
-    iError = iUtlDictGetKeyBlockEntryData(pudUtlDict, ulKeyBlockID, pucDictKey, ppvDictEntryData, puiDictEntryLength);
+    /* Get the entry from the key block */
+    iError = iUtlDictGetKeyBlockEntryData(pudUtlDict, ulKeyBlockID, uiKeyOrdinal % UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT, ppvDictEntryData, puiDictEntryLength);
 
 
     return (iError);
@@ -1017,8 +1314,8 @@ int iUtlDictProcessEntryList
 
     int                 iError = UTL_NoError;
     struct utlDict      *pudUtlDict = (struct utlDict *)pvUtlDict;
-    unsigned char       *pucSuperBlockEntry = NULL;
-    unsigned char       *pucSuperBlockEntryPtr = NULL;
+    unsigned int        uiKeyOrdinal = 0;
+    boolean             bKeyFound = false;
     unsigned long       ulKeyBlockID = 0;
     va_list             ap;
 
@@ -1044,22 +1341,22 @@ int iUtlDictProcessEntryList
 
 
 
-    /* Get the super block entry for this key */
-    if ( (iError = iUtlDictGetSuperBlockEntry(pudUtlDict, pucDictKey, &pucSuperBlockEntry)) != UTL_NoError ) {
+    /* Get the ordinal of this key from the FST, or that of the last key before it if it is not there */
+    if ( (iError = iUtlDictFstGetKeyOrdinal(pudUtlDict, pucDictKey, &uiKeyOrdinal, &bKeyFound)) != UTL_NoError ) {
         return (iError);
     }
 
 
-    /* Get a pointer to the key block ID in the super block entry */
-    pucSuperBlockEntryPtr = pucSuperBlockEntry + pudUtlDict->uiKeyLength;
-
-    /* Read the key block ID from the super block entry */
-    UTL_NUM_READ_ULONG(ulKeyBlockID, UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE, pucSuperBlockEntryPtr);
+    /* Get the key block ID for that key, the list starts at the restart point preceding that key */
+    if ( (iError = iUtlDictGetKeyBlockID(pudUtlDict, uiKeyOrdinal, &ulKeyBlockID)) != UTL_NoError ) {
+        return (iError);
+    }
 
 
     /* Process the key block entry list */
     va_start(ap, iUtlDictCallBackFunction);
-    iError = iUtlDictProcessKeyBlockEntryList(pvUtlDict, ulKeyBlockID, pucDictKey, (int (*)())iUtlDictCallBackFunction, ap);
+    iError = iUtlDictProcessKeyBlockEntryList(pvUtlDict, ulKeyBlockID, uiKeyOrdinal % UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT, 
+            pucDictKey, (int (*)())iUtlDictCallBackFunction, ap);
     va_end(ap);
     
 
@@ -1118,33 +1415,21 @@ int iUtlDictList
     printf("Dictionary Super Block:\n");
 
     printf("Super Block ID: %lu, Key Length: %u, Super Block Entry Count: %u\n", pudUtlDict->ulSuperBlockID, pudUtlDict->uiKeyLength, pudUtlDict->uiSuperBlockEntryCount);
+    printf("FST ID: %lu, FST Root State ID: %lu, FST Length: %lu, Key Count: %u\n", pudUtlDict->ulFstID, pudUtlDict->ulFstRootStateID, 
+            (unsigned long)(pudUtlDict->zFileLength - pudUtlDict->ulFstID), pudUtlDict->uiKeyCount);
 
-    printf("Key                                          Key Block ID\n");
+    printf("First Key Ordinal          Key Block ID\n");
 
     /* Loop through all the super block entries */
     for ( uiI = 0, pucSuperBlockPtr = pudUtlDict->pucSuperBlock; uiI < pudUtlDict->uiSuperBlockEntryCount; uiI++ ) {
         
         unsigned long   ulKeyBlockID = 0;
 
-        /* Set the super block key block ID pointer */
-        unsigned char *pucSuperBlockKeyBlockIDPtr = pucSuperBlockPtr + pudUtlDict->uiKeyLength;
-
-        /* Read the key block ID */
-        UTL_NUM_READ_ULONG(ulKeyBlockID, UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE, pucSuperBlockKeyBlockIDPtr);
-
-        /* Print the key and the key block ID */
-        if (  s_strcmp(pucSuperBlockPtr, UTL_DICT_FIRST_KEY_STRING) == 0 ) {
-            printf(" %-40s %10lu\n", "UTL_DICT_FIRST_KEY_STRING", ulKeyBlockID);
-        }
-        else if ( s_strcmp(pucSuperBlockPtr, UTL_DICT_LAST_KEY_STRING) == 0 ) {
-            printf(" %-40s %10lu\n", "UTL_DICT_LAST_KEY_STRING", ulKeyBlockID);
-        }
-        else {
-            printf(" %-40s %10lu\n", pucSuperBlockPtr, ulKeyBlockID);
-        }
+        /* Read the key block ID, this moves the super block pointer to the next entry */
+        UTL_NUM_READ_ULONG(ulKeyBlockID, UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE, pucSuperBlockPtr);
 
-        /* Move to the next super block entry */
-        pucSuperBlockPtr += pudUtlDict->uiSuperBlockEntryLength;
+        /* Print the ordinal of the first key in the key block and the key block ID */
+        printf(" %10u               %10lu\n", uiI * UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT, ulKeyBlockID);
     }
 
     printf("\n");
@@ -1161,16 +1446,11 @@ int iUtlDictList
         unsigned char   *pucKeyBlockPtr = NULL;
         unsigned char   *pucKeyBlockEndPtr = NULL;
         unsigned int    uiKeyBlockLength = 0;
+        unsigned int    uiKeyBlockRestartCount = 0;
         unsigned char   pucKey[UTL_DICT_KEY_MAXIMUM_LENGTH + 1] = {'\0'};
 
-        /* Set the super block key block ID pointer */
-        unsigned char *pucSuperBlockKeyBlockIDPtr = pucSuperBlockPtr + pudUtlDict->uiKeyLength;
-
-        /* Read the key block ID */
-        UTL_NUM_READ_ULONG(ulKeyBlockID, UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE, pucSuperBlockKeyBlockIDPtr);
-
-        /* Move to the next super block entry */
-        pucSuperBlockPtr += pudUtlDict->uiSuperBlockEntryLength;
+        /* Read the key block ID, this moves the super block pointer to the next entry */
+        UTL_NUM_READ_ULONG(ulKeyBlockID, UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE, pucSuperBlockPtr);
 
         /* Get the key block pointer */
         pucKeyBlockPtr = (unsigned char *)pudUtlDict->pvFile + ulKeyBlockID;
@@ -1181,8 +1461,12 @@ int iUtlDictList
         /* Get the key block end pointer */
         pucKeyBlockEndPtr = pucKeyBlockPtr + uiKeyBlockLength;
 
+        /* Read the restart count and skip the restart table */
+        UTL_NUM_READ_COMPRESSED_UINT(uiKeyBlockRestartCount, pucKeyBlockPtr);
+        pucKeyBlockPtr += uiKeyBlockRestartCount * UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE;
+
         /* Nice header */
-        printf("Key Block ID: %lu, Key Block Length: %u\n", ulKeyBlockID, uiKeyBlockLength);
+        printf("Key Block ID: %lu, Key Block Length: %u, Restart Count: %u\n", ulKeyBlockID, uiKeyBlockLength, uiKeyBlockRestartCount);
         printf("Key                                          Data Length\n"); 
 
         /* Loop over the pointer until we run out */
@@ -1342,119 +1626,54 @@ static int iUtlDictUnMapFile
 
 /*
 
-    Function:   iUtlDictGetSuperBlockEntry()
+    Function:   iUtlDictGetKeyBlockID()
 
-    Purpose:    Get the super block entry where the key would be located.
+    Purpose:    Get the ID of the key block holding a key from the super
+                block, key blocks are full so this is just a matter of 
+                dividing the ordinal of the key by the key block entry count.
 
-    Parameters: pudUtlDict              dictionary structure
-                pucKey                  key
-                ppucSuperBlockEntry     return pointer for the super block entry
+    Parameters: pudUtlDict          dictionary structure
+                uiKeyOrdinal        key ordinal
+                pulKeyBlockID       return pointer for the key block ID
 
     Globals:    none
 
     Returns:    UTL error code 
 
 */
-static int iUtlDictGetSuperBlockEntry
+static int iUtlDictGetKeyBlockID
 (
     struct utlDict *pudUtlDict,
-    unsigned char *pucKey,
-    unsigned char **ppucSuperBlockEntry
+    unsigned int uiKeyOrdinal,
+    unsigned long *pulKeyBlockID
 )
 {
 
-    unsigned int    uiHigh = 0;
-    unsigned int    uiLow = 0;
     unsigned int    uiSuperBlockEntryIndex = 0;
+    unsigned char   *pucSuperBlockEntryPtr = NULL;
 
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictGetSuperBlockEntry - pucKey: [%s]", pucKey); */
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictGetKeyBlockID - uiKeyOrdinal: [%u]", uiKeyOrdinal); */
 
 
     ASSERT(pudUtlDict != NULL);
-    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
-    ASSERT(ppucSuperBlockEntry != NULL);
-
+    ASSERT(pulKeyBlockID != NULL);
 
-    /* Check to see if the key is lexically before the first key in the super block, 
-    ** remember that the super block start with the (NULL terminated) key 
-    */
-    if ( s_strcmp(pucKey, pudUtlDict->pucSuperBlock) < 0 ) {
-/*         iUtlLogDebug(UTL_LOG_CONTEXT, "Key is before the super block - key: [%s], super block key: [%s]", pucKey, pudUtlDict->pucSuperBlock); */
-        return (UTL_DictKeyNotFound);
-    }
-
-    uiHigh = pudUtlDict->uiSuperBlockEntryCount;
-    uiSuperBlockEntryIndex = (uiLow + uiHigh) / 2;
-
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "initial - uiSuperBlockEntryIndex = %u", uiSuperBlockEntryIndex); */
-
-    while ( uiLow != uiHigh ) {
-    
-        /* Get the super block entry pointer and the key, remember that the super block entry start with the key (NULL terminated) */
-        unsigned char   *pucSuperBlockEntryPtr = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * uiSuperBlockEntryIndex);
-        unsigned char   *pucKeyPtr = pucSuperBlockEntryPtr;
-        
-        /* Compare the super block key with the key */
-        int    iStatus = s_strcmp(pucKeyPtr, pucKey);
-
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "iStatus [%d] - super block key [%s]", iStatus, pucKeyPtr); */
-
-        /* Exact match */
-        if ( iStatus == 0 ) {
-            *ppucSuperBlockEntry = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * uiSuperBlockEntryIndex);
-/*             *ppucSuperBlockEntry = pucSuperBlockEntryPtr; */
-            return (UTL_NoError);
-        }
-        
-        /* Further back */
-        else if ( iStatus > 0 ) {
-
-            if ( uiHigh != uiSuperBlockEntryIndex ) {
-                uiHigh = uiSuperBlockEntryIndex;
-                uiSuperBlockEntryIndex = (uiLow + uiHigh) / 2;
-/*                 uiSuperBlockEntryIndex = uiLow + ((uiHigh - uiLow) / 2); */    /* Use this if 'uiLow + uiHigh' blows the maximum unsigned int and wraps around */
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "(iStatus > 0) - uiSuperBlockEntryIndex = %u", uiSuperBlockEntryIndex); */
-            } 
-            else {
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "(iStatus > 0) - match - super block key [%s]", pucKeyPtr); */
-                *ppucSuperBlockEntry = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * (uiSuperBlockEntryIndex - 1));
-/*                 *ppucSuperBlockEntry = pucSuperBlockEntryPtr - pudUtlDict->uiSuperBlockEntryLength; */
-                return (UTL_NoError);
-            }
-        }
-        
-        /* Further along */
-        else if ( iStatus < 0 ) {
-
-            if ( uiLow != uiSuperBlockEntryIndex ) {
-                uiLow = uiSuperBlockEntryIndex;
-                uiSuperBlockEntryIndex = (0.5 + uiLow + uiHigh) / 2;
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "(iStatus < 0) - uiSuperBlockEntryIndex = %u", uiSuperBlockEntryIndex); */
-            } 
-            else {
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "(iStatus < 0) - match - super block key [%s]", pucKeyPtr); */
-                *ppucSuperBlockEntry = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * uiSuperBlockEntryIndex);
-/*                 *ppucSuperBlockEntry = pucSuperBlockEntryPtr; */
-                return (UTL_NoError);
-            }
-        }
-    }
 
+    /* Get the super block entry index */
+    uiSuperBlockEntryIndex = uiKeyOrdinal / UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT;
 
-    /* Found the block */
-    if ( uiSuperBlockEntryIndex != 0 ) {
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "(uiSuperBlockEntryIndex != 0) "); */
-        *ppucSuperBlockEntry = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * (uiSuperBlockEntryIndex - 1));
-/*         *ppucSuperBlockEntry = pucSuperBlockEntryPtr - pudUtlDict->uiSuperBlockEntryLength; */
-        return (UTL_NoError);
+    /* Check the super block entry index, this should never happen */
+    if ( uiSuperBlockEntryIndex >= pudUtlDict->uiSuperBlockEntryCount ) {
+        return (UTL_DictKeyNotFound);
     }
 
-    /* Fall through, this should never happen */            
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "(uiSuperBlockEntryIndex == 0)"); */
+    /* Read the key block ID from the super block entry */
+    pucSuperBlockEntryPtr = pudUtlDict->pucSuperBlock + (pudUtlDict->uiSuperBlockEntryLength * uiSuperBlockEntryIndex);
+    UTL_NUM_READ_ULONG(*pulKeyBlockID, UTL_DICT_SUPER_BLOCK_KEY_BLOCK_ID_SIZE, pucSuperBlockEntryPtr);
 
 
-    return (UTL_DictKeyNotFound);
+    return (UTL_NoError);
 
 }
 
@@ -1466,13 +1685,17 @@ static int iUtlDictGetSuperBlockEntry
 
     Function:   iUtlDictGetKeyBlockEntryData()
 
-    Purpose:    Get the entry data from the key block for the key.
+    Purpose:    Get the entry data from the key block for the key at the 
+                key block entry index. The FST has already told us that the
+                key is there, so we start at the restart point preceding it
+                and skip over the entries in between without rebuilding their
+                keys.
 
-    Parameters: pvUtlDict           dictionary structure
-                ulKeyBlockID        key block ID
-                pucKey              key
-                ppvEntryData        return pointer for the entry data
-                puiEntryLength      return pointer for the entry length
+    Parameters: pvUtlDict               dictionary structure
+                ulKeyBlockID            key block ID
+                uiKeyBlockEntryIndex    key block entry index
+                ppvEntryData            return pointer for the entry data
+                puiEntryLength          return pointer for the entry length
 
     Globals:    none
 
@@ -1483,7 +1706,7 @@ static int iUtlDictGetKeyBlockEntryData
 (
     struct utlDict *pudUtlDict,
     unsigned long ulKeyBlockID,
-    unsigned char *pucKey,
+    unsigned int uiKeyBlockEntryIndex,
     void **ppvEntryData,
     unsigned int *puiEntryLength
     
@@ -1491,88 +1714,146 @@ static int iUtlDictGetKeyBlockEntryData
 {
 
 
-    unsigned int    uiKeyBlockLength = 0;
     unsigned char   *pucKeyBlockPtr = NULL;
     unsigned char   *pucKeyBlockEndPtr = NULL;
-    unsigned int    uiKeyLength = 0;
-    unsigned int    uiKeyIndentLength = 0;
-    unsigned char   pucLocalKey[UTL_DICT_KEY_MAXIMUM_LENGTH + 1] = {'\0'};
-    unsigned char   *pucLocalKeyPtr = NULL;
     unsigned int    uiEntryLength = 0;
-    int             iStatus = 0;
+    unsigned int    uiI = 0;
+    int             iError = UTL_NoError;
 
 
-/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictGetKeyBlockEntryData - ulKeyBlockID: [%lu], pucKey: [%s]", ulKeyBlockID, pucKey); */
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictGetKeyBlockEntryData - ulKeyBlockID: [%lu], uiKeyBlockEntryIndex: [%u]", ulKeyBlockID, uiKeyBlockEntryIndex); */
 
 
     ASSERT(pudUtlDict != NULL);
     ASSERT(ulKeyBlockID > 0);
-    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(uiKeyBlockEntryIndex < UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT);
     ASSERT(ppvEntryData != NULL);
     ASSERT(puiEntryLength != NULL);
 
 
-    /* Get the key length */
-    uiKeyLength = s_strlen(pucKey);
-
+    /* Get the restart point preceding the entry */
+    if ( (iError = iUtlDictGetKeyBlockRestartPoint(pudUtlDict, ulKeyBlockID, uiKeyBlockEntryIndex, &pucKeyBlockPtr, &pucKeyBlockEndPtr)) != UTL_NoError ) {
+        return (iError);
+    }
 
-    /* Set the key block pointer */
-    pucKeyBlockPtr = (unsigned char *)pudUtlDict->pvFile + ulKeyBlockID;
-    
-    /* Read the key block length */
-    UTL_NUM_READ_COMPRESSED_UINT(uiKeyBlockLength, pucKeyBlockPtr);
-    
-    /* Set the key block end pointer */
-    pucKeyBlockEndPtr = pucKeyBlockPtr + uiKeyBlockLength;
 
+    /* Loop over the entries from the restart point up to and including the one we want */
+    for ( uiI = uiKeyBlockEntryIndex - (uiKeyBlockEntryIndex % UTL_DICT_KEY_BLOCK_RESTART_INTERVAL); uiI <= uiKeyBlockEntryIndex; uiI++ ) {
 
-    /* Loop while we are in the key block */
-    do {
+        /* Check that we are still in the key block, this should never happen */
+        if ( pucKeyBlockPtr >= pucKeyBlockEndPtr ) {
+            return (UTL_DictKeyNotFound);
+        }
 
-        /* Read the key indent length */
-        UTL_NUM_READ_COMPRESSED_UINT(uiKeyIndentLength, pucKeyBlockPtr);
+        /* Skip the key indent length */
+        UTL_NUM_SKIP_COMPRESSED_UINT(pucKeyBlockPtr);
         
-        /* Copy the key delta to the local key starting at the indent in the local key,
-        ** the copy is done character by character because this is much faster than s_strnncpy()
-        */
-        for ( pucLocalKeyPtr = pucLocalKey + uiKeyIndentLength; *pucKeyBlockPtr != '\0'; pucLocalKeyPtr++, pucKeyBlockPtr++ ) {
-            *pucLocalKeyPtr = *pucKeyBlockPtr;
+        /* Skip the key delta, including the terminating NULL */
+        while ( *pucKeyBlockPtr != '\0' ) {
+            pucKeyBlockPtr++;
         }
-    
-        /* NULL terminate the local key */
-        *pucLocalKeyPtr = '\0';
-
-        /* Increment the key block pointer past the end of the key delta */
         pucKeyBlockPtr++;
 
         /* Read the entry length, after which pucKeyBlockPtr will point to the entry data */
         UTL_NUM_READ_COMPRESSED_UINT(uiEntryLength, pucKeyBlockPtr);
 
+        /* Skip over the entry data if this is not the entry we want */
+        if ( uiI < uiKeyBlockEntryIndex ) {
+            pucKeyBlockPtr += uiEntryLength;
+        }
+    }
 
-        /* And check the local key against the key we are looking for, 
-        ** first check that they are the same length before calling s_strcmp()
-        */
-        if ( (uiKeyLength == (pucLocalKeyPtr - pucLocalKey)) && (iStatus = s_strcmp(pucKey, pucLocalKey)) == 0 ) {
-
-/*             iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictGetKeyBlockEntryData - Key [%s]", pucLocalKey); */
 
-            /* This is the key we are looking for, so we set the return pointers and return */
-            *ppvEntryData = pucKeyBlockPtr;
-            *puiEntryLength = uiEntryLength;
+    /* Set the return pointers */
+    *ppvEntryData = pucKeyBlockPtr;
+    *puiEntryLength = uiEntryLength;
             
-            return (UTL_NoError);
-        }
 
-/* iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictGetKeyBlockEntryData - Key [%s][%d]", pucLocalKey, s_strcmp(pucLocalKey, UTL_DICT_LAST_KEY_FLAG)); */
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlDictGetKeyBlockRestartPoint()
+
+    Purpose:    Get a pointer to the restart point preceding the key block
+                entry index in a key block, along with a pointer to the end 
+                of the key block.
+
+    Parameters: pvUtlDict               dictionary structure
+                ulKeyBlockID            key block ID
+                uiKeyBlockEntryIndex    key block entry index
+                ppucKeyBlockEntryPtr    return pointer for the key block entry pointer
+                ppucKeyBlockEndPtr      return pointer for the key block end pointer
+
+    Globals:    none
+
+    Returns:    UTL error code 
+
+*/
+static int iUtlDictGetKeyBlockRestartPoint
+(
+    struct utlDict *pudUtlDict,
+    unsigned long ulKeyBlockID,
+    unsigned int uiKeyBlockEntryIndex,
+    unsigned char **ppucKeyBlockEntryPtr,
+    unsigned char **ppucKeyBlockEndPtr
+)
+{
+
+    unsigned int    uiKeyBlockLength = 0;
+    unsigned char   *pucKeyBlockPtr = NULL;
+    unsigned char   *pucKeyBlockEndPtr = NULL;
+    unsigned int    uiKeyBlockRestartCount = 0;
+    unsigned int    uiKeyBlockRestartIndex = 0;
+    unsigned int    uiKeyBlockRestartOffset = 0;
+    unsigned char   *pucKeyBlockRestartPtr = NULL;
+
 
-        /* We failed to make a match, so we skip over the entry data */
-        pucKeyBlockPtr += uiEntryLength;
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictGetKeyBlockRestartPoint - ulKeyBlockID: [%lu], uiKeyBlockEntryIndex: [%u]", ulKeyBlockID, uiKeyBlockEntryIndex); */
 
-    } while ( (iStatus >= 0) && (pucKeyBlockPtr < pucKeyBlockEndPtr) );    
 
+    ASSERT(pudUtlDict != NULL);
+    ASSERT(ulKeyBlockID > 0);
+    ASSERT(uiKeyBlockEntryIndex < UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT);
+    ASSERT(ppucKeyBlockEntryPtr != NULL);
+    ASSERT(ppucKeyBlockEndPtr != NULL);
 
-    /* We dropped out of the loop, so the key was not found */
-    return (UTL_DictKeyNotFound);
+
+    /* Set the key block pointer */
+    pucKeyBlockPtr = (unsigned char *)pudUtlDict->pvFile + ulKeyBlockID;
+    
+    /* Read the key block length */
+    UTL_NUM_READ_COMPRESSED_UINT(uiKeyBlockLength, pucKeyBlockPtr);
+    
+    /* Set the key block end pointer */
+    pucKeyBlockEndPtr = pucKeyBlockPtr + uiKeyBlockLength;
+
+    /* Read the restart count */
+    UTL_NUM_READ_COMPRESSED_UINT(uiKeyBlockRestartCount, pucKeyBlockPtr);
+
+    /* Get the restart index for this entry, checking that it is in the key block, this should never happen */
+    uiKeyBlockRestartIndex = uiKeyBlockEntryIndex / UTL_DICT_KEY_BLOCK_RESTART_INTERVAL;
+    if ( uiKeyBlockRestartIndex >= uiKeyBlockRestartCount ) {
+        return (UTL_DictKeyNotFound);
+    }
+
+    /* Read the restart offset */
+    pucKeyBlockRestartPtr = pucKeyBlockPtr + (uiKeyBlockRestartIndex * UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE);
+    UTL_NUM_READ_UINT(uiKeyBlockRestartOffset, UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE, pucKeyBlockRestartPtr);
+
+
+    /* Set the return pointers, the restart offset is from the first key block entry, which follows the restart table */
+    *ppucKeyBlockEntryPtr = pucKeyBlockPtr + (uiKeyBlockRestartCount * UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE) + uiKeyBlockRestartOffset;
+    *ppucKeyBlockEndPtr = pucKeyBlockEndPtr;
+
+
+    return (UTL_NoError);
 
 }
 
@@ -1599,8 +1880,13 @@ static int iUtlDictGetKeyBlockEntryData
                 The call-back function needs to return 0 to keep processing or
                 non-zero to stop processing.
                 
+                Processing starts at the restart point preceding the key 
+                block entry index in the first key block, and carries on
+                through the key blocks that follow.
+
     Parameters: pvUtlDict                   dictionary structure
                 ulKeyBlockID                key block ID
+                uiKeyBlockEntryIndex        key block entry index
                 pucKey                      key
                 iUtlDictCallBackFunction    lookup call back function
                 ap                          arg list (optional)
@@ -1614,6 +1900,7 @@ static int iUtlDictProcessKeyBlockEntryList
 (
     struct utlDict *pudUtlDict,
     unsigned long ulKeyBlockID,
+    unsigned int uiKeyBlockEntryIndex,
     unsigned char *pucKey,
     int (*iUtlDictCallBackFunction)(),
     va_list ap
@@ -1621,6 +1908,7 @@ static int iUtlDictProcessKeyBlockEntryList
 {
 
     unsigned int    uiKeyBlockLength = 0;
+    unsigned int    uiKeyBlockRestartCount = 0;
     unsigned char   *pucKeyBlockPtr = NULL;
     unsigned char   *pucKeyBlockEndPtr = NULL;
     unsigned int    uiKeyIndentLength = 0;
@@ -1629,6 +1917,7 @@ static int iUtlDictProcessKeyBlockEntryList
     void            *pvEntryData = 0;
     unsigned int    uiEntryLength = 0;
     int             iStatus = 0;
+    int             iError = UTL_NoError;
 
 
 /*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictProcessKeyBlockEntryList - ulKeyBlockID: [%lu], pucKey: [%s]", ulKeyBlockID, pucKey); */
@@ -1636,12 +1925,15 @@ static int iUtlDictProcessKeyBlockEntryList
 
     ASSERT(pudUtlDict != NULL);
     ASSERT(ulKeyBlockID > 0);
+    ASSERT(uiKeyBlockEntryIndex < UTL_DICT_KEY_BLOCK_ENTRY_MAXIMUM_COUNT);
     ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
     ASSERT(iUtlDictCallBackFunction != NULL);
 
 
-    /* Set the key block pointer */
-    pucKeyBlockPtr = (unsigned char *)pudUtlDict->pvFile + ulKeyBlockID;
+    /* Get the restart point preceding the entry in the first key block */
+    if ( (iError = iUtlDictGetKeyBlockRestartPoint(pudUtlDict, ulKeyBlockID, uiKeyBlockEntryIndex, &pucKeyBlockPtr, &pucKeyBlockEndPtr)) != UTL_NoError ) {
+        return (iError);
+    }
     
 
     /* Loop while there are keys to be found, the call back function will tell us
@@ -1651,11 +1943,19 @@ static int iUtlDictProcessKeyBlockEntryList
     */
     while ( true ) {
 
-        /* Read the key block length */
-        UTL_NUM_READ_COMPRESSED_UINT(uiKeyBlockLength, pucKeyBlockPtr);
-    
-        /* Set the key block end pointer */
-        pucKeyBlockEndPtr = pucKeyBlockPtr + uiKeyBlockLength;
+        /* Move to the next key block if we have reached the end of this one */
+        if ( pucKeyBlockPtr >= pucKeyBlockEndPtr ) {
+
+            /* Read the key block length */
+            UTL_NUM_READ_COMPRESSED_UINT(uiKeyBlockLength, pucKeyBlockPtr);
+        
+            /* Set the key block end pointer */
+            pucKeyBlockEndPtr = pucKeyBlockPtr + uiKeyBlockLength;
+
+            /* Read the restart count and skip the restart table */
+            UTL_NUM_READ_COMPRESSED_UINT(uiKeyBlockRestartCount, pucKeyBlockPtr);
+            pucKeyBlockPtr += uiKeyBlockRestartCount * UTL_DICT_KEY_BLOCK_RESTART_OFFSET_SIZE;
+        }
 
 
         /* Loop while we are still in the key block */
@@ -1720,4 +2020,486 @@ static int iUtlDictProcessKeyBlockEntryList
 }
 
 
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlDictFstAddKey()
+
+    Purpose:    Add a key to the FST being built, keys need to be added in 
+                increasing order. The states along the path of the previous
+                key beyond the prefix it shares with this key cannot change
+                any more so they get compiled, after which the path for the
+                rest of this key is added.
+
+    Parameters: pudUtlDict      dictionary structure
+                pucKey          key
+
+    Globals:    none
+
+    Returns:    UTL error code 
+
+*/
+static int iUtlDictFstAddKey
+(
+    struct utlDict *pudUtlDict,
+    unsigned char *pucKey
+)
+{
+
+    int                     iError = UTL_NoError;
+    struct utlDictWrite     *pudwDictWrite = NULL;
+    unsigned int            uiKeyLength = 0;
+    unsigned int            uiPreviousKeyLength = 0;
+    unsigned int            uiPrefixLength = 0;
+    unsigned int            uiI = 0;
+
+
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictFstAddKey - pucKey: [%s]", pucKey); */
+
+
+    ASSERT(pudUtlDict != NULL);
+    ASSERT(pudUtlDict->pudwDictWrite != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(s_strcmp(pudUtlDict->pudwDictWrite->pucPreviousKey, pucKey) < 0);
+
+
+    /* Dereference the dictionary write structure */
+    pudwDictWrite = pudUtlDict->pudwDictWrite;
+
+    /* Get the key lengths */
+    uiKeyLength = s_strlen(pucKey);
+    uiPreviousKeyLength = s_strlen(pudwDictWrite->pucPreviousKey);
+
+
+    /* Get the length of the prefix this key shares with the previous key */
+    for ( uiPrefixLength = 0; (uiPrefixLength < uiKeyLength) && (uiPrefixLength < uiPreviousKeyLength) && 
+            (pucKey[uiPrefixLength] == pudwDictWrite->pucPreviousKey[uiPrefixLength]); uiPrefixLength++ ) {
+        ;
+    }
+
+
+    /* Compile the states along the path of the previous key beyond the shared prefix */
+    if ( (iError = iUtlDictFstCompileStates(pudUtlDict, uiPreviousKeyLength, uiPrefixLength)) != UTL_NoError ) {
+        return (iError);
+    }
+
+
+    /* Add the path for the rest of this key, an arc from each state to the next one */
+    for ( uiI = uiPrefixLength; uiI < uiKeyLength; uiI++ ) {
+
+        struct utlDictFstState  *pudfsUtlDictFstState = pudwDictWrite->pudfsUtlDictFstStates + uiI;
+        struct utlDictFstArc    *pudfaUtlDictFstArc = NULL;
+
+        /* Extend the arcs if needed */
+        if ( pudfsUtlDictFstState->uiUtlDictFstArcsLength == pudfsUtlDictFstState->uiUtlDictFstArcsCapacity ) {
+
+            unsigned int            uiUtlDictFstArcsCapacity = UTL_MACROS_MIN(UTL_MACROS_MAX(pudfsUtlDictFstState->uiUtlDictFstArcsCapacity * 2, 4), 
+                    UTL_DICT_FST_ARC_MAXIMUM_COUNT);
+            struct utlDictFstArc    *pudfaUtlDictFstArcs = NULL;
+
+            if ( (pudfaUtlDictFstArcs = (struct utlDictFstArc *)s_realloc(pudfsUtlDictFstState->pudfaUtlDictFstArcs, 
+                    (size_t)(sizeof(struct utlDictFstArc) * uiUtlDictFstArcsCapacity))) == NULL ) {
+                return (UTL_MemError);
+            }
+
+            pudfsUtlDictFstState->pudfaUtlDictFstArcs = pudfaUtlDictFstArcs;
+            pudfsUtlDictFstState->uiUtlDictFstArcsCapacity = uiUtlDictFstArcsCapacity;
+        }
+
+        /* Add the arc, its target gets set when the next state is compiled */
+        pudfaUtlDictFstArc = pudfsUtlDictFstState->pudfaUtlDictFstArcs + pudfsUtlDictFstState->uiUtlDictFstArcsLength;
+        pudfaUtlDictFstArc->ucLabel = pucKey[uiI];
+        pudfaUtlDictFstArc->ulTargetStateID = 0;
+        pudfaUtlDictFstArc->uiTargetKeyCount = 0;
+        pudfsUtlDictFstState->uiUtlDictFstArcsLength++;
+
+        /* Reset the next state */
+        pudwDictWrite->pudfsUtlDictFstStates[uiI + 1].bFinal = false;
+        pudwDictWrite->pudfsUtlDictFstStates[uiI + 1].uiUtlDictFstArcsLength = 0;
+    }
+
+    /* The key ends at the last state */
+    pudwDictWrite->pudfsUtlDictFstStates[uiKeyLength].bFinal = true;
+
+
+    /* Save this key, this becomes our previous key next time around */
+    s_strnncpy(pudwDictWrite->pucPreviousKey, pucKey, UTL_DICT_KEY_MAXIMUM_LENGTH + 1);
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlDictFstCompileStates()
+
+    Purpose:    Compile the FST states along the path of the previous key 
+                from a depth back to a depth, deepest first, setting the 
+                target of the last arc of the parent state of each state 
+                as we go.
+
+    Parameters: pudUtlDict      dictionary structure
+                uiFromDepth     depth to compile from
+                uiToDepth       depth to compile to (not included)
+
+    Globals:    none
+
+    Returns:    UTL error code 
+
+*/
+static int iUtlDictFstCompileStates
+(
+    struct utlDict *pudUtlDict,
+    unsigned int uiFromDepth,
+    unsigned int uiToDepth
+)
+{
+
+    int             iError = UTL_NoError;
+    unsigned int    uiDepth = 0;
+
+
+    ASSERT(pudUtlDict != NULL);
+    ASSERT(pudUtlDict->pudwDictWrite != NULL);
+    ASSERT(uiFromDepth >= uiToDepth);
+
+
+    /* Loop over the states, deepest first */
+    for ( uiDepth = uiFromDepth; uiDepth > uiToDepth; uiDepth-- ) {
+
+        struct utlDictFstState  *pudfsUtlDictFstStateParent = pudUtlDict->pudwDictWrite->pudfsUtlDictFstStates + (uiDepth - 1);
+        struct utlDictFstArc    *pudfaUtlDictFstArc = NULL;
+
+        ASSERT(pudfsUtlDictFstStateParent->uiUtlDictFstArcsLength > 0);
+
+        /* Get the last arc of the parent state, this is the one leading to the state */
+        pudfaUtlDictFstArc = pudfsUtlDictFstStateParent->pudfaUtlDictFstArcs + (pudfsUtlDictFstStateParent->uiUtlDictFstArcsLength - 1);
+
+        /* Compile the state, setting the arc target */
+        if ( (iError = iUtlDictFstCompileState(pudUtlDict, pudUtlDict->pudwDictWrite->pudfsUtlDictFstStates + uiDepth, 
+                &pudfaUtlDictFstArc->ulTargetStateID, &pudfaUtlDictFstArc->uiTargetKeyCount)) != UTL_NoError ) {
+            return (iError);
+        }
+    }
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlDictFstCompileState()
+
+    Purpose:    Compile an FST state. The state is encoded and looked up in
+                the register of compiled states, reusing the compiled state 
+                if there is one with the same encoding, or adding it to the 
+                FST and the register if not, which is what keeps the FST 
+                minimal. The state is reset once it is compiled.
+
+                Two states have the same encoding if and only if they have 
+                the same final flag and the same arcs leading to the same 
+                compiled states, the outputs only depend on the targets.
+
+    Parameters: pudUtlDict              dictionary structure
+                pudfsUtlDictFstState    FST state
+                pulStateID              return pointer for the compiled state ID
+                puiKeyCount             return pointer for the number of keys reachable from the state
+
+    Globals:    none
+
+    Returns:    UTL error code 
+
+*/
+static int iUtlDictFstCompileState
+(
+    struct utlDict *pudUtlDict,
+    struct utlDictFstState *pudfsUtlDictFstState, 
+    unsigned long *pulStateID,
+    unsigned int *puiKeyCount
+)
+{
+
+    struct utlDictWrite     *pudwDictWrite = NULL;
+    unsigned char           pucState[UTL_DICT_FST_STATE_MAXIMUM_LENGTH];
+    unsigned char           *pucStatePtr = pucState;
+    unsigned int            uiStateLength = 0;
+    unsigned int            uiKeyCount = 0;
+    unsigned int            uiOutput = 0;
+    unsigned int            uiHash = 0;
+    unsigned long           ulRegisterIndex = 0;
+    unsigned long           ulStateID = 0;
+    unsigned int            uiI = 0;
+
+
+    ASSERT(pudUtlDict != NULL);
+    ASSERT(pudUtlDict->pudwDictWrite != NULL);
+    ASSERT(pudfsUtlDictFstState != NULL);
+    ASSERT(pulStateID != NULL);
+    ASSERT(puiKeyCount != NULL);
+
+
+    /* Dereference the dictionary write structure */
+    pudwDictWrite = pudUtlDict->pudwDictWrite;
+
+
+    /* Count the keys reachable from the state */
+    uiKeyCount = (pudfsUtlDictFstState->bFinal == true) ? 1 : 0;
+    for ( uiI = 0; uiI < pudfsUtlDictFstState->uiUtlDictFstArcsLength; uiI++ ) {
+        uiKeyCount += pudfsUtlDictFstState->pudfaUtlDictFstArcs[uiI].uiTargetKeyCount;
+    }
+
+
+    /* Encode the state, the key ending at the state sorts before the keys reached through the arcs */
+    UTL_NUM_WRITE_COMPRESSED_UINT(((pudfsUtlDictFstState->uiUtlDictFstArcsLength << 1) | ((pudfsUtlDictFstState->bFinal == true) ? 1 : 0)), pucStatePtr);
+    UTL_NUM_WRITE_COMPRESSED_UINT(uiKeyCount, pucStatePtr);
+
+    for ( uiI = 0, uiOutput = (pudfsUtlDictFstState->bFinal == true) ? 1 : 0; uiI < pudfsUtlDictFstState->uiUtlDictFstArcsLength; uiI++ ) {
+        *pucStatePtr = pudfsUtlDictFstState->pudfaUtlDictFstArcs[uiI].ucLabel;
+        pucStatePtr++;
+        UTL_NUM_WRITE_COMPRESSED_UINT(uiOutput, pucStatePtr);
+        UTL_NUM_WRITE_COMPRESSED_ULONG(pudfsUtlDictFstState->pudfaUtlDictFstArcs[uiI].ulTargetStateID, pucStatePtr);
+        uiOutput += pudfsUtlDictFstState->pudfaUtlDictFstArcs[uiI].uiTargetKeyCount;
+    }
+
+    uiStateLength = pucStatePtr - pucState;
+
+    ASSERT(uiStateLength <= UTL_DICT_FST_STATE_MAXIMUM_LENGTH);
+
+
+    /* Reset the state */
+    pudfsUtlDictFstState->bFinal = false;
+    pudfsUtlDictFstState->uiUtlDictFstArcsLength = 0;
+
+
+    /* Hash the encoded state (FNV-1a) */
+    for ( uiI = 0, uiHash = 2166136261U; uiI < uiStateLength; uiI++ ) {
+        uiHash = (uiHash ^ pucState[uiI]) * 16777619U;
+    }
+
+
+    /* Look for the state in the register, we are done if it is there */
+    if ( pudwDictWrite->ulFstRegisterLength > 0 ) {
+
+        for ( ulRegisterIndex = uiHash & (pudwDictWrite->ulFstRegisterLength - 1); pudwDictWrite->pulFstRegisterStateIDs[ulRegisterIndex] != 0; 
+                ulRegisterIndex = (ulRegisterIndex + 1) & (pudwDictWrite->ulFstRegisterLength - 1) ) {
+            
+            ulStateID = pudwDictWrite->pulFstRegisterStateIDs[ulRegisterIndex] - 1;
+            
+            if ( (pudwDictWrite->puiFstRegisterHashes[ulRegisterIndex] == uiHash) && ((ulStateID + uiStateLength) <= pudwDictWrite->ulFstLength) &&
+                    (s_memcmp(pudwDictWrite->pucFst + ulStateID, pucState, uiStateLength) == 0) ) {
+                *pulStateID = ulStateID;
+                *puiKeyCount = uiKeyCount;
+                return (UTL_NoError);
+            }
+        }
+    }
+
+
+    /* Extend the register if it is getting full, keeping it at most half full */
+    if ( ((pudwDictWrite->ulFstRegisterCount + 1) * 2) > pudwDictWrite->ulFstRegisterLength ) {
+
+        unsigned long   ulFstRegisterLength = UTL_MACROS_MAX(pudwDictWrite->ulFstRegisterLength * 2, UTL_DICT_FST_REGISTER_LENGTH_INITIAL);
+        unsigned long   *pulFstRegisterStateIDs = NULL;
+        unsigned int    *puiFstRegisterHashes = NULL;
+        unsigned long   ulI = 0;
+
+        if ( (pulFstRegisterStateIDs = (unsigned long *)s_malloc((size_t)(sizeof(unsigned long) * ulFstRegisterLength))) == NULL ) {
+            return (UTL_MemError);
+        }
+
+        if ( (puiFstRegisterHashes = (unsigned int *)s_malloc((size_t)(sizeof(unsigned int) * ulFstRegisterLength))) == NULL ) {
+            s_free(pulFstRegisterStateIDs);
+            return (UTL_MemError);
+        }
+
+        /* Rehash the register into the new register */
+        for ( ulI = 0; ulI < pudwDictWrite->ulFstRegisterLength; ulI++ ) {
+            if ( pudwDictWrite->pulFstRegisterStateIDs[ulI] != 0 ) {
+                for ( ulRegisterIndex = pudwDictWrite->puiFstRegisterHashes[ulI] & (ulFstRegisterLength - 1); pulFstRegisterStateIDs[ulRegisterIndex] != 0; 
+                        ulRegisterIndex = (ulRegisterIndex + 1) & (ulFstRegisterLength - 1) ) {
+                    ;
+                }
+                pulFstRegisterStateIDs[ulRegisterIndex] = pudwDictWrite->pulFstRegisterStateIDs[ulI];
+                puiFstRegisterHashes[ulRegisterIndex] = pudwDictWrite->puiFstRegisterHashes[ulI];
+            }
+        }
+
+        /* Hand over the new register */
+        s_free(pudwDictWrite->pulFstRegisterStateIDs);
+        s_free(pudwDictWrite->puiFstRegisterHashes);
+        pudwDictWrite->pulFstRegisterStateIDs = pulFstRegisterStateIDs;
+        pudwDictWrite->puiFstRegisterHashes = puiFstRegisterHashes;
+        pudwDictWrite->ulFstRegisterLength = ulFstRegisterLength;
+    }
+
+
+    /* Extend the FST if needed */
+    if ( (pudwDictWrite->ulFstLength + uiStateLength) > pudwDictWrite->ulFstCapacity ) {
+
+        unsigned long   ulFstCapacity = UTL_MACROS_MAX(pudwDictWrite->ulFstCapacity * 2, UTL_DICT_FST_LENGTH_INITIAL) + uiStateLength;
+        unsigned char   *pucFst = NULL;
+
+        if ( (pucFst = (unsigned char *)s_realloc(pudwDictWrite->pucFst, (size_t)(sizeof(unsigned char) * ulFstCapacity))) == NULL ) {
+            return (UTL_MemError);
+        }
+
+        pudwDictWrite->pucFst = pucFst;
+        pudwDictWrite->ulFstCapacity = ulFstCapacity;
+    }
+
+
+    /* Add the state to the FST */
+    ulStateID = pudwDictWrite->ulFstLength;
+    s_memcpy(pudwDictWrite->pucFst + ulStateID, pucState, uiStateLength);
+    pudwDictWrite->ulFstLength += uiStateLength;
+
+
+    /* Add the state to the register, the slot we need is the next empty one */
+    for ( ulRegisterIndex = uiHash & (pudwDictWrite->ulFstRegisterLength - 1); pudwDictWrite->pulFstRegisterStateIDs[ulRegisterIndex] != 0; 
+            ulRegisterIndex = (ulRegisterIndex + 1) & (pudwDictWrite->ulFstRegisterLength - 1) ) {
+        ;
+    }
+    pudwDictWrite->pulFstRegisterStateIDs[ulRegisterIndex] = ulStateID + 1;
+    pudwDictWrite->puiFstRegisterHashes[ulRegisterIndex] = uiHash;
+    pudwDictWrite->ulFstRegisterCount++;
+
+
+    /* Set the return pointers */
+    *pulStateID = ulStateID;
+    *puiKeyCount = uiKeyCount;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlDictFstGetKeyOrdinal()
+
+    Purpose:    Get the ordinal of a key by walking the FST from the root 
+                state, adding up the arc outputs along the way. If the key
+                is not in the dictionary, this gets the ordinal of the last
+                key which sorts before it, which is where range and prefix 
+                lookups start.
+
+    Parameters: pudUtlDict          dictionary structure
+                pucKey              key
+                puiKeyOrdinal       return pointer for the key ordinal
+                pbKeyFound          return pointer set to true if the key was found
+
+    Globals:    none
+
+    Returns:    UTL error code 
+
+*/
+static int iUtlDictFstGetKeyOrdinal
+(
+    struct utlDict *pudUtlDict,
+    unsigned char *pucKey,
+    unsigned int *puiKeyOrdinal,
+    boolean *pbKeyFound
+)
+{
+
+    unsigned char   *pucStatePtr = NULL;
+    unsigned char   *pucKeyPtr = NULL;
+    unsigned int    uiArcCountAndFinal = 0;
+    unsigned int    uiArcCount = 0;
+    unsigned int    uiStateKeyCount = 0;
+    unsigned char   ucLabel = '\0';
+    unsigned int    uiOutput = 0;
+    unsigned long   ulTargetStateID = 0;
+    unsigned int    uiKeyRank = 0;
+    boolean         bKeyFound = false;
+    unsigned int    uiI = 0;
+
+
+/*     iUtlLogDebug(UTL_LOG_CONTEXT, "iUtlDictFstGetKeyOrdinal - pucKey: [%s]", pucKey); */
+
+
+    ASSERT(pudUtlDict != NULL);
+    ASSERT(pudUtlDict->pucFst != NULL);
+    ASSERT(bUtlStringsIsStringNULL(pucKey) == false);
+    ASSERT(puiKeyOrdinal != NULL);
+    ASSERT(pbKeyFound != NULL);
+
+
+    /* Walk the FST, adding up the number of keys which sort before the key */
+    for ( pucStatePtr = pudUtlDict->pucFst + pudUtlDict->ulFstRootStateID, pucKeyPtr = pucKey; ; pucKeyPtr++ ) {
+
+        /* Read the state header */
+        UTL_NUM_READ_COMPRESSED_UINT(uiArcCountAndFinal, pucStatePtr);
+        UTL_NUM_READ_COMPRESSED_UINT(uiStateKeyCount, pucStatePtr);
+
+        /* We are at the end of the key, it is there if a key ends at this state */
+        if ( *pucKeyPtr == '\0' ) {
+            bKeyFound = (uiArcCountAndFinal & 1) ? true : false;
+            break;
+        }
+
+        /* Look for the first arc whose label does not sort before the key character, the arcs are in label order */
+        for ( uiI = 0, uiArcCount = uiArcCountAndFinal >> 1; uiI < uiArcCount; uiI++ ) {
+
+            ucLabel = *pucStatePtr;
+            pucStatePtr++;
+            UTL_NUM_READ_COMPRESSED_UINT(uiOutput, pucStatePtr);
+            UTL_NUM_READ_COMPRESSED_ULONG(ulTargetStateID, pucStatePtr);
+
+            if ( ucLabel >= *pucKeyPtr ) {
+                break;
+            }
+        }
+
+        /* All the keys reachable from this state sort before the key */
+        if ( uiI == uiArcCount ) {
+            uiKeyRank += uiStateKeyCount;
+            break;
+        }
+
+        /* The keys before this arc sort before the key */
+        uiKeyRank += uiOutput;
+
+        /* The keys reached through this arc sort after the key */
+        if ( ucLabel != *pucKeyPtr ) {
+            break;
+        }
+
+        /* Follow the arc */
+        pucStatePtr = pudUtlDict->pucFst + ulTargetStateID;
+    }
+
+
+    /* The key sorts before the first key, this should never happen since the first key sorts before all keys */
+    if ( (bKeyFound == false) && (uiKeyRank == 0) ) {
+        return (UTL_DictKeyNotFound);
+    }
+
+
+    /* Set the return pointers */
+    *puiKeyOrdinal = (bKeyFound == true) ? uiKeyRank : uiKeyRank - 1;
+    *pbKeyFound = bKeyFound;
+
+
+    return (UTL_NoError);
+
+}
+
+
 /*---------------------------------------------------------------------------*/
@@ -45,6 +45,95 @@
 #define UTL_LOG_CONTEXT                     (unsigned char *)"com.fsconsult.mps.src.utils.num"
 
 
+/* Enable the SSSE3 decoder for runs of compressed unsigned integers if the 
+** compiler can target it, whether the processor supports it is checked at 
+** run time so the build does not need to be tied to a processor
+*/
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTL_NUM_ENABLE_SSSE3_DECODE
+#endif    /* defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#if defined(UTL_NUM_ENABLE_SSSE3_DECODE)
+#include <tmmintrin.h>
+#endif    /* defined(UTL_NUM_ENABLE_SSSE3_DECODE) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if defined(UTL_NUM_ENABLE_SSSE3_DECODE)
+
+/*
+** Defines
+*/
+
+/* Number of bytes loaded by the SSSE3 decoder, the number of those bytes whose 
+** continue bits are used to look up the decode, and the maximum number of 
+** numbers decoded at a time, the decoder only handles numbers of one or two bytes
+*/
+#define UTL_NUM_SSSE3_DECODE_BYTES_LENGTH       (16)
+#define UTL_NUM_SSSE3_DECODE_MASK_BITS          (12)
+#define UTL_NUM_SSSE3_DECODE_MASK_LENGTH        (1 << UTL_NUM_SSSE3_DECODE_MASK_BITS)
+#define UTL_NUM_SSSE3_DECODE_VALUES_LENGTH      (8)
+
+
+/* Shuffle index which zeroes the destination byte */
+#define UTL_NUM_SSSE3_DECODE_SHUFFLE_ZERO       (0x80)
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Structures
+*/
+
+/* SSSE3 decode structure, there is one for each continue bit mask */
+struct utlNumSsse3Decode {
+    unsigned char   pucShuffle[UTL_NUM_SSSE3_DECODE_BYTES_LENGTH];  /* Shuffle which puts each number into a 16 bit lane, 
+                                                                    ** final byte in the low byte, continue byte in the high byte */
+    unsigned char   ucValuesCount;                                  /* Number of numbers decoded, 0 if the first number is longer than two bytes */
+    unsigned char   ucBytesCount;                                   /* Number of bytes decoded */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Globals
+*/
+
+static struct utlNumSsse3Decode     pundUtlNumSsse3DecodesGlobal[UTL_NUM_SSSE3_DECODE_MASK_LENGTH];
+
+static pthread_once_t               ptoUtlNumSsse3DecodeOnceGlobal = PTHREAD_ONCE_INIT;
+
+static boolean                      bUtlNumSsse3DecodeGlobal = false;
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Private function declarations
+*/
+
+static void vUtlNumSsse3DecodeInit (void);
+
+static unsigned int uiUtlNumSsse3DecodeCompressedUInts (unsigned char *pucBuffer, 
+        unsigned int *puiValues, unsigned int *puiBytesCount);
+
+#endif    /* defined(UTL_NUM_ENABLE_SSSE3_DECODE) */
+
+
 /*---------------------------------------------------------------------------*/
 
 
@@ -109,4 +198,498 @@ int iUtlNumRoundNumber
 }
 
 
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlNumReadCompressedUIntArray()
+
+    Purpose:    Read a run of compressed unsigned integers from memory into an 
+                array, this is the bulk version of UTL_NUM_READ_COMPRESSED_UINT.
+
+                Runs of numbers which fit into one or two bytes are the 
+                common case in index blocks, so if the processor supports 
+                SSSE3 we decode up to eight of them at a time from sixteen 
+                bytes, otherwise we check eight bytes at a time for continue 
+                bits and copy them straight across if there are none, falling 
+                back to the macro for anything else.
+
+                Reading stops when the array is full or when the end of 
+                the buffer is reached, and the buffer pointer is moved along.
+
+    Parameters: ppucBuffer          pointer to the buffer pointer to read from (updated)
+                pucBufferEnd        buffer end
+                puiValues           array to read the numbers into
+                uiValuesLength      array length
+                puiValuesRead       return pointer for the number of numbers read
+
+    Globals:    ptoUtlNumSsse3DecodeOnceGlobal, bUtlNumSsse3DecodeGlobal
+
+    Returns:    UTL error code
+*/
+int iUtlNumReadCompressedUIntArray
+(
+    unsigned char **ppucBuffer,
+    unsigned char *pucBufferEnd,
+    unsigned int *puiValues,
+    unsigned int uiValuesLength,
+    unsigned int *puiValuesRead
+)
+{
+
+    unsigned char   *pucBufferPtr = NULL;
+    unsigned int    *puiValuesPtr = NULL;
+    unsigned int    *puiValuesEnd = NULL;
+
+
+    /* Check the parameters */
+    if ( (ppucBuffer == NULL) || (*ppucBuffer == NULL) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppucBuffer' parameter passed to 'iUtlNumReadCompressedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( pucBufferEnd == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucBufferEnd' parameter passed to 'iUtlNumReadCompressedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( puiValues == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiValues' parameter passed to 'iUtlNumReadCompressedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( puiValuesRead == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiValuesRead' parameter passed to 'iUtlNumReadCompressedUIntArray'."); 
+        return (UTL_ReturnParameterError);
+    }
+
+
+#if defined(UTL_NUM_ENABLE_SSSE3_DECODE)
+    /* Check for SSSE3 and set up the decodes, this is only done once */
+    pthread_once(&ptoUtlNumSsse3DecodeOnceGlobal, vUtlNumSsse3DecodeInit);
+#endif    /* defined(UTL_NUM_ENABLE_SSSE3_DECODE) */
+
+
+    /* Loop while there is space in the array and stuff to read */
+    for ( pucBufferPtr = *ppucBuffer, puiValuesPtr = puiValues, puiValuesEnd = puiValues + uiValuesLength; 
+            (puiValuesPtr < puiValuesEnd) && (pucBufferPtr < pucBufferEnd); ) {
+
+#if defined(UTL_NUM_ENABLE_SSSE3_DECODE)
+        /* Decode the next sixteen bytes with SSSE3, this always stores eight numbers so there needs to be space for them */
+        if ( (bUtlNumSsse3DecodeGlobal == true) && ((pucBufferEnd - pucBufferPtr) >= UTL_NUM_SSSE3_DECODE_BYTES_LENGTH) && 
+                ((puiValuesEnd - puiValuesPtr) >= UTL_NUM_SSSE3_DECODE_VALUES_LENGTH) ) {
+
+            unsigned int    uiValuesCount = 0;
+            unsigned int    uiBytesCount = 0;
+
+            if ( (uiValuesCount = uiUtlNumSsse3DecodeCompressedUInts(pucBufferPtr, puiValuesPtr, &uiBytesCount)) > 0 ) {
+                puiValuesPtr += uiValuesCount;
+                pucBufferPtr += uiBytesCount;
+                continue;
+            }
+        }
+        else
+#endif    /* defined(UTL_NUM_ENABLE_SSSE3_DECODE) */
+
+        /* Check the next eight bytes for continue bits, copying them across if there are none */
+        if ( ((pucBufferEnd - pucBufferPtr) >= UTL_NUM_COMPRESSED_UINT_BULK_LENGTH) && ((puiValuesEnd - puiValuesPtr) >= UTL_NUM_COMPRESSED_UINT_BULK_LENGTH) ) {
+
+            uint64_t    uiWord = 0;
+
+            s_memcpy(&uiWord, pucBufferPtr, sizeof(uint64_t));
+
+            if ( (uiWord & UTL_NUM_COMPRESSED_UINT_BULK_CONTINUE_MASK) == 0 ) {
+                puiValuesPtr[0] = pucBufferPtr[0];
+                puiValuesPtr[1] = pucBufferPtr[1];
+                puiValuesPtr[2] = pucBufferPtr[2];
+                puiValuesPtr[3] = pucBufferPtr[3];
+                puiValuesPtr[4] = pucBufferPtr[4];
+                puiValuesPtr[5] = pucBufferPtr[5];
+                puiValuesPtr[6] = pucBufferPtr[6];
+                puiValuesPtr[7] = pucBufferPtr[7];
+                puiValuesPtr += UTL_NUM_COMPRESSED_UINT_BULK_LENGTH;
+                pucBufferPtr += UTL_NUM_COMPRESSED_UINT_BULK_LENGTH;
+                continue;
+            }
+        }
+
+        /* Read a single number */
+        UTL_NUM_READ_COMPRESSED_UINT(*puiValuesPtr, pucBufferPtr);
+        puiValuesPtr++;
+    }
+
+
+    /* Set the return pointers */
+    *ppucBuffer = pucBufferPtr;
+    *puiValuesRead = puiValuesPtr - puiValues;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if defined(UTL_NUM_ENABLE_SSSE3_DECODE)
+
+/*
+
+    Function:   vUtlNumSsse3DecodeInit()
+
+    Purpose:    Check whether the processor supports SSSE3 and if it does, set up
+                the decode for each continue bit mask. 
+                
+                Each decode lists the numbers which are complete within the 
+                mask bytes, stopping at eight numbers, or at the first number 
+                longer than two bytes.
+
+    Parameters: void
+
+    Globals:    pundUtlNumSsse3DecodesGlobal, bUtlNumSsse3DecodeGlobal
+
+    Returns:    void
+*/
+static void vUtlNumSsse3DecodeInit
+(
+
+)
+{
+
+    unsigned int    uiMask = 0;
+
+
+    /* Check the processor */
+    __builtin_cpu_init();
+    if ( !__builtin_cpu_supports("ssse3") ) {
+        return;
+    }
+
+
+    /* Set up the decode for each mask */
+    for ( uiMask = 0; uiMask < UTL_NUM_SSSE3_DECODE_MASK_LENGTH; uiMask++ ) {
+
+        struct utlNumSsse3Decode    *pundUtlNumSsse3Decode = pundUtlNumSsse3DecodesGlobal + uiMask;
+        unsigned int                uiByte = 0;
+        unsigned int                uiValuesCount = 0;
+
+        s_memset(pundUtlNumSsse3Decode->pucShuffle, UTL_NUM_SSSE3_DECODE_SHUFFLE_ZERO, UTL_NUM_SSSE3_DECODE_BYTES_LENGTH);
+
+        while ( (uiValuesCount < UTL_NUM_SSSE3_DECODE_VALUES_LENGTH) && (uiByte < UTL_NUM_SSSE3_DECODE_MASK_BITS) ) {
+
+            /* One byte number */
+            if ( (uiMask & (1 << uiByte)) == 0 ) {
+                pundUtlNumSsse3Decode->pucShuffle[uiValuesCount * 2] = uiByte;
+                uiByte += 1;
+            }
+            /* Two byte number */
+            else if ( ((uiByte + 1) < UTL_NUM_SSSE3_DECODE_MASK_BITS) && ((uiMask & (1 << (uiByte + 1))) == 0) ) {
+                pundUtlNumSsse3Decode->pucShuffle[uiValuesCount * 2] = uiByte + 1;
+                pundUtlNumSsse3Decode->pucShuffle[(uiValuesCount * 2) + 1] = uiByte;
+                uiByte += 2;
+            }
+            /* Longer number, or one which runs past the mask */
+            else {
+                break;
+            }
+
+            uiValuesCount++;
+        }
+
+        pundUtlNumSsse3Decode->ucValuesCount = uiValuesCount;
+        pundUtlNumSsse3Decode->ucBytesCount = uiByte;
+    }
+
+
+    /* The decodes can now be used */
+    bUtlNumSsse3DecodeGlobal = true;
+
+
+    return;
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   uiUtlNumSsse3DecodeCompressedUInts()
+
+    Purpose:    Decode up to eight compressed unsigned integers from sixteen bytes 
+                using SSSE3. The continue bits of the bytes are used to look 
+                up the shuffle which puts each number into its own 16 bit lane, 
+                the two 7 bit groups are then joined and the lanes are widened 
+                to 32 bits.
+
+                Eight numbers are always stored, only the first ones returned
+                in the count are valid.
+
+    Parameters: pucBuffer           buffer to read from, there must be at least sixteen bytes
+                puiValues           array to read the numbers into, there must be space for eight numbers
+                puiBytesCount       return pointer for the number of bytes decoded
+
+    Globals:    pundUtlNumSsse3DecodesGlobal
+
+    Returns:    the number of numbers decoded, 0 if the first number is longer than two bytes
+*/
+__attribute__((target("ssse3"))) static unsigned int uiUtlNumSsse3DecodeCompressedUInts
+(
+    unsigned char *pucBuffer,
+    unsigned int *puiValues,
+    unsigned int *puiBytesCount
+)
+{
+
+    struct utlNumSsse3Decode    *pundUtlNumSsse3Decode = NULL;
+    __m128i                     xmmBytes;
+    __m128i                     xmmLanes;
+    __m128i                     xmmZero;
+
+
+    /* Load the bytes and look up the decode from their continue bits */
+    xmmBytes = _mm_loadu_si128((__m128i *)pucBuffer);
+    pundUtlNumSsse3Decode = pundUtlNumSsse3DecodesGlobal + ((unsigned int)_mm_movemask_epi8(xmmBytes) & (UTL_NUM_SSSE3_DECODE_MASK_LENGTH - 1));
+
+    if ( pundUtlNumSsse3Decode->ucValuesCount == 0 ) {
+        return (0);
+    }
+
+
+    /* Shuffle the numbers into their lanes and join the 7 bit groups */
+    xmmLanes = _mm_shuffle_epi8(xmmBytes, _mm_loadu_si128((__m128i *)pundUtlNumSsse3Decode->pucShuffle));
+    xmmLanes = _mm_or_si128(_mm_and_si128(xmmLanes, _mm_set1_epi16(0x007F)), _mm_srli_epi16(_mm_and_si128(xmmLanes, _mm_set1_epi16(0x7F00)), 1));
+
+
+    /* Widen the lanes and store them */
+    xmmZero = _mm_setzero_si128();
+    _mm_storeu_si128((__m128i *)puiValues, _mm_unpacklo_epi16(xmmLanes, xmmZero));
+    _mm_storeu_si128((__m128i *)(puiValues + 4), _mm_unpackhi_epi16(xmmLanes, xmmZero));
+
+
+    /* Set the return pointer */
+    *puiBytesCount = pundUtlNumSsse3Decode->ucBytesCount;
+
+
+    return (pundUtlNumSsse3Decode->ucValuesCount);
+
+}
+
+#endif    /* defined(UTL_NUM_ENABLE_SSSE3_DECODE) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlNumWriteBitPackedUIntArray()
+
+    Purpose:    Write an array of unsigned integers to memory, packing each 
+                one into the bit width, low bits first. The bit width needs 
+                to be wide enough for the largest number in the array, 
+                UTL_NUM_GET_BIT_PACKED_UINT_WIDTH will work it out.
+
+                The numbers are read every uiValuesStride entries in the 
+                array, this allows one field to be packed out of an array 
+                of records.
+
+                The buffer needs to be UTL_NUM_GET_BIT_PACKED_UINT_ARRAY_SIZE 
+                bytes long, and the buffer pointer is moved along.
+
+    Parameters: puiValues           array to write the numbers from
+                uiValuesLength      number of numbers to write
+                uiValuesStride      stride between the numbers in the array
+                uiBitWidth          bit width
+                ppucBuffer          pointer to the buffer pointer to write to (updated)
+
+    Globals:    none
+
+    Returns:    UTL error code
+*/
+int iUtlNumWriteBitPackedUIntArray
+(
+    unsigned int *puiValues,
+    unsigned int uiValuesLength,
+    unsigned int uiValuesStride,
+    unsigned int uiBitWidth,
+    unsigned char **ppucBuffer
+)
+{
+
+    unsigned char   *pucBufferPtr = NULL;
+    unsigned int    *puiValuesPtr = NULL;
+    unsigned int    uiI = 0;
+    uint64_t        uiBits = 0;
+    unsigned int    uiBitsLength = 0;
+
+
+    /* Check the parameters */
+    if ( puiValues == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiValues' parameter passed to 'iUtlNumWriteBitPackedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( uiValuesStride < 1 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiValuesStride' parameter passed to 'iUtlNumWriteBitPackedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( uiBitWidth > UTL_NUM_BIT_PACKED_UINT_MAX_WIDTH ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiBitWidth' parameter passed to 'iUtlNumWriteBitPackedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( (ppucBuffer == NULL) || (*ppucBuffer == NULL) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppucBuffer' parameter passed to 'iUtlNumWriteBitPackedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+
+    /* Nothing to write if the numbers take no bits */
+    if ( uiBitWidth == 0 ) {
+        return (UTL_NoError);
+    }
+
+
+    /* Loop over the numbers, adding each one to the top of the bits and 
+    ** writing out the bottom of the bits a byte at a time
+    */
+    for ( uiI = 0, puiValuesPtr = puiValues, pucBufferPtr = *ppucBuffer; uiI < uiValuesLength; uiI++, puiValuesPtr += uiValuesStride ) {
+
+        ASSERT((uiBitWidth == UTL_NUM_BIT_PACKED_UINT_MAX_WIDTH) || (*puiValuesPtr < (1U << uiBitWidth)));
+
+        uiBits |= (uint64_t)*puiValuesPtr << uiBitsLength;
+        uiBitsLength += uiBitWidth;
+
+        while ( uiBitsLength >= 8 ) {
+            *pucBufferPtr++ = (unsigned char)(uiBits & 0xFF);
+            uiBits >>= 8;
+            uiBitsLength -= 8;
+        }
+    }
+
+    /* Write out the last partial byte */
+    if ( uiBitsLength > 0 ) {
+        *pucBufferPtr++ = (unsigned char)(uiBits & 0xFF);
+    }
+
+    ASSERT((pucBufferPtr - *ppucBuffer) == UTL_NUM_GET_BIT_PACKED_UINT_ARRAY_SIZE(uiValuesLength, uiBitWidth));
+
+
+    /* Set the return pointer */
+    *ppucBuffer = pucBufferPtr;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlNumReadBitPackedUIntArray()
+
+    Purpose:    Read an array of unsigned integers from memory which were 
+                written by iUtlNumWriteBitPackedUIntArray().
+
+                The numbers are written every uiValuesStride entries in the 
+                array, this allows one field to be unpacked into an array 
+                of records.
+
+                The buffer pointer is moved along.
+
+    Parameters: ppucBuffer          pointer to the buffer pointer to read from (updated)
+                uiBitWidth          bit width
+                puiValues           array to read the numbers into
+                uiValuesLength      number of numbers to read
+                uiValuesStride      stride between the numbers in the array
+
+    Globals:    none
+
+    Returns:    UTL error code
+*/
+int iUtlNumReadBitPackedUIntArray
+(
+    unsigned char **ppucBuffer,
+    unsigned int uiBitWidth,
+    unsigned int *puiValues,
+    unsigned int uiValuesLength,
+    unsigned int uiValuesStride
+)
+{
+
+    unsigned char   *pucBufferPtr = NULL;
+    unsigned int    *puiValuesPtr = NULL;
+    unsigned int    uiI = 0;
+    uint64_t        uiBits = 0;
+    unsigned int    uiBitsLength = 0;
+    uint64_t        uiMask = 0;
+
+
+    /* Check the parameters */
+    if ( (ppucBuffer == NULL) || (*ppucBuffer == NULL) ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppucBuffer' parameter passed to 'iUtlNumReadBitPackedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( uiBitWidth > UTL_NUM_BIT_PACKED_UINT_MAX_WIDTH ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiBitWidth' parameter passed to 'iUtlNumReadBitPackedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( puiValues == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiValues' parameter passed to 'iUtlNumReadBitPackedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+    if ( uiValuesStride < 1 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiValuesStride' parameter passed to 'iUtlNumReadBitPackedUIntArray'."); 
+        return (UTL_ParameterError);
+    }
+
+
+    /* The numbers are all 0 if they take no bits */
+    if ( uiBitWidth == 0 ) {
+        for ( uiI = 0, puiValuesPtr = puiValues; uiI < uiValuesLength; uiI++, puiValuesPtr += uiValuesStride ) {
+            *puiValuesPtr = 0;
+        }
+        return (UTL_NoError);
+    }
+
+
+    /* Loop over the numbers, reading bytes into the top of the bits 
+    ** until there are enough to take a number off the bottom
+    */
+    for ( uiI = 0, puiValuesPtr = puiValues, pucBufferPtr = *ppucBuffer, uiMask = ((uint64_t)1 << uiBitWidth) - 1; 
+            uiI < uiValuesLength; uiI++, puiValuesPtr += uiValuesStride ) {
+
+        while ( uiBitsLength < uiBitWidth ) {
+            uiBits |= (uint64_t)*pucBufferPtr++ << uiBitsLength;
+            uiBitsLength += 8;
+        }
+
+        *puiValuesPtr = (unsigned int)(uiBits & uiMask);
+        uiBits >>= uiBitWidth;
+        uiBitsLength -= uiBitWidth;
+    }
+
+    ASSERT((pucBufferPtr - *ppucBuffer) == UTL_NUM_GET_BIT_PACKED_UINT_ARRAY_SIZE(uiValuesLength, uiBitWidth));
+
+
+    /* Set the return pointer */
+    *ppucBuffer = pucBufferPtr;
+
+
+    return (UTL_NoError);
+
+}
+
+
 /*---------------------------------------------------------------------------*/
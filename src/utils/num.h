@@ -167,6 +167,13 @@ extern "C" {
 #define UTL_NUM_SKIP_COMPRESSED_UINT(pucMacroPtr)                   UTL_NUM_SKIP_COMPRESSED_NUMBER((pucMacroPtr))
 
 
+/* Number of single byte compressed unsigned ints checked at a time by iUtlNumReadCompressedUIntArray(),
+** and the mask for their continue bits
+*/
+#define UTL_NUM_COMPRESSED_UINT_BULK_LENGTH                         (8)
+#define UTL_NUM_COMPRESSED_UINT_BULK_CONTINUE_MASK                  (0x8080808080808080ULL)
+
+
 /* Macro for compressing an unsigned integer and writing it to memory */
 #define UTL_NUM_WRITE_COMPRESSED_UINT(uiMacroValue, pucMacroPtr) \
     {    \
@@ -378,6 +385,32 @@ extern "C" {
 /*---------------------------------------------------------------------------*/
 
 
+/* Macros for bit packed unsigned int arrays, all the numbers in a bit packed 
+** array are stored in the same number of bits, the bit width, low bits first
+*/
+
+/* Maximum bit width of a bit packed unsigned int */
+#define UTL_NUM_BIT_PACKED_UINT_MAX_WIDTH                           (32)
+
+
+/* Macro to get the bit width needed to store an unsigned int, 0 needs no bits */
+#define UTL_NUM_GET_BIT_PACKED_UINT_WIDTH(uiMacroValue, uiMacroWidth) \
+    {    \
+        unsigned int uiMacroLocalValue = uiMacroValue; \
+\
+        for ( uiMacroWidth = 0; uiMacroLocalValue > 0; uiMacroLocalValue >>= 1, uiMacroWidth++ ) { \
+            ; \
+        }    \
+    }
+
+
+/* Macro to get the number of bytes occupied by a bit packed unsigned int array */
+#define UTL_NUM_GET_BIT_PACKED_UINT_ARRAY_SIZE(uiMacroLength, uiMacroWidth)     ((((uiMacroLength) * (uiMacroWidth)) + 7) / 8)
+
+
+/*---------------------------------------------------------------------------*/
+
+
 /*
 ** ============================================ 
 ** === Number storage macros (uncompressed) ===
@@ -1295,6 +1328,15 @@ static struct varintSize pvsCompactVarintSizesGlobal[] =
 int iUtlNumRoundNumber (long lNumber, unsigned int uiThreshold, 
         unsigned int uiRounding, unsigned int uiDigits, long *plNumber);
 
+int iUtlNumReadCompressedUIntArray (unsigned char **ppucBuffer, unsigned char *pucBufferEnd, 
+        unsigned int *puiValues, unsigned int uiValuesLength, unsigned int *puiValuesRead);
+
+int iUtlNumWriteBitPackedUIntArray (unsigned int *puiValues, unsigned int uiValuesLength, 
+        unsigned int uiValuesStride, unsigned int uiBitWidth, unsigned char **ppucBuffer);
+
+int iUtlNumReadBitPackedUIntArray (unsigned char **ppucBuffer, unsigned int uiBitWidth, 
+        unsigned int *puiValues, unsigned int uiValuesLength, unsigned int uiValuesStride);
+
 
 /*---------------------------------------------------------------------------*/
 
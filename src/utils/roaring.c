@@ -0,0 +1,2290 @@
+/*****************************************************************************
+*       Copyright (C) 1993-2011, FS Consulting LLC. All rights reserved      *
+*                                                                            *
+*  This notice is intended as a precaution against inadvertent publication   *
+*  and does not constitute an admission or acknowledgement that publication  *
+*  has occurred or constitute a waiver of confidentiality.                   *
+*                                                                            *
+*  This software is the proprietary and confidential property                *
+*  of FS Consulting LLC.                                                     *
+*****************************************************************************/
+
+
+/*
+
+    Module:     roaring.c
+
+    Author:     Francois Schiettecatte (FS Consulting LLC.)
+
+    Created:    17 October 2026
+
+    Purpose:    This implements a compressed set of unsigned integers along
+                the lines of a roaring bitmap.
+
+                The values are split into a high 16 bit key and a low 16 bit
+                value, and the low values sharing a key are kept in a container.
+                A container is either a sorted array of low values if it holds
+                few of them, or a bitmap of all 65536 low values if it holds
+                more, so a container never takes more than 8KB.
+
+                The set can be serialized to a buffer and deserialized from it,
+                the format is:
+
+                    [container count]
+                    [key][value count - 1][values]      (repeated per container)
+
+                where the counts and the key are compressed, the values of
+                an array container are stored in 2 bytes each and those of
+                a bitmap container are stored as a 8KB bitmap, least
+                significant bit first.
+
+
+                Roaring functions:
+
+                    iUtlRoaringCreate()
+                    iUtlRoaringFree()
+                    iUtlRoaringAddValue()
+                    bUtlRoaringContainsValue()
+                    iUtlRoaringGetNextValue()
+                    iUtlRoaringGetValuesCount()
+
+
+                Roaring serialization functions:
+
+                    iUtlRoaringGetSerializedLength()
+                    iUtlRoaringSerialize()
+                    iUtlRoaringDeserialize()
+
+
+                Roaring set functions:
+
+                    iUtlRoaringMerge()
+
+
+                Roaring bitmap functions:
+
+                    iUtlRoaringCreateFromBitmap()
+                    iUtlRoaringGetBitmap()
+
+*/
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#include "utils.h"
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Feature defines
+*/
+
+/* Context for logging */
+#undef UTL_LOG_CONTEXT
+#define UTL_LOG_CONTEXT                                 (unsigned char *)"com.fsconsult.mps.src.utils.roaring"
+
+
+/* Enable SSE2 for merging bitmap containers if the compiler targets it */
+#if defined(__SSE2__)
+#define UTL_ROARING_ENABLE_SSE2
+#endif    /* defined(__SSE2__) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#if defined(UTL_ROARING_ENABLE_SSE2)
+#include <emmintrin.h>
+#endif    /* defined(UTL_ROARING_ENABLE_SSE2) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Defines
+*/
+
+/* Macros to split a value into its key and its low value, and to join them back */
+#define UTL_ROARING_KEY(n)                              ((n) >> 16)
+#define UTL_ROARING_LOW_VALUE(n)                        ((n) & 0xFFFF)
+#define UTL_ROARING_VALUE(k, l)                         (((k) << 16) | (l))
+
+
+/* Maximum number of values in an array container, a bitmap container is smaller beyond that */
+#define UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH      (4096)
+
+/* Initial array container length */
+#define UTL_ROARING_ARRAY_CONTAINER_LENGTH_INITIAL      (16)
+
+
+/* Bitmap container length in words and in bytes */
+#define UTL_ROARING_BITMAP_CONTAINER_LENGTH             (65536 / 64)
+#define UTL_ROARING_BITMAP_CONTAINER_SIZE               (65536 / 8)
+
+
+/* Containers length increment */
+#define UTL_ROARING_CONTAINERS_LENGTH_INCREMENT         (16)
+
+
+/* Size of a low value in an array container when serialized */
+#define UTL_ROARING_LOW_VALUE_SIZE                      (2)
+
+
+/* Macros to count the bits set in a word and the trailing zeros of a non-zero word */
+#if defined(__GNUC__)
+#define UTL_ROARING_WORD_BIT_COUNT(n)                   ((unsigned int)__builtin_popcountll((unsigned long long)(n)))
+#define UTL_ROARING_WORD_TRAILING_ZEROS(n)              ((unsigned int)__builtin_ctzll((unsigned long long)(n)))
+#else
+#define UTL_ROARING_WORD_BIT_COUNT(n)                   uiUtlRoaringWordBitCount(n)
+#define UTL_ROARING_WORD_TRAILING_ZEROS(n)              uiUtlRoaringWordTrailingZeros(n)
+#endif    /* defined(__GNUC__) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Structures
+*/
+
+/* Roaring container structure, either the array or the bitmap is set */
+struct utlRoaringContainer {
+    unsigned int            uiKey;                          /* Key, high 16 bits of the values */
+    unsigned int            uiValuesCount;                  /* Number of values in the container */
+    unsigned short          *pusArray;                      /* Sorted low values (array container) */
+    unsigned int            uiArrayLength;                  /* Allocated array length (array container) */
+    uint64_t                *puiBitmap;                     /* Bitmap of the low values (bitmap container) */
+};
+
+
+/* Roaring structure */
+struct utlRoaring {
+    struct utlRoaringContainer  *purcUtlRoaringContainers;  /* Containers in key order */
+    unsigned int                uiUtlRoaringContainersLength;   /* Number of containers */
+    unsigned int                uiUtlRoaringContainersAllocated;    /* Allocated containers length */
+    unsigned int                uiValuesCount;              /* Number of values */
+    unsigned int                uiLastContainerIndex;       /* Index of the last container used, values tend to be accessed in order */
+};
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Private function prototypes
+*/
+
+static int iUtlRoaringGetContainer (struct utlRoaring *purUtlRoaring, unsigned int uiKey,
+        boolean bCreate, struct utlRoaringContainer **ppurcUtlRoaringContainer);
+
+static unsigned int uiUtlRoaringGetArrayIndex (struct utlRoaringContainer *purcUtlRoaringContainer,
+        unsigned int uiLowValue);
+
+static int iUtlRoaringConvertToBitmapContainer (struct utlRoaringContainer *purcUtlRoaringContainer);
+
+static int iUtlRoaringConvertToArrayContainer (struct utlRoaringContainer *purcUtlRoaringContainer);
+
+static int iUtlRoaringAppendContainer (struct utlRoaring *purUtlRoaring,
+        struct utlRoaringContainer *purcUtlRoaringContainer);
+
+static int iUtlRoaringCopyContainer (struct utlRoaringContainer *purcUtlRoaringContainer,
+        struct utlRoaringContainer *purcUtlRoaringContainerCopy);
+
+static int iUtlRoaringMergeArrayContainers (struct utlRoaringContainer *purcUtlRoaringContainer1,
+        struct utlRoaringContainer *purcUtlRoaringContainer2, unsigned int uiMergeType,
+        struct utlRoaringContainer *purcUtlRoaringContainer);
+
+static int iUtlRoaringFilterArrayContainer (struct utlRoaringContainer *purcUtlRoaringContainerArray,
+        struct utlRoaringContainer *purcUtlRoaringContainerBitmap, boolean bKeepSetValues,
+        struct utlRoaringContainer *purcUtlRoaringContainer);
+
+static int iUtlRoaringMergeBitmapContainers (struct utlRoaringContainer *purcUtlRoaringContainer1,
+        struct utlRoaringContainer *purcUtlRoaringContainer2, unsigned int uiMergeType,
+        struct utlRoaringContainer *purcUtlRoaringContainer);
+
+static unsigned int uiUtlRoaringMergeWords (uint64_t *puiWords1, uint64_t *puiWords2,
+        unsigned int uiMergeType, uint64_t *puiWords);
+
+#if !defined(__GNUC__)
+static unsigned int uiUtlRoaringWordBitCount (uint64_t uiWord);
+
+static unsigned int uiUtlRoaringWordTrailingZeros (uint64_t uiWord);
+#endif    /* !defined(__GNUC__) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringCreate()
+
+    Purpose:    Create a new empty roaring structure.
+
+    Parameters: ppvUtlRoaring       return pointer for the roaring structure
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringCreate
+(
+    void **ppvUtlRoaring
+)
+{
+
+    struct utlRoaring   *purUtlRoaring = NULL;
+
+
+    /* Check the parameters */
+    if ( ppvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppvUtlRoaring' parameter passed to 'iUtlRoaringCreate'.");
+        return (UTL_ReturnParameterError);
+    }
+
+
+    /* Allocate a roaring structure, this sets all the fields to 0/NULL */
+    if ( (purUtlRoaring = (struct utlRoaring *)s_malloc((size_t)(sizeof(struct utlRoaring)))) == NULL ) {
+        return (UTL_MemError);
+    }
+
+
+    /* Set the return pointer */
+    *ppvUtlRoaring = (void *)purUtlRoaring;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringFree()
+
+    Purpose:    Free the roaring structure.
+
+    Parameters: pvUtlRoaring        roaring structure
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringFree
+(
+    void *pvUtlRoaring
+)
+{
+
+    struct utlRoaring   *purUtlRoaring = (struct utlRoaring *)pvUtlRoaring;
+
+
+    /* Free the roaring structure */
+    if ( purUtlRoaring != NULL ) {
+
+        unsigned int    uiI = 0;
+
+        for ( uiI = 0; uiI < purUtlRoaring->uiUtlRoaringContainersLength; uiI++ ) {
+            s_free(purUtlRoaring->purcUtlRoaringContainers[uiI].pusArray);
+            s_free(purUtlRoaring->purcUtlRoaringContainers[uiI].puiBitmap);
+        }
+
+        s_free(purUtlRoaring->purcUtlRoaringContainers);
+        s_free(purUtlRoaring);
+    }
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringAddValue()
+
+    Purpose:    Add a value to the roaring structure, adding a value which is
+                already there does nothing. Values can be added in any order
+                but adding them in increasing order is the fastest.
+
+    Parameters: pvUtlRoaring        roaring structure
+                uiValue             value
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringAddValue
+(
+    void *pvUtlRoaring,
+    unsigned int uiValue
+)
+{
+
+    int                         iError = UTL_NoError;
+    struct utlRoaring           *purUtlRoaring = (struct utlRoaring *)pvUtlRoaring;
+    struct utlRoaringContainer  *purcUtlRoaringContainer = NULL;
+    unsigned int                uiLowValue = UTL_ROARING_LOW_VALUE(uiValue);
+
+
+    /* Check the parameters */
+    if ( pvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring' parameter passed to 'iUtlRoaringAddValue'.");
+        return (UTL_RoaringInvalidRoaring);
+    }
+
+
+    /* Get the container for this value, creating it if needed */
+    if ( (iError = iUtlRoaringGetContainer(purUtlRoaring, UTL_ROARING_KEY(uiValue), true, &purcUtlRoaringContainer)) != UTL_NoError ) {
+        return (iError);
+    }
+
+
+    /* Convert the array container to a bitmap container if it is full */
+    if ( (purcUtlRoaringContainer->puiBitmap == NULL) && (purcUtlRoaringContainer->uiValuesCount >= UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH) ) {
+        if ( (iError = iUtlRoaringConvertToBitmapContainer(purcUtlRoaringContainer)) != UTL_NoError ) {
+            return (iError);
+        }
+    }
+
+
+    /* Bitmap container, set the bit if it is not set */
+    if ( purcUtlRoaringContainer->puiBitmap != NULL ) {
+
+        uint64_t    uiBit = (uint64_t)1 << (uiLowValue & 63);
+
+        if ( !(purcUtlRoaringContainer->puiBitmap[uiLowValue >> 6] & uiBit) ) {
+            purcUtlRoaringContainer->puiBitmap[uiLowValue >> 6] |= uiBit;
+            purcUtlRoaringContainer->uiValuesCount++;
+            purUtlRoaring->uiValuesCount++;
+        }
+    }
+
+    /* Array container, insert the low value if it is not there */
+    else {
+
+        unsigned int    uiIndex = 0;
+
+        /* Get the index to insert the low value at, checking the end first since values are usually added in order */
+        if ( (purcUtlRoaringContainer->uiValuesCount == 0) ||
+                (purcUtlRoaringContainer->pusArray[purcUtlRoaringContainer->uiValuesCount - 1] < uiLowValue) ) {
+            uiIndex = purcUtlRoaringContainer->uiValuesCount;
+        }
+        else {
+
+            uiIndex = uiUtlRoaringGetArrayIndex(purcUtlRoaringContainer, uiLowValue);
+
+            /* Already there */
+            if ( purcUtlRoaringContainer->pusArray[uiIndex] == uiLowValue ) {
+                return (UTL_NoError);
+            }
+        }
+
+        /* Extend the array if needed, doubling it every time */
+        if ( purcUtlRoaringContainer->uiValuesCount >= purcUtlRoaringContainer->uiArrayLength ) {
+
+            unsigned int    uiArrayLength = (purcUtlRoaringContainer->uiArrayLength == 0) ? UTL_ROARING_ARRAY_CONTAINER_LENGTH_INITIAL :
+                    UTL_MACROS_MIN(purcUtlRoaringContainer->uiArrayLength * 2, UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH);
+            unsigned short  *pusArray = NULL;
+
+            if ( (pusArray = (unsigned short *)s_realloc(purcUtlRoaringContainer->pusArray, (size_t)(uiArrayLength * sizeof(unsigned short)))) == NULL ) {
+                return (UTL_MemError);
+            }
+
+            purcUtlRoaringContainer->pusArray = pusArray;
+            purcUtlRoaringContainer->uiArrayLength = uiArrayLength;
+        }
+
+        /* Make space for the low value and add it */
+        if ( uiIndex < purcUtlRoaringContainer->uiValuesCount ) {
+            s_memmove(purcUtlRoaringContainer->pusArray + uiIndex + 1, purcUtlRoaringContainer->pusArray + uiIndex,
+                    (purcUtlRoaringContainer->uiValuesCount - uiIndex) * sizeof(unsigned short));
+        }
+
+        purcUtlRoaringContainer->pusArray[uiIndex] = (unsigned short)uiLowValue;
+        purcUtlRoaringContainer->uiValuesCount++;
+        purUtlRoaring->uiValuesCount++;
+    }
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   bUtlRoaringContainsValue()
+
+    Purpose:    Check whether a value is in the roaring structure.
+
+    Parameters: pvUtlRoaring        roaring structure
+                uiValue             value
+
+    Globals:    none
+
+    Returns:    true if the value is there, false if not
+
+*/
+boolean bUtlRoaringContainsValue
+(
+    void *pvUtlRoaring,
+    unsigned int uiValue
+)
+{
+
+    struct utlRoaringContainer  *purcUtlRoaringContainer = NULL;
+    unsigned int                uiLowValue = UTL_ROARING_LOW_VALUE(uiValue);
+
+
+    /* Check the parameters */
+    if ( pvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring' parameter passed to 'bUtlRoaringContainsValue'.");
+        return (false);
+    }
+
+
+    /* Get the container for this value */
+    if ( iUtlRoaringGetContainer((struct utlRoaring *)pvUtlRoaring, UTL_ROARING_KEY(uiValue), false, &purcUtlRoaringContainer) != UTL_NoError ) {
+        return (false);
+    }
+
+
+    /* Bitmap container, check the bit */
+    if ( purcUtlRoaringContainer->puiBitmap != NULL ) {
+        return ((purcUtlRoaringContainer->puiBitmap[uiLowValue >> 6] & ((uint64_t)1 << (uiLowValue & 63))) ? true : false);
+    }
+
+
+    /* Array container, look for the low value */
+    return (((purcUtlRoaringContainer->uiValuesCount > 0) &&
+            (purcUtlRoaringContainer->pusArray[uiUtlRoaringGetArrayIndex(purcUtlRoaringContainer, uiLowValue)] == uiLowValue)) ? true : false);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringGetNextValue()
+
+    Purpose:    Get the first value in the roaring structure which is
+                greater than or equal to the passed value.
+
+    Parameters: pvUtlRoaring        roaring structure
+                uiValue             value
+                puiNextValue        return pointer for the next value
+
+    Globals:    none
+
+    Returns:    UTL error code, UTL_RoaringValueNotFound if there is no such value
+
+*/
+int iUtlRoaringGetNextValue
+(
+    void *pvUtlRoaring,
+    unsigned int uiValue,
+    unsigned int *puiNextValue
+)
+{
+
+    struct utlRoaring           *purUtlRoaring = (struct utlRoaring *)pvUtlRoaring;
+    struct utlRoaringContainer  *purcUtlRoaringContainer = NULL;
+    unsigned int                uiKey = UTL_ROARING_KEY(uiValue);
+    unsigned int                uiLowValue = UTL_ROARING_LOW_VALUE(uiValue);
+    unsigned int                uiIndex = 0;
+
+
+    /* Check the parameters */
+    if ( pvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring' parameter passed to 'iUtlRoaringGetNextValue'.");
+        return (UTL_RoaringInvalidRoaring);
+    }
+
+    if ( puiNextValue == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiNextValue' parameter passed to 'iUtlRoaringGetNextValue'.");
+        return (UTL_ReturnParameterError);
+    }
+
+
+    /* Find the first container whose key is greater than or equal to the key,
+    ** starting from the last container used if we can
+    */
+    uiIndex = ((purUtlRoaring->uiLastContainerIndex < purUtlRoaring->uiUtlRoaringContainersLength) &&
+            (purUtlRoaring->purcUtlRoaringContainers[purUtlRoaring->uiLastContainerIndex].uiKey <= uiKey)) ? purUtlRoaring->uiLastContainerIndex : 0;
+
+    for ( ; (uiIndex < purUtlRoaring->uiUtlRoaringContainersLength) && (purUtlRoaring->purcUtlRoaringContainers[uiIndex].uiKey < uiKey); uiIndex++ ) {
+        ;
+    }
+
+
+    /* Loop over the containers from there, the low value only applies to a container with the same key */
+    for ( ; uiIndex < purUtlRoaring->uiUtlRoaringContainersLength; uiIndex++, uiLowValue = 0 ) {
+
+        purcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + uiIndex;
+        purUtlRoaring->uiLastContainerIndex = uiIndex;
+
+        if ( purcUtlRoaringContainer->uiKey > uiKey ) {
+            uiLowValue = 0;
+        }
+
+        /* Bitmap container, scan the words from the low value */
+        if ( purcUtlRoaringContainer->puiBitmap != NULL ) {
+
+            unsigned int    uiWordIndex = uiLowValue >> 6;
+            uint64_t        uiWord = purcUtlRoaringContainer->puiBitmap[uiWordIndex] & (~(uint64_t)0 << (uiLowValue & 63));
+
+            while ( true ) {
+
+                if ( uiWord != 0 ) {
+                    *puiNextValue = UTL_ROARING_VALUE(purcUtlRoaringContainer->uiKey, (uiWordIndex << 6) + UTL_ROARING_WORD_TRAILING_ZEROS(uiWord));
+                    return (UTL_NoError);
+                }
+
+                if ( ++uiWordIndex >= UTL_ROARING_BITMAP_CONTAINER_LENGTH ) {
+                    break;
+                }
+
+                uiWord = purcUtlRoaringContainer->puiBitmap[uiWordIndex];
+            }
+        }
+
+        /* Array container, look for the low value */
+        else if ( purcUtlRoaringContainer->uiValuesCount > 0 ) {
+
+            unsigned int    uiArrayIndex = uiUtlRoaringGetArrayIndex(purcUtlRoaringContainer, uiLowValue);
+
+            if ( purcUtlRoaringContainer->pusArray[uiArrayIndex] >= uiLowValue ) {
+                *puiNextValue = UTL_ROARING_VALUE(purcUtlRoaringContainer->uiKey, purcUtlRoaringContainer->pusArray[uiArrayIndex]);
+                return (UTL_NoError);
+            }
+        }
+    }
+
+
+    return (UTL_RoaringValueNotFound);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringGetValuesCount()
+
+    Purpose:    Get the number of values in the roaring structure.
+
+    Parameters: pvUtlRoaring        roaring structure
+                puiValuesCount      return pointer for the number of values
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringGetValuesCount
+(
+    void *pvUtlRoaring,
+    unsigned int *puiValuesCount
+)
+{
+
+    /* Check the parameters */
+    if ( pvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring' parameter passed to 'iUtlRoaringGetValuesCount'.");
+        return (UTL_RoaringInvalidRoaring);
+    }
+
+    if ( puiValuesCount == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiValuesCount' parameter passed to 'iUtlRoaringGetValuesCount'.");
+        return (UTL_ReturnParameterError);
+    }
+
+
+    /* Set the return pointer */
+    *puiValuesCount = ((struct utlRoaring *)pvUtlRoaring)->uiValuesCount;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringGetSerializedLength()
+
+    Purpose:    Get the length of the roaring structure when it is serialized.
+
+    Parameters: pvUtlRoaring            roaring structure
+                puiSerializedLength     return pointer for the serialized length
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringGetSerializedLength
+(
+    void *pvUtlRoaring,
+    unsigned int *puiSerializedLength
+)
+{
+
+    struct utlRoaring   *purUtlRoaring = (struct utlRoaring *)pvUtlRoaring;
+    unsigned int        uiSerializedLength = 0;
+    unsigned int        uiSize = 0;
+    unsigned int        uiI = 0;
+
+
+    /* Check the parameters */
+    if ( pvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring' parameter passed to 'iUtlRoaringGetSerializedLength'.");
+        return (UTL_RoaringInvalidRoaring);
+    }
+
+    if ( puiSerializedLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiSerializedLength' parameter passed to 'iUtlRoaringGetSerializedLength'.");
+        return (UTL_ReturnParameterError);
+    }
+
+
+    /* Container count */
+    UTL_NUM_GET_COMPRESSED_UINT_SIZE(purUtlRoaring->uiUtlRoaringContainersLength, uiSize);
+    uiSerializedLength += uiSize;
+
+    /* Containers, empty containers are not serialized */
+    for ( uiI = 0; uiI < purUtlRoaring->uiUtlRoaringContainersLength; uiI++ ) {
+
+        struct utlRoaringContainer  *purcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + uiI;
+
+        if ( purcUtlRoaringContainer->uiValuesCount == 0 ) {
+            continue;
+        }
+
+        UTL_NUM_GET_COMPRESSED_UINT_SIZE(purcUtlRoaringContainer->uiKey, uiSize);
+        uiSerializedLength += uiSize;
+
+        UTL_NUM_GET_COMPRESSED_UINT_SIZE(purcUtlRoaringContainer->uiValuesCount - 1, uiSize);
+        uiSerializedLength += uiSize;
+
+        uiSerializedLength += (purcUtlRoaringContainer->uiValuesCount > UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH) ?
+                UTL_ROARING_BITMAP_CONTAINER_SIZE : purcUtlRoaringContainer->uiValuesCount * UTL_ROARING_LOW_VALUE_SIZE;
+    }
+
+
+    /* Set the return pointer */
+    *puiSerializedLength = uiSerializedLength;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringSerialize()
+
+    Purpose:    Serialize the roaring structure to a buffer, the buffer must be
+                at least as long as the length returned by
+                iUtlRoaringGetSerializedLength().
+
+                A container holding up to UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH
+                values is always serialized as an array container so that the
+                container type can be told from the value count.
+
+    Parameters: pvUtlRoaring        roaring structure
+                pucBuffer           buffer
+                puiBufferLength     return pointer for the length of the buffer used
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringSerialize
+(
+    void *pvUtlRoaring,
+    unsigned char *pucBuffer,
+    unsigned int *puiBufferLength
+)
+{
+
+    struct utlRoaring   *purUtlRoaring = (struct utlRoaring *)pvUtlRoaring;
+    unsigned char       *pucBufferPtr = pucBuffer;
+    unsigned int        uiContainersCount = 0;
+    unsigned int        uiI = 0;
+
+
+    /* Check the parameters */
+    if ( pvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring' parameter passed to 'iUtlRoaringSerialize'.");
+        return (UTL_RoaringInvalidRoaring);
+    }
+
+    if ( pucBuffer == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucBuffer' parameter passed to 'iUtlRoaringSerialize'.");
+        return (UTL_RoaringInvalidBuffer);
+    }
+
+    if ( puiBufferLength == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'puiBufferLength' parameter passed to 'iUtlRoaringSerialize'.");
+        return (UTL_ReturnParameterError);
+    }
+
+
+    /* Count the non-empty containers */
+    for ( uiI = 0; uiI < purUtlRoaring->uiUtlRoaringContainersLength; uiI++ ) {
+        if ( purUtlRoaring->purcUtlRoaringContainers[uiI].uiValuesCount > 0 ) {
+            uiContainersCount++;
+        }
+    }
+
+    /* Write the container count */
+    UTL_NUM_WRITE_COMPRESSED_UINT(uiContainersCount, pucBufferPtr);
+
+
+    /* Write the containers */
+    for ( uiI = 0; uiI < purUtlRoaring->uiUtlRoaringContainersLength; uiI++ ) {
+
+        struct utlRoaringContainer  *purcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + uiI;
+        unsigned int                uiJ = 0;
+
+        if ( purcUtlRoaringContainer->uiValuesCount == 0 ) {
+            continue;
+        }
+
+        UTL_NUM_WRITE_COMPRESSED_UINT(purcUtlRoaringContainer->uiKey, pucBufferPtr);
+        UTL_NUM_WRITE_COMPRESSED_UINT(purcUtlRoaringContainer->uiValuesCount - 1, pucBufferPtr);
+
+        /* Bitmap, written as an array if it is sparse enough */
+        if ( purcUtlRoaringContainer->puiBitmap != NULL ) {
+
+            if ( purcUtlRoaringContainer->uiValuesCount > UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH ) {
+
+                for ( uiJ = 0; uiJ < UTL_ROARING_BITMAP_CONTAINER_LENGTH; uiJ++ ) {
+
+                    uint64_t        uiWord = purcUtlRoaringContainer->puiBitmap[uiJ];
+                    unsigned int    uiK = 0;
+
+                    for ( uiK = 0; uiK < sizeof(uint64_t); uiK++, uiWord >>= 8 ) {
+                        *pucBufferPtr++ = (unsigned char)(uiWord & 0xFF);
+                    }
+                }
+            }
+            else {
+
+                for ( uiJ = 0; uiJ < UTL_ROARING_BITMAP_CONTAINER_LENGTH; uiJ++ ) {
+
+                    uint64_t    uiWord = purcUtlRoaringContainer->puiBitmap[uiJ];
+
+                    for ( ; uiWord != 0; uiWord &= uiWord - 1 ) {
+                        unsigned int    uiLowValue = (uiJ << 6) + UTL_ROARING_WORD_TRAILING_ZEROS(uiWord);
+                        UTL_NUM_WRITE_UINT(uiLowValue, UTL_ROARING_LOW_VALUE_SIZE, pucBufferPtr);
+                    }
+                }
+            }
+        }
+
+        /* Array */
+        else {
+            for ( uiJ = 0; uiJ < purcUtlRoaringContainer->uiValuesCount; uiJ++ ) {
+                UTL_NUM_WRITE_UINT(purcUtlRoaringContainer->pusArray[uiJ], UTL_ROARING_LOW_VALUE_SIZE, pucBufferPtr);
+            }
+        }
+    }
+
+
+    /* Set the return pointer */
+    *puiBufferLength = pucBufferPtr - pucBuffer;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringDeserialize()
+
+    Purpose:    Create a roaring structure from a buffer it was serialized to.
+
+    Parameters: pucBuffer           buffer
+                uiBufferLength      buffer length
+                ppvUtlRoaring       return pointer for the roaring structure
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringDeserialize
+(
+    unsigned char *pucBuffer,
+    unsigned int uiBufferLength,
+    void **ppvUtlRoaring
+)
+{
+
+    int                 iError = UTL_NoError;
+    struct utlRoaring   *purUtlRoaring = NULL;
+    unsigned char       *pucBufferPtr = pucBuffer;
+    unsigned char       *pucBufferEnd = pucBuffer + uiBufferLength;
+    unsigned int        uiContainersCount = 0;
+    unsigned int        uiI = 0;
+
+
+    /* Check the parameters */
+    if ( pucBuffer == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucBuffer' parameter passed to 'iUtlRoaringDeserialize'.");
+        return (UTL_RoaringInvalidBuffer);
+    }
+
+    if ( uiBufferLength <= 0 ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiBufferLength' parameter passed to 'iUtlRoaringDeserialize'.");
+        return (UTL_RoaringInvalidBufferLength);
+    }
+
+    if ( ppvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppvUtlRoaring' parameter passed to 'iUtlRoaringDeserialize'.");
+        return (UTL_ReturnParameterError);
+    }
+
+
+    /* Create the roaring structure */
+    if ( (iError = iUtlRoaringCreate((void **)&purUtlRoaring)) != UTL_NoError ) {
+        return (iError);
+    }
+
+
+    /* Read the container count and allocate the containers */
+    UTL_NUM_READ_COMPRESSED_UINT(uiContainersCount, pucBufferPtr);
+
+    if ( uiContainersCount > 0 ) {
+        if ( (purUtlRoaring->purcUtlRoaringContainers = (struct utlRoaringContainer *)s_malloc((size_t)(uiContainersCount * sizeof(struct utlRoaringContainer)))) == NULL ) {
+            iError = UTL_MemError;
+            goto bailFromiUtlRoaringDeserialize;
+        }
+        purUtlRoaring->uiUtlRoaringContainersAllocated = uiContainersCount;
+    }
+
+
+    /* Read the containers */
+    for ( uiI = 0; uiI < uiContainersCount; uiI++ ) {
+
+        struct utlRoaringContainer  *purcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + uiI;
+        unsigned int                uiJ = 0;
+
+        /* Check that there is a container to read */
+        if ( pucBufferPtr >= pucBufferEnd ) {
+            iError = UTL_RoaringInvalidBufferLength;
+            goto bailFromiUtlRoaringDeserialize;
+        }
+
+        UTL_NUM_READ_COMPRESSED_UINT(purcUtlRoaringContainer->uiKey, pucBufferPtr);
+        UTL_NUM_READ_COMPRESSED_UINT(purcUtlRoaringContainer->uiValuesCount, pucBufferPtr);
+        purcUtlRoaringContainer->uiValuesCount++;
+        purUtlRoaring->uiUtlRoaringContainersLength++;
+
+        /* Bitmap container */
+        if ( purcUtlRoaringContainer->uiValuesCount > UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH ) {
+
+            if ( (pucBufferPtr + UTL_ROARING_BITMAP_CONTAINER_SIZE) > pucBufferEnd ) {
+                iError = UTL_RoaringInvalidBufferLength;
+                goto bailFromiUtlRoaringDeserialize;
+            }
+
+            if ( (purcUtlRoaringContainer->puiBitmap = (uint64_t *)s_malloc((size_t)(UTL_ROARING_BITMAP_CONTAINER_LENGTH * sizeof(uint64_t)))) == NULL ) {
+                iError = UTL_MemError;
+                goto bailFromiUtlRoaringDeserialize;
+            }
+
+            for ( uiJ = 0; uiJ < UTL_ROARING_BITMAP_CONTAINER_LENGTH; uiJ++ ) {
+
+                uint64_t        uiWord = 0;
+                unsigned int    uiK = 0;
+
+                for ( uiK = 0; uiK < sizeof(uint64_t); uiK++ ) {
+                    uiWord |= (uint64_t)*pucBufferPtr++ << (uiK * 8);
+                }
+
+                purcUtlRoaringContainer->puiBitmap[uiJ] = uiWord;
+            }
+        }
+
+        /* Array container */
+        else {
+
+            if ( (pucBufferPtr + (purcUtlRoaringContainer->uiValuesCount * UTL_ROARING_LOW_VALUE_SIZE)) > pucBufferEnd ) {
+                iError = UTL_RoaringInvalidBufferLength;
+                goto bailFromiUtlRoaringDeserialize;
+            }
+
+            if ( (purcUtlRoaringContainer->pusArray = (unsigned short *)s_malloc((size_t)(purcUtlRoaringContainer->uiValuesCount * sizeof(unsigned short)))) == NULL ) {
+                iError = UTL_MemError;
+                goto bailFromiUtlRoaringDeserialize;
+            }
+            purcUtlRoaringContainer->uiArrayLength = purcUtlRoaringContainer->uiValuesCount;
+
+            for ( uiJ = 0; uiJ < purcUtlRoaringContainer->uiValuesCount; uiJ++ ) {
+
+                unsigned int    uiLowValue = 0;
+
+                UTL_NUM_READ_UINT(uiLowValue, UTL_ROARING_LOW_VALUE_SIZE, pucBufferPtr);
+                purcUtlRoaringContainer->pusArray[uiJ] = (unsigned short)uiLowValue;
+            }
+        }
+
+        purUtlRoaring->uiValuesCount += purcUtlRoaringContainer->uiValuesCount;
+    }
+
+
+
+    /* Bail label */
+    bailFromiUtlRoaringDeserialize:
+
+
+    /* Handle the error */
+    if ( iError == UTL_NoError ) {
+
+        /* Set the return pointer */
+        *ppvUtlRoaring = (void *)purUtlRoaring;
+    }
+    else {
+
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to deserialize a roaring structure, utl error: %d.", iError);
+
+        /* Free the roaring structure */
+        iUtlRoaringFree((void *)purUtlRoaring);
+        purUtlRoaring = NULL;
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringMerge()
+
+    Purpose:    Merge two roaring structures into a new roaring structure
+                according to the merge type, the two roaring structures
+                are left untouched.
+
+                The containers are merged key by key, sorted arrays are
+                merged with each other, arrays are filtered against bitmaps
+                when the result cannot be larger than the array, and bitmaps
+                are merged word by word otherwise.
+
+    Parameters: pvUtlRoaring1       roaring structure
+                pvUtlRoaring2       roaring structure
+                uiMergeType         merge type
+                ppvUtlRoaring       return pointer for the roaring structure
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringMerge
+(
+    void *pvUtlRoaring1,
+    void *pvUtlRoaring2,
+    unsigned int uiMergeType,
+    void **ppvUtlRoaring
+)
+{
+
+    int                 iError = UTL_NoError;
+    struct utlRoaring   *purUtlRoaring1 = (struct utlRoaring *)pvUtlRoaring1;
+    struct utlRoaring   *purUtlRoaring2 = (struct utlRoaring *)pvUtlRoaring2;
+    struct utlRoaring   *purUtlRoaring = NULL;
+    unsigned int        uiI = 0;
+    unsigned int        uiJ = 0;
+
+
+    /* Check the parameters */
+    if ( pvUtlRoaring1 == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring1' parameter passed to 'iUtlRoaringMerge'.");
+        return (UTL_RoaringInvalidRoaring);
+    }
+
+    if ( pvUtlRoaring2 == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring2' parameter passed to 'iUtlRoaringMerge'.");
+        return (UTL_RoaringInvalidRoaring);
+    }
+
+    if ( UTL_ROARING_MERGE_TYPE_VALID(uiMergeType) == false ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Invalid 'uiMergeType' parameter passed to 'iUtlRoaringMerge'.");
+        return (UTL_RoaringInvalidMergeType);
+    }
+
+    if ( ppvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppvUtlRoaring' parameter passed to 'iUtlRoaringMerge'.");
+        return (UTL_ReturnParameterError);
+    }
+
+
+    /* Create the roaring structure */
+    if ( (iError = iUtlRoaringCreate((void **)&purUtlRoaring)) != UTL_NoError ) {
+        return (iError);
+    }
+
+
+    /* Loop over the containers of both roaring structures in key order */
+    while ( (uiI < purUtlRoaring1->uiUtlRoaringContainersLength) || (uiJ < purUtlRoaring2->uiUtlRoaringContainersLength) ) {
+
+        struct utlRoaringContainer  *purcUtlRoaringContainer1 = (uiI < purUtlRoaring1->uiUtlRoaringContainersLength) ? purUtlRoaring1->purcUtlRoaringContainers + uiI : NULL;
+        struct utlRoaringContainer  *purcUtlRoaringContainer2 = (uiJ < purUtlRoaring2->uiUtlRoaringContainersLength) ? purUtlRoaring2->purcUtlRoaringContainers + uiJ : NULL;
+        struct utlRoaringContainer  urcUtlRoaringContainer;
+
+        s_memset(&urcUtlRoaringContainer, 0, sizeof(struct utlRoaringContainer));
+
+        /* Key only in the first roaring structure, it is kept unless we are ANDing */
+        if ( (purcUtlRoaringContainer2 == NULL) || ((purcUtlRoaringContainer1 != NULL) && (purcUtlRoaringContainer1->uiKey < purcUtlRoaringContainer2->uiKey)) ) {
+            if ( uiMergeType != UTL_ROARING_MERGE_TYPE_AND ) {
+                iError = iUtlRoaringCopyContainer(purcUtlRoaringContainer1, &urcUtlRoaringContainer);
+            }
+            uiI++;
+        }
+
+        /* Key only in the second roaring structure, it is kept if we are ORing or XORing */
+        else if ( (purcUtlRoaringContainer1 == NULL) || (purcUtlRoaringContainer2->uiKey < purcUtlRoaringContainer1->uiKey) ) {
+            if ( (uiMergeType == UTL_ROARING_MERGE_TYPE_OR) || (uiMergeType == UTL_ROARING_MERGE_TYPE_XOR) ) {
+                iError = iUtlRoaringCopyContainer(purcUtlRoaringContainer2, &urcUtlRoaringContainer);
+            }
+            uiJ++;
+        }
+
+        /* Key in both roaring structures */
+        else {
+
+            urcUtlRoaringContainer.uiKey = purcUtlRoaringContainer1->uiKey;
+
+            /* Two arrays */
+            if ( (purcUtlRoaringContainer1->puiBitmap == NULL) && (purcUtlRoaringContainer2->puiBitmap == NULL) ) {
+                iError = iUtlRoaringMergeArrayContainers(purcUtlRoaringContainer1, purcUtlRoaringContainer2, uiMergeType, &urcUtlRoaringContainer);
+            }
+
+            /* An array ANDed or NOTed with a bitmap, the result is a subset of the array */
+            else if ( (purcUtlRoaringContainer1->puiBitmap == NULL) &&
+                    ((uiMergeType == UTL_ROARING_MERGE_TYPE_AND) || (uiMergeType == UTL_ROARING_MERGE_TYPE_NOT)) ) {
+                iError = iUtlRoaringFilterArrayContainer(purcUtlRoaringContainer1, purcUtlRoaringContainer2,
+                        (uiMergeType == UTL_ROARING_MERGE_TYPE_AND) ? true : false, &urcUtlRoaringContainer);
+            }
+
+            /* A bitmap ANDed with an array, the result is a subset of the array */
+            else if ( (purcUtlRoaringContainer2->puiBitmap == NULL) && (uiMergeType == UTL_ROARING_MERGE_TYPE_AND) ) {
+                iError = iUtlRoaringFilterArrayContainer(purcUtlRoaringContainer2, purcUtlRoaringContainer1, true, &urcUtlRoaringContainer);
+            }
+
+            /* Everything else is merged as bitmaps */
+            else {
+                iError = iUtlRoaringMergeBitmapContainers(purcUtlRoaringContainer1, purcUtlRoaringContainer2, uiMergeType, &urcUtlRoaringContainer);
+            }
+
+            uiI++;
+            uiJ++;
+        }
+
+        /* Add the container, empty containers are dropped */
+        if ( iError == UTL_NoError ) {
+            iError = iUtlRoaringAppendContainer(purUtlRoaring, &urcUtlRoaringContainer);
+        }
+
+        /* Handle the error */
+        if ( iError != UTL_NoError ) {
+            s_free(urcUtlRoaringContainer.pusArray);
+            s_free(urcUtlRoaringContainer.puiBitmap);
+            goto bailFromiUtlRoaringMerge;
+        }
+    }
+
+
+
+    /* Bail label */
+    bailFromiUtlRoaringMerge:
+
+
+    /* Handle the error */
+    if ( iError == UTL_NoError ) {
+
+        /* Set the return pointer */
+        *ppvUtlRoaring = (void *)purUtlRoaring;
+    }
+    else {
+
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to merge two roaring structures, utl error: %d.", iError);
+
+        /* Free the roaring structure */
+        iUtlRoaringFree((void *)purUtlRoaring);
+        purUtlRoaring = NULL;
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringCreateFromBitmap()
+
+    Purpose:    Create a roaring structure from a bitmap, the bitmap is 
+                stored least significant bit first.
+
+    Parameters: pucBitmap           bitmap
+                uiBitmapLength      bitmap length (in bits)
+                ppvUtlRoaring       return pointer for the roaring structure
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringCreateFromBitmap
+(
+    unsigned char *pucBitmap,
+    unsigned int uiBitmapLength,
+    void **ppvUtlRoaring
+)
+{
+
+    int                 iError = UTL_NoError;
+    struct utlRoaring   *purUtlRoaring = NULL;
+    unsigned int        uiBitmapByteLength = UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength);
+    unsigned int        uiKey = 0;
+
+
+    /* Check the parameters */
+    if ( pucBitmap == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucBitmap' parameter passed to 'iUtlRoaringCreateFromBitmap'.");
+        return (UTL_RoaringInvalidBuffer);
+    }
+
+    if ( ppvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'ppvUtlRoaring' parameter passed to 'iUtlRoaringCreateFromBitmap'.");
+        return (UTL_ReturnParameterError);
+    }
+
+
+    /* Create the roaring structure */
+    if ( (iError = iUtlRoaringCreate((void **)&purUtlRoaring)) != UTL_NoError ) {
+        return (iError);
+    }
+
+
+    /* Loop over the bitmap, one container at a time */
+    for ( uiKey = 0; (uiKey * UTL_ROARING_BITMAP_CONTAINER_SIZE) < uiBitmapByteLength; uiKey++ ) {
+
+        unsigned char               *pucBitmapPtr = pucBitmap + (uiKey * UTL_ROARING_BITMAP_CONTAINER_SIZE);
+        unsigned int                uiLength = UTL_MACROS_MIN(UTL_ROARING_BITMAP_CONTAINER_SIZE, uiBitmapByteLength - (uiKey * UTL_ROARING_BITMAP_CONTAINER_SIZE));
+        struct utlRoaringContainer  urcUtlRoaringContainer;
+        unsigned int                uiI = 0;
+
+        s_memset(&urcUtlRoaringContainer, 0, sizeof(struct utlRoaringContainer));
+        urcUtlRoaringContainer.uiKey = uiKey;
+
+        /* Allocate the bitmap, this clears it */
+        if ( (urcUtlRoaringContainer.puiBitmap = (uint64_t *)s_malloc((size_t)(UTL_ROARING_BITMAP_CONTAINER_LENGTH * sizeof(uint64_t)))) == NULL ) {
+            iError = UTL_MemError;
+            goto bailFromiUtlRoaringCreateFromBitmap;
+        }
+
+        /* Copy the bytes into the words */
+        for ( uiI = 0; uiI < uiLength; uiI++ ) {
+            urcUtlRoaringContainer.puiBitmap[uiI >> 3] |= (uint64_t)pucBitmapPtr[uiI] << ((uiI & 7) * 8);
+        }
+
+        /* Count the values */
+        for ( uiI = 0; uiI < UTL_ROARING_BITMAP_CONTAINER_LENGTH; uiI++ ) {
+            urcUtlRoaringContainer.uiValuesCount += UTL_ROARING_WORD_BIT_COUNT(urcUtlRoaringContainer.puiBitmap[uiI]);
+        }
+
+        /* Convert the container to an array container if it is sparse enough */
+        if ( (urcUtlRoaringContainer.uiValuesCount > 0) && (urcUtlRoaringContainer.uiValuesCount <= UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH) ) {
+            iError = iUtlRoaringConvertToArrayContainer(&urcUtlRoaringContainer);
+        }
+
+        /* Add the container, empty containers are dropped */
+        if ( iError == UTL_NoError ) {
+            iError = iUtlRoaringAppendContainer(purUtlRoaring, &urcUtlRoaringContainer);
+        }
+
+        /* Handle the error */
+        if ( iError != UTL_NoError ) {
+            s_free(urcUtlRoaringContainer.pusArray);
+            s_free(urcUtlRoaringContainer.puiBitmap);
+            goto bailFromiUtlRoaringCreateFromBitmap;
+        }
+    }
+
+
+
+    /* Bail label */
+    bailFromiUtlRoaringCreateFromBitmap:
+
+
+    /* Handle the error */
+    if ( iError == UTL_NoError ) {
+
+        /* Set the return pointer */
+        *ppvUtlRoaring = (void *)purUtlRoaring;
+    }
+    else {
+
+        iUtlLogError(UTL_LOG_CONTEXT, "Failed to create a roaring structure from a bitmap, utl error: %d.", iError);
+
+        /* Free the roaring structure */
+        iUtlRoaringFree((void *)purUtlRoaring);
+        purUtlRoaring = NULL;
+    }
+
+
+    return (iError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringGetBitmap()
+
+    Purpose:    Get the roaring structure as a bitmap, the bitmap is stored
+                least significant bit first and values beyond the end of
+                the bitmap are ignored.
+
+    Parameters: pvUtlRoaring        roaring structure
+                pucBitmap           bitmap
+                uiBitmapLength      bitmap length (in bits)
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+int iUtlRoaringGetBitmap
+(
+    void *pvUtlRoaring,
+    unsigned char *pucBitmap,
+    unsigned int uiBitmapLength
+)
+{
+
+    struct utlRoaring   *purUtlRoaring = (struct utlRoaring *)pvUtlRoaring;
+    unsigned int        uiBitmapByteLength = UTL_BITMAP_GET_BITMAP_BYTE_LENGTH(uiBitmapLength);
+    unsigned int        uiI = 0;
+
+
+    /* Check the parameters */
+    if ( pvUtlRoaring == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pvUtlRoaring' parameter passed to 'iUtlRoaringGetBitmap'.");
+        return (UTL_RoaringInvalidRoaring);
+    }
+
+    if ( pucBitmap == NULL ) {
+        iUtlLogError(UTL_LOG_CONTEXT, "Null 'pucBitmap' parameter passed to 'iUtlRoaringGetBitmap'.");
+        return (UTL_RoaringInvalidBuffer);
+    }
+
+
+    /* Clear the bitmap */
+    UTL_BITMAP_CLEAR_POINTER(pucBitmap, uiBitmapLength);
+
+
+    /* Loop over the containers */
+    for ( uiI = 0; uiI < purUtlRoaring->uiUtlRoaringContainersLength; uiI++ ) {
+
+        struct utlRoaringContainer  *purcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + uiI;
+        unsigned int                uiOffset = purcUtlRoaringContainer->uiKey * UTL_ROARING_BITMAP_CONTAINER_SIZE;
+        unsigned int                uiJ = 0;
+
+        /* The containers are in key order so there is nothing more to get once we are past the end of the bitmap */
+        if ( uiOffset >= uiBitmapByteLength ) {
+            break;
+        }
+
+        /* Bitmap container, copy the words into the bytes */
+        if ( purcUtlRoaringContainer->puiBitmap != NULL ) {
+
+            unsigned int    uiLength = UTL_MACROS_MIN(UTL_ROARING_BITMAP_CONTAINER_SIZE, uiBitmapByteLength - uiOffset);
+
+            for ( uiJ = 0; uiJ < uiLength; uiJ++ ) {
+                pucBitmap[uiOffset + uiJ] = (unsigned char)((purcUtlRoaringContainer->puiBitmap[uiJ >> 3] >> ((uiJ & 7) * 8)) & 0xFF);
+            }
+        }
+
+        /* Array container, set the bits */
+        else {
+
+            for ( uiJ = 0; uiJ < purcUtlRoaringContainer->uiValuesCount; uiJ++ ) {
+
+                unsigned int    uiValue = UTL_ROARING_VALUE(purcUtlRoaringContainer->uiKey, purcUtlRoaringContainer->pusArray[uiJ]);
+
+                if ( uiValue >= uiBitmapLength ) {
+                    break;
+                }
+
+                UTL_BITMAP_SET_BIT_IN_POINTER(pucBitmap, uiValue);
+            }
+        }
+    }
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringGetContainer()
+
+    Purpose:    Get the container for a key, creating it if it does not
+                exist and we are asked to.
+
+    Parameters: purUtlRoaring               roaring structure
+                uiKey                       key
+                bCreate                     set to true to create the container if it does not exist
+                ppurcUtlRoaringContainer    return pointer for the roaring container structure
+
+    Globals:    none
+
+    Returns:    UTL error code, UTL_RoaringValueNotFound if the container does not exist
+
+*/
+static int iUtlRoaringGetContainer
+(
+    struct utlRoaring *purUtlRoaring,
+    unsigned int uiKey,
+    boolean bCreate,
+    struct utlRoaringContainer **ppurcUtlRoaringContainer
+)
+{
+
+    unsigned int    uiLow = 0;
+    unsigned int    uiHigh = 0;
+
+
+    ASSERT(purUtlRoaring != NULL);
+    ASSERT(ppurcUtlRoaringContainer != NULL);
+
+
+    /* Check the last container used first, and the one after it */
+    if ( purUtlRoaring->uiLastContainerIndex < purUtlRoaring->uiUtlRoaringContainersLength ) {
+
+        if ( purUtlRoaring->purcUtlRoaringContainers[purUtlRoaring->uiLastContainerIndex].uiKey == uiKey ) {
+            *ppurcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + purUtlRoaring->uiLastContainerIndex;
+            return (UTL_NoError);
+        }
+
+        if ( ((purUtlRoaring->uiLastContainerIndex + 1) < purUtlRoaring->uiUtlRoaringContainersLength) &&
+                (purUtlRoaring->purcUtlRoaringContainers[purUtlRoaring->uiLastContainerIndex + 1].uiKey == uiKey) ) {
+            purUtlRoaring->uiLastContainerIndex++;
+            *ppurcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + purUtlRoaring->uiLastContainerIndex;
+            return (UTL_NoError);
+        }
+    }
+
+
+    /* Binary search for the first container whose key is greater than or equal to the key */
+    for ( uiLow = 0, uiHigh = purUtlRoaring->uiUtlRoaringContainersLength; uiLow < uiHigh; ) {
+
+        unsigned int    uiMiddle = uiLow + ((uiHigh - uiLow) / 2);
+
+        if ( purUtlRoaring->purcUtlRoaringContainers[uiMiddle].uiKey < uiKey ) {
+            uiLow = uiMiddle + 1;
+        }
+        else {
+            uiHigh = uiMiddle;
+        }
+    }
+
+
+    /* Found it */
+    if ( (uiLow < purUtlRoaring->uiUtlRoaringContainersLength) && (purUtlRoaring->purcUtlRoaringContainers[uiLow].uiKey == uiKey) ) {
+        purUtlRoaring->uiLastContainerIndex = uiLow;
+        *ppurcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + uiLow;
+        return (UTL_NoError);
+    }
+
+
+    /* Not found and we dont need to create it */
+    if ( bCreate == false ) {
+        return (UTL_RoaringValueNotFound);
+    }
+
+
+    /* Extend the containers if needed */
+    if ( purUtlRoaring->uiUtlRoaringContainersLength >= purUtlRoaring->uiUtlRoaringContainersAllocated ) {
+
+        struct utlRoaringContainer  *purcUtlRoaringContainers = NULL;
+
+        if ( (purcUtlRoaringContainers = (struct utlRoaringContainer *)s_realloc(purUtlRoaring->purcUtlRoaringContainers,
+                (size_t)((purUtlRoaring->uiUtlRoaringContainersAllocated + UTL_ROARING_CONTAINERS_LENGTH_INCREMENT) * sizeof(struct utlRoaringContainer)))) == NULL ) {
+            return (UTL_MemError);
+        }
+
+        purUtlRoaring->purcUtlRoaringContainers = purcUtlRoaringContainers;
+        purUtlRoaring->uiUtlRoaringContainersAllocated += UTL_ROARING_CONTAINERS_LENGTH_INCREMENT;
+    }
+
+
+    /* Insert the new container */
+    if ( uiLow < purUtlRoaring->uiUtlRoaringContainersLength ) {
+        s_memmove(purUtlRoaring->purcUtlRoaringContainers + uiLow + 1, purUtlRoaring->purcUtlRoaringContainers + uiLow,
+                (purUtlRoaring->uiUtlRoaringContainersLength - uiLow) * sizeof(struct utlRoaringContainer));
+    }
+
+    s_memset(purUtlRoaring->purcUtlRoaringContainers + uiLow, 0, sizeof(struct utlRoaringContainer));
+    purUtlRoaring->purcUtlRoaringContainers[uiLow].uiKey = uiKey;
+    purUtlRoaring->uiUtlRoaringContainersLength++;
+
+
+    /* Set the return pointer */
+    purUtlRoaring->uiLastContainerIndex = uiLow;
+    *ppurcUtlRoaringContainer = purUtlRoaring->purcUtlRoaringContainers + uiLow;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   uiUtlRoaringGetArrayIndex()
+
+    Purpose:    Get the index of the first low value in an array container
+                which is greater than or equal to the passed low value, the
+                index of the last low value is returned if there is none.
+
+    Parameters: purcUtlRoaringContainer     roaring container structure
+                uiLowValue                  low value
+
+    Globals:    none
+
+    Returns:    the index
+
+*/
+static unsigned int uiUtlRoaringGetArrayIndex
+(
+    struct utlRoaringContainer *purcUtlRoaringContainer,
+    unsigned int uiLowValue
+)
+{
+
+    unsigned int    uiLow = 0;
+    unsigned int    uiHigh = 0;
+
+
+    ASSERT(purcUtlRoaringContainer != NULL);
+    ASSERT(purcUtlRoaringContainer->uiValuesCount > 0);
+
+
+    /* Binary search, stopping on the last low value */
+    for ( uiLow = 0, uiHigh = purcUtlRoaringContainer->uiValuesCount - 1; uiLow < uiHigh; ) {
+
+        unsigned int    uiMiddle = uiLow + ((uiHigh - uiLow) / 2);
+
+        if ( purcUtlRoaringContainer->pusArray[uiMiddle] < uiLowValue ) {
+            uiLow = uiMiddle + 1;
+        }
+        else {
+            uiHigh = uiMiddle;
+        }
+    }
+
+
+    return (uiLow);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringConvertToBitmapContainer()
+
+    Purpose:    Convert an array container to a bitmap container.
+
+    Parameters: purcUtlRoaringContainer     roaring container structure
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iUtlRoaringConvertToBitmapContainer
+(
+    struct utlRoaringContainer *purcUtlRoaringContainer
+)
+{
+
+    unsigned int    uiI = 0;
+
+
+    ASSERT(purcUtlRoaringContainer != NULL);
+    ASSERT(purcUtlRoaringContainer->puiBitmap == NULL);
+
+
+    /* Allocate the bitmap, this clears it */
+    if ( (purcUtlRoaringContainer->puiBitmap = (uint64_t *)s_malloc((size_t)(UTL_ROARING_BITMAP_CONTAINER_LENGTH * sizeof(uint64_t)))) == NULL ) {
+        return (UTL_MemError);
+    }
+
+    /* Set the low values in the bitmap */
+    for ( uiI = 0; uiI < purcUtlRoaringContainer->uiValuesCount; uiI++ ) {
+        purcUtlRoaringContainer->puiBitmap[purcUtlRoaringContainer->pusArray[uiI] >> 6] |= (uint64_t)1 << (purcUtlRoaringContainer->pusArray[uiI] & 63);
+    }
+
+    /* Free the array */
+    s_free(purcUtlRoaringContainer->pusArray);
+    purcUtlRoaringContainer->uiArrayLength = 0;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringConvertToArrayContainer()
+
+    Purpose:    Convert a bitmap container to an array container, the 
+                container must hold no more than 
+                UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH values.
+
+    Parameters: purcUtlRoaringContainer     roaring container structure
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iUtlRoaringConvertToArrayContainer
+(
+    struct utlRoaringContainer *purcUtlRoaringContainer
+)
+{
+
+    unsigned short  *pusArrayPtr = NULL;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(purcUtlRoaringContainer != NULL);
+    ASSERT(purcUtlRoaringContainer->puiBitmap != NULL);
+    ASSERT(purcUtlRoaringContainer->pusArray == NULL);
+    ASSERT(purcUtlRoaringContainer->uiValuesCount <= UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH);
+
+
+    /* Allocate the array */
+    if ( (purcUtlRoaringContainer->pusArray = (unsigned short *)s_malloc((size_t)(UTL_MACROS_MAX(purcUtlRoaringContainer->uiValuesCount, 1) * sizeof(unsigned short)))) == NULL ) {
+        return (UTL_MemError);
+    }
+    purcUtlRoaringContainer->uiArrayLength = UTL_MACROS_MAX(purcUtlRoaringContainer->uiValuesCount, 1);
+
+    /* Add the low values to the array */
+    for ( uiI = 0, pusArrayPtr = purcUtlRoaringContainer->pusArray; uiI < UTL_ROARING_BITMAP_CONTAINER_LENGTH; uiI++ ) {
+
+        uint64_t    uiWord = purcUtlRoaringContainer->puiBitmap[uiI];
+
+        for ( ; uiWord != 0; uiWord &= uiWord - 1 ) {
+            *pusArrayPtr++ = (unsigned short)((uiI << 6) + UTL_ROARING_WORD_TRAILING_ZEROS(uiWord));
+        }
+    }
+
+    /* Free the bitmap */
+    s_free(purcUtlRoaringContainer->puiBitmap);
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringAppendContainer()
+
+    Purpose:    Append a container to the roaring structure, the container
+                must have a key greater than that of the last container.
+                
+                The roaring structure takes over the array or the bitmap of 
+                the container, and an empty container is freed rather than
+                appended.
+
+    Parameters: purUtlRoaring               roaring structure
+                purcUtlRoaringContainer     roaring container structure
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iUtlRoaringAppendContainer
+(
+    struct utlRoaring *purUtlRoaring,
+    struct utlRoaringContainer *purcUtlRoaringContainer
+)
+{
+
+    ASSERT(purUtlRoaring != NULL);
+    ASSERT(purcUtlRoaringContainer != NULL);
+    ASSERT((purUtlRoaring->uiUtlRoaringContainersLength == 0) || 
+            (purUtlRoaring->purcUtlRoaringContainers[purUtlRoaring->uiUtlRoaringContainersLength - 1].uiKey < purcUtlRoaringContainer->uiKey));
+
+
+    /* Free the container if it is empty */
+    if ( purcUtlRoaringContainer->uiValuesCount == 0 ) {
+        s_free(purcUtlRoaringContainer->pusArray);
+        s_free(purcUtlRoaringContainer->puiBitmap);
+        return (UTL_NoError);
+    }
+
+
+    /* Extend the containers if needed */
+    if ( purUtlRoaring->uiUtlRoaringContainersLength >= purUtlRoaring->uiUtlRoaringContainersAllocated ) {
+
+        struct utlRoaringContainer  *purcUtlRoaringContainers = NULL;
+
+        if ( (purcUtlRoaringContainers = (struct utlRoaringContainer *)s_realloc(purUtlRoaring->purcUtlRoaringContainers,
+                (size_t)((purUtlRoaring->uiUtlRoaringContainersAllocated + UTL_ROARING_CONTAINERS_LENGTH_INCREMENT) * sizeof(struct utlRoaringContainer)))) == NULL ) {
+            return (UTL_MemError);
+        }
+
+        purUtlRoaring->purcUtlRoaringContainers = purcUtlRoaringContainers;
+        purUtlRoaring->uiUtlRoaringContainersAllocated += UTL_ROARING_CONTAINERS_LENGTH_INCREMENT;
+    }
+
+
+    /* Append the container */
+    purUtlRoaring->purcUtlRoaringContainers[purUtlRoaring->uiUtlRoaringContainersLength] = *purcUtlRoaringContainer;
+    purUtlRoaring->uiUtlRoaringContainersLength++;
+    purUtlRoaring->uiValuesCount += purcUtlRoaringContainer->uiValuesCount;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringCopyContainer()
+
+    Purpose:    Copy a container.
+
+    Parameters: purcUtlRoaringContainer         roaring container structure
+                purcUtlRoaringContainerCopy     roaring container structure to copy to
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iUtlRoaringCopyContainer
+(
+    struct utlRoaringContainer *purcUtlRoaringContainer,
+    struct utlRoaringContainer *purcUtlRoaringContainerCopy
+)
+{
+
+    ASSERT(purcUtlRoaringContainer != NULL);
+    ASSERT(purcUtlRoaringContainerCopy != NULL);
+
+
+    /* Copy the container */
+    s_memset(purcUtlRoaringContainerCopy, 0, sizeof(struct utlRoaringContainer));
+    purcUtlRoaringContainerCopy->uiKey = purcUtlRoaringContainer->uiKey;
+    purcUtlRoaringContainerCopy->uiValuesCount = purcUtlRoaringContainer->uiValuesCount;
+
+    /* Nothing to copy */
+    if ( purcUtlRoaringContainer->uiValuesCount == 0 ) {
+        return (UTL_NoError);
+    }
+
+    /* Copy the bitmap */
+    if ( purcUtlRoaringContainer->puiBitmap != NULL ) {
+
+        if ( (purcUtlRoaringContainerCopy->puiBitmap = (uint64_t *)s_malloc((size_t)(UTL_ROARING_BITMAP_CONTAINER_LENGTH * sizeof(uint64_t)))) == NULL ) {
+            return (UTL_MemError);
+        }
+
+        s_memcpy(purcUtlRoaringContainerCopy->puiBitmap, purcUtlRoaringContainer->puiBitmap, UTL_ROARING_BITMAP_CONTAINER_LENGTH * sizeof(uint64_t));
+    }
+
+    /* Copy the array */
+    else {
+
+        if ( (purcUtlRoaringContainerCopy->pusArray = (unsigned short *)s_malloc((size_t)(purcUtlRoaringContainer->uiValuesCount * sizeof(unsigned short)))) == NULL ) {
+            return (UTL_MemError);
+        }
+
+        s_memcpy(purcUtlRoaringContainerCopy->pusArray, purcUtlRoaringContainer->pusArray, purcUtlRoaringContainer->uiValuesCount * sizeof(unsigned short));
+        purcUtlRoaringContainerCopy->uiArrayLength = purcUtlRoaringContainer->uiValuesCount;
+    }
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringMergeArrayContainers()
+
+    Purpose:    Merge two array containers according to the merge type.
+
+                The arrays are merged in a single pass, except when ANDing
+                a much smaller array into a larger one, where we binary 
+                search the larger array for each low value of the smaller
+                one instead.
+
+    Parameters: purcUtlRoaringContainer1    roaring container structure
+                purcUtlRoaringContainer2    roaring container structure
+                uiMergeType                 merge type
+                purcUtlRoaringContainer     roaring container structure to merge to
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iUtlRoaringMergeArrayContainers
+(
+    struct utlRoaringContainer *purcUtlRoaringContainer1,
+    struct utlRoaringContainer *purcUtlRoaringContainer2,
+    unsigned int uiMergeType,
+    struct utlRoaringContainer *purcUtlRoaringContainer
+)
+{
+
+    unsigned short  *pusArray1Ptr = NULL;
+    unsigned short  *pusArray1End = NULL;
+    unsigned short  *pusArray2Ptr = NULL;
+    unsigned short  *pusArray2End = NULL;
+    unsigned short  *pusArrayPtr = NULL;
+    unsigned int    uiArrayLength = 0;
+
+
+    ASSERT(purcUtlRoaringContainer1 != NULL);
+    ASSERT(purcUtlRoaringContainer1->puiBitmap == NULL);
+    ASSERT(purcUtlRoaringContainer2 != NULL);
+    ASSERT(purcUtlRoaringContainer2->puiBitmap == NULL);
+    ASSERT(UTL_ROARING_MERGE_TYPE_VALID(uiMergeType) == true);
+    ASSERT(purcUtlRoaringContainer != NULL);
+
+
+    /* Work out the largest array the merge can produce */
+    if ( uiMergeType == UTL_ROARING_MERGE_TYPE_AND ) {
+        uiArrayLength = UTL_MACROS_MIN(purcUtlRoaringContainer1->uiValuesCount, purcUtlRoaringContainer2->uiValuesCount);
+    }
+    else if ( uiMergeType == UTL_ROARING_MERGE_TYPE_NOT ) {
+        uiArrayLength = purcUtlRoaringContainer1->uiValuesCount;
+    }
+    else {
+        uiArrayLength = purcUtlRoaringContainer1->uiValuesCount + purcUtlRoaringContainer2->uiValuesCount;
+    }
+
+    /* Nothing to merge */
+    if ( uiArrayLength == 0 ) {
+        return (UTL_NoError);
+    }
+
+    /* Allocate the array */
+    if ( (purcUtlRoaringContainer->pusArray = (unsigned short *)s_malloc((size_t)(uiArrayLength * sizeof(unsigned short)))) == NULL ) {
+        return (UTL_MemError);
+    }
+    purcUtlRoaringContainer->uiArrayLength = uiArrayLength;
+
+
+    /* Set the pointers */
+    pusArray1Ptr = purcUtlRoaringContainer1->pusArray;
+    pusArray1End = purcUtlRoaringContainer1->pusArray + purcUtlRoaringContainer1->uiValuesCount;
+    pusArray2Ptr = purcUtlRoaringContainer2->pusArray;
+    pusArray2End = purcUtlRoaringContainer2->pusArray + purcUtlRoaringContainer2->uiValuesCount;
+    pusArrayPtr = purcUtlRoaringContainer->pusArray;
+
+
+    /* AND a much smaller array into a larger one by searching the larger one */
+    if ( (uiMergeType == UTL_ROARING_MERGE_TYPE_AND) && 
+            ((purcUtlRoaringContainer1->uiValuesCount * 32) < purcUtlRoaringContainer2->uiValuesCount) ) {
+
+        for ( ; pusArray1Ptr < pusArray1End; pusArray1Ptr++ ) {
+            if ( purcUtlRoaringContainer2->pusArray[uiUtlRoaringGetArrayIndex(purcUtlRoaringContainer2, *pusArray1Ptr)] == *pusArray1Ptr ) {
+                *pusArrayPtr++ = *pusArray1Ptr;
+            }
+        }
+    }
+    else if ( (uiMergeType == UTL_ROARING_MERGE_TYPE_AND) && 
+            ((purcUtlRoaringContainer2->uiValuesCount * 32) < purcUtlRoaringContainer1->uiValuesCount) ) {
+
+        for ( ; pusArray2Ptr < pusArray2End; pusArray2Ptr++ ) {
+            if ( purcUtlRoaringContainer1->pusArray[uiUtlRoaringGetArrayIndex(purcUtlRoaringContainer1, *pusArray2Ptr)] == *pusArray2Ptr ) {
+                *pusArrayPtr++ = *pusArray2Ptr;
+            }
+        }
+    }
+
+    /* Merge the arrays in a single pass */
+    else {
+
+        while ( (pusArray1Ptr < pusArray1End) && (pusArray2Ptr < pusArray2End) ) {
+
+            /* Low value only in the first array, kept unless we are ANDing */
+            if ( *pusArray1Ptr < *pusArray2Ptr ) {
+                if ( uiMergeType != UTL_ROARING_MERGE_TYPE_AND ) {
+                    *pusArrayPtr++ = *pusArray1Ptr;
+                }
+                pusArray1Ptr++;
+            }
+
+            /* Low value only in the second array, kept if we are ORing or XORing */
+            else if ( *pusArray1Ptr > *pusArray2Ptr ) {
+                if ( (uiMergeType == UTL_ROARING_MERGE_TYPE_OR) || (uiMergeType == UTL_ROARING_MERGE_TYPE_XOR) ) {
+                    *pusArrayPtr++ = *pusArray2Ptr;
+                }
+                pusArray2Ptr++;
+            }
+
+            /* Low value in both arrays, kept if we are ANDing or ORing */
+            else {
+                if ( (uiMergeType == UTL_ROARING_MERGE_TYPE_AND) || (uiMergeType == UTL_ROARING_MERGE_TYPE_OR) ) {
+                    *pusArrayPtr++ = *pusArray1Ptr;
+                }
+                pusArray1Ptr++;
+                pusArray2Ptr++;
+            }
+        }
+
+        /* Add what is left in the first array unless we are ANDing */
+        if ( uiMergeType != UTL_ROARING_MERGE_TYPE_AND ) {
+            for ( ; pusArray1Ptr < pusArray1End; pusArray1Ptr++ ) {
+                *pusArrayPtr++ = *pusArray1Ptr;
+            }
+        }
+
+        /* Add what is left in the second array if we are ORing or XORing */
+        if ( (uiMergeType == UTL_ROARING_MERGE_TYPE_OR) || (uiMergeType == UTL_ROARING_MERGE_TYPE_XOR) ) {
+            for ( ; pusArray2Ptr < pusArray2End; pusArray2Ptr++ ) {
+                *pusArrayPtr++ = *pusArray2Ptr;
+            }
+        }
+    }
+
+
+    /* Set the values count */
+    purcUtlRoaringContainer->uiValuesCount = pusArrayPtr - purcUtlRoaringContainer->pusArray;
+
+
+    /* Convert the array container to a bitmap container if it is too large */
+    if ( purcUtlRoaringContainer->uiValuesCount > UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH ) {
+        return (iUtlRoaringConvertToBitmapContainer(purcUtlRoaringContainer));
+    }
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringFilterArrayContainer()
+
+    Purpose:    Filter an array container against a bitmap container, keeping
+                either the low values which are set in the bitmap (AND) or 
+                those which are not (NOT).
+
+    Parameters: purcUtlRoaringContainerArray    roaring container structure (array)
+                purcUtlRoaringContainerBitmap   roaring container structure (bitmap)
+                bKeepSetValues                  set to true to keep the low values set in the bitmap
+                purcUtlRoaringContainer         roaring container structure to filter to
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iUtlRoaringFilterArrayContainer
+(
+    struct utlRoaringContainer *purcUtlRoaringContainerArray,
+    struct utlRoaringContainer *purcUtlRoaringContainerBitmap,
+    boolean bKeepSetValues,
+    struct utlRoaringContainer *purcUtlRoaringContainer
+)
+{
+
+    unsigned short  *pusArrayPtr = NULL;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(purcUtlRoaringContainerArray != NULL);
+    ASSERT(purcUtlRoaringContainerArray->puiBitmap == NULL);
+    ASSERT(purcUtlRoaringContainerBitmap != NULL);
+    ASSERT(purcUtlRoaringContainerBitmap->puiBitmap != NULL);
+    ASSERT(purcUtlRoaringContainer != NULL);
+
+
+    /* Nothing to filter */
+    if ( purcUtlRoaringContainerArray->uiValuesCount == 0 ) {
+        return (UTL_NoError);
+    }
+
+    /* Allocate the array */
+    if ( (purcUtlRoaringContainer->pusArray = (unsigned short *)s_malloc((size_t)(purcUtlRoaringContainerArray->uiValuesCount * sizeof(unsigned short)))) == NULL ) {
+        return (UTL_MemError);
+    }
+    purcUtlRoaringContainer->uiArrayLength = purcUtlRoaringContainerArray->uiValuesCount;
+
+    /* Keep the low values we want */
+    for ( uiI = 0, pusArrayPtr = purcUtlRoaringContainer->pusArray; uiI < purcUtlRoaringContainerArray->uiValuesCount; uiI++ ) {
+
+        unsigned int    uiLowValue = purcUtlRoaringContainerArray->pusArray[uiI];
+        boolean         bSet = (purcUtlRoaringContainerBitmap->puiBitmap[uiLowValue >> 6] & ((uint64_t)1 << (uiLowValue & 63))) ? true : false;
+
+        if ( bSet == bKeepSetValues ) {
+            *pusArrayPtr++ = (unsigned short)uiLowValue;
+        }
+    }
+
+    /* Set the values count */
+    purcUtlRoaringContainer->uiValuesCount = pusArrayPtr - purcUtlRoaringContainer->pusArray;
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   iUtlRoaringMergeBitmapContainers()
+
+    Purpose:    Merge two containers as bitmaps according to the merge type,
+                an array container is expanded to a bitmap first.
+
+    Parameters: purcUtlRoaringContainer1    roaring container structure
+                purcUtlRoaringContainer2    roaring container structure
+                uiMergeType                 merge type
+                purcUtlRoaringContainer     roaring container structure to merge to
+
+    Globals:    none
+
+    Returns:    UTL error code
+
+*/
+static int iUtlRoaringMergeBitmapContainers
+(
+    struct utlRoaringContainer *purcUtlRoaringContainer1,
+    struct utlRoaringContainer *purcUtlRoaringContainer2,
+    unsigned int uiMergeType,
+    struct utlRoaringContainer *purcUtlRoaringContainer
+)
+{
+
+    uint64_t        puiWords[UTL_ROARING_BITMAP_CONTAINER_LENGTH];
+    uint64_t        *puiWords1 = NULL;
+    uint64_t        *puiWords2 = NULL;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(purcUtlRoaringContainer1 != NULL);
+    ASSERT(purcUtlRoaringContainer2 != NULL);
+    ASSERT((purcUtlRoaringContainer1->puiBitmap != NULL) || (purcUtlRoaringContainer2->puiBitmap != NULL));
+    ASSERT(UTL_ROARING_MERGE_TYPE_VALID(uiMergeType) == true);
+    ASSERT(purcUtlRoaringContainer != NULL);
+
+
+    /* Expand the array container if there is one, there is at most one */
+    if ( (purcUtlRoaringContainer1->puiBitmap == NULL) || (purcUtlRoaringContainer2->puiBitmap == NULL) ) {
+
+        struct utlRoaringContainer  *purcUtlRoaringContainerArray = (purcUtlRoaringContainer1->puiBitmap == NULL) ? purcUtlRoaringContainer1 : purcUtlRoaringContainer2;
+
+        s_memset(puiWords, 0, UTL_ROARING_BITMAP_CONTAINER_LENGTH * sizeof(uint64_t));
+
+        for ( uiI = 0; uiI < purcUtlRoaringContainerArray->uiValuesCount; uiI++ ) {
+            puiWords[purcUtlRoaringContainerArray->pusArray[uiI] >> 6] |= (uint64_t)1 << (purcUtlRoaringContainerArray->pusArray[uiI] & 63);
+        }
+    }
+
+    puiWords1 = (purcUtlRoaringContainer1->puiBitmap != NULL) ? purcUtlRoaringContainer1->puiBitmap : puiWords;
+    puiWords2 = (purcUtlRoaringContainer2->puiBitmap != NULL) ? purcUtlRoaringContainer2->puiBitmap : puiWords;
+
+
+    /* Allocate the bitmap */
+    if ( (purcUtlRoaringContainer->puiBitmap = (uint64_t *)s_malloc((size_t)(UTL_ROARING_BITMAP_CONTAINER_LENGTH * sizeof(uint64_t)))) == NULL ) {
+        return (UTL_MemError);
+    }
+
+    /* Merge the words */
+    purcUtlRoaringContainer->uiValuesCount = uiUtlRoaringMergeWords(puiWords1, puiWords2, uiMergeType, purcUtlRoaringContainer->puiBitmap);
+
+
+    /* Convert the bitmap container to an array container if it is sparse enough */
+    if ( (purcUtlRoaringContainer->uiValuesCount > 0) && (purcUtlRoaringContainer->uiValuesCount <= UTL_ROARING_ARRAY_CONTAINER_MAXIMUM_LENGTH) ) {
+        return (iUtlRoaringConvertToArrayContainer(purcUtlRoaringContainer));
+    }
+
+
+    return (UTL_NoError);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   uiUtlRoaringMergeWords()
+
+    Purpose:    Merge the words of two bitmap containers according to the
+                merge type, two words at a time with SSE2 if it is enabled.
+
+    Parameters: puiWords1       words
+                puiWords2       words
+                uiMergeType     merge type
+                puiWords        words to merge to
+
+    Globals:    none
+
+    Returns:    the number of bits set in the merged words
+
+*/
+static unsigned int uiUtlRoaringMergeWords
+(
+    uint64_t *puiWords1,
+    uint64_t *puiWords2,
+    unsigned int uiMergeType,
+    uint64_t *puiWords
+)
+{
+
+    unsigned int    uiBitCount = 0;
+    unsigned int    uiI = 0;
+
+
+    ASSERT(puiWords1 != NULL);
+    ASSERT(puiWords2 != NULL);
+    ASSERT(UTL_ROARING_MERGE_TYPE_VALID(uiMergeType) == true);
+    ASSERT(puiWords != NULL);
+
+
+#if defined(UTL_ROARING_ENABLE_SSE2)
+
+    /* Merge the words, two at a time */
+    for ( uiI = 0; uiI < UTL_ROARING_BITMAP_CONTAINER_LENGTH; uiI += 2 ) {
+
+        __m128i     mWords1 = _mm_loadu_si128((__m128i *)(puiWords1 + uiI));
+        __m128i     mWords2 = _mm_loadu_si128((__m128i *)(puiWords2 + uiI));
+        __m128i     mWords;
+
+        if ( uiMergeType == UTL_ROARING_MERGE_TYPE_AND ) {
+            mWords = _mm_and_si128(mWords1, mWords2);
+        }
+        else if ( uiMergeType == UTL_ROARING_MERGE_TYPE_OR ) {
+            mWords = _mm_or_si128(mWords1, mWords2);
+        }
+        else if ( uiMergeType == UTL_ROARING_MERGE_TYPE_XOR ) {
+            mWords = _mm_xor_si128(mWords1, mWords2);
+        }
+        else {
+            /* _mm_andnot_si128() negates its first operand */
+            mWords = _mm_andnot_si128(mWords2, mWords1);
+        }
+
+        _mm_storeu_si128((__m128i *)(puiWords + uiI), mWords);
+
+        uiBitCount += UTL_ROARING_WORD_BIT_COUNT(puiWords[uiI]) + UTL_ROARING_WORD_BIT_COUNT(puiWords[uiI + 1]);
+    }
+
+#else
+
+    /* Merge the words */
+    for ( uiI = 0; uiI < UTL_ROARING_BITMAP_CONTAINER_LENGTH; uiI++ ) {
+
+        if ( uiMergeType == UTL_ROARING_MERGE_TYPE_AND ) {
+            puiWords[uiI] = puiWords1[uiI] & puiWords2[uiI];
+        }
+        else if ( uiMergeType == UTL_ROARING_MERGE_TYPE_OR ) {
+            puiWords[uiI] = puiWords1[uiI] | puiWords2[uiI];
+        }
+        else if ( uiMergeType == UTL_ROARING_MERGE_TYPE_XOR ) {
+            puiWords[uiI] = puiWords1[uiI] ^ puiWords2[uiI];
+        }
+        else {
+            puiWords[uiI] = puiWords1[uiI] & ~puiWords2[uiI];
+        }
+
+        uiBitCount += UTL_ROARING_WORD_BIT_COUNT(puiWords[uiI]);
+    }
+
+#endif    /* defined(UTL_ROARING_ENABLE_SSE2) */
+
+
+    return (uiBitCount);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if !defined(__GNUC__)
+
+/*
+
+    Function:   uiUtlRoaringWordBitCount()
+
+    Purpose:    Count the bits set in a word.
+
+    Parameters: uiWord      word
+
+    Globals:    none
+
+    Returns:    the number of bits set
+
+*/
+static unsigned int uiUtlRoaringWordBitCount
+(
+    uint64_t uiWord
+)
+{
+
+    unsigned int    uiBitCount = 0;
+
+
+    /* Clear the lowest bit set until there are none left */
+    for ( uiBitCount = 0; uiWord != 0; uiWord &= uiWord - 1, uiBitCount++ ) {
+        ;
+    }
+
+
+    return (uiBitCount);
+
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+
+    Function:   uiUtlRoaringWordTrailingZeros()
+
+    Purpose:    Count the trailing zeros in a non-zero word.
+
+    Parameters: uiWord      word
+
+    Globals:    none
+
+    Returns:    the number of trailing zeros
+
+*/
+static unsigned int uiUtlRoaringWordTrailingZeros
+(
+    uint64_t uiWord
+)
+{
+
+    unsigned int    uiTrailingZeros = 0;
+
+
+    ASSERT(uiWord != 0);
+
+
+    /* Shift the word down until the lowest bit is set */
+    for ( uiTrailingZeros = 0; !(uiWord & 1); uiWord >>= 1, uiTrailingZeros++ ) {
+        ;
+    }
+
+
+    return (uiTrailingZeros);
+
+}
+
+#endif    /* !defined(__GNUC__) */
+
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,133 @@
+/*****************************************************************************
+*       Copyright (C) 1993-2011, FS Consulting LLC. All rights reserved      *
+*                                                                            *
+*  This notice is intended as a precaution against inadvertent publication   *
+*  and does not constitute an admission or acknowledgement that publication  *
+*  has occurred or constitute a waiver of confidentiality.                   *
+*                                                                            *
+*  This software is the proprietary and confidential property                *
+*  of FS Consulting LLC.                                                     *
+*****************************************************************************/
+
+
+/*
+
+    Module:     roaring.h
+
+    Author:     Francois Schiettecatte (FS Consulting LLC.)
+
+    Created:    17 October 2026
+
+    Purpose:    This is the header file for roaring.c.
+
+*/
+
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#if !defined(UTL_ROARING_H)
+#define UTL_ROARING_H
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Includes
+*/
+
+#include "utils.h"
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** C++ wrapper
+*/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif    /* defined(__cplusplus) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Defines
+*/
+
+/* Merge types */
+#define UTL_ROARING_MERGE_TYPE_INVALID                  (0)
+#define UTL_ROARING_MERGE_TYPE_XOR                      (1)
+#define UTL_ROARING_MERGE_TYPE_OR                       (2)
+#define UTL_ROARING_MERGE_TYPE_AND                      (3)
+#define UTL_ROARING_MERGE_TYPE_NOT                      (4)
+
+#define UTL_ROARING_MERGE_TYPE_VALID(n)                 (((n) >= UTL_ROARING_MERGE_TYPE_XOR) && \
+                                                                ((n) <= UTL_ROARING_MERGE_TYPE_NOT))
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** Public function prototypes
+*/
+
+int iUtlRoaringCreate (void **ppvUtlRoaring);
+
+int iUtlRoaringFree (void *pvUtlRoaring);
+
+int iUtlRoaringAddValue (void *pvUtlRoaring, unsigned int uiValue);
+
+boolean bUtlRoaringContainsValue (void *pvUtlRoaring, unsigned int uiValue);
+
+int iUtlRoaringGetNextValue (void *pvUtlRoaring, unsigned int uiValue,
+        unsigned int *puiNextValue);
+
+int iUtlRoaringGetValuesCount (void *pvUtlRoaring, unsigned int *puiValuesCount);
+
+
+int iUtlRoaringGetSerializedLength (void *pvUtlRoaring, unsigned int *puiSerializedLength);
+
+int iUtlRoaringSerialize (void *pvUtlRoaring, unsigned char *pucBuffer,
+        unsigned int *puiBufferLength);
+
+int iUtlRoaringDeserialize (unsigned char *pucBuffer, unsigned int uiBufferLength,
+        void **ppvUtlRoaring);
+
+
+int iUtlRoaringMerge (void *pvUtlRoaring1, void *pvUtlRoaring2,
+        unsigned int uiMergeType, void **ppvUtlRoaring);
+
+
+int iUtlRoaringCreateFromBitmap (unsigned char *pucBitmap, unsigned int uiBitmapLength,
+        void **ppvUtlRoaring);
+
+int iUtlRoaringGetBitmap (void *pvUtlRoaring, unsigned char *pucBitmap,
+        unsigned int uiBitmapLength);
+
+
+/*---------------------------------------------------------------------------*/
+
+
+/*
+** C++ wrapper
+*/
+
+#if defined(__cplusplus)
+}
+#endif    /* defined(__cplusplus) */
+
+
+/*---------------------------------------------------------------------------*/
+
+
+#endif    /* !defined(UTL_ROARING_H) */
+
+
+/*---------------------------------------------------------------------------*/
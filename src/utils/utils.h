@@ -72,6 +72,7 @@
 #include "net.h"
 #include "num.h"
 #include "rand.h"
+#include "roaring.h"
 #include "sha1.h"
 #include "signals.h"
 #include "socket.h"
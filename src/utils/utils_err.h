@@ -130,6 +130,7 @@ extern "C" {
 #define UTL_DictMappingFailed                           (-409)
 #define UTL_DictInvalidCallBackFunction                 (-407)
 #define UTL_DictKeyNotFound                             (-408)
+#define UTL_DictInvalidVersion                          (-410)
 
 
 /* File */
@@ -318,6 +319,14 @@ extern "C" {
 #define UTL_VersionInvalidLogContext                    (-1801)
 
 
+/* Roaring */
+#define UTL_RoaringInvalidRoaring                       (-1900)
+#define UTL_RoaringInvalidBuffer                        (-1901)
+#define UTL_RoaringInvalidBufferLength                  (-1902)
+#define UTL_RoaringValueNotFound                        (-1903)
+#define UTL_RoaringInvalidMergeType                     (-1904)
+
+
 /*---------------------------------------------------------------------------*/
 
 
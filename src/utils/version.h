@@ -62,7 +62,7 @@ extern "C" {
 
 /* Version numbers, abstracted */
 #define UTL_VERSION_MAJOR                   (11)
-#define UTL_VERSION_MINOR                   (0)
+#define UTL_VERSION_MINOR                   (1)
 #define UTL_VERSION_PATCH                   (0)
 
 